@@ -0,0 +1,162 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   accuracy.h
+ *
+ * @brief  Header file for the math kernel accuracy harness
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup Accuracy Math kernel accuracy harness
+ * @brief    Compares float kernels with double precision references over dense grids and random inputs
+ * @details  Every output of a kernel gets the largest and RMS absolute error, the largest relative error and the largest
+ *           error in units in the last place of the float nearest the reference. An output near zero has its relative
+ *           and ulp errors taken against ACCURACY_RELATIVE_FLOOR of its scale instead, and an angle output has its error wrapped
+ *           to +-pi first. Each output carries an accuracy budget, the largest absolute error it may show
+ * @{
+ */
+
+#define ACCURACY_MAX_ARGS 3U                           /**< Most float arguments of a kernel */
+#define ACCURACY_MAX_OUTPUTS 3U                        /**< Most outputs of a kernel */
+#define ACCURACY_DEFAULT_NUM_RANDOM_INPUTS (1U << 20U) /**< Random inputs per kernel, after the grid */
+#define ACCURACY_DEFAULT_SEED 0x9E3779B9U              /**< Seed of the random inputs */
+#define ACCURACY_RELATIVE_FLOOR 1e-3                   /**< Fraction of the scale relative errors are floored at */
+
+/**
+ * @brief   How grid points are spread over an argument's range
+ */
+typedef enum {
+  ACCURACY_SPACING_LINEAR, /**< Evenly spaced */
+  ACCURACY_SPACING_LOG,    /**< Evenly spaced in the logarithm, for a positive range over decades */
+} AccuracySpacing_t;
+
+/**
+ * @brief   How an output's error is taken
+ */
+typedef enum {
+  ACCURACY_OUTPUT_VALUE, /**< Difference from the reference */
+  ACCURACY_OUTPUT_ANGLE, /**< Difference from the reference wrapped to +-pi (rad) */
+} AccuracyOutputType_t;
+
+/**
+ * @brief   Argument of a kernel
+ */
+struct AccuracyArg_t {
+  const char *name;          /**< Name in the report */
+  float min;                 /**< Smallest input */
+  float max;                 /**< Largest input */
+  uint32_t grid_points;      /**< Grid points over the range */
+  AccuracySpacing_t spacing; /**< Spread of the grid and the random inputs */
+};
+
+/**
+ * @brief   Output of a kernel
+ */
+struct AccuracyOutput_t {
+  const char *name;          /**< Name in the report */
+  AccuracyOutputType_t type; /**< How the error is taken */
+  double scale;              /**< Typical magnitude, relative errors are floored at a fraction of it */
+  double budget_abs;         /**< Largest absolute error allowed */
+};
+
+/**
+ * @brief   Kernel to compare with its reference
+ */
+struct AccuracyKernel_t {
+  const char *name;                                      /**< Name in the report */
+  struct AccuracyArg_t args[ACCURACY_MAX_ARGS];          /**< Arguments */
+  uint32_t num_args;                                     /**< Number of arguments */
+  struct AccuracyOutput_t outputs[ACCURACY_MAX_OUTPUTS]; /**< Outputs */
+  uint32_t num_outputs;                                  /**< Number of outputs */
+  bool (*evaluate)(const float *args, float *outputs);   /**< Run the kernel, FALSE if it reported a failure */
+  void (*reference)(const float *args, double *outputs); /**< Compute the outputs in double precision */
+};
+
+/**
+ * @brief   Error statistics of one output
+ */
+struct AccuracyStats_t {
+  uint64_t count;                      /**< Inputs compared */
+  double max_abs;                      /**< Largest absolute error */
+  double sum_sq_abs;                   /**< Sum of the squared absolute errors */
+  double max_rel;                      /**< Largest relative error */
+  double max_ulp;                      /**< Largest error in units in the last place */
+  float worst_args[ACCURACY_MAX_ARGS]; /**< Input behind the largest absolute error */
+};
+
+/**
+ * @brief   Outcome of comparing a kernel with its reference
+ */
+struct AccuracyResult_t {
+  const struct AccuracyKernel_t *kernel;                /**< Kernel compared */
+  struct AccuracyStats_t outputs[ACCURACY_MAX_OUTPUTS]; /**< Statistics of each output */
+  uint32_t num_failures;                                /**< Inputs the kernel failed on, or gave a non-finite output for */
+  float first_failure[ACCURACY_MAX_ARGS];               /**< First input the kernel failed on */
+};
+
+/**
+ * @brief   Comparison settings
+ */
+struct AccuracyOptions_t {
+  uint32_t num_random_inputs; /**< Random inputs per kernel */
+  uint32_t seed;              /**< Seed of the random inputs */
+};
+
+/**
+ * @brief   Error of a float in units in the last place of the float nearest the reference
+ * @details Near zero the unit is taken at floor instead, so outputs that cancel are not charged millions of ulp
+ * @param   value Float result
+ * @param   reference Double precision reference
+ * @param   floor Smallest magnitude to take the unit at
+ * @return  Error (ulp)
+ */
+double accuracy_ulp_error(float value, double reference, double floor);
+
+/**
+ * @brief   Add one comparison to the statistics of an output
+ * @param   stats Statistics to update
+ * @param   output Output compared
+ * @param   value Kernel result
+ * @param   reference Reference result
+ * @param   args Input of the comparison, kept if its error is the largest so far
+ * @param   num_args Number of arguments
+ */
+void accuracy_stats_add(struct AccuracyStats_t *stats, const struct AccuracyOutput_t *output, float value, double reference,
+                        const float *args, uint32_t num_args);
+
+/**
+ * @brief   RMS absolute error of an output
+ * @param   stats Statistics of the output
+ * @return  RMS error, 0 before any comparison
+ */
+double accuracy_stats_rms(const struct AccuracyStats_t *stats);
+
+/**
+ * @brief   Compare a kernel with its reference over its grid, then over random inputs
+ * @param   kernel Kernel to compare
+ * @param   options Comparison settings
+ * @param   result Pointer to store the outcome
+ */
+void accuracy_compare(const struct AccuracyKernel_t *kernel, const struct AccuracyOptions_t *options, struct AccuracyResult_t *result);
+
+/**
+ * @brief   Check an outcome against the budgets of the kernel
+ * @param   result Outcome to check
+ * @return  TRUE if an output is past its budget or the kernel failed on an input
+ */
+bool accuracy_is_over_budget(const struct AccuracyResult_t *result);
+
+/** @} */
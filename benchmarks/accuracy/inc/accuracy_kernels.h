@@ -0,0 +1,32 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   accuracy_kernels.h
+ *
+ * @brief  Header file for the math kernels the accuracy harness compares with their references
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stddef.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "accuracy.h"
+
+/**
+ * @addtogroup Accuracy
+ * @{
+ */
+
+/**
+ * @brief   Kernels to compare, each with its accuracy budget
+ * @param   num_kernels Pointer to store the number of kernels
+ * @return  Table of kernels
+ */
+const struct AccuracyKernel_t *accuracy_kernels_get(size_t *num_kernels);
+
+/** @} */
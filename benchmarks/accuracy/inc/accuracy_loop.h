@@ -0,0 +1,80 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   accuracy_loop.h
+ *
+ * @brief  Header file for the closed-loop error of the math kernels
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @addtogroup Accuracy
+ * @{
+ */
+
+/**
+ * @brief   Math of the field oriented control step, in one set of kernels
+ * @details Values cross in double precision, a float set rounds them on the way into its kernels. The PI controllers
+ *          and the motor stay in double precision, so a difference between two runs comes from the math alone
+ */
+struct AccuracyLoopMath_t {
+  const char *name;                                                                    /**< Name in the report */
+  double (*elec_angle)(double mech_angle);                                             /**< Electrical angle in [0, 2pi) */
+  bool (*clarke)(double ia, double ib, double ic, double *alpha, double *beta);        /**< Clarke transform */
+  bool (*park)(double alpha, double beta, double theta, double *d, double *q);         /**< Park transform */
+  bool (*inverse_park)(double d, double q, double theta, double *alpha, double *beta); /**< Inverse Park transform */
+  double (*magnitude)(double x, double y);                                             /**< Length of a vector */
+  double (*angle)(double y, double x);                                                 /**< Direction of a vector */
+  bool (*svpwm)(double theta, double modulation, double *duties);                      /**< Three duty cycles */
+  double budget_torque;                                                                /**< Largest torque error allowed (Nm) */
+  double budget_angle;                                                                 /**< Largest angle error allowed (rad) */
+};
+
+/**
+ * @brief   Difference of a closed-loop run from the double precision run
+ */
+struct AccuracyLoopResult_t {
+  const struct AccuracyLoopMath_t *math; /**< Math set run */
+  uint32_t num_steps;                    /**< Control steps run */
+  uint32_t num_failures;                 /**< Steps a kernel reported a failure in */
+  double torque_max_error;               /**< Largest electromagnetic torque error (Nm) */
+  double torque_rms_error;               /**< RMS electromagnetic torque error (Nm) */
+  double speed_max_error;                /**< Largest mechanical speed error (rad/s) */
+  double angle_max_error;                /**< Largest rotor electrical angle error (rad) */
+  double control_angle_max_error;        /**< Largest error of the electrical angle the controller used, within the run (rad) */
+};
+
+/**
+ * @brief   Math sets to compare with the double precision set
+ * @param   num_math Pointer to store the number of sets
+ * @return  Table of math sets
+ */
+const struct AccuracyLoopMath_t *accuracy_loop_math_get(size_t *num_math);
+
+/**
+ * @brief   Run a speed step, a load step and a reversal with a math set and with double precision math, and compare
+ * @param   math Math set to run
+ * @param   result Pointer to store the difference
+ * @return  0 on success, -1 if the traces could not be allocated
+ */
+int accuracy_loop_compare(const struct AccuracyLoopMath_t *math, struct AccuracyLoopResult_t *result);
+
+/**
+ * @brief   Check a difference against the budgets of its math set
+ * @param   result Difference to check
+ * @return  TRUE if an error is past its budget or a kernel failed
+ */
+bool accuracy_loop_is_over_budget(const struct AccuracyLoopResult_t *result);
+
+/** @} */
@@ -0,0 +1,143 @@
+/*******************************************************************************************************************************
+ * @file   accuracy.c
+ *
+ * @brief  Source file for the math kernel accuracy harness
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "accuracy.h"
+
+#define ACCURACY_PI 3.14159265358979323846 /**< Pi in double precision */
+
+/* xorshift32, never 0 for a seed that is not 0 */
+static uint32_t next_random(uint32_t *seed) {
+  *seed ^= *seed << 13U;
+  *seed ^= *seed >> 17U;
+  *seed ^= *seed << 5U;
+  return *seed;
+}
+
+/* Point at fraction 0 to 1 of an argument's range, in its spacing */
+static float point_at(const struct AccuracyArg_t *arg, double fraction) {
+  if (arg->spacing == ACCURACY_SPACING_LOG && arg->min > 0.0f) {
+    return (float)exp(log((double)arg->min) + fraction * (log((double)arg->max) - log((double)arg->min)));
+  }
+
+  return (float)((double)arg->min + fraction * ((double)arg->max - (double)arg->min));
+}
+
+static void compare_input(const struct AccuracyKernel_t *kernel, const float *args, struct AccuracyResult_t *result) {
+  float values[ACCURACY_MAX_OUTPUTS];
+  double references[ACCURACY_MAX_OUTPUTS];
+  bool is_valid = kernel->evaluate(args, values);
+
+  for (uint32_t out = 0U; out < kernel->num_outputs && is_valid; out++) {
+    is_valid = isfinite(values[out]);
+  }
+
+  if (!is_valid) {
+    if (result->num_failures++ == 0U) {
+      memcpy(result->first_failure, args, kernel->num_args * sizeof(args[0]));
+    }
+    return;
+  }
+
+  kernel->reference(args, references);
+
+  for (uint32_t out = 0U; out < kernel->num_outputs; out++) {
+    accuracy_stats_add(&result->outputs[out], &kernel->outputs[out], values[out], references[out], args, kernel->num_args);
+  }
+}
+
+double accuracy_ulp_error(float value, double reference, double floor) {
+  float nearest = (float)((fabs(reference) > floor) ? fabs(reference) : floor);
+  nearest = (nearest < FLT_MIN) ? FLT_MIN : nearest;
+
+  double ulp = (double)nextafterf(nearest, INFINITY) - (double)nearest;
+  return fabs((double)value - reference) / ulp;
+}
+
+void accuracy_stats_add(struct AccuracyStats_t *stats, const struct AccuracyOutput_t *output, float value, double reference,
+                        const float *args, uint32_t num_args) {
+  double error = (double)value - reference;
+
+  if (output->type == ACCURACY_OUTPUT_ANGLE) {
+    error = remainder(error, 2.0 * ACCURACY_PI);
+  }
+
+  double abs_error = fabs(error);
+  double floor = ACCURACY_RELATIVE_FLOOR * output->scale;
+  double rel_error = abs_error / ((fabs(reference) > floor) ? fabs(reference) : floor);
+  double ulp_error = accuracy_ulp_error((float)(reference + error), reference, floor);
+
+  if (stats->count == 0U || abs_error > stats->max_abs) {
+    stats->max_abs = abs_error;
+    memcpy(stats->worst_args, args, num_args * sizeof(args[0]));
+  }
+
+  stats->count++;
+  stats->sum_sq_abs += abs_error * abs_error;
+  stats->max_rel = (rel_error > stats->max_rel) ? rel_error : stats->max_rel;
+  stats->max_ulp = (ulp_error > stats->max_ulp) ? ulp_error : stats->max_ulp;
+}
+
+double accuracy_stats_rms(const struct AccuracyStats_t *stats) {
+  return (stats->count > 0U) ? sqrt(stats->sum_sq_abs / (double)stats->count) : 0.0;
+}
+
+void accuracy_compare(const struct AccuracyKernel_t *kernel, const struct AccuracyOptions_t *options, struct AccuracyResult_t *result) {
+  float args[ACCURACY_MAX_ARGS] = { 0.0f };
+  uint64_t num_grid_inputs = 1U;
+  uint32_t seed = (options->seed != 0U) ? options->seed : ACCURACY_DEFAULT_SEED;
+
+  memset(result, 0, sizeof(*result));
+  result->kernel = kernel;
+
+  for (uint32_t arg = 0U; arg < kernel->num_args; arg++) {
+    num_grid_inputs *= kernel->args[arg].grid_points;
+  }
+
+  /* Every grid point, both ends of each range included */
+  for (uint64_t i = 0U; i < num_grid_inputs; i++) {
+    uint64_t index = i;
+
+    for (uint32_t arg = 0U; arg < kernel->num_args; arg++) {
+      uint32_t points = kernel->args[arg].grid_points;
+      double fraction = (points > 1U) ? (double)(index % points) / (double)(points - 1U) : 0.5;
+
+      args[arg] = point_at(&kernel->args[arg], fraction);
+      index /= points;
+    }
+
+    compare_input(kernel, args, result);
+  }
+
+  /* Random inputs fall between the grid points */
+  for (uint32_t i = 0U; i < options->num_random_inputs; i++) {
+    for (uint32_t arg = 0U; arg < kernel->num_args; arg++) {
+      args[arg] = point_at(&kernel->args[arg], (double)next_random(&seed) / 4294967296.0);
+    }
+
+    compare_input(kernel, args, result);
+  }
+}
+
+bool accuracy_is_over_budget(const struct AccuracyResult_t *result) {
+  bool is_over_budget = (result->num_failures > 0U);
+
+  for (uint32_t out = 0U; out < result->kernel->num_outputs; out++) {
+    is_over_budget = is_over_budget || (result->outputs[out].max_abs > result->kernel->outputs[out].budget_abs);
+  }
+
+  return is_over_budget;
+}
@@ -0,0 +1,383 @@
+/*******************************************************************************************************************************
+ * @file   accuracy_kernels.c
+ *
+ * @brief  Source file for the math kernels the accuracy harness compares with their references
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+
+/* Inter-component Headers */
+#include "math_utils.h"
+#include "svpwm.h"
+#include "transform_batch.h"
+#include "transform_utils.h"
+
+/* Intra-component Headers */
+#include "accuracy.h"
+#include "accuracy_kernels.h"
+
+#define ACCURACY_POLE_PAIRS 7U             /**< Pole pairs of the mechanical to electrical conversion */
+#define ACCURACY_CURRENT_RANGE 40.0f       /**< Currents and voltages, either sign (A or V) */
+#define ACCURACY_BATCH_ANGLE_RANGE 1000.0f /**< Angles the batch sin/cos is documented for, either sign (rad) */
+#define ACCURACY_GRID_1D (1U << 20U)       /**< Grid points of a kernel with one argument */
+#define ACCURACY_GRID_2D 1024U             /**< Grid points per argument of a kernel with two arguments */
+#define ACCURACY_GRID_3D 101U              /**< Grid points per argument of a kernel with three arguments */
+
+#define REF_PI 3.14159265358979323846 /**< Pi in double precision */
+
+/* Angle in [0, 2pi) in double precision */
+static double ref_normalize(double angle) {
+  double wrapped = fmod(angle, 2.0 * REF_PI);
+  return (wrapped < 0.0) ? wrapped + 2.0 * REF_PI : wrapped;
+}
+
+/* Duty cycles of min-max injection, the same switching times the sector form of svpwm_generate() gives */
+static void ref_svpwm(double theta, double vref_mag, double *duties) {
+  double m = (vref_mag > 1.0) ? 1.0 : ((vref_mag < 0.0) ? 0.0 : vref_mag);
+  double v[3];
+
+  for (int phase = 0; phase < 3; phase++) {
+    v[phase] = (2.0 * m / 3.0) * cos(theta - (double)phase * 2.0 * REF_PI / 3.0);
+  }
+
+  double max = fmax(v[0], fmax(v[1], v[2]));
+  double min = fmin(v[0], fmin(v[1], v[2]));
+
+  for (int phase = 0; phase < 3; phase++) {
+    duties[phase] = v[phase] + 0.5 - 0.5 * (max + min);
+  }
+}
+
+static bool eval_sqrtf(const float *args, float *outputs) {
+  outputs[0] = sqrtf(args[0]);
+  return true;
+}
+
+/* Optimizing compilers inline sqrtf as the FPU's square root, the call reaches the Newton-Raphson one in math_utils.c */
+static float (*volatile s_sqrtf_call)(float x) = sqrtf;
+
+static bool eval_sqrtf_call(const float *args, float *outputs) {
+  outputs[0] = s_sqrtf_call(args[0]);
+  return true;
+}
+
+static void ref_sqrtf(const float *args, double *outputs) {
+  outputs[0] = sqrt((double)args[0]);
+}
+
+static bool eval_fast_inv_sqrt(const float *args, float *outputs) {
+  outputs[0] = fast_inv_sqrt(args[0]);
+  return true;
+}
+
+static void ref_fast_inv_sqrt(const float *args, double *outputs) {
+  outputs[0] = 1.0 / sqrt((double)args[0]);
+}
+
+static bool eval_fast_sin_cos(const float *args, float *outputs) {
+  fast_sin_cos(args[0], &outputs[0], &outputs[1]);
+  return true;
+}
+
+static void ref_sin_cos(const float *args, double *outputs) {
+  outputs[0] = sin((double)args[0]);
+  outputs[1] = cos((double)args[0]);
+}
+
+static bool eval_normalize_angle(const float *args, float *outputs) {
+  outputs[0] = normalize_angle(args[0]);
+  return (outputs[0] >= 0.0f && outputs[0] < MATH_TWO_PI);
+}
+
+static void ref_normalize_angle(const float *args, double *outputs) {
+  outputs[0] = ref_normalize((double)args[0]);
+}
+
+static bool eval_mech_to_elec_angle(const float *args, float *outputs) {
+  outputs[0] = mech_to_elec_angle(args[0], ACCURACY_POLE_PAIRS);
+  return (outputs[0] >= 0.0f && outputs[0] < MATH_TWO_PI);
+}
+
+static void ref_mech_to_elec_angle(const float *args, double *outputs) {
+  outputs[0] = ref_normalize((double)args[0] * ACCURACY_POLE_PAIRS);
+}
+
+static bool eval_clarke_transform_2phase(const float *args, float *outputs) {
+  return clarke_transform_2phase(args[0], args[1], &outputs[0], &outputs[1]) == UTILS_OK;
+}
+
+static void ref_clarke_2phase(const float *args, double *outputs) {
+  outputs[0] = (double)args[0];
+  outputs[1] = ((double)args[0] + 2.0 * (double)args[1]) / sqrt(3.0);
+}
+
+static bool eval_clarke_transform_3phase(const float *args, float *outputs) {
+  return clarke_transform_3phase(args[0], args[1], args[2], &outputs[0], &outputs[1]) == UTILS_OK;
+}
+
+static void ref_clarke_3phase(const float *args, double *outputs) {
+  outputs[0] = (double)args[0];
+  outputs[1] = ((double)args[1] - (double)args[2]) / sqrt(3.0);
+}
+
+static bool eval_clarke_transform_batch(const float *args, float *outputs) {
+  return clarke_transform_batch(&args[0], &args[1], &args[2], &outputs[0], &outputs[1], 1U) == UTILS_OK;
+}
+
+static bool eval_park_transform(const float *args, float *outputs) {
+  return park_transform(args[0], args[1], args[2], &outputs[0], &outputs[1]) == UTILS_OK;
+}
+
+static bool eval_park_transform_batch(const float *args, float *outputs) {
+  return park_transform_batch(&args[0], &args[1], &args[2], &outputs[0], &outputs[1], 1U) == UTILS_OK;
+}
+
+static void ref_park(const float *args, double *outputs) {
+  double theta = (double)args[2];
+
+  outputs[0] = (double)args[0] * cos(theta) + (double)args[1] * sin(theta);
+  outputs[1] = -(double)args[0] * sin(theta) + (double)args[1] * cos(theta);
+}
+
+static bool eval_inverse_park_transform(const float *args, float *outputs) {
+  return inverse_park_transform(args[0], args[1], args[2], &outputs[0], &outputs[1]) == UTILS_OK;
+}
+
+static bool eval_inverse_park_transform_batch(const float *args, float *outputs) {
+  return inverse_park_transform_batch(&args[0], &args[1], &args[2], &outputs[0], &outputs[1], 1U) == UTILS_OK;
+}
+
+static void ref_inverse_park(const float *args, double *outputs) {
+  double theta = (double)args[2];
+
+  outputs[0] = (double)args[0] * cos(theta) - (double)args[1] * sin(theta);
+  outputs[1] = (double)args[0] * sin(theta) + (double)args[1] * cos(theta);
+}
+
+static bool eval_svpwm_generate(const float *args, float *outputs) {
+  return svpwm_generate(args[0], args[1], &outputs[0], &outputs[1], &outputs[2]) == UTILS_OK;
+}
+
+static bool eval_svpwm_generate_batch(const float *args, float *outputs) {
+  return svpwm_generate_batch(&args[0], &args[1], &outputs[0], &outputs[1], &outputs[2], 1U) == UTILS_OK;
+}
+
+static void ref_svpwm_generate(const float *args, double *outputs) {
+  ref_svpwm((double)args[0], (double)args[1], outputs);
+}
+
+/*
+ * Budgets are the largest errors measured over the grid and the default random inputs, with headroom for other
+ * compilers and libm builds. A change that breaches one has made a kernel less accurate
+ */
+static const struct AccuracyKernel_t s_kernels[] = {
+  {
+    .name = "sqrtf",
+    .args = { { "x", 0.0f, 1e4f, ACCURACY_GRID_1D, ACCURACY_SPACING_LINEAR } },
+    .num_args = 1U,
+    .outputs = { { "sqrt", ACCURACY_OUTPUT_VALUE, 100.0, 1e-5 } },
+    .num_outputs = 1U,
+    .evaluate = eval_sqrtf,
+    .reference = ref_sqrtf,
+  },
+  {
+    .name = "sqrtf_call",
+    .args = { { "x", 0.0f, 1e4f, ACCURACY_GRID_1D, ACCURACY_SPACING_LINEAR } },
+    .num_args = 1U,
+    .outputs = { { "sqrt", ACCURACY_OUTPUT_VALUE, 100.0, 1e-3 } },
+    .num_outputs = 1U,
+    .evaluate = eval_sqrtf_call,
+    .reference = ref_sqrtf,
+  },
+  {
+    .name = "fast_inv_sqrt",
+    .args = { { "x", 1e-4f, 1e4f, ACCURACY_GRID_1D, ACCURACY_SPACING_LOG } },
+    .num_args = 1U,
+    .outputs = { { "inv_sqrt", ACCURACY_OUTPUT_VALUE, 1.0, 1e-3 } },
+    .num_outputs = 1U,
+    .evaluate = eval_fast_inv_sqrt,
+    .reference = ref_fast_inv_sqrt,
+  },
+  {
+    .name = "fast_sin_cos",
+    .args = { { "angle", -4.0f * MATH_TWO_PI, 4.0f * MATH_TWO_PI, ACCURACY_GRID_1D, ACCURACY_SPACING_LINEAR } },
+    .num_args = 1U,
+    .outputs = {
+      { "sin", ACCURACY_OUTPUT_VALUE, 1.0, 1e-7 },
+      { "cos", ACCURACY_OUTPUT_VALUE, 1.0, 1e-7 },
+    },
+    .num_outputs = 2U,
+    .evaluate = eval_fast_sin_cos,
+    .reference = ref_sin_cos,
+  },
+  {
+    .name = "normalize_angle",
+    .args = { { "angle", -4.0f * MATH_TWO_PI, 4.0f * MATH_TWO_PI, ACCURACY_GRID_1D, ACCURACY_SPACING_LINEAR } },
+    .num_args = 1U,
+    .outputs = { { "angle", ACCURACY_OUTPUT_ANGLE, MATH_TWO_PI, 4e-6 } },
+    .num_outputs = 1U,
+    .evaluate = eval_normalize_angle,
+    .reference = ref_normalize_angle,
+  },
+  {
+    .name = "mech_to_elec_angle",
+    .args = { { "angle", 0.0f, MATH_TWO_PI, ACCURACY_GRID_1D, ACCURACY_SPACING_LINEAR } },
+    .num_args = 1U,
+    .outputs = { { "angle", ACCURACY_OUTPUT_ANGLE, MATH_TWO_PI, 1e-5 } },
+    .num_outputs = 1U,
+    .evaluate = eval_mech_to_elec_angle,
+    .reference = ref_mech_to_elec_angle,
+  },
+  {
+    .name = "clarke_transform_2phase",
+    .args = {
+      { "ia", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_2D, ACCURACY_SPACING_LINEAR },
+      { "ib", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_2D, ACCURACY_SPACING_LINEAR },
+    },
+    .num_args = 2U,
+    .outputs = {
+      { "alpha", ACCURACY_OUTPUT_VALUE, ACCURACY_CURRENT_RANGE, 1e-5 },
+      { "beta", ACCURACY_OUTPUT_VALUE, ACCURACY_CURRENT_RANGE, 1.5e-5 },
+    },
+    .num_outputs = 2U,
+    .evaluate = eval_clarke_transform_2phase,
+    .reference = ref_clarke_2phase,
+  },
+  {
+    .name = "clarke_transform_3phase",
+    .args = {
+      { "ia", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+      { "ib", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+      { "ic", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+    },
+    .num_args = 3U,
+    .outputs = {
+      { "alpha", ACCURACY_OUTPUT_VALUE, ACCURACY_CURRENT_RANGE, 1e-5 },
+      { "beta", ACCURACY_OUTPUT_VALUE, ACCURACY_CURRENT_RANGE, 1e-5 },
+    },
+    .num_outputs = 2U,
+    .evaluate = eval_clarke_transform_3phase,
+    .reference = ref_clarke_3phase,
+  },
+  {
+    .name = "clarke_transform_batch",
+    .args = {
+      { "ia", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+      { "ib", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+      { "ic", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+    },
+    .num_args = 3U,
+    .outputs = {
+      { "alpha", ACCURACY_OUTPUT_VALUE, ACCURACY_CURRENT_RANGE, 1e-5 },
+      { "beta", ACCURACY_OUTPUT_VALUE, ACCURACY_CURRENT_RANGE, 1e-5 },
+    },
+    .num_outputs = 2U,
+    .evaluate = eval_clarke_transform_batch,
+    .reference = ref_clarke_3phase,
+  },
+  {
+    .name = "park_transform",
+    .args = {
+      { "alpha", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+      { "beta", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+      { "theta", 0.0f, MATH_TWO_PI, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+    },
+    .num_args = 3U,
+    .outputs = {
+      { "d", ACCURACY_OUTPUT_VALUE, ACCURACY_CURRENT_RANGE, 1.5e-5 },
+      { "q", ACCURACY_OUTPUT_VALUE, ACCURACY_CURRENT_RANGE, 1.5e-5 },
+    },
+    .num_outputs = 2U,
+    .evaluate = eval_park_transform,
+    .reference = ref_park,
+  },
+  {
+    .name = "park_transform_batch",
+    .args = {
+      { "alpha", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+      { "beta", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+      { "theta", -ACCURACY_BATCH_ANGLE_RANGE, ACCURACY_BATCH_ANGLE_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+    },
+    .num_args = 3U,
+    .outputs = {
+      { "d", ACCURACY_OUTPUT_VALUE, ACCURACY_CURRENT_RANGE, 1.5e-5 },
+      { "q", ACCURACY_OUTPUT_VALUE, ACCURACY_CURRENT_RANGE, 1.5e-5 },
+    },
+    .num_outputs = 2U,
+    .evaluate = eval_park_transform_batch,
+    .reference = ref_park,
+  },
+  {
+    .name = "inverse_park_transform",
+    .args = {
+      { "d", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+      { "q", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+      { "theta", 0.0f, MATH_TWO_PI, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+    },
+    .num_args = 3U,
+    .outputs = {
+      { "alpha", ACCURACY_OUTPUT_VALUE, ACCURACY_CURRENT_RANGE, 1.5e-5 },
+      { "beta", ACCURACY_OUTPUT_VALUE, ACCURACY_CURRENT_RANGE, 1.5e-5 },
+    },
+    .num_outputs = 2U,
+    .evaluate = eval_inverse_park_transform,
+    .reference = ref_inverse_park,
+  },
+  {
+    .name = "inverse_park_transform_batch",
+    .args = {
+      { "d", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+      { "q", -ACCURACY_CURRENT_RANGE, ACCURACY_CURRENT_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+      { "theta", -ACCURACY_BATCH_ANGLE_RANGE, ACCURACY_BATCH_ANGLE_RANGE, ACCURACY_GRID_3D, ACCURACY_SPACING_LINEAR },
+    },
+    .num_args = 3U,
+    .outputs = {
+      { "alpha", ACCURACY_OUTPUT_VALUE, ACCURACY_CURRENT_RANGE, 1.5e-5 },
+      { "beta", ACCURACY_OUTPUT_VALUE, ACCURACY_CURRENT_RANGE, 1.5e-5 },
+    },
+    .num_outputs = 2U,
+    .evaluate = eval_inverse_park_transform_batch,
+    .reference = ref_inverse_park,
+  },
+  {
+    .name = "svpwm_generate",
+    .args = {
+      { "theta_e", -MATH_PI, MATH_TWO_PI, ACCURACY_GRID_2D, ACCURACY_SPACING_LINEAR },
+      { "vref_mag", 0.0f, 1.0f, ACCURACY_GRID_2D, ACCURACY_SPACING_LINEAR },
+    },
+    .num_args = 2U,
+    .outputs = {
+      { "duty_a", ACCURACY_OUTPUT_VALUE, 1.0, 1e-6 },
+      { "duty_b", ACCURACY_OUTPUT_VALUE, 1.0, 1e-6 },
+      { "duty_c", ACCURACY_OUTPUT_VALUE, 1.0, 1e-6 },
+    },
+    .num_outputs = 3U,
+    .evaluate = eval_svpwm_generate,
+    .reference = ref_svpwm_generate,
+  },
+  {
+    .name = "svpwm_generate_batch",
+    .args = {
+      { "theta_e", -ACCURACY_BATCH_ANGLE_RANGE, ACCURACY_BATCH_ANGLE_RANGE, ACCURACY_GRID_2D, ACCURACY_SPACING_LINEAR },
+      { "vref_mag", 0.0f, 1.0f, ACCURACY_GRID_2D, ACCURACY_SPACING_LINEAR },
+    },
+    .num_args = 2U,
+    .outputs = {
+      { "duty_a", ACCURACY_OUTPUT_VALUE, 1.0, 5e-7 },
+      { "duty_b", ACCURACY_OUTPUT_VALUE, 1.0, 5e-7 },
+      { "duty_c", ACCURACY_OUTPUT_VALUE, 1.0, 5e-7 },
+    },
+    .num_outputs = 3U,
+    .evaluate = eval_svpwm_generate_batch,
+    .reference = ref_svpwm_generate,
+  },
+};
+
+const struct AccuracyKernel_t *accuracy_kernels_get(size_t *num_kernels) {
+  *num_kernels = sizeof(s_kernels) / sizeof(s_kernels[0]);
+  return s_kernels;
+}
@@ -0,0 +1,414 @@
+/*******************************************************************************************************************************
+ * @file   accuracy_loop.c
+ *
+ * @brief  Source file for the closed-loop error of the math kernels
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "math_utils.h"
+#include "svpwm.h"
+#include "transform_batch.h"
+#include "transform_utils.h"
+
+/* Intra-component Headers */
+#include "accuracy_loop.h"
+
+#define LOOP_PI 3.14159265358979323846 /**< Pi in double precision */
+
+/* Motor, close to the simulator's default PMSM */
+#define LOOP_POLE_PAIRS 7U     /**< Pole pairs */
+#define LOOP_RS 0.5            /**< Phase resistance (ohm) */
+#define LOOP_LS 1e-3           /**< Phase inductance, the same on both axes (H) */
+#define LOOP_FLUX_LINKAGE 0.01 /**< Permanent magnet flux linkage (Wb) */
+#define LOOP_INERTIA 1e-4      /**< Rotor and load inertia (kg m^2) */
+#define LOOP_FRICTION 1e-5     /**< Viscous friction (Nm s/rad) */
+#define LOOP_DC_VOLTAGE 24.0   /**< Bus voltage (V) */
+
+/* Control */
+#define LOOP_PERIOD 50e-6             /**< Control period (s) */
+#define LOOP_SUBSTEPS 10U             /**< Motor integration steps per control period */
+#define LOOP_CURRENT_KP 2.0           /**< Current controller gain, 2000 rad/s bandwidth (V/A) */
+#define LOOP_CURRENT_KI 1000.0        /**< Current controller integral gain (V/As) */
+#define LOOP_SPEED_KP 0.095           /**< Speed controller gain, 100 rad/s bandwidth (A s/rad) */
+#define LOOP_SPEED_KI 1.9             /**< Speed controller integral gain (A/rad) */
+#define LOOP_CURRENT_LIMIT 10.0       /**< q-axis current limit (A) */
+#define LOOP_MAX_MODULATION 0.8660254 /**< Linear modulation limit, as the sensorless driver clamps it */
+
+/* Scenario */
+#define LOOP_DURATION 0.5     /**< Run length (s) */
+#define LOOP_SPEED_REF 150.0  /**< Mechanical speed reference, reversed at LOOP_REVERSE_TIME (rad/s) */
+#define LOOP_LOAD_TIME 0.2    /**< Time the load torque is applied at (s) */
+#define LOOP_LOAD_TORQUE 0.5  /**< Load torque (Nm) */
+#define LOOP_REVERSE_TIME 0.3 /**< Time the speed reference is reversed at (s) */
+
+/**
+ * @brief   Trace of one closed-loop run
+ */
+struct LoopTrace_t {
+  double *torque;                 /**< Electromagnetic torque at the end of each step (Nm) */
+  double *speed;                  /**< Mechanical speed at the end of each step (rad/s) */
+  double *angle;                  /**< Unwrapped rotor electrical angle at the end of each step (rad) */
+  double control_angle_max_error; /**< Largest error of the electrical angle the controller used (rad) */
+  uint32_t num_failures;          /**< Steps a kernel failed in */
+};
+
+/**
+ * @brief   Proportional-integral controller with a clamped output and integrator
+ */
+struct LoopPi_t {
+  double kp;         /**< Proportional gain */
+  double ki;         /**< Integral gain */
+  double limit;      /**< Output limit, either sign */
+  double integrator; /**< Integral term */
+};
+
+static double limit(double value, double bound) {
+  return (value > bound) ? bound : ((value < -bound) ? -bound : value);
+}
+
+static double pi_update(struct LoopPi_t *pi, double error) {
+  pi->integrator = limit(pi->integrator + pi->ki * error * LOOP_PERIOD, pi->limit);
+  return limit(pi->kp * error + pi->integrator, pi->limit);
+}
+
+static double wrap_angle(double angle) {
+  double wrapped = fmod(angle, 2.0 * LOOP_PI);
+  return (wrapped < 0.0) ? wrapped + 2.0 * LOOP_PI : wrapped;
+}
+
+/* Double precision set */
+
+static double ref_elec_angle(double mech_angle) {
+  return wrap_angle(mech_angle * LOOP_POLE_PAIRS);
+}
+
+static bool ref_clarke(double ia, double ib, double ic, double *alpha, double *beta) {
+  *alpha = ia;
+  *beta = (ib - ic) / sqrt(3.0);
+  return true;
+}
+
+static bool ref_park(double alpha, double beta, double theta, double *d, double *q) {
+  *d = alpha * cos(theta) + beta * sin(theta);
+  *q = -alpha * sin(theta) + beta * cos(theta);
+  return true;
+}
+
+static bool ref_inverse_park(double d, double q, double theta, double *alpha, double *beta) {
+  *alpha = d * cos(theta) - q * sin(theta);
+  *beta = d * sin(theta) + q * cos(theta);
+  return true;
+}
+
+static double ref_magnitude(double x, double y) {
+  return sqrt(x * x + y * y);
+}
+
+static bool ref_svpwm(double theta, double modulation, double *duties) {
+  double v[3];
+
+  for (int phase = 0; phase < 3; phase++) {
+    v[phase] = (2.0 * modulation / 3.0) * cos(theta - (double)phase * 2.0 * LOOP_PI / 3.0);
+  }
+
+  double offset = 0.5 - 0.5 * (fmax(v[0], fmax(v[1], v[2])) + fmin(v[0], fmin(v[1], v[2])));
+
+  for (int phase = 0; phase < 3; phase++) {
+    duties[phase] = v[phase] + offset;
+  }
+
+  return true;
+}
+
+static const struct AccuracyLoopMath_t s_reference = {
+  .name = "double",
+  .elec_angle = ref_elec_angle,
+  .clarke = ref_clarke,
+  .park = ref_park,
+  .inverse_park = ref_inverse_park,
+  .magnitude = ref_magnitude,
+  .angle = atan2,
+  .svpwm = ref_svpwm,
+};
+
+/* Float kernels of the motor core */
+
+static double core_elec_angle(double mech_angle) {
+  return mech_to_elec_angle((float)mech_angle, LOOP_POLE_PAIRS);
+}
+
+static bool core_clarke(double ia, double ib, double ic, double *alpha, double *beta) {
+  float alpha_out, beta_out;
+  bool is_ok = clarke_transform_3phase((float)ia, (float)ib, (float)ic, &alpha_out, &beta_out) == UTILS_OK;
+
+  *alpha = alpha_out;
+  *beta = beta_out;
+  return is_ok;
+}
+
+static bool core_park(double alpha, double beta, double theta, double *d, double *q) {
+  float d_out, q_out;
+  bool is_ok = park_transform((float)alpha, (float)beta, (float)theta, &d_out, &q_out) == UTILS_OK;
+
+  *d = d_out;
+  *q = q_out;
+  return is_ok;
+}
+
+static bool core_inverse_park(double d, double q, double theta, double *alpha, double *beta) {
+  float alpha_out, beta_out;
+  bool is_ok = inverse_park_transform((float)d, (float)q, (float)theta, &alpha_out, &beta_out) == UTILS_OK;
+
+  *alpha = alpha_out;
+  *beta = beta_out;
+  return is_ok;
+}
+
+static double core_magnitude(double x, double y) {
+  float x_f = (float)x;
+  float y_f = (float)y;
+
+  return sqrtf(x_f * x_f + y_f * y_f);
+}
+
+static double core_angle(double y, double x) {
+  return atan2f((float)y, (float)x);
+}
+
+static bool core_svpwm(double theta, double modulation, double *duties) {
+  float duty_a, duty_b, duty_c;
+  bool is_ok = svpwm_generate((float)theta, (float)modulation, &duty_a, &duty_b, &duty_c) == UTILS_OK;
+
+  duties[0] = duty_a;
+  duties[1] = duty_b;
+  duties[2] = duty_c;
+  return is_ok;
+}
+
+/* Array kernels of the visualizer library, one sample at a time */
+
+static bool batch_clarke(double ia, double ib, double ic, double *alpha, double *beta) {
+  float in[3] = { (float)ia, (float)ib, (float)ic };
+  float alpha_out, beta_out;
+  bool is_ok = clarke_transform_batch(&in[0], &in[1], &in[2], &alpha_out, &beta_out, 1U) == UTILS_OK;
+
+  *alpha = alpha_out;
+  *beta = beta_out;
+  return is_ok;
+}
+
+static bool batch_park(double alpha, double beta, double theta, double *d, double *q) {
+  float in[3] = { (float)alpha, (float)beta, (float)theta };
+  float d_out, q_out;
+  bool is_ok = park_transform_batch(&in[0], &in[1], &in[2], &d_out, &q_out, 1U) == UTILS_OK;
+
+  *d = d_out;
+  *q = q_out;
+  return is_ok;
+}
+
+static bool batch_inverse_park(double d, double q, double theta, double *alpha, double *beta) {
+  float in[3] = { (float)d, (float)q, (float)theta };
+  float alpha_out, beta_out;
+  bool is_ok = inverse_park_transform_batch(&in[0], &in[1], &in[2], &alpha_out, &beta_out, 1U) == UTILS_OK;
+
+  *alpha = alpha_out;
+  *beta = beta_out;
+  return is_ok;
+}
+
+static bool batch_svpwm(double theta, double modulation, double *duties) {
+  float in[2] = { (float)theta, (float)modulation };
+  float duty_a, duty_b, duty_c;
+  bool is_ok = svpwm_generate_batch(&in[0], &in[1], &duty_a, &duty_b, &duty_c, 1U) == UTILS_OK;
+
+  duties[0] = duty_a;
+  duties[1] = duty_b;
+  duties[2] = duty_c;
+  return is_ok;
+}
+
+/*
+ * Budgets are the largest errors measured with headroom, a kernel change that breaches one moves the loop itself.
+ * An electrical angle error of 1 mrad puts 0.1% of the current in the wrong axis
+ */
+static const struct AccuracyLoopMath_t s_math[] = {
+  {
+    .name = "motor_core",
+    .elec_angle = core_elec_angle,
+    .clarke = core_clarke,
+    .park = core_park,
+    .inverse_park = core_inverse_park,
+    .magnitude = core_magnitude,
+    .angle = core_angle,
+    .svpwm = core_svpwm,
+    .budget_torque = 5e-6,
+    .budget_angle = 2e-5,
+  },
+  {
+    .name = "batch",
+    .elec_angle = core_elec_angle,
+    .clarke = batch_clarke,
+    .park = batch_park,
+    .inverse_park = batch_inverse_park,
+    .magnitude = core_magnitude,
+    .angle = core_angle,
+    .svpwm = batch_svpwm,
+    .budget_torque = 5e-6,
+    .budget_angle = 2e-5,
+  },
+};
+
+/* Advance the motor by one control period with the phase voltages of the duty cycles */
+static void step_motor(const double *duties, double load_torque, double *state) {
+  double mean = (duties[0] + duties[1] + duties[2]) / 3.0;
+  double v_alpha = (duties[0] - mean) * LOOP_DC_VOLTAGE;
+  double v_beta = (duties[1] - duties[2]) * LOOP_DC_VOLTAGE / sqrt(3.0);
+  double dt = LOOP_PERIOD / LOOP_SUBSTEPS;
+
+  /* state: id, iq, mechanical speed, unwrapped mechanical angle */
+  for (uint32_t sub = 0U; sub < LOOP_SUBSTEPS; sub++) {
+    double theta_e = state[3] * LOOP_POLE_PAIRS;
+    double omega_e = state[2] * LOOP_POLE_PAIRS;
+    double v_d = v_alpha * cos(theta_e) + v_beta * sin(theta_e);
+    double v_q = -v_alpha * sin(theta_e) + v_beta * cos(theta_e);
+    double torque = 1.5 * LOOP_POLE_PAIRS * LOOP_FLUX_LINKAGE * state[1];
+
+    double did = (v_d - LOOP_RS * state[0] + omega_e * LOOP_LS * state[1]) / LOOP_LS;
+    double diq = (v_q - LOOP_RS * state[1] - omega_e * (LOOP_LS * state[0] + LOOP_FLUX_LINKAGE)) / LOOP_LS;
+    double domega = (torque - load_torque - LOOP_FRICTION * state[2]) / LOOP_INERTIA;
+
+    state[0] += did * dt;
+    state[1] += diq * dt;
+    state[3] += state[2] * dt;
+    state[2] += domega * dt;
+  }
+}
+
+static void run_loop(const struct AccuracyLoopMath_t *math, uint32_t num_steps, struct LoopTrace_t *trace) {
+  double state[4] = { 0.0, 0.0, 0.0, 0.0 };
+  double duties[3] = { 0.5, 0.5, 0.5 };
+  struct LoopPi_t speed_pi = { .kp = LOOP_SPEED_KP, .ki = LOOP_SPEED_KI, .limit = LOOP_CURRENT_LIMIT };
+  struct LoopPi_t id_pi = { .kp = LOOP_CURRENT_KP, .ki = LOOP_CURRENT_KI, .limit = LOOP_DC_VOLTAGE };
+  struct LoopPi_t iq_pi = id_pi;
+
+  trace->control_angle_max_error = 0.0;
+  trace->num_failures = 0U;
+
+  for (uint32_t step = 0U; step < num_steps; step++) {
+    double time = step * LOOP_PERIOD;
+    double theta_e = state[3] * LOOP_POLE_PAIRS;
+    double i_alpha = state[0] * cos(theta_e) - state[1] * sin(theta_e);
+    double i_beta = state[0] * sin(theta_e) + state[1] * cos(theta_e);
+    double i_a = i_alpha;
+    double i_b = -0.5 * i_alpha + 0.5 * sqrt(3.0) * i_beta;
+    bool is_ok = true;
+
+    /* The encoder reads the mechanical angle wrapped to a turn */
+    double angle = math->elec_angle(wrap_angle(state[3]));
+    double error = fabs(remainder(angle - theta_e, 2.0 * LOOP_PI));
+    trace->control_angle_max_error = (error > trace->control_angle_max_error) ? error : trace->control_angle_max_error;
+
+    double alpha, beta, d, q;
+    is_ok = math->clarke(i_a, i_b, -i_a - i_b, &alpha, &beta) && is_ok;
+    is_ok = math->park(alpha, beta, angle, &d, &q) && is_ok;
+
+    double speed_ref = (time < LOOP_REVERSE_TIME) ? LOOP_SPEED_REF : -LOOP_SPEED_REF;
+    double iq_ref = pi_update(&speed_pi, speed_ref - state[2]);
+    double v_d = pi_update(&id_pi, 0.0 - d);
+    double v_q = pi_update(&iq_pi, iq_ref - q);
+
+    /* Modulation as the sensorless driver forms it, from the stationary frame voltage */
+    double v_alpha, v_beta;
+    double new_duties[3];
+    is_ok = math->inverse_park(v_d, v_q, angle, &v_alpha, &v_beta) && is_ok;
+
+    double modulation = 1.5 * math->magnitude(v_alpha, v_beta) / LOOP_DC_VOLTAGE;
+    modulation = (modulation > LOOP_MAX_MODULATION) ? LOOP_MAX_MODULATION : modulation;
+    is_ok = math->svpwm(math->angle(v_beta, v_alpha), modulation, new_duties) && is_ok;
+
+    /* A failed step keeps the previous duty cycles, as the drivers do */
+    if (is_ok) {
+      memcpy(duties, new_duties, sizeof(duties));
+    } else {
+      trace->num_failures++;
+    }
+
+    step_motor(duties, (time < LOOP_LOAD_TIME) ? 0.0 : LOOP_LOAD_TORQUE, state);
+
+    trace->torque[step] = 1.5 * LOOP_POLE_PAIRS * LOOP_FLUX_LINKAGE * state[1];
+    trace->speed[step] = state[2];
+    trace->angle[step] = state[3] * LOOP_POLE_PAIRS;
+  }
+}
+
+static bool alloc_trace(struct LoopTrace_t *trace, uint32_t num_steps) {
+  trace->torque = calloc(num_steps, sizeof(double));
+  trace->speed = calloc(num_steps, sizeof(double));
+  trace->angle = calloc(num_steps, sizeof(double));
+  return trace->torque != NULL && trace->speed != NULL && trace->angle != NULL;
+}
+
+static void free_trace(struct LoopTrace_t *trace) {
+  free(trace->torque);
+  free(trace->speed);
+  free(trace->angle);
+}
+
+const struct AccuracyLoopMath_t *accuracy_loop_math_get(size_t *num_math) {
+  *num_math = sizeof(s_math) / sizeof(s_math[0]);
+  return s_math;
+}
+
+int accuracy_loop_compare(const struct AccuracyLoopMath_t *math, struct AccuracyLoopResult_t *result) {
+  uint32_t num_steps = (uint32_t)(LOOP_DURATION / LOOP_PERIOD + 0.5);
+  struct LoopTrace_t reference = { 0 };
+  struct LoopTrace_t trace = { 0 };
+
+  memset(result, 0, sizeof(*result));
+  result->math = math;
+  result->num_steps = num_steps;
+
+  if (!alloc_trace(&reference, num_steps) || !alloc_trace(&trace, num_steps)) {
+    free_trace(&reference);
+    free_trace(&trace);
+    return -1;
+  }
+
+  run_loop(&s_reference, num_steps, &reference);
+  run_loop(math, num_steps, &trace);
+
+  double sum_sq_torque = 0.0;
+
+  for (uint32_t step = 0U; step < num_steps; step++) {
+    double torque_error = fabs(trace.torque[step] - reference.torque[step]);
+    double speed_error = fabs(trace.speed[step] - reference.speed[step]);
+    double angle_error = fabs(trace.angle[step] - reference.angle[step]);
+
+    sum_sq_torque += torque_error * torque_error;
+    result->torque_max_error = fmax(result->torque_max_error, torque_error);
+    result->speed_max_error = fmax(result->speed_max_error, speed_error);
+    result->angle_max_error = fmax(result->angle_max_error, angle_error);
+  }
+
+  result->num_failures = trace.num_failures;
+  result->torque_rms_error = sqrt(sum_sq_torque / num_steps);
+  result->control_angle_max_error = trace.control_angle_max_error;
+
+  free_trace(&reference);
+  free_trace(&trace);
+  return 0;
+}
+
+bool accuracy_loop_is_over_budget(const struct AccuracyLoopResult_t *result) {
+  return result->num_failures > 0U || result->torque_max_error > result->math->budget_torque ||
+         result->angle_max_error > result->math->budget_angle || result->control_angle_max_error > result->math->budget_angle;
+}
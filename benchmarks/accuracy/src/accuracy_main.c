@@ -0,0 +1,258 @@
+/*******************************************************************************************************************************
+ * @file   accuracy_main.c
+ *
+ * @brief  Main file for the math kernel accuracy harness
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "accuracy.h"
+#include "accuracy_kernels.h"
+#include "accuracy_loop.h"
+
+#define ACCURACY_LOOP_PREFIX "closed_loop_" /**< Prefix of the closed-loop runs, for the filters */
+
+/**
+ * @brief   Command line options
+ */
+struct AccuracyCliOptions_t {
+  const char *json_path;            /**< File to write the outcomes to, NULL for none */
+  struct AccuracyOptions_t compare; /**< Comparison settings */
+};
+
+static void print_usage(const char *program) {
+  fprintf(stderr, "usage: %s [--json PATH] [--random N] [--seed N] [FILTER...]\n", program);
+  fprintf(stderr, "  Compares the kernels whose names contain a filter with double precision, every kernel without filters.\n");
+  fprintf(stderr, "  Closed-loop runs are named %s<math>. Exits with 1 if a kernel is past its accuracy budget.\n",
+          ACCURACY_LOOP_PREFIX);
+}
+
+/* Positive number of a numeric option, 0 when the value is missing or not a positive number */
+static uint32_t read_count(const char *value) {
+  char *end = NULL;
+  unsigned long count = (value != NULL) ? strtoul(value, &end, 0) : 0UL;
+
+  return (end != NULL && *end == '\0') ? (uint32_t)count : 0U;
+}
+
+/**
+ * @brief   Read the options, given before or between the filters
+ * @return  Number of filters, moved to the front of argv, or -1 on a bad option
+ */
+static int parse_options(int argc, char **argv, struct AccuracyCliOptions_t *options) {
+  int num_filters = 0;
+
+  for (int arg = 1; arg < argc; arg++) {
+    const char *value = (arg + 1 < argc) ? argv[arg + 1] : NULL;
+    uint32_t count = read_count(value);
+
+    if (strcmp(argv[arg], "--json") == 0 && value != NULL) {
+      options->json_path = value;
+      arg++;
+    } else if (strcmp(argv[arg], "--random") == 0 && value != NULL && (count > 0U || strcmp(value, "0") == 0)) {
+      options->compare.num_random_inputs = count;
+      arg++;
+    } else if (strcmp(argv[arg], "--seed") == 0 && count > 0U) {
+      options->compare.seed = count;
+      arg++;
+    } else if (strncmp(argv[arg], "--", 2) == 0) {
+      print_usage(argv[0]);
+      return -1;
+    } else {
+      argv[1 + num_filters++] = argv[arg];
+    }
+  }
+
+  return num_filters;
+}
+
+/* Without filters every name is selected */
+static bool is_selected(const char *prefix, const char *name, char **filters, int num_filters) {
+  char full_name[64];
+  bool selected = (num_filters == 0);
+
+  snprintf(full_name, sizeof(full_name), "%s%s", prefix, name);
+
+  for (int i = 0; i < num_filters; i++) {
+    selected = selected || (strstr(full_name, filters[i]) != NULL);
+  }
+
+  return selected;
+}
+
+static void print_args(FILE *file, const struct AccuracyKernel_t *kernel, const float *args) {
+  for (uint32_t arg = 0U; arg < kernel->num_args; arg++) {
+    fprintf(file, "%s%s=%.9g", (arg > 0U) ? " " : "", kernel->args[arg].name, (double)args[arg]);
+  }
+}
+
+static void print_result(const struct AccuracyResult_t *result) {
+  const struct AccuracyKernel_t *kernel = result->kernel;
+
+  for (uint32_t out = 0U; out < kernel->num_outputs; out++) {
+    const struct AccuracyStats_t *stats = &result->outputs[out];
+    bool is_over = stats->max_abs > kernel->outputs[out].budget_abs;
+
+    printf("%-30s %-9s %10.3e %10.3e %10.3e %10.1f %10.1e %-4s ", (out == 0U) ? kernel->name : "", kernel->outputs[out].name,
+           stats->max_abs, accuracy_stats_rms(stats), stats->max_rel, stats->max_ulp, kernel->outputs[out].budget_abs,
+           is_over ? "OVER" : "ok");
+    print_args(stdout, kernel, stats->worst_args);
+    printf("\n");
+  }
+
+  if (result->num_failures > 0U) {
+    printf("%-30s failed on %u inputs, first: ", "", result->num_failures);
+    print_args(stdout, kernel, result->first_failure);
+    printf("\n");
+  }
+}
+
+static void print_loop_result(const struct AccuracyLoopResult_t *result) {
+  printf("%s%-18s %10.3e %10.3e %10.3e %10.3e %10.3e %8u %s\n", ACCURACY_LOOP_PREFIX, result->math->name, result->torque_max_error,
+         result->torque_rms_error, result->speed_max_error, result->angle_max_error, result->control_angle_max_error,
+         result->num_failures, accuracy_loop_is_over_budget(result) ? "OVER" : "ok");
+}
+
+static void write_json(FILE *file, const struct AccuracyResult_t *results, size_t num_results,
+                       const struct AccuracyLoopResult_t *loop_results, size_t num_loop_results, const struct AccuracyOptions_t *options) {
+  fprintf(file, "{\n  \"random_inputs\": %u,\n  \"seed\": %u,\n  \"kernels\": [\n", options->num_random_inputs, options->seed);
+
+  for (size_t i = 0U; i < num_results; i++) {
+    const struct AccuracyKernel_t *kernel = results[i].kernel;
+
+    fprintf(file, "    {\"name\": \"%s\", \"failures\": %u, \"over_budget\": %s, \"outputs\": [\n", kernel->name,
+            results[i].num_failures, accuracy_is_over_budget(&results[i]) ? "true" : "false");
+
+    for (uint32_t out = 0U; out < kernel->num_outputs; out++) {
+      const struct AccuracyStats_t *stats = &results[i].outputs[out];
+
+      fprintf(file,
+              "      {\"name\": \"%s\", \"count\": %llu, \"max_abs\": %.6e, \"rms_abs\": %.6e, \"max_rel\": %.6e, "
+              "\"max_ulp\": %.3f, \"budget_abs\": %.6e, \"worst_input\": [",
+              kernel->outputs[out].name, (unsigned long long)stats->count, stats->max_abs, accuracy_stats_rms(stats),
+              stats->max_rel, stats->max_ulp, kernel->outputs[out].budget_abs);
+
+      for (uint32_t arg = 0U; arg < kernel->num_args; arg++) {
+        fprintf(file, "%s%.9g", (arg > 0U) ? ", " : "", (double)stats->worst_args[arg]);
+      }
+
+      fprintf(file, "]}%s\n", (out + 1U < kernel->num_outputs) ? "," : "");
+    }
+
+    fprintf(file, "    ]}%s\n", (i + 1U < num_results) ? "," : "");
+  }
+
+  fprintf(file, "  ],\n  \"closed_loop\": [\n");
+
+  for (size_t i = 0U; i < num_loop_results; i++) {
+    const struct AccuracyLoopResult_t *result = &loop_results[i];
+
+    fprintf(file,
+            "    {\"name\": \"%s\", \"steps\": %u, \"failures\": %u, \"torque_max_error\": %.6e, \"torque_rms_error\": %.6e, "
+            "\"speed_max_error\": %.6e, \"angle_max_error\": %.6e, \"control_angle_max_error\": %.6e, "
+            "\"budget_torque\": %.6e, \"budget_angle\": %.6e, \"over_budget\": %s}%s\n",
+            result->math->name, result->num_steps, result->num_failures, result->torque_max_error, result->torque_rms_error,
+            result->speed_max_error, result->angle_max_error, result->control_angle_max_error, result->math->budget_torque,
+            result->math->budget_angle, accuracy_loop_is_over_budget(result) ? "true" : "false",
+            (i + 1U < num_loop_results) ? "," : "");
+  }
+
+  fprintf(file, "  ]\n}\n");
+}
+
+int main(int argc, char **argv) {
+  struct AccuracyCliOptions_t options = {
+    .compare = {
+      .num_random_inputs = ACCURACY_DEFAULT_NUM_RANDOM_INPUTS,
+      .seed = ACCURACY_DEFAULT_SEED,
+    },
+  };
+  size_t num_kernels = 0U;
+  size_t num_math = 0U;
+  const struct AccuracyKernel_t *kernels = accuracy_kernels_get(&num_kernels);
+  const struct AccuracyLoopMath_t *math = accuracy_loop_math_get(&num_math);
+  int num_filters = parse_options(argc, argv, &options);
+
+  if (num_filters < 0) {
+    return 2;
+  }
+
+  struct AccuracyResult_t *results = calloc(num_kernels, sizeof(*results));
+  struct AccuracyLoopResult_t *loop_results = calloc(num_math, sizeof(*loop_results));
+  size_t num_results = 0U;
+  size_t num_loop_results = 0U;
+  bool is_over_budget = false;
+
+  if (results == NULL || loop_results == NULL) {
+    fprintf(stderr, "out of memory\n");
+    free(results);
+    free(loop_results);
+    return 2;
+  }
+
+  printf("%u random inputs per kernel after the grid, relative errors floored at %g of the output scale\n",
+         options.compare.num_random_inputs, ACCURACY_RELATIVE_FLOOR);
+  printf("%-30s %-9s %10s %10s %10s %10s %10s %-4s %s\n", "kernel", "output", "max_abs", "rms_abs", "max_rel", "max_ulp", "budget",
+         "", "worst input");
+
+  for (size_t i = 0U; i < num_kernels; i++) {
+    if (!is_selected("", kernels[i].name, &argv[1], num_filters)) {
+      continue;
+    }
+
+    accuracy_compare(&kernels[i], &options.compare, &results[num_results]);
+    is_over_budget = is_over_budget || accuracy_is_over_budget(&results[num_results]);
+    print_result(&results[num_results]);
+    fflush(stdout);
+    num_results++;
+  }
+
+  printf("\n%-30s %10s %10s %10s %10s %10s %8s\n", "closed loop, error from double", "torque_max", "torque_rms", "speed_max",
+         "angle_max", "ctrl_angle", "failures");
+
+  for (size_t i = 0U; i < num_math; i++) {
+    if (!is_selected(ACCURACY_LOOP_PREFIX, math[i].name, &argv[1], num_filters)) {
+      continue;
+    }
+
+    if (accuracy_loop_compare(&math[i], &loop_results[num_loop_results]) != 0) {
+      fprintf(stderr, "%s: could not allocate the traces\n", math[i].name);
+      free(results);
+      free(loop_results);
+      return 2;
+    }
+
+    is_over_budget = is_over_budget || accuracy_loop_is_over_budget(&loop_results[num_loop_results]);
+    print_loop_result(&loop_results[num_loop_results]);
+    num_loop_results++;
+  }
+
+  if (options.json_path != NULL) {
+    FILE *file = fopen(options.json_path, "w");
+
+    if (file == NULL) {
+      perror(options.json_path);
+      free(results);
+      free(loop_results);
+      return 2;
+    }
+
+    write_json(file, results, num_results, loop_results, num_loop_results, &options.compare);
+    fclose(file);
+  }
+
+  free(results);
+  free(loop_results);
+  return is_over_budget ? 1 : 0;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   bench.h
+ *
+ * @brief  Header file for the motor core microbenchmark harness
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup Bench Microbenchmark harness
+ * @brief    Times batches of calls and reports the median and 99th percentile cost of one call
+ * @details  A batch runs a fixed number of calls between two clock reads, so the timer costs little per call. The cost of
+ *           a call in a batch is the batch time, less the cost of reading the clock, over the calls. Percentiles are
+ *           taken over the batches
+ * @{
+ */
+
+#define BENCH_MAX_NAME_LENGTH 48U        /**< Longest benchmark name, with its terminator */
+#define BENCH_DEFAULT_NUM_BATCHES 2000U  /**< Timed batches per benchmark and round */
+#define BENCH_DEFAULT_NUM_ROUNDS 5U      /**< Rounds over the benchmarks, the fastest round of each is kept */
+#define BENCH_DEFAULT_TOLERANCE 1.2f     /**< Regression threshold on the median, a ratio to the baseline */
+#define BENCH_DEFAULT_P99_TOLERANCE 3.0f /**< Regression threshold on the 99th percentile, a ratio to the baseline */
+#define BENCH_DEFAULT_SLACK_NS 1.0f      /**< Regression allowance on top of the ratios, for the shortest calls (ns) */
+
+/**
+ * @brief   Named benchmark
+ */
+struct BenchCase_t {
+  const char *name;            /**< Name in the report and the baseline */
+  void (*setup)(void);         /**< Run once before the timed batches, NULL for none */
+  void (*run)(uint32_t calls); /**< Run a batch of calls */
+  uint32_t calls_per_batch;    /**< Calls per batch */
+};
+
+/**
+ * @brief   Cost of one call of a benchmark
+ */
+struct BenchResult_t {
+  char name[BENCH_MAX_NAME_LENGTH]; /**< Benchmark name */
+  double median_ns;                 /**< Median cost of a call (ns) */
+  double p99_ns;                    /**< 99th percentile cost of a call (ns) */
+};
+
+/**
+ * @brief   Thresholds past which a result is a regression
+ */
+struct BenchTolerance_t {
+  double median;   /**< Largest median as a ratio to the baseline */
+  double p99;      /**< Largest 99th percentile as a ratio to the baseline */
+  double slack_ns; /**< Allowance on top of both ratios (ns) */
+};
+
+/**
+ * @brief   Stored results to compare against
+ */
+struct BenchBaseline_t {
+  struct BenchTolerance_t tolerance; /**< Thresholds of the comparison */
+  struct BenchResult_t *results;     /**< Stored results */
+  size_t num_results;                /**< Number of stored results */
+};
+
+/**
+ * @brief   Keep a value alive, so the compiler cannot drop the call producing it
+ * @param   value Result of a benchmarked call
+ */
+void bench_consume(float value);
+
+/**
+ * @brief   Fill an array with repeatable pseudo-random inputs
+ * @param   inputs Array to fill
+ * @param   count Number of inputs
+ * @param   min Smallest input
+ * @param   max Largest input
+ */
+void bench_fill_inputs(float *inputs, uint32_t count, float min, float max);
+
+/**
+ * @brief   Time a benchmark
+ * @param   bench Benchmark to run
+ * @param   num_batches Timed batches, after a tenth as many untimed ones
+ * @param   result Pointer to store the cost of one call
+ * @return  0 if successful, -1 if out of memory
+ */
+int bench_measure(const struct BenchCase_t *bench, uint32_t num_batches, struct BenchResult_t *result);
+
+/**
+ * @brief   Write results as JSON
+ * @param   file File to write
+ * @param   results Results to write
+ * @param   num_results Number of results
+ * @param   tolerance Thresholds to store along, so the file can serve as a baseline
+ */
+void bench_write_json(FILE *file, const struct BenchResult_t *results, size_t num_results, const struct BenchTolerance_t *tolerance);
+
+/**
+ * @brief   Read a baseline written by bench_write_json()
+ * @param   path File to read
+ * @param   baseline Pointer to store the baseline, released with bench_free_baseline()
+ * @return  0 if successful, -1 if the file could not be read
+ */
+int bench_load_baseline(const char *path, struct BenchBaseline_t *baseline);
+
+/**
+ * @brief   Release a baseline
+ * @param   baseline Baseline read by bench_load_baseline()
+ */
+void bench_free_baseline(struct BenchBaseline_t *baseline);
+
+/**
+ * @brief   Compare a result with its baseline
+ * @param   result Result to check
+ * @param   baseline Baseline to compare against
+ * @param   stored Pointer to store the baseline entry of the result, NULL when it has none
+ * @return  TRUE if the result is past a threshold of its baseline entry
+ */
+bool bench_is_regression(const struct BenchResult_t *result, const struct BenchBaseline_t *baseline, const struct BenchResult_t **stored);
+
+/** @} */
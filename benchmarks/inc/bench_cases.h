@@ -0,0 +1,190 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   bench_cases.h
+ *
+ * @brief  Header file for the motor core benchmarks
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdint.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup BenchCases Motor core benchmarks
+ * @brief    Batches of calls into the utilities, the FOC blocks and whole control cycles of each driver
+ * @details  Every run function makes the given number of calls on inputs cycling through a table, so the branch
+ *           predictors do not learn a single path. Control cycles run against the no-op HAL and the synthetic rotor.
+ *           A driver that faults on the synthetic inputs, a sensorless startup timing out, is restarted in place
+ * @{
+ */
+
+/**
+ * @brief   Fill the input tables of the utility benchmarks
+ */
+void bench_utils_setup(void);
+
+/**
+ * @brief   fast_sin_cos() over angles of several turns either way
+ * @param   calls Number of calls
+ */
+void bench_fast_sin_cos(uint32_t calls);
+
+/**
+ * @brief   normalize_angle() over angles of several turns either way
+ * @param   calls Number of calls
+ */
+void bench_normalize_angle(uint32_t calls);
+
+/**
+ * @brief   mech_to_elec_angle() over a mechanical turn
+ * @param   calls Number of calls
+ */
+void bench_mech_to_elec_angle(uint32_t calls);
+
+/**
+ * @brief   fast_inv_sqrt() over five decades
+ * @param   calls Number of calls
+ */
+void bench_fast_inv_sqrt(uint32_t calls);
+
+/**
+ * @brief   clamp() with inputs below, inside and above the range
+ * @param   calls Number of calls
+ */
+void bench_clamp(uint32_t calls);
+
+/**
+ * @brief   clarke_transform_2phase()
+ * @param   calls Number of calls
+ */
+void bench_clarke_transform_2phase(uint32_t calls);
+
+/**
+ * @brief   clarke_transform_3phase()
+ * @param   calls Number of calls
+ */
+void bench_clarke_transform_3phase(uint32_t calls);
+
+/**
+ * @brief   park_transform()
+ * @param   calls Number of calls
+ */
+void bench_park_transform(uint32_t calls);
+
+/**
+ * @brief   inverse_park_transform()
+ * @param   calls Number of calls
+ */
+void bench_inverse_park_transform(uint32_t calls);
+
+/**
+ * @brief   svpwm_generate() over every sector and into overmodulation
+ * @param   calls Number of calls
+ */
+void bench_svpwm_generate(uint32_t calls);
+
+/**
+ * @brief   Initialize the controller of the PID benchmark
+ */
+void bench_pid_setup(void);
+
+/**
+ * @brief   pid_update() of a PID with a filtered derivative
+ * @param   calls Number of calls
+ */
+void bench_pid_update(uint32_t calls);
+
+/**
+ * @brief   Initialize a PLL with fixed gains
+ */
+void bench_pll_setup(void);
+
+/**
+ * @brief   Initialize a type-3 PLL with scheduled gains
+ */
+void bench_pll_scheduled_setup(void);
+
+/**
+ * @brief   pll_update() of the PLL set up last
+ * @param   calls Number of calls
+ */
+void bench_pll_update(uint32_t calls);
+
+/**
+ * @brief   Initialize the estimator of the Hall benchmark
+ */
+void bench_hall_estimator_setup(void);
+
+/**
+ * @brief   hall_estimator_update() on a rotor crossing a sector every few calls
+ * @param   calls Number of calls
+ */
+void bench_hall_estimator_update(uint32_t calls);
+
+/**
+ * @brief   Fill the rotating voltage and current tables of the FOC benchmarks
+ */
+void bench_foc_setup(void);
+
+/**
+ * @brief   field_weakening_update() around the voltage limit
+ * @param   calls Number of calls
+ */
+void bench_field_weakening_update(uint32_t calls);
+
+/**
+ * @brief   Create and initialize a back-EMF PLL observer
+ */
+void bench_backemf_pll_observer_setup(void);
+
+/**
+ * @brief   Create and initialize a high-frequency injection observer
+ */
+void bench_hfi_observer_setup(void);
+
+/**
+ * @brief   Update of the observer set up last
+ * @param   calls Number of calls
+ */
+void bench_observer_update(uint32_t calls);
+
+/**
+ * @brief   Initialize the sensored FOC driver on the synthetic rotor, following a q-axis current
+ */
+void bench_foc_sensored_setup(void);
+
+/**
+ * @brief   Initialize the sensorless FOC driver on the synthetic rotor, following a q-axis current
+ */
+void bench_foc_sensorless_setup(void);
+
+/**
+ * @brief   motor_run() cycles of the FOC driver set up last
+ * @param   calls Number of calls
+ */
+void bench_foc_motor_run(uint32_t calls);
+
+/**
+ * @brief   Initialize the sensored 6-step driver on the synthetic rotor at a fixed voltage
+ */
+void bench_6step_sensored_setup(void);
+
+/**
+ * @brief   Initialize the sensorless 6-step driver on the synthetic rotor at a fixed voltage
+ */
+void bench_6step_sensorless_setup(void);
+
+/**
+ * @brief   motor_run() cycles of the 6-step driver set up last
+ * @param   calls Number of calls
+ */
+void bench_6step_motor_run(uint32_t calls);
+
+/** @} */
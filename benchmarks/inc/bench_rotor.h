@@ -0,0 +1,44 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   bench_rotor.h
+ *
+ * @brief  Header file for the synthetic rotor feeding the no-op HAL during motor_run() benchmarks
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdint.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup BenchRotor Synthetic rotor
+ * @brief    Rotor turning at a constant speed, read by the drivers through the no-op HAL
+ * @details  Currents, terminal voltages, Hall states and the encoder angle come from tables over one electrical
+ *           revolution filled once, so a control cycle costs the drivers a few table reads on top of their own work.
+ *           Nothing reacts to the drivers' outputs
+ * @{
+ */
+
+#define BENCH_ROTOR_CONTROL_PERIOD_US 50U /**< Control loop period (us), 20 kHz */
+#define BENCH_ROTOR_POLE_PAIRS 7U         /**< Pole pairs of the motor configurations */
+
+/**
+ * @brief   Stop the clock at zero and set the rotor turning
+ * @param   electrical_speed Electrical speed (rad/s)
+ * @param   current_amplitude Peak phase current, leading the back-EMF by 90 degrees as for torque (A)
+ * @param   bemf_amplitude Peak phase back-EMF, about the half bus voltage (V)
+ */
+void bench_rotor_reset(float electrical_speed, float current_amplitude, float bemf_amplitude);
+
+/**
+ * @brief   Move the rotor and the clock on by one control period and update the HAL inputs
+ */
+void bench_rotor_step(void);
+
+/** @} */
@@ -0,0 +1,114 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   replay.h
+ *
+ * @brief  Header file for the recorded control-loop player
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Inter-component Headers */
+#include "hal_replay.h"
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup Replay Control-loop replay
+ * @brief    Records the application calls of a simulator run next to its HAL calls and plays them back on the replay HAL
+ * @details  The recording build of the simulator marks each driver creation, initialization, setpoint, module setter and
+ *           motor_run() call, logs the HAL calls made inside it and marks the returned error. The player repeats the
+ *           marked calls in order on a fresh motor, so the control code reads the recorded inputs and its outputs can be
+ *           compared with the recording bit for bit
+ * @{
+ */
+
+#define REPLAY_MAX_MARK_SIZE 512U  /**< Largest mark payload, a module configuration and its gain points */
+#define REPLAY_MAX_GAIN_POINTS 16U /**< Largest PLL gain schedule a setter mark can restore */
+
+/**
+ * @brief   Application events of a recording, in the trace's mark kind byte
+ */
+typedef enum {
+  REPLAY_MARK_CREATE,       /**< Driver creation: ReplayDriver_t byte and its argument byte */
+  REPLAY_MARK_INIT,         /**< driver.init(), the MotorConfig_t */
+  REPLAY_MARK_DEINIT,       /**< driver.deinit() */
+  REPLAY_MARK_SET_VOLTAGE,  /**< driver.set_voltage(), the float */
+  REPLAY_MARK_SET_CURRENT,  /**< driver.set_current(), the float */
+  REPLAY_MARK_SET_VELOCITY, /**< driver.set_velocity(), the float */
+  REPLAY_MARK_SET_POSITION, /**< driver.set_position(), the float */
+  REPLAY_MARK_SET_TORQUE,   /**< driver.set_torque(), the float */
+  REPLAY_MARK_RUN,          /**< motor_run() */
+  REPLAY_MARK_RETURN,       /**< Error returned by the call marked before, an int32_t */
+  REPLAY_MARK_SETTER,       /**< Module setter: ReplaySetter_t byte and the configuration */
+  NUM_REPLAY_MARKS
+} ReplayMark_t;
+
+/**
+ * @brief   Drivers a recording can create
+ */
+typedef enum {
+  REPLAY_DRIVER_6STEP_SENSORED,   /**< bldc_6step_sensored_create_driver() */
+  REPLAY_DRIVER_6STEP_SENSORLESS, /**< bldc_6step_sensorless_create_driver() */
+  REPLAY_DRIVER_FOC_SENSORED,     /**< foc_sensored_create_driver() */
+  REPLAY_DRIVER_FOC_SENSORLESS,   /**< foc_sensorless_create_driver(), the argument is the observer type */
+  NUM_REPLAY_DRIVERS
+} ReplayDriver_t;
+
+/**
+ * @brief   Module setters a recording can call. A PLL configuration is followed by a count byte and its gain points
+ */
+typedef enum {
+  REPLAY_SETTER_6STEP_SENSORED_PWM_SCHEME,         /**< bldc_6step_sensored_set_pwm_scheme() */
+  REPLAY_SETTER_6STEP_SENSORED_POSITION,           /**< bldc_6step_sensored_set_position_config() */
+  REPLAY_SETTER_6STEP_SENSORLESS_PWM_SCHEME,       /**< bldc_6step_sensorless_set_pwm_scheme() */
+  REPLAY_SETTER_6STEP_SENSORLESS_STARTUP,          /**< bldc_6step_sensorless_set_startup_config() */
+  REPLAY_SETTER_6STEP_SENSORLESS_FLYING_START,     /**< bldc_6step_sensorless_set_flying_start_config() */
+  REPLAY_SETTER_6STEP_SENSORLESS_INITIAL_POSITION, /**< bldc_6step_sensorless_set_initial_position_config() */
+  REPLAY_SETTER_6STEP_SENSORLESS_COMMUTATION,      /**< bldc_6step_sensorless_set_commutation_config() */
+  REPLAY_SETTER_6STEP_SENSORLESS_ZERO_CROSSING,    /**< bldc_6step_sensorless_set_zero_crossing_config() */
+  REPLAY_SETTER_6STEP_SENSORLESS_POSITION,         /**< bldc_6step_sensorless_set_position_config() */
+  REPLAY_SETTER_FOC_SENSORED_POSITION_SOURCE,      /**< foc_sensored_set_position_source() */
+  REPLAY_SETTER_FOC_SENSORLESS_BACKEMF_PLL,        /**< foc_sensorless_set_backemf_pll_config() */
+  REPLAY_SETTER_FOC_SENSORLESS_HFI,                /**< foc_sensorless_set_hfi_config() */
+  REPLAY_SETTER_FOC_SENSORLESS_STARTUP,            /**< foc_sensorless_set_startup_config() */
+  REPLAY_SETTER_FOC_SENSORLESS_FLYING_START,       /**< foc_sensorless_set_flying_start_config() */
+  NUM_REPLAY_SETTERS
+} ReplaySetter_t;
+
+/**
+ * @brief   Outcome and timing of one pass over a trace
+ */
+struct ReplayResult_t {
+  uint32_t num_runs;           /**< motor_run() calls replayed */
+  uint32_t num_bad_marks;      /**< Marks the player could not apply, the pass stops at the first */
+  uint64_t run_ns_total;       /**< Time spent in motor_run() (ns) */
+  uint64_t run_ns_max;         /**< Longest motor_run() call (ns) */
+  uint64_t pass_ns;            /**< Time of the whole pass (ns) */
+  struct HalReplayStats_t hal; /**< Replay HAL outcome */
+};
+
+/**
+ * @brief   Play a trace once from a fresh motor
+ * @param   data Trace bytes
+ * @param   size Number of bytes
+ * @param   sink Receiver of the trace the pass produces, NULL for none
+ * @param   context Argument passed to the sink
+ * @param   result Pointer to store the outcome
+ * @return  0 if the trace was played, -1 if its header is not a supported trace
+ */
+int replay_run(const uint8_t *data, uint32_t size, HalTraceSink_t sink, void *context, struct ReplayResult_t *result);
+
+/**
+ * @brief   Check whether a pass reproduced its recording
+ * @param   result Outcome of the pass
+ * @return  TRUE if every event was consumed with identical outputs
+ */
+bool replay_is_exact(const struct ReplayResult_t *result);
+
+/** @} */
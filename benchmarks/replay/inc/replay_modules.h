@@ -0,0 +1,73 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   replay_modules.h
+ *
+ * @brief  Header file for the driver creations and module setters the player repeats
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Inter-component Headers */
+#include "motor.h"
+
+/* Intra-component Headers */
+#include "replay.h"
+
+/**
+ * @addtogroup Replay
+ * @{
+ */
+
+/**
+ * @brief   Copy a value out of a mark payload
+ * @param   data Payload bytes
+ * @param   size Bytes of payload
+ * @param   value Pointer to store the value
+ * @param   value_size Bytes of the value
+ * @return  TRUE if the payload holds the value
+ */
+bool replay_read_value(const uint8_t *data, uint32_t size, void *value, size_t value_size);
+
+/**
+ * @brief   Create a 6-step driver
+ * @param   motor Motor to create the driver in
+ * @param   driver Driver to create
+ * @return  TRUE if driver is a 6-step driver
+ */
+bool replay_6step_create(struct Motor_t *motor, ReplayDriver_t driver);
+
+/**
+ * @brief   Call a 6-step module setter
+ * @param   setter Setter to call
+ * @param   data Configuration bytes
+ * @param   size Bytes of configuration
+ * @return  TRUE if setter is a 6-step setter and the configuration is complete
+ */
+bool replay_6step_apply_setter(ReplaySetter_t setter, const uint8_t *data, uint32_t size);
+
+/**
+ * @brief   Create a FOC driver
+ * @param   motor Motor to create the driver in
+ * @param   driver Driver to create
+ * @param   arg Observer type of a sensorless driver
+ * @return  TRUE if driver is a FOC driver
+ */
+bool replay_foc_create(struct Motor_t *motor, ReplayDriver_t driver, uint8_t arg);
+
+/**
+ * @brief   Call a FOC module setter, restoring the gain schedule of a PLL configuration
+ * @param   setter Setter to call
+ * @param   data Configuration bytes
+ * @param   size Bytes of configuration
+ * @return  TRUE if setter is a FOC setter and the configuration is complete
+ */
+bool replay_foc_apply_setter(ReplaySetter_t setter, const uint8_t *data, uint32_t size);
+
+/** @} */
@@ -0,0 +1,74 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   replay_record.h
+ *
+ * @brief  Header file for the application side of a simulator recording
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Inter-component Headers */
+#include "motor.h"
+#include "pll.h"
+
+/* Intra-component Headers */
+#include "replay.h"
+
+/**
+ * @addtogroup Replay
+ * @{
+ */
+
+/**
+ * @brief   Mark a call and log the HAL calls it makes, the trace file is opened by the first recorded call
+ * @param   mark Kind of call
+ * @param   payload Arguments of the call
+ * @param   size Bytes of arguments
+ * @return  TRUE if the call is the outermost and was marked
+ */
+bool replay_record_enter(ReplayMark_t mark, const void *payload, uint32_t size);
+
+/**
+ * @brief   End a call started with replay_record_enter() and mark its error
+ * @param   is_outer Value returned by replay_record_enter()
+ * @param   err Error returned by the call
+ * @return  err
+ */
+MotorError_t replay_record_leave(bool is_outer, MotorError_t err);
+
+/**
+ * @brief   Mark a module setter with a copy of its configuration
+ * @details The gain schedule of a PLL configuration is a pointer, its points follow the configuration after a count byte
+ *          and the pointer is stored as NULL so two recordings of a run are identical
+ * @param   setter Setter called
+ * @param   config Configuration passed to it
+ * @param   config_size Bytes of configuration
+ * @param   pll PLL configuration inside config, NULL for none
+ * @param   pll_offset Offset of the PLL configuration in config
+ * @return  TRUE if the call is the outermost and was marked
+ */
+bool replay_record_enter_setter(ReplaySetter_t setter, const void *config, size_t config_size, const struct PLLConfig_t *pll,
+                                size_t pll_offset);
+
+/**
+ * @brief   End a setter started with replay_record_enter_setter()
+ * @param   is_outer Value returned by replay_record_enter_setter()
+ */
+void replay_record_leave_setter(bool is_outer);
+
+/**
+ * @brief   Mark a driver creation and route the driver calls of the motor through the recorder
+ * @param   motor Motor the driver was created in
+ * @param   driver Driver created
+ * @param   arg Argument of the creation, the observer type of a sensorless FOC driver
+ */
+void replay_record_create(struct Motor_t *motor, ReplayDriver_t driver, uint8_t arg);
+
+/** @} */
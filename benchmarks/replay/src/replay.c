@@ -0,0 +1,196 @@
+/*******************************************************************************************************************************
+ * @file   replay.c
+ *
+ * @brief  Source file for the recorded control-loop player
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+/* Inter-component Headers */
+#include "motor.h"
+
+/* Intra-component Headers */
+#include "replay_modules.h"
+
+/**
+ * @brief   Motor driven by the player, the driver keeps a pointer to the configuration
+ */
+struct ReplayPlayer_t {
+  struct Motor_t motor;        /**< Motor under replay */
+  struct MotorConfig_t config; /**< Configuration of the last init */
+};
+
+static struct ReplayPlayer_t s_player;
+
+static inline uint64_t now_ns(void) {
+  struct timespec time;
+
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+}
+
+bool replay_read_value(const uint8_t *data, uint32_t size, void *value, size_t value_size) {
+  if (size < value_size) {
+    return false;
+  }
+
+  memcpy(value, data, value_size);
+  return true;
+}
+
+static bool apply_setter(const uint8_t *payload, uint32_t size) {
+  if (size < 1U) {
+    return false;
+  }
+
+  ReplaySetter_t setter = (ReplaySetter_t)payload[0];
+
+  return replay_6step_apply_setter(setter, &payload[1], size - 1U) || replay_foc_apply_setter(setter, &payload[1], size - 1U);
+}
+
+static bool create_driver(const uint8_t *payload, uint32_t size) {
+  if (size != 2U) {
+    return false;
+  }
+
+  memset(&s_player.motor, 0, sizeof(s_player.motor));
+
+  return replay_6step_create(&s_player.motor, (ReplayDriver_t)payload[0]) ||
+         replay_foc_create(&s_player.motor, (ReplayDriver_t)payload[0], payload[1]);
+}
+
+/* A setpoint mark calls the matching driver function, a driver without one returns MOTOR_INVALID_ARGS as a null motor would */
+static bool call_setpoint(ReplayMark_t mark, const uint8_t *payload, uint32_t size, MotorError_t *err) {
+  struct MotorDriver_t *driver = &s_player.motor.driver;
+  MotorError_t (*set)(struct Motor_t *motor, float value) = NULL;
+  float value;
+
+  if (!replay_read_value(payload, size, &value, sizeof(value))) {
+    return false;
+  }
+
+  switch (mark) {
+    case REPLAY_MARK_SET_VOLTAGE:
+      set = driver->set_voltage;
+      break;
+
+    case REPLAY_MARK_SET_CURRENT:
+      set = driver->set_current;
+      break;
+
+    case REPLAY_MARK_SET_VELOCITY:
+      set = driver->set_velocity;
+      break;
+
+    case REPLAY_MARK_SET_POSITION:
+      set = driver->set_position;
+      break;
+
+    default:
+      set = driver->set_torque;
+      break;
+  }
+
+  *err = (set != NULL) ? set(&s_player.motor, value) : MOTOR_INVALID_ARGS;
+  return true;
+}
+
+static void expect_return(MotorError_t err) {
+  int32_t code = (int32_t)err;
+
+  hal_replay_expect_mark(REPLAY_MARK_RETURN, &code, sizeof(code));
+}
+
+/**
+ * @brief   Repeat one marked call
+ * @return  TRUE if the mark could be applied
+ */
+static bool apply_mark(ReplayMark_t mark, const uint8_t *payload, uint32_t size, struct ReplayResult_t *result) {
+  MotorError_t err = MOTOR_OK;
+
+  switch (mark) {
+    case REPLAY_MARK_CREATE:
+      return create_driver(payload, size);
+
+    case REPLAY_MARK_INIT:
+      if (size != sizeof(s_player.config) || s_player.motor.driver.init == NULL) {
+        return false;
+      }
+      memcpy(&s_player.config, payload, sizeof(s_player.config));
+      err = s_player.motor.driver.init(&s_player.motor, &s_player.config);
+      break;
+
+    case REPLAY_MARK_DEINIT:
+      if (s_player.motor.driver.deinit == NULL) {
+        return false;
+      }
+      err = s_player.motor.driver.deinit(&s_player.motor);
+      break;
+
+    case REPLAY_MARK_SET_VOLTAGE:
+    case REPLAY_MARK_SET_CURRENT:
+    case REPLAY_MARK_SET_VELOCITY:
+    case REPLAY_MARK_SET_POSITION:
+    case REPLAY_MARK_SET_TORQUE:
+      if (!call_setpoint(mark, payload, size, &err)) {
+        return false;
+      }
+      break;
+
+    case REPLAY_MARK_RUN: {
+      uint64_t start = now_ns();
+      err = motor_run(&s_player.motor);
+      uint64_t elapsed = now_ns() - start;
+
+      result->num_runs++;
+      result->run_ns_total += elapsed;
+      result->run_ns_max = (elapsed > result->run_ns_max) ? elapsed : result->run_ns_max;
+      break;
+    }
+
+    /* Setters return nothing */
+    case REPLAY_MARK_SETTER:
+      return apply_setter(payload, size);
+
+    default:
+      return false;
+  }
+
+  expect_return(err);
+  return true;
+}
+
+int replay_run(const uint8_t *data, uint32_t size, HalTraceSink_t sink, void *context, struct ReplayResult_t *result) {
+  uint8_t kind;
+  const uint8_t *payload;
+  uint32_t payload_size;
+
+  memset(result, 0, sizeof(*result));
+
+  if (!hal_replay_start(data, size, sink, context)) {
+    return -1;
+  }
+
+  uint64_t start = now_ns();
+
+  while (hal_replay_next_mark(&kind, &payload, &payload_size)) {
+    if (!apply_mark((ReplayMark_t)kind, payload, payload_size, result)) {
+      result->num_bad_marks++;
+      break;
+    }
+  }
+
+  result->pass_ns = now_ns() - start;
+  hal_replay_finish(&result->hal);
+  return 0;
+}
+
+bool replay_is_exact(const struct ReplayResult_t *result) {
+  return result->num_bad_marks == 0U && result->hal.num_mismatches == 0U && result->hal.is_complete;
+}
@@ -0,0 +1,120 @@
+/*******************************************************************************************************************************
+ * @file   replay_6step.c
+ *
+ * @brief  Source file for the 6-step driver creations and setters of the player
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+#include "bldc_6step_sensored.h"
+#include "bldc_6step_sensorless.h"
+
+/* Intra-component Headers */
+#include "replay_modules.h"
+
+bool replay_6step_create(struct Motor_t *motor, ReplayDriver_t driver) {
+  switch (driver) {
+    case REPLAY_DRIVER_6STEP_SENSORED:
+      bldc_6step_sensored_create_driver(motor);
+      return true;
+
+    case REPLAY_DRIVER_6STEP_SENSORLESS:
+      bldc_6step_sensorless_create_driver(motor);
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+bool replay_6step_apply_setter(ReplaySetter_t setter, const uint8_t *data, uint32_t size) {
+  switch (setter) {
+    case REPLAY_SETTER_6STEP_SENSORED_PWM_SCHEME: {
+      BLDC6StepPwmScheme_t scheme;
+      if (!replay_read_value(data, size, &scheme, sizeof(scheme))) {
+        return false;
+      }
+      bldc_6step_sensored_set_pwm_scheme(scheme);
+      return true;
+    }
+
+    case REPLAY_SETTER_6STEP_SENSORED_POSITION: {
+      struct BLDC6StepPositionConfig_t config;
+      if (!replay_read_value(data, size, &config, sizeof(config))) {
+        return false;
+      }
+      bldc_6step_sensored_set_position_config(&config);
+      return true;
+    }
+
+    case REPLAY_SETTER_6STEP_SENSORLESS_PWM_SCHEME: {
+      BLDC6StepPwmScheme_t scheme;
+      if (!replay_read_value(data, size, &scheme, sizeof(scheme))) {
+        return false;
+      }
+      bldc_6step_sensorless_set_pwm_scheme(scheme);
+      return true;
+    }
+
+    case REPLAY_SETTER_6STEP_SENSORLESS_STARTUP: {
+      struct BLDC6StepStartupConfig_t config;
+      if (!replay_read_value(data, size, &config, sizeof(config))) {
+        return false;
+      }
+      bldc_6step_sensorless_set_startup_config(&config);
+      return true;
+    }
+
+    case REPLAY_SETTER_6STEP_SENSORLESS_FLYING_START: {
+      struct BLDC6StepFlyingStartConfig_t config;
+      if (!replay_read_value(data, size, &config, sizeof(config))) {
+        return false;
+      }
+      bldc_6step_sensorless_set_flying_start_config(&config);
+      return true;
+    }
+
+    case REPLAY_SETTER_6STEP_SENSORLESS_INITIAL_POSITION: {
+      struct BLDC6StepInitialPositionConfig_t config;
+      if (!replay_read_value(data, size, &config, sizeof(config))) {
+        return false;
+      }
+      bldc_6step_sensorless_set_initial_position_config(&config);
+      return true;
+    }
+
+    case REPLAY_SETTER_6STEP_SENSORLESS_COMMUTATION: {
+      struct BLDC6StepCommutationConfig_t config;
+      if (!replay_read_value(data, size, &config, sizeof(config))) {
+        return false;
+      }
+      bldc_6step_sensorless_set_commutation_config(&config);
+      return true;
+    }
+
+    case REPLAY_SETTER_6STEP_SENSORLESS_ZERO_CROSSING: {
+      struct BLDC6StepZeroCrossingConfig_t config;
+      if (!replay_read_value(data, size, &config, sizeof(config))) {
+        return false;
+      }
+      bldc_6step_sensorless_set_zero_crossing_config(&config);
+      return true;
+    }
+
+    case REPLAY_SETTER_6STEP_SENSORLESS_POSITION: {
+      struct BLDC6StepPositionConfig_t config;
+      if (!replay_read_value(data, size, &config, sizeof(config))) {
+        return false;
+      }
+      bldc_6step_sensorless_set_position_config(&config);
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
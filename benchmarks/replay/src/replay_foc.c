@@ -0,0 +1,106 @@
+/*******************************************************************************************************************************
+ * @file   replay_foc.c
+ *
+ * @brief  Source file for the FOC driver creations and setters of the player
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <string.h>
+
+/* Inter-component Headers */
+#include "foc_sensored.h"
+#include "foc_sensorless.h"
+
+/* Intra-component Headers */
+#include "replay_modules.h"
+
+static struct PLLGainPoint_t s_backemf_points[REPLAY_MAX_GAIN_POINTS]; /**< Gain schedule of the back-EMF PLL setter */
+static struct PLLGainPoint_t s_hfi_points[REPLAY_MAX_GAIN_POINTS];     /**< Gain schedule of the HFI setter */
+
+/* The gain points follow the configuration after a count byte, see replay_record.c */
+static bool read_pll_config(const uint8_t *data, uint32_t size, void *config, size_t config_size, struct PLLConfig_t *pll,
+                            struct PLLGainPoint_t *points) {
+  if (!replay_read_value(data, size, config, config_size) || size < config_size + 1U) {
+    return false;
+  }
+
+  uint8_t num_points = data[config_size];
+
+  if (num_points > REPLAY_MAX_GAIN_POINTS || size != config_size + 1U + num_points * sizeof(*points)) {
+    return false;
+  }
+
+  memcpy(points, &data[config_size + 1U], num_points * sizeof(*points));
+  pll->gain_schedule = (num_points > 0U) ? points : NULL;
+  return true;
+}
+
+bool replay_foc_create(struct Motor_t *motor, ReplayDriver_t driver, uint8_t arg) {
+  switch (driver) {
+    case REPLAY_DRIVER_FOC_SENSORED:
+      foc_sensored_create_driver(motor);
+      return true;
+
+    case REPLAY_DRIVER_FOC_SENSORLESS:
+      foc_sensorless_create_driver(motor, (FOCObserverType_t)arg);
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+bool replay_foc_apply_setter(ReplaySetter_t setter, const uint8_t *data, uint32_t size) {
+  switch (setter) {
+    case REPLAY_SETTER_FOC_SENSORED_POSITION_SOURCE: {
+      FOCPositionSource_t source;
+      if (!replay_read_value(data, size, &source, sizeof(source))) {
+        return false;
+      }
+      foc_sensored_set_position_source(source);
+      return true;
+    }
+
+    case REPLAY_SETTER_FOC_SENSORLESS_BACKEMF_PLL: {
+      struct BackEMFPLLConfig_t config;
+      if (!read_pll_config(data, size, &config, sizeof(config), &config.pll_cfg, s_backemf_points)) {
+        return false;
+      }
+      foc_sensorless_set_backemf_pll_config(&config);
+      return true;
+    }
+
+    case REPLAY_SETTER_FOC_SENSORLESS_HFI: {
+      struct HFIObserverConfig_t config;
+      if (!read_pll_config(data, size, &config, sizeof(config), &config.pll_cfg, s_hfi_points)) {
+        return false;
+      }
+      foc_sensorless_set_hfi_config(&config);
+      return true;
+    }
+
+    case REPLAY_SETTER_FOC_SENSORLESS_STARTUP: {
+      struct FOCSensorlessStartupConfig_t config;
+      if (!replay_read_value(data, size, &config, sizeof(config))) {
+        return false;
+      }
+      foc_sensorless_set_startup_config(&config);
+      return true;
+    }
+
+    case REPLAY_SETTER_FOC_SENSORLESS_FLYING_START: {
+      struct FOCSensorlessFlyingStartConfig_t config;
+      if (!replay_read_value(data, size, &config, sizeof(config))) {
+        return false;
+      }
+      foc_sensorless_set_flying_start_config(&config);
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
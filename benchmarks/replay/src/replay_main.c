@@ -0,0 +1,227 @@
+/*******************************************************************************************************************************
+ * @file   replay_main.c
+ *
+ * @brief  Main file for the recorded control-loop player
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "replay.h"
+
+/**
+ * @brief   Command line options
+ */
+struct ReplayCliOptions_t {
+  const char *trace_path; /**< Recorded trace */
+  const char *out_path;   /**< File to write the trace of the first pass to, NULL for none */
+  const char *json_path;  /**< File to write the outcome to, NULL for none */
+  uint32_t num_passes;    /**< Passes over the trace, for profiling */
+};
+
+static void print_usage(const char *program) {
+  fprintf(stderr, "usage: %s [--out PATH] [--repeat N] [--json PATH] TRACE\n", program);
+  fprintf(stderr, "  Plays a trace recorded by sim_bldc_record through motor_run() and compares every output bit for bit.\n");
+  fprintf(stderr, "  --out writes the trace this build produces, identical to TRACE when nothing changed. Exits with 1 on a\n");
+  fprintf(stderr, "  difference in any pass. A pass starts from the module settings the previous one left, so --repeat only\n");
+  fprintf(stderr, "  reproduces traces that set every module they rely on.\n");
+}
+
+/* Positive number of a numeric option, 0 when the value is missing or not a positive number */
+static uint32_t read_count(const char *value) {
+  char *end = NULL;
+  unsigned long count = (value != NULL) ? strtoul(value, &end, 0) : 0UL;
+
+  return (end != NULL && *end == '\0') ? (uint32_t)count : 0U;
+}
+
+/**
+ * @brief   Read the options, given before or after the trace
+ * @return  0 on success, -1 on a bad option or without exactly one trace
+ */
+static int parse_options(int argc, char **argv, struct ReplayCliOptions_t *options) {
+  for (int arg = 1; arg < argc; arg++) {
+    const char *value = (arg + 1 < argc) ? argv[arg + 1] : NULL;
+    uint32_t count = read_count(value);
+
+    if (strcmp(argv[arg], "--out") == 0 && value != NULL) {
+      options->out_path = value;
+      arg++;
+    } else if (strcmp(argv[arg], "--json") == 0 && value != NULL) {
+      options->json_path = value;
+      arg++;
+    } else if (strcmp(argv[arg], "--repeat") == 0 && count > 0U) {
+      options->num_passes = count;
+      arg++;
+    } else if (strncmp(argv[arg], "--", 2) == 0 || options->trace_path != NULL) {
+      print_usage(argv[0]);
+      return -1;
+    } else {
+      options->trace_path = argv[arg];
+    }
+  }
+
+  if (options->trace_path == NULL) {
+    print_usage(argv[0]);
+    return -1;
+  }
+
+  return 0;
+}
+
+static uint8_t *load_file(const char *path, uint32_t *size) {
+  FILE *file = fopen(path, "rb");
+  uint8_t *data = NULL;
+  long length = -1L;
+
+  if (file == NULL) {
+    perror(path);
+    return NULL;
+  }
+
+  if (fseek(file, 0L, SEEK_END) == 0) {
+    length = ftell(file);
+  }
+
+  if (length > 0L && (unsigned long)length <= UINT32_MAX && fseek(file, 0L, SEEK_SET) == 0) {
+    data = malloc((size_t)length);
+
+    if (data != NULL && fread(data, 1U, (size_t)length, file) != (size_t)length) {
+      free(data);
+      data = NULL;
+    }
+  }
+
+  fclose(file);
+
+  if (data == NULL) {
+    fprintf(stderr, "%s: could not read the trace\n", path);
+    return NULL;
+  }
+
+  *size = (uint32_t)length;
+  return data;
+}
+
+static void file_sink(const uint8_t *data, uint32_t size, void *context) {
+  fwrite(data, 1U, size, (FILE *)context);
+}
+
+static void print_result(uint32_t pass, const struct ReplayResult_t *result) {
+  const struct HalReplayStats_t *hal = &result->hal;
+  double mean_ns = (result->num_runs > 0U) ? (double)result->run_ns_total / (double)result->num_runs : 0.0;
+
+  printf("%-6u %10u %12llu %10.1f %10llu %10.3f %10llu %s\n", pass, result->num_runs, (unsigned long long)hal->num_events, mean_ns,
+         (unsigned long long)result->run_ns_max, (double)result->pass_ns * 1e-6, (unsigned long long)hal->num_mismatches,
+         replay_is_exact(result) ? "exact" : "DIFFERS");
+
+  if (hal->num_mismatches > 0U) {
+    printf("       first mismatch at event %llu (%s)\n", (unsigned long long)hal->first_mismatch_event,
+           hal_trace_tag_name(hal->first_mismatch_tag));
+  }
+
+  if (hal->is_diverged) {
+    printf("       diverged at event %llu: trace has %s, code called %s\n", (unsigned long long)hal->divergence_event,
+           (hal->expected_tag < NUM_HAL_TRACE_TAGS) ? hal_trace_tag_name(hal->expected_tag) : "end of trace",
+           hal_trace_tag_name(hal->actual_tag));
+  } else if (result->num_bad_marks > 0U) {
+    printf("       stopped at event %llu on a mark the player cannot apply\n", (unsigned long long)hal->num_events);
+  } else if (!hal->is_complete) {
+    printf("       trace not fully consumed after event %llu\n", (unsigned long long)hal->num_events);
+  }
+}
+
+static void write_json(FILE *file, const struct ReplayCliOptions_t *options, const struct ReplayResult_t *results, uint32_t num_passes) {
+  fprintf(file, "{\n  \"trace\": \"%s\",\n  \"passes\": [\n", options->trace_path);
+
+  for (uint32_t pass = 0U; pass < num_passes; pass++) {
+    const struct ReplayResult_t *result = &results[pass];
+
+    fprintf(file,
+            "    {\"runs\": %u, \"events\": %llu, \"timer_fires\": %llu, \"run_ns_total\": %llu, \"run_ns_max\": %llu, "
+            "\"pass_ns\": %llu, \"mismatches\": %llu, \"diverged\": %s, \"complete\": %s, \"exact\": %s}%s\n",
+            result->num_runs, (unsigned long long)result->hal.num_events, (unsigned long long)result->hal.num_timer_fires,
+            (unsigned long long)result->run_ns_total, (unsigned long long)result->run_ns_max, (unsigned long long)result->pass_ns,
+            (unsigned long long)result->hal.num_mismatches, result->hal.is_diverged ? "true" : "false",
+            result->hal.is_complete ? "true" : "false", replay_is_exact(result) ? "true" : "false",
+            (pass + 1U < num_passes) ? "," : "");
+  }
+
+  fprintf(file, "  ]\n}\n");
+}
+
+int main(int argc, char **argv) {
+  struct ReplayCliOptions_t options = { .num_passes = 1U };
+  uint32_t size = 0U;
+
+  if (parse_options(argc, argv, &options) != 0) {
+    return 2;
+  }
+
+  uint8_t *data = load_file(options.trace_path, &size);
+  struct ReplayResult_t *results = calloc(options.num_passes, sizeof(*results));
+  FILE *out_file = NULL;
+  bool is_exact = true;
+
+  if (data == NULL || results == NULL) {
+    free(data);
+    free(results);
+    return 2;
+  }
+
+  if (options.out_path != NULL && (out_file = fopen(options.out_path, "wb")) == NULL) {
+    perror(options.out_path);
+    free(data);
+    free(results);
+    return 2;
+  }
+
+  printf("%u byte trace, motor_run() times in ns, pass times in ms\n", size);
+  printf("%-6s %10s %12s %10s %10s %10s %10s\n", "pass", "runs", "events", "run_mean", "run_max", "pass_ms", "mismatches");
+
+  /* Module state carries over between passes, as it would between two scenarios of one simulator run */
+  for (uint32_t pass = 0U; pass < options.num_passes; pass++) {
+    FILE *sink_file = (pass == 0U) ? out_file : NULL;
+
+    if (replay_run(data, size, (sink_file != NULL) ? file_sink : NULL, sink_file, &results[pass]) != 0) {
+      fprintf(stderr, "%s: not a supported trace\n", options.trace_path);
+      is_exact = false;
+      break;
+    }
+
+    is_exact = is_exact && replay_is_exact(&results[pass]);
+    print_result(pass, &results[pass]);
+  }
+
+  if (out_file != NULL) {
+    fclose(out_file);
+  }
+
+  if (options.json_path != NULL) {
+    FILE *file = fopen(options.json_path, "w");
+
+    if (file == NULL) {
+      perror(options.json_path);
+      free(data);
+      free(results);
+      return 2;
+    }
+
+    write_json(file, &options, results, options.num_passes);
+    fclose(file);
+  }
+
+  free(data);
+  free(results);
+  return is_exact ? 0 : 1;
+}
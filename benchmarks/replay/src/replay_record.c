@@ -0,0 +1,207 @@
+/*******************************************************************************************************************************
+ * @file   replay_record.c
+ *
+ * @brief  Source file for the application side of a simulator recording
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "hal_record.h"
+
+/* Intra-component Headers */
+#include "replay_record.h"
+
+#define REPLAY_RECORD_PATH_ENV "SIM_RECORD_TRACE"  /**< Environment variable naming the trace file */
+#define REPLAY_RECORD_DEFAULT_PATH "sim_trace.bin" /**< Trace file without the variable */
+
+/* Control code behind the wrapper, bound by the linker's --wrap */
+MotorError_t __real_motor_run(struct Motor_t *motor);
+
+/**
+ * @brief   Recording state
+ */
+struct ReplayRecordState_t {
+  FILE *file;                  /**< Trace file, opened by the first recorded call */
+  bool has_failed;             /**< The trace file could not be opened, nothing is recorded */
+  uint32_t depth;              /**< Recorded calls in progress, only the outermost is marked */
+  struct MotorDriver_t driver; /**< Functions of the last driver created, called by the driver wrappers */
+};
+
+static struct ReplayRecordState_t s_record;
+
+static void file_sink(const uint8_t *data, uint32_t size, void *context) {
+  fwrite(data, 1U, size, (FILE *)context);
+}
+
+static void close_trace(void) {
+  hal_record_stop();
+
+  if (s_record.file != NULL) {
+    fclose(s_record.file);
+    s_record.file = NULL;
+  }
+}
+
+static bool open_trace(void) {
+  if (hal_record_is_active()) {
+    return true;
+  }
+
+  if (s_record.has_failed) {
+    return false;
+  }
+
+  const char *path = getenv(REPLAY_RECORD_PATH_ENV);
+  path = (path != NULL && path[0] != '\0') ? path : REPLAY_RECORD_DEFAULT_PATH;
+
+  s_record.file = fopen(path, "wb");
+
+  if (s_record.file == NULL) {
+    perror(path);
+    s_record.has_failed = true;
+    return false;
+  }
+
+  hal_record_start(file_sink, s_record.file);
+  atexit(close_trace);
+  return true;
+}
+
+bool replay_record_enter(ReplayMark_t mark, const void *payload, uint32_t size) {
+  bool is_outer = (s_record.depth++ == 0U) && open_trace();
+
+  if (is_outer) {
+    hal_record_mark((uint8_t)mark, payload, size);
+    hal_record_set_capture(true);
+  }
+
+  return is_outer;
+}
+
+MotorError_t replay_record_leave(bool is_outer, MotorError_t err) {
+  s_record.depth--;
+
+  if (is_outer) {
+    int32_t code = (int32_t)err;
+
+    hal_record_set_capture(false);
+    hal_record_mark(REPLAY_MARK_RETURN, &code, sizeof(code));
+  }
+
+  return err;
+}
+
+void replay_record_leave_setter(bool is_outer) {
+  s_record.depth--;
+
+  if (is_outer) {
+    hal_record_set_capture(false);
+  }
+}
+
+bool replay_record_enter_setter(ReplaySetter_t setter, const void *config, size_t config_size, const struct PLLConfig_t *pll,
+                                size_t pll_offset) {
+  uint8_t payload[REPLAY_MAX_MARK_SIZE];
+  uint32_t size = 1U + (uint32_t)config_size;
+  uint8_t num_points = 0U;
+
+  if (config == NULL || size + 1U + REPLAY_MAX_GAIN_POINTS * sizeof(struct PLLGainPoint_t) > sizeof(payload)) {
+    return replay_record_enter(REPLAY_MARK_SETTER, NULL, 0U);
+  }
+
+  payload[0] = (uint8_t)setter;
+  memcpy(&payload[1], config, config_size);
+
+  if (pll != NULL) {
+    const struct PLLGainPoint_t *points = pll->gain_schedule;
+    const struct PLLGainPoint_t *no_points = NULL;
+
+    if (points != NULL) {
+      num_points = (pll->num_gain_points < REPLAY_MAX_GAIN_POINTS) ? pll->num_gain_points : REPLAY_MAX_GAIN_POINTS;
+    }
+
+    memcpy(&payload[1U + pll_offset + offsetof(struct PLLConfig_t, gain_schedule)], &no_points, sizeof(no_points));
+    payload[size++] = num_points;
+    memcpy(&payload[size], points, num_points * sizeof(*points));
+    size += num_points * (uint32_t)sizeof(*points);
+  }
+
+  return replay_record_enter(REPLAY_MARK_SETTER, payload, size);
+}
+
+static MotorError_t record_init(struct Motor_t *motor, struct MotorConfig_t *config) {
+  bool is_outer = replay_record_enter(REPLAY_MARK_INIT, config, (config != NULL) ? (uint32_t)sizeof(*config) : 0U);
+
+  return replay_record_leave(is_outer, s_record.driver.init(motor, config));
+}
+
+static MotorError_t record_deinit(struct Motor_t *motor) {
+  bool is_outer = replay_record_enter(REPLAY_MARK_DEINIT, NULL, 0U);
+
+  return replay_record_leave(is_outer, s_record.driver.deinit(motor));
+}
+
+static MotorError_t record_set_voltage(struct Motor_t *motor, float voltage) {
+  bool is_outer = replay_record_enter(REPLAY_MARK_SET_VOLTAGE, &voltage, sizeof(voltage));
+
+  return replay_record_leave(is_outer, s_record.driver.set_voltage(motor, voltage));
+}
+
+static MotorError_t record_set_current(struct Motor_t *motor, float current) {
+  bool is_outer = replay_record_enter(REPLAY_MARK_SET_CURRENT, &current, sizeof(current));
+
+  return replay_record_leave(is_outer, s_record.driver.set_current(motor, current));
+}
+
+static MotorError_t record_set_velocity(struct Motor_t *motor, float velocity) {
+  bool is_outer = replay_record_enter(REPLAY_MARK_SET_VELOCITY, &velocity, sizeof(velocity));
+
+  return replay_record_leave(is_outer, s_record.driver.set_velocity(motor, velocity));
+}
+
+static MotorError_t record_set_position(struct Motor_t *motor, float position) {
+  bool is_outer = replay_record_enter(REPLAY_MARK_SET_POSITION, &position, sizeof(position));
+
+  return replay_record_leave(is_outer, s_record.driver.set_position(motor, position));
+}
+
+static MotorError_t record_set_torque(struct Motor_t *motor, float torque) {
+  bool is_outer = replay_record_enter(REPLAY_MARK_SET_TORQUE, &torque, sizeof(torque));
+
+  return replay_record_leave(is_outer, s_record.driver.set_torque(motor, torque));
+}
+
+/* The driver table is a copy in the motor, so the application's calls through it are redirected here */
+void replay_record_create(struct Motor_t *motor, ReplayDriver_t driver, uint8_t arg) {
+  uint8_t payload[2] = { (uint8_t)driver, arg };
+
+  if (s_record.depth > 0U || !open_trace()) {
+    return;
+  }
+
+  hal_record_mark(REPLAY_MARK_CREATE, payload, sizeof(payload));
+
+  if (motor != NULL) {
+    s_record.driver = motor->driver;
+    motor->driver.init = (motor->driver.init != NULL) ? record_init : NULL;
+    motor->driver.deinit = (motor->driver.deinit != NULL) ? record_deinit : NULL;
+    motor->driver.set_voltage = (motor->driver.set_voltage != NULL) ? record_set_voltage : NULL;
+    motor->driver.set_current = (motor->driver.set_current != NULL) ? record_set_current : NULL;
+    motor->driver.set_velocity = (motor->driver.set_velocity != NULL) ? record_set_velocity : NULL;
+    motor->driver.set_position = (motor->driver.set_position != NULL) ? record_set_position : NULL;
+    motor->driver.set_torque = (motor->driver.set_torque != NULL) ? record_set_torque : NULL;
+  }
+}
+
+MotorError_t __wrap_motor_run(struct Motor_t *motor) {
+  bool is_outer = replay_record_enter(REPLAY_MARK_RUN, NULL, 0U);
+
+  return replay_record_leave(is_outer, __real_motor_run(motor));
+}
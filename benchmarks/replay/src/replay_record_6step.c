@@ -0,0 +1,104 @@
+/*******************************************************************************************************************************
+ * @file   replay_record_6step.c
+ *
+ * @brief  Source file for the recording of the 6-step driver calls
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stddef.h>
+
+/* Inter-component Headers */
+#include "bldc_6step_sensored.h"
+#include "bldc_6step_sensorless.h"
+
+/* Intra-component Headers */
+#include "replay_record.h"
+
+/* Control code behind the wrappers, bound by the linker's --wrap */
+void __real_bldc_6step_sensored_create_driver(struct Motor_t *motor);
+void __real_bldc_6step_sensorless_create_driver(struct Motor_t *motor);
+void __real_bldc_6step_sensored_set_pwm_scheme(BLDC6StepPwmScheme_t scheme);
+void __real_bldc_6step_sensored_set_position_config(const struct BLDC6StepPositionConfig_t *config);
+void __real_bldc_6step_sensorless_set_pwm_scheme(BLDC6StepPwmScheme_t scheme);
+void __real_bldc_6step_sensorless_set_startup_config(const struct BLDC6StepStartupConfig_t *config);
+void __real_bldc_6step_sensorless_set_flying_start_config(const struct BLDC6StepFlyingStartConfig_t *config);
+void __real_bldc_6step_sensorless_set_initial_position_config(const struct BLDC6StepInitialPositionConfig_t *config);
+void __real_bldc_6step_sensorless_set_commutation_config(const struct BLDC6StepCommutationConfig_t *config);
+void __real_bldc_6step_sensorless_set_zero_crossing_config(const struct BLDC6StepZeroCrossingConfig_t *config);
+void __real_bldc_6step_sensorless_set_position_config(const struct BLDC6StepPositionConfig_t *config);
+
+void __wrap_bldc_6step_sensored_create_driver(struct Motor_t *motor) {
+  __real_bldc_6step_sensored_create_driver(motor);
+  replay_record_create(motor, REPLAY_DRIVER_6STEP_SENSORED, 0U);
+}
+
+void __wrap_bldc_6step_sensorless_create_driver(struct Motor_t *motor) {
+  __real_bldc_6step_sensorless_create_driver(motor);
+  replay_record_create(motor, REPLAY_DRIVER_6STEP_SENSORLESS, 0U);
+}
+
+void __wrap_bldc_6step_sensored_set_pwm_scheme(BLDC6StepPwmScheme_t scheme) {
+  bool is_outer = replay_record_enter_setter(REPLAY_SETTER_6STEP_SENSORED_PWM_SCHEME, &scheme, sizeof(scheme), NULL, 0U);
+
+  __real_bldc_6step_sensored_set_pwm_scheme(scheme);
+  replay_record_leave_setter(is_outer);
+}
+
+void __wrap_bldc_6step_sensored_set_position_config(const struct BLDC6StepPositionConfig_t *config) {
+  bool is_outer = replay_record_enter_setter(REPLAY_SETTER_6STEP_SENSORED_POSITION, config, sizeof(*config), NULL, 0U);
+
+  __real_bldc_6step_sensored_set_position_config(config);
+  replay_record_leave_setter(is_outer);
+}
+
+void __wrap_bldc_6step_sensorless_set_pwm_scheme(BLDC6StepPwmScheme_t scheme) {
+  bool is_outer = replay_record_enter_setter(REPLAY_SETTER_6STEP_SENSORLESS_PWM_SCHEME, &scheme, sizeof(scheme), NULL, 0U);
+
+  __real_bldc_6step_sensorless_set_pwm_scheme(scheme);
+  replay_record_leave_setter(is_outer);
+}
+
+void __wrap_bldc_6step_sensorless_set_startup_config(const struct BLDC6StepStartupConfig_t *config) {
+  bool is_outer = replay_record_enter_setter(REPLAY_SETTER_6STEP_SENSORLESS_STARTUP, config, sizeof(*config), NULL, 0U);
+
+  __real_bldc_6step_sensorless_set_startup_config(config);
+  replay_record_leave_setter(is_outer);
+}
+
+void __wrap_bldc_6step_sensorless_set_flying_start_config(const struct BLDC6StepFlyingStartConfig_t *config) {
+  bool is_outer = replay_record_enter_setter(REPLAY_SETTER_6STEP_SENSORLESS_FLYING_START, config, sizeof(*config), NULL, 0U);
+
+  __real_bldc_6step_sensorless_set_flying_start_config(config);
+  replay_record_leave_setter(is_outer);
+}
+
+void __wrap_bldc_6step_sensorless_set_initial_position_config(const struct BLDC6StepInitialPositionConfig_t *config) {
+  bool is_outer = replay_record_enter_setter(REPLAY_SETTER_6STEP_SENSORLESS_INITIAL_POSITION, config, sizeof(*config), NULL, 0U);
+
+  __real_bldc_6step_sensorless_set_initial_position_config(config);
+  replay_record_leave_setter(is_outer);
+}
+
+void __wrap_bldc_6step_sensorless_set_commutation_config(const struct BLDC6StepCommutationConfig_t *config) {
+  bool is_outer = replay_record_enter_setter(REPLAY_SETTER_6STEP_SENSORLESS_COMMUTATION, config, sizeof(*config), NULL, 0U);
+
+  __real_bldc_6step_sensorless_set_commutation_config(config);
+  replay_record_leave_setter(is_outer);
+}
+
+void __wrap_bldc_6step_sensorless_set_zero_crossing_config(const struct BLDC6StepZeroCrossingConfig_t *config) {
+  bool is_outer = replay_record_enter_setter(REPLAY_SETTER_6STEP_SENSORLESS_ZERO_CROSSING, config, sizeof(*config), NULL, 0U);
+
+  __real_bldc_6step_sensorless_set_zero_crossing_config(config);
+  replay_record_leave_setter(is_outer);
+}
+
+void __wrap_bldc_6step_sensorless_set_position_config(const struct BLDC6StepPositionConfig_t *config) {
+  bool is_outer = replay_record_enter_setter(REPLAY_SETTER_6STEP_SENSORLESS_POSITION, config, sizeof(*config), NULL, 0U);
+
+  __real_bldc_6step_sensorless_set_position_config(config);
+  replay_record_leave_setter(is_outer);
+}
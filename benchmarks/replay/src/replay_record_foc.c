@@ -0,0 +1,76 @@
+/*******************************************************************************************************************************
+ * @file   replay_record_foc.c
+ *
+ * @brief  Source file for the recording of the FOC driver calls
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stddef.h>
+
+/* Inter-component Headers */
+#include "foc_sensored.h"
+#include "foc_sensorless.h"
+
+/* Intra-component Headers */
+#include "replay_record.h"
+
+/* Control code behind the wrappers, bound by the linker's --wrap */
+void __real_foc_sensored_create_driver(struct Motor_t *motor);
+void __real_foc_sensorless_create_driver(struct Motor_t *motor, FOCObserverType_t observer_type);
+void __real_foc_sensored_set_position_source(FOCPositionSource_t source);
+void __real_foc_sensorless_set_backemf_pll_config(const struct BackEMFPLLConfig_t *config);
+void __real_foc_sensorless_set_hfi_config(const struct HFIObserverConfig_t *config);
+void __real_foc_sensorless_set_startup_config(const struct FOCSensorlessStartupConfig_t *config);
+void __real_foc_sensorless_set_flying_start_config(const struct FOCSensorlessFlyingStartConfig_t *config);
+
+void __wrap_foc_sensored_create_driver(struct Motor_t *motor) {
+  __real_foc_sensored_create_driver(motor);
+  replay_record_create(motor, REPLAY_DRIVER_FOC_SENSORED, 0U);
+}
+
+void __wrap_foc_sensorless_create_driver(struct Motor_t *motor, FOCObserverType_t observer_type) {
+  __real_foc_sensorless_create_driver(motor, observer_type);
+  replay_record_create(motor, REPLAY_DRIVER_FOC_SENSORLESS, (uint8_t)observer_type);
+}
+
+void __wrap_foc_sensored_set_position_source(FOCPositionSource_t source) {
+  bool is_outer = replay_record_enter_setter(REPLAY_SETTER_FOC_SENSORED_POSITION_SOURCE, &source, sizeof(source), NULL, 0U);
+
+  __real_foc_sensored_set_position_source(source);
+  replay_record_leave_setter(is_outer);
+}
+
+void __wrap_foc_sensorless_set_backemf_pll_config(const struct BackEMFPLLConfig_t *config) {
+  const struct PLLConfig_t *pll = (config != NULL) ? &config->pll_cfg : NULL;
+  bool is_outer = replay_record_enter_setter(REPLAY_SETTER_FOC_SENSORLESS_BACKEMF_PLL, config, sizeof(*config), pll,
+                                             offsetof(struct BackEMFPLLConfig_t, pll_cfg));
+
+  __real_foc_sensorless_set_backemf_pll_config(config);
+  replay_record_leave_setter(is_outer);
+}
+
+void __wrap_foc_sensorless_set_hfi_config(const struct HFIObserverConfig_t *config) {
+  const struct PLLConfig_t *pll = (config != NULL) ? &config->pll_cfg : NULL;
+  bool is_outer = replay_record_enter_setter(REPLAY_SETTER_FOC_SENSORLESS_HFI, config, sizeof(*config), pll,
+                                             offsetof(struct HFIObserverConfig_t, pll_cfg));
+
+  __real_foc_sensorless_set_hfi_config(config);
+  replay_record_leave_setter(is_outer);
+}
+
+void __wrap_foc_sensorless_set_startup_config(const struct FOCSensorlessStartupConfig_t *config) {
+  bool is_outer = replay_record_enter_setter(REPLAY_SETTER_FOC_SENSORLESS_STARTUP, config, sizeof(*config), NULL, 0U);
+
+  __real_foc_sensorless_set_startup_config(config);
+  replay_record_leave_setter(is_outer);
+}
+
+void __wrap_foc_sensorless_set_flying_start_config(const struct FOCSensorlessFlyingStartConfig_t *config) {
+  bool is_outer = replay_record_enter_setter(REPLAY_SETTER_FOC_SENSORLESS_FLYING_START, config, sizeof(*config), NULL, 0U);
+
+  __real_foc_sensorless_set_flying_start_config(config);
+  replay_record_leave_setter(is_outer);
+}
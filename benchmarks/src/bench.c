@@ -0,0 +1,239 @@
+/*******************************************************************************************************************************
+ * @file   bench.c
+ *
+ * @brief  Source file for the motor core microbenchmark harness
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "bench.h"
+
+#define BENCH_CLOCK_SAMPLES 1001U /**< Clock reads timed to find the cost of one */
+
+static volatile float s_sink;
+
+static inline uint64_t now_ns(void) {
+  struct timespec time;
+
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+  double lhs = *(const double *)a;
+  double rhs = *(const double *)b;
+
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+static double percentile(const double *sorted, uint32_t count, double fraction) {
+  uint32_t index = (uint32_t)(fraction * (double)(count - 1U) + 0.5);
+
+  return sorted[index];
+}
+
+static double clock_overhead_ns(void) {
+  static double s_overhead_ns = -1.0;
+  double samples[BENCH_CLOCK_SAMPLES];
+
+  if (s_overhead_ns >= 0.0) {
+    return s_overhead_ns;
+  }
+
+  for (uint32_t i = 0U; i < BENCH_CLOCK_SAMPLES; i++) {
+    uint64_t start = now_ns();
+    samples[i] = (double)(now_ns() - start);
+  }
+
+  qsort(samples, BENCH_CLOCK_SAMPLES, sizeof(samples[0]), compare_doubles);
+  s_overhead_ns = percentile(samples, BENCH_CLOCK_SAMPLES, 0.5);
+  return s_overhead_ns;
+}
+
+void bench_consume(float value) {
+  s_sink = value;
+}
+
+void bench_fill_inputs(float *inputs, uint32_t count, float min, float max) {
+  uint32_t seed = 0x12345678U;
+
+  for (uint32_t i = 0U; i < count; i++) {
+    seed = seed * 1664525U + 1013904223U;
+    inputs[i] = min + (max - min) * (float)(seed >> 8) / (float)(1U << 24);
+  }
+}
+
+int bench_measure(const struct BenchCase_t *bench, uint32_t num_batches, struct BenchResult_t *result) {
+  double *per_call_ns = malloc((size_t)num_batches * sizeof(*per_call_ns));
+  double overhead_ns = clock_overhead_ns();
+
+  if (per_call_ns == NULL || num_batches == 0U) {
+    free(per_call_ns);
+    return -1;
+  }
+
+  if (bench->setup != NULL) {
+    bench->setup();
+  }
+
+  /* Warm the caches and branch predictors, and let the clock speed settle */
+  for (uint32_t batch = 0U; batch < num_batches / 10U; batch++) {
+    bench->run(bench->calls_per_batch);
+  }
+
+  for (uint32_t batch = 0U; batch < num_batches; batch++) {
+    uint64_t start = now_ns();
+    bench->run(bench->calls_per_batch);
+    double elapsed_ns = (double)(now_ns() - start) - overhead_ns;
+
+    per_call_ns[batch] = (elapsed_ns > 0.0 ? elapsed_ns : 0.0) / (double)bench->calls_per_batch;
+  }
+
+  qsort(per_call_ns, num_batches, sizeof(per_call_ns[0]), compare_doubles);
+
+  snprintf(result->name, sizeof(result->name), "%s", bench->name);
+  result->median_ns = percentile(per_call_ns, num_batches, 0.5);
+  result->p99_ns = percentile(per_call_ns, num_batches, 0.99);
+
+  free(per_call_ns);
+  return 0;
+}
+
+void bench_write_json(FILE *file, const struct BenchResult_t *results, size_t num_results, const struct BenchTolerance_t *tolerance) {
+  fprintf(file, "{\n");
+  fprintf(file, "  \"tolerance\": {\"median\": %.2f, \"p99\": %.2f, \"slack_ns\": %.2f},\n", tolerance->median, tolerance->p99,
+          tolerance->slack_ns);
+  fprintf(file, "  \"results\": [\n");
+
+  for (size_t i = 0U; i < num_results; i++) {
+    fprintf(file, "    {\"name\": \"%s\", \"median_ns\": %.2f, \"p99_ns\": %.2f}%s\n", results[i].name, results[i].median_ns,
+            results[i].p99_ns, (i + 1U < num_results) ? "," : "");
+  }
+
+  fprintf(file, "  ]\n}\n");
+}
+
+/* Copy length characters of text, cut to fit and terminated */
+static void copy_span(char *copy, size_t copy_size, const char *text, size_t length) {
+  if (length > copy_size - 1U) {
+    length = copy_size - 1U;
+  }
+
+  memcpy(copy, text, length);
+  copy[length] = '\0';
+}
+
+/* Number following "key": anywhere after text, or fallback when the key is missing */
+static double read_number(const char *text, const char *key, double fallback) {
+  const char *found = strstr(text, key);
+
+  if (found == NULL) {
+    return fallback;
+  }
+
+  found = strchr(found + strlen(key), ':');
+  return (found != NULL) ? strtod(found + 1, NULL) : fallback;
+}
+
+int bench_load_baseline(const char *path, struct BenchBaseline_t *baseline) {
+  FILE *file = fopen(path, "rb");
+
+  memset(baseline, 0, sizeof(*baseline));
+  baseline->tolerance.median = BENCH_DEFAULT_TOLERANCE;
+  baseline->tolerance.p99 = BENCH_DEFAULT_P99_TOLERANCE;
+  baseline->tolerance.slack_ns = BENCH_DEFAULT_SLACK_NS;
+
+  if (file == NULL) {
+    return -1;
+  }
+
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+
+  char *text = (size > 0) ? malloc((size_t)size + 1U) : NULL;
+
+  if (text == NULL || fread(text, 1U, (size_t)size, file) != (size_t)size) {
+    free(text);
+    fclose(file);
+    return -1;
+  }
+
+  text[size] = '\0';
+  fclose(file);
+
+  /* Only the layout bench_write_json() produces is understood, one result per line */
+  const char *tolerance = strstr(text, "\"tolerance\"");
+  const char *tolerance_end = (tolerance != NULL) ? strchr(tolerance, '}') : NULL;
+
+  if (tolerance_end != NULL) {
+    char block[128];
+
+    copy_span(block, sizeof(block), tolerance, (size_t)(tolerance_end - tolerance));
+    baseline->tolerance.median = read_number(block, "\"median\"", BENCH_DEFAULT_TOLERANCE);
+    baseline->tolerance.p99 = read_number(block, "\"p99\"", BENCH_DEFAULT_P99_TOLERANCE);
+    baseline->tolerance.slack_ns = read_number(block, "\"slack_ns\"", BENCH_DEFAULT_SLACK_NS);
+  }
+
+  for (const char *entry = strstr(text, "\"name\""); entry != NULL; entry = strstr(entry + 1, "\"name\"")) {
+    const char *name = strchr(entry + 6, '"');
+    const char *name_end = (name != NULL) ? strchr(name + 1, '"') : NULL;
+    const char *line_end = strchr(entry, '\n');
+
+    if (name_end == NULL || (line_end != NULL && name_end > line_end)) {
+      continue;
+    }
+
+    struct BenchResult_t *results = realloc(baseline->results, (baseline->num_results + 1U) * sizeof(*results));
+
+    if (results == NULL) {
+      break;
+    }
+
+    baseline->results = results;
+
+    struct BenchResult_t *result = &results[baseline->num_results++];
+    char line[256];
+
+    copy_span(result->name, sizeof(result->name), name + 1, (size_t)(name_end - name - 1));
+    copy_span(line, sizeof(line), entry, (line_end != NULL) ? (size_t)(line_end - entry) : strlen(entry));
+    result->median_ns = read_number(line, "\"median_ns\"", 0.0);
+    result->p99_ns = read_number(line, "\"p99_ns\"", 0.0);
+  }
+
+  free(text);
+  return 0;
+}
+
+void bench_free_baseline(struct BenchBaseline_t *baseline) {
+  free(baseline->results);
+  baseline->results = NULL;
+  baseline->num_results = 0U;
+}
+
+bool bench_is_regression(const struct BenchResult_t *result, const struct BenchBaseline_t *baseline, const struct BenchResult_t **stored) {
+  *stored = NULL;
+
+  for (size_t i = 0U; i < baseline->num_results; i++) {
+    if (strcmp(baseline->results[i].name, result->name) == 0) {
+      *stored = &baseline->results[i];
+      break;
+    }
+  }
+
+  if (*stored == NULL) {
+    return false;
+  }
+
+  return result->median_ns > (*stored)->median_ns * baseline->tolerance.median + baseline->tolerance.slack_ns ||
+         result->p99_ns > (*stored)->p99_ns * baseline->tolerance.p99 + baseline->tolerance.slack_ns;
+}
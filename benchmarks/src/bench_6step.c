@@ -0,0 +1,82 @@
+/*******************************************************************************************************************************
+ * @file   bench_6step.c
+ *
+ * @brief  Source file for the 6-step benchmarks
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <string.h>
+
+/* Inter-component Headers */
+#include "bldc_6step_sensored.h"
+#include "bldc_6step_sensorless.h"
+#include "motor.h"
+
+/* Intra-component Headers */
+#include "bench_cases.h"
+#include "bench_rotor.h"
+
+#define BENCH_6STEP_VOLTAGE_SETPOINT 12.0f  /**< Voltage setpoint of the driver cycles (V) */
+#define BENCH_6STEP_ELECTRICAL_SPEED 500.0f /**< Electrical speed of the synthetic rotor (rad/s) */
+#define BENCH_6STEP_BEMF 5.0f               /**< Peak phase back-EMF of the synthetic rotor (V) */
+#define BENCH_6STEP_CURRENT 2.0f            /**< Peak phase current of the synthetic rotor (A) */
+
+static struct Motor_t MOTOR_HOT_DATA s_motor;
+static struct MotorConfig_t s_motor_config;
+
+static void prepare_motor_config(ControlMethod_t control_method) {
+  memset(&s_motor_config, 0, sizeof(s_motor_config));
+  s_motor_config.type = MOTOR_TYPE_BLDC;
+  s_motor_config.control_method = control_method;
+  s_motor_config.control_mode = CONTROL_MODE_VOLTAGE;
+  s_motor_config.pole_pairs = BENCH_ROTOR_POLE_PAIRS;
+  s_motor_config.phase_resistance = 0.5f;
+  s_motor_config.phase_inductance = 0.001f;
+  s_motor_config.max_current = 40.0f;
+  s_motor_config.max_voltage = 24.0f;
+  s_motor_config.max_velocity = 10000.0f;
+  s_motor_config.current_pid_config.output_min = 0.0f;
+  s_motor_config.current_pid_config.output_max = 1.0f;
+
+  s_motor_config.pwm_config.frequency = 20000U;
+  s_motor_config.pwm_config.dead_time_ns = 500U;
+  s_motor_config.pwm_config.resolution = 12U;
+  s_motor_config.pwm_config.complementary_output = true;
+  s_motor_config.adc_config.sampling_freq = 20000U;
+  s_motor_config.adc_config.resolution = 12U;
+}
+
+static void start_motor(void) {
+  s_motor.driver.init(&s_motor, &s_motor_config);
+  s_motor.driver.set_voltage(&s_motor, BENCH_6STEP_VOLTAGE_SETPOINT);
+}
+
+void bench_6step_sensored_setup(void) {
+  prepare_motor_config(CONTROL_METHOD_SIX_STEP);
+  memset(&s_motor, 0, sizeof(s_motor));
+  bench_rotor_reset(BENCH_6STEP_ELECTRICAL_SPEED, BENCH_6STEP_CURRENT, BENCH_6STEP_BEMF);
+  bldc_6step_sensored_create_driver(&s_motor);
+  start_motor();
+}
+
+void bench_6step_sensorless_setup(void) {
+  prepare_motor_config(CONTROL_METHOD_SENSORLESS);
+  memset(&s_motor, 0, sizeof(s_motor));
+  bench_rotor_reset(BENCH_6STEP_ELECTRICAL_SPEED, BENCH_6STEP_CURRENT, BENCH_6STEP_BEMF);
+  bldc_6step_sensorless_create_driver(&s_motor);
+  start_motor();
+}
+
+void bench_6step_motor_run(uint32_t calls) {
+  for (uint32_t i = 0U; i < calls; i++) {
+    bench_rotor_step();
+
+    if (motor_run(&s_motor) != MOTOR_OK) {
+      s_motor.driver.deinit(&s_motor);
+      start_motor();
+    }
+  }
+}
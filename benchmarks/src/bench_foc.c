@@ -0,0 +1,202 @@
+/*******************************************************************************************************************************
+ * @file   bench_foc.c
+ *
+ * @brief  Source file for the FOC benchmarks
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "backemf_pll_observer.h"
+#include "foc_field_weakening.h"
+#include "foc_sensored.h"
+#include "foc_sensorless.h"
+#include "hfi_observer.h"
+#include "math_utils.h"
+#include "motor.h"
+
+/* Intra-component Headers */
+#include "bench.h"
+#include "bench_cases.h"
+#include "bench_rotor.h"
+
+#define BENCH_FOC_NUM_SAMPLES 1024U                        /**< Observer inputs per table, a power of two */
+#define BENCH_FOC_SAMPLE_MASK (BENCH_FOC_NUM_SAMPLES - 1U) /**< Wraps a sample index */
+#define BENCH_FOC_TABLE_TURNS 3U                           /**< Electrical turns over the table, so it wraps smoothly */
+#define BENCH_FOC_DT 0.00005f                              /**< Observer update period (s), 20 kHz */
+#define BENCH_FOC_RESISTANCE 0.5f                          /**< Phase resistance (Ohm) */
+#define BENCH_FOC_INDUCTANCE 0.001f                        /**< Phase inductance (H) */
+#define BENCH_FOC_FLUX_LINKAGE 0.01f                       /**< Rotor flux linkage (Wb) */
+#define BENCH_FOC_CURRENT 3.0f                             /**< Peak phase current, on the q-axis (A) */
+#define BENCH_FOC_CURRENT_SETPOINT 2.0f                    /**< Q-axis current setpoint of the driver cycles (A) */
+
+/**
+ * @brief   Voltage and current of a rotor turning at a constant speed, as an observer sees them
+ */
+struct BenchFocSamples_t {
+  float v_alpha[BENCH_FOC_NUM_SAMPLES]; /**< Alpha-axis voltage (V) */
+  float v_beta[BENCH_FOC_NUM_SAMPLES];  /**< Beta-axis voltage (V) */
+  float i_alpha[BENCH_FOC_NUM_SAMPLES]; /**< Alpha-axis current (A) */
+  float i_beta[BENCH_FOC_NUM_SAMPLES];  /**< Beta-axis current (A) */
+  float vd[BENCH_FOC_NUM_SAMPLES];      /**< D-axis voltage command around the field weakening limit (V) */
+  float vq[BENCH_FOC_NUM_SAMPLES];      /**< Q-axis voltage command around the field weakening limit (V) */
+};
+
+static struct BenchFocSamples_t s_samples;
+static uint32_t s_index = 0U;
+
+static const struct FieldWeakeningConfig_t s_field_weakening_config = { .voltage_margin = 0.95f, .id_min = -10.0f, .id_max = 0.0f, .k_fw = 0.1f };
+static struct FieldWeakeningState_t s_field_weakening;
+
+static struct BackEMFPLLConfig_t s_backemf_config;
+static struct HFIObserverConfig_t s_hfi_config;
+static struct FOCObserver_t s_observer;
+
+static struct Motor_t MOTOR_HOT_DATA s_motor;
+static struct MotorConfig_t s_motor_config;
+
+static inline uint32_t next_index(void) {
+  return s_index++ & BENCH_FOC_SAMPLE_MASK;
+}
+
+void bench_foc_setup(void) {
+  float omega = MATH_TWO_PI * (float)BENCH_FOC_TABLE_TURNS / ((float)BENCH_FOC_NUM_SAMPLES * BENCH_FOC_DT);
+  float bemf = BENCH_FOC_FLUX_LINKAGE * omega;
+  float reactance = BENCH_FOC_INDUCTANCE * omega * BENCH_FOC_CURRENT;
+
+  /* v = R i + L di/dt + e, with the current on the q-axis in phase with the back-EMF */
+  for (uint32_t i = 0U; i < BENCH_FOC_NUM_SAMPLES; i++) {
+    float theta = omega * BENCH_FOC_DT * (float)i;
+    float sin_theta = sinf(theta);
+    float cos_theta = cosf(theta);
+
+    s_samples.i_alpha[i] = -BENCH_FOC_CURRENT * sin_theta;
+    s_samples.i_beta[i] = BENCH_FOC_CURRENT * cos_theta;
+    s_samples.v_alpha[i] = (BENCH_FOC_RESISTANCE * BENCH_FOC_CURRENT + bemf) * -sin_theta - reactance * cos_theta;
+    s_samples.v_beta[i] = (BENCH_FOC_RESISTANCE * BENCH_FOC_CURRENT + bemf) * cos_theta - reactance * sin_theta;
+  }
+
+  bench_fill_inputs(s_samples.vd, BENCH_FOC_NUM_SAMPLES, -14.0f, 14.0f);
+  bench_fill_inputs(s_samples.vq, BENCH_FOC_NUM_SAMPLES, -14.0f, 14.0f);
+  field_weakening_init(&s_field_weakening, &s_field_weakening_config);
+}
+
+void bench_field_weakening_update(uint32_t calls) {
+  for (uint32_t i = 0U; i < calls; i++) {
+    uint32_t index = next_index();
+    field_weakening_update(&s_field_weakening, s_samples.vd[index], s_samples.vq[index], 24.0f);
+  }
+
+  bench_consume(s_field_weakening.id_ref);
+}
+
+static void prepare_backemf_config(void) {
+  memset(&s_backemf_config, 0, sizeof(s_backemf_config));
+  s_backemf_config.pll_cfg.kp = FOC_SENSORLESS_DEFAULT_PLL_KP;
+  s_backemf_config.pll_cfg.ki = FOC_SENSORLESS_DEFAULT_PLL_KI;
+  s_backemf_config.pll_cfg.max_omega = FOC_SENSORLESS_DEFAULT_PLL_MAX_OMEGA;
+  s_backemf_config.Rs = BENCH_FOC_RESISTANCE;
+  s_backemf_config.Ls = BENCH_FOC_INDUCTANCE;
+  s_backemf_config.lambda_pm = BENCH_FOC_FLUX_LINKAGE;
+  s_backemf_config.min_speed = FOC_SENSORLESS_DEFAULT_OBSERVER_MIN_SPEED;
+  s_backemf_config.max_speed = FOC_SENSORLESS_DEFAULT_PLL_MAX_OMEGA;
+}
+
+void bench_backemf_pll_observer_setup(void) {
+  bench_foc_setup();
+  prepare_backemf_config();
+  foc_observer_backemf_pll_create_driver(&s_observer, &s_backemf_config);
+  s_observer.driver.init(&s_observer);
+}
+
+void bench_hfi_observer_setup(void) {
+  bench_foc_setup();
+  prepare_backemf_config();
+
+  memset(&s_hfi_config, 0, sizeof(s_hfi_config));
+  s_hfi_config.pll_cfg.kp = FOC_SENSORLESS_DEFAULT_HFI_PLL_KP;
+  s_hfi_config.pll_cfg.ki = FOC_SENSORLESS_DEFAULT_HFI_PLL_KI;
+  s_hfi_config.pll_cfg.max_omega = FOC_SENSORLESS_DEFAULT_PLL_MAX_OMEGA;
+  s_hfi_config.injection_voltage = FOC_SENSORLESS_DEFAULT_HFI_INJECTION_VOLTAGE;
+  s_hfi_config.Ld = 0.0008f;
+  s_hfi_config.Lq = 0.0012f;
+  /* Above the table speed, so the injection keeps running */
+  s_hfi_config.crossover_low = 2000.0f;
+  s_hfi_config.crossover_high = 3000.0f;
+
+  foc_observer_hfi_create_driver(&s_observer, &s_hfi_config, &s_backemf_config);
+  s_observer.driver.init(&s_observer);
+}
+
+void bench_observer_update(uint32_t calls) {
+  float sum = 0.0f;
+
+  for (uint32_t i = 0U; i < calls; i++) {
+    uint32_t index = next_index();
+    float theta, omega;
+
+    s_observer.driver.update(&s_observer, s_samples.v_alpha[index], s_samples.v_beta[index], s_samples.i_alpha[index], s_samples.i_beta[index],
+                             BENCH_FOC_DT, &theta, &omega);
+    sum += theta + omega;
+  }
+
+  bench_consume(sum);
+}
+
+static void prepare_motor_config(void) {
+  memset(&s_motor_config, 0, sizeof(s_motor_config));
+  s_motor_config.type = MOTOR_TYPE_PMSM;
+  s_motor_config.control_method = CONTROL_METHOD_FOC;
+  s_motor_config.control_mode = CONTROL_MODE_CURRENT;
+  s_motor_config.pole_pairs = BENCH_ROTOR_POLE_PAIRS;
+  s_motor_config.phase_resistance = BENCH_FOC_RESISTANCE;
+  s_motor_config.phase_inductance = BENCH_FOC_INDUCTANCE;
+  s_motor_config.max_current = 40.0f;
+  s_motor_config.max_voltage = 24.0f;
+  s_motor_config.max_velocity = 200.0f;
+  s_motor_config.torque_constant = 0.15f;
+
+  s_motor_config.pwm_config.frequency = 20000U;
+  s_motor_config.pwm_config.dead_time_ns = 500U;
+  s_motor_config.pwm_config.resolution = 12U;
+  s_motor_config.pwm_config.complementary_output = true;
+  s_motor_config.adc_config.sampling_freq = 20000U;
+  s_motor_config.adc_config.resolution = 12U;
+}
+
+static void start_motor(void) {
+  s_motor.driver.init(&s_motor, &s_motor_config);
+  s_motor.driver.set_current(&s_motor, BENCH_FOC_CURRENT_SETPOINT);
+}
+
+void bench_foc_sensored_setup(void) {
+  prepare_motor_config();
+  memset(&s_motor, 0, sizeof(s_motor));
+  bench_rotor_reset(500.0f, BENCH_FOC_CURRENT, BENCH_FOC_FLUX_LINKAGE * 500.0f);
+  foc_sensored_create_driver(&s_motor);
+  start_motor();
+}
+
+void bench_foc_sensorless_setup(void) {
+  prepare_motor_config();
+  memset(&s_motor, 0, sizeof(s_motor));
+  bench_rotor_reset(500.0f, BENCH_FOC_CURRENT, BENCH_FOC_FLUX_LINKAGE * 500.0f);
+  foc_sensorless_create_driver(&s_motor, OBSERVER_TYPE_BACKEMF_PLL);
+  start_motor();
+}
+
+void bench_foc_motor_run(uint32_t calls) {
+  for (uint32_t i = 0U; i < calls; i++) {
+    bench_rotor_step();
+
+    if (motor_run(&s_motor) != MOTOR_OK) {
+      s_motor.driver.deinit(&s_motor);
+      start_motor();
+    }
+  }
+}
@@ -0,0 +1,260 @@
+/*******************************************************************************************************************************
+ * @file   bench_main.c
+ *
+ * @brief  Main file for the motor core microbenchmarks
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "bench.h"
+#include "bench_cases.h"
+
+static const struct BenchCase_t s_benchmarks[] = {
+  { "fast_sin_cos", bench_utils_setup, bench_fast_sin_cos, 64U },
+  { "normalize_angle", bench_utils_setup, bench_normalize_angle, 64U },
+  { "mech_to_elec_angle", bench_utils_setup, bench_mech_to_elec_angle, 64U },
+  { "fast_inv_sqrt", bench_utils_setup, bench_fast_inv_sqrt, 64U },
+  { "clamp", bench_utils_setup, bench_clamp, 64U },
+  { "clarke_transform_2phase", bench_utils_setup, bench_clarke_transform_2phase, 64U },
+  { "clarke_transform_3phase", bench_utils_setup, bench_clarke_transform_3phase, 64U },
+  { "park_transform", bench_utils_setup, bench_park_transform, 64U },
+  { "inverse_park_transform", bench_utils_setup, bench_inverse_park_transform, 64U },
+  { "svpwm_generate", bench_utils_setup, bench_svpwm_generate, 64U },
+  { "pid_update", bench_pid_setup, bench_pid_update, 64U },
+  { "pll_update", bench_pll_setup, bench_pll_update, 64U },
+  { "pll_update_scheduled", bench_pll_scheduled_setup, bench_pll_update, 64U },
+  { "hall_estimator_update", bench_hall_estimator_setup, bench_hall_estimator_update, 64U },
+  { "field_weakening_update", bench_foc_setup, bench_field_weakening_update, 64U },
+  { "backemf_pll_observer_update", bench_backemf_pll_observer_setup, bench_observer_update, 32U },
+  { "hfi_observer_update", bench_hfi_observer_setup, bench_observer_update, 32U },
+  { "motor_run_foc_sensored", bench_foc_sensored_setup, bench_foc_motor_run, 16U },
+  { "motor_run_foc_sensorless", bench_foc_sensorless_setup, bench_foc_motor_run, 16U },
+  { "motor_run_6step_sensored", bench_6step_sensored_setup, bench_6step_motor_run, 16U },
+  { "motor_run_6step_sensorless", bench_6step_sensorless_setup, bench_6step_motor_run, 16U },
+};
+
+#define NUM_BENCHMARKS (sizeof(s_benchmarks) / sizeof(s_benchmarks[0]))
+
+#define BENCH_ROUND_PAUSE_NS 100000000L   /**< Sleep before each round, so the next one may run on a quieter core */
+#define BENCH_CONFIRM_PAUSE_NS 500000000L /**< Sleep before each further round of the results past their baseline */
+#define BENCH_CONFIRM_ROUNDS 12U          /**< Further rounds a result past its baseline thresholds gets before it counts */
+#define BENCH_BASELINE_ROUND_FACTOR 4U    /**< Rounds of a run recording the baseline, as a multiple of the usual ones */
+
+/**
+ * @brief   Command line options
+ */
+struct BenchOptions_t {
+  const char *json_path;     /**< File to write the results to, NULL for none */
+  const char *baseline_path; /**< Baseline to check the results against, NULL for none */
+  const char *record_path;   /**< File to record the results to as the new baseline, NULL for none */
+  uint32_t num_batches;      /**< Timed batches per benchmark and round */
+  uint32_t num_rounds;       /**< Rounds over the benchmarks, the fastest of each is kept */
+};
+
+static void print_usage(const char *program) {
+  fprintf(stderr, "usage: %s [--json PATH] [--baseline PATH | --record-baseline PATH] [--batches N] [--rounds N] [FILTER...]\n", program);
+  fprintf(stderr, "  Runs the benchmarks whose names contain a filter, every benchmark without filters.\n");
+  fprintf(stderr, "  Each benchmark runs once per round and keeps its fastest round.\n");
+  fprintf(stderr, "  Exits with 1 when a result is past the thresholds of its baseline entry, and with 2 when the baseline\n");
+  fprintf(stderr, "  cannot be read or has no entry for a benchmark.\n");
+  fprintf(stderr, "  --record-baseline runs every benchmark and stores the results, timings of the machine it runs on.\n");
+}
+
+static void pause_between_rounds(long pause_ns) {
+  struct timespec pause = { 0, pause_ns };
+
+  nanosleep(&pause, NULL);
+}
+
+/* Time a benchmark for one round, keeping the lowest median and 99th percentile of the rounds so far */
+static int measure_fastest(const struct BenchCase_t *bench, uint32_t num_batches, bool is_first_round, struct BenchResult_t *fastest) {
+  struct BenchResult_t measured;
+
+  if (bench_measure(bench, num_batches, &measured) != 0) {
+    fprintf(stderr, "%s: out of memory\n", bench->name);
+    return -1;
+  }
+
+  if (is_first_round) {
+    *fastest = measured;
+  } else {
+    fastest->median_ns = fmin(fastest->median_ns, measured.median_ns);
+    fastest->p99_ns = fmin(fastest->p99_ns, measured.p99_ns);
+  }
+
+  return 0;
+}
+
+static int write_results(const char *path, const struct BenchResult_t *results, size_t num_results, const struct BenchTolerance_t *tolerance) {
+  FILE *file = fopen(path, "w");
+
+  if (file == NULL) {
+    perror(path);
+    return -1;
+  }
+
+  bench_write_json(file, results, num_results, tolerance);
+  fclose(file);
+  return 0;
+}
+
+/**
+ * @brief   Read the options, given before or between the filters
+ * @return  Number of filters, moved to the front of argv, or -1 on a bad option
+ */
+static int parse_options(int argc, char **argv, struct BenchOptions_t *options) {
+  int num_filters = 0;
+
+  for (int arg = 1; arg < argc; arg++) {
+    const char *value = (arg + 1 < argc) ? argv[arg + 1] : NULL;
+
+    if (strcmp(argv[arg], "--json") == 0 && value != NULL) {
+      options->json_path = value;
+      arg++;
+    } else if (strcmp(argv[arg], "--baseline") == 0 && value != NULL) {
+      options->baseline_path = value;
+      arg++;
+    } else if (strcmp(argv[arg], "--record-baseline") == 0 && value != NULL) {
+      options->record_path = value;
+      arg++;
+    } else if (strcmp(argv[arg], "--batches") == 0 && value != NULL && strtoul(value, NULL, 10) > 0UL) {
+      options->num_batches = (uint32_t)strtoul(value, NULL, 10);
+      arg++;
+    } else if (strcmp(argv[arg], "--rounds") == 0 && value != NULL && strtoul(value, NULL, 10) > 0UL) {
+      options->num_rounds = (uint32_t)strtoul(value, NULL, 10);
+      arg++;
+    } else if (strncmp(argv[arg], "--", 2) == 0) {
+      print_usage(argv[0]);
+      return -1;
+    } else {
+      argv[1 + num_filters++] = argv[arg];
+    }
+  }
+
+  return num_filters;
+}
+
+int main(int argc, char **argv) {
+  struct BenchOptions_t options = { .num_batches = BENCH_DEFAULT_NUM_BATCHES, .num_rounds = BENCH_DEFAULT_NUM_ROUNDS };
+  struct BenchBaseline_t baseline = { .tolerance = { BENCH_DEFAULT_TOLERANCE, BENCH_DEFAULT_P99_TOLERANCE, BENCH_DEFAULT_SLACK_NS } };
+  struct BenchResult_t results[NUM_BENCHMARKS];
+  const struct BenchCase_t *selected[NUM_BENCHMARKS];
+  size_t num_results = 0U;
+  int num_regressions = 0;
+  int num_missing = 0;
+  int num_filters = parse_options(argc, argv, &options);
+
+  if (num_filters < 0) {
+    return 2;
+  }
+
+  /* A baseline covers every benchmark, later runs treat a benchmark it lacks as an error */
+  if (options.record_path != NULL && (options.baseline_path != NULL || num_filters > 0)) {
+    fprintf(stderr, "--record-baseline runs every benchmark, without --baseline or filters\n");
+    return 2;
+  }
+
+  /* Timings only compare on the machine that took them, the baseline is recorded there with --record-baseline */
+  if (options.baseline_path != NULL && bench_load_baseline(options.baseline_path, &baseline) != 0) {
+    fprintf(stderr, "%s: could not read the baseline, record one with --record-baseline\n", options.baseline_path);
+    return 2;
+  }
+
+  /* Every later run is held to the baseline, so it gets more chances to catch a quiet machine */
+  uint32_t num_rounds = (options.record_path != NULL) ? options.num_rounds * BENCH_BASELINE_ROUND_FACTOR : options.num_rounds;
+
+  /* Without filters every benchmark runs */
+  for (size_t i = 0U; i < NUM_BENCHMARKS; i++) {
+    bool is_selected = (num_filters == 0);
+
+    for (int arg = 1; arg <= num_filters; arg++) {
+      is_selected = is_selected || (strstr(s_benchmarks[i].name, argv[arg]) != NULL);
+    }
+
+    if (is_selected) {
+      selected[num_results++] = &s_benchmarks[i];
+    }
+  }
+
+  /* Load from elsewhere on the machine only ever slows a round down. Spreading the rounds over the run and keeping the
+   * fastest one leaves the cost of the code itself. A busy spell can outlast the usual rounds, so results past their
+   * baseline thresholds get further ones before they count as regressions */
+  for (uint32_t round = 0U; round < num_rounds + BENCH_CONFIRM_ROUNDS; round++) {
+    bool is_confirming = (round >= num_rounds);
+    bool is_measured[NUM_BENCHMARKS];
+    size_t num_measured = 0U;
+
+    for (size_t i = 0U; i < num_results; i++) {
+      const struct BenchResult_t *stored = NULL;
+
+      is_measured[i] = !is_confirming || bench_is_regression(&results[i], &baseline, &stored);
+      num_measured += is_measured[i] ? 1U : 0U;
+    }
+
+    if (num_measured == 0U) {
+      break;
+    }
+
+    pause_between_rounds(is_confirming ? BENCH_CONFIRM_PAUSE_NS : BENCH_ROUND_PAUSE_NS);
+
+    for (size_t i = 0U; i < num_results; i++) {
+      if (is_measured[i] && measure_fastest(selected[i], options.num_batches, round == 0U, &results[i]) != 0) {
+        bench_free_baseline(&baseline);
+        return 2;
+      }
+    }
+  }
+
+  printf("%-28s %12s %12s %12s %12s\n", "benchmark", "median_ns", "p99_ns", "base_median", "base_p99");
+
+  for (size_t i = 0U; i < num_results; i++) {
+    const struct BenchResult_t *result = &results[i];
+    const struct BenchResult_t *stored = NULL;
+    bool is_regression = bench_is_regression(result, &baseline, &stored);
+    bool is_missing = (options.baseline_path != NULL && stored == NULL);
+    num_regressions += is_regression ? 1 : 0;
+    num_missing += is_missing ? 1 : 0;
+
+    if (stored != NULL) {
+      printf("%-28s %12.2f %12.2f %12.2f %12.2f%s\n", result->name, result->median_ns, result->p99_ns, stored->median_ns, stored->p99_ns,
+             is_regression ? "  REGRESSION" : "");
+    } else {
+      printf("%-28s %12.2f %12.2f %12s %12s%s\n", result->name, result->median_ns, result->p99_ns, "-", "-",
+             is_missing ? "  NOT IN BASELINE" : "");
+    }
+  }
+
+  bool is_written = (options.json_path == NULL || write_results(options.json_path, results, num_results, &baseline.tolerance) == 0) &&
+                    (options.record_path == NULL || write_results(options.record_path, results, num_results, &baseline.tolerance) == 0);
+
+  bench_free_baseline(&baseline);
+
+  if (!is_written) {
+    return 2;
+  }
+
+  if (num_missing > 0) {
+    printf("%d benchmark(s) missing from the baseline, record it again with --record-baseline\n", num_missing);
+    return 2;
+  }
+
+  if (num_regressions > 0) {
+    printf("%d benchmark(s) regressed past the baseline\n", num_regressions);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+/*******************************************************************************************************************************
+ * @file   bench_rotor.c
+ *
+ * @brief  Source file for the synthetic rotor feeding the no-op HAL during motor_run() benchmarks
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+
+/* Inter-component Headers */
+#include "hal_noop.h"
+#include "math_utils.h"
+
+/* Intra-component Headers */
+#include "bench_rotor.h"
+
+#define BENCH_ROTOR_TABLE_BITS 8U                             /**< log2 of the table length */
+#define BENCH_ROTOR_TABLE_SIZE (1U << BENCH_ROTOR_TABLE_BITS) /**< Entries per electrical revolution */
+#define BENCH_ROTOR_DC_VOLTAGE 24.0f                          /**< Bus voltage (V) */
+
+/**
+ * @brief   HAL inputs at one electrical angle
+ */
+struct BenchRotorSample_t {
+  float phase_currents[NUM_MOTOR_PHASES]; /**< Phase currents (A) */
+  float phase_voltages[NUM_MOTOR_PHASES]; /**< Terminal voltages (V) */
+  float electrical_angle;                 /**< Electrical angle (rad) */
+  uint8_t hall_state;                     /**< Hall inputs */
+};
+
+/**
+ * @brief   Rotor state
+ */
+struct BenchRotor_t {
+  struct BenchRotorSample_t table[BENCH_ROTOR_TABLE_SIZE]; /**< Inputs over one electrical revolution */
+  uint32_t phase;                                          /**< Electrical angle, a full turn at 2^32 */
+  uint32_t phase_step;                                     /**< Electrical angle moved per control period */
+  uint32_t revolution;                                     /**< Electrical revolution within the mechanical one */
+  float mechanical_velocity;                               /**< Encoder velocity (rad/s) */
+};
+
+/* Forward sequence of hall_state_to_sector() */
+static const uint8_t s_hall_sequence[6] = { 0x3U, 0x1U, 0x5U, 0x4U, 0x6U, 0x2U };
+
+static struct BenchRotor_t s_rotor;
+
+void bench_rotor_reset(float electrical_speed, float current_amplitude, float bemf_amplitude) {
+  for (uint32_t i = 0U; i < BENCH_ROTOR_TABLE_SIZE; i++) {
+    struct BenchRotorSample_t *sample = &s_rotor.table[i];
+    float angle = MATH_TWO_PI * (float)i / (float)BENCH_ROTOR_TABLE_SIZE;
+
+    for (uint32_t phase = 0U; phase < NUM_MOTOR_PHASES; phase++) {
+      float phase_angle = angle - MATH_TWO_PI * (float)phase / 3.0f;
+
+      sample->phase_currents[phase] = current_amplitude * cosf(phase_angle);
+      sample->phase_voltages[phase] = 0.5f * BENCH_ROTOR_DC_VOLTAGE + bemf_amplitude * sinf(phase_angle);
+    }
+
+    sample->electrical_angle = angle;
+    sample->hall_state = s_hall_sequence[(i * 6U) / BENCH_ROTOR_TABLE_SIZE];
+  }
+
+  s_rotor.phase = 0U;
+  s_rotor.phase_step = (uint32_t)(electrical_speed * (float)BENCH_ROTOR_CONTROL_PERIOD_US * 1e-6f / MATH_TWO_PI * 4294967296.0f);
+  s_rotor.revolution = 0U;
+  s_rotor.mechanical_velocity = electrical_speed / (float)BENCH_ROTOR_POLE_PAIRS;
+
+  hal_noop_reset();
+  hal_noop_set_dc_voltage(BENCH_ROTOR_DC_VOLTAGE);
+  bench_rotor_step();
+}
+
+void bench_rotor_step(void) {
+  uint32_t phase = s_rotor.phase + s_rotor.phase_step;
+
+  if (phase < s_rotor.phase) {
+    s_rotor.revolution = (s_rotor.revolution + 1U) % BENCH_ROTOR_POLE_PAIRS;
+  }
+  s_rotor.phase = phase;
+
+  const struct BenchRotorSample_t *sample = &s_rotor.table[phase >> (32U - BENCH_ROTOR_TABLE_BITS)];
+
+  hal_noop_advance_us(BENCH_ROTOR_CONTROL_PERIOD_US);
+  hal_noop_set_phase_currents(sample->phase_currents);
+  hal_noop_set_phase_voltages(sample->phase_voltages);
+  hal_noop_set_hall_state(sample->hall_state);
+  hal_noop_set_encoder((MATH_TWO_PI * (float)s_rotor.revolution + sample->electrical_angle) / (float)BENCH_ROTOR_POLE_PAIRS,
+                       s_rotor.mechanical_velocity);
+}
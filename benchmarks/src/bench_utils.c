@@ -0,0 +1,272 @@
+/*******************************************************************************************************************************
+ * @file   bench_utils.c
+ *
+ * @brief  Source file for the utility benchmarks
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "hall_estimator.h"
+#include "math_utils.h"
+#include "pid.h"
+#include "pll.h"
+#include "svpwm.h"
+#include "transform_utils.h"
+
+/* Intra-component Headers */
+#include "bench.h"
+#include "bench_cases.h"
+
+#define BENCH_NUM_INPUTS 1024U                   /**< Inputs per table, a power of two */
+#define BENCH_INPUT_MASK (BENCH_NUM_INPUTS - 1U) /**< Wraps an input index */
+#define BENCH_DT 0.00005f                        /**< Update period of the loops (s), 20 kHz */
+#define BENCH_HALL_PERIOD_US 50U                 /**< Time between Hall estimator updates (us) */
+#define BENCH_HALL_CALLS_PER_SECTOR 7U           /**< Updates per Hall sector */
+
+/**
+ * @brief   Input tables shared by the utility benchmarks
+ */
+struct BenchUtilsInputs_t {
+  float angles[BENCH_NUM_INPUTS];     /**< Angles over four turns either way (rad) */
+  float turn[BENCH_NUM_INPUTS];       /**< Angles over one turn, 0 to 2pi (rad) */
+  float currents[BENCH_NUM_INPUTS];   /**< Phase currents (A) */
+  float modulation[BENCH_NUM_INPUTS]; /**< Modulation indices, past the linear SVPWM range at the top */
+  float errors[BENCH_NUM_INPUTS];     /**< Phase errors of the PLL (rad) */
+  float positives[BENCH_NUM_INPUTS];  /**< Inverse square root arguments over five decades */
+};
+
+static struct BenchUtilsInputs_t s_inputs;
+static uint32_t s_index = 0U;
+
+static struct PidConfig_t s_pid_config = {
+  .kp = 0.5f, .ki = 20.0f, .kd = 0.001f, .output_min = -10.0f, .output_max = 10.0f, .derivative_ema_alpha = 0.2f
+};
+static struct PidController_t s_pid;
+
+/* Bandwidths of the scheduled PLL, as in the sensorless driver's speed range */
+static const struct PLLGainPoint_t s_pll_gain_schedule[] = {
+  { .omega = 100.0f, .bandwidth = 150.0f },
+  { .omega = 1000.0f, .bandwidth = 400.0f },
+  { .omega = 5000.0f, .bandwidth = 800.0f },
+};
+static struct PLLConfig_t s_pll_config;
+static struct PLLState_t s_pll;
+
+static const struct HallEstimatorConfig_t s_hall_config = { .angle_offset = 0.0f, .stale_timeout_us = 100000U };
+static struct HallEstimatorState_t s_hall_estimator;
+static const uint8_t s_hall_sequence[HALL_NUM_SECTORS] = { 0x3U, 0x1U, 0x5U, 0x4U, 0x6U, 0x2U };
+static uint32_t s_hall_time_us = 0U;
+
+static inline uint32_t next_index(void) {
+  return s_index++ & BENCH_INPUT_MASK;
+}
+
+void bench_utils_setup(void) {
+  /* Every run reads the same inputs in the same order, whichever benchmarks ran before */
+  s_index = 0U;
+
+  bench_fill_inputs(s_inputs.angles, BENCH_NUM_INPUTS, -4.0f * MATH_TWO_PI, 4.0f * MATH_TWO_PI);
+  bench_fill_inputs(s_inputs.turn, BENCH_NUM_INPUTS, 0.0f, MATH_TWO_PI);
+  bench_fill_inputs(s_inputs.currents, BENCH_NUM_INPUTS, -20.0f, 20.0f);
+  bench_fill_inputs(s_inputs.modulation, BENCH_NUM_INPUTS, 0.0f, 1.2f);
+  bench_fill_inputs(s_inputs.errors, BENCH_NUM_INPUTS, -0.2f, 0.2f);
+  bench_fill_inputs(s_inputs.positives, BENCH_NUM_INPUTS, 0.0f, 5.0f);
+
+  for (uint32_t i = 0U; i < BENCH_NUM_INPUTS; i++) {
+    s_inputs.positives[i] = 1e-2f * powf(10.0f, s_inputs.positives[i]);
+  }
+}
+
+void bench_fast_sin_cos(uint32_t calls) {
+  float sum = 0.0f;
+
+  for (uint32_t i = 0U; i < calls; i++) {
+    float sin_out, cos_out;
+    fast_sin_cos(s_inputs.angles[next_index()], &sin_out, &cos_out);
+    sum += sin_out + cos_out;
+  }
+
+  bench_consume(sum);
+}
+
+void bench_normalize_angle(uint32_t calls) {
+  float sum = 0.0f;
+
+  for (uint32_t i = 0U; i < calls; i++) {
+    sum += normalize_angle(s_inputs.angles[next_index()]);
+  }
+
+  bench_consume(sum);
+}
+
+void bench_mech_to_elec_angle(uint32_t calls) {
+  float sum = 0.0f;
+
+  for (uint32_t i = 0U; i < calls; i++) {
+    sum += mech_to_elec_angle(s_inputs.turn[next_index()], 7U);
+  }
+
+  bench_consume(sum);
+}
+
+void bench_fast_inv_sqrt(uint32_t calls) {
+  float sum = 0.0f;
+
+  for (uint32_t i = 0U; i < calls; i++) {
+    sum += fast_inv_sqrt(s_inputs.positives[next_index()]);
+  }
+
+  bench_consume(sum);
+}
+
+void bench_clamp(uint32_t calls) {
+  float sum = 0.0f;
+
+  for (uint32_t i = 0U; i < calls; i++) {
+    sum += clamp(s_inputs.currents[next_index()], -10.0f, 10.0f);
+  }
+
+  bench_consume(sum);
+}
+
+void bench_clarke_transform_2phase(uint32_t calls) {
+  float sum = 0.0f;
+
+  for (uint32_t i = 0U; i < calls; i++) {
+    uint32_t index = next_index();
+    float alpha, beta;
+    clarke_transform_2phase(s_inputs.currents[index], s_inputs.currents[(index + 1U) & BENCH_INPUT_MASK], &alpha, &beta);
+    sum += alpha + beta;
+  }
+
+  bench_consume(sum);
+}
+
+void bench_clarke_transform_3phase(uint32_t calls) {
+  float sum = 0.0f;
+
+  for (uint32_t i = 0U; i < calls; i++) {
+    uint32_t index = next_index();
+    float ia = s_inputs.currents[index];
+    float ib = s_inputs.currents[(index + 1U) & BENCH_INPUT_MASK];
+    float alpha, beta;
+    clarke_transform_3phase(ia, ib, -ia - ib, &alpha, &beta);
+    sum += alpha + beta;
+  }
+
+  bench_consume(sum);
+}
+
+void bench_park_transform(uint32_t calls) {
+  float sum = 0.0f;
+
+  for (uint32_t i = 0U; i < calls; i++) {
+    uint32_t index = next_index();
+    float d, q;
+    park_transform(s_inputs.currents[index], s_inputs.currents[(index + 1U) & BENCH_INPUT_MASK], s_inputs.angles[index], &d, &q);
+    sum += d + q;
+  }
+
+  bench_consume(sum);
+}
+
+void bench_inverse_park_transform(uint32_t calls) {
+  float sum = 0.0f;
+
+  for (uint32_t i = 0U; i < calls; i++) {
+    uint32_t index = next_index();
+    float alpha, beta;
+    inverse_park_transform(s_inputs.currents[index], s_inputs.currents[(index + 1U) & BENCH_INPUT_MASK], s_inputs.angles[index], &alpha,
+                           &beta);
+    sum += alpha + beta;
+  }
+
+  bench_consume(sum);
+}
+
+void bench_svpwm_generate(uint32_t calls) {
+  float sum = 0.0f;
+
+  for (uint32_t i = 0U; i < calls; i++) {
+    uint32_t index = next_index();
+    float duty_a, duty_b, duty_c;
+    svpwm_generate(s_inputs.turn[index], s_inputs.modulation[index], &duty_a, &duty_b, &duty_c);
+    sum += duty_a + duty_b + duty_c;
+  }
+
+  bench_consume(sum);
+}
+
+void bench_pid_setup(void) {
+  bench_utils_setup();
+  pid_init(&s_pid, &s_pid_config);
+}
+
+void bench_pid_update(uint32_t calls) {
+  float sum = 0.0f;
+
+  for (uint32_t i = 0U; i < calls; i++) {
+    uint32_t index = next_index();
+    sum += pid_update(&s_pid, s_inputs.currents[index], s_inputs.currents[(index + 1U) & BENCH_INPUT_MASK], BENCH_DT);
+  }
+
+  bench_consume(sum);
+}
+
+void bench_pll_setup(void) {
+  bench_utils_setup();
+  memset(&s_pll_config, 0, sizeof(s_pll_config));
+  s_pll_config.kp = 600.0f;
+  s_pll_config.ki = 90000.0f;
+  s_pll_config.max_omega = 10000.0f;
+  s_pll_config.filter_alpha = 0.05f;
+  s_pll_config.enable_filtering = true;
+  pll_init(&s_pll, &s_pll_config);
+}
+
+void bench_pll_scheduled_setup(void) {
+  bench_pll_setup();
+  s_pll_config.gain_schedule = s_pll_gain_schedule;
+  s_pll_config.num_gain_points = (uint8_t)(sizeof(s_pll_gain_schedule) / sizeof(s_pll_gain_schedule[0]));
+  s_pll_config.track_acceleration = true;
+  pll_init(&s_pll, &s_pll_config);
+}
+
+void bench_pll_update(uint32_t calls) {
+  float sum = 0.0f;
+
+  for (uint32_t i = 0U; i < calls; i++) {
+    float theta, omega;
+    pll_update(&s_pll, s_inputs.errors[next_index()], BENCH_DT, &theta, &omega);
+    sum += theta + omega;
+  }
+
+  bench_consume(sum);
+}
+
+void bench_hall_estimator_setup(void) {
+  bench_utils_setup();
+  hall_estimator_init(&s_hall_estimator, &s_hall_config);
+  s_hall_time_us = 0U;
+}
+
+void bench_hall_estimator_update(uint32_t calls) {
+  float sum = 0.0f;
+
+  for (uint32_t i = 0U; i < calls; i++) {
+    uint32_t sector = (s_hall_time_us / (BENCH_HALL_PERIOD_US * BENCH_HALL_CALLS_PER_SECTOR)) % HALL_NUM_SECTORS;
+    float theta, omega;
+
+    hall_estimator_update(&s_hall_estimator, s_hall_sequence[sector], s_hall_time_us, &theta, &omega);
+    s_hall_time_us += BENCH_HALL_PERIOD_US;
+    sum += theta + omega;
+  }
+
+  bench_consume(sum);
+}
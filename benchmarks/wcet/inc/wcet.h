@@ -0,0 +1,151 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   wcet.h
+ *
+ * @brief  Header file for the worst-case execution time explorer
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup Wcet Worst-case execution time explorer
+ * @brief    Times single calls of a kernel over boundary and random inputs, and keeps the inputs behind the slowest ones
+ * @details  Boundary inputs combine the special values of each argument: signed zeros, denormals, the float limits,
+ *           infinities, NaN, huge angles and the edges of the argument's range. Random inputs draw each argument over its
+ *           range, swapping in a boundary value now and then. Every input is timed over a few calls, keeping the fastest,
+ *           so an interrupt landing on one call does not pass for a data-dependent cost. A call still running after the
+ *           timeout is abandoned and reported as a hang. A boundary value, or a pair of them, behind a few hangs and no
+ *           return is taken to hang on its own, and the inputs carrying it afterwards are skipped rather than each waiting
+ *           out the timeout
+ * @{
+ */
+
+#define WCET_MAX_ARGS 4U                      /**< Most float arguments of a kernel */
+#define WCET_NUM_WORST 3U                     /**< Slowest inputs kept per kernel */
+#define WCET_MAX_BOUNDARY_INPUTS 8192U        /**< Boundary combinations timed, sampled when a kernel has more */
+#define WCET_HANGS_TO_SKIP 2U                 /**< Hangs without a return after which boundary values are skipped */
+#define WCET_DEFAULT_NUM_RANDOM_INPUTS 20000U /**< Random inputs per kernel */
+#define WCET_DEFAULT_NUM_REPEATS 8U           /**< Calls timed per input, the fastest is kept */
+#define WCET_DEFAULT_TIMEOUT_MS 25U           /**< Time after which a call counts as a hang (ms) */
+#define WCET_DEFAULT_SEED 0x2545F491U         /**< Seed of the random inputs */
+
+/**
+ * @brief   Kind of argument, picking the boundary values it is driven with
+ */
+typedef enum {
+  WCET_ARG_ANGLE,     /**< Angle, with sector edges, multiples of 2pi and huge angles */
+  WCET_ARG_SIGNED,    /**< Signed quantity, with zeros, denormals, the float limits and infinities */
+  WCET_ARG_MAGNITUDE, /**< Quantity expected to be positive, with the same specials and a negative one */
+} WcetArgType_t;
+
+/**
+ * @brief   Argument of a kernel
+ */
+struct WcetArg_t {
+  const char *name;   /**< Name in the report */
+  WcetArgType_t type; /**< Boundary values to use */
+  float min;          /**< Smallest random input, also a boundary value */
+  float max;          /**< Largest random input, also a boundary value */
+};
+
+/**
+ * @brief   Kernel to explore
+ */
+struct WcetKernel_t {
+  const char *name;                     /**< Name in the report */
+  struct WcetArg_t args[WCET_MAX_ARGS]; /**< Arguments, the inputs of the call and any state it starts from */
+  uint32_t num_args;                    /**< Number of arguments */
+  void (*prepare)(const float *args);   /**< Set up the state the call starts from, untimed, NULL for none */
+  void (*run)(const float *args);       /**< Make the timed call */
+};
+
+/**
+ * @brief   One input and its cost
+ */
+struct WcetInput_t {
+  float args[WCET_MAX_ARGS]; /**< Argument values */
+  bool is_random;            /**< TRUE for a random input, FALSE for a boundary one */
+  uint64_t cycles;           /**< Fastest of the timed calls (cycles) */
+};
+
+/**
+ * @brief   Exploration settings
+ */
+struct WcetOptions_t {
+  uint32_t num_random_inputs; /**< Random inputs per kernel */
+  uint32_t num_repeats;       /**< Calls timed per input */
+  uint32_t timeout_ms;        /**< Time after which a call counts as a hang (ms) */
+  uint32_t seed;              /**< Seed of the random inputs */
+};
+
+/**
+ * @brief   Outcome of exploring a kernel
+ */
+struct WcetResult_t {
+  const struct WcetKernel_t *kernel;        /**< Kernel explored */
+  uint32_t num_inputs;                      /**< Inputs timed, boundary and random */
+  double mean_cycles;                       /**< Mean cost over the random inputs (cycles) */
+  struct WcetInput_t worst[WCET_NUM_WORST]; /**< Slowest inputs, slowest first */
+  uint32_t num_worst;                       /**< Entries in worst */
+  uint32_t num_hangs;                       /**< Inputs whose call did not return within the timeout */
+  uint32_t num_skipped;                     /**< Inputs skipped for carrying a value taken to hang */
+  struct WcetInput_t first_hang;            /**< First input that hung, valid when num_hangs is not 0 */
+};
+
+/**
+ * @brief   Keep a value alive, so the compiler cannot drop the call producing it
+ * @param   value Result of a timed call
+ */
+void wcet_consume(float value);
+
+/**
+ * @brief   Name of the counter the cycles are read from
+ * @return  "tsc", "cntvct" or "ns" when no counter is available and nanoseconds are counted instead
+ */
+const char *wcet_counter_name(void);
+
+/**
+ * @brief   Length of a counter cycle, measured against the monotonic clock
+ * @return  Nanoseconds per cycle
+ */
+double wcet_ns_per_cycle(void);
+
+/**
+ * @brief   Time a kernel over its boundary inputs, then over random ones
+ * @param   kernel Kernel to explore
+ * @param   options Exploration settings
+ * @param   result Pointer to store the outcome
+ * @return  0 if successful, -1 if the timeout could not be set up
+ */
+int wcet_explore(const struct WcetKernel_t *kernel, const struct WcetOptions_t *options, struct WcetResult_t *result);
+
+/**
+ * @brief   Print the inputs of a kernel as name=value pairs
+ * @param   file File to write
+ * @param   kernel Kernel the input belongs to
+ * @param   input Input to print
+ */
+void wcet_print_input(FILE *file, const struct WcetKernel_t *kernel, const struct WcetInput_t *input);
+
+/**
+ * @brief   Write outcomes as JSON
+ * @param   file File to write
+ * @param   results Outcomes to write
+ * @param   num_results Number of outcomes
+ * @param   options Settings the outcomes were explored with
+ */
+void wcet_write_json(FILE *file, const struct WcetResult_t *results, size_t num_results, const struct WcetOptions_t *options);
+
+/** @} */
@@ -0,0 +1,32 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   wcet_kernels.h
+ *
+ * @brief  Header file for the control kernels the worst-case execution time explorer drives
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stddef.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "wcet.h"
+
+/**
+ * @addtogroup Wcet
+ * @{
+ */
+
+/**
+ * @brief   Kernels to explore
+ * @param   num_kernels Pointer to store the number of kernels
+ * @return  Table of kernels
+ */
+const struct WcetKernel_t *wcet_kernels_get(size_t *num_kernels);
+
+/** @} */
@@ -0,0 +1,495 @@
+/*******************************************************************************************************************************
+ * @file   wcet.c
+ *
+ * @brief  Source file for the worst-case execution time explorer
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <float.h>
+#include <math.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/* Inter-component Headers */
+#include "math_utils.h"
+
+/* Intra-component Headers */
+#include "wcet.h"
+
+#define WCET_MAX_BOUNDARY_VALUES 32U  /**< Most boundary values of one argument */
+#define WCET_CLOCK_SAMPLES 1001U      /**< Empty timed regions measured to find the cost of the counter reads */
+#define WCET_CALIBRATION_NS 20000000U /**< Time the counter is compared with the monotonic clock over (ns) */
+#define WCET_MIX_IN_MASK 7U           /**< A random argument is swapped for a boundary value one time in eight */
+
+#if defined(__x86_64__) || defined(__i386__)
+#define WCET_COUNTER_NAME "tsc"
+#elif defined(__aarch64__)
+#define WCET_COUNTER_NAME "cntvct"
+#else
+#define WCET_COUNTER_NAME "ns"
+#endif
+
+static volatile float s_sink;
+
+static sigjmp_buf s_timeout_jump;
+static volatile sig_atomic_t s_is_armed = 0;
+static bool s_is_handler_installed = false;
+
+static inline uint64_t now_ns(void) {
+  struct timespec time;
+
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+}
+
+/* Fenced on both sides, so the timed call can neither start before the first read nor finish after the second */
+static inline uint64_t read_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_lfence();
+  uint64_t cycles = __rdtsc();
+  _mm_lfence();
+  return cycles;
+#elif defined(__aarch64__)
+  uint64_t cycles;
+  __asm__ volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(cycles) : : "memory");
+  return cycles;
+#else
+  return now_ns();
+#endif
+}
+
+static uint64_t counter_overhead(void) {
+  static uint64_t s_overhead = UINT64_MAX;
+
+  if (s_overhead != UINT64_MAX) {
+    return s_overhead;
+  }
+
+  for (uint32_t i = 0U; i < WCET_CLOCK_SAMPLES; i++) {
+    uint64_t start = read_cycles();
+    uint64_t elapsed = read_cycles() - start;
+
+    s_overhead = (elapsed < s_overhead) ? elapsed : s_overhead;
+  }
+
+  return s_overhead;
+}
+
+static void on_timeout(int signal_number) {
+  (void)signal_number;
+
+  if (s_is_armed) {
+    s_is_armed = 0;
+    siglongjmp(s_timeout_jump, 1);
+  }
+}
+
+static int install_timeout_handler(void) {
+  struct sigaction action;
+
+  if (s_is_handler_installed) {
+    return 0;
+  }
+
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = on_timeout;
+  sigemptyset(&action.sa_mask);
+
+  if (sigaction(SIGALRM, &action, NULL) != 0) {
+    return -1;
+  }
+
+  s_is_handler_installed = true;
+  return 0;
+}
+
+static void arm_timeout(uint32_t timeout_ms) {
+  struct itimerval timer;
+
+  memset(&timer, 0, sizeof(timer));
+  timer.it_value.tv_sec = (time_t)(timeout_ms / 1000U);
+  timer.it_value.tv_usec = (suseconds_t)((timeout_ms % 1000U) * 1000U);
+
+  s_is_armed = 1;
+  setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+static void disarm_timeout(void) {
+  struct itimerval timer;
+
+  s_is_armed = 0;
+  memset(&timer, 0, sizeof(timer));
+  setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+/* xorshift32, never 0 for a seed that is not 0 */
+static uint32_t next_random(uint32_t *seed) {
+  *seed ^= *seed << 13U;
+  *seed ^= *seed >> 17U;
+  *seed ^= *seed << 5U;
+  return *seed;
+}
+
+static float random_between(uint32_t *seed, float min, float max) {
+  return min + (max - min) * (float)(next_random(seed) >> 8U) / (float)(1U << 24U);
+}
+
+static uint32_t boundary_values(const struct WcetArg_t *arg, float *values) {
+  uint32_t count = 0U;
+
+  /* Every type: the ends of the range, both zeros, the smallest denormal and the non-finite values */
+  values[count++] = arg->min;
+  values[count++] = arg->max;
+  values[count++] = 0.0f;
+  values[count++] = -0.0f;
+  values[count++] = FLT_TRUE_MIN;
+  values[count++] = INFINITY;
+  values[count++] = NAN;
+
+  switch (arg->type) {
+    case WCET_ARG_ANGLE:
+      /* Sector edges of the SVPWM switch, either side of the wrap, and angles far enough out to loop for long */
+      values[count++] = -FLT_TRUE_MIN;
+      values[count++] = -FLT_EPSILON;
+      values[count++] = nextafterf(MATH_PI_OVER_3, 0.0f);
+      values[count++] = MATH_PI_OVER_3;
+      values[count++] = MATH_PI;
+      values[count++] = 5.0f * MATH_PI_OVER_3;
+      values[count++] = nextafterf(MATH_TWO_PI, 0.0f);
+      values[count++] = MATH_TWO_PI;
+      values[count++] = -MATH_TWO_PI;
+      values[count++] = 1e3f;
+      values[count++] = -1e3f;
+      values[count++] = 1e5f;
+      values[count++] = -1e5f;
+      values[count++] = 1e7f;
+      values[count++] = -1e7f;
+      values[count++] = 1e9f;
+      values[count++] = -INFINITY;
+      break;
+
+    case WCET_ARG_SIGNED:
+      values[count++] = -FLT_TRUE_MIN;
+      values[count++] = FLT_MIN;
+      values[count++] = -FLT_MIN;
+      values[count++] = 1.0f;
+      values[count++] = -1.0f;
+      values[count++] = 1e20f;
+      values[count++] = -1e20f;
+      values[count++] = FLT_MAX;
+      values[count++] = -FLT_MAX;
+      values[count++] = -INFINITY;
+      break;
+
+    case WCET_ARG_MAGNITUDE:
+      values[count++] = FLT_MIN;
+      values[count++] = 1e-20f;
+      values[count++] = 1e-6f;
+      values[count++] = 1.0f;
+      values[count++] = 1e6f;
+      values[count++] = 1e20f;
+      values[count++] = FLT_MAX;
+      values[count++] = -1.0f;
+      break;
+
+    default:
+      break;
+  }
+
+  return count;
+}
+
+/* Fastest of the timed calls of an input, or FALSE if a call did not return within the timeout */
+static bool time_input(const struct WcetKernel_t *kernel, const struct WcetOptions_t *options, struct WcetInput_t *input) {
+  uint64_t overhead = counter_overhead();
+  uint64_t fastest = UINT64_MAX;
+
+  for (uint32_t repeat = 0U; repeat < options->num_repeats; repeat++) {
+    if (kernel->prepare != NULL) {
+      kernel->prepare(input->args);
+    }
+
+    /* The kernel is abandoned where it stands, its state is prepared again before any further call */
+    if (sigsetjmp(s_timeout_jump, 1) != 0) {
+      return false;
+    }
+
+    arm_timeout(options->timeout_ms);
+    uint64_t start = read_cycles();
+    kernel->run(input->args);
+    uint64_t elapsed = read_cycles() - start;
+    disarm_timeout();
+
+    elapsed = (elapsed > overhead) ? elapsed - overhead : 0U;
+    fastest = (elapsed < fastest) ? elapsed : fastest;
+  }
+
+  input->cycles = fastest;
+  return true;
+}
+
+/**
+ * @brief   Outcomes of the inputs carrying each pair of boundary values, a value on its own being the pair of arg with itself
+ */
+struct WcetValueStats_t {
+  uint16_t hangs[WCET_MAX_ARGS][WCET_MAX_ARGS][WCET_MAX_BOUNDARY_VALUES][WCET_MAX_BOUNDARY_VALUES];   /**< Inputs that hung */
+  uint16_t returns[WCET_MAX_ARGS][WCET_MAX_ARGS][WCET_MAX_BOUNDARY_VALUES][WCET_MAX_BOUNDARY_VALUES]; /**< Inputs that returned */
+};
+
+static struct WcetValueStats_t s_stats;
+
+static void record_worst(struct WcetResult_t *result, const struct WcetInput_t *input) {
+  uint32_t slot = result->num_worst;
+
+  /* The same input met again, from a random draw landing on boundary values, keeps one entry at its slowest */
+  for (uint32_t w = 0U; w < result->num_worst; w++) {
+    if (memcmp(result->worst[w].args, input->args, sizeof(input->args)) != 0) {
+      continue;
+    }
+
+    if (result->worst[w].cycles >= input->cycles) {
+      return;
+    }
+
+    memmove(&result->worst[w], &result->worst[w + 1U], (result->num_worst - w - 1U) * sizeof(result->worst[0]));
+    slot = --result->num_worst;
+    break;
+  }
+
+  /* Insertion into the list, slowest first */
+  while (slot > 0U && result->worst[slot - 1U].cycles < input->cycles) {
+    if (slot < WCET_NUM_WORST) {
+      result->worst[slot] = result->worst[slot - 1U];
+    }
+    slot--;
+  }
+
+  if (slot < WCET_NUM_WORST) {
+    result->worst[slot] = *input;
+    result->num_worst += (result->num_worst < WCET_NUM_WORST) ? 1U : 0U;
+  }
+}
+
+static bool is_known_hang(const struct WcetValueStats_t *stats, uint32_t num_args, const int32_t *picks) {
+  for (uint32_t a = 0U; a < num_args; a++) {
+    for (uint32_t b = a; b < num_args && picks[a] >= 0; b++) {
+      if (picks[b] >= 0 && stats->returns[a][b][picks[a]][picks[b]] == 0U &&
+          stats->hangs[a][b][picks[a]][picks[b]] >= WCET_HANGS_TO_SKIP) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+static void count_outcome(struct WcetValueStats_t *stats, uint32_t num_args, const int32_t *picks, bool has_returned) {
+  for (uint32_t a = 0U; a < num_args; a++) {
+    for (uint32_t b = a; b < num_args && picks[a] >= 0; b++) {
+      if (picks[b] < 0) {
+        continue;
+      }
+
+      uint16_t *count = has_returned ? &stats->returns[a][b][picks[a]][picks[b]] : &stats->hangs[a][b][picks[a]][picks[b]];
+      *count = (*count < UINT16_MAX) ? *count + 1U : *count;
+    }
+  }
+}
+
+/**
+ * @brief   Time an input and record its outcome
+ * @param   picks Boundary value index of each argument, -1 for a value drawn over the range
+ * @return  TRUE if the input was timed, FALSE if it hung or was skipped
+ */
+static bool explore_input(const struct WcetKernel_t *kernel, const struct WcetOptions_t *options, struct WcetInput_t *input,
+                          const int32_t *picks, struct WcetResult_t *result) {
+  if (is_known_hang(&s_stats, kernel->num_args, picks)) {
+    result->num_skipped++;
+    return false;
+  }
+
+  result->num_inputs++;
+  bool has_returned = time_input(kernel, options, input);
+  count_outcome(&s_stats, kernel->num_args, picks, has_returned);
+
+  if (!has_returned) {
+    if (result->num_hangs++ == 0U) {
+      result->first_hang = *input;
+    }
+    return false;
+  }
+
+  record_worst(result, input);
+  return true;
+}
+
+void wcet_consume(float value) {
+  s_sink = value;
+}
+
+const char *wcet_counter_name(void) {
+  return WCET_COUNTER_NAME;
+}
+
+double wcet_ns_per_cycle(void) {
+  static double s_ns_per_cycle = 0.0;
+
+  if (s_ns_per_cycle > 0.0) {
+    return s_ns_per_cycle;
+  }
+
+  uint64_t start_ns = now_ns();
+  uint64_t start_cycles = read_cycles();
+  uint64_t end_ns = start_ns;
+
+  while (end_ns - start_ns < WCET_CALIBRATION_NS) {
+    end_ns = now_ns();
+  }
+
+  uint64_t cycles = read_cycles() - start_cycles;
+
+  s_ns_per_cycle = (cycles > 0U) ? (double)(end_ns - start_ns) / (double)cycles : 1.0;
+  return s_ns_per_cycle;
+}
+
+int wcet_explore(const struct WcetKernel_t *kernel, const struct WcetOptions_t *options, struct WcetResult_t *result) {
+  float values[WCET_MAX_ARGS][WCET_MAX_BOUNDARY_VALUES];
+  uint32_t num_values[WCET_MAX_ARGS];
+  int32_t picks[WCET_MAX_ARGS];
+  uint64_t num_combinations = 1U;
+  uint32_t seed = (options->seed != 0U) ? options->seed : WCET_DEFAULT_SEED;
+
+  memset(result, 0, sizeof(*result));
+  memset(&s_stats, 0, sizeof(s_stats));
+  result->kernel = kernel;
+
+  if (kernel->num_args > WCET_MAX_ARGS || install_timeout_handler() != 0) {
+    return -1;
+  }
+
+  for (uint32_t arg = 0U; arg < kernel->num_args; arg++) {
+    num_values[arg] = boundary_values(&kernel->args[arg], values[arg]);
+    num_combinations *= num_values[arg];
+  }
+
+  /* Every combination of the boundary values, or as many sampled from them */
+  bool is_sampled = num_combinations > WCET_MAX_BOUNDARY_INPUTS;
+  uint64_t num_boundary_inputs = is_sampled ? WCET_MAX_BOUNDARY_INPUTS : num_combinations;
+
+  for (uint64_t i = 0U; i < num_boundary_inputs; i++) {
+    struct WcetInput_t input = { .is_random = false };
+    uint64_t combination = i;
+
+    if (is_sampled) {
+      uint64_t wide = ((uint64_t)next_random(&seed) << 32U) | next_random(&seed);
+      combination = wide % num_combinations;
+    }
+
+    for (uint32_t arg = 0U; arg < kernel->num_args; arg++) {
+      picks[arg] = (int32_t)(combination % num_values[arg]);
+      input.args[arg] = values[arg][picks[arg]];
+      combination /= num_values[arg];
+    }
+
+    explore_input(kernel, options, &input, picks, result);
+  }
+
+  /* Random inputs over the ranges. One with a boundary value mixed in is kept out of the mean */
+  double random_cycles = 0.0;
+  uint32_t num_random_timed = 0U;
+
+  for (uint32_t i = 0U; i < options->num_random_inputs; i++) {
+    struct WcetInput_t input = { .is_random = true };
+
+    for (uint32_t arg = 0U; arg < kernel->num_args; arg++) {
+      if ((next_random(&seed) & WCET_MIX_IN_MASK) == 0U) {
+        picks[arg] = (int32_t)(next_random(&seed) % num_values[arg]);
+        input.args[arg] = values[arg][picks[arg]];
+        input.is_random = false;
+      } else {
+        picks[arg] = -1;
+        input.args[arg] = random_between(&seed, kernel->args[arg].min, kernel->args[arg].max);
+      }
+    }
+
+    if (explore_input(kernel, options, &input, picks, result) && input.is_random) {
+      random_cycles += (double)input.cycles;
+      num_random_timed++;
+    }
+  }
+
+  result->mean_cycles = (num_random_timed > 0U) ? random_cycles / (double)num_random_timed : 0.0;
+  return 0;
+}
+
+void wcet_print_input(FILE *file, const struct WcetKernel_t *kernel, const struct WcetInput_t *input) {
+  for (uint32_t arg = 0U; arg < kernel->num_args; arg++) {
+    fprintf(file, "%s%s=%g", (arg > 0U) ? " " : "", kernel->args[arg].name, input->args[arg]);
+  }
+}
+
+/* JSON has no NaN or infinities, those go in as strings */
+static void write_json_float(FILE *file, float value) {
+  if (isnan(value)) {
+    fprintf(file, "\"nan\"");
+  } else if (isinf(value)) {
+    fprintf(file, "\"%sinf\"", (value < 0.0f) ? "-" : "");
+  } else {
+    fprintf(file, "%.9g", value);
+  }
+}
+
+static void write_json_args(FILE *file, const struct WcetKernel_t *kernel, const struct WcetInput_t *input) {
+  fprintf(file, "{");
+
+  for (uint32_t arg = 0U; arg < kernel->num_args; arg++) {
+    fprintf(file, "%s\"%s\": ", (arg > 0U) ? ", " : "", kernel->args[arg].name);
+    write_json_float(file, input->args[arg]);
+  }
+
+  fprintf(file, "}");
+}
+
+void wcet_write_json(FILE *file, const struct WcetResult_t *results, size_t num_results, const struct WcetOptions_t *options) {
+  fprintf(file, "{\n");
+  fprintf(file, "  \"counter\": \"%s\", \"ns_per_cycle\": %.4f, \"repeats\": %u, \"timeout_ms\": %u, \"random_inputs\": %u, \"seed\": %u,\n",
+          wcet_counter_name(), wcet_ns_per_cycle(), options->num_repeats, options->timeout_ms, options->num_random_inputs, options->seed);
+  fprintf(file, "  \"kernels\": [\n");
+
+  for (size_t i = 0U; i < num_results; i++) {
+    const struct WcetResult_t *result = &results[i];
+    uint64_t worst_cycles = (result->num_worst > 0U) ? result->worst[0].cycles : 0U;
+
+    fprintf(file, "    {\"name\": \"%s\", \"inputs\": %u, \"mean_cycles\": %.1f, \"worst_cycles\": %llu, \"hangs\": %u, \"skipped\": %u,\n",
+            result->kernel->name, result->num_inputs, result->mean_cycles, (unsigned long long)worst_cycles, result->num_hangs, result->num_skipped);
+    fprintf(file, "     \"worst\": [");
+
+    for (uint32_t w = 0U; w < result->num_worst; w++) {
+      fprintf(file, "%s{\"cycles\": %llu, \"source\": \"%s\", \"args\": ", (w > 0U) ? ", " : "",
+              (unsigned long long)result->worst[w].cycles, result->worst[w].is_random ? "random" : "boundary");
+      write_json_args(file, result->kernel, &result->worst[w]);
+      fprintf(file, "}");
+    }
+
+    fprintf(file, "]");
+
+    if (result->num_hangs > 0U) {
+      fprintf(file, ",\n     \"first_hang\": ");
+      write_json_args(file, result->kernel, &result->first_hang);
+    }
+
+    fprintf(file, "}%s\n", (i + 1U < num_results) ? "," : "");
+  }
+
+  fprintf(file, "  ]\n}\n");
+}
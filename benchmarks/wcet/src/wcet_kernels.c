@@ -0,0 +1,278 @@
+/*******************************************************************************************************************************
+ * @file   wcet_kernels.c
+ *
+ * @brief  Source file for the control kernels the worst-case execution time explorer drives
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+#include "foc_field_weakening.h"
+#include "math_utils.h"
+#include "pid.h"
+#include "pll.h"
+#include "svpwm.h"
+#include "transform_utils.h"
+
+/* Intra-component Headers */
+#include "wcet.h"
+#include "wcet_kernels.h"
+
+#define WCET_POLE_PAIRS 7U       /**< Pole pairs of the mechanical to electrical conversion */
+#define WCET_CLAMP_LIMIT 10.0f   /**< Limits of the clamp kernel, either sign */
+#define WCET_CURRENT_RANGE 40.0f /**< Random currents, either sign (A) */
+#define WCET_VOLTAGE_RANGE 30.0f /**< Random voltages, either sign (V) */
+#define WCET_MAX_OMEGA 5000.0f   /**< Speed limit of the PLLs (rad/s) */
+
+static struct PidConfig_t s_pid_config = {
+  .kp = 0.5f, .ki = 20.0f, .kd = 0.001f, .output_min = -10.0f, .output_max = 10.0f, .derivative_ema_alpha = 0.2f
+};
+static struct PidController_t s_pid;
+
+static const struct PLLConfig_t s_pll_config = { .kp = 400.0f, .ki = 40000.0f, .max_omega = WCET_MAX_OMEGA };
+
+/* Bandwidths of the scheduled PLL, as in the sensorless driver's speed range */
+static const struct PLLGainPoint_t s_pll_gain_schedule[] = {
+  { .omega = 100.0f, .bandwidth = 150.0f },
+  { .omega = 1000.0f, .bandwidth = 400.0f },
+  { .omega = 5000.0f, .bandwidth = 800.0f },
+};
+static const struct PLLConfig_t s_pll_scheduled_config = {
+  .max_omega = WCET_MAX_OMEGA,
+  .gain_schedule = s_pll_gain_schedule,
+  .num_gain_points = sizeof(s_pll_gain_schedule) / sizeof(s_pll_gain_schedule[0]),
+  .track_acceleration = true,
+};
+static struct PLLState_t s_pll;
+
+static const struct FieldWeakeningConfig_t s_field_weakening_config = { .voltage_margin = 0.95f, .id_min = -10.0f, .id_max = 0.0f, .k_fw = 0.1f };
+static struct FieldWeakeningState_t s_field_weakening;
+
+static void run_normalize_angle(const float *args) {
+  wcet_consume(normalize_angle(args[0]));
+}
+
+static void run_mech_to_elec_angle(const float *args) {
+  wcet_consume(mech_to_elec_angle(args[0], WCET_POLE_PAIRS));
+}
+
+static void run_fast_sin_cos(const float *args) {
+  float sin_out, cos_out;
+
+  fast_sin_cos(args[0], &sin_out, &cos_out);
+  wcet_consume(sin_out + cos_out);
+}
+
+static void run_sqrtf(const float *args) {
+  wcet_consume(sqrtf(args[0]));
+}
+
+static void run_fast_inv_sqrt(const float *args) {
+  wcet_consume(fast_inv_sqrt(args[0]));
+}
+
+static void run_clamp(const float *args) {
+  wcet_consume(clamp(args[0], -WCET_CLAMP_LIMIT, WCET_CLAMP_LIMIT));
+}
+
+static void run_clarke_transform_3phase(const float *args) {
+  float alpha, beta;
+
+  clarke_transform_3phase(args[0], args[1], args[2], &alpha, &beta);
+  wcet_consume(alpha + beta);
+}
+
+static void run_park_transform(const float *args) {
+  float d, q;
+
+  park_transform(args[0], args[1], args[2], &d, &q);
+  wcet_consume(d + q);
+}
+
+static void run_inverse_park_transform(const float *args) {
+  float alpha, beta;
+
+  inverse_park_transform(args[0], args[1], args[2], &alpha, &beta);
+  wcet_consume(alpha + beta);
+}
+
+static void run_svpwm_generate(const float *args) {
+  float duty_a, duty_b, duty_c;
+
+  svpwm_generate(args[0], args[1], &duty_a, &duty_b, &duty_c);
+  wcet_consume(duty_a + duty_b + duty_c);
+}
+
+/* The previous error is part of the input, it decides whether the derivative is taken */
+static void prepare_pid_update(const float *args) {
+  pid_init(&s_pid, &s_pid_config);
+  s_pid.prev_error = args[3];
+}
+
+static void run_pid_update(const float *args) {
+  wcet_consume(pid_update(&s_pid, args[0], args[1], args[2]));
+}
+
+/* The angle and the integrator speed the update starts from are part of the input */
+static void prepare_pll_update(const float *args) {
+  pll_init(&s_pll, &s_pll_config);
+  s_pll.theta = args[2];
+  s_pll.integrator = args[3];
+}
+
+static void prepare_pll_update_scheduled(const float *args) {
+  pll_init(&s_pll, &s_pll_scheduled_config);
+  s_pll.theta = args[2];
+  s_pll.integrator = args[3];
+}
+
+static void run_pll_update(const float *args) {
+  float theta, omega;
+
+  pll_update(&s_pll, args[0], args[1], &theta, &omega);
+  wcet_consume(theta + omega);
+}
+
+static void prepare_field_weakening_update(const float *args) {
+  field_weakening_init(&s_field_weakening, &s_field_weakening_config);
+  s_field_weakening.id_ref = args[3];
+}
+
+static void run_field_weakening_update(const float *args) {
+  field_weakening_update(&s_field_weakening, args[0], args[1], args[2]);
+  wcet_consume(s_field_weakening.id_ref);
+}
+
+static const struct WcetKernel_t s_kernels[] = {
+  {
+    .name = "normalize_angle",
+    .args = { { "angle", WCET_ARG_ANGLE, -4.0f * MATH_TWO_PI, 4.0f * MATH_TWO_PI } },
+    .num_args = 1U,
+    .run = run_normalize_angle,
+  },
+  {
+    .name = "mech_to_elec_angle",
+    .args = { { "angle", WCET_ARG_ANGLE, 0.0f, MATH_TWO_PI } },
+    .num_args = 1U,
+    .run = run_mech_to_elec_angle,
+  },
+  {
+    .name = "fast_sin_cos",
+    .args = { { "angle", WCET_ARG_ANGLE, -4.0f * MATH_TWO_PI, 4.0f * MATH_TWO_PI } },
+    .num_args = 1U,
+    .run = run_fast_sin_cos,
+  },
+  {
+    .name = "sqrtf",
+    .args = { { "x", WCET_ARG_MAGNITUDE, 0.0f, 2.0f * WCET_VOLTAGE_RANGE * WCET_VOLTAGE_RANGE } },
+    .num_args = 1U,
+    .run = run_sqrtf,
+  },
+  {
+    .name = "fast_inv_sqrt",
+    .args = { { "x", WCET_ARG_MAGNITUDE, 1e-2f, 1e3f } },
+    .num_args = 1U,
+    .run = run_fast_inv_sqrt,
+  },
+  {
+    .name = "clamp",
+    .args = { { "value", WCET_ARG_SIGNED, -2.0f * WCET_CLAMP_LIMIT, 2.0f * WCET_CLAMP_LIMIT } },
+    .num_args = 1U,
+    .run = run_clamp,
+  },
+  {
+    .name = "clarke_transform_3phase",
+    .args = {
+      { "ia", WCET_ARG_SIGNED, -WCET_CURRENT_RANGE, WCET_CURRENT_RANGE },
+      { "ib", WCET_ARG_SIGNED, -WCET_CURRENT_RANGE, WCET_CURRENT_RANGE },
+      { "ic", WCET_ARG_SIGNED, -WCET_CURRENT_RANGE, WCET_CURRENT_RANGE },
+    },
+    .num_args = 3U,
+    .run = run_clarke_transform_3phase,
+  },
+  {
+    .name = "park_transform",
+    .args = {
+      { "alpha", WCET_ARG_SIGNED, -WCET_CURRENT_RANGE, WCET_CURRENT_RANGE },
+      { "beta", WCET_ARG_SIGNED, -WCET_CURRENT_RANGE, WCET_CURRENT_RANGE },
+      { "theta", WCET_ARG_ANGLE, 0.0f, MATH_TWO_PI },
+    },
+    .num_args = 3U,
+    .run = run_park_transform,
+  },
+  {
+    .name = "inverse_park_transform",
+    .args = {
+      { "d", WCET_ARG_SIGNED, -WCET_VOLTAGE_RANGE, WCET_VOLTAGE_RANGE },
+      { "q", WCET_ARG_SIGNED, -WCET_VOLTAGE_RANGE, WCET_VOLTAGE_RANGE },
+      { "theta", WCET_ARG_ANGLE, 0.0f, MATH_TWO_PI },
+    },
+    .num_args = 3U,
+    .run = run_inverse_park_transform,
+  },
+  {
+    .name = "svpwm_generate",
+    .args = {
+      { "theta_e", WCET_ARG_ANGLE, 0.0f, MATH_TWO_PI },
+      { "vref_mag", WCET_ARG_MAGNITUDE, 0.0f, 1.2f },
+    },
+    .num_args = 2U,
+    .run = run_svpwm_generate,
+  },
+  {
+    .name = "pid_update",
+    .args = {
+      { "set_point", WCET_ARG_SIGNED, -WCET_CURRENT_RANGE, WCET_CURRENT_RANGE },
+      { "measurement", WCET_ARG_SIGNED, -WCET_CURRENT_RANGE, WCET_CURRENT_RANGE },
+      { "delta_time", WCET_ARG_MAGNITUDE, 1e-5f, 1e-3f },
+      { "prev_error", WCET_ARG_SIGNED, -WCET_CURRENT_RANGE, WCET_CURRENT_RANGE },
+    },
+    .num_args = 4U,
+    .prepare = prepare_pid_update,
+    .run = run_pid_update,
+  },
+  {
+    .name = "pll_update",
+    .args = {
+      { "phase_error", WCET_ARG_SIGNED, -0.5f, 0.5f },
+      { "dt", WCET_ARG_MAGNITUDE, 1e-5f, 1e-3f },
+      { "theta", WCET_ARG_ANGLE, 0.0f, MATH_TWO_PI },
+      { "integrator", WCET_ARG_SIGNED, -WCET_MAX_OMEGA, WCET_MAX_OMEGA },
+    },
+    .num_args = 4U,
+    .prepare = prepare_pll_update,
+    .run = run_pll_update,
+  },
+  {
+    .name = "pll_update_scheduled",
+    .args = {
+      { "phase_error", WCET_ARG_SIGNED, -0.5f, 0.5f },
+      { "dt", WCET_ARG_MAGNITUDE, 1e-5f, 1e-3f },
+      { "theta", WCET_ARG_ANGLE, 0.0f, MATH_TWO_PI },
+      { "integrator", WCET_ARG_SIGNED, -WCET_MAX_OMEGA, WCET_MAX_OMEGA },
+    },
+    .num_args = 4U,
+    .prepare = prepare_pll_update_scheduled,
+    .run = run_pll_update,
+  },
+  {
+    .name = "field_weakening_update",
+    .args = {
+      { "vd", WCET_ARG_SIGNED, -WCET_VOLTAGE_RANGE, WCET_VOLTAGE_RANGE },
+      { "vq", WCET_ARG_SIGNED, -WCET_VOLTAGE_RANGE, WCET_VOLTAGE_RANGE },
+      { "vbus", WCET_ARG_MAGNITUDE, 6.0f, 60.0f },
+      { "id_ref", WCET_ARG_SIGNED, -10.0f, 0.0f },
+    },
+    .num_args = 4U,
+    .prepare = prepare_field_weakening_update,
+    .run = run_field_weakening_update,
+  },
+};
+
+const struct WcetKernel_t *wcet_kernels_get(size_t *num_kernels) {
+  *num_kernels = sizeof(s_kernels) / sizeof(s_kernels[0]);
+  return s_kernels;
+}
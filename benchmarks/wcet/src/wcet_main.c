@@ -0,0 +1,171 @@
+/*******************************************************************************************************************************
+ * @file   wcet_main.c
+ *
+ * @brief  Main file for the worst-case execution time explorer
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "wcet.h"
+#include "wcet_kernels.h"
+
+/**
+ * @brief   Command line options
+ */
+struct WcetCliOptions_t {
+  const char *json_path;        /**< File to write the outcomes to, NULL for none */
+  struct WcetOptions_t explore; /**< Exploration settings */
+};
+
+static void print_usage(const char *program) {
+  fprintf(stderr, "usage: %s [--json PATH] [--random N] [--repeats N] [--timeout-ms N] [--seed N] [FILTER...]\n", program);
+  fprintf(stderr, "  Explores the kernels whose names contain a filter, every kernel without filters.\n");
+  fprintf(stderr, "  Reports the mean cost over random inputs and the slowest inputs found, in counter cycles.\n");
+}
+
+/* Positive number of a numeric option, 0 when the value is missing or not a positive number */
+static uint32_t read_count(const char *value) {
+  char *end = NULL;
+  unsigned long count = (value != NULL) ? strtoul(value, &end, 0) : 0UL;
+
+  return (end != NULL && *end == '\0') ? (uint32_t)count : 0U;
+}
+
+/**
+ * @brief   Read the options, given before or between the filters
+ * @return  Number of filters, moved to the front of argv, or -1 on a bad option
+ */
+static int parse_options(int argc, char **argv, struct WcetCliOptions_t *options) {
+  int num_filters = 0;
+
+  for (int arg = 1; arg < argc; arg++) {
+    const char *value = (arg + 1 < argc) ? argv[arg + 1] : NULL;
+    uint32_t count = read_count(value);
+
+    if (strcmp(argv[arg], "--json") == 0 && value != NULL) {
+      options->json_path = value;
+      arg++;
+    } else if (strcmp(argv[arg], "--random") == 0 && value != NULL && (count > 0U || strcmp(value, "0") == 0)) {
+      options->explore.num_random_inputs = count;
+      arg++;
+    } else if (strcmp(argv[arg], "--repeats") == 0 && count > 0U) {
+      options->explore.num_repeats = count;
+      arg++;
+    } else if (strcmp(argv[arg], "--timeout-ms") == 0 && count > 0U) {
+      options->explore.timeout_ms = count;
+      arg++;
+    } else if (strcmp(argv[arg], "--seed") == 0 && count > 0U) {
+      options->explore.seed = count;
+      arg++;
+    } else if (strncmp(argv[arg], "--", 2) == 0) {
+      print_usage(argv[0]);
+      return -1;
+    } else {
+      argv[1 + num_filters++] = argv[arg];
+    }
+  }
+
+  return num_filters;
+}
+
+static void print_result(const struct WcetResult_t *result, double ns_per_cycle) {
+  uint64_t worst_cycles = (result->num_worst > 0U) ? result->worst[0].cycles : 0U;
+  double ratio = (result->mean_cycles > 0.0) ? (double)worst_cycles / result->mean_cycles : 0.0;
+
+  printf("%-24s %8u %12.1f %12llu %10.1f %6u %8u\n", result->kernel->name, result->num_inputs, result->mean_cycles,
+         (unsigned long long)worst_cycles, ratio, result->num_hangs, result->num_skipped);
+
+  for (uint32_t w = 0U; w < result->num_worst; w++) {
+    printf("    #%u %10llu cycles %10.3f us  %-8s  ", w + 1U, (unsigned long long)result->worst[w].cycles,
+           (double)result->worst[w].cycles * ns_per_cycle * 1e-3, result->worst[w].is_random ? "random" : "boundary");
+    wcet_print_input(stdout, result->kernel, &result->worst[w]);
+    printf("\n");
+  }
+
+  if (result->num_hangs > 0U) {
+    printf("    hang, first of %u:                            ", result->num_hangs);
+    wcet_print_input(stdout, result->kernel, &result->first_hang);
+    printf("\n");
+  }
+}
+
+int main(int argc, char **argv) {
+  struct WcetCliOptions_t options = {
+    .explore = {
+      .num_random_inputs = WCET_DEFAULT_NUM_RANDOM_INPUTS,
+      .num_repeats = WCET_DEFAULT_NUM_REPEATS,
+      .timeout_ms = WCET_DEFAULT_TIMEOUT_MS,
+      .seed = WCET_DEFAULT_SEED,
+    },
+  };
+  size_t num_kernels = 0U;
+  const struct WcetKernel_t *kernels = wcet_kernels_get(&num_kernels);
+  int num_filters = parse_options(argc, argv, &options);
+
+  if (num_filters < 0) {
+    return 2;
+  }
+
+  struct WcetResult_t *results = calloc(num_kernels, sizeof(*results));
+  size_t num_results = 0U;
+  double ns_per_cycle = wcet_ns_per_cycle();
+
+  if (results == NULL) {
+    fprintf(stderr, "out of memory\n");
+    return 2;
+  }
+
+  printf("counter %s, %.4f ns per cycle, fastest of %u calls per input, hang after %u ms\n", wcet_counter_name(), ns_per_cycle,
+         options.explore.num_repeats, options.explore.timeout_ms);
+  printf("%-24s %8s %12s %12s %10s %6s %8s\n", "kernel", "inputs", "mean_cycles", "worst_cycles", "worst/mean", "hangs", "skipped");
+
+  /* Without filters every kernel runs */
+  for (size_t i = 0U; i < num_kernels; i++) {
+    bool is_selected = (num_filters == 0);
+
+    for (int arg = 1; arg <= num_filters; arg++) {
+      is_selected = is_selected || (strstr(kernels[i].name, argv[arg]) != NULL);
+    }
+
+    if (!is_selected) {
+      continue;
+    }
+
+    if (wcet_explore(&kernels[i], &options.explore, &results[num_results]) != 0) {
+      fprintf(stderr, "%s: could not set up the exploration\n", kernels[i].name);
+      free(results);
+      return 2;
+    }
+
+    print_result(&results[num_results], ns_per_cycle);
+    fflush(stdout);
+    num_results++;
+  }
+
+  if (options.json_path != NULL) {
+    FILE *file = fopen(options.json_path, "w");
+
+    if (file == NULL) {
+      perror(options.json_path);
+      free(results);
+      return 2;
+    }
+
+    wcet_write_json(file, results, num_results, &options.explore);
+    fclose(file);
+  }
+
+  free(results);
+  return 0;
+}
@@ -28,12 +28,6 @@
  * Private defines and enums
  *******************************************************************************************************************************/
 
-#define PHASE_A_HIGH_COMMUTATION_IDX 0U
-#define PHASE_A_LOW_COMMUTATION_IDX 1U
-#define PHASE_B_HIGH_COMMUTATION_IDX 2U
-#define PHASE_B_LOW_COMMUTATION_IDX 3U
-#define PHASE_C_HIGH_COMMUTATION_IDX 4U
-#define PHASE_C_LOW_COMMUTATION_IDX 5U
 #define NUM_COMMUTATION_STEPS 6U
 
 #define DEFAULT_STARTUP_DUTY 0.20f             // Default startup PWM duty cycle (in decimal)
@@ -45,12 +39,21 @@
 #define STARTUP_DUTY_INCREMENT_PER_STEP 0.05f  // PWM duty cycle increment per step during startup
 #define MAX_STALL_TIME_MS 500U                 // Maximum time without movement before stall detection
 
+#define BLDC6STEP_SPEED_WINDOW 6U                /**< Commutation periods averaged for the speed estimate (one electrical revolution) */
+#define BLDC6STEP_RPM_PERIOD_PRODUCT 10000000.0f /**< Electrical RPM times the 60-degree period in microseconds (60e6 / 6) */
+#define BLDC6STEP_RPM_PER_STEP_RATE 10.0f        /**< Electrical RPM of one commutation step per second (60 / 6) */
+
+#define BLDC6STEP_DEFAULT_POSITION_CRUISE_RPM 3000.0f    /**< Default cruise speed of a point-to-point move (electrical RPM) */
+#define BLDC6STEP_DEFAULT_POSITION_ACCELERATION 20000.0f /**< Default acceleration of a point-to-point move (electrical RPM/s) */
+
 /**
  * @brief   Motor mode definitions
  */
 typedef enum {
   MOTOR_MODE_IDLE,       /**< Motor is in idle state (Just initialized) */
   MOTOR_MODE_STOPPED,    /**< Motor is stopped */
+  MOTOR_MODE_CATCHING,   /**< Bridge off, measuring the Back-EMF of a spinning rotor (flying start) */
+  MOTOR_MODE_DETECTING,  /**< Voltage pulses measuring the rotor position at standstill */
   MOTOR_MODE_ALIGNING,   /**< Initial rotor alignment phase */
   MOTOR_MODE_OPEN_LOOP,  /**< Open-loop startup sequence */
   MOTOR_MODE_TRANSITION, /**< Transition from open to closed loop */
@@ -59,24 +62,66 @@ typedef enum {
   MOTOR_MODE_ERROR       /**< Error state */
 } BLDC6StepMotorMode_t;
 
+/**
+ * @brief   6-step modulation schemes
+ * @details The sourcing phase is the one driven high in a step, the sinking phase the one driven low
+ */
+typedef enum {
+  BLDC6STEP_PWM_H_PWM_L_ON,    /**< Sourcing high side switches, sinking low side held on. Freewheels through the sourcing low diode */
+  BLDC6STEP_PWM_H_ON_L_PWM,    /**< Sourcing high side held on, sinking low side switches. Freewheels through the sinking high diode */
+  BLDC6STEP_PWM_COMPLEMENTARY, /**< H_PWM-L_ON with the sourcing low side synchronously rectifying the freewheel current */
+  BLDC6STEP_PWM_ALTERNATING,   /**< Every switch is held on for the first 60 degrees of its conduction and modulates the second */
+  NUM_BLDC6STEP_PWM_SCHEMES
+} BLDC6StepPwmScheme_t;
+
+/**
+ * @brief   Moving-window speed estimator over the last commutation periods
+ * @details Averaging a full electrical revolution cancels the per-sector asymmetry of Hall placement or zero-crossing
+ *          detection. The running sum keeps each update O(1) with a single division
+ */
+struct BLDC6StepSpeedEstimator_t {
+  uint32_t periods[BLDC6STEP_SPEED_WINDOW]; /**< Ring buffer of the most recent 60-degree periods (microseconds) */
+  uint32_t period_sum;                      /**< Running sum of the periods held in the ring buffer */
+  uint8_t index;                            /**< Next slot to overwrite in the ring buffer */
+  uint8_t count;                            /**< Number of valid periods in the ring buffer */
+  bool is_updated;                          /**< A period was pushed since the velocity loop last consumed the estimate */
+};
+
+/**
+ * @brief   Trapezoidal velocity profile limits of the position mode
+ */
+struct BLDC6StepPositionConfig_t {
+  float cruise_velocity; /**< Peak speed of a move (electrical RPM) */
+  float acceleration;    /**< Acceleration and deceleration of a move (electrical RPM/s) */
+};
+
+/**
+ * @brief   Trapezoidal position reference, in commutation steps (60 electrical degrees)
+ */
+struct BLDC6StepPositionProfile_t {
+  int32_t target; /**< Final position of the move (steps) */
+  float position; /**< Reference position (steps) */
+  float velocity; /**< Reference velocity (steps/s) */
+};
+
 /*******************************************************************************************************************************
  * Variables
  *******************************************************************************************************************************/
 
-extern const uint8_t bldc_6step_commutation_table[NUM_COMMUTATION_STEPS][NUM_COMMUTATION_STEPS];
+/** @brief  Packed HAL_GATE_* state of each commutation step, for every modulation scheme */
+extern const uint16_t bldc_6step_commutation_table[NUM_BLDC6STEP_PWM_SCHEMES][NUM_COMMUTATION_STEPS];
 
 /*******************************************************************************************************************************
  * Function definitions
  *******************************************************************************************************************************/
 
 /**
- * @brief   Sets the PWM duty cycle or low/float state for each motor phase based on the commutation
- * map
- * @param   commutation The 6-element array representing the current commutation step (1U for
- * active, 0U for inactive)
- * @param   pwm_duty The PWM duty cycle to apply to the HIGH side of the active phase
+ * @brief   Applies the gate states of a commutation step and the PWM duty cycle in a single HAL write
+ * @param   scheme Modulation scheme selecting the row of bldc_6step_commutation_table
+ * @param   step The commutation step (0-5)
+ * @param   pwm_duty The PWM duty cycle of the modulated switches
  */
-void _6step_bldc_set_phase_outputs(const uint8_t commutation[NUM_COMMUTATION_STEPS], float pwm_duty);
+void _6step_bldc_set_phase_outputs(BLDC6StepPwmScheme_t scheme, uint8_t step, float pwm_duty);
 
 /**
  * @brief   Determines the floating (un-driven) phase for a given 6-step commutation step
@@ -93,6 +138,56 @@ MotorPhase_t _6step_bldc_determine_floating_phase(uint8_t step);
  */
 float _6step_bldc_get_conducting_current(struct Motor_t *motor, uint8_t step);
 
+/**
+ * @brief   Clears the speed estimator window
+ * @param   estimator Pointer to the speed estimator
+ */
+void _6step_bldc_speed_estimator_reset(struct BLDC6StepSpeedEstimator_t *estimator);
+
+/**
+ * @brief   Pushes a measured 60-degree commutation period into the speed estimator window
+ * @param   estimator Pointer to the speed estimator
+ * @param   period_us Measured commutation period (microseconds)
+ * @return  Electrical speed averaged over the window (RPM)
+ */
+float _6step_bldc_speed_estimator_push(struct BLDC6StepSpeedEstimator_t *estimator, uint32_t period_us);
+
+/**
+ * @brief   Converts a mechanical angle to the nearest whole number of commutation steps
+ * @param   position Mechanical angle (rad)
+ * @param   pole_pairs Number of pole pairs, 0 is treated as 1
+ * @return  Signed commutation steps
+ */
+int32_t _6step_bldc_position_to_steps(float position, uint8_t pole_pairs);
+
+/**
+ * @brief   Converts commutation steps to a mechanical angle
+ * @param   steps Signed commutation steps
+ * @param   pole_pairs Number of pole pairs, 0 is treated as 1
+ * @return  Mechanical angle (rad)
+ */
+float _6step_bldc_steps_to_position(int32_t steps, uint8_t pole_pairs);
+
+/**
+ * @brief   Places the position reference at rest on the given step
+ * @param   profile Pointer to the position profile
+ * @param   steps Current position (steps)
+ */
+void _6step_bldc_position_profile_reset(struct BLDC6StepPositionProfile_t *profile, int32_t steps);
+
+/**
+ * @brief   Advances the position reference one control period towards the target
+ * @details The reference speed is the lower of the cruise speed and the speed that still stops at the target with
+ *          the configured deceleration, and slews at most one acceleration step per update. A move that would
+ *          reach the target within the period lands on it at rest. Non-positive limits jump straight to the target
+ * @param   profile Pointer to the position profile
+ * @param   config Pointer to the profile limits
+ * @param   delta_time Time since the previous update (s)
+ * @return  Reference velocity to feed forward (electrical RPM)
+ */
+float _6step_bldc_position_profile_update(struct BLDC6StepPositionProfile_t *profile, const struct BLDC6StepPositionConfig_t *config,
+                                          float delta_time);
+
 /**
  * @brief   Sets all phase currents to 0 and stops all PWM output
  */
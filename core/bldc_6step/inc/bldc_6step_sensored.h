@@ -25,15 +25,26 @@
  * @{
  */
 
+#define BLDC6STEP_SENSORED_SPEED_TIMEOUT_US 100000U /**< Time without a Hall edge before the speed is reported as 0 */
+#define BLDC6STEP_SENSORED_MAX_INVALID_EDGES 3U     /**< Consecutive illegal Hall edges tolerated before the driver faults */
+
 struct BLDC6StepSensoredData_t {
-  uint8_t step;                   /**< Current commutation step (0-5) */
-  bool direction;                 /**< Motor rotation direction (true for forward, false for reverse) */
-  float pwm_duty;                 /**< Current PWM duty cycle applied to the high side */
-  uint8_t last_hall_state;        /**< Last read Hall sensor state */
-  uint32_t last_commutation_time; /**< Timestamp of the last commutation (microseconds) */
-  uint32_t commutation_period;    /**< Estimated time for one 60-degree commutation step (microseconds) */
-  float estimated_speed;          /**< Estimated motor speed (RPM) */
-  BLDC6StepMotorMode_t mode;      /**< Current motor operational mode */
+  uint8_t step;                                            /**< Current commutation step (0-5) */
+  bool direction;                                          /**< Motor rotation direction (true for forward, false for reverse) */
+  float pwm_duty;                                          /**< Current PWM duty cycle applied to the high side */
+  BLDC6StepPwmScheme_t pwm_scheme;                         /**< Modulation scheme selecting the gate states of each step */
+  uint8_t last_hall_state;                                 /**< Hall state after the last legal captured edge */
+  uint8_t invalid_edges;                                   /**< Consecutive illegal Hall edges captured */
+  bool commutation_pending;                                /**< A captured edge has not been commutated yet */
+  int8_t edge_direction;                                   /**< Rotation sense of the last edge (+1 forward, -1 reverse, 0 unknown) */
+  uint32_t last_commutation_time;                          /**< Capture timestamp of the last Hall edge (microseconds) */
+  struct BLDC6StepSpeedEstimator_t speed_estimator;        /**< Moving window over the Hall edge-to-edge periods */
+  float estimated_speed;                                   /**< Estimated motor speed (RPM) */
+  uint32_t last_velocity_update_time;                      /**< Timestamp of the last velocity loop update (microseconds) */
+  int32_t position_steps;                                  /**< Signed Hall sectors travelled since startup (60 electrical degrees each) */
+  struct BLDC6StepPositionProfile_t position_profile;      /**< Trapezoidal reference followed in position mode */
+  const struct BLDC6StepPositionConfig_t *position_config; /**< Velocity and acceleration limits of a position move, kept out of the hot data */
+  BLDC6StepMotorMode_t mode;                               /**< Current motor operational mode */
 };
 
 /**
@@ -43,4 +54,20 @@ struct BLDC6StepSensoredData_t {
  */
 void bldc_6step_sensored_create_driver(struct Motor_t *motor);
 
+/**
+ * @brief   Sets the modulation scheme used by the sensored driver
+ * @details Takes effect on the next commutation step applied. Defaults to BLDC6STEP_PWM_H_PWM_L_ON
+ * @param   scheme Modulation scheme
+ */
+void bldc_6step_sensored_set_pwm_scheme(BLDC6StepPwmScheme_t scheme);
+
+/**
+ * @brief   Sets the trapezoidal profile limits of the position mode
+ * @details Position mode cascades the position PID (steps to electrical RPM) into the velocity PID, whose signed output
+ *          selects the drive direction. velocity_pid_config.output_min must be negative for moves in both directions.
+ *          The resolution is one Hall sector, 60 electrical degrees. Defaults to BLDC6STEP_DEFAULT_POSITION_*
+ * @param   config Pointer to the profile limits
+ */
+void bldc_6step_sensored_set_position_config(const struct BLDC6StepPositionConfig_t *config);
+
 /** @} */
@@ -25,21 +25,150 @@
  * @{
  */
 
+#define BLDC6STEP_MAX_DETECTION_PULSES 12U /**< Voltage pulse directions of the initial position detection, 30 degrees apart */
+
 typedef enum { ZC_STATE_RISING, ZC_STATE_FALLING } ZeroCrossingState_t;
 
+/**
+ * @brief   Star point estimate the floating phase voltage is compared against
+ */
+typedef enum {
+  ZC_REFERENCE_VIRTUAL_NEUTRAL, /**< Average of the three terminal voltages */
+  ZC_REFERENCE_HALF_BUS         /**< Half of the measured DC bus voltage, only valid when sampling inside the PWM on-time */
+} ZeroCrossingReference_t;
+
+/**
+ * @brief   Open-loop startup ramp configuration
+ * @details The commutation period starts at initial_period_us and is multiplied by acceleration_factor on every forced
+ *          step until it reaches final_period_us. After num_steps forced steps the driver keeps commutating at the
+ *          final period until the first Back-EMF zero-crossing hands over to closed-loop operation
+ */
+struct BLDC6StepStartupConfig_t {
+  float align_duty;               /**< PWM duty cycle used to align the rotor to step 0 */
+  uint32_t align_time_us;         /**< Alignment duration (microseconds) */
+  uint32_t initial_period_us;     /**< First open-loop commutation period (microseconds) */
+  uint32_t final_period_us;       /**< Shortest open-loop commutation period (microseconds) */
+  float acceleration_factor;      /**< Period multiplier applied on every open-loop step (smaller = faster) */
+  float initial_duty;             /**< PWM duty cycle of the first open-loop step */
+  float duty_increment;           /**< PWM duty cycle added on every open-loop step */
+  uint8_t num_steps;              /**< Number of forced open-loop steps before looking for zero-crossings */
+  uint32_t transition_timeout_us; /**< Time allowed to detect the first zero-crossing before reporting a stall */
+};
+
+/**
+ * @brief   Commutation timing configuration
+ * @details With delayed commutation the next step is scheduled on the one-shot HAL timer 30 degrees after the
+ *          interpolated zero-crossing, minus a speed dependent advance
+ */
+struct BLDC6StepCommutationConfig_t {
+  bool delayed_commutation;   /**< Commutate 30 degrees after the zero-crossing (false commutates on detection) */
+  float advance_deg_per_krpm; /**< Commutation advance per 1000 electrical RPM (electrical degrees) */
+  float max_advance_deg;      /**< Maximum commutation advance (electrical degrees) */
+  float blanking_fraction;    /**< Fraction of the commutation period ignored after a commutation (demagnetization) */
+};
+
+/**
+ * @brief   Zero-crossing detection configuration
+ * @details A crossing is confirmed once the Back-EMF passes the hysteresis. The hysteresis follows the estimated sample
+ *          noise, is capped by a fraction of the previous step Back-EMF peak so it stays reachable at low speed, and never
+ *          drops below min_hysteresis
+ */
+struct BLDC6StepZeroCrossingConfig_t {
+  ZeroCrossingReference_t reference; /**< Reference the floating phase voltage is compared against */
+  float sample_point;                /**< Position of the ADC trigger inside the PWM on-time (0.0 to 1.0) */
+  float min_hysteresis;              /**< Hysteresis floor (V) */
+  float noise_gain;                  /**< Hysteresis per volt of estimated sample noise */
+  float bemf_fraction;               /**< Hysteresis cap as a fraction of the previous step Back-EMF peak */
+};
+
+/**
+ * @brief   Flying start configuration
+ * @details With the bridge off all three terminals carry the Back-EMF. Its zero-crossings are timed for up to
+ *          catch_time_us: three consecutive crossings in the driver direction give the step and the speed, and the driver
+ *          enters closed-loop on the step of the last crossing with the duty matched to the Back-EMF. A rotor that stands,
+ *          turns the other way or is slower than the open-loop final period goes through the open-loop startup
+ */
+struct BLDC6StepFlyingStartConfig_t {
+  bool enabled;           /**< Look for a spinning rotor before the open-loop startup */
+  uint32_t catch_time_us; /**< Longest time the bridge floats waiting for the zero-crossings (microseconds) */
+};
+
+/**
+ * @brief   Initial position detection configuration
+ * @details Replaces the alignment of the open-loop startup. Full bus voltage pulses, too short to move the rotor, are
+ *          applied along num_pulses directions evenly spread over an electrical revolution and the current reached at
+ *          the end of each pulse is measured. The iron saturates when the pulse adds to the magnet flux, so the largest
+ *          current points at the north pole, and a rotor with Ld < Lq also draws more current along both ends of the
+ *          d-axis. The first forced step then leads the detected rotor, with no alignment and no backwards jerk
+ */
+struct BLDC6StepInitialPositionConfig_t {
+  bool enabled;            /**< Detect the rotor position instead of aligning it */
+  uint8_t num_pulses;      /**< Pulse directions, 6 (60 degrees apart) or 12 (30 degrees apart) */
+  uint32_t pulse_time_us;  /**< Duration of each pulse (microseconds) */
+  uint32_t settle_time_us; /**< Time the bridge floats after each pulse for the current to decay (microseconds) */
+};
+
+/**
+ * @brief   Sensorless driver configuration outside closed-loop commutation
+ * @details Kept out of BLDC6StepSensorlessData_t so it does not take up the MOTOR_HOT_DATA block
+ */
+struct BLDC6StepSensorlessColdConfig_t {
+  struct BLDC6StepPositionConfig_t position_config;                /**< Velocity and acceleration limits of a position move */
+  struct BLDC6StepStartupConfig_t startup_config;                  /**< Open-loop startup ramp configuration */
+  struct BLDC6StepFlyingStartConfig_t flying_start_config;         /**< Flying start configuration */
+  struct BLDC6StepInitialPositionConfig_t initial_position_config; /**< Initial position detection configuration */
+};
+
 struct BLDC6StepSensorlessData_t {
   uint8_t step;                          /**< Current commutation step (0-5) */
   bool direction;                        /**< Motor rotation direction (true for forward, false for reverse) */
   float pwm_duty;                        /**< Current PWM duty cycle applied to the high side */
+  BLDC6StepPwmScheme_t pwm_scheme;       /**< Modulation scheme selecting the gate states of each step */
   ZeroCrossingState_t zc_state;          /**< Expected zero-crossing state (rising or falling) */
-  float zc_threshold;                    /**< Back-EMF zero-crossing threshold */
+  float zc_hysteresis;                   /**< Back-EMF level that confirms a zero-crossing (V) */
   float bemf[NUM_MOTOR_PHASES];          /**< Raw Back-EMF readings for each phase */
   float bemf_filtered[NUM_MOTOR_PHASES]; /**< Filtered Back-EMF readings */
   float bemf_filter_alpha;               /**< Alpha value for the BEMF low-pass filter */
-  uint32_t last_zc_time;                 /**< Timestamp of the last zero-crossing event (microseconds) */
-  uint32_t commutation_period;           /**< Estimated time for one 60-degree commutation step (microseconds) */
-  float estimated_speed;                 /**< Estimated motor speed (RPM) */
+  uint32_t last_zc_time;                 /**< Interpolated timestamp of the last zero-crossing event (microseconds) */
+  uint32_t last_commutation_time;        /**< Timestamp of the last commutation (microseconds) */
+  float last_bemf_sample;                /**< Previous floating phase sample of the current step */
+  uint32_t last_bemf_sample_time;        /**< Timestamp of last_bemf_sample (microseconds) */
+  bool last_bemf_sample_valid;           /**< last_bemf_sample was taken during the current step */
+  float last_bemf_delta;                 /**< Difference between the last two floating phase samples */
+  bool last_bemf_delta_valid;            /**< last_bemf_delta was taken during the current step */
+  float bemf_noise;                      /**< Filtered absolute second difference of the floating phase samples (V) */
+  float bemf_peak;                       /**< Largest Back-EMF magnitude seen after blanking in the current step (V) */
+  float last_bemf_peak;                  /**< bemf_peak of the previous step (V) */
+  uint32_t zc_candidate_time;            /**< Interpolated time the floating phase crossed zero in this step (microseconds) */
+  bool zc_candidate_valid;               /**< A crossing has been interpolated in this step */
+  bool commutation_scheduled;            /**< The next commutation is armed on the one-shot timer */
+  uint32_t commutation_period;           /**< Last measured zero-crossing to zero-crossing period (microseconds) */
+  float estimated_speed;                 /**< Estimated motor speed averaged over the last electrical revolution (RPM) */
+  uint32_t last_velocity_update_time;    /**< Timestamp of the last velocity loop update (microseconds) */
+  int32_t position_steps;                /**< Signed commutations applied since alignment (60 electrical degrees each) */
+  bool is_reverse_torque;                /**< Position mode brakes, the bridge drives the step opposite the commutation step */
   BLDC6StepMotorMode_t mode;             /**< Current motor operational mode */
+
+  struct BLDC6StepSpeedEstimator_t speed_estimator;       /**< Moving window over the zero-crossing periods */
+  struct BLDC6StepZeroCrossingConfig_t zc_config;         /**< Zero-crossing detection configuration */
+  struct BLDC6StepCommutationConfig_t commutation_config; /**< Commutation timing configuration */
+  const struct BLDC6StepSensorlessColdConfig_t *cold;     /**< Startup, position, flying start and detection configuration */
+  struct BLDC6StepPositionProfile_t position_profile;     /**< Trapezoidal reference followed in position mode */
+  uint32_t startup_mode_time;                             /**< Timestamp the current startup mode was entered (microseconds) */
+  uint32_t startup_step_time;                             /**< Timestamp of the last forced commutation (microseconds) */
+  uint32_t startup_period;                                /**< Current forced commutation period (microseconds) */
+  uint8_t startup_step_count;                             /**< Number of forced commutations since alignment */
+
+  int8_t catch_bemf_sign[NUM_MOTOR_PHASES]; /**< Side of each phase Back-EMF past the hysteresis, 0 until known */
+  float catch_last_bemf[NUM_MOTOR_PHASES];  /**< Previous Back-EMF sample of each phase while catching (V) */
+  uint32_t catch_last_sample_time;          /**< Timestamp of catch_last_bemf (microseconds) */
+  uint8_t catch_zc_count;                   /**< Consecutive zero-crossings seen in the driver direction */
+
+  float detect_responses[BLDC6STEP_MAX_DETECTION_PULSES]; /**< Current at the end of each pulse along its direction (A) */
+  uint8_t detect_pulse_index;                             /**< Pulses applied so far */
+  bool detect_pulse_on;                                   /**< A pulse is applied, false while the current decays */
+  uint32_t detect_pulse_time;                             /**< Timestamp the current pulse or decay began (microseconds) */
+  float detected_angle;                                   /**< Electrical angle of the north pole from the last detection (0 to 2 pi rad) */
 };
 
 /**
@@ -49,4 +178,59 @@ struct BLDC6StepSensorlessData_t {
  */
 void bldc_6step_sensorless_create_driver(struct Motor_t *motor);
 
+/**
+ * @brief   Sets the modulation scheme used by the sensorless driver
+ * @details Takes effect on the next commutation step applied. Defaults to BLDC6STEP_PWM_H_PWM_L_ON
+ * @param   scheme Modulation scheme
+ */
+void bldc_6step_sensorless_set_pwm_scheme(BLDC6StepPwmScheme_t scheme);
+
+/**
+ * @brief   Sets the open-loop startup ramp used by the sensorless driver
+ * @details Startup is advanced by motor_run() after init returns. It must be configured before init is called
+ * @param   config Pointer to the startup configuration to copy
+ */
+void bldc_6step_sensorless_set_startup_config(const struct BLDC6StepStartupConfig_t *config);
+
+/**
+ * @brief   Sets the flying start used by the sensorless driver
+ * @details Disabled by default. When enabled, init floats the bridge and times the Back-EMF zero-crossings before
+ *          deciding between closed-loop operation and the open-loop startup. It must be configured before init is called
+ * @param   config Pointer to the flying start configuration to copy
+ */
+void bldc_6step_sensorless_set_flying_start_config(const struct BLDC6StepFlyingStartConfig_t *config);
+
+/**
+ * @brief   Sets the initial position detection used by the sensorless driver
+ * @details Disabled by default. When enabled, the open-loop startup begins with the position detection instead of the
+ *          alignment. It must be configured before init is called, which rejects an enabled detection with a number of
+ *          pulses other than 6 or 12
+ * @param   config Pointer to the detection configuration to copy
+ */
+void bldc_6step_sensorless_set_initial_position_config(const struct BLDC6StepInitialPositionConfig_t *config);
+
+/**
+ * @brief   Sets the commutation timing used by the sensorless driver
+ * @param   config Pointer to the commutation configuration to copy
+ */
+void bldc_6step_sensorless_set_commutation_config(const struct BLDC6StepCommutationConfig_t *config);
+
+/**
+ * @brief   Sets the zero-crossing detection used by the sensorless driver
+ * @details The ADC trigger is configured by init, so this must be called before init
+ * @param   config Pointer to the zero-crossing configuration to copy
+ */
+void bldc_6step_sensorless_set_zero_crossing_config(const struct BLDC6StepZeroCrossingConfig_t *config);
+
+/**
+ * @brief   Sets the trapezoidal profile limits of the position mode
+ * @details Position is the count of commutations applied since alignment. Moves are forward only and approach the target
+ *          no slower than the startup final_period_us, since the Back-EMF that drives commutation vanishes at standstill.
+ *          A negative velocity loop output brakes, which needs a negative velocity_pid_config.output_min. Once the count
+ *          reaches the target the target step is held at the startup align_duty in MOTOR_MODE_BRAKING, and a further move
+ *          needs a new init. Defaults to BLDC6STEP_DEFAULT_POSITION_*
+ * @param   config Pointer to the profile limits
+ */
+void bldc_6step_sensorless_set_position_config(const struct BLDC6StepPositionConfig_t *config);
+
 /** @} */
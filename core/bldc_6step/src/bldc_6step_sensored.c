@@ -13,6 +13,7 @@
 
 /* Inter-component Headers */
 #include "hal.h"
+#include "hall_estimator.h"
 #include "math_utils.h"
 
 /* Intra-component Headers */
@@ -22,7 +23,14 @@
  * Private Variables
  *******************************************************************************************************************************/
 
-static struct BLDC6StepSensoredData_t s_6step_sensored_data = { 0U };
+static struct BLDC6StepPositionConfig_t s_6step_sensored_position_config = {
+  .cruise_velocity = BLDC6STEP_DEFAULT_POSITION_CRUISE_RPM,
+  .acceleration = BLDC6STEP_DEFAULT_POSITION_ACCELERATION,
+};
+
+static struct BLDC6StepSensoredData_t MOTOR_HOT_DATA s_6step_sensored_data = {
+  .position_config = &s_6step_sensored_position_config,
+};
 
 /*******************************************************************************************************************************
  * Helper Functions
@@ -39,37 +47,37 @@ static uint8_t _6step_sensored_hall_state_to_commutation_index(uint8_t hall_stat
       case 0b011U:
         /*
          * Hall A=L, Hall B=H, Hall C=H (Diagram Step 1)
-         * Corresponds to bldc_6step_commutation_table[0]: Phase A-High, Phase B-Low (Phase C-Float)
+         * Corresponds to commutation step 0: Phase A-High, Phase B-Low (Phase C-Float)
          */
         return 0U;
       case 0b001U:
         /*
          * Hall A=L, Hall B=L, Hall C=H (Diagram Step 2)
-         * Corresponds to bldc_6step_commutation_table[1]: Phase A-High, Phase C-Low (Phase B-Float)
+         * Corresponds to commutation step 1: Phase A-High, Phase C-Low (Phase B-Float)
          */
         return 1U;
       case 0b101U:
         /*
          * Hall A=H, Hall B=L, Hall C=H (Diagram Step 3)
-         * Corresponds to bldc_6step_commutation_table[2]: Phase B-High, Phase C-Low (Phase A-Float)
+         * Corresponds to commutation step 2: Phase B-High, Phase C-Low (Phase A-Float)
          */
         return 2U;
       case 0b100U:
         /*
          * Hall A=H, Hall B=L, Hall C=L (Diagram Step 4)
-         * Corresponds to bldc_6step_commutation_table[3]: Phase B-High, Phase A-Low (Phase C-Float)
+         * Corresponds to commutation step 3: Phase B-High, Phase A-Low (Phase C-Float)
          */
         return 3U;
       case 0b110U:
         /*
          * Hall A=H, Hall B=H, Hall C=L (Diagram Step 5)
-         * Corresponds to bldc_6step_commutation_table[4]: Phase C-High, Phase A-Low (Phase B-Float)
+         * Corresponds to commutation step 4: Phase C-High, Phase A-Low (Phase B-Float)
          */
         return 4U;
       case 0b010U:
         /*
          * Hall A=L, Hall B=H, Hall C=L (Diagram Step 6)
-         * Corresponds to bldc_6step_commutation_table[5]: Phase C-High, Phase B-Low (Phase A-Float)
+         * Corresponds to commutation step 5: Phase C-High, Phase B-Low (Phase A-Float)
          */
         return 5U;
       default:
@@ -78,7 +86,7 @@ static uint8_t _6step_sensored_hall_state_to_commutation_index(uint8_t hall_stat
   } else {
     /*
      * Reverse rotation commutation table mapping.
-     * This sequence is the reverse of the forward rotation to maintain continuous motion
+     * Each Hall state selects the step opposite (180 electrical degrees) to the forward one, so the torque reverses
      * Hall state is read as 0bHallA_MSB HallB_MID HallC_LSB
      * Commutation steps refer to 0-based indices in the 'bldc_6step_commutation_table'
      */
@@ -86,45 +94,104 @@ static uint8_t _6step_sensored_hall_state_to_commutation_index(uint8_t hall_stat
       case 0b011U:
         /*
          * Hall A=L, Hall B=H, Hall C=H (Corresponds to Diagram Step 1 in forward sequence)
-         * This is bldc_6step_commutation_table[5]: Phase C-High, Phase B-Low (Phase A-Float)
+         * This is commutation step 3: Phase B-High, Phase A-Low (Phase C-Float)
          */
-        return 5U;
+        return 3U;
       case 0b001U:
         /*
          * Hall A=L, Hall B=L, Hall C=H (Corresponds to Diagram Step 2 in forward sequence)
-         * This is bldc_6step_commutation_table[0]: Phase A-High, Phase B-Low (Phase C-Float)
+         * This is commutation step 4: Phase C-High, Phase A-Low (Phase B-Float)
          */
-        return 0U;
+        return 4U;
       case 0b101U:
         /*
          * Hall A=H, Hall B=L, Hall C=H (Corresponds to Diagram Step 3 in forward sequence)
-         * This is bldc_6step_commutation_table[1]: Phase A-High, Phase C-Low (Phase B-Float)
+         * This is commutation step 5: Phase C-High, Phase B-Low (Phase A-Float)
          */
-        return 1U;
+        return 5U;
       case 0b100U:
         /*
          * Hall A=H, Hall B=L, Hall C=L (Corresponds to Diagram Step 4 in forward sequence)
-         * This is bldc_6step_commutation_table[2]: Phase B-High, Phase C-Low (Phase A-Float)
+         * This is commutation step 0: Phase A-High, Phase B-Low (Phase C-Float)
          */
-        return 2U;
+        return 0U;
       case 0b110U:
         /*
          * Hall A=H, Hall B=H, Hall C=L (Corresponds to Diagram Step 5 in forward sequence)
-         * This is bldc_6step_commutation_table[3]: Phase B-High, Phase A-Low (Phase C-Float)
+         * This is commutation step 1: Phase A-High, Phase C-Low (Phase B-Float)
          */
-        return 3U;
+        return 1U;
       case 0b010U:
         /*
          * Hall A=L, Hall B=H, Hall C=L (Corresponds to Diagram Step 6 in forward sequence)
-         * This is bldc_6step_commutation_table[4]: Phase C-High, Phase A-Low (Phase B-Float)
+         * This is commutation step 2: Phase B-High, Phase C-Low (Phase A-Float)
          */
-        return 4U;
+        return 2U;
       default:
         return 0xFF;
     }
   }
 }
 
+static void _6step_sensored_reset_speed_window(struct BLDC6StepSensoredData_t *bldc_data) {
+  _6step_bldc_speed_estimator_reset(&bldc_data->speed_estimator);
+  bldc_data->estimated_speed = 0.0f;
+}
+
+static void _6step_sensored_process_hall_edge(struct BLDC6StepSensoredData_t *bldc_data, const struct HallEdge_t *edge) {
+  uint8_t last_sector = hall_state_to_sector(bldc_data->last_hall_state);
+  uint8_t sector = hall_state_to_sector(edge->hall_state);
+  int8_t edge_direction = 0;
+
+  if (last_sector != HALL_INVALID_SECTOR && sector != HALL_INVALID_SECTOR) {
+    uint8_t delta = (uint8_t)((sector + HALL_NUM_SECTORS - last_sector) % HALL_NUM_SECTORS);
+
+    if (delta == 1U) {
+      edge_direction = 1;
+    } else if (delta == HALL_NUM_SECTORS - 1U) {
+      edge_direction = -1;
+    }
+
+    /* A skipped sector still counts towards the position. Half a revolution away has no known sense and is dropped */
+    if (delta < HALL_NUM_SECTORS / 2U) {
+      bldc_data->position_steps += (int32_t)delta;
+    } else if (delta > HALL_NUM_SECTORS / 2U) {
+      bldc_data->position_steps -= (int32_t)(HALL_NUM_SECTORS - delta);
+    }
+  }
+
+  if (edge_direction != 0 && edge_direction == bldc_data->edge_direction) {
+    /* Consecutive edges in the same direction bound a full 60 degree sector */
+    bldc_data->estimated_speed = _6step_bldc_speed_estimator_push(&bldc_data->speed_estimator, edge->timestamp_us - bldc_data->last_commutation_time);
+  } else {
+    /* Reversal, skipped sector or first edge. The time since the previous edge is not a sector period */
+    _6step_sensored_reset_speed_window(bldc_data);
+  }
+
+  bldc_data->edge_direction = edge_direction;
+  bldc_data->last_hall_state = edge->hall_state;
+  bldc_data->last_commutation_time = edge->timestamp_us;
+  bldc_data->commutation_pending = true;
+}
+
+static void _6step_sensored_update_position(struct Motor_t *motor, struct BLDC6StepSensoredData_t *bldc_data, float delta_time) {
+  float velocity_feedforward = _6step_bldc_position_profile_update(&bldc_data->position_profile, bldc_data->position_config, delta_time);
+
+  /* Position loop trims the profile speed, the velocity loop turns the speed command into a signed duty */
+  float velocity_command =
+      velocity_feedforward + pid_update(&motor->control.position, bldc_data->position_profile.position, (float)bldc_data->position_steps, delta_time);
+  float duty = pid_update(&motor->control.velocity, velocity_command, motor->state.velocity, delta_time);
+  bool direction = (duty >= 0.0f);
+
+  if (direction != bldc_data->direction) {
+    /* Reversing the torque selects a new step for the same Hall state */
+    bldc_data->direction = direction;
+    bldc_data->commutation_pending = true;
+  }
+
+  bldc_data->pwm_duty = fabsf(duty);
+}
+
 static MotorError_t _6step_sensored_startup_sequence(struct Motor_t *motor) {
   if (motor == NULL) {
     return MOTOR_INVALID_ARGS;
@@ -136,7 +203,7 @@ static MotorError_t _6step_sensored_startup_sequence(struct Motor_t *motor) {
   bldc_data->step = 0U;
   bldc_data->pwm_duty = DEFAULT_STARTUP_DUTY;
   bldc_data->mode = MOTOR_MODE_ALIGNING;
-  _6step_bldc_set_phase_outputs(bldc_6step_commutation_table[bldc_data->step], bldc_data->pwm_duty);
+  _6step_bldc_set_phase_outputs(bldc_data->pwm_scheme, bldc_data->step, bldc_data->pwm_duty);
   hal_delay_ms(DEFAULT_ALIGNMENT_TIME_MS);
 
   uint8_t current_hall_state = hal_gpio_get_hall_state();
@@ -147,10 +214,25 @@ static MotorError_t _6step_sensored_startup_sequence(struct Motor_t *motor) {
     return MOTOR_INIT_ERROR;
   }
 
+  /* Edges captured while aligning carry no speed information */
+  struct HallEdge_t edge;
+  while (hal_hall_capture_pop(&edge)) {
+  }
+
   bldc_data->step = initial_commutation_step;
-  _6step_bldc_set_phase_outputs(bldc_6step_commutation_table[bldc_data->step], bldc_data->pwm_duty);
+  _6step_bldc_set_phase_outputs(bldc_data->pwm_scheme, bldc_data->step, bldc_data->pwm_duty);
   bldc_data->last_commutation_time = hal_get_micros();
   bldc_data->last_hall_state = current_hall_state;
+  bldc_data->invalid_edges = 0U;
+  /* The control loops integrate from here, not across the alignment delay */
+  motor->state.last_update_time = bldc_data->last_commutation_time;
+  bldc_data->commutation_pending = false;
+  bldc_data->edge_direction = 0;
+  _6step_sensored_reset_speed_window(bldc_data);
+
+  /* Positions are counted from the aligned rotor */
+  bldc_data->position_steps = 0;
+  _6step_bldc_position_profile_reset(&bldc_data->position_profile, 0);
 
   motor->state.is_initialized = true;
   bldc_data->mode = MOTOR_MODE_RUNNING;
@@ -173,16 +255,25 @@ static MotorError_t _6step_sensored_init(struct Motor_t *motor, struct MotorConf
   s_6step_sensored_data.direction = true;
   s_6step_sensored_data.pwm_duty = 0U;
   s_6step_sensored_data.last_hall_state = 0U;
+  s_6step_sensored_data.invalid_edges = 0U;
+  s_6step_sensored_data.commutation_pending = false;
+  s_6step_sensored_data.edge_direction = 0;
   s_6step_sensored_data.last_commutation_time = 0U;
-  s_6step_sensored_data.estimated_speed = 0.0f;
+  s_6step_sensored_data.last_velocity_update_time = hal_get_micros();
   s_6step_sensored_data.mode = MOTOR_MODE_IDLE;
+  _6step_sensored_reset_speed_window(&s_6step_sensored_data);
 
   /* Initialize PID */
   pid_init(&motor->control.current, &motor->config->current_pid_config);
   pid_init(&motor->control.velocity, &motor->config->velocity_pid_config);
+  pid_init(&motor->control.position, &motor->config->position_pid_config);
+
+  /* The control cycle reads the copies in params */
+  motor_reload_config(motor);
 
   /* Initialize hardware */
-  if (!hal_pwm_init(&config->pwm_config) || !hal_adc_init(&config->adc_config) || !hal_gpio_init() || !hal_gpio_init_hall_sensors()) {
+  if (!hal_pwm_init(&config->pwm_config) || !hal_adc_init(&config->adc_config) || !hal_gpio_init() || !hal_gpio_init_hall_sensors() ||
+      !hal_hall_capture_init()) {
     return MOTOR_INIT_ERROR;
   }
 
@@ -237,49 +328,79 @@ static MotorError_t _6step_sensored_update_state(struct Motor_t *motor) {
   float delta_time = (float)(current_time - motor->state.last_update_time) / 1000000.0f;
   motor->state.last_update_time = current_time;
 
-  /* Check for overvoltage or undervoltage */
+  /* The terminals swing between the rails, so overvoltage is checked on the bus */
+  if (motor->state.dc_voltage > MOTOR_BUS_OVERVOLTAGE_RATIO * motor->params.max_voltage) {
+    bldc_data->mode = MOTOR_MODE_ERROR;
+    return MOTOR_OVERVOLTAGE_ERROR;
+  }
+
   for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
-    if (motor->state.phase_voltages[phase] > motor->config->max_voltage) {
-      bldc_data->mode = MOTOR_MODE_ERROR;
-      return MOTOR_OVERVOLTAGE_ERROR;
-    } else if (motor->state.phase_currents[phase] > motor->config->max_current) {
+    if (motor->state.phase_currents[phase] > motor->params.max_current) {
       bldc_data->mode = MOTOR_MODE_ERROR;
       return MOTOR_OVERCURRENT_ERROR;
     }
   }
 
-  /* Sample hall sensors */
-  uint8_t current_hall_state = hal_gpio_get_hall_state();
-
-  /* Calculate an estimated speed if the hall sensor state has changed */
-  if (current_hall_state != bldc_data->last_hall_state) {
-    if (bldc_data->last_commutation_time != 0) {
-      uint32_t commutation_time_diff = current_time - bldc_data->last_commutation_time;
-      if (commutation_time_diff > 0) {
-        /* 60 degrees * the time it to for comutation * 6 sectors */
-        bldc_data->estimated_speed = 60.0f * (1000000.0f / ((float)commutation_time_diff * 6.0f));
+  /* Consume every Hall edge captured since the last cycle, using the capture timestamps rather than the loop time */
+  struct HallEdge_t edge;
+  while (hal_hall_capture_pop(&edge)) {
+    if (hall_state_to_sector(edge.hall_state) == HALL_INVALID_SECTOR) {
+      if (bldc_data->invalid_edges >= BLDC6STEP_SENSORED_MAX_INVALID_EDGES) {
+        bldc_data->mode = MOTOR_MODE_ERROR;
+        return MOTOR_HAL_ERROR;
       }
+
+      /* A single noisy edge is common. Keep commutating from the last legal state */
+      bldc_data->invalid_edges++;
+      continue;
+    }
+
+    bldc_data->invalid_edges = 0U;
+
+    if (edge.hall_state != bldc_data->last_hall_state) {
+      _6step_sensored_process_hall_edge(bldc_data, &edge);
     }
-    bldc_data->last_commutation_time = current_time;
-    bldc_data->last_hall_state = current_hall_state;
   }
 
-  motor->state.velocity = bldc_data->estimated_speed;
+  if ((current_time - bldc_data->last_commutation_time) > BLDC6STEP_SENSORED_SPEED_TIMEOUT_US) {
+    /* No edge for too long, the rotor has stalled */
+    _6step_sensored_reset_speed_window(bldc_data);
+  }
+
+  /* An overdue edge bounds the speed, so a decelerating rotor is not reported at its last window average */
+  uint32_t time_since_edge = current_time - bldc_data->last_commutation_time;
+  float speed = bldc_data->estimated_speed;
 
-  switch (motor->config->control_mode) {
+  if (time_since_edge > 0U) {
+    speed = fminf(speed, BLDC6STEP_RPM_PERIOD_PRODUCT / (float)time_since_edge);
+  }
+
+  motor->state.velocity = (bldc_data->edge_direction < 0) ? -speed : speed;
+  motor->state.position = _6step_bldc_steps_to_position(bldc_data->position_steps, motor->params.pole_pairs);
+
+  switch (motor->params.control_mode) {
     case CONTROL_MODE_TORQUE:
     case CONTROL_MODE_CURRENT:
       float conducting_current = _6step_bldc_get_conducting_current(motor, bldc_data->step);
       bldc_data->pwm_duty = pid_update(&motor->control.current, motor->setpoint.current, conducting_current, delta_time);
       break;
     case CONTROL_MODE_VELOCITY:
-      bldc_data->pwm_duty = pid_update(&motor->control.velocity, motor->setpoint.velocity, bldc_data->estimated_speed, delta_time);
+      if (!motor->params.velocity_loop_per_commutation) {
+        bldc_data->pwm_duty = pid_update(&motor->control.velocity, motor->setpoint.velocity, bldc_data->estimated_speed, delta_time);
+        bldc_data->last_velocity_update_time = current_time;
+      } else if (bldc_data->speed_estimator.is_updated || bldc_data->speed_estimator.count == 0U) {
+        /* One update per new speed sample (or while stalled), integrated over the time since the previous update */
+        float velocity_delta_time = (float)(current_time - bldc_data->last_velocity_update_time) / 1000000.0f;
+        bldc_data->pwm_duty = pid_update(&motor->control.velocity, motor->setpoint.velocity, bldc_data->estimated_speed, velocity_delta_time);
+        bldc_data->speed_estimator.is_updated = false;
+        bldc_data->last_velocity_update_time = current_time;
+      }
       break;
     case CONTROL_MODE_VOLTAGE:
-      bldc_data->pwm_duty = motor->setpoint.voltage / motor->config->max_voltage;
+      bldc_data->pwm_duty = motor->setpoint.voltage / motor->params.max_voltage;
       break;
     case CONTROL_MODE_POSITION:
-      // TODO: Complete position control
+      _6step_sensored_update_position(motor, bldc_data, delta_time);
       break;
     default:
       bldc_data->pwm_duty = 0.0f;
@@ -294,7 +415,6 @@ static MotorError_t _6step_sensored_update_state(struct Motor_t *motor) {
 
 static MotorError_t _6step_sensored_commutate(struct Motor_t *motor) {
   struct BLDC6StepSensoredData_t *bldc_data;
-  uint8_t current_hall_state;
   uint8_t next_step;
 
   if (motor == NULL) {
@@ -308,10 +428,8 @@ static MotorError_t _6step_sensored_commutate(struct Motor_t *motor) {
     return MOTOR_OK;
   }
 
-  current_hall_state = hal_gpio_get_hall_state();
-
-  if (current_hall_state != bldc_data->last_hall_state) {
-    next_step = _6step_sensored_hall_state_to_commutation_index(current_hall_state, bldc_data->direction);
+  if (bldc_data->commutation_pending) {
+    next_step = _6step_sensored_hall_state_to_commutation_index(bldc_data->last_hall_state, bldc_data->direction);
 
     if (next_step == 0xFFU) {
       bldc_data->mode = MOTOR_MODE_ERROR;
@@ -319,10 +437,9 @@ static MotorError_t _6step_sensored_commutate(struct Motor_t *motor) {
     }
 
     bldc_data->step = next_step;
-    _6step_bldc_set_phase_outputs(bldc_6step_commutation_table[bldc_data->step], bldc_data->pwm_duty);
+    _6step_bldc_set_phase_outputs(bldc_data->pwm_scheme, bldc_data->step, bldc_data->pwm_duty);
 
-    bldc_data->last_hall_state = current_hall_state;
-    bldc_data->last_commutation_time = hal_get_micros();
+    bldc_data->commutation_pending = false;
   }
 
   return MOTOR_OK;
@@ -342,7 +459,7 @@ static MotorError_t _6step_sensored_update_pwm(struct Motor_t *motor) {
     return MOTOR_OK;
   }
 
-  _6step_bldc_set_phase_outputs(bldc_6step_commutation_table[bldc_data->step], bldc_data->pwm_duty);
+  _6step_bldc_set_phase_outputs(bldc_data->pwm_scheme, bldc_data->step, bldc_data->pwm_duty);
   return MOTOR_OK;
 }
 
@@ -350,8 +467,8 @@ static MotorError_t _6step_sensored_set_voltage(struct Motor_t *motor, float vol
   if (motor == NULL) {
     return MOTOR_INVALID_ARGS;
   }
-  motor->setpoint.voltage = fminf(voltage, motor->config->max_voltage);
-  motor->config->control_mode = CONTROL_MODE_VOLTAGE;
+  motor->setpoint.voltage = fminf(voltage, motor->params.max_voltage);
+  motor_set_control_mode(motor, CONTROL_MODE_VOLTAGE);
   return MOTOR_OK;
 }
 
@@ -359,8 +476,8 @@ static MotorError_t _6step_sensored_set_current(struct Motor_t *motor, float cur
   if (motor == NULL) {
     return MOTOR_INVALID_ARGS;
   }
-  motor->setpoint.current = fminf(current, motor->config->max_current);
-  motor->config->control_mode = CONTROL_MODE_CURRENT;
+  motor->setpoint.current = fminf(current, motor->params.max_current);
+  motor_set_control_mode(motor, CONTROL_MODE_CURRENT);
   return MOTOR_OK;
 }
 
@@ -368,8 +485,8 @@ static MotorError_t _6step_sensored_set_velocity(struct Motor_t *motor, float ve
   if (motor == NULL) {
     return MOTOR_INVALID_ARGS;
   }
-  motor->setpoint.velocity = fminf(velocity, motor->config->max_velocity);
-  motor->config->control_mode = CONTROL_MODE_VELOCITY;
+  motor->setpoint.velocity = fminf(velocity, motor->params.max_velocity);
+  motor_set_control_mode(motor, CONTROL_MODE_VELOCITY);
   return MOTOR_OK;
 }
 
@@ -377,8 +494,18 @@ static MotorError_t _6step_sensored_set_position(struct Motor_t *motor, float po
   if (motor == NULL) {
     return MOTOR_INVALID_ARGS;
   }
+
+  struct BLDC6StepSensoredData_t *bldc_data = (struct BLDC6StepSensoredData_t *)motor->private_data;
+
+  if (motor->params.control_mode != CONTROL_MODE_POSITION) {
+    /* The first move starts from the counted position at the measured speed */
+    _6step_bldc_position_profile_reset(&bldc_data->position_profile, bldc_data->position_steps);
+    bldc_data->position_profile.velocity = motor->state.velocity / BLDC6STEP_RPM_PER_STEP_RATE;
+  }
+
+  bldc_data->position_profile.target = _6step_bldc_position_to_steps(position, motor->params.pole_pairs);
   motor->setpoint.position = position;
-  motor->config->control_mode = CONTROL_MODE_POSITION;
+  motor_set_control_mode(motor, CONTROL_MODE_POSITION);
   return MOTOR_OK;
 }
 
@@ -387,8 +514,8 @@ static MotorError_t _6step_sensored_set_torque(struct Motor_t *motor, float torq
     return MOTOR_INVALID_ARGS;
   }
   motor->setpoint.torque = torque;
-  motor->setpoint.current = motor->setpoint.torque / motor->config->torque_constant;
-  motor->config->control_mode = CONTROL_MODE_TORQUE;
+  motor->setpoint.current = motor->setpoint.torque / motor->params.torque_constant;
+  motor_set_control_mode(motor, CONTROL_MODE_TORQUE);
   return MOTOR_OK;
 }
 
@@ -409,4 +536,16 @@ void bldc_6step_sensored_create_driver(struct Motor_t *motor) {
     motor->driver.set_position = _6step_sensored_set_position;
     motor->driver.set_torque = _6step_sensored_set_torque;
   }
+}
+
+void bldc_6step_sensored_set_pwm_scheme(BLDC6StepPwmScheme_t scheme) {
+  if (scheme < NUM_BLDC6STEP_PWM_SCHEMES) {
+    s_6step_sensored_data.pwm_scheme = scheme;
+  }
+}
+
+void bldc_6step_sensored_set_position_config(const struct BLDC6StepPositionConfig_t *config) {
+  if (config != NULL) {
+    s_6step_sensored_position_config = *config;
+  }
 }
\ No newline at end of file
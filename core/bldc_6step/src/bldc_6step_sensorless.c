@@ -8,12 +8,14 @@
  *******************************************************************************************************************************/
 
 /* Standard library Headers */
+#include <math.h>
 #include <stddef.h>
 #include <stdio.h>
 
 /* Inter-component Headers */
 #include "hal.h"
 #include "math_utils.h"
+#include "transform_utils.h"
 
 /* Intra-component Headers */
 #include "bldc_6step_sensorless.h"
@@ -26,136 +28,721 @@
 #define MAX_COMMUTATION_PERIOD_US 50000U /**< Maximum time between commutations (20Hz min) */
 #define BEMF_FILTER_ALPHA_MIN 0.0f       /**< Back-EMF filter minimum alpha */
 #define BEMF_FILTER_ALPHA_MAX 1.0f       /**< Back-EMF filter maximum alpha */
-#define ZERO_CROSSING_HYSTERSIS 0.5f     /**< Hysteresis value for zero crossing in Volts(V) */
+#define BEMF_NOISE_FILTER_ALPHA 0.05f    /**< Alpha value for the Back-EMF noise estimate */
+
+#define DEFAULT_ADVANCE_DEG_PER_KRPM 0.5f /**< Default commutation advance per 1000 electrical RPM (electrical degrees) */
+#define DEFAULT_MAX_ADVANCE_DEG 10.0f     /**< Default maximum commutation advance (electrical degrees) */
+#define DEFAULT_BLANKING_FRACTION 0.25f   /**< Default fraction of the period ignored after a commutation */
+
+#define DEFAULT_ZC_SAMPLE_POINT 0.5f   /**< Default ADC trigger position, the middle of the PWM on-time */
+#define DEFAULT_ZC_MIN_HYSTERESIS 0.1f /**< Default zero-crossing hysteresis floor (V) */
+#define DEFAULT_ZC_NOISE_GAIN 2.0f     /**< Default hysteresis per volt of estimated sample noise */
+#define DEFAULT_ZC_BEMF_FRACTION 0.5f  /**< Default hysteresis cap as a fraction of the previous Back-EMF peak */
+
+#define DEFAULT_CATCH_TIME_US 20000U   /**< Default flying start window, three crossings at the slowest final startup period */
+#define CATCH_ZERO_CROSSINGS 3U        /**< Consecutive zero-crossings that measure a spinning rotor */
+#define CATCH_MAX_EXTRAPOLATION 4.0f   /**< Sample intervals a crossing time may be extrapolated back */
+
+#define DEFAULT_DETECTION_PULSES 12U          /**< Default pulse directions of the initial position detection */
+#define DEFAULT_DETECTION_PULSE_TIME_US 200U  /**< Default detection pulse duration (us) */
+#define DEFAULT_DETECTION_SETTLE_TIME_US 300U /**< Default decay time after a detection pulse (us) */
 
 /*******************************************************************************************************************************
  * Private Variables
  *******************************************************************************************************************************/
 
-static struct BLDC6StepSensorlessData_t s_6step_sensorless_data = { 0U };
-
-static const float s_startup_acceleration_lookup[DEFAULT_STARTUP_STEPS] = {
-  1.0000f, /**< powf(0.8, 0) */
-  0.8000f, /**< powf(0.8, 1) */
-  0.6400f, /**< powf(0.8, 2) */
-  0.5120f, /**< powf(0.8, 3) */
-  0.4096f, /**< powf(0.8, 4) */
-  0.3277f, /**< powf(0.8, 5) */
-  0.2621f, /**< powf(0.8, 6) */
-  0.2097f, /**< powf(0.8, 7) */
-  0.1678f, /**< powf(0.8, 8) */
-  0.1342f, /**< powf(0.8, 9) */
-  0.1074f, /**< powf(0.8, 10) */
-  0.0859f  /**< powf(0.8, 11) */
+static struct BLDC6StepSensorlessColdConfig_t s_6step_sensorless_cold = {
+  .position_config = {
+    .cruise_velocity = BLDC6STEP_DEFAULT_POSITION_CRUISE_RPM,
+    .acceleration = BLDC6STEP_DEFAULT_POSITION_ACCELERATION,
+  },
+  .startup_config = {
+    .align_duty = DEFAULT_STARTUP_DUTY,
+    .align_time_us = DEFAULT_ALIGNMENT_TIME_MS * 1000U,
+    .initial_period_us = STARTUP_MIN_PERIOD_US,
+    .final_period_us = STARTUP_MAX_PERIOD_US,
+    .acceleration_factor = STARTUP_ACCELERATION_FACTOR,
+    .initial_duty = DEFAULT_STARTUP_DUTY,
+    .duty_increment = STARTUP_DUTY_INCREMENT_PER_STEP,
+    .num_steps = DEFAULT_STARTUP_STEPS,
+    .transition_timeout_us = MAX_STALL_TIME_MS * 1000U,
+  },
+  .flying_start_config = {
+    .enabled = false,
+    .catch_time_us = DEFAULT_CATCH_TIME_US,
+  },
+  .initial_position_config = {
+    .enabled = false,
+    .num_pulses = DEFAULT_DETECTION_PULSES,
+    .pulse_time_us = DEFAULT_DETECTION_PULSE_TIME_US,
+    .settle_time_us = DEFAULT_DETECTION_SETTLE_TIME_US,
+  },
+};
+
+static struct BLDC6StepSensorlessData_t MOTOR_HOT_DATA s_6step_sensorless_data = {
+  .zc_config = {
+    .reference = ZC_REFERENCE_VIRTUAL_NEUTRAL,
+    .sample_point = DEFAULT_ZC_SAMPLE_POINT,
+    .min_hysteresis = DEFAULT_ZC_MIN_HYSTERESIS,
+    .noise_gain = DEFAULT_ZC_NOISE_GAIN,
+    .bemf_fraction = DEFAULT_ZC_BEMF_FRACTION,
+  },
+  .commutation_config = {
+    .delayed_commutation = true,
+    .advance_deg_per_krpm = DEFAULT_ADVANCE_DEG_PER_KRPM,
+    .max_advance_deg = DEFAULT_MAX_ADVANCE_DEG,
+    .blanking_fraction = DEFAULT_BLANKING_FRACTION,
+  },
+  .cold = &s_6step_sensorless_cold,
+};
+
+/**
+ * @brief   Gates of the initial position detection pulses, the current of pulse k points at k * 30 electrical degrees
+ * @details Even pulses drive one phase against the other two, odd pulses drive two phases in series. The switches are
+ *          held on for the whole pulse
+ */
+static const uint16_t s_detect_pulse_gates[BLDC6STEP_MAX_DETECTION_PULSES] = {
+  HAL_GATE_HIGH(MOTOR_PHASE_A) | HAL_GATE_LOW(MOTOR_PHASE_B) | HAL_GATE_LOW(MOTOR_PHASE_C),  /* 0 degrees */
+  HAL_GATE_HIGH(MOTOR_PHASE_A) | HAL_GATE_LOW(MOTOR_PHASE_C),                                /* 30 degrees */
+  HAL_GATE_HIGH(MOTOR_PHASE_A) | HAL_GATE_HIGH(MOTOR_PHASE_B) | HAL_GATE_LOW(MOTOR_PHASE_C), /* 60 degrees */
+  HAL_GATE_HIGH(MOTOR_PHASE_B) | HAL_GATE_LOW(MOTOR_PHASE_C),                                /* 90 degrees */
+  HAL_GATE_HIGH(MOTOR_PHASE_B) | HAL_GATE_LOW(MOTOR_PHASE_A) | HAL_GATE_LOW(MOTOR_PHASE_C),  /* 120 degrees */
+  HAL_GATE_HIGH(MOTOR_PHASE_B) | HAL_GATE_LOW(MOTOR_PHASE_A),                                /* 150 degrees */
+  HAL_GATE_HIGH(MOTOR_PHASE_B) | HAL_GATE_HIGH(MOTOR_PHASE_C) | HAL_GATE_LOW(MOTOR_PHASE_A), /* 180 degrees */
+  HAL_GATE_HIGH(MOTOR_PHASE_C) | HAL_GATE_LOW(MOTOR_PHASE_A),                                /* 210 degrees */
+  HAL_GATE_HIGH(MOTOR_PHASE_C) | HAL_GATE_LOW(MOTOR_PHASE_A) | HAL_GATE_LOW(MOTOR_PHASE_B),  /* 240 degrees */
+  HAL_GATE_HIGH(MOTOR_PHASE_C) | HAL_GATE_LOW(MOTOR_PHASE_B),                                /* 270 degrees */
+  HAL_GATE_HIGH(MOTOR_PHASE_A) | HAL_GATE_HIGH(MOTOR_PHASE_C) | HAL_GATE_LOW(MOTOR_PHASE_B), /* 300 degrees */
+  HAL_GATE_HIGH(MOTOR_PHASE_A) | HAL_GATE_LOW(MOTOR_PHASE_B),                                /* 330 degrees */
 };
 
 /*******************************************************************************************************************************
  * Helper Functions
  *******************************************************************************************************************************/
 
-static bool _6step_sensorless_has_zero_crossed(float bemf_value, float threshold, ZeroCrossingState_t zc_state) {
-  /* If the back-emf value has risen past the Back-EMF threshold, and the zero crossing is rising */
-  /* Or if the back-emf value has fallen below the Back-EMF threshold, and the zero crossing is
+static bool _6step_sensorless_has_zero_crossed(float bemf_value, float hysteresis, ZeroCrossingState_t zc_state) {
+  /* If the back-emf value has risen past the hysteresis, and the zero crossing is rising */
+  /* Or if the back-emf value has fallen below the hysteresis, and the zero crossing is
    * falling */
-  if (zc_state == ZC_STATE_RISING && bemf_value > (threshold + ZERO_CROSSING_HYSTERSIS)) {
+  if (zc_state == ZC_STATE_RISING && bemf_value > hysteresis) {
     return true;
-  } else if (zc_state == ZC_STATE_FALLING && bemf_value < -(threshold + ZERO_CROSSING_HYSTERSIS)) {
+  } else if (zc_state == ZC_STATE_FALLING && bemf_value < -hysteresis) {
     return true;
   }
   return false;
 }
 
-static ZeroCrossingState_t _6step_sensorless_update_zc_state(ZeroCrossingState_t current_state) {
-  /* In trapezoidal commutation of a BLDC motor, the zero crossing flips between rising and falling
-   * edge */
-  return (current_state == ZC_STATE_RISING) ? ZC_STATE_FALLING : ZC_STATE_RISING;
+static float _6step_sensorless_calculate_zc_reference(struct BLDC6StepSensorlessData_t *bldc_data, struct MotorState_t *state) {
+  switch (bldc_data->zc_config.reference) {
+    case ZC_REFERENCE_HALF_BUS:
+      /* During the on-time the conducting phases sit at the rails, so the star point is near half the bus */
+      return 0.5f * state->dc_voltage;
+    case ZC_REFERENCE_VIRTUAL_NEUTRAL:
+    default:
+      /* With balanced windings the star point is the average of the three terminals */
+      return (state->phase_voltages[MOTOR_PHASE_A] + state->phase_voltages[MOTOR_PHASE_B] + state->phase_voltages[MOTOR_PHASE_C]) / 3.0f;
+  }
+}
+
+static float _6step_sensorless_calculate_hysteresis(struct BLDC6StepSensorlessData_t *bldc_data) {
+  const struct BLDC6StepZeroCrossingConfig_t *zc_config = &bldc_data->zc_config;
+
+  /* Noisy samples need a wider band, but it must stay below the Back-EMF the rotor speed can produce */
+  float hysteresis = zc_config->noise_gain * bldc_data->bemf_noise;
+  hysteresis = fminf(hysteresis, zc_config->bemf_fraction * bldc_data->last_bemf_peak);
+
+  return fmaxf(hysteresis, zc_config->min_hysteresis);
+}
+
+static ZeroCrossingState_t _6step_sensorless_expected_zc_state(uint8_t step, bool direction) {
+  /**
+   * In trapezoidal commutation of a BLDC motor, the zero crossing flips between rising and falling edge.
+   * Forward rotation sees a falling floating phase in even steps, reverse rotation mirrors it
+   */
+  bool is_falling = ((step % 2U) == 0U) == direction;
+  return is_falling ? ZC_STATE_FALLING : ZC_STATE_RISING;
+}
+
+/* Braking drives the step 180 electrical degrees away, which floats the same phase with the polarity of the others swapped */
+static uint8_t _6step_sensorless_torque_step(const struct BLDC6StepSensorlessData_t *bldc_data) {
+  if (bldc_data->is_reverse_torque) {
+    return (uint8_t)((bldc_data->step + NUM_COMMUTATION_STEPS / 2U) % NUM_COMMUTATION_STEPS);
+  }
+
+  return bldc_data->step;
+}
+
+static void _6step_sensorless_commutate_step(struct BLDC6StepSensorlessData_t *bldc_data, uint32_t current_time) {
+  if (bldc_data->direction) {
+    bldc_data->step = (bldc_data->step + 1U) % NUM_COMMUTATION_STEPS;
+  } else {
+    bldc_data->step = (bldc_data->step + NUM_COMMUTATION_STEPS - 1U) % NUM_COMMUTATION_STEPS;
+  }
+
+  bldc_data->position_steps += bldc_data->direction ? 1 : -1;
+
+  _6step_bldc_set_phase_outputs(bldc_data->pwm_scheme, _6step_sensorless_torque_step(bldc_data), bldc_data->pwm_duty);
+
+  /* A new floating phase starts a new zero-crossing search */
+  bldc_data->zc_state = _6step_sensorless_expected_zc_state(bldc_data->step, bldc_data->direction);
+  bldc_data->last_commutation_time = current_time;
+  bldc_data->last_velocity_update_time = current_time;
+  bldc_data->last_bemf_sample_valid = false;
+  bldc_data->last_bemf_delta_valid = false;
+  bldc_data->zc_candidate_valid = false;
+  bldc_data->commutation_scheduled = false;
+
+  /* The Back-EMF peak of the finished step bounds the hysteresis of the next one */
+  bldc_data->last_bemf_peak = bldc_data->bemf_peak;
+  bldc_data->bemf_peak = 0.0f;
+  bldc_data->zc_hysteresis = _6step_sensorless_calculate_hysteresis(bldc_data);
+}
+
+static void _6step_sensorless_scheduled_commutation(void *context) {
+  struct Motor_t *motor = (struct Motor_t *)context;
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+
+  if (bldc_data->commutation_scheduled && bldc_data->mode == MOTOR_MODE_RUNNING) {
+    _6step_sensorless_commutate_step(bldc_data, hal_get_micros());
+  }
 }
 
-static uint32_t _6step_sensorless_calculate_startup_period(struct Motor_t *motor, uint8_t step) {
-  if (motor == NULL || step >= DEFAULT_STARTUP_STEPS) {
-    return STARTUP_MIN_PERIOD_US;
+static void _6step_sensorless_track_zero_crossing(struct BLDC6StepSensorlessData_t *bldc_data, float bemf_sample, uint32_t sample_time) {
+  uint32_t blanking_time = (uint32_t)((float)bldc_data->commutation_period * bldc_data->commutation_config.blanking_fraction);
+  bool is_blanked = (sample_time - bldc_data->last_commutation_time) < blanking_time;
+
+  if (is_blanked) {
+    bldc_data->last_bemf_sample_valid = false;
+    return;
   }
 
-  /* Calculate period with exponential decrease (faster acceleration) */
-  float exponent = s_startup_acceleration_lookup[step];
+  if (bldc_data->last_bemf_sample_valid) {
+    float previous_sample = bldc_data->last_bemf_sample;
+    float delta = bemf_sample - previous_sample;
 
-  /* Interpolate between min and max period */
-  uint32_t period = (uint32_t)(STARTUP_MIN_PERIOD_US * exponent);
+    /* The Back-EMF is close to a straight line around the crossing, so its second difference is mostly sample noise */
+    if (bldc_data->last_bemf_delta_valid) {
+      float second_difference = fabsf(delta - bldc_data->last_bemf_delta);
+      bldc_data->bemf_noise += BEMF_NOISE_FILTER_ALPHA * (second_difference - bldc_data->bemf_noise);
+    }
+    bldc_data->last_bemf_delta = delta;
+    bldc_data->last_bemf_delta_valid = true;
+
+    bool is_rising = (bldc_data->zc_state == ZC_STATE_RISING);
+    bool has_crossed = is_rising ? (previous_sample < 0.0f && bemf_sample >= 0.0f) : (previous_sample > 0.0f && bemf_sample <= 0.0f);
+    bool has_returned = is_rising ? (bemf_sample < 0.0f) : (bemf_sample > 0.0f);
+
+    if (!bldc_data->zc_candidate_valid && has_crossed) {
+      /* Linear interpolation of the crossing between the two samples that straddle it */
+      float fraction = previous_sample / (previous_sample - bemf_sample);
+      uint32_t sample_interval = sample_time - bldc_data->last_bemf_sample_time;
+      bldc_data->zc_candidate_time = bldc_data->last_bemf_sample_time + (uint32_t)(fraction * (float)sample_interval);
+      bldc_data->zc_candidate_valid = true;
+    } else if (bldc_data->zc_candidate_valid && has_returned) {
+      /* Back on the starting side before the hysteresis confirmed it, the crossing was noise */
+      bldc_data->zc_candidate_valid = false;
+    }
+  }
+
+  bldc_data->bemf_peak = fmaxf(bldc_data->bemf_peak, fabsf(bemf_sample));
+  bldc_data->last_bemf_sample = bemf_sample;
+  bldc_data->last_bemf_sample_time = sample_time;
+  bldc_data->last_bemf_sample_valid = true;
+}
+
+static uint32_t _6step_sensorless_calculate_commutation_delay(struct BLDC6StepSensorlessData_t *bldc_data) {
+  const struct BLDC6StepCommutationConfig_t *commutation_config = &bldc_data->commutation_config;
+
+  /* Advance grows with speed to compensate the current rise time, which takes a larger angle at high speed */
+  float advance_deg = commutation_config->advance_deg_per_krpm * (bldc_data->estimated_speed / 1000.0f);
+  advance_deg = clamp(advance_deg, 0.0f, commutation_config->max_advance_deg);
+
+  /* 30 degrees after the zero-crossing is half of the 60 degree commutation period */
+  return (uint32_t)((float)bldc_data->commutation_period * ((30.0f - advance_deg) / 60.0f));
+}
+
+static uint32_t _6step_sensorless_calculate_startup_period(const struct BLDC6StepStartupConfig_t *startup_config, uint32_t period) {
+  /* Exponential decrease of the period, one multiplication per forced step */
+  uint32_t next_period = (uint32_t)((float)period * startup_config->acceleration_factor);
 
   /* Ensure we don't exceed the limits */
-  if (period < STARTUP_MAX_PERIOD_US) {
-    period = STARTUP_MAX_PERIOD_US;
+  if (next_period < startup_config->final_period_us) {
+    next_period = startup_config->final_period_us;
   }
 
-  return period;
+  return next_period;
 }
 
 static float _6step_sensorless_calculate_startup_duty(struct Motor_t *motor, uint8_t step) {
-  float duty = DEFAULT_STARTUP_DUTY + (step * STARTUP_DUTY_INCREMENT_PER_STEP);
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+  float duty = bldc_data->cold->startup_config.initial_duty + (step * bldc_data->cold->startup_config.duty_increment);
 
   /* Cap at max duty cycle */
-  if (duty > motor->config->current_pid_config.output_max) {
-    duty = motor->config->current_pid_config.output_max;
-  } else if (duty < motor->config->current_pid_config.output_min) {
-    duty = motor->config->current_pid_config.output_min;
+  if (duty > motor->control.current.gains.output_max) {
+    duty = motor->control.current.gains.output_max;
+  } else if (duty < motor->control.current.gains.output_min) {
+    duty = motor->control.current.gains.output_min;
   }
 
   return duty;
 }
 
-static MotorError_t _6step_sensorless_startup_sequence(struct Motor_t *motor) {
-  if (motor == NULL) {
-    return MOTOR_INVALID_ARGS;
+static void _6step_sensorless_force_commutation(struct Motor_t *motor, uint32_t current_time) {
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+
+  _6step_sensorless_commutate_step(bldc_data, current_time);
+
+  bldc_data->startup_step_time = current_time;
+  bldc_data->startup_step_count++;
+
+  /* The forced period is the best available speed estimate until the first zero-crossing */
+  bldc_data->commutation_period = bldc_data->startup_period;
+  bldc_data->estimated_speed = 60.0f * (1000000.0f / ((float)bldc_data->startup_period * 6.0f));
+  motor->state.velocity = bldc_data->estimated_speed;
+}
+
+static bool _6step_sensorless_detect_zero_crossing(struct Motor_t *motor, uint32_t current_time) {
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+  float bemf_value = bldc_data->bemf[_6step_bldc_determine_floating_phase(bldc_data->step)];
+
+  /* The zero-crossing of this step was already handled, the commutation is waiting on the timer */
+  if (bldc_data->commutation_scheduled) {
+    return false;
   }
 
+  /**
+   * Only check for zero crossing if enough time has passed since last commutation
+   * This prevents very high-frequency false zero-crossings at high speed or noise
+   */
+  if ((current_time - bldc_data->last_zc_time) < MIN_COMMUTATION_PERIOD_US) {
+    return false;
+  }
+
+  /* The hysteresis only confirms the crossing, its timing comes from the interpolated candidate */
+  if (!bldc_data->zc_candidate_valid || !_6step_sensorless_has_zero_crossed(bemf_value, bldc_data->zc_hysteresis, bldc_data->zc_state)) {
+    return false;
+  }
+
+  uint32_t zc_time = bldc_data->zc_candidate_time;
+
+  /* The first zero-crossing after open-loop has no predecessor, the forced period stays the estimate */
+  if (bldc_data->mode == MOTOR_MODE_RUNNING) {
+    /* The latest period times the next commutation, the window average over a revolution is the speed */
+    bldc_data->commutation_period = zc_time - bldc_data->last_zc_time;
+    bldc_data->estimated_speed = _6step_bldc_speed_estimator_push(&bldc_data->speed_estimator, bldc_data->commutation_period);
+    motor->state.velocity = bldc_data->estimated_speed;
+  }
+  bldc_data->last_zc_time = zc_time;
+
+  if (bldc_data->commutation_config.delayed_commutation) {
+    uint32_t commutation_time = zc_time + _6step_sensorless_calculate_commutation_delay(bldc_data);
+
+    bldc_data->commutation_scheduled = hal_timer_schedule(commutation_time, _6step_sensorless_scheduled_commutation, motor);
+    if (bldc_data->commutation_scheduled) {
+      return true;
+    }
+  }
+
+  /* Immediate commutation, or no timer available */
+  _6step_sensorless_commutate_step(bldc_data, current_time);
+
+  return true;
+}
+
+/* Clears the commutation and zero-crossing tracking ahead of the open-loop startup from the given step */
+static void _6step_sensorless_startup_reset(struct Motor_t *motor, uint8_t step, uint32_t current_time) {
   struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
-  uint32_t start_time = hal_get_micros();
 
-  /* Step 1: Initial alignment phase */
-  bldc_data->mode = MOTOR_MODE_ALIGNING;
-  bldc_data->step = 0;
-  bldc_data->pwm_duty = DEFAULT_STARTUP_DUTY;
-  _6step_bldc_set_phase_outputs(bldc_6step_commutation_table[bldc_data->step], bldc_data->pwm_duty);
-  hal_delay_ms(DEFAULT_ALIGNMENT_TIME_MS);
+  bldc_data->step = step;
+  bldc_data->startup_mode_time = current_time;
+  bldc_data->startup_step_time = current_time;
+  bldc_data->startup_period = bldc_data->cold->startup_config.initial_period_us;
+  bldc_data->startup_step_count = 0U;
+  bldc_data->last_zc_time = current_time;
+  bldc_data->last_commutation_time = current_time;
+  bldc_data->last_velocity_update_time = current_time;
+  bldc_data->last_bemf_sample_valid = false;
+  bldc_data->last_bemf_delta_valid = false;
+  bldc_data->zc_candidate_valid = false;
+  bldc_data->commutation_scheduled = false;
+  bldc_data->bemf_noise = 0.0f;
+  bldc_data->bemf_peak = 0.0f;
+  bldc_data->last_bemf_peak = 0.0f;
+  bldc_data->zc_hysteresis = bldc_data->zc_config.min_hysteresis;
+  bldc_data->zc_state = _6step_sensorless_expected_zc_state(bldc_data->step, bldc_data->direction);
+  _6step_bldc_speed_estimator_reset(&bldc_data->speed_estimator);
+
+  /* Positions are counted from the aligned rotor */
+  bldc_data->position_steps = 0;
+  bldc_data->is_reverse_torque = false;
+  _6step_bldc_position_profile_reset(&bldc_data->position_profile, 0);
+}
 
-  /* Step 2: Open-loop acceleration phase */
+static void _6step_sensorless_open_loop_begin(struct Motor_t *motor, uint32_t current_time) {
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+
+  /* Open-loop acceleration phase */
   bldc_data->mode = MOTOR_MODE_OPEN_LOOP;
-  for (uint8_t i = 0; i < DEFAULT_STARTUP_STEPS; i++) {
-    /* Calculate next commutation time and duty based on acceleration */
-    uint32_t commutation_period = _6step_sensorless_calculate_startup_period(motor, i);
-    bldc_data->pwm_duty = _6step_sensorless_calculate_startup_duty(motor, i);
-
-    /* Next commutation step */
-    bldc_data->step = (bldc_data->step + (bldc_data->direction ? 1 : NUM_COMMUTATION_STEPS - 1)) % NUM_COMMUTATION_STEPS;
-    _6step_bldc_set_phase_outputs(bldc_6step_commutation_table[bldc_data->step], bldc_data->pwm_duty);
-
-    /* Wait for calculated time */
-    hal_delay_us(commutation_period);
-
-    /* Check for stall condition */
-    if ((hal_get_micros() - start_time) > (MAX_STALL_TIME_MS * 1000U)) {
-      if (bldc_data->estimated_speed < motor->config->min_startup_speed) {
-        // bldc_emergency_stop(motor); // TODO
-        bldc_data->mode = MOTOR_MODE_ERROR;
-        return MOTOR_INIT_ERROR;
-      }
+  bldc_data->startup_mode_time = current_time;
+  bldc_data->startup_period = bldc_data->cold->startup_config.initial_period_us;
+  bldc_data->pwm_duty = _6step_sensorless_calculate_startup_duty(motor, 0U);
+  _6step_sensorless_force_commutation(motor, current_time);
+}
+
+/* Direction index of the pulse, every pulse is followed by the opposite one so their torques cancel */
+static uint8_t _6step_sensorless_detect_pulse_direction(const struct BLDC6StepSensorlessData_t *bldc_data, uint8_t pulse) {
+  uint8_t num_pulses = bldc_data->cold->initial_position_config.num_pulses;
+  uint8_t direction = (pulse / 2U) + ((pulse % 2U) * (num_pulses / 2U));
+
+  return direction * (BLDC6STEP_MAX_DETECTION_PULSES / num_pulses);
+}
+
+static void _6step_sensorless_detect_apply_pulse(struct BLDC6StepSensorlessData_t *bldc_data, uint32_t current_time) {
+  uint8_t direction = _6step_sensorless_detect_pulse_direction(bldc_data, bldc_data->detect_pulse_index);
+
+  hal_pwm_set_gates(s_detect_pulse_gates[direction], 0.0f);
+  bldc_data->detect_pulse_on = true;
+  bldc_data->detect_pulse_time = current_time;
+}
+
+static void _6step_sensorless_detect_begin(struct Motor_t *motor, uint32_t current_time) {
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+
+  bldc_data->mode = MOTOR_MODE_DETECTING;
+  bldc_data->pwm_duty = 0.0f;
+  bldc_data->startup_mode_time = current_time;
+  bldc_data->detect_pulse_index = 0U;
+  _6step_sensorless_detect_apply_pulse(bldc_data, current_time);
+}
+
+/**
+ * @brief   Electrical angle of the north pole from the pulse currents
+ * @details Saturation makes the current of the pulses a function of their direction with one maximum, along the
+ *          north pole. Ld < Lq adds a maximum at each end of the d-axis, which is sharper when it dominates and is
+ *          then resolved to the end nearest the saturation estimate
+ */
+static float _6step_sensorless_detect_estimate(const struct BLDC6StepSensorlessData_t *bldc_data) {
+  float cos_sum = 0.0f;
+  float sin_sum = 0.0f;
+  float cos_2_sum = 0.0f;
+  float sin_2_sum = 0.0f;
+
+  for (uint8_t pulse = 0U; pulse < bldc_data->cold->initial_position_config.num_pulses; pulse++) {
+    float angle = (float)_6step_sensorless_detect_pulse_direction(bldc_data, pulse) * (MATH_PI / 6.0f);
+    float response = bldc_data->detect_responses[pulse];
+
+    cos_sum += response * cosf(angle);
+    sin_sum += response * sinf(angle);
+    cos_2_sum += response * cosf(2.0f * angle);
+    sin_2_sum += response * sinf(2.0f * angle);
+  }
+
+  float north = atan2f(sin_sum, cos_sum);
+
+  if (hypotf(cos_2_sum, sin_2_sum) > hypotf(cos_sum, sin_sum)) {
+    float axis = 0.5f * atan2f(sin_2_sum, cos_2_sum);
+    north = (cosf(axis - north) >= 0.0f) ? axis : (axis + MATH_PI);
+  }
+
+  return normalize_angle(north);
+}
+
+static void _6step_sensorless_detect_tick(struct Motor_t *motor, uint32_t current_time) {
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+  const struct BLDC6StepInitialPositionConfig_t *detect_config = &bldc_data->cold->initial_position_config;
+
+  if (!bldc_data->detect_pulse_on) {
+    if ((current_time - bldc_data->detect_pulse_time) >= detect_config->settle_time_us) {
+      _6step_sensorless_detect_apply_pulse(bldc_data, current_time);
     }
+    return;
   }
 
-  /* Step 3: Transition to closed-loop */
-  bldc_data->mode = MOTOR_MODE_TRANSITION;
+  if ((current_time - bldc_data->detect_pulse_time) < detect_config->pulse_time_us) {
+    return;
+  }
+
+  /* The currents were sampled by update_state at the end of the pulse, keep their component along it */
+  float angle = (float)_6step_sensorless_detect_pulse_direction(bldc_data, bldc_data->detect_pulse_index) * (MATH_PI / 6.0f);
+  float current_alpha = 0.0f;
+  float current_beta = 0.0f;
+
+  clarke_transform_3phase(motor->state.phase_currents[MOTOR_PHASE_A], motor->state.phase_currents[MOTOR_PHASE_B],
+                          motor->state.phase_currents[MOTOR_PHASE_C], &current_alpha, &current_beta);
+  bldc_data->detect_responses[bldc_data->detect_pulse_index] = current_alpha * cosf(angle) + current_beta * sinf(angle);
+  bldc_data->detect_pulse_index++;
+  bldc_data->detect_pulse_on = false;
+  bldc_data->detect_pulse_time = current_time;
+  _6step_bldc_stop_pwm_output();
+
+  if (bldc_data->detect_pulse_index < detect_config->num_pulses) {
+    return;
+  }
+
+  /**
+   * Step s drives the current at s * 60 - 30 electrical degrees. Start from the step the rotor lies within 60 degrees
+   * ahead of, so the first forced step leads it by 60 to 120 degrees as after an alignment
+   */
+  bldc_data->detected_angle = _6step_sensorless_detect_estimate(bldc_data);
+
+  int32_t sector = (int32_t)floorf((bldc_data->detected_angle + (MATH_PI / 6.0f)) / (MATH_PI / 3.0f));
+  int32_t step = bldc_data->direction ? (sector + 1) : sector;
 
-  /* Pre-calculate expected zero-crossing time based on last open-loop timing */
-  bldc_data->last_zc_time = hal_get_micros();
-  bldc_data->commutation_period = _6step_sensorless_calculate_startup_period(motor, DEFAULT_STARTUP_STEPS - 1);
+  _6step_sensorless_startup_reset(motor, (uint8_t)((step + 2 * NUM_COMMUTATION_STEPS) % NUM_COMMUTATION_STEPS), current_time);
+  _6step_sensorless_open_loop_begin(motor, current_time);
+}
+
+static void _6step_sensorless_startup_begin(struct Motor_t *motor, uint32_t current_time) {
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+
+  if (bldc_data->cold->initial_position_config.enabled) {
+    _6step_sensorless_detect_begin(motor, current_time);
+    return;
+  }
+
+  /* Initial alignment phase. Hold step 0 and let the following ticks time it out */
+  _6step_sensorless_startup_reset(motor, 0U, current_time);
+  bldc_data->mode = MOTOR_MODE_ALIGNING;
+  bldc_data->pwm_duty = bldc_data->cold->startup_config.align_duty;
+  _6step_bldc_set_phase_outputs(bldc_data->pwm_scheme, bldc_data->step, bldc_data->pwm_duty);
+}
+
+static void _6step_sensorless_catch_begin(struct Motor_t *motor, uint32_t current_time) {
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+
+  /* Flying start. With the bridge off no current flows and every terminal carries its Back-EMF */
+  bldc_data->mode = MOTOR_MODE_CATCHING;
+  bldc_data->pwm_duty = 0.0f;
+  bldc_data->startup_mode_time = current_time;
+  bldc_data->catch_last_sample_time = current_time;
+  bldc_data->catch_zc_count = 0U;
+  bldc_data->bemf_peak = 0.0f;
 
-  /* Initialize BEMF filters with expected values to ensure smoother transition */
   for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
-    bldc_data->bemf_filtered[phase] = 0.0f;
+    bldc_data->catch_bemf_sign[phase] = 0;
+    bldc_data->catch_last_bemf[phase] = 0.0f;
   }
 
-  /* Now fully running in closed-loop mode */
+  _6step_bldc_stop_pwm_output();
+}
+
+/* Closed-loop from the caught rotor, picking up as if the driver had detected the last crossing itself */
+static void _6step_sensorless_catch_enter_running(struct Motor_t *motor, float duty, uint32_t current_time) {
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+
   bldc_data->mode = MOTOR_MODE_RUNNING;
+  bldc_data->last_commutation_time = current_time;
+  bldc_data->last_velocity_update_time = current_time;
+  bldc_data->last_bemf_sample_valid = false;
+  bldc_data->last_bemf_delta_valid = false;
+  bldc_data->zc_candidate_valid = false;
+  bldc_data->bemf_noise = 0.0f;
+  bldc_data->zc_state = _6step_sensorless_expected_zc_state(bldc_data->step, bldc_data->direction);
+  _6step_bldc_speed_estimator_reset(&bldc_data->speed_estimator);
+  bldc_data->estimated_speed = _6step_bldc_speed_estimator_push(&bldc_data->speed_estimator, bldc_data->commutation_period);
+  motor->state.velocity = bldc_data->estimated_speed;
+
+  /* Positions are counted from the caught rotor */
+  bldc_data->position_steps = 0;
+  bldc_data->is_reverse_torque = false;
+  _6step_bldc_position_profile_reset(&bldc_data->position_profile, 0);
+
+  /* The loops start out at the duty that matches the Back-EMF, so the bridge reconnects without a current step */
+  bldc_data->pwm_duty = clamp(duty, 0.0f, 1.0f);
+  pid_init(&motor->control.current, &motor->config->current_pid_config);
+  pid_init(&motor->control.velocity, &motor->config->velocity_pid_config);
+
+  if (motor->control.current.gains.ki != 0.0f) {
+    motor->control.current.integral = bldc_data->pwm_duty / motor->control.current.gains.ki;
+  }
+
+  if (motor->control.velocity.gains.ki != 0.0f) {
+    motor->control.velocity.integral = bldc_data->pwm_duty / motor->control.velocity.gains.ki;
+  }
+
+  _6step_bldc_set_phase_outputs(bldc_data->pwm_scheme, bldc_data->step, bldc_data->pwm_duty);
+
+  if (bldc_data->commutation_config.delayed_commutation) {
+    uint32_t commutation_time = bldc_data->last_zc_time + _6step_sensorless_calculate_commutation_delay(bldc_data);
+    bldc_data->commutation_scheduled = hal_timer_schedule(commutation_time, _6step_sensorless_scheduled_commutation, motor);
+  } else {
+    bldc_data->commutation_scheduled = false;
+  }
+
+  /* Immediate commutation, or no timer available */
+  if (!bldc_data->commutation_scheduled) {
+    _6step_sensorless_commutate_step(bldc_data, current_time);
+  }
+}
+
+static void _6step_sensorless_catch_zero_crossing(struct Motor_t *motor, MotorPhase_t phase, bool is_rising, uint32_t zc_time) {
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+  ZeroCrossingState_t zc_state = is_rising ? ZC_STATE_RISING : ZC_STATE_FALLING;
+  uint8_t step = NUM_COMMUTATION_STEPS;
+
+  /* Each phase floats in two steps, which see opposite crossings */
+  for (uint8_t candidate = 0U; candidate < NUM_COMMUTATION_STEPS; candidate++) {
+    if (_6step_bldc_determine_floating_phase(candidate) == phase &&
+        _6step_sensorless_expected_zc_state(candidate, bldc_data->direction) == zc_state) {
+      step = candidate;
+    }
+  }
+
+  uint8_t next_step = bldc_data->direction ? (uint8_t)((bldc_data->step + 1U) % NUM_COMMUTATION_STEPS)
+                                           : (uint8_t)((bldc_data->step + NUM_COMMUTATION_STEPS - 1U) % NUM_COMMUTATION_STEPS);
+
+  if (bldc_data->catch_zc_count > 0U && step == next_step) {
+    bldc_data->commutation_period = zc_time - bldc_data->last_zc_time;
+    bldc_data->catch_zc_count++;
+  } else {
+    /* First crossing, or the rotor turns against the driver direction */
+    bldc_data->catch_zc_count = 1U;
+  }
+
+  bldc_data->step = step;
+  bldc_data->last_zc_time = zc_time;
+}
+
+/* Times the Back-EMF zero-crossings with the bridge off, then hands a spinning rotor to closed-loop and a slow one to the startup */
+static void _6step_sensorless_catch_tick(struct Motor_t *motor, uint32_t current_time) {
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+  const float *phase_voltages = motor->state.phase_voltages;
+  float neutral = (phase_voltages[MOTOR_PHASE_A] + phase_voltages[MOTOR_PHASE_B] + phase_voltages[MOTOR_PHASE_C]) / 3.0f;
+  float hysteresis = bldc_data->zc_config.min_hysteresis;
+  float sample_interval = (float)(current_time - bldc_data->catch_last_sample_time);
+  float bemf_max = -INFINITY;
+  float bemf_min = INFINITY;
+
+  for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+    /* The star point floats with the bridge off, the average of the terminals follows it */
+    float bemf = phase_voltages[phase] - neutral;
+    int8_t sign = (bemf > hysteresis) ? 1 : ((bemf < -hysteresis) ? -1 : 0);
+
+    if (sign != 0 && bldc_data->catch_bemf_sign[phase] == -sign) {
+      /* Confirmed past the hysteresis, the crossing is extrapolated back to zero along the last slope */
+      float slope = bemf - bldc_data->catch_last_bemf[phase];
+      float fraction = ((bemf * slope) > 0.0f) ? fminf(bemf / slope, CATCH_MAX_EXTRAPOLATION) : 0.0f;
+
+      _6step_sensorless_catch_zero_crossing(motor, phase, sign > 0, current_time - (uint32_t)(fraction * sample_interval));
+    }
+
+    if (sign != 0) {
+      bldc_data->catch_bemf_sign[phase] = sign;
+    }
+
+    bldc_data->catch_last_bemf[phase] = bemf;
+    bldc_data->bemf_peak = fmaxf(bldc_data->bemf_peak, fabsf(bemf));
+    bemf_max = fmaxf(bemf_max, bemf);
+    bemf_min = fminf(bemf_min, bemf);
+  }
+
+  bldc_data->catch_last_sample_time = current_time;
+
+  if (bldc_data->catch_zc_count >= CATCH_ZERO_CROSSINGS) {
+    if (bldc_data->commutation_period <= bldc_data->cold->startup_config.final_period_us) {
+      /* Just past the crossing of the floating phase, the two driven phases see the full line-to-line Back-EMF */
+      float duty = (motor->state.dc_voltage > 0.0f) ? ((bemf_max - bemf_min) / motor->state.dc_voltage) : 0.0f;
+
+      _6step_sensorless_catch_enter_running(motor, duty, current_time);
+    } else {
+      /* Slower than the open-loop startup hands over at, too little Back-EMF to commutate on */
+      _6step_sensorless_startup_begin(motor, current_time);
+    }
+  } else if ((current_time - bldc_data->startup_mode_time) > bldc_data->cold->flying_start_config.catch_time_us) {
+    /* Standing, or turning the other way */
+    _6step_sensorless_startup_begin(motor, current_time);
+  }
+}
+
+static void _6step_sensorless_update_position(struct Motor_t *motor, struct BLDC6StepSensorlessData_t *bldc_data, float delta_time) {
+  if (bldc_data->position_steps >= bldc_data->position_profile.target) {
+    /* Commutation stops with the Back-EMF. Hold the target step like the alignment the count starts from */
+    hal_timer_cancel();
+    bldc_data->commutation_scheduled = false;
+    bldc_data->is_reverse_torque = false;
+    bldc_data->pwm_duty = bldc_data->cold->startup_config.align_duty;
+    bldc_data->mode = MOTOR_MODE_BRAKING;
+    _6step_bldc_set_phase_outputs(bldc_data->pwm_scheme, bldc_data->step, bldc_data->pwm_duty);
+    return;
+  }
+
+  float velocity_feedforward = _6step_bldc_position_profile_update(&bldc_data->position_profile, &bldc_data->cold->position_config, delta_time);
+
+  /* Position loop trims the profile speed, the velocity loop turns the speed command into a signed duty */
+  float velocity_command =
+      velocity_feedforward + pid_update(&motor->control.position, bldc_data->position_profile.position, (float)bldc_data->position_steps, delta_time);
+
+  /* The last steps still need a Back-EMF to commutate on, they are taken at the speed the open-loop startup hands over at */
+  if (bldc_data->cold->startup_config.final_period_us > 0U) {
+    velocity_command = fmaxf(velocity_command, BLDC6STEP_RPM_PERIOD_PRODUCT / (float)bldc_data->cold->startup_config.final_period_us);
+  }
+
+  float duty = pid_update(&motor->control.velocity, velocity_command, bldc_data->estimated_speed, delta_time);
+
+  bldc_data->is_reverse_torque = (duty < 0.0f);
+  bldc_data->pwm_duty = fabsf(duty);
+}
+
+static MotorError_t _6step_sensorless_startup_tick(struct Motor_t *motor, uint32_t current_time) {
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+  const struct BLDC6StepStartupConfig_t *startup_config = &bldc_data->cold->startup_config;
+
+  switch (bldc_data->mode) {
+    case MOTOR_MODE_DETECTING:
+      _6step_sensorless_detect_tick(motor, current_time);
+      break;
+
+    case MOTOR_MODE_ALIGNING:
+      if ((current_time - bldc_data->startup_mode_time) >= startup_config->align_time_us) {
+        _6step_sensorless_open_loop_begin(motor, current_time);
+      }
+      break;
+
+    case MOTOR_MODE_OPEN_LOOP:
+      if ((current_time - bldc_data->startup_step_time) < bldc_data->startup_period) {
+        break;
+      }
+
+      if (bldc_data->startup_step_count >= startup_config->num_steps) {
+        /* Transition to closed-loop. Start from clean filters so the first zero-crossing is genuine */
+        bldc_data->mode = MOTOR_MODE_TRANSITION;
+        bldc_data->startup_mode_time = current_time;
+        bldc_data->last_zc_time = current_time;
+
+        for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+          bldc_data->bemf_filtered[phase] = 0.0f;
+        }
+        break;
+      }
+
+      bldc_data->startup_period = _6step_sensorless_calculate_startup_period(startup_config, bldc_data->startup_period);
+      bldc_data->pwm_duty = _6step_sensorless_calculate_startup_duty(motor, bldc_data->startup_step_count);
+      _6step_sensorless_force_commutation(motor, current_time);
+      break;
+
+    case MOTOR_MODE_TRANSITION:
+      if (_6step_sensorless_detect_zero_crossing(motor, current_time)) {
+        /* Now fully running in closed-loop mode */
+        bldc_data->mode = MOTOR_MODE_RUNNING;
+        break;
+      }
+
+      if ((current_time - bldc_data->startup_mode_time) > startup_config->transition_timeout_us) {
+        /* The rotor never produced a usable Back-EMF, it has stalled */
+        bldc_data->mode = MOTOR_MODE_ERROR;
+        _6step_bldc_stop_pwm_output();
+        return MOTOR_INIT_ERROR;
+      }
+
+      /* Keep the rotor turning at the final open-loop speed until Back-EMF can be tracked */
+      if ((current_time - bldc_data->startup_step_time) >= bldc_data->startup_period) {
+        _6step_sensorless_force_commutation(motor, current_time);
+      }
+      break;
+
+    default:
+      break;
+  }
 
   return MOTOR_OK;
 }
@@ -169,17 +756,25 @@ static MotorError_t _6step_sensorless_init(struct Motor_t *motor, struct MotorCo
     return MOTOR_INVALID_ARGS;
   }
 
+  /* The pulse directions must split the electrical revolution evenly */
+  const struct BLDC6StepInitialPositionConfig_t *detect_config = &s_6step_sensorless_cold.initial_position_config;
+  if (detect_config->enabled && detect_config->num_pulses != 6U && detect_config->num_pulses != BLDC6STEP_MAX_DETECTION_PULSES) {
+    return MOTOR_INVALID_ARGS;
+  }
+
   motor->config = config;
   motor->private_data = &s_6step_sensorless_data;
 
   s_6step_sensorless_data.step = 0U;
   s_6step_sensorless_data.direction = true;
   s_6step_sensorless_data.pwm_duty = 0U;
-  s_6step_sensorless_data.zc_state = ZC_STATE_RISING;
-  s_6step_sensorless_data.zc_threshold = 0.1f;
+  s_6step_sensorless_data.zc_state = _6step_sensorless_expected_zc_state(0U, true);
+  s_6step_sensorless_data.zc_hysteresis = s_6step_sensorless_data.zc_config.min_hysteresis;
   s_6step_sensorless_data.bemf_filter_alpha = 0.1f;
   s_6step_sensorless_data.estimated_speed = 0.0f;
   s_6step_sensorless_data.commutation_period = MAX_COMMUTATION_PERIOD_US;
+  s_6step_sensorless_data.last_zc_time = 0U;
+  s_6step_sensorless_data.is_reverse_torque = false;
   s_6step_sensorless_data.mode = MOTOR_MODE_IDLE;
 
   for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
@@ -190,16 +785,26 @@ static MotorError_t _6step_sensorless_init(struct Motor_t *motor, struct MotorCo
   /* Initialize PID */
   pid_init(&motor->control.current, &motor->config->current_pid_config);
   pid_init(&motor->control.velocity, &motor->config->velocity_pid_config);
+  pid_init(&motor->control.position, &motor->config->position_pid_config);
+
+  /* The control cycle reads the copies in params */
+  motor_reload_config(motor);
 
   /* Initialize hardware */
   if (!hal_pwm_init(&config->pwm_config) || !hal_adc_init(&config->adc_config) || !hal_gpio_init()) {
     return MOTOR_INIT_ERROR;
   }
 
-  /* Startup sequence */
-  MotorError_t startup_res = _6step_sensorless_startup_sequence(motor);
-  if (startup_res != MOTOR_OK) {
-    return startup_res;
+  /* Sample the floating phase at a fixed point of the on-time, away from the switching edges */
+  if (!hal_adc_set_pwm_trigger(s_6step_sensorless_data.zc_config.sample_point)) {
+    return MOTOR_INIT_ERROR;
+  }
+
+  /* Startup sequence. Only alignment or detection, or the flying start measurement, is started here, motor_run() advances it */
+  if (s_6step_sensorless_cold.flying_start_config.enabled) {
+    _6step_sensorless_catch_begin(motor, hal_get_micros());
+  } else {
+    _6step_sensorless_startup_begin(motor, hal_get_micros());
   }
 
   motor->state.is_initialized = true;
@@ -214,6 +819,8 @@ static MotorError_t _6step_sensorless_deinit(struct Motor_t *motor) {
 
   struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
 
+  hal_timer_cancel();
+  bldc_data->commutation_scheduled = false;
   _6step_bldc_stop_pwm_output();
 
   motor->state.is_initialized = false;
@@ -247,12 +854,14 @@ static MotorError_t _6step_sensorless_update_state(struct Motor_t *motor) {
   float delta_time = (current_time - motor->state.last_update_time) / 1000000.0f;
   motor->state.last_update_time = current_time;
 
-  /* Check for overvoltage or undervoltage */
+  /* The terminals swing between the rails, so overvoltage is checked on the bus */
+  if (motor->state.dc_voltage > MOTOR_BUS_OVERVOLTAGE_RATIO * motor->params.max_voltage) {
+    bldc_data->mode = MOTOR_MODE_ERROR;
+    return MOTOR_OVERVOLTAGE_ERROR;
+  }
+
   for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
-    if (motor->state.phase_voltages[phase] > motor->config->max_voltage) {
-      bldc_data->mode = MOTOR_MODE_ERROR;
-      return MOTOR_OVERVOLTAGE_ERROR;
-    } else if (motor->state.phase_currents[phase] > motor->config->max_current) {
+    if (motor->state.phase_currents[phase] > motor->params.max_current) {
       bldc_data->mode = MOTOR_MODE_ERROR;
       return MOTOR_OVERCURRENT_ERROR;
     }
@@ -260,26 +869,47 @@ static MotorError_t _6step_sensorless_update_state(struct Motor_t *motor) {
 
   MotorPhase_t floating_phase = _6step_bldc_determine_floating_phase(bldc_data->step);
 
-  /* Sample BEMF on the floating phase */
-  bldc_data->bemf[floating_phase] = motor->state.phase_voltages[floating_phase];
+  /* Sample BEMF on the floating phase, relative to the star point so bus sag and PWM level cancel out */
+  float bemf_sample = motor->state.phase_voltages[floating_phase] - _6step_sensorless_calculate_zc_reference(bldc_data, &motor->state);
+  _6step_sensorless_track_zero_crossing(bldc_data, bemf_sample, current_time);
+  bldc_data->bemf[floating_phase] = bemf_sample;
 
   /* Apply low-pass filter */
   bldc_data->bemf_filtered[floating_phase] = (bldc_data->bemf_filter_alpha * bldc_data->bemf[floating_phase]) +
                                              ((1.0f - bldc_data->bemf_filter_alpha) * bldc_data->bemf_filtered[floating_phase]);
 
-  switch (motor->config->control_mode) {
+  motor->state.position = _6step_bldc_steps_to_position(bldc_data->position_steps, motor->params.pole_pairs);
+
+  /* The startup ramp owns the duty cycle until closed-loop operation */
+  if (bldc_data->mode != MOTOR_MODE_RUNNING) {
+    return MOTOR_OK;
+  }
+
+  /* Only the position mode brakes */
+  bldc_data->is_reverse_torque = false;
+
+  switch (motor->params.control_mode) {
     case CONTROL_MODE_TORQUE:
     case CONTROL_MODE_CURRENT:
       bldc_data->pwm_duty = pid_update(&motor->control.current, motor->setpoint.current, motor->state.phase_currents[floating_phase], delta_time);
       break;
     case CONTROL_MODE_VELOCITY:
-      bldc_data->pwm_duty = pid_update(&motor->control.velocity, motor->setpoint.velocity, bldc_data->estimated_speed, delta_time);
+      if (!motor->params.velocity_loop_per_commutation) {
+        bldc_data->pwm_duty = pid_update(&motor->control.velocity, motor->setpoint.velocity, bldc_data->estimated_speed, delta_time);
+        bldc_data->last_velocity_update_time = current_time;
+      } else if (bldc_data->speed_estimator.is_updated) {
+        /* One update per measured commutation period, integrated over the time since the previous update */
+        float velocity_delta_time = (float)(current_time - bldc_data->last_velocity_update_time) / 1000000.0f;
+        bldc_data->pwm_duty = pid_update(&motor->control.velocity, motor->setpoint.velocity, bldc_data->estimated_speed, velocity_delta_time);
+        bldc_data->speed_estimator.is_updated = false;
+        bldc_data->last_velocity_update_time = current_time;
+      }
       break;
     case CONTROL_MODE_VOLTAGE:
-      bldc_data->pwm_duty = motor->setpoint.voltage / motor->config->max_voltage;
+      bldc_data->pwm_duty = motor->setpoint.voltage / motor->params.max_voltage;
       break;
     case CONTROL_MODE_POSITION:
-      // TODO: Complete position control
+      _6step_sensorless_update_position(motor, bldc_data, delta_time);
       break;
     default:
       break;
@@ -298,45 +928,27 @@ static MotorError_t _6step_sensorless_commutate(struct Motor_t *motor) {
 
   struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
 
-  if (bldc_data->mode != MOTOR_MODE_RUNNING) {
-    _6step_bldc_stop_pwm_output();
-    return MOTOR_OK;
-  }
-
   uint32_t current_time = hal_get_micros();
-  float bemf_value = bldc_data->bemf_filtered[_6step_bldc_determine_floating_phase(bldc_data->step)];
 
-  /**
-   * Only check for zero crossing if enough time has passed since last commutation
-   * This prevents very high-frequency false zero-crossings at high speed or noise
-   */
-  if ((current_time - bldc_data->last_zc_time) >= MIN_COMMUTATION_PERIOD_US) {
-    if (_6step_sensorless_has_zero_crossed(bemf_value, bldc_data->zc_threshold, bldc_data->zc_state)) {
-      bldc_data->commutation_period = current_time - bldc_data->last_zc_time;
-
-      /* RPM = Revolutions / Minute */
-      /* Commutation period is time for 1/6th of a full revolution, thus RPM = 1/6 * 1/T_us * 60 *
-       * 10^6 */
-      bldc_data->estimated_speed = 60.0f * (1000000.0f / ((float)bldc_data->commutation_period * 6.0f));
-      motor->state.velocity = bldc_data->estimated_speed;
-
-      // printf("Zero cross %d, Period: %lu us, Speed: %.2f RPM\n", bldc_data->step,
-      // bldc_data->commutation_period, bldc_data->estimated_speed);
-
-      if (bldc_data->direction) {
-        bldc_data->step = (bldc_data->step + 1U) % NUM_COMMUTATION_STEPS;
-      } else {
-        bldc_data->step = (bldc_data->step + NUM_COMMUTATION_STEPS - 1U) % NUM_COMMUTATION_STEPS;
-      }
-
-      _6step_bldc_set_phase_outputs(bldc_6step_commutation_table[bldc_data->step], bldc_data->pwm_duty);
-
-      bldc_data->last_zc_time = current_time;
-      bldc_data->zc_state = _6step_sensorless_update_zc_state(bldc_data->zc_state);
-    }
+  switch (bldc_data->mode) {
+    case MOTOR_MODE_CATCHING:
+      _6step_sensorless_catch_tick(motor, current_time);
+      return MOTOR_OK;
+    case MOTOR_MODE_DETECTING:
+    case MOTOR_MODE_ALIGNING:
+    case MOTOR_MODE_OPEN_LOOP:
+    case MOTOR_MODE_TRANSITION:
+      return _6step_sensorless_startup_tick(motor, current_time);
+    case MOTOR_MODE_RUNNING:
+      _6step_sensorless_detect_zero_crossing(motor, current_time);
+      return MOTOR_OK;
+    case MOTOR_MODE_BRAKING:
+      /* Holding the reached position, nothing commutates */
+      return MOTOR_OK;
+    default:
+      _6step_bldc_stop_pwm_output();
+      return MOTOR_OK;
   }
-
-  return MOTOR_OK;
 }
 
 static MotorError_t _6step_sensorless_update_pwm(struct Motor_t *motor) {
@@ -346,12 +958,18 @@ static MotorError_t _6step_sensorless_update_pwm(struct Motor_t *motor) {
 
   struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
 
-  if (bldc_data->mode != MOTOR_MODE_RUNNING) {
+  /* The detection pulses are applied and released by the detection itself */
+  if (bldc_data->mode == MOTOR_MODE_DETECTING) {
+    return MOTOR_OK;
+  }
+
+  if (bldc_data->mode != MOTOR_MODE_RUNNING && bldc_data->mode != MOTOR_MODE_ALIGNING && bldc_data->mode != MOTOR_MODE_OPEN_LOOP &&
+      bldc_data->mode != MOTOR_MODE_TRANSITION && bldc_data->mode != MOTOR_MODE_BRAKING) {
     _6step_bldc_stop_pwm_output();
     return MOTOR_OK;
   }
 
-  _6step_bldc_set_phase_outputs(bldc_6step_commutation_table[bldc_data->step], bldc_data->pwm_duty);
+  _6step_bldc_set_phase_outputs(bldc_data->pwm_scheme, _6step_sensorless_torque_step(bldc_data), bldc_data->pwm_duty);
 
   return MOTOR_OK;
 }
@@ -360,8 +978,8 @@ static MotorError_t _6step_sensorless_set_voltage(struct Motor_t *motor, float v
   if (motor == NULL) {
     return MOTOR_INVALID_ARGS;
   }
-  motor->setpoint.voltage = fminf(voltage, motor->config->max_voltage);
-  motor->config->control_mode = CONTROL_MODE_VOLTAGE;
+  motor->setpoint.voltage = fminf(voltage, motor->params.max_voltage);
+  motor_set_control_mode(motor, CONTROL_MODE_VOLTAGE);
   return MOTOR_OK;
 }
 
@@ -369,8 +987,8 @@ static MotorError_t _6step_sensorless_set_current(struct Motor_t *motor, float c
   if (motor == NULL) {
     return MOTOR_INVALID_ARGS;
   }
-  motor->setpoint.current = fminf(current, motor->config->max_current);
-  motor->config->control_mode = CONTROL_MODE_CURRENT;
+  motor->setpoint.current = fminf(current, motor->params.max_current);
+  motor_set_control_mode(motor, CONTROL_MODE_CURRENT);
   return MOTOR_OK;
 }
 
@@ -378,8 +996,8 @@ static MotorError_t _6step_sensorless_set_velocity(struct Motor_t *motor, float
   if (motor == NULL) {
     return MOTOR_INVALID_ARGS;
   }
-  motor->setpoint.velocity = fminf(velocity, motor->config->max_velocity);
-  motor->config->control_mode = CONTROL_MODE_VELOCITY;
+  motor->setpoint.velocity = fminf(velocity, motor->params.max_velocity);
+  motor_set_control_mode(motor, CONTROL_MODE_VELOCITY);
   return MOTOR_OK;
 }
 
@@ -387,8 +1005,30 @@ static MotorError_t _6step_sensorless_set_position(struct Motor_t *motor, float
   if (motor == NULL) {
     return MOTOR_INVALID_ARGS;
   }
+
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+  int32_t target = _6step_bldc_position_to_steps(position, motor->params.pole_pairs);
+
+  /* Moves are forward only, and a held, stopped or faulted motor has no Back-EMF to start a move from */
+  if (target <= bldc_data->position_steps || bldc_data->mode == MOTOR_MODE_BRAKING || bldc_data->mode == MOTOR_MODE_STOPPED ||
+      bldc_data->mode == MOTOR_MODE_ERROR) {
+    return MOTOR_INVALID_ARGS;
+  }
+
+  if (motor->params.control_mode != CONTROL_MODE_POSITION) {
+    /* The first move starts from the counted position at the measured speed */
+    _6step_bldc_position_profile_reset(&bldc_data->position_profile, bldc_data->position_steps);
+    bldc_data->position_profile.velocity = bldc_data->estimated_speed / BLDC6STEP_RPM_PER_STEP_RATE;
+
+    /* The velocity loop takes over at the running duty, so the handover does not drop the speed */
+    if (motor->control.velocity.gains.ki != 0.0f) {
+      motor->control.velocity.integral = bldc_data->pwm_duty / motor->control.velocity.gains.ki;
+    }
+  }
+
+  bldc_data->position_profile.target = target;
   motor->setpoint.position = position;
-  motor->config->control_mode = CONTROL_MODE_POSITION;
+  motor_set_control_mode(motor, CONTROL_MODE_POSITION);
   return MOTOR_OK;
 }
 
@@ -397,8 +1037,8 @@ static MotorError_t _6step_sensorless_set_torque(struct Motor_t *motor, float to
     return MOTOR_INVALID_ARGS;
   }
   motor->setpoint.torque = torque;
-  motor->setpoint.current = motor->setpoint.torque / motor->config->torque_constant;
-  motor->config->control_mode = CONTROL_MODE_TORQUE;
+  motor->setpoint.current = motor->setpoint.torque / motor->params.torque_constant;
+  motor_set_control_mode(motor, CONTROL_MODE_TORQUE);
   return MOTOR_OK;
 }
 
@@ -419,4 +1059,46 @@ void bldc_6step_sensorless_create_driver(struct Motor_t *motor) {
     motor->driver.set_position = _6step_sensorless_set_position;
     motor->driver.set_torque = _6step_sensorless_set_torque;
   }
+}
+
+void bldc_6step_sensorless_set_startup_config(const struct BLDC6StepStartupConfig_t *config) {
+  if (config != NULL) {
+    s_6step_sensorless_cold.startup_config = *config;
+  }
+}
+
+void bldc_6step_sensorless_set_flying_start_config(const struct BLDC6StepFlyingStartConfig_t *config) {
+  if (config != NULL) {
+    s_6step_sensorless_cold.flying_start_config = *config;
+  }
+}
+
+void bldc_6step_sensorless_set_initial_position_config(const struct BLDC6StepInitialPositionConfig_t *config) {
+  if (config != NULL) {
+    s_6step_sensorless_cold.initial_position_config = *config;
+  }
+}
+
+void bldc_6step_sensorless_set_commutation_config(const struct BLDC6StepCommutationConfig_t *config) {
+  if (config != NULL) {
+    s_6step_sensorless_data.commutation_config = *config;
+  }
+}
+
+void bldc_6step_sensorless_set_zero_crossing_config(const struct BLDC6StepZeroCrossingConfig_t *config) {
+  if (config != NULL) {
+    s_6step_sensorless_data.zc_config = *config;
+  }
+}
+
+void bldc_6step_sensorless_set_pwm_scheme(BLDC6StepPwmScheme_t scheme) {
+  if (scheme < NUM_BLDC6STEP_PWM_SCHEMES) {
+    s_6step_sensorless_data.pwm_scheme = scheme;
+  }
+}
+
+void bldc_6step_sensorless_set_position_config(const struct BLDC6StepPositionConfig_t *config) {
+  if (config != NULL) {
+    s_6step_sensorless_cold.position_config = *config;
+  }
 }
\ No newline at end of file
@@ -8,60 +8,78 @@
  *******************************************************************************************************************************/
 
 /* Standard library Headers */
+#include <math.h>
 #include <stddef.h>
 #include <stdio.h>
 
 /* Inter-component Headers */
 #include "hal.h"
+#include "math_utils.h"
 
 /* Intra-component Headers */
 #include "bldc_6step_common.h"
 
+/*******************************************************************************************************************************
+ * Private Defines
+ *******************************************************************************************************************************/
+
+/* Gate states of one step, given the sourcing (high) and sinking (low) phase */
+#define GATES_H_PWM_L_ON(high, low) (HAL_GATE_HIGH(high) | HAL_GATE_PWM(high) | HAL_GATE_LOW(low))
+#define GATES_H_ON_L_PWM(high, low) (HAL_GATE_HIGH(high) | HAL_GATE_LOW(low) | HAL_GATE_PWM(low))
+#define GATES_COMPLEMENTARY(high, low) (HAL_GATE_HIGH(high) | HAL_GATE_LOW(high) | HAL_GATE_PWM(high) | HAL_GATE_LOW(low))
+
 /*******************************************************************************************************************************
  * Private Variables
  *******************************************************************************************************************************/
 
-const uint8_t bldc_6step_commutation_table[NUM_COMMUTATION_STEPS][NUM_COMMUTATION_STEPS] = {
-  /* High_A, Low_A, High_B, Low_B, High_C, Low_C */
-  { 1U, 0U, 0U, 1U, 0U, 0U }, /* Step 1: A-High, B-Low */
-  { 1U, 0U, 0U, 0U, 0U, 1U }, /* Step 2: A-High, C-Low */
-  { 0U, 0U, 1U, 0U, 0U, 1U }, /* Step 3: B-High, C-Low */
-  { 0U, 1U, 1U, 0U, 0U, 0U }, /* Step 4: B-High, A-Low */
-  { 0U, 1U, 0U, 0U, 1U, 0U }, /* Step 5: C-High, A-Low */
-  { 0U, 0U, 0U, 1U, 1U, 0U }, /* Step 6: C-High, B-Low */
+const uint16_t bldc_6step_commutation_table[NUM_BLDC6STEP_PWM_SCHEMES][NUM_COMMUTATION_STEPS] = {
+  [BLDC6STEP_PWM_H_PWM_L_ON] = {
+    GATES_H_PWM_L_ON(MOTOR_PHASE_A, MOTOR_PHASE_B), /* Step 1: A-High, B-Low */
+    GATES_H_PWM_L_ON(MOTOR_PHASE_A, MOTOR_PHASE_C), /* Step 2: A-High, C-Low */
+    GATES_H_PWM_L_ON(MOTOR_PHASE_B, MOTOR_PHASE_C), /* Step 3: B-High, C-Low */
+    GATES_H_PWM_L_ON(MOTOR_PHASE_B, MOTOR_PHASE_A), /* Step 4: B-High, A-Low */
+    GATES_H_PWM_L_ON(MOTOR_PHASE_C, MOTOR_PHASE_A), /* Step 5: C-High, A-Low */
+    GATES_H_PWM_L_ON(MOTOR_PHASE_C, MOTOR_PHASE_B), /* Step 6: C-High, B-Low */
+  },
+  [BLDC6STEP_PWM_H_ON_L_PWM] = {
+    GATES_H_ON_L_PWM(MOTOR_PHASE_A, MOTOR_PHASE_B),
+    GATES_H_ON_L_PWM(MOTOR_PHASE_A, MOTOR_PHASE_C),
+    GATES_H_ON_L_PWM(MOTOR_PHASE_B, MOTOR_PHASE_C),
+    GATES_H_ON_L_PWM(MOTOR_PHASE_B, MOTOR_PHASE_A),
+    GATES_H_ON_L_PWM(MOTOR_PHASE_C, MOTOR_PHASE_A),
+    GATES_H_ON_L_PWM(MOTOR_PHASE_C, MOTOR_PHASE_B),
+  },
+  [BLDC6STEP_PWM_COMPLEMENTARY] = {
+    GATES_COMPLEMENTARY(MOTOR_PHASE_A, MOTOR_PHASE_B),
+    GATES_COMPLEMENTARY(MOTOR_PHASE_A, MOTOR_PHASE_C),
+    GATES_COMPLEMENTARY(MOTOR_PHASE_B, MOTOR_PHASE_C),
+    GATES_COMPLEMENTARY(MOTOR_PHASE_B, MOTOR_PHASE_A),
+    GATES_COMPLEMENTARY(MOTOR_PHASE_C, MOTOR_PHASE_A),
+    GATES_COMPLEMENTARY(MOTOR_PHASE_C, MOTOR_PHASE_B),
+  },
+  /* Each switch conducts for two steps, held on in the first and modulating in the second. The switch turned off at a
+     commutation is always the modulating one, so the outgoing phase freewheels against the full bus and clears quickly */
+  [BLDC6STEP_PWM_ALTERNATING] = {
+    GATES_H_ON_L_PWM(MOTOR_PHASE_A, MOTOR_PHASE_B),
+    GATES_H_PWM_L_ON(MOTOR_PHASE_A, MOTOR_PHASE_C),
+    GATES_H_ON_L_PWM(MOTOR_PHASE_B, MOTOR_PHASE_C),
+    GATES_H_PWM_L_ON(MOTOR_PHASE_B, MOTOR_PHASE_A),
+    GATES_H_ON_L_PWM(MOTOR_PHASE_C, MOTOR_PHASE_A),
+    GATES_H_PWM_L_ON(MOTOR_PHASE_C, MOTOR_PHASE_B),
+  },
 };
 
 /*******************************************************************************************************************************
  * Function Definitions
  *******************************************************************************************************************************/
 
-void _6step_bldc_set_phase_outputs(const uint8_t commutation[NUM_COMMUTATION_STEPS], float pwm_duty) {
-  /* Phase A */
-  if (commutation[PHASE_A_HIGH_COMMUTATION_IDX] == 1U) {
-    hal_pwm_set_duty(MOTOR_PHASE_A, pwm_duty);
-  } else if (commutation[PHASE_A_LOW_COMMUTATION_IDX] == 1U) {
-    hal_gpio_set_phase_low(MOTOR_PHASE_A);
-  } else {
-    hal_gpio_set_phase_float(MOTOR_PHASE_A);
-  }
-
-  /* Phase B */
-  if (commutation[PHASE_B_HIGH_COMMUTATION_IDX] == 1U) {
-    hal_pwm_set_duty(MOTOR_PHASE_B, pwm_duty);
-  } else if (commutation[PHASE_B_LOW_COMMUTATION_IDX] == 1U) {
-    hal_gpio_set_phase_low(MOTOR_PHASE_B);
-  } else {
-    hal_gpio_set_phase_float(MOTOR_PHASE_B);
+void _6step_bldc_set_phase_outputs(BLDC6StepPwmScheme_t scheme, uint8_t step, float pwm_duty) {
+  if (scheme >= NUM_BLDC6STEP_PWM_SCHEMES || step >= NUM_COMMUTATION_STEPS) {
+    hal_pwm_set_gates(HAL_GATES_FLOAT, 0.0f);
+    return;
   }
 
-  /* Phase C */
-  if (commutation[PHASE_C_HIGH_COMMUTATION_IDX] == 1U) {
-    hal_pwm_set_duty(MOTOR_PHASE_C, pwm_duty);
-  } else if (commutation[PHASE_C_LOW_COMMUTATION_IDX] == 1U) {
-    hal_gpio_set_phase_low(MOTOR_PHASE_C);
-  } else {
-    hal_gpio_set_phase_float(MOTOR_PHASE_C);
-  }
+  hal_pwm_set_gates(bldc_6step_commutation_table[scheme][step], pwm_duty);
 }
 
 MotorPhase_t _6step_bldc_determine_floating_phase(uint8_t step) {
@@ -99,11 +117,85 @@ float _6step_bldc_get_conducting_current(struct Motor_t *motor, uint8_t step) {
   return (count > 0) ? (sum / (float)count) : 0.0f;
 }
 
+void _6step_bldc_speed_estimator_reset(struct BLDC6StepSpeedEstimator_t *estimator) {
+  for (uint8_t i = 0U; i < BLDC6STEP_SPEED_WINDOW; i++) {
+    estimator->periods[i] = 0U;
+  }
+
+  estimator->period_sum = 0U;
+  estimator->index = 0U;
+  estimator->count = 0U;
+  estimator->is_updated = false;
+}
+
+float _6step_bldc_speed_estimator_push(struct BLDC6StepSpeedEstimator_t *estimator, uint32_t period_us) {
+  /* Running sum keeps the moving average O(1) per commutation */
+  estimator->period_sum -= estimator->periods[estimator->index];
+  estimator->periods[estimator->index] = period_us;
+  estimator->period_sum += period_us;
+  estimator->index = (uint8_t)((estimator->index + 1U) % BLDC6STEP_SPEED_WINDOW);
+
+  if (estimator->count < BLDC6STEP_SPEED_WINDOW) {
+    estimator->count++;
+  }
+
+  estimator->is_updated = true;
+
+  if (estimator->period_sum == 0U) {
+    return 0.0f;
+  }
+
+  /* RPM = 60e6 / (6 * average period), and the average period is period_sum / count */
+  return (BLDC6STEP_RPM_PERIOD_PRODUCT * (float)estimator->count) / (float)estimator->period_sum;
+}
+
+int32_t _6step_bldc_position_to_steps(float position, uint8_t pole_pairs) {
+  float pairs = (pole_pairs > 0U) ? (float)pole_pairs : 1.0f;
+
+  return (int32_t)lroundf(position * pairs / MATH_PI_OVER_3);
+}
+
+float _6step_bldc_steps_to_position(int32_t steps, uint8_t pole_pairs) {
+  float pairs = (pole_pairs > 0U) ? (float)pole_pairs : 1.0f;
+
+  return (float)steps * MATH_PI_OVER_3 / pairs;
+}
+
+void _6step_bldc_position_profile_reset(struct BLDC6StepPositionProfile_t *profile, int32_t steps) {
+  profile->target = steps;
+  profile->position = (float)steps;
+  profile->velocity = 0.0f;
+}
+
+float _6step_bldc_position_profile_update(struct BLDC6StepPositionProfile_t *profile, const struct BLDC6StepPositionConfig_t *config,
+                                          float delta_time) {
+  float cruise_velocity = config->cruise_velocity / BLDC6STEP_RPM_PER_STEP_RATE;
+  float acceleration = config->acceleration / BLDC6STEP_RPM_PER_STEP_RATE;
+  float remaining = (float)profile->target - profile->position;
+
+  if (cruise_velocity <= 0.0f || acceleration <= 0.0f) {
+    _6step_bldc_position_profile_reset(profile, profile->target);
+    return 0.0f;
+  }
+
+  /* v^2 = 2 * a * d gives the fastest speed that can still brake to rest at the target */
+  float velocity_target = copysignf(fminf(cruise_velocity, sqrtf(2.0f * acceleration * fabsf(remaining))), remaining);
+  float velocity_change = acceleration * delta_time;
+
+  profile->velocity += clamp(velocity_target - profile->velocity, -velocity_change, velocity_change);
+
+  float travel = profile->velocity * delta_time;
+
+  if (travel * remaining > 0.0f && fabsf(travel) >= fabsf(remaining)) {
+    /* Arrives within this period, land on the target at rest */
+    _6step_bldc_position_profile_reset(profile, profile->target);
+    return 0.0f;
+  }
+
+  profile->position += travel;
+  return profile->velocity * BLDC6STEP_RPM_PER_STEP_RATE;
+}
+
 void _6step_bldc_stop_pwm_output() {
-  hal_pwm_set_duty(MOTOR_PHASE_A, 0U);
-  hal_pwm_set_duty(MOTOR_PHASE_B, 0U);
-  hal_pwm_set_duty(MOTOR_PHASE_C, 0U);
-  hal_gpio_set_phase_float(MOTOR_PHASE_A);
-  hal_gpio_set_phase_float(MOTOR_PHASE_B);
-  hal_gpio_set_phase_float(MOTOR_PHASE_C);
+  hal_pwm_set_gates(HAL_GATES_FLOAT, 0.0f);
 }
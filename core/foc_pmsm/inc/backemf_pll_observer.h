@@ -16,6 +16,7 @@
 /* Inter-component Headers */
 
 /* Intra-component Headers */
+#include "foc_observer.h"
 #include "motor_error.h"
 #include "pll.h"
 
@@ -49,31 +50,33 @@ struct BackEMFPLLData_t {
     float bemf_alpha;          /**< Alpha-axis back-EMF [V] */
     float bemf_beta;           /**< Beta-axis back-EMF [V] */
     float bemf_magnitude;      /**< Back-EMF magnitude [V] */
+    float prev_i_alpha;        /**< Alpha-axis current of the previous update, for the inductive drop [A] */
+    float prev_i_beta;         /**< Beta-axis current of the previous update, for the inductive drop [A] */
     
     float position_radians;
     float angular_velocity;
 
     /* Status flags */
     bool is_initialized;       /**< Initialization status */
+    bool has_prev_current;     /**< prev_i_alpha/prev_i_beta hold a sample */
 
     /* Statistics/debugging */
     uint32_t update_count;     /**< Update cycle counter */
-    uint32_t last_pll_estimate_time;
 };
 
 /**
  * @brief Create and initialize a Back-EMF PLL observer driver
  * 
- * This function sets up the observer driver function pointers and allocates
- * the internal state structure with default configuration.
+ * This function sets up the observer driver function pointers and points the
+ * observer at the static internal state structure. The driver init function
+ * must run before the first update.
  * 
  * @param[in,out] observer Pointer to FOC observer structure
- * @param[in] config       Pointer to configuration parameters (NULL for defaults)
+ * @param[in] config       Pointer to configuration parameters, kept by reference
  * 
  * @return MotorError_t
- * @retval MOTOR_ERROR_NONE           Success
- * @retval MOTOR_ERROR_NULL_POINTER   Invalid observer pointer
- * @retval MOTOR_ERROR_INIT_FAILED    Initialization failed
+ * @retval MOTOR_OK                   Success
+ * @retval MOTOR_INVALID_ARGS         Invalid observer or config pointer
  */
 MotorError_t foc_observer_backemf_pll_create_driver(struct FOCObserver_t *observer, struct BackEMFPLLConfig_t *config);
 
@@ -81,14 +84,14 @@ MotorError_t foc_observer_backemf_pll_create_driver(struct FOCObserver_t *observ
  * @brief Get observer status and statistics
  * 
  * @param[in] observer     Pointer to FOC observer structure
- * @param[out] is_converged Convergence status flag
+ * @param[out] is_converged PLL locked to the back-EMF above min_speed
  * @param[out] update_count Number of updates performed
  * @param[out] max_error   Maximum phase error observed
  * 
  * @return MotorError_t
- * @retval MOTOR_ERROR_NONE           Success
- * @retval MOTOR_ERROR_NULL_POINTER   Invalid pointer
- * @retval MOTOR_ERROR_NOT_INITIALIZED Observer not initialized
+ * @retval MOTOR_OK                   Success
+ * @retval MOTOR_INVALID_ARGS         Invalid pointer
+ * @retval MOTOR_UNINITIALIZED        Observer not initialized
  */
 MotorError_t foc_observer_backemf_pll_get_status(const struct FOCObserver_t *observer,
                                                  bool *is_converged,
@@ -104,13 +107,32 @@ MotorError_t foc_observer_backemf_pll_get_status(const struct FOCObserver_t *obs
  * @param[out] bemf_mag   Back-EMF magnitude [V]
  * 
  * @return MotorError_t
- * @retval MOTOR_ERROR_NONE           Success
- * @retval MOTOR_ERROR_NULL_POINTER   Invalid pointer
- * @retval MOTOR_ERROR_NOT_INITIALIZED Observer not initialized
+ * @retval MOTOR_OK                   Success
+ * @retval MOTOR_INVALID_ARGS         Invalid pointer
+ * @retval MOTOR_UNINITIALIZED        Observer not initialized
  */
 MotorError_t foc_observer_backemf_pll_get_bemf(const struct FOCObserver_t *observer,
                                                float *bemf_alpha,
                                                float *bemf_beta, 
                                                float *bemf_mag);
 
+/**
+ * @brief Restart the PLL from a known angle and speed
+ * 
+ * The PLL takes the direction of rotation from the sign of its own speed, so
+ * starting it from zero speed lets it settle on a reversed estimate. Seeding it
+ * with an open-loop startup angle and speed gives it the commanded direction.
+ * The convergence status is cleared.
+ * 
+ * @param[in,out] observer Pointer to FOC observer structure
+ * @param[in] theta        Electrical angle to start from [rad]
+ * @param[in] omega        Electrical speed to start from [rad/s]
+ * 
+ * @return MotorError_t
+ * @retval MOTOR_OK                   Success
+ * @retval MOTOR_INVALID_ARGS         Invalid pointer
+ * @retval MOTOR_UNINITIALIZED        Observer not initialized
+ */
+MotorError_t foc_observer_backemf_pll_seed(struct FOCObserver_t *observer, float theta, float omega);
+
 /** @} */
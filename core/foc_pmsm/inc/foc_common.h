@@ -22,12 +22,33 @@
  * @{
  */
 
+/**
+ * D axis - Flux enhancing vector
+ */
+#define FOC_PID_DEFAULT_D_KP (2.0f)
+#define FOC_PID_DEFAULT_D_KI (500.0f)
+#define FOC_PID_DEFAULT_D_KD (0.0f)
+#define FOC_PID_DEFAULT_D_OUTPUT_MAX (24.0f)  /**< Volts */
+#define FOC_PID_DEFAULT_D_OUTPUT_MIN (-24.0f) /**< Volts */
+#define FOC_PID_DEFAULT_D_DERIV_EMA_ALPHA (0.1f)
+
+/**
+ * Q axis - Torque producing vector
+ */
+#define FOC_PID_DEFAULT_Q_KP (2.0f)
+#define FOC_PID_DEFAULT_Q_KI (500.0f)
+#define FOC_PID_DEFAULT_Q_KD (0.0f)
+#define FOC_PID_DEFAULT_Q_OUTPUT_MAX (24.0f)  /**< Volts */
+#define FOC_PID_DEFAULT_Q_OUTPUT_MIN (-24.0f) /**< Volts */
+#define FOC_PID_DEFAULT_Q_DERIV_EMA_ALPHA (0.1f)
+
 /**
  * @brief   Motor mode definitions
  */
 typedef enum {
   MOTOR_MODE_IDLE,       /**< Motor is in idle state (Just initialized) */
   MOTOR_MODE_STOPPED,    /**< Motor is stopped */
+  MOTOR_MODE_CATCHING,   /**< Bridge off, measuring the Back-EMF of a spinning rotor (flying start) */
   MOTOR_MODE_ALIGNING,   /**< Initial rotor alignment phase */
   MOTOR_MODE_OPEN_LOOP,  /**< Open-loop startup sequence */
   MOTOR_MODE_TRANSITION, /**< Transition from open to closed loop */
@@ -38,28 +38,28 @@ struct FieldWeakeningConfig_t {
  */
 struct FieldWeakeningState_t {
   float id_ref;           /**< Current d-axis reference generated by field weakening */
-  struct FieldWeakeningConfig_t *config; /**< Config settings */
+  const struct FieldWeakeningConfig_t *config; /**< Config settings */
 };
 
 /**
  * @brief   Initialize field weakening system
  * @param   state Pointer to field weakening state structure
+ * @param   config Pointer to config parameters
  * @return  MOTOR_OK if successful
- *          MOTOR_INVALID_ARGS if state pointer is null
+ *          MOTOR_INVALID_ARGS if state or config pointers are null
  */
-MotorError_t field_weakening_init(struct FieldWeakeningState_t *state);
+MotorError_t field_weakening_init(struct FieldWeakeningState_t *state, const struct FieldWeakeningConfig_t *config);
 
 /**
  * @brief   Field weakening update function (core logic)
  * 
  * @param   state Pointer to state object
- * @param   config Pointer to config parameters
  * @param   vd Current d-axis voltage output from PID
  * @param   vq Current q-axis voltage output from PID
  * @param   vbus Measured DC bus voltage
  * @return  MOTOR_OK if successful
- *          MOTOR_INVALID_ARGS if state or config pointers are null
+ *          MOTOR_INVALID_ARGS if state pointer is null
  */
-MotorError_t field_weakening_update(struct FieldWeakeningState_t *state, const struct FieldWeakeningConfig_t *config, float vd, float vq, float vbus);
+MotorError_t field_weakening_update(struct FieldWeakeningState_t *state, float vd, float vq, float vbus);
 
 /** @} */
@@ -30,6 +30,7 @@ typedef enum {
   OBSERVER_TYPE_BACKEMF_PLL,
   OBSERVER_TYPE_SMO,
   OBSERVER_TYPE_EKF,
+  OBSERVER_TYPE_HFI,
   /* TOOD: Add more observers */
 } FOCObserverType_t;
 
@@ -14,6 +14,7 @@
 #include <stdint.h>
 
 /* Inter-component Headers */
+#include "hall_estimator.h"
 
 /* Intra-component Headers */
 #include "foc_common.h"
@@ -27,24 +28,29 @@
  */
 
 /**
- * D axis - Flux enhancing vector
+ * Hall position source
  */
-#define FOC_PID_DEFAULT_D_KP (2.0f)
-#define FOC_PID_DEFAULT_D_KI (500.0f)
-#define FOC_PID_DEFAULT_D_KD (0.0f)
-#define FOC_PID_DEFAULT_D_OUTPUT_MAX (24.0f)  /**< Volts */
-#define FOC_PID_DEFAULT_D_OUTPUT_MIN (-24.0f) /**< Volts */
-#define FOC_PID_DEFAULT_D_DERIV_EMA_ALPHA (0.1f)
+#define FOC_HALL_DEFAULT_ANGLE_OFFSET (0.0f)      /**< Electrical angle at the start of Hall sector 0 [rad] */
+#define FOC_HALL_DEFAULT_STALE_TIMEOUT_US 100000U /**< No Hall edge for this long means the rotor is stopped [us] */
+#define FOC_HALL_DEFAULT_MAX_INVALID_READS 3U     /**< Consecutive illegal Hall states before the driver faults */
 
 /**
- * Q axis - Torque producing vector
+ * @brief   Rotor position feedback sources
  */
-#define FOC_PID_DEFAULT_Q_KP (2.0f)
-#define FOC_PID_DEFAULT_Q_KI (500.0f)
-#define FOC_PID_DEFAULT_Q_KD (0.0f)
-#define FOC_PID_DEFAULT_Q_OUTPUT_MAX (24.0f)  /**< Volts */
-#define FOC_PID_DEFAULT_Q_OUTPUT_MIN (-24.0f) /**< Volts */
-#define FOC_PID_DEFAULT_Q_DERIV_EMA_ALPHA (0.1f)
+typedef enum {
+  FOC_POSITION_SOURCE_ENCODER, /**< Absolute/incremental encoder */
+  FOC_POSITION_SOURCE_HALL,    /**< Digital Hall sensors with angle interpolation */
+} FOCPositionSource_t;
+
+/**
+ * @brief   Sensored FOC configuration kept out of the MOTOR_HOT_DATA block
+ * @details The d/q controllers copy their gains at init and the Hall estimator keeps a pointer to its configuration
+ */
+struct FOCSensoredColdConfig_t {
+  struct PidConfig_t current_d_pid_config;            /**< D-axis current PID Configuration */
+  struct PidConfig_t current_q_pid_config;            /**< Q-axis current PID Configuration */
+  struct HallEstimatorConfig_t hall_estimator_config; /**< Hall estimator configuration */
+};
 
 struct FOCSensoredData_t {
   float electrical_angle; /**< Electrical angle [rad] */
@@ -52,15 +58,18 @@ struct FOCSensoredData_t {
   float iq;               /**< Q-axis current [A] */
   float vd;               /**< D-axis voltage command */
   float vq;               /**< Q-axis voltage command */
+  float v_alpha;          /**< Alpha-axis voltage applied until the next control period [V] */
+  float v_beta;           /**< Beta-axis voltage applied until the next control period [V] */
 
-  struct PidConfig_t current_d_pid_config; /**< D-axis current PID Configuration */
-  struct PidConfig_t current_q_pid_config; /**< Q-axis current PID Configuration */
-  struct PidController_t current_d;        /**< D-axis current PID controller */
-  struct PidController_t current_q;        /**< Q-axis current PID controller */
+  struct PidController_t current_d; /**< D-axis current PID controller */
+  struct PidController_t current_q; /**< Q-axis current PID controller */
 
   struct FieldWeakeningConfig_t field_weakening_config;
   struct FieldWeakeningState_t field_weakening_state;
 
+  FOCPositionSource_t position_source;        /**< Rotor position feedback source */
+  struct HallEstimatorState_t hall_estimator; /**< Hall estimator state */
+
   FOCMotorMode_t mode;
 };
 
@@ -71,4 +80,19 @@ struct FOCSensoredData_t {
  */
 void foc_sensored_create_driver(struct Motor_t *motor);
 
+/**
+ * @brief   Selects the rotor position feedback used by the sensored FOC driver
+ * @details Must be called before the driver init function. Defaults to FOC_POSITION_SOURCE_ENCODER
+ * @param   source Position source to use
+ */
+void foc_sensored_set_position_source(FOCPositionSource_t source);
+
+/**
+ * @brief   Sets the Hall estimator configuration of the sensored FOC driver
+ * @details Must be called before the driver init function. The angle offset places the rotor flux (d-axis) at the
+ *          start of Hall sector 0. Defaults to FOC_HALL_DEFAULT_*
+ * @param   config Pointer to the estimator configuration to copy
+ */
+void foc_sensored_set_hall_config(const struct HallEstimatorConfig_t *config);
+
 /** @} */
@@ -0,0 +1,194 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   foc_sensorless.h
+ *
+ * @brief  Header file for the sensorless FOC driver
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "backemf_pll_observer.h"
+#include "foc_common.h"
+#include "foc_field_weakening.h"
+#include "foc_observer.h"
+#include "hfi_observer.h"
+#include "motor.h"
+
+/**
+ * @defgroup FOC_PMSMMotor FOC control motor class
+ * @brief    PMSM FOC control motor class
+ * @{
+ */
+
+/**
+ * Back-EMF PLL observer
+ */
+#define FOC_SENSORLESS_DEFAULT_PLL_KP (600.0f)           /**< Speed correction per radian of angle error [rad/s] */
+#define FOC_SENSORLESS_DEFAULT_PLL_KI (90000.0f)         /**< Critically damped with the proportional gain at 300 rad/s [rad/s^2] */
+#define FOC_SENSORLESS_DEFAULT_PLL_MAX_OMEGA (10000.0f)  /**< Electrical speed limit of the PLL [rad/s] */
+#define FOC_SENSORLESS_DEFAULT_OBSERVER_MIN_SPEED (50.0f) /**< Electrical speed below which a lock is not trusted [rad/s] */
+
+/**
+ * High-frequency injection observer
+ */
+#define FOC_SENSORLESS_DEFAULT_HFI_PLL_KP (300.0f)            /**< Speed correction per radian of angle error [rad/s] */
+#define FOC_SENSORLESS_DEFAULT_HFI_PLL_KI (22500.0f)          /**< Critically damped with the proportional gain at 150 rad/s [rad/s^2] */
+#define FOC_SENSORLESS_DEFAULT_HFI_INJECTION_VOLTAGE (5.0f)   /**< Amplitude of the injected square wave [V] */
+#define FOC_SENSORLESS_DEFAULT_HFI_CROSSOVER_LOW (100.0f)     /**< Electrical speed the back-EMF observer starts blending in at [rad/s] */
+#define FOC_SENSORLESS_DEFAULT_HFI_CROSSOVER_HIGH (200.0f)    /**< Electrical speed from which the injection stops [rad/s] */
+
+/**
+ * I/f startup
+ */
+#define FOC_SENSORLESS_DEFAULT_ALIGN_CURRENT (2.0f)               /**< D-axis current holding the rotor during alignment [A] */
+#define FOC_SENSORLESS_DEFAULT_ALIGN_TIME_US (200000U)            /**< Alignment duration [us] */
+#define FOC_SENSORLESS_DEFAULT_RAMP_CURRENT (3.0f)                /**< Amplitude of the rotating current vector [A] */
+#define FOC_SENSORLESS_DEFAULT_RAMP_ACCELERATION (2000.0f)        /**< Electrical acceleration of the forced angle [rad/s^2] */
+#define FOC_SENSORLESS_DEFAULT_RAMP_FINAL_SPEED (300.0f)          /**< Electrical speed the forced angle settles at [rad/s] */
+#define FOC_SENSORLESS_DEFAULT_LOCK_WINDOW_US (20000U)            /**< Time the observer must stay converged before the handover [us] */
+#define FOC_SENSORLESS_DEFAULT_BLEND_TIME_US (20000U)             /**< Time the angle takes to move from the forced to the observer angle [us] */
+#define FOC_SENSORLESS_DEFAULT_TRANSITION_TIMEOUT_US (1000000U)   /**< Time allowed from the start of the ramp to the observer lock [us] */
+
+/**
+ * Flying start
+ */
+#define FOC_SENSORLESS_DEFAULT_CATCH_TIME_US (2000U) /**< Time the bridge floats while the back-EMF is measured [us] */
+#define FOC_SENSORLESS_DEFAULT_CATCH_MIN_BEMF (0.5f) /**< Back-EMF amplitude below which the rotor is taken as standing [V] */
+
+/**
+ * @brief   I/f open-loop startup configuration
+ * @details The rotor is pulled onto the d-axis of the forced angle, then a current vector of ramp_current is rotated
+ *          ahead of it at a speed rising by ramp_acceleration up to ramp_final_speed. The rotor lags the vector by
+ *          whatever load angle its torque needs. Once the observer has reported convergence for lock_window_us, the
+ *          control angle is blended from the forced angle to the observer angle over blend_time_us and the driver
+ *          runs closed-loop. A negative ramp_final_speed starts the motor in reverse
+ */
+struct FOCSensorlessStartupConfig_t {
+  float align_current;            /**< D-axis current holding the rotor during alignment, ramped up over the first half [A] */
+  uint32_t align_time_us;         /**< Alignment duration [us] */
+  float ramp_current;             /**< Amplitude of the rotating current vector [A] */
+  float ramp_acceleration;        /**< Electrical acceleration of the forced angle [rad/s^2] */
+  float ramp_final_speed;         /**< Signed electrical speed the forced angle settles at [rad/s] */
+  uint32_t lock_window_us;        /**< Time the observer must stay converged before the handover [us] */
+  uint32_t blend_time_us;         /**< Time the angle takes to move from the forced to the observer angle [us] */
+  uint32_t transition_timeout_us; /**< Time allowed from the start of the ramp to the observer lock before reporting a stall [us] */
+};
+
+/**
+ * @brief   Flying start configuration
+ * @details With the bridge off the terminal voltages are the back-EMF, leading the rotor flux by 90 degrees. Its angle is
+ *          tracked for catch_time_us to measure the speed. A rotor turning faster than the observer min_speed has the
+ *          observer seeded with its angle and speed, and the driver runs closed-loop straight away with the current
+ *          loops preset to the back-EMF, so the bridge reconnects without a current step. Otherwise, or as soon as the
+ *          back-EMF drops below min_bemf, the I/f startup runs
+ */
+struct FOCSensorlessFlyingStartConfig_t {
+  bool enabled;           /**< Look for a spinning rotor before the I/f startup */
+  uint32_t catch_time_us; /**< Time the bridge floats while the back-EMF is measured [us] */
+  float min_bemf;         /**< Back-EMF amplitude below which the rotor is taken as standing [V] */
+};
+
+/**
+ * @brief   Sensorless FOC configuration outside closed-loop control
+ * @details Kept out of FOCSensorlessData_t so it does not take up the MOTOR_HOT_DATA block. The d/q controllers copy
+ *          their gains at init
+ */
+struct FOCSensorlessColdConfig_t {
+  struct PidConfig_t current_d_pid_config;                     /**< D-axis current PID Configuration, output limits follow the bus voltage */
+  struct PidConfig_t current_q_pid_config;                     /**< Q-axis current PID Configuration, output limits follow the bus voltage */
+  struct FOCSensorlessStartupConfig_t startup_config;          /**< I/f open-loop startup configuration */
+  struct FOCSensorlessFlyingStartConfig_t flying_start_config; /**< Flying start configuration */
+};
+
+struct FOCSensorlessData_t {
+  float electrical_angle;    /**< Estimated electrical angle of the rotor flux (d-axis) [rad] */
+  float electrical_velocity; /**< Estimated electrical speed [rad/s] */
+  float i_alpha;             /**< Alpha-axis current [A] */
+  float i_beta;              /**< Beta-axis current [A] */
+  float id;                  /**< D-axis current [A] */
+  float iq;                  /**< Q-axis current [A] */
+  float vd;                  /**< D-axis voltage command [V] */
+  float vq;                  /**< Q-axis voltage command [V] */
+  float v_alpha;             /**< Alpha-axis voltage applied until the next control period [V] */
+  float v_beta;              /**< Beta-axis voltage applied until the next control period [V] */
+
+  struct FOCSensorlessColdConfig_t *cold; /**< Current PID, startup and flying start configuration */
+  struct PidController_t current_d;       /**< D-axis current PID controller */
+  struct PidController_t current_q;       /**< Q-axis current PID controller */
+
+  struct FieldWeakeningConfig_t field_weakening_config;
+  struct FieldWeakeningState_t field_weakening_state;
+
+  struct FOCObserver_t observer;                /**< Rotor angle and speed observer */
+  struct BackEMFPLLConfig_t backemf_pll_config; /**< Back-EMF PLL observer configuration */
+  struct HFIObserverConfig_t hfi_config;        /**< High-frequency injection observer configuration */
+
+  float forced_angle;         /**< Angle of the rotating current vector during startup [rad] */
+  float forced_velocity;      /**< Electrical speed of the rotating current vector [rad/s] */
+  uint32_t startup_mode_time; /**< Timestamp the current startup mode was entered [us] */
+  uint32_t lock_start_time;   /**< Timestamp the observer started reporting convergence [us] */
+  bool is_observer_locked;    /**< The observer has reported convergence since lock_start_time */
+
+  float catch_bemf_angle; /**< Back-EMF angle of the previous catch sample [rad] */
+  float catch_travel;     /**< Back-EMF angle travelled since the first catch sample [rad] */
+  bool has_catch_sample;  /**< catch_bemf_angle holds a sample */
+
+  FOCMotorMode_t mode;
+};
+
+/**
+ * @brief   Initializes and registers the sensorless FOC driver functions
+ *          into the provided Motor_t structure
+ * @details The observer replaces the position sensor. Every control period it is fed the αβ voltage applied over the
+ *          previous period and the measured αβ currents, and its angle and speed drive the Park transforms and the speed
+ *          loop once the I/f startup has handed over. An observer type without an implementation makes the driver init
+ *          function return MOTOR_INIT_ERROR
+ * @param   motor Pointer to the Motor_t structure to be populated
+ * @param   observer_type Rotor angle observer to use
+ */
+void foc_sensorless_create_driver(struct Motor_t *motor, FOCObserverType_t observer_type);
+
+/**
+ * @brief   Sets the back-EMF PLL observer configuration of the sensorless FOC driver
+ * @details Must be called before the driver init function. Rs and Ls are replaced with the MotorConfig_t phase
+ *          resistance and inductance by init. Speeds are electrical
+ * @param   config Pointer to the observer configuration to copy
+ */
+void foc_sensorless_set_backemf_pll_config(const struct BackEMFPLLConfig_t *config);
+
+/**
+ * @brief   Sets the high-frequency injection observer configuration of the sensorless FOC driver
+ * @details Must be called before the driver init function. Ld and Lq have no default and init fails until they are set
+ *          to different values. The back-EMF PLL observer configuration applies to the observer it blends into. With
+ *          this observer the I/f startup ends after the alignment, which gives the injection its polarity, and the
+ *          driver runs closed-loop from standstill
+ * @param   config Pointer to the observer configuration to copy
+ */
+void foc_sensorless_set_hfi_config(const struct HFIObserverConfig_t *config);
+
+/**
+ * @brief   Sets the I/f open-loop startup used by the sensorless FOC driver
+ * @details Startup is advanced by motor_run() after init returns and the control mode only takes over once it ends.
+ *          It must be configured before init is called
+ * @param   config Pointer to the startup configuration to copy
+ */
+void foc_sensorless_set_startup_config(const struct FOCSensorlessStartupConfig_t *config);
+
+/**
+ * @brief   Sets the flying start used by the sensorless FOC driver
+ * @details Disabled by default. When enabled, init floats the bridge and measures the back-EMF before deciding between
+ *          closed-loop operation and the I/f startup. It must be configured before init is called
+ * @param   config Pointer to the flying start configuration to copy
+ */
+void foc_sensorless_set_flying_start_config(const struct FOCSensorlessFlyingStartConfig_t *config);
+
+/** @} */
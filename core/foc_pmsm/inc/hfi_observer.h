@@ -0,0 +1,168 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   hfi_observer.h
+ *
+ * @brief  Header file for FOC high-frequency injection observer
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "backemf_pll_observer.h"
+#include "foc_observer.h"
+#include "motor_error.h"
+#include "pll.h"
+
+/**
+ * @defgroup FOC_Observers FOC observers
+ * @brief    FOC observers
+ * @{
+ */
+
+/**
+ * @brief High-frequency injection observer configuration parameters
+ */
+struct HFIObserverConfig_t {
+    struct PLLConfig_t pll_cfg; /**< PLL Config of the injection angle tracker */
+    float injection_voltage;    /**< Amplitude of the square wave injected along the estimated d-axis [V] */
+    float Ld;                   /**< D-axis inductance [H] */
+    float Lq;                   /**< Q-axis inductance [H], must differ from Ld */
+    float crossover_low;        /**< Electrical speed the back-EMF observer starts blending in at [rad/s] */
+    float crossover_high;       /**< Electrical speed from which only the back-EMF observer is used and injection stops [rad/s] */
+};
+
+/**
+ * @brief High-frequency injection observer internal state
+ */
+struct HFIObserverData_t {
+    struct PLLState_t pll_state;
+    struct HFIObserverConfig_t *config;  /**< Configuration parameters */
+
+    struct FOCObserver_t backemf_observer; /**< Back-EMF PLL observer taking over above the crossover */
+
+    /* Carrier */
+    float injection_alpha;     /**< Alpha-axis injection voltage applied until the next update [V] */
+    float injection_beta;      /**< Beta-axis injection voltage applied until the next update [V] */
+    float carrier_pulse;       /**< Pulse applied until the next update, in injection_voltage */
+    float prev_carrier_pulse;  /**< Pulse applied over the previous period, in injection_voltage */
+    float carrier_level;       /**< Ripple the pulses leave on the current once applied, -0.5, 0 or 0.5 of a full pulse response */
+    float prev_i_alpha;        /**< Alpha-axis current of the previous update [A] */
+    float prev_i_beta;         /**< Beta-axis current of the previous update [A] */
+    float prev_di_alpha;       /**< Alpha-axis current change over the previous period [A] */
+    float prev_di_beta;        /**< Beta-axis current change over the previous period [A] */
+    float fundamental_alpha;   /**< Alpha-axis current with the carrier ripple removed [A] */
+    float fundamental_beta;    /**< Beta-axis current with the carrier ripple removed [A] */
+
+    /* Blending */
+    float hfi_theta;           /**< Angle of the injection tracker [rad] */
+    float hfi_omega;           /**< Speed of the injection tracker, its PLL integrator [rad/s] */
+    float filtered_omega;      /**< Low-passed tracker speed the blend weight follows [rad/s] */
+    float blend;               /**< Weight of the back-EMF observer in the output, 0 to 1 */
+
+    /* Status flags */
+    bool is_initialized;       /**< Initialization status */
+    bool has_prev_current;     /**< prev_i_alpha/prev_i_beta hold a sample */
+    bool has_prev_delta;       /**< prev_di_alpha/prev_di_beta hold a current change */
+
+    /* Statistics/debugging */
+    uint32_t update_count;     /**< Update cycle counter */
+};
+
+/**
+ * @brief Create and initialize a high-frequency injection observer driver
+ *
+ * A pulsating square wave of injection_voltage is added along the estimated
+ * d-axis, alternating sign every update. It starts and stops with a half pulse,
+ * so the current ripple stays centred on the fundamental. On a rotor with
+ * Ld != Lq the current it produces leans towards the q-axis in proportion to
+ * sin(2 * angle error), which a PLL drives to zero. A back-EMF PLL observer runs alongside on the
+ * voltage and current with the carrier removed, and its estimate is blended in
+ * between crossover_low and crossover_high. Above the band the injection stops.
+ * The estimate is ambiguous by 180 degrees, the caller seeds it with a known
+ * polarity. The back-EMF observer uses the static instance of its own driver.
+ *
+ * @param[in,out] observer   Pointer to FOC observer structure
+ * @param[in] config         Pointer to configuration parameters, kept by reference
+ * @param[in] backemf_config Pointer to the back-EMF PLL observer configuration, kept by reference
+ *
+ * @return MotorError_t
+ * @retval MOTOR_OK                   Success
+ * @retval MOTOR_INVALID_ARGS         Invalid observer or config pointer
+ */
+MotorError_t foc_observer_hfi_create_driver(struct FOCObserver_t *observer, struct HFIObserverConfig_t *config,
+                                            struct BackEMFPLLConfig_t *backemf_config);
+
+/**
+ * @brief Get the injection voltage to add to the output until the next update
+ *
+ * The observer update expects the voltage it is fed to include it.
+ *
+ * @param[in] observer Pointer to FOC observer structure
+ * @param[out] v_alpha Alpha-axis injection voltage [V]
+ * @param[out] v_beta  Beta-axis injection voltage [V]
+ *
+ * @return MotorError_t
+ * @retval MOTOR_OK                   Success
+ * @retval MOTOR_INVALID_ARGS         Invalid pointer
+ * @retval MOTOR_UNINITIALIZED        Observer not initialized
+ */
+MotorError_t foc_observer_hfi_get_injection(const struct FOCObserver_t *observer, float *v_alpha, float *v_beta);
+
+/**
+ * @brief Get the measured current with the carrier ripple removed
+ *
+ * The mean of the last two samples, which the square wave moves by equal and
+ * opposite amounts, less the d-axis response of a half pulse when the carrier
+ * starts or stops. Feeding it to the current loops keeps them from working
+ * against the injection.
+ *
+ * @param[in] observer Pointer to FOC observer structure
+ * @param[out] i_alpha Alpha-axis current [A]
+ * @param[out] i_beta  Beta-axis current [A]
+ *
+ * @return MotorError_t
+ * @retval MOTOR_OK                   Success
+ * @retval MOTOR_INVALID_ARGS         Invalid pointer
+ * @retval MOTOR_UNINITIALIZED        Observer not initialized
+ */
+MotorError_t foc_observer_hfi_get_fundamental_current(const struct FOCObserver_t *observer, float *i_alpha, float *i_beta);
+
+/**
+ * @brief Get the weight of the back-EMF observer in the estimate
+ *
+ * @param[in] observer Pointer to FOC observer structure
+ * @param[out] blend   0 below crossover_low, 1 above crossover_high
+ *
+ * @return MotorError_t
+ * @retval MOTOR_OK                   Success
+ * @retval MOTOR_INVALID_ARGS         Invalid pointer
+ * @retval MOTOR_UNINITIALIZED        Observer not initialized
+ */
+MotorError_t foc_observer_hfi_get_blend(const struct FOCObserver_t *observer, float *blend);
+
+/**
+ * @brief Restart both trackers from a known angle and speed
+ *
+ * The injection only resolves the d-axis up to its direction, so the polarity
+ * has to come from elsewhere, such as an alignment.
+ *
+ * @param[in,out] observer Pointer to FOC observer structure
+ * @param[in] theta        Electrical angle of the rotor flux to start from [rad]
+ * @param[in] omega        Electrical speed to start from [rad/s]
+ *
+ * @return MotorError_t
+ * @retval MOTOR_OK                   Success
+ * @retval MOTOR_INVALID_ARGS         Invalid pointer
+ * @retval MOTOR_UNINITIALIZED        Observer not initialized
+ */
+MotorError_t foc_observer_hfi_seed(struct FOCObserver_t *observer, float theta, float omega);
+
+/** @} */
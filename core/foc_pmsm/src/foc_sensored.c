@@ -14,6 +14,7 @@
 /* Inter-component Headers */
 #include "foc_common.h"
 #include "hal.h"
+#include "hall_estimator.h"
 #include "math_utils.h"
 #include "transform_utils.h"
 #include "svpwm.h"
@@ -25,31 +26,41 @@
  * Private Data Structure
  *******************************************************************************************************************************/
 
-static struct FOCSensoredData_t s_foc_data = {
+static struct FOCSensoredColdConfig_t s_foc_cold = {
   .current_d_pid_config = {
-    .kd                   = FOC_PID_DEFAULT_D_KP,
+    .kp                   = FOC_PID_DEFAULT_D_KP,
     .ki                   = FOC_PID_DEFAULT_D_KI,
-    .kp                   = FOC_PID_DEFAULT_D_KD,
+    .kd                   = FOC_PID_DEFAULT_D_KD,
     .output_max           = FOC_PID_DEFAULT_D_OUTPUT_MAX,
     .output_min           = FOC_PID_DEFAULT_D_OUTPUT_MIN,
     .derivative_ema_alpha = FOC_PID_DEFAULT_D_DERIV_EMA_ALPHA,
   },
 
   .current_q_pid_config = {
-    .kd                   = FOC_PID_DEFAULT_Q_KP,
+    .kp                   = FOC_PID_DEFAULT_Q_KP,
     .ki                   = FOC_PID_DEFAULT_Q_KI,
-    .kp                   = FOC_PID_DEFAULT_Q_KD,
+    .kd                   = FOC_PID_DEFAULT_Q_KD,
     .output_max           = FOC_PID_DEFAULT_Q_OUTPUT_MAX,
     .output_min           = FOC_PID_DEFAULT_Q_OUTPUT_MIN,
     .derivative_ema_alpha = FOC_PID_DEFAULT_Q_DERIV_EMA_ALPHA,
   },
 
+  .hall_estimator_config = {
+    .angle_offset      = FOC_HALL_DEFAULT_ANGLE_OFFSET,
+    .stale_timeout_us  = FOC_HALL_DEFAULT_STALE_TIMEOUT_US,
+    .max_invalid_reads = FOC_HALL_DEFAULT_MAX_INVALID_READS,
+  },
+};
+
+static struct FOCSensoredData_t MOTOR_HOT_DATA s_foc_data = {
   .field_weakening_config = {
     .id_max = 0.0f,
     .id_min = -2.0f,
     .k_fw = 0.01f,
     .voltage_margin = 0.9f,
-  }
+  },
+
+  .position_source = FOC_POSITION_SOURCE_ENCODER,
 };
 
 /*******************************************************************************************************************************
@@ -67,16 +78,41 @@ static MotorError_t foc_sensored_init(struct Motor_t *motor, struct MotorConfig_
   /* Initialize pid controllers */
   pid_init(&motor->control.current, &motor->config->current_pid_config);
   pid_init(&motor->control.velocity, &motor->config->velocity_pid_config);
+  pid_init(&motor->control.position, &motor->config->position_pid_config);
+
+  /* The control cycle reads the copies in params */
+  motor_reload_config(motor);
 
-  pid_init(&s_foc_data.current_d, &s_foc_data.current_d_pid_config);
-  pid_init(&s_foc_data.current_q, &s_foc_data.current_q_pid_config);
+  pid_init(&s_foc_data.current_d, &s_foc_cold.current_d_pid_config);
+  pid_init(&s_foc_data.current_q, &s_foc_cold.current_q_pid_config);
 
   field_weakening_init(&s_foc_data.field_weakening_state, &s_foc_data.field_weakening_config);
 
-  if (!hal_pwm_init(&config->pwm_config) || !hal_adc_init(&config->adc_config) || !hal_encoder_init()) {
+  if (!hal_pwm_init(&config->pwm_config) || !hal_adc_init(&config->adc_config) || !hal_gpio_init()) {
     return MOTOR_INIT_ERROR;
   }
 
+  if (s_foc_data.position_source == FOC_POSITION_SOURCE_HALL) {
+    if (!hal_gpio_init_hall_sensors()) {
+      return MOTOR_INIT_ERROR;
+    }
+    hall_estimator_init(&s_foc_data.hall_estimator, &s_foc_cold.hall_estimator_config);
+  } else if (!hal_encoder_init()) {
+    return MOTOR_INIT_ERROR;
+  }
+
+  s_foc_data.electrical_angle = 0.0f;
+  s_foc_data.id = 0.0f;
+  s_foc_data.iq = 0.0f;
+  s_foc_data.vd = 0.0f;
+  s_foc_data.vq = 0.0f;
+  s_foc_data.v_alpha = 0.0f;
+  s_foc_data.v_beta = 0.0f;
+  s_foc_data.mode = MOTOR_MODE_RUNNING;
+
+  /* The current loops integrate from here, not from the last run of the driver */
+  motor->state.last_update_time = hal_get_micros();
+
   motor->state.is_initialized = true;
   return MOTOR_OK;
 }
@@ -110,15 +146,30 @@ static MotorError_t foc_sensored_update_state(struct Motor_t *motor) {
   motor->state.temperature = hal_adc_get_temperature();
   motor->state.dc_voltage = hal_adc_get_dc_voltage();
 
-  motor->state.position = hal_encoder_get_position();
-  motor->state.velocity = hal_encoder_get_velocity();
+  if (foc_data->position_source == FOC_POSITION_SOURCE_HALL) {
+    float theta_e, omega_e;
 
-  /* Check for overvoltage or undervoltage */
-  for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
-    if (motor->state.phase_voltages[phase] > motor->config->max_voltage) {
+    if (hall_estimator_update(&foc_data->hall_estimator, hal_gpio_get_hall_state(), hal_get_micros(), &theta_e, &omega_e) != UTILS_OK) {
       foc_data->mode = MOTOR_MODE_ERROR;
-      return MOTOR_OVERVOLTAGE_ERROR;
-    } else if (motor->state.phase_currents[phase] > motor->config->max_current) {
+      return MOTOR_HAL_ERROR;
+    }
+
+    /* Hall sensors only resolve the electrical angle, which is all the transforms need */
+    motor->state.position = theta_e / (float)motor->params.pole_pairs;
+    motor->state.velocity = omega_e / (float)motor->params.pole_pairs;
+  } else {
+    motor->state.position = hal_encoder_get_position();
+    motor->state.velocity = hal_encoder_get_velocity();
+  }
+
+  /* The terminals swing between the rails, so overvoltage is checked on the bus */
+  if (motor->state.dc_voltage > MOTOR_BUS_OVERVOLTAGE_RATIO * motor->params.max_voltage) {
+    foc_data->mode = MOTOR_MODE_ERROR;
+    return MOTOR_OVERVOLTAGE_ERROR;
+  }
+
+  for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+    if (motor->state.phase_currents[phase] > motor->params.max_current) {
       foc_data->mode = MOTOR_MODE_ERROR;
       return MOTOR_OVERCURRENT_ERROR;
     }
@@ -148,7 +199,7 @@ static MotorError_t foc_sensored_commutate(struct Motor_t *motor) {
    * Step 2: Calculate electrical angle
    */
   float mech_angle = motor->state.position;
-  foc_data->electrical_angle = normalize_angle(mech_angle * motor->config->pole_pairs);
+  foc_data->electrical_angle = normalize_angle(mech_angle * motor->params.pole_pairs);
 
   /*
    * Step 3: Clarke transform
@@ -165,18 +216,18 @@ static MotorError_t foc_sensored_commutate(struct Motor_t *motor) {
    * Step 5: Apply Field Weakening if necessary based on control mode
    * We apply field weakening (adjust D-axis current) only in Torque or Velocity mode.
    */
-  switch (motor->config->control_mode) {
+  switch (motor->params.control_mode) {
     case CONTROL_MODE_CURRENT:
     case CONTROL_MODE_TORQUE: {
       float id_ref = 0.0f; 
 
-      if (motor->config->control_mode == CONTROL_MODE_TORQUE) {
-        field_weakening_update(&foc_data->field_weakening_state, &foc_data->field_weakening_config, foc_data->vd, foc_data->vq, motor->state.dc_voltage);
+      if (motor->params.control_mode == CONTROL_MODE_TORQUE) {
+        field_weakening_update(&foc_data->field_weakening_state, foc_data->vd, foc_data->vq, motor->state.dc_voltage);
         id_ref = foc_data->field_weakening_state.id_ref;
       }
 
-      float iq_ref = (motor->config->control_mode == CONTROL_MODE_TORQUE) ? 
-                     (motor->setpoint.torque / motor->config->torque_constant) : motor->setpoint.current;
+      float iq_ref = (motor->params.control_mode == CONTROL_MODE_TORQUE) ? 
+                     (motor->setpoint.torque / motor->params.torque_constant) : motor->setpoint.current;
 
       foc_data->vd = pid_update(&foc_data->current_d, id_ref, foc_data->id, delta_time);
       foc_data->vq = pid_update(&foc_data->current_q, iq_ref, foc_data->iq, delta_time);
@@ -186,7 +237,7 @@ static MotorError_t foc_sensored_commutate(struct Motor_t *motor) {
     case CONTROL_MODE_VELOCITY: {
       float iq_ref = pid_update(&motor->control.velocity, motor->setpoint.velocity, motor->state.velocity, delta_time);
 
-      field_weakening_update(&foc_data->field_weakening_state, &foc_data->field_weakening_config, foc_data->vd, foc_data->vq, motor->state.dc_voltage);
+      field_weakening_update(&foc_data->field_weakening_state, foc_data->vd, foc_data->vq, motor->state.dc_voltage);
       float id_ref = foc_data->field_weakening_state.id_ref;
 
       foc_data->vd = pid_update(&foc_data->current_d, id_ref, foc_data->id, delta_time);
@@ -197,7 +248,7 @@ static MotorError_t foc_sensored_commutate(struct Motor_t *motor) {
     case CONTROL_MODE_POSITION: {
       float iq_ref = pid_update(&motor->control.velocity, motor->setpoint.velocity, motor->state.velocity, delta_time);
 
-      field_weakening_update(&foc_data->field_weakening_state, &foc_data->field_weakening_config, foc_data->vd, foc_data->vq, motor->state.dc_voltage);
+      field_weakening_update(&foc_data->field_weakening_state, foc_data->vd, foc_data->vq, motor->state.dc_voltage);
       float id_ref = foc_data->field_weakening_state.id_ref;
 
       foc_data->vd = pid_update(&foc_data->current_d, id_ref, foc_data->id, delta_time);
@@ -207,8 +258,9 @@ static MotorError_t foc_sensored_commutate(struct Motor_t *motor) {
 
     case CONTROL_MODE_VOLTAGE:
     default: {
-      foc_data->vd = motor->setpoint.voltage;
-      foc_data->vq = 0.0f;
+      /* Along the back-EMF, the voltage that turns the rotor */
+      foc_data->vd = 0.0f;
+      foc_data->vq = motor->setpoint.voltage;
       break;
     }
   }
@@ -216,7 +268,7 @@ static MotorError_t foc_sensored_commutate(struct Motor_t *motor) {
   /*
    * Step 6: Inverse park transform to convert the D/Q axis voltages back to alpha/beta.
    */
-  inverse_park_transform(foc_data->vd, foc_data->vq, foc_data->electrical_angle, &alpha, &beta);
+  inverse_park_transform(foc_data->vd, foc_data->vq, foc_data->electrical_angle, &foc_data->v_alpha, &foc_data->v_beta);
   return MOTOR_OK;
 }
 
@@ -229,11 +281,13 @@ static MotorError_t foc_sensored_update_pwm(struct Motor_t *motor) {
 
   /*
    * Step 7: Space vector modulation generation
+   * A modulation index of 1 is an active vector, 2/3 of the bus voltage
    */
-  float vref_mag = sqrtf(foc_data->vd * foc_data->vd + foc_data->vq * foc_data->vq);
+  float v_mag = sqrtf(foc_data->v_alpha * foc_data->v_alpha + foc_data->v_beta * foc_data->v_beta);
+  float modulation = (motor->state.dc_voltage > 0.0f) ? clamp(1.5f * v_mag / motor->state.dc_voltage, 0.0f, SQRT3_OVER_2) : 0.0f;
   float duty_A, duty_B, duty_C;
 
-  svpwm_generate(foc_data->electrical_angle, vref_mag, &duty_A, &duty_B, &duty_C);
+  svpwm_generate(atan2f(foc_data->v_beta, foc_data->v_alpha), modulation, &duty_A, &duty_B, &duty_C);
   hal_set_pwm(&motor->config->pwm_config, duty_A, duty_B, duty_C);
   return MOTOR_OK;
 }
@@ -243,7 +297,7 @@ static MotorError_t foc_sensored_set_voltage(struct Motor_t *motor, float voltag
     return MOTOR_INVALID_ARGS;
   }
   motor->setpoint.voltage = voltage;
-  motor->config->control_mode = CONTROL_MODE_VOLTAGE;
+  motor_set_control_mode(motor, CONTROL_MODE_VOLTAGE);
   return MOTOR_OK;
 }
 
@@ -252,7 +306,7 @@ static MotorError_t foc_sensored_set_current(struct Motor_t *motor, float curren
     return MOTOR_INVALID_ARGS;
   }
   motor->setpoint.current = current;
-  motor->config->control_mode = CONTROL_MODE_CURRENT;
+  motor_set_control_mode(motor, CONTROL_MODE_CURRENT);
   return MOTOR_OK;
 }
 
@@ -261,7 +315,7 @@ static MotorError_t foc_sensored_set_velocity(struct Motor_t *motor, float veloc
     return MOTOR_INVALID_ARGS;
   }
   motor->setpoint.velocity = velocity;
-  motor->config->control_mode = CONTROL_MODE_VELOCITY;
+  motor_set_control_mode(motor, CONTROL_MODE_VELOCITY);
   return MOTOR_OK;
 }
 
@@ -270,7 +324,7 @@ static MotorError_t foc_sensored_set_position(struct Motor_t *motor, float posit
     return MOTOR_INVALID_ARGS;
   }
   motor->setpoint.position = position;
-  motor->config->control_mode = CONTROL_MODE_POSITION;
+  motor_set_control_mode(motor, CONTROL_MODE_POSITION);
   return MOTOR_OK;
 }
 
@@ -279,7 +333,7 @@ static MotorError_t foc_sensored_set_torque(struct Motor_t *motor, float torque)
     return MOTOR_INVALID_ARGS;
   }
   motor->setpoint.torque = torque;
-  motor->config->control_mode = CONTROL_MODE_TORQUE;
+  motor_set_control_mode(motor, CONTROL_MODE_TORQUE);
   return MOTOR_OK;
 }
 
@@ -301,3 +355,13 @@ void foc_sensored_create_driver(struct Motor_t *motor) {
     motor->driver.set_torque = foc_sensored_set_torque;
   }
 }
+
+void foc_sensored_set_position_source(FOCPositionSource_t source) {
+  s_foc_data.position_source = source;
+}
+
+void foc_sensored_set_hall_config(const struct HallEstimatorConfig_t *config) {
+  if (config != NULL) {
+    s_foc_cold.hall_estimator_config = *config;
+  }
+}
@@ -0,0 +1,758 @@
+/*******************************************************************************************************************************
+ * @file   foc_sensorless.c
+ *
+ * @brief  Source file for the sensorless FOC driver
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "hal.h"
+#include "math_utils.h"
+#include "svpwm.h"
+#include "transform_utils.h"
+
+/* Intra-component Headers */
+#include "backemf_pll_observer.h"
+#include "foc_common.h"
+#include "foc_observer.h"
+#include "foc_sensorless.h"
+#include "hfi_observer.h"
+
+/*******************************************************************************************************************************
+ * Private Data Structure
+ *******************************************************************************************************************************/
+
+static struct FOCSensorlessColdConfig_t s_foc_cold = {
+  .current_d_pid_config = {
+    .kp                   = FOC_PID_DEFAULT_D_KP,
+    .ki                   = FOC_PID_DEFAULT_D_KI,
+    .kd                   = FOC_PID_DEFAULT_D_KD,
+    .output_max           = FOC_PID_DEFAULT_D_OUTPUT_MAX,
+    .output_min           = FOC_PID_DEFAULT_D_OUTPUT_MIN,
+    .derivative_ema_alpha = FOC_PID_DEFAULT_D_DERIV_EMA_ALPHA,
+  },
+
+  .current_q_pid_config = {
+    .kp                   = FOC_PID_DEFAULT_Q_KP,
+    .ki                   = FOC_PID_DEFAULT_Q_KI,
+    .kd                   = FOC_PID_DEFAULT_Q_KD,
+    .output_max           = FOC_PID_DEFAULT_Q_OUTPUT_MAX,
+    .output_min           = FOC_PID_DEFAULT_Q_OUTPUT_MIN,
+    .derivative_ema_alpha = FOC_PID_DEFAULT_Q_DERIV_EMA_ALPHA,
+  },
+
+  .startup_config = {
+    .align_current = FOC_SENSORLESS_DEFAULT_ALIGN_CURRENT,
+    .align_time_us = FOC_SENSORLESS_DEFAULT_ALIGN_TIME_US,
+    .ramp_current = FOC_SENSORLESS_DEFAULT_RAMP_CURRENT,
+    .ramp_acceleration = FOC_SENSORLESS_DEFAULT_RAMP_ACCELERATION,
+    .ramp_final_speed = FOC_SENSORLESS_DEFAULT_RAMP_FINAL_SPEED,
+    .lock_window_us = FOC_SENSORLESS_DEFAULT_LOCK_WINDOW_US,
+    .blend_time_us = FOC_SENSORLESS_DEFAULT_BLEND_TIME_US,
+    .transition_timeout_us = FOC_SENSORLESS_DEFAULT_TRANSITION_TIMEOUT_US,
+  },
+
+  .flying_start_config = {
+    .enabled = false,
+    .catch_time_us = FOC_SENSORLESS_DEFAULT_CATCH_TIME_US,
+    .min_bemf = FOC_SENSORLESS_DEFAULT_CATCH_MIN_BEMF,
+  },
+};
+
+static struct FOCSensorlessData_t MOTOR_HOT_DATA s_foc_data = {
+  .cold = &s_foc_cold,
+
+  .field_weakening_config = {
+    .id_max = 0.0f,
+    .id_min = -2.0f,
+    .k_fw = 0.01f,
+    .voltage_margin = 0.9f,
+  },
+
+  .backemf_pll_config = {
+    .pll_cfg = {
+      .kp               = FOC_SENSORLESS_DEFAULT_PLL_KP,
+      .ki               = FOC_SENSORLESS_DEFAULT_PLL_KI,
+      .max_omega        = FOC_SENSORLESS_DEFAULT_PLL_MAX_OMEGA,
+      .filter_alpha     = 0.0f,
+      .enable_filtering = false,
+    },
+    .min_speed = FOC_SENSORLESS_DEFAULT_OBSERVER_MIN_SPEED,
+    .max_speed = FOC_SENSORLESS_DEFAULT_PLL_MAX_OMEGA,
+  },
+
+  .hfi_config = {
+    .pll_cfg = {
+      .kp               = FOC_SENSORLESS_DEFAULT_HFI_PLL_KP,
+      .ki               = FOC_SENSORLESS_DEFAULT_HFI_PLL_KI,
+      .max_omega        = FOC_SENSORLESS_DEFAULT_PLL_MAX_OMEGA,
+      .filter_alpha     = 0.0f,
+      .enable_filtering = false,
+    },
+    .injection_voltage = FOC_SENSORLESS_DEFAULT_HFI_INJECTION_VOLTAGE,
+    .crossover_low = FOC_SENSORLESS_DEFAULT_HFI_CROSSOVER_LOW,
+    .crossover_high = FOC_SENSORLESS_DEFAULT_HFI_CROSSOVER_HIGH,
+  },
+};
+
+/*******************************************************************************************************************************
+ * Private Functions
+ *******************************************************************************************************************************/
+
+/* Linear SVPWM reaches a phase voltage amplitude of Vdc / sqrt(3) */
+static float foc_sensorless_max_phase_voltage(struct Motor_t *motor) {
+  return fmaxf(motor->state.dc_voltage, 0.0f) * INV_SQRT3;
+}
+
+static void foc_sensorless_run_current_loops(struct FOCSensorlessData_t *foc_data, float v_max, float id_ref, float iq_ref, float delta_time) {
+  /* The d-axis is served first and the q-axis gets the rest of the voltage. Limiting the PI outputs, rather than the
+   * voltage vector afterwards, keeps their integrators from winding up at the modulation limit */
+  pid_set_output_limits(&foc_data->current_d, -v_max, v_max);
+  foc_data->vd = pid_update(&foc_data->current_d, id_ref, foc_data->id, delta_time);
+
+  float vq_max = sqrtf(fmaxf(v_max * v_max - foc_data->vd * foc_data->vd, 0.0f));
+  pid_set_output_limits(&foc_data->current_q, -vq_max, vq_max);
+  foc_data->vq = pid_update(&foc_data->current_q, iq_ref, foc_data->iq, delta_time);
+}
+
+/* Restarts the observer from a known angle and speed, through the back-EMF PLL the injection observer blends into */
+static void foc_sensorless_seed_observer(struct FOCSensorlessData_t *foc_data, float theta, float omega) {
+  if (foc_data->observer.type == OBSERVER_TYPE_HFI) {
+    foc_observer_hfi_seed(&foc_data->observer, theta, omega);
+  } else {
+    foc_observer_backemf_pll_seed(&foc_data->observer, theta, omega);
+  }
+}
+
+static void foc_sensorless_startup_begin(struct FOCSensorlessData_t *foc_data, uint32_t current_time) {
+  /* Initial alignment phase. The rotor flux is pulled onto the forced angle */
+  foc_data->mode = MOTOR_MODE_ALIGNING;
+  foc_data->forced_angle = 0.0f;
+  foc_data->forced_velocity = 0.0f;
+  foc_data->startup_mode_time = current_time;
+  foc_data->lock_start_time = current_time;
+  foc_data->is_observer_locked = false;
+}
+
+static void foc_sensorless_catch_begin(struct FOCSensorlessData_t *foc_data, uint32_t current_time) {
+  /* Flying start. With the bridge off no current flows and the terminals carry the back-EMF */
+  foc_data->mode = MOTOR_MODE_CATCHING;
+  foc_data->startup_mode_time = current_time;
+  foc_data->catch_bemf_angle = 0.0f;
+  foc_data->catch_travel = 0.0f;
+  foc_data->has_catch_sample = false;
+  hal_pwm_set_gates(HAL_GATES_FLOAT, 0.0f);
+}
+
+/* Closed-loop from the caught rotor. The current loops start out producing the back-EMF, which keeps the current at zero */
+static void foc_sensorless_catch_enter_running(struct Motor_t *motor, struct FOCSensorlessData_t *foc_data, float bemf_alpha, float bemf_beta,
+                                               float flux_angle, float velocity) {
+  float bemf_d, bemf_q;
+
+  foc_sensorless_seed_observer(foc_data, flux_angle, velocity);
+  park_transform(bemf_alpha, bemf_beta, flux_angle, &bemf_d, &bemf_q);
+
+  pid_init(&foc_data->current_d, &foc_data->cold->current_d_pid_config);
+  pid_init(&foc_data->current_q, &foc_data->cold->current_q_pid_config);
+  pid_init(&motor->control.velocity, &motor->config->velocity_pid_config);
+
+  if (foc_data->current_d.gains.ki != 0.0f) {
+    foc_data->current_d.integral = bemf_d / foc_data->current_d.gains.ki;
+  }
+
+  if (foc_data->current_q.gains.ki != 0.0f) {
+    foc_data->current_q.integral = bemf_q / foc_data->current_q.gains.ki;
+  }
+
+  foc_data->vd = bemf_d;
+  foc_data->vq = bemf_q;
+  foc_data->mode = MOTOR_MODE_RUNNING;
+}
+
+/* Tracks the back-EMF angle with the bridge off, then hands a spinning rotor to closed-loop and a standing one to the I/f startup */
+static void foc_sensorless_catch_tick(struct Motor_t *motor, struct FOCSensorlessData_t *foc_data, uint32_t current_time) {
+  const float *phase_voltages = motor->state.phase_voltages;
+  float neutral = (phase_voltages[MOTOR_PHASE_A] + phase_voltages[MOTOR_PHASE_B] + phase_voltages[MOTOR_PHASE_C]) / 3.0f;
+  float bemf_alpha, bemf_beta;
+
+  /* The star point floats with the bridge off, removing the common mode leaves the back-EMF */
+  clarke_transform_3phase(phase_voltages[MOTOR_PHASE_A] - neutral, phase_voltages[MOTOR_PHASE_B] - neutral, phase_voltages[MOTOR_PHASE_C] - neutral,
+                          &bemf_alpha, &bemf_beta);
+
+  if (sqrtf(bemf_alpha * bemf_alpha + bemf_beta * bemf_beta) < foc_data->cold->flying_start_config.min_bemf) {
+    /* Standing, or too slow for the angle to stand out of the noise */
+    foc_sensorless_startup_begin(foc_data, current_time);
+    return;
+  }
+
+  float bemf_angle = atan2f(bemf_beta, bemf_alpha);
+
+  if (!foc_data->has_catch_sample) {
+    /* The measurement window starts at the first sample */
+    foc_data->has_catch_sample = true;
+    foc_data->startup_mode_time = current_time;
+  } else {
+    foc_data->catch_travel += normalize_angle(bemf_angle - foc_data->catch_bemf_angle + MATH_PI) - MATH_PI;
+  }
+
+  foc_data->catch_bemf_angle = bemf_angle;
+
+  uint32_t elapsed = current_time - foc_data->startup_mode_time;
+
+  if (elapsed < foc_data->cold->flying_start_config.catch_time_us) {
+    return;
+  }
+
+  float velocity = foc_data->catch_travel / ((float)elapsed / 1000000.0f);
+
+  if (fabsf(velocity) < foc_data->backemf_pll_config.min_speed) {
+    foc_sensorless_startup_begin(foc_data, current_time);
+    return;
+  }
+
+  /* The back-EMF leads the rotor flux by 90 degrees, and lags it in reverse */
+  float flux_angle = normalize_angle(bemf_angle - copysignf(MATH_PI_OVER_2, velocity));
+
+  foc_sensorless_catch_enter_running(motor, foc_data, bemf_alpha, bemf_beta, flux_angle, velocity);
+}
+
+static void foc_sensorless_advance_forced_angle(struct FOCSensorlessData_t *foc_data, float delta_time) {
+  const struct FOCSensorlessStartupConfig_t *startup_config = &foc_data->cold->startup_config;
+  float speed_step = startup_config->ramp_acceleration * delta_time;
+
+  if (startup_config->ramp_final_speed >= 0.0f) {
+    foc_data->forced_velocity = fminf(foc_data->forced_velocity + speed_step, startup_config->ramp_final_speed);
+  } else {
+    foc_data->forced_velocity = fmaxf(foc_data->forced_velocity - speed_step, startup_config->ramp_final_speed);
+  }
+
+  foc_data->forced_angle = normalize_angle(foc_data->forced_angle + foc_data->forced_velocity * delta_time);
+}
+
+/* The lock only counts once it has held for the whole window, turning the same way as the forced angle */
+static bool foc_sensorless_observer_has_locked(struct FOCSensorlessData_t *foc_data, uint32_t current_time) {
+  bool is_converged = false;
+  uint32_t update_count = 0U;
+  float max_error = 0.0f;
+
+  if (foc_observer_backemf_pll_get_status(&foc_data->observer, &is_converged, &update_count, &max_error) != MOTOR_OK) {
+    return false;
+  }
+
+  if (!is_converged || (foc_data->observer.estimated_omega * foc_data->forced_velocity) <= 0.0f) {
+    foc_data->is_observer_locked = false;
+    return false;
+  }
+
+  if (!foc_data->is_observer_locked) {
+    foc_data->is_observer_locked = true;
+    foc_data->lock_start_time = current_time;
+  }
+
+  return (current_time - foc_data->lock_start_time) >= foc_data->cold->startup_config.lock_window_us;
+}
+
+/* Advances the startup modes and sets their current references, which apply in the forced (or blended) frame */
+static MotorError_t foc_sensorless_startup_tick(struct Motor_t *motor, struct FOCSensorlessData_t *foc_data, uint32_t current_time,
+                                                float delta_time, float *id_ref, float *iq_ref) {
+  const struct FOCSensorlessStartupConfig_t *startup_config = &foc_data->cold->startup_config;
+  uint32_t elapsed = current_time - foc_data->startup_mode_time;
+  float ramp_current = copysignf(startup_config->ramp_current, startup_config->ramp_final_speed);
+
+  switch (foc_data->mode) {
+    case MOTOR_MODE_CATCHING:
+      foc_sensorless_catch_tick(motor, foc_data, current_time);
+      break;
+
+    case MOTOR_MODE_ALIGNING: {
+      /*
+       * A rotor sitting opposite the current vector feels no torque. The vector is ramped up 90 degrees ahead during
+       * the first half, then turned back onto the start angle during the second half, which no rotor position is
+       * opposite to both of. Both moves are gradual so the rotor follows instead of swinging about the vector
+       */
+      float progress = 2.0f * (float)elapsed / fmaxf((float)startup_config->align_time_us, 1.0f);
+
+      foc_data->forced_angle = MATH_PI_OVER_2 * clamp(2.0f - progress, 0.0f, 1.0f);
+      *id_ref = startup_config->align_current * fminf(progress, 1.0f);
+      *iq_ref = 0.0f;
+
+      if (elapsed >= startup_config->align_time_us && foc_data->observer.type == OBSERVER_TYPE_HFI) {
+        /* The injection tracks the rotor from standstill, the alignment only gives it the polarity of the d-axis */
+        foc_sensorless_seed_observer(foc_data, 0.0f, 0.0f);
+        foc_data->mode = MOTOR_MODE_RUNNING;
+        pid_init(&motor->control.velocity, &motor->config->velocity_pid_config);
+      } else if (elapsed >= startup_config->align_time_us) {
+        /* I/f acceleration phase, the current vector now leads the aligned rotor by 90 degrees */
+        foc_data->mode = MOTOR_MODE_OPEN_LOOP;
+        foc_data->startup_mode_time = current_time;
+        foc_data->is_observer_locked = false;
+        foc_data->forced_angle = 0.0f;
+        *id_ref = 0.0f;
+        *iq_ref = ramp_current;
+      }
+      break;
+    }
+
+    case MOTOR_MODE_OPEN_LOOP:
+      foc_sensorless_advance_forced_angle(foc_data, delta_time);
+      *id_ref = 0.0f;
+      *iq_ref = ramp_current;
+
+      /*
+       * Without back-EMF the PLL wanders, so it follows the forced angle until the rotor turns. Once it turns against
+       * the forced angle it sits on a reversed estimate that the error averages out on and never leaves, so it is
+       * restarted from the forced angle, which carries the commanded direction
+       */
+      if (fabsf(foc_data->forced_velocity) < foc_data->backemf_pll_config.min_speed ||
+          (foc_data->observer.estimated_omega * foc_data->forced_velocity) < 0.0f) {
+        foc_sensorless_seed_observer(foc_data, foc_data->forced_angle, foc_data->forced_velocity);
+      }
+
+      if (foc_sensorless_observer_has_locked(foc_data, current_time)) {
+        foc_data->mode = MOTOR_MODE_TRANSITION;
+        foc_data->startup_mode_time = current_time;
+      } else if (elapsed > startup_config->transition_timeout_us) {
+        /* The observer never locked, the rotor has most likely stalled behind the forced angle */
+        foc_data->mode = MOTOR_MODE_ERROR;
+        hal_pwm_set_gates(HAL_GATES_FLOAT, 0.0f);
+        return MOTOR_INIT_ERROR;
+      }
+      break;
+
+    case MOTOR_MODE_TRANSITION: {
+      foc_sensorless_advance_forced_angle(foc_data, delta_time);
+      *id_ref = 0.0f;
+      *iq_ref = ramp_current;
+
+      float blend = fminf((float)elapsed / fmaxf((float)startup_config->blend_time_us, 1.0f), 1.0f);
+
+      if (blend >= 1.0f) {
+        /* Closed-loop from here. The speed loop starts from the startup current so the torque does not step */
+        foc_data->mode = MOTOR_MODE_RUNNING;
+        pid_init(&motor->control.velocity, &motor->config->velocity_pid_config);
+
+        if (motor->control.velocity.gains.ki != 0.0f) {
+          motor->control.velocity.integral = ramp_current / motor->control.velocity.gains.ki;
+        }
+      }
+      break;
+    }
+
+    default:
+      break;
+  }
+
+  return MOTOR_OK;
+}
+
+/* Control angle and speed of the current mode. Startup blends linearly from the forced angle to the observer */
+static void foc_sensorless_select_angle(struct FOCSensorlessData_t *foc_data, uint32_t current_time) {
+  float observer_angle = foc_data->observer.estimated_theta;
+  float observer_velocity = foc_data->observer.estimated_omega;
+
+  switch (foc_data->mode) {
+    case MOTOR_MODE_ALIGNING:
+    case MOTOR_MODE_OPEN_LOOP:
+      foc_data->electrical_angle = foc_data->forced_angle;
+      foc_data->electrical_velocity = foc_data->forced_velocity;
+      break;
+
+    case MOTOR_MODE_TRANSITION: {
+      uint32_t elapsed = current_time - foc_data->startup_mode_time;
+      float blend = fminf((float)elapsed / fmaxf((float)foc_data->cold->startup_config.blend_time_us, 1.0f), 1.0f);
+      float angle_error = normalize_angle(observer_angle - foc_data->forced_angle + MATH_PI) - MATH_PI;
+
+      foc_data->electrical_angle = normalize_angle(foc_data->forced_angle + blend * angle_error);
+      foc_data->electrical_velocity = foc_data->forced_velocity + blend * (observer_velocity - foc_data->forced_velocity);
+      break;
+    }
+
+    default:
+      foc_data->electrical_angle = observer_angle;
+      foc_data->electrical_velocity = observer_velocity;
+      break;
+  }
+}
+
+static bool foc_sensorless_is_starting(const struct FOCSensorlessData_t *foc_data) {
+  return foc_data->mode == MOTOR_MODE_CATCHING || foc_data->mode == MOTOR_MODE_ALIGNING || foc_data->mode == MOTOR_MODE_OPEN_LOOP || foc_data->mode == MOTOR_MODE_TRANSITION;
+}
+
+/*******************************************************************************************************************************
+ * Interface Functions
+ *******************************************************************************************************************************/
+
+static MotorError_t foc_sensorless_init(struct Motor_t *motor, struct MotorConfig_t *config) {
+  if (motor == NULL || config == NULL) {
+    return MOTOR_INVALID_ARGS;
+  }
+
+  motor->config = config;
+  motor->private_data = &s_foc_data;
+
+  /* The requested observer type has no implementation */
+  if (s_foc_data.observer.driver.init == NULL || s_foc_data.observer.driver.update == NULL) {
+    return MOTOR_INIT_ERROR;
+  }
+
+  /* Initialize pid controllers */
+  pid_init(&motor->control.current, &motor->config->current_pid_config);
+  pid_init(&motor->control.velocity, &motor->config->velocity_pid_config);
+  pid_init(&motor->control.position, &motor->config->position_pid_config);
+
+  /* The control cycle reads the copies in params */
+  motor_reload_config(motor);
+
+  pid_init(&s_foc_data.current_d, &s_foc_cold.current_d_pid_config);
+  pid_init(&s_foc_data.current_q, &s_foc_cold.current_q_pid_config);
+
+  field_weakening_init(&s_foc_data.field_weakening_state, &s_foc_data.field_weakening_config);
+
+  if (!hal_pwm_init(&config->pwm_config) || !hal_adc_init(&config->adc_config) || !hal_gpio_init()) {
+    return MOTOR_INIT_ERROR;
+  }
+
+  /* The observer motor model is the configured motor */
+  s_foc_data.backemf_pll_config.Rs = config->phase_resistance;
+  s_foc_data.backemf_pll_config.Ls = config->phase_inductance;
+
+  if (s_foc_data.observer.driver.init(&s_foc_data.observer) != MOTOR_OK) {
+    return MOTOR_INIT_ERROR;
+  }
+
+  s_foc_data.electrical_angle = 0.0f;
+  s_foc_data.electrical_velocity = 0.0f;
+  s_foc_data.id = 0.0f;
+  s_foc_data.iq = 0.0f;
+  s_foc_data.vd = 0.0f;
+  s_foc_data.vq = 0.0f;
+  s_foc_data.v_alpha = 0.0f;
+  s_foc_data.v_beta = 0.0f;
+
+  motor->state.last_update_time = hal_get_micros();
+
+  if (s_foc_cold.flying_start_config.enabled) {
+    foc_sensorless_catch_begin(&s_foc_data, motor->state.last_update_time);
+  } else {
+    foc_sensorless_startup_begin(&s_foc_data, motor->state.last_update_time);
+  }
+
+  motor->state.is_initialized = true;
+  return MOTOR_OK;
+}
+
+static MotorError_t foc_sensorless_deinit(struct Motor_t *motor) {
+  if (motor == NULL) {
+    return MOTOR_INVALID_ARGS;
+  }
+
+  hal_pwm_set_gates(HAL_GATES_FLOAT, 0.0f);
+
+  s_foc_data.mode = MOTOR_MODE_STOPPED;
+  motor->state.is_initialized = false;
+  return MOTOR_OK;
+}
+
+static MotorError_t foc_sensorless_update_state(struct Motor_t *motor) {
+  if (motor == NULL) {
+    return MOTOR_INVALID_ARGS;
+  }
+
+  struct FOCSensorlessData_t *foc_data = (struct FOCSensorlessData_t *)motor->private_data;
+
+  hal_adc_start_conversion();
+  hal_adc_get_phase_voltages(motor->state.phase_voltages);
+  hal_adc_get_phase_currents(motor->state.phase_currents);
+  motor->state.temperature = hal_adc_get_temperature();
+  motor->state.dc_voltage = hal_adc_get_dc_voltage();
+
+  /* The terminals swing between the rails, so overvoltage is checked on the bus */
+  if (motor->state.dc_voltage > MOTOR_BUS_OVERVOLTAGE_RATIO * motor->params.max_voltage) {
+    foc_data->mode = MOTOR_MODE_ERROR;
+    return MOTOR_OVERVOLTAGE_ERROR;
+  }
+
+  for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+    if (fabsf(motor->state.phase_currents[phase]) > motor->params.max_current) {
+      foc_data->mode = MOTOR_MODE_ERROR;
+      return MOTOR_OVERCURRENT_ERROR;
+    }
+  }
+
+  return MOTOR_OK;
+}
+
+static MotorError_t foc_sensorless_commutate(struct Motor_t *motor) {
+  if (motor == NULL) {
+    return MOTOR_INVALID_ARGS;
+  }
+
+  struct FOCSensorlessData_t *foc_data = (struct FOCSensorlessData_t *)motor->private_data;
+
+  uint32_t current_time = hal_get_micros();
+  float delta_time = (current_time - motor->state.last_update_time) / 1000000.0f;
+  motor->state.last_update_time = current_time;
+
+  /*
+   * Step 1: Clarke transform of the measured phase currents
+   */
+  clarke_transform_2phase(motor->state.phase_currents[MOTOR_PHASE_A], motor->state.phase_currents[MOTOR_PHASE_B], &foc_data->i_alpha,
+                          &foc_data->i_beta);
+
+  /*
+   * Step 2: Estimate the rotor angle from the voltage applied over the last period and the currents it produced.
+   * While catching, nothing is applied and the observer is seeded from the measured back-EMF instead
+   */
+  if (delta_time > 0.0f && foc_data->mode != MOTOR_MODE_CATCHING) {
+    float observer_angle, observer_velocity;
+
+    if (foc_data->observer.driver.update(&foc_data->observer, foc_data->v_alpha, foc_data->v_beta, foc_data->i_alpha, foc_data->i_beta,
+                                         delta_time, &observer_angle, &observer_velocity) != MOTOR_OK) {
+      foc_data->mode = MOTOR_MODE_ERROR;
+      return MOTOR_INTERNAL_ERROR;
+    }
+
+    /* The current loops work on the current without the injection ripple */
+    if (foc_data->observer.type == OBSERVER_TYPE_HFI) {
+      foc_observer_hfi_get_fundamental_current(&foc_data->observer, &foc_data->i_alpha, &foc_data->i_beta);
+    }
+  }
+
+  /* The observer runs through the startup too, so it has locked by the time the control angle is handed to it */
+  float startup_id_ref = 0.0f;
+  float startup_iq_ref = 0.0f;
+
+  if (foc_sensorless_is_starting(foc_data)) {
+    MotorError_t status = foc_sensorless_startup_tick(motor, foc_data, current_time, delta_time, &startup_id_ref, &startup_iq_ref);
+
+    if (status != MOTOR_OK) {
+      return status;
+    }
+  }
+
+  /* A caught rotor runs closed-loop from the period it was caught in */
+  bool is_starting = foc_sensorless_is_starting(foc_data);
+
+  if (foc_data->mode == MOTOR_MODE_CATCHING || (!is_starting && foc_data->mode != MOTOR_MODE_RUNNING)) {
+    /* Catching, stopped or faulted, the bridge is off */
+    foc_data->v_alpha = 0.0f;
+    foc_data->v_beta = 0.0f;
+    return MOTOR_OK;
+  }
+
+  foc_sensorless_select_angle(foc_data, current_time);
+
+  /* The observer only resolves the electrical angle, which is all the transforms need */
+  motor->state.position = foc_data->electrical_angle / (float)motor->params.pole_pairs;
+  motor->state.velocity = foc_data->electrical_velocity / (float)motor->params.pole_pairs;
+
+  /*
+   * Step 3: Park transform
+   */
+  park_transform(foc_data->i_alpha, foc_data->i_beta, foc_data->electrical_angle, &foc_data->id, &foc_data->iq);
+
+  /*
+   * Step 4: Current references from the control mode, then the current loops
+   * Field weakening compares against the linear modulation limit, the largest phase voltage amplitude SVPWM reaches
+   */
+  float v_max = foc_sensorless_max_phase_voltage(motor);
+
+  if (is_starting) {
+    foc_sensorless_run_current_loops(foc_data, v_max, startup_id_ref, startup_iq_ref, delta_time);
+  } else {
+    switch (motor->params.control_mode) {
+      case CONTROL_MODE_CURRENT:
+      case CONTROL_MODE_TORQUE: {
+        float id_ref = 0.0f;
+
+        if (motor->params.control_mode == CONTROL_MODE_TORQUE) {
+          field_weakening_update(&foc_data->field_weakening_state, foc_data->vd, foc_data->vq, v_max);
+          id_ref = foc_data->field_weakening_state.id_ref;
+        }
+
+        float iq_ref = (motor->params.control_mode == CONTROL_MODE_TORQUE) ? (motor->setpoint.torque / motor->params.torque_constant)
+                                                                             : motor->setpoint.current;
+
+        foc_sensorless_run_current_loops(foc_data, v_max, id_ref, iq_ref, delta_time);
+        break;
+      }
+
+      case CONTROL_MODE_VELOCITY: {
+        float iq_ref = pid_update(&motor->control.velocity, motor->setpoint.velocity, motor->state.velocity, delta_time);
+
+        field_weakening_update(&foc_data->field_weakening_state, foc_data->vd, foc_data->vq, v_max);
+        float id_ref = foc_data->field_weakening_state.id_ref;
+
+        foc_sensorless_run_current_loops(foc_data, v_max, id_ref, iq_ref, delta_time);
+        break;
+      }
+
+      case CONTROL_MODE_VOLTAGE:
+      default: {
+        /* Along the back-EMF, the voltage that turns the rotor */
+        foc_data->vd = 0.0f;
+        foc_data->vq = clamp(motor->setpoint.voltage, -v_max, v_max);
+        break;
+      }
+    }
+  }
+
+  /*
+   * Step 5: Inverse park transform. The voltage is held for the next control period, so it is rotated to the angle
+   * the rotor reaches halfway through it
+   */
+  float output_angle = normalize_angle(foc_data->electrical_angle + 0.5f * foc_data->electrical_velocity * delta_time);
+  inverse_park_transform(foc_data->vd, foc_data->vq, output_angle, &foc_data->v_alpha, &foc_data->v_beta);
+
+  /* The injection rides on the output, the observer is fed the total voltage next period */
+  if (foc_data->observer.type == OBSERVER_TYPE_HFI) {
+    float injection_alpha, injection_beta;
+
+    if (foc_observer_hfi_get_injection(&foc_data->observer, &injection_alpha, &injection_beta) == MOTOR_OK) {
+      foc_data->v_alpha += injection_alpha;
+      foc_data->v_beta += injection_beta;
+    }
+  }
+
+  return MOTOR_OK;
+}
+
+static MotorError_t foc_sensorless_update_pwm(struct Motor_t *motor) {
+  if (motor == NULL) {
+    return MOTOR_INVALID_ARGS;
+  }
+
+  struct FOCSensorlessData_t *foc_data = (struct FOCSensorlessData_t *)motor->private_data;
+
+  if (foc_data->mode == MOTOR_MODE_CATCHING || (foc_data->mode != MOTOR_MODE_RUNNING && !foc_sensorless_is_starting(foc_data))) {
+    hal_pwm_set_gates(HAL_GATES_FLOAT, 0.0f);
+    return MOTOR_OK;
+  }
+
+  /*
+   * Step 6: Space vector modulation generation
+   * A modulation index of 1 is an active vector, 2/3 of the bus voltage
+   */
+  float v_mag = sqrtf(foc_data->v_alpha * foc_data->v_alpha + foc_data->v_beta * foc_data->v_beta);
+  float modulation = (motor->state.dc_voltage > 0.0f) ? clamp(1.5f * v_mag / motor->state.dc_voltage, 0.0f, SQRT3_OVER_2) : 0.0f;
+  float duty_A, duty_B, duty_C;
+
+  svpwm_generate(atan2f(foc_data->v_beta, foc_data->v_alpha), modulation, &duty_A, &duty_B, &duty_C);
+  hal_set_pwm(&motor->config->pwm_config, duty_A, duty_B, duty_C);
+  return MOTOR_OK;
+}
+
+static MotorError_t foc_sensorless_set_voltage(struct Motor_t *motor, float voltage) {
+  if (motor == NULL) {
+    return MOTOR_INVALID_ARGS;
+  }
+  motor->setpoint.voltage = voltage;
+  motor_set_control_mode(motor, CONTROL_MODE_VOLTAGE);
+  return MOTOR_OK;
+}
+
+static MotorError_t foc_sensorless_set_current(struct Motor_t *motor, float current) {
+  if (motor == NULL) {
+    return MOTOR_INVALID_ARGS;
+  }
+  motor->setpoint.current = current;
+  motor_set_control_mode(motor, CONTROL_MODE_CURRENT);
+  return MOTOR_OK;
+}
+
+static MotorError_t foc_sensorless_set_velocity(struct Motor_t *motor, float velocity) {
+  if (motor == NULL) {
+    return MOTOR_INVALID_ARGS;
+  }
+  motor->setpoint.velocity = velocity;
+  motor_set_control_mode(motor, CONTROL_MODE_VELOCITY);
+  return MOTOR_OK;
+}
+
+static MotorError_t foc_sensorless_set_position(struct Motor_t *motor, float position) {
+  if (motor == NULL) {
+    return MOTOR_INVALID_ARGS;
+  }
+
+  /* The back-EMF observer has no absolute position and loses the angle at standstill */
+  (void)position;
+  return MOTOR_INVALID_ARGS;
+}
+
+static MotorError_t foc_sensorless_set_torque(struct Motor_t *motor, float torque) {
+  if (motor == NULL) {
+    return MOTOR_INVALID_ARGS;
+  }
+  motor->setpoint.torque = torque;
+  motor_set_control_mode(motor, CONTROL_MODE_TORQUE);
+  return MOTOR_OK;
+}
+
+/*******************************************************************************************************************************
+ * Global Driver Registration
+ *******************************************************************************************************************************/
+
+void foc_sensorless_create_driver(struct Motor_t *motor, FOCObserverType_t observer_type) {
+  if (motor == NULL) {
+    return;
+  }
+
+  motor->driver.init = foc_sensorless_init;
+  motor->driver.deinit = foc_sensorless_deinit;
+  motor->driver.update_state = foc_sensorless_update_state;
+  motor->driver.commutate = foc_sensorless_commutate;
+  motor->driver.update_pwm = foc_sensorless_update_pwm;
+  motor->driver.set_voltage = foc_sensorless_set_voltage;
+  motor->driver.set_current = foc_sensorless_set_current;
+  motor->driver.set_velocity = foc_sensorless_set_velocity;
+  motor->driver.set_position = foc_sensorless_set_position;
+  motor->driver.set_torque = foc_sensorless_set_torque;
+
+  memset(&s_foc_data.observer, 0, sizeof(s_foc_data.observer));
+
+  switch (observer_type) {
+    case OBSERVER_TYPE_BACKEMF_PLL:
+      foc_observer_backemf_pll_create_driver(&s_foc_data.observer, &s_foc_data.backemf_pll_config);
+      break;
+
+    case OBSERVER_TYPE_HFI:
+      foc_observer_hfi_create_driver(&s_foc_data.observer, &s_foc_data.hfi_config, &s_foc_data.backemf_pll_config);
+      break;
+
+    default:
+      /* No implementation yet. The driver functions stay null and init fails */
+      s_foc_data.observer.type = observer_type;
+      break;
+  }
+}
+
+void foc_sensorless_set_backemf_pll_config(const struct BackEMFPLLConfig_t *config) {
+  if (config != NULL) {
+    s_foc_data.backemf_pll_config = *config;
+  }
+}
+
+void foc_sensorless_set_hfi_config(const struct HFIObserverConfig_t *config) {
+  if (config != NULL) {
+    s_foc_data.hfi_config = *config;
+  }
+}
+
+void foc_sensorless_set_startup_config(const struct FOCSensorlessStartupConfig_t *config) {
+  if (config != NULL) {
+    s_foc_cold.startup_config = *config;
+  }
+}
+
+void foc_sensorless_set_flying_start_config(const struct FOCSensorlessFlyingStartConfig_t *config) {
+  if (config != NULL) {
+    s_foc_cold.flying_start_config = *config;
+  }
+}
@@ -12,7 +12,6 @@
 
 /* Inter-component Headers */
 #include "math_utils.h"
-#include "hal.h"
 
 /* Intra-component Headers */
 #include "foc_observer.h"
@@ -23,49 +22,78 @@ static struct BackEMFPLLData_t s_backemf_pll_data = {0};
 
 #define MIN_BEMF_MAGNITUDE (0.01f)
 
-static void calculate_back_emf(struct BackEMFPLLData_t *bemf_pll_data,
-                              float v_alpha, float v_beta,
-                              float i_alpha, float i_beta,
-                              float dt) {
-    struct BackEMFPLLConfig_t *cfg = &bemf_pll_data->config;
+/* Returns the reciprocal of the back-EMF magnitude, 0 when it is too small to carry an angle */
+static float calculate_back_emf(struct BackEMFPLLData_t *bemf_pll_data,
+                                float v_alpha, float v_beta,
+                                float i_alpha, float i_beta,
+                                float dt) {
+    const struct BackEMFPLLConfig_t *cfg = bemf_pll_data->config;
     
-    /* Calculate back-EMF using a motor model: e = v - Rs*i - Ls*di/dt */
-    /* TODO: Handle di/dt term by storing previous current reading */
-    bemf_pll_data->bemf_alpha = v_alpha - cfg->Rs * i_alpha;
-    bemf_pll_data->bemf_beta = v_beta - cfg->Rs * i_beta;
+    /*
+     * Stator model e = v - Rs*i - Ls*di/dt over the last period. The voltage is the one applied across it, so the current
+     * is taken at its midpoint and the difference of the two samples is its derivative
+     */
+    if (bemf_pll_data->has_prev_current) {
+        float ls_over_dt = cfg->Ls / dt;
+
+        bemf_pll_data->bemf_alpha = v_alpha - cfg->Rs * 0.5f * (i_alpha + bemf_pll_data->prev_i_alpha) -
+                                    ls_over_dt * (i_alpha - bemf_pll_data->prev_i_alpha);
+        bemf_pll_data->bemf_beta = v_beta - cfg->Rs * 0.5f * (i_beta + bemf_pll_data->prev_i_beta) -
+                                   ls_over_dt * (i_beta - bemf_pll_data->prev_i_beta);
+    } else {
+        /* The first update has no previous current to differentiate */
+        bemf_pll_data->bemf_alpha = v_alpha - cfg->Rs * i_alpha;
+        bemf_pll_data->bemf_beta = v_beta - cfg->Rs * i_beta;
+    }
+
+    bemf_pll_data->prev_i_alpha = i_alpha;
+    bemf_pll_data->prev_i_beta = i_beta;
+    bemf_pll_data->has_prev_current = true;
     
-    /* Calculate magnitude */
-    bemf_pll_data->bemf_magnitude = sqrtf(bemf_pll_data->bemf_alpha * bemf_pll_data->bemf_alpha + 
-                                          bemf_pll_data->bemf_beta * bemf_pll_data->bemf_beta);
+    float magnitude_squared = bemf_pll_data->bemf_alpha * bemf_pll_data->bemf_alpha + bemf_pll_data->bemf_beta * bemf_pll_data->bemf_beta;
+
+    if (magnitude_squared < MIN_BEMF_MAGNITUDE * MIN_BEMF_MAGNITUDE) {
+        bemf_pll_data->bemf_magnitude = 0.0f;
+        return 0.0f;
+    }
+
+    float inv_magnitude = fast_inv_sqrt(magnitude_squared);
+    bemf_pll_data->bemf_magnitude = magnitude_squared * inv_magnitude;
+
+    return inv_magnitude;
 }
 
-static void run_pll(struct BackEMFPLLData_t *bemf_pll_data, float dt, 
-                   float *theta_out, float *omega_out) {
-    const struct BackEMFPLLConfig_t *cfg = &bemf_pll_data->config;
-    
+static void run_pll(struct BackEMFPLLData_t *bemf_pll_data, float inv_bemf_magnitude, float dt,
+                    float *theta_out, float *omega_out) {
     /* Skip PLL if back-EMF magnitude is too small. We can assume it didn't move much */
-    if (bemf_pll_data->bemf_magnitude < MIN_BEMF_MAGNITUDE) {
+    if (inv_bemf_magnitude == 0.0f) {
         *theta_out = bemf_pll_data->pll_state.theta;
         *omega_out = bemf_pll_data->pll_state.omega;
         return;
     }
     
-    /* Calculate estimated back-EMF based on current theta */
-    float cos_theta = cosf(bemf_pll_data->pll_state.theta);
-    float sin_theta = sinf(bemf_pll_data->pll_state.theta);
-
-    /* Expected back-EMF direction */
-    float expected_bemf_alpha = -bemf_pll_data->bemf_magnitude * sin_theta;
-    float expected_bemf_beta = bemf_pll_data->bemf_magnitude * cos_theta;
+    /*
+     * The back-EMF is the mean over the last period, so it is compared against the estimate half a period on. The
+     * integrator speed is used here and for the direction, the proportional term swings its sign while acquiring
+     */
+    float sin_theta, cos_theta;
+    fast_sin_cos(bemf_pll_data->pll_state.theta + 0.5f * bemf_pll_data->pll_state.integrator * dt, &sin_theta, &cos_theta);
 
-    /* Phase error calculation (cross product) */
-    float phase_error = (bemf_pll_data->bemf_alpha * expected_bemf_beta - 
-                        bemf_pll_data->bemf_beta * expected_bemf_alpha) / 
-                       (bemf_pll_data->bemf_magnitude * bemf_pll_data->bemf_magnitude + 1e-6f);
+    /*
+     * Cross product of the unit back-EMF direction expected 90 degrees ahead of the rotor flux (d-axis) and the measured
+     * back-EMF, normalized to sin(theta_actual - theta_estimate). This is the back-EMF along the estimated d-axis
+     */
+    float phase_error = -(cos_theta * bemf_pll_data->bemf_alpha + sin_theta * bemf_pll_data->bemf_beta) * inv_bemf_magnitude;
                        
-    pll_update(&bemf_pll_data->pll_state, phase_error, hal_get_micros() - bemf_pll_data->last_pll_estimate_time, &bemf_pll_data->position_radians, &bemf_pll_data->angular_velocity);
+    /* Reverse rotation flips the back-EMF onto the negative q-axis */
+    if (bemf_pll_data->pll_state.integrator < 0.0f) {
+        phase_error = -phase_error;
+    }
 
-    bemf_pll_data->last_pll_estimate_time = hal_get_micros();
+    pll_update(&bemf_pll_data->pll_state, phase_error, dt, &bemf_pll_data->position_radians, &bemf_pll_data->angular_velocity);
+
+    *theta_out = bemf_pll_data->position_radians;
+    *omega_out = bemf_pll_data->angular_velocity;
 }
 
 static MotorError_t foc_observer_backemf_pll_init(struct FOCObserver_t *observer) {
@@ -79,13 +107,20 @@ static MotorError_t foc_observer_backemf_pll_init(struct FOCObserver_t *observer
     bemf_pll_data->bemf_alpha = 0.0f;
     bemf_pll_data->bemf_beta = 0.0f;
     bemf_pll_data->bemf_magnitude = 0.0f;
+    bemf_pll_data->prev_i_alpha = 0.0f;
+    bemf_pll_data->prev_i_beta = 0.0f;
+    bemf_pll_data->has_prev_current = false;
     bemf_pll_data->update_count = 0;
     bemf_pll_data->position_radians = 0.0f;
     bemf_pll_data->angular_velocity = 0.0f;
     bemf_pll_data->is_initialized = true;
-    bemf_pll_data->last_pll_estimate_time = hal_get_micros();
 
     pll_init(&bemf_pll_data->pll_state, &bemf_pll_data->config->pll_cfg);
+
+    observer->estimated_theta = 0.0f;
+    observer->estimated_omega = 0.0f;
+    observer->prev_theta = 0.0f;
+    observer->prev_omega = 0.0f;
     
     return MOTOR_OK;
 }
@@ -110,11 +145,16 @@ static MotorError_t foc_observer_backemf_pll_update(struct FOCObserver_t *observ
     }
     
     /* Calculate back-EMF */
-    calculate_back_emf(bemf_pll_data, v_alpha, v_beta, i_alpha, i_beta, dt);
+    float inv_bemf_magnitude = calculate_back_emf(bemf_pll_data, v_alpha, v_beta, i_alpha, i_beta, dt);
     
     /* Run PLL algorithm */
-    run_pll(bemf_pll_data, dt, theta_out, omega_out);
+    run_pll(bemf_pll_data, inv_bemf_magnitude, dt, theta_out, omega_out);
     
+    observer->prev_theta = observer->estimated_theta;
+    observer->prev_omega = observer->estimated_omega;
+    observer->estimated_theta = *theta_out;
+    observer->estimated_omega = *omega_out;
+
     /* Increment update counter */
     bemf_pll_data->update_count++;
     
@@ -130,10 +170,14 @@ static MotorError_t foc_observer_backemf_pll_reset(struct FOCObserver_t *observe
     
     /* Reset dynamic state variables but keep configuration */
     bemf_pll_data->pll_state.integrator = 0.0f;
+    bemf_pll_data->pll_state.acceleration = 0.0f;
     bemf_pll_data->pll_state.prev_error = 0.0f;
+    bemf_pll_data->pll_state.filtered_error = MATH_TWO_PI;
+    bemf_pll_data->pll_state.is_converged = false;
     bemf_pll_data->bemf_alpha = 0.0f;
     bemf_pll_data->bemf_beta = 0.0f;
     bemf_pll_data->bemf_magnitude = 0.0f;
+    bemf_pll_data->has_prev_current = false;
     bemf_pll_data->pll_state.theta = 0.0f;
     bemf_pll_data->pll_state.omega = 0.0f;
     bemf_pll_data->update_count = 0;
@@ -165,3 +209,73 @@ MotorError_t foc_observer_backemf_pll_create_driver(struct FOCObserver_t *observ
 
     return MOTOR_OK;
 }
+
+MotorError_t foc_observer_backemf_pll_get_status(const struct FOCObserver_t *observer,
+                                                 bool *is_converged,
+                                                 uint32_t *update_count,
+                                                 float *max_error) {
+    if (observer == NULL || is_converged == NULL || update_count == NULL || max_error == NULL) {
+        return MOTOR_INVALID_ARGS;
+    }
+
+    const struct BackEMFPLLData_t *bemf_pll_data = (const struct BackEMFPLLData_t *)observer->private_data;
+
+    if (!bemf_pll_data->is_initialized) {
+        return MOTOR_UNINITIALIZED;
+    }
+
+    /* Below min_speed the back-EMF is too small against the resistive drop to trust the lock */
+    *is_converged = bemf_pll_data->pll_state.is_converged && (fabsf(bemf_pll_data->pll_state.omega) >= bemf_pll_data->config->min_speed);
+    *update_count = bemf_pll_data->update_count;
+    *max_error = bemf_pll_data->pll_state.max_error;
+
+    return MOTOR_OK;
+}
+
+MotorError_t foc_observer_backemf_pll_get_bemf(const struct FOCObserver_t *observer,
+                                               float *bemf_alpha,
+                                               float *bemf_beta,
+                                               float *bemf_mag) {
+    if (observer == NULL || bemf_alpha == NULL || bemf_beta == NULL || bemf_mag == NULL) {
+        return MOTOR_INVALID_ARGS;
+    }
+
+    const struct BackEMFPLLData_t *bemf_pll_data = (const struct BackEMFPLLData_t *)observer->private_data;
+
+    if (!bemf_pll_data->is_initialized) {
+        return MOTOR_UNINITIALIZED;
+    }
+
+    *bemf_alpha = bemf_pll_data->bemf_alpha;
+    *bemf_beta = bemf_pll_data->bemf_beta;
+    *bemf_mag = bemf_pll_data->bemf_magnitude;
+
+    return MOTOR_OK;
+}
+
+MotorError_t foc_observer_backemf_pll_seed(struct FOCObserver_t *observer, float theta, float omega) {
+    if (observer == NULL) {
+        return MOTOR_INVALID_ARGS;
+    }
+
+    struct BackEMFPLLData_t *bemf_pll_data = (struct BackEMFPLLData_t *)observer->private_data;
+
+    if (!bemf_pll_data->is_initialized) {
+        return MOTOR_UNINITIALIZED;
+    }
+
+    /* The integrator holds the speed once the phase error settles */
+    bemf_pll_data->pll_state.theta = normalize_angle(theta);
+    bemf_pll_data->pll_state.omega = omega;
+    bemf_pll_data->pll_state.integrator = omega;
+    bemf_pll_data->pll_state.acceleration = 0.0f;
+    bemf_pll_data->pll_state.filtered_error = MATH_TWO_PI;
+    bemf_pll_data->pll_state.is_converged = false;
+    bemf_pll_data->position_radians = bemf_pll_data->pll_state.theta;
+    bemf_pll_data->angular_velocity = omega;
+
+    observer->estimated_theta = bemf_pll_data->pll_state.theta;
+    observer->estimated_omega = omega;
+
+    return MOTOR_OK;
+}
@@ -0,0 +1,381 @@
+/*******************************************************************************************************************************
+ * @file   hfi_observer.c
+ *
+ * @brief  Source file for FOC high-frequency injection observer
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stddef.h>
+
+/* Inter-component Headers */
+#include "math_utils.h"
+
+/* Intra-component Headers */
+#include "backemf_pll_observer.h"
+#include "foc_observer.h"
+#include "hfi_observer.h"
+
+/* Static instance for private data */
+static struct HFIObserverData_t s_hfi_data = {0};
+
+#define SPEED_FILTER_TIME_CONST (0.005f) /**< Averaging of the tracker speed the blend weight follows [s] */
+
+/* Weight of the back-EMF observer at the filtered speed, 0 below the crossover band and 1 above it */
+static float calculate_blend(const struct HFIObserverData_t *hfi_data) {
+    const struct HFIObserverConfig_t *cfg = hfi_data->config;
+
+    return clamp((fabsf(hfi_data->filtered_omega) - cfg->crossover_low) / (cfg->crossover_high - cfg->crossover_low), 0.0f, 1.0f);
+}
+
+static void set_tracker(struct HFIObserverData_t *hfi_data, float theta, float omega) {
+    hfi_data->pll_state.theta = normalize_angle(theta);
+    hfi_data->pll_state.omega = omega;
+    hfi_data->pll_state.integrator = omega;
+    hfi_data->pll_state.acceleration = 0.0f;
+    hfi_data->hfi_theta = hfi_data->pll_state.theta;
+    hfi_data->hfi_omega = omega;
+}
+
+/*
+ * Over one period a pulse a moves the current by a * T * inv(L) * v_h. Two periods apart the fundamental change cancels and
+ * the carrier response is left, scaled by the pulse difference. Along the estimated q-axis a full pulse gives
+ * V_h * T * (1/Ld - 1/Lq) / 2 * sin(2 * error)
+ */
+static void demodulate_carrier(struct HFIObserverData_t *hfi_data, float di_alpha, float di_beta, float dt) {
+    const struct HFIObserverConfig_t *cfg = hfi_data->config;
+    float sin_theta, cos_theta;
+    float pulse_step = hfi_data->carrier_pulse - hfi_data->prev_carrier_pulse;
+
+    float response_alpha = (di_alpha - hfi_data->prev_di_alpha) / pulse_step;
+    float response_beta = (di_beta - hfi_data->prev_di_beta) / pulse_step;
+
+    /* The carrier of the last period was injected along the current estimate */
+    fast_sin_cos(hfi_data->pll_state.theta, &sin_theta, &cos_theta);
+
+    /* Scaled to 0.5 * sin(2 * error), which follows the error for small angles */
+    float response_q = -sin_theta * response_alpha + cos_theta * response_beta;
+    float phase_error = response_q / (cfg->injection_voltage * dt * (1.0f / cfg->Ld - 1.0f / cfg->Lq));
+
+    float theta, omega;
+    pll_update(&hfi_data->pll_state, phase_error, dt, &theta, &omega);
+
+    /* The integrator carries the speed without the error noise of the proportional path */
+    hfi_data->hfi_theta = theta;
+    hfi_data->hfi_omega = hfi_data->pll_state.integrator;
+}
+
+/*
+ * The mean of two samples cancels the ripple while the level swings between -0.5 and 0.5. A half pulse starting or
+ * stopping the carrier leaves a quarter of a pulse response in it, taken off with the d-axis response of a locked rotor
+ */
+static void remove_carrier_ripple(struct HFIObserverData_t *hfi_data, float i_alpha, float i_beta, float dt) {
+    float prev_level = hfi_data->carrier_level - hfi_data->carrier_pulse;
+
+    if (!hfi_data->has_prev_current || (hfi_data->carrier_level == 0.0f && prev_level == 0.0f)) {
+        hfi_data->fundamental_alpha = i_alpha;
+        hfi_data->fundamental_beta = i_beta;
+        return;
+    }
+
+    float sin_theta, cos_theta;
+    fast_sin_cos(hfi_data->pll_state.theta, &sin_theta, &cos_theta);
+
+    float offset = 0.5f * (hfi_data->carrier_level + prev_level) * hfi_data->config->injection_voltage * dt / hfi_data->config->Ld;
+
+    hfi_data->fundamental_alpha = 0.5f * (i_alpha + hfi_data->prev_i_alpha) - offset * cos_theta;
+    hfi_data->fundamental_beta = 0.5f * (i_beta + hfi_data->prev_i_beta) - offset * sin_theta;
+}
+
+static void set_injection(struct HFIObserverData_t *hfi_data) {
+    float sin_theta, cos_theta;
+    fast_sin_cos(hfi_data->pll_state.theta, &sin_theta, &cos_theta);
+
+    hfi_data->injection_alpha = hfi_data->carrier_pulse * hfi_data->config->injection_voltage * cos_theta;
+    hfi_data->injection_beta = hfi_data->carrier_pulse * hfi_data->config->injection_voltage * sin_theta;
+}
+
+/* Next period pulse along the injection tracker d-axis. Stopping returns the ripple to the fundamental with a half pulse */
+static void update_carrier(struct HFIObserverData_t *hfi_data, bool is_injecting) {
+    float level = 0.0f;
+
+    if (is_injecting) {
+        level = (hfi_data->carrier_level > 0.0f) ? -0.5f : 0.5f;
+    }
+
+    hfi_data->prev_carrier_pulse = hfi_data->carrier_pulse;
+    hfi_data->carrier_pulse = level - hfi_data->carrier_level;
+    hfi_data->carrier_level = level;
+
+    set_injection(hfi_data);
+}
+
+static MotorError_t foc_observer_hfi_init(struct FOCObserver_t *observer) {
+    if (observer == NULL) {
+        return MOTOR_INVALID_ARGS;
+    }
+
+    struct HFIObserverData_t *hfi_data = (struct HFIObserverData_t *)observer->private_data;
+    const struct HFIObserverConfig_t *cfg = hfi_data->config;
+
+    /* Without saliency the carrier response carries no angle */
+    if (cfg->Ld <= 0.0f || cfg->Lq <= 0.0f || cfg->Ld == cfg->Lq || cfg->injection_voltage <= 0.0f ||
+        cfg->crossover_high <= cfg->crossover_low) {
+        return MOTOR_INVALID_ARGS;
+    }
+
+    if (hfi_data->backemf_observer.driver.init(&hfi_data->backemf_observer) != MOTOR_OK) {
+        return MOTOR_INIT_ERROR;
+    }
+
+    /* Reset all state variables */
+    hfi_data->injection_alpha = 0.0f;
+    hfi_data->injection_beta = 0.0f;
+    hfi_data->carrier_pulse = 0.0f;
+    hfi_data->prev_carrier_pulse = 0.0f;
+    hfi_data->carrier_level = 0.0f;
+    hfi_data->prev_i_alpha = 0.0f;
+    hfi_data->prev_i_beta = 0.0f;
+    hfi_data->prev_di_alpha = 0.0f;
+    hfi_data->prev_di_beta = 0.0f;
+    hfi_data->fundamental_alpha = 0.0f;
+    hfi_data->fundamental_beta = 0.0f;
+    hfi_data->hfi_theta = 0.0f;
+    hfi_data->hfi_omega = 0.0f;
+    hfi_data->filtered_omega = 0.0f;
+    hfi_data->blend = 0.0f;
+    hfi_data->has_prev_current = false;
+    hfi_data->has_prev_delta = false;
+    hfi_data->update_count = 0;
+    hfi_data->is_initialized = true;
+
+    pll_init(&hfi_data->pll_state, &hfi_data->config->pll_cfg);
+
+    /* Injecting from the first update, the tracker moves once a full pulse has followed the half pulse */
+    update_carrier(hfi_data, true);
+
+    observer->estimated_theta = 0.0f;
+    observer->estimated_omega = 0.0f;
+    observer->prev_theta = 0.0f;
+    observer->prev_omega = 0.0f;
+
+    return MOTOR_OK;
+}
+
+static MotorError_t foc_observer_hfi_update(struct FOCObserver_t *observer,
+                                            float v_alpha, float v_beta,
+                                            float i_alpha, float i_beta,
+                                            float dt,
+                                            float *theta_out, float *omega_out) {
+    if (observer == NULL || theta_out == NULL || omega_out == NULL) {
+        return MOTOR_INVALID_ARGS;
+    }
+
+    if (dt <= 0.0f) {
+        return MOTOR_INVALID_ARGS;
+    }
+
+    struct HFIObserverData_t *hfi_data = (struct HFIObserverData_t *)observer->private_data;
+
+    if (!hfi_data->is_initialized) {
+        return MOTOR_UNINITIALIZED;
+    }
+
+    remove_carrier_ripple(hfi_data, i_alpha, i_beta, dt);
+
+    /* The back-EMF observer only sees the fundamental, the carrier would swamp its inductive drop */
+    float bemf_theta, bemf_omega;
+    MotorError_t status = hfi_data->backemf_observer.driver.update(&hfi_data->backemf_observer,
+                                                                   v_alpha - hfi_data->injection_alpha, v_beta - hfi_data->injection_beta,
+                                                                   hfi_data->fundamental_alpha, hfi_data->fundamental_beta,
+                                                                   dt, &bemf_theta, &bemf_omega);
+    if (status != MOTOR_OK) {
+        return status;
+    }
+
+    /* Demodulate across a full pulse step, the half pulses starting and stopping the carrier only move the level */
+    float di_alpha = i_alpha - hfi_data->prev_i_alpha;
+    float di_beta = i_beta - hfi_data->prev_i_beta;
+
+    if (hfi_data->has_prev_delta && fabsf(hfi_data->carrier_pulse - hfi_data->prev_carrier_pulse) >= 1.0f) {
+        demodulate_carrier(hfi_data, di_alpha, di_beta, dt);
+    } else if (hfi_data->carrier_pulse == 0.0f && hfi_data->carrier_level == 0.0f) {
+        /* Above the band the tracker follows the back-EMF observer, so the injection restarts on the right axis */
+        set_tracker(hfi_data, bemf_theta, bemf_omega);
+    }
+
+    hfi_data->prev_i_alpha = i_alpha;
+    hfi_data->prev_i_beta = i_beta;
+    hfi_data->prev_di_alpha = di_alpha;
+    hfi_data->prev_di_beta = di_beta;
+    hfi_data->has_prev_delta = hfi_data->has_prev_current;
+    hfi_data->has_prev_current = true;
+
+    /* Blend from the injection tracker to the back-EMF observer across the crossover band */
+    hfi_data->blend = calculate_blend(hfi_data);
+
+    float angle_error = normalize_angle(bemf_theta - hfi_data->hfi_theta + MATH_PI) - MATH_PI;
+    *theta_out = normalize_angle(hfi_data->hfi_theta + hfi_data->blend * angle_error);
+    *omega_out = hfi_data->hfi_omega + hfi_data->blend * (bemf_omega - hfi_data->hfi_omega);
+
+    /*
+     * The weight follows the tracker rather than the output, which would feed a low speed back-EMF estimate back into its
+     * own weight. Above the band the tracker follows the back-EMF observer
+     */
+    hfi_data->filtered_omega += (dt / (SPEED_FILTER_TIME_CONST + dt)) * (hfi_data->hfi_omega - hfi_data->filtered_omega);
+
+    float next_blend = calculate_blend(hfi_data);
+
+    /* Below the band the back-EMF estimate is meaningless, it is held on the tracker so it is ready once the speed rises */
+    if (next_blend <= 0.0f) {
+        foc_observer_backemf_pll_seed(&hfi_data->backemf_observer, hfi_data->hfi_theta, hfi_data->hfi_omega);
+    }
+
+    update_carrier(hfi_data, next_blend < 1.0f);
+
+    observer->prev_theta = observer->estimated_theta;
+    observer->prev_omega = observer->estimated_omega;
+    observer->estimated_theta = *theta_out;
+    observer->estimated_omega = *omega_out;
+
+    /* Increment update counter */
+    hfi_data->update_count++;
+
+    return MOTOR_OK;
+}
+
+static MotorError_t foc_observer_hfi_reset(struct FOCObserver_t *observer) {
+    if (observer == NULL) {
+        return MOTOR_INVALID_ARGS;
+    }
+
+    struct HFIObserverData_t *hfi_data = (struct HFIObserverData_t *)observer->private_data;
+
+    /* Reset dynamic state variables but keep configuration */
+    hfi_data->pll_state.integrator = 0.0f;
+    hfi_data->pll_state.acceleration = 0.0f;
+    hfi_data->pll_state.prev_error = 0.0f;
+    hfi_data->pll_state.filtered_error = MATH_TWO_PI;
+    hfi_data->pll_state.is_converged = false;
+    hfi_data->pll_state.theta = 0.0f;
+    hfi_data->pll_state.omega = 0.0f;
+    hfi_data->injection_alpha = 0.0f;
+    hfi_data->injection_beta = 0.0f;
+    hfi_data->carrier_pulse = 0.0f;
+    hfi_data->prev_carrier_pulse = 0.0f;
+    hfi_data->carrier_level = 0.0f;
+    hfi_data->has_prev_current = false;
+    hfi_data->has_prev_delta = false;
+    hfi_data->hfi_theta = 0.0f;
+    hfi_data->hfi_omega = 0.0f;
+    hfi_data->filtered_omega = 0.0f;
+    hfi_data->blend = 0.0f;
+    hfi_data->update_count = 0;
+
+    return hfi_data->backemf_observer.driver.reset(&hfi_data->backemf_observer);
+}
+
+MotorError_t foc_observer_hfi_create_driver(struct FOCObserver_t *observer, struct HFIObserverConfig_t *config,
+                                            struct BackEMFPLLConfig_t *backemf_config) {
+    if (observer == NULL || config == NULL || backemf_config == NULL) {
+        return MOTOR_INVALID_ARGS;
+    }
+
+    /* Set up driver function pointers */
+    observer->driver.init = foc_observer_hfi_init;
+    observer->driver.update = foc_observer_hfi_update;
+    observer->driver.reset = foc_observer_hfi_reset;
+
+    /* Set observer type */
+    observer->type = OBSERVER_TYPE_HFI;
+
+    /* Point private data to static instance */
+    observer->private_data = &s_hfi_data;
+
+    /* Store configuration */
+    s_hfi_data.config = config;
+
+    /* Initialize state */
+    s_hfi_data.is_initialized = false;
+
+    return foc_observer_backemf_pll_create_driver(&s_hfi_data.backemf_observer, backemf_config);
+}
+
+MotorError_t foc_observer_hfi_get_injection(const struct FOCObserver_t *observer, float *v_alpha, float *v_beta) {
+    if (observer == NULL || v_alpha == NULL || v_beta == NULL) {
+        return MOTOR_INVALID_ARGS;
+    }
+
+    const struct HFIObserverData_t *hfi_data = (const struct HFIObserverData_t *)observer->private_data;
+
+    if (!hfi_data->is_initialized) {
+        return MOTOR_UNINITIALIZED;
+    }
+
+    *v_alpha = hfi_data->injection_alpha;
+    *v_beta = hfi_data->injection_beta;
+
+    return MOTOR_OK;
+}
+
+MotorError_t foc_observer_hfi_get_fundamental_current(const struct FOCObserver_t *observer, float *i_alpha, float *i_beta) {
+    if (observer == NULL || i_alpha == NULL || i_beta == NULL) {
+        return MOTOR_INVALID_ARGS;
+    }
+
+    const struct HFIObserverData_t *hfi_data = (const struct HFIObserverData_t *)observer->private_data;
+
+    if (!hfi_data->is_initialized) {
+        return MOTOR_UNINITIALIZED;
+    }
+
+    *i_alpha = hfi_data->fundamental_alpha;
+    *i_beta = hfi_data->fundamental_beta;
+
+    return MOTOR_OK;
+}
+
+MotorError_t foc_observer_hfi_get_blend(const struct FOCObserver_t *observer, float *blend) {
+    if (observer == NULL || blend == NULL) {
+        return MOTOR_INVALID_ARGS;
+    }
+
+    const struct HFIObserverData_t *hfi_data = (const struct HFIObserverData_t *)observer->private_data;
+
+    if (!hfi_data->is_initialized) {
+        return MOTOR_UNINITIALIZED;
+    }
+
+    *blend = hfi_data->blend;
+
+    return MOTOR_OK;
+}
+
+MotorError_t foc_observer_hfi_seed(struct FOCObserver_t *observer, float theta, float omega) {
+    if (observer == NULL) {
+        return MOTOR_INVALID_ARGS;
+    }
+
+    struct HFIObserverData_t *hfi_data = (struct HFIObserverData_t *)observer->private_data;
+
+    if (!hfi_data->is_initialized) {
+        return MOTOR_UNINITIALIZED;
+    }
+
+    set_tracker(hfi_data, theta, omega);
+    hfi_data->pll_state.filtered_error = MATH_TWO_PI;
+    hfi_data->pll_state.is_converged = false;
+    hfi_data->filtered_omega = omega;
+    hfi_data->blend = calculate_blend(hfi_data);
+
+    /* The pending pulse turns onto the seeded axis, the current change before it does not demodulate against it */
+    hfi_data->has_prev_delta = false;
+    set_injection(hfi_data);
+
+    observer->estimated_theta = hfi_data->pll_state.theta;
+    observer->estimated_omega = omega;
+
+    return foc_observer_backemf_pll_seed(&hfi_data->backemf_observer, theta, omega);
+}
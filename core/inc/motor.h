@@ -25,6 +25,29 @@
  * @{
  */
 
+/**
+ * @brief   Alignment of the control state a cycle touches, a cache line
+ */
+#define MOTOR_HOT_ALIGNMENT 64U
+
+/**
+ * @brief   Bus voltage, relative to max_voltage, above which the drivers report an overvoltage
+ * @details max_voltage is the nominal bus. The margin keeps ADC noise and supply ripple from tripping the check
+ */
+#define MOTOR_BUS_OVERVOLTAGE_RATIO 1.1f
+
+/**
+ * @brief   Placement of a motor and the per-cycle private data of its driver
+ * @details Building with MOTOR_HOT_SECTION set to a section name, such as ".dtcm", puts them in that section so a
+ *          linker script can map it to tightly-coupled memory. The section then needs the same startup copy as .data.
+ *          Configuration only read outside the control cycle is kept in separate objects without this attribute
+ */
+#ifdef MOTOR_HOT_SECTION
+#define MOTOR_HOT_DATA __attribute__((section(MOTOR_HOT_SECTION), aligned(MOTOR_HOT_ALIGNMENT)))
+#else
+#define MOTOR_HOT_DATA __attribute__((aligned(MOTOR_HOT_ALIGNMENT)))
+#endif
+
 struct Motor_t;
 
 /**
@@ -83,26 +106,31 @@ struct MotorConfig_t {
   float phase_resistance;                 /**< Phase resistance */
   float phase_inductance;                 /**< Phase inductance */
   float max_current;                      /**< Maximum current */
-  float max_voltage;                      /**< Maximum voltage */
+  float max_voltage;                      /**< Nominal bus voltage (V) */
   float max_velocity;                     /**< Maximum velocity */
   float min_startup_speed;                /**< Minimum startup speed */
   float torque_constant;                  /**< Torque constant of the motor (Nm/A) */
   struct PidConfig_t current_pid_config;  /**< Current PID Configuration */
   struct PidConfig_t voltage_pid_config;  /**< Voltage PID Configuration */
   struct PidConfig_t velocity_pid_config; /**< Velocity PID Configuration */
+  struct PidConfig_t position_pid_config; /**< Position PID Configuration */
+  bool velocity_loop_per_commutation;     /**< 6-step only: run the velocity PID once per new commutation period instead of every tick */
 
   struct PwmConfig_t pwm_config;
   struct AdcConfig_t adc_config;
 };
 
+/**
+ * @brief   Motor driver function table, the calls made by motor_run() come first
+ */
 struct MotorDriver_t {
-  MotorError_t (*init)(struct Motor_t *motor, struct MotorConfig_t *config); /**< Motor initializer */
-  MotorError_t (*deinit)(struct Motor_t *motor);                             /**< Motor deinitializer */
-
   MotorError_t (*update_state)(struct Motor_t *motor); /**< Update motor state */
   MotorError_t (*commutate)(struct Motor_t *motor);    /**< Commutate motor */
   MotorError_t (*update_pwm)(struct Motor_t *motor);   /**< Update motor PWM */
 
+  MotorError_t (*init)(struct Motor_t *motor, struct MotorConfig_t *config); /**< Motor initializer, keeps the config pointer */
+  MotorError_t (*deinit)(struct Motor_t *motor);                             /**< Motor deinitializer */
+
   MotorError_t (*set_voltage)(struct Motor_t *motor, float voltage);   /**< Update voltage setpoint */
   MotorError_t (*set_current)(struct Motor_t *motor, float current);   /**< Update current setpoint */
   MotorError_t (*set_velocity)(struct Motor_t *motor, float velocity); /**< Update velocity setpoint */
@@ -116,12 +144,25 @@ struct MotorDriver_t {
 
 /**
  * @brief   Motor storage class
+ * @details The members a control cycle touches come first, from state to private_data, followed by the calls of
+ *          motor_run() at the head of the driver table. The configuration stays behind its pointer and is not read by
+ *          the control cycle: params and the PID controllers hold copies of what it needs
  */
 struct Motor_t {
-  struct MotorConfig_t *config; /**< Pointer to the motor configuration class */
-  struct MotorDriver_t driver;  /**< Motor driver */
-  struct MotorState_t state;    /**< Motor state */
-  MotorError_t motor_error;     /**< Motor error tracker */
+  struct MotorState_t state; /**< Motor state */
+
+  /**
+   * @brief   Configuration scalars read by the control cycle, copied from the configuration by motor_reload_config()
+   */
+  struct {
+    ControlMode_t control_mode;         /**< Motor control mode, follows the setpoint setters */
+    uint8_t pole_pairs;                 /**< Number of pole pairs */
+    bool velocity_loop_per_commutation; /**< 6-step only: run the velocity PID once per new commutation period */
+    float max_current;                  /**< Maximum current */
+    float max_voltage;                  /**< Nominal bus voltage (V) */
+    float max_velocity;                 /**< Maximum velocity */
+    float torque_constant;              /**< Torque constant of the motor (Nm/A) */
+  } params;
 
   /**
    * @brief   Control loop setpoints
@@ -143,7 +184,16 @@ struct Motor_t {
     struct PidController_t position; /**< Position PID controller */
   } control;
 
-  void *private_data; /**< Private data for motor-specific data */
+  MotorError_t motor_error; /**< Motor error tracker */
+  void *private_data;       /**< Private data for motor-specific data */
+
+  /**
+   * @brief   Pointer to the motor configuration class, taken by the driver init function
+   * @details The driver copies the configuration when it is initialized. Changes made to it afterwards take effect
+   *          once motor_reload_config() is called
+   */
+  struct MotorConfig_t *config;
+  struct MotorDriver_t driver; /**< Motor driver */
 };
 
 /**
@@ -151,4 +201,21 @@ struct Motor_t {
  */
 MotorError_t motor_run(struct Motor_t *motor);
 
+/**
+ * @brief   Copy the motor configuration into params and the PID controllers again
+ * @details Called by the driver init functions. Call it after writing to the configuration of an initialized motor,
+ *          the integrator states are kept
+ * @param   motor Pointer to the motor storage class
+ * @return  MOTOR_OK on success, MOTOR_INVALID_ARGS without a motor or configuration
+ */
+MotorError_t motor_reload_config(struct Motor_t *motor);
+
+/**
+ * @brief   Select the control mode in both the configuration and params
+ * @details Used by the driver setpoint setters
+ * @param   motor Pointer to the motor storage class
+ * @param   control_mode Control mode to run
+ */
+void motor_set_control_mode(struct Motor_t *motor, ControlMode_t control_mode);
+
 /** @} */
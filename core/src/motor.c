@@ -39,4 +39,33 @@ MotorError_t motor_run(struct Motor_t *motor) {
   }
 
   return MOTOR_OK;
-}
\ No newline at end of file
+}
+
+MotorError_t motor_reload_config(struct Motor_t *motor) {
+  if (motor == NULL || motor->config == NULL) {
+    return MOTOR_INVALID_ARGS;
+  }
+
+  motor->params.control_mode = motor->config->control_mode;
+  motor->params.pole_pairs = motor->config->pole_pairs;
+  motor->params.velocity_loop_per_commutation = motor->config->velocity_loop_per_commutation;
+  motor->params.max_current = motor->config->max_current;
+  motor->params.max_voltage = motor->config->max_voltage;
+  motor->params.max_velocity = motor->config->max_velocity;
+  motor->params.torque_constant = motor->config->torque_constant;
+
+  pid_reload_config(&motor->control.current);
+  pid_reload_config(&motor->control.velocity);
+  pid_reload_config(&motor->control.position);
+
+  return MOTOR_OK;
+}
+
+void motor_set_control_mode(struct Motor_t *motor, ControlMode_t control_mode) {
+  if (motor == NULL || motor->config == NULL) {
+    return;
+  }
+
+  motor->config->control_mode = control_mode;
+  motor->params.control_mode = control_mode;
+}
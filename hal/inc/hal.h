@@ -33,6 +33,19 @@ typedef enum {
   NUM_MOTOR_PHASES
 } MotorPhase_t;
 
+/**
+ * @brief   Gate state bits for hal_pwm_set_gates(), three per phase
+ * @details HAL_GATE_HIGH() or HAL_GATE_LOW() alone holds that switch on. Adding HAL_GATE_PWM() switches it at the duty
+ *          cycle, the freewheel current then flows through the opposite body diode during the off-time. HIGH, LOW and PWM
+ *          together drive the leg complementary: the high side at the duty cycle and the low side, after the dead time, for
+ *          the rest of the period. A phase without bits floats. HIGH and LOW without PWM would short the bus, implementations
+ *          float the phase instead
+ */
+#define HAL_GATE_HIGH(phase) ((uint16_t)(1U << (2U * (uint16_t)(phase))))
+#define HAL_GATE_LOW(phase) ((uint16_t)(2U << (2U * (uint16_t)(phase))))
+#define HAL_GATE_PWM(phase) ((uint16_t)(1U << (6U + (uint16_t)(phase))))
+#define HAL_GATES_FLOAT 0x0000U
+
 /**
  * @brief   PWM configuration structure
  */
@@ -54,6 +67,19 @@ struct AdcConfig_t {
   float voltage_gain;     /**< Voltage sensor gain (V/V) */
 };
 
+/**
+ * @brief   Hall sensor transition captured by a timer input capture channel
+ */
+struct HallEdge_t {
+  uint32_t timestamp_us; /**< Capture timer value at the transition (microseconds, same base as hal_get_micros) */
+  uint8_t hall_state;    /**< Hall state after the transition as 0bHallA_MSB HallB_MID HallC_LSB */
+};
+
+/**
+ * @brief   Callback run by the one-shot timer
+ */
+typedef void (*HalTimerCallback_t)(void *context);
+
 /**
  * @brief   Initialize the PWM interface
  * @param   config Pointer to the PWM config
@@ -83,16 +109,61 @@ void hal_gpio_set_phase_low(MotorPhase_t phase);
 
 void hal_gpio_set_phase_float(MotorPhase_t phase);
 
-void hal_pwm_set_duty(MotorPhase_t phase, uint16_t duty);
+/**
+ * @brief   Drive the high side of a phase with PWM
+ * @param   phase Motor phase
+ * @param   duty Duty cycle (0.0 to 1.0)
+ */
+void hal_pwm_set_duty(MotorPhase_t phase, float duty);
+
+/**
+ * @brief   Apply the gate states of all three phases and the high side duty cycle in one update
+ * @details On target this is a single preloaded write of the timer output enable and compare registers, so the bridge
+ *          never sees a partially applied commutation
+ * @param   gate_mask HAL_GATE_HIGH(), HAL_GATE_LOW() and HAL_GATE_PWM() bits of the three phases
+ * @param   duty On-time fraction of the modulated switches (0.0 to 1.0)
+ */
+void hal_pwm_set_gates(uint16_t gate_mask, float duty);
 
 uint32_t hal_get_micros();
 
+/**
+ * @brief   Arm the one-shot timer
+ * @details Re-arming replaces a pending deadline. The callback runs in interrupt context on target
+ * @param   fire_time_us Timestamp to fire at, on the hal_get_micros() time base. A deadline in the past fires immediately
+ * @param   callback Function called when the timer fires
+ * @param   context Argument passed to the callback
+ * @return  TRUE if the timer was armed
+ *          FALSE if the callback is null or no timer is available
+ */
+bool hal_timer_schedule(uint32_t fire_time_us, HalTimerCallback_t callback, void *context);
+
+/**
+ * @brief   Cancel a pending one-shot timer deadline
+ */
+void hal_timer_cancel();
+
 void hal_delay_us(uint32_t delay_us);
 
 void hal_delay_ms(uint32_t delay_ms);
 
 void hal_adc_start_conversion();
 
+/**
+ * @brief   Trigger the phase voltage conversions at a fixed point of the PWM on-time
+ * @details Sampling inside the on-time keeps the conducting phases at the bus rails and away from the switching edges
+ * @param   on_time_fraction Position of the sample inside the high side on-time (0.0 at the rising edge, 1.0 at the falling edge)
+ * @return  TRUE if the trigger was configured
+ *          FALSE if the fraction is out of range or the ADC cannot be synchronized to the PWM
+ */
+bool hal_adc_set_pwm_trigger(float on_time_fraction);
+
+/**
+ * @brief   Read the phase terminal voltages
+ * @details A conducting high side puts its terminal at the bus, plus ringing after the switching edge. Limits apply to
+ *          hal_adc_get_dc_voltage()
+ * @param   voltages Pointer to store the 3 phase voltages, referenced to the negative DC rail (V)
+ */
 void hal_adc_get_phase_voltages(float *voltages);
 
 void hal_adc_get_phase_currents(float *currents);
@@ -103,8 +174,49 @@ float hal_adc_get_temperature();
 
 bool hal_gpio_init_hall_sensors();
 
+/**
+ * @brief   Read the Hall sensor inputs
+ * @return  Hall state as 0bHallA_MSB HallB_MID HallC_LSB
+ */
 uint8_t hal_gpio_get_hall_state();
 
+/**
+ * @brief   Start timestamping Hall transitions into the capture queue
+ * @details The capture queue is flushed. If it overflows the oldest edges are dropped so the newest Hall state is kept
+ * @return  TRUE if initialization succeeds
+ *          FALSE if initialization fails
+ */
+bool hal_hall_capture_init();
+
+/**
+ * @brief   Pop the oldest captured Hall transition
+ * @param   edge Pointer to store the captured edge
+ * @return  TRUE if an edge was dequeued
+ *          FALSE if the queue is empty
+ */
+bool hal_hall_capture_pop(struct HallEdge_t *edge);
+
 bool hal_encoder_init();
 
+/**
+ * @brief   Read the encoder position
+ * @return  Mechanical rotor angle in radians
+ */
+float hal_encoder_get_position();
+
+/**
+ * @brief   Read the encoder velocity
+ * @return  Mechanical rotor velocity in radians per second
+ */
+float hal_encoder_get_velocity();
+
+/**
+ * @brief   Apply center-aligned PWM to all three phases with complementary outputs
+ * @param   config Pointer to the PWM config
+ * @param   duty_a Phase A duty cycle (0.0 to 1.0)
+ * @param   duty_b Phase B duty cycle (0.0 to 1.0)
+ * @param   duty_c Phase C duty cycle (0.0 to 1.0)
+ */
+void hal_set_pwm(struct PwmConfig_t *config, float duty_a, float duty_b, float duty_c);
+
 /** @} */
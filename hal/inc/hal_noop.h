@@ -0,0 +1,71 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   hal_noop.h
+ *
+ * @brief  Header file for the no-op HAL controls
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdint.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "hal.h"
+
+/**
+ * @defgroup HALNoop No-op HAL
+ * @brief    HAL that returns the inputs last set and drops every output, for timing the control code on its own
+ * @details  Nothing is simulated. The caller moves the clock and sets the measurements between control cycles, each HAL
+ *           call is a load or a store
+ * @{
+ */
+
+/**
+ * @brief   Return to the start of time with a still rotor, a 24 V bus and no timer armed
+ */
+void hal_noop_reset(void);
+
+/**
+ * @brief   Move the clock forward, firing the one-shot timer once due
+ * @param   duration_us Time to advance (microseconds)
+ */
+void hal_noop_advance_us(uint32_t duration_us);
+
+/**
+ * @brief   Set the phase currents read by hal_adc_get_phase_currents()
+ * @param   currents Current of each phase (A)
+ */
+void hal_noop_set_phase_currents(const float currents[NUM_MOTOR_PHASES]);
+
+/**
+ * @brief   Set the phase voltages read by hal_adc_get_phase_voltages()
+ * @param   voltages Terminal voltage of each phase (V)
+ */
+void hal_noop_set_phase_voltages(const float voltages[NUM_MOTOR_PHASES]);
+
+/**
+ * @brief   Set the DC bus voltage read by hal_adc_get_dc_voltage()
+ * @param   voltage Bus voltage (V)
+ */
+void hal_noop_set_dc_voltage(float voltage);
+
+/**
+ * @brief   Set the Hall sensor inputs, a change is captured as an edge at the current time
+ * @details The capture queue holds one edge, an edge not yet popped is replaced
+ * @param   hall_state Hall state as 0bHallA_MSB HallB_MID HallC_LSB
+ */
+void hal_noop_set_hall_state(uint8_t hall_state);
+
+/**
+ * @brief   Set the encoder readings
+ * @param   position Mechanical angle (rad)
+ * @param   velocity Mechanical velocity (rad/s)
+ */
+void hal_noop_set_encoder(float position, float velocity);
+
+/** @} */
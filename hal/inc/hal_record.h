@@ -0,0 +1,64 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   hal_record.h
+ *
+ * @brief  Header file for the recording HAL shim
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "hal_trace.h"
+
+/**
+ * @defgroup HALRecord Recording HAL
+ * @brief    Shim between the control code and a real HAL that logs every call to a trace
+ * @details  The shim defines __wrap_hal_*() for each HAL function, a program linked with -Wl,--wrap=hal_<name> for each of
+ *           them reaches the shim from its calls and the HAL through __real_hal_*(). Calls are only logged while capture
+ *           is on, so the application's own HAL reads (a simulator checking the rotor angle) stay out of the trace. The
+ *           one-shot timer callback is logged as a HAL_TRACE_TIMER_FIRE event and runs with capture on
+ * @{
+ */
+
+/**
+ * @brief   Start a trace, with capture off
+ * @param   sink Receiver of the trace bytes
+ * @param   context Argument passed to the sink
+ */
+void hal_record_start(HalTraceSink_t sink, void *context);
+
+/**
+ * @brief   Flush the trace and stop logging
+ */
+void hal_record_stop(void);
+
+/**
+ * @brief   Turn the logging of HAL calls on or off
+ * @param   is_enabled TRUE to log the calls that follow
+ * @return  Previous setting, to restore after a nested section
+ */
+bool hal_record_set_capture(bool is_enabled);
+
+/**
+ * @brief   Log an application event, such as a setpoint change or the start of a control cycle
+ * @param   kind Application defined event kind
+ * @param   payload Event data, copied into the trace
+ * @param   size Bytes of event data
+ */
+void hal_record_mark(uint8_t kind, const void *payload, uint32_t size);
+
+/**
+ * @brief   Check whether a trace is being written
+ * @return  TRUE between hal_record_start() and hal_record_stop()
+ */
+bool hal_record_is_active(void);
+
+/** @} */
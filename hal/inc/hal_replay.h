@@ -0,0 +1,83 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   hal_replay.h
+ *
+ * @brief  Header file for the replay HAL
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "hal_trace.h"
+
+/**
+ * @defgroup HALReplay Replay HAL
+ * @brief    HAL that plays a recorded trace back to the control code
+ * @details  Each HAL call takes the next event of the trace. Readings (ADC frames, Hall states and edges, encoder values,
+ *           timestamps, success flags) come from the event, the values the code writes (duties, gates, delays, timer
+ *           deadlines) are compared with it bit for bit. A call of another kind than the event is a divergence: the replay
+ *           stops following the trace and every later call reads zeros. A recorded timer fire runs the armed callback
+ *           right after the call it followed. Nothing waits, so a trace replays as fast as the control code runs
+ * @{
+ */
+
+/**
+ * @brief   Outcome of a replay
+ */
+struct HalReplayStats_t {
+  uint64_t num_events;              /**< Trace events consumed */
+  uint64_t num_timer_fires;         /**< Timer callbacks run */
+  uint64_t num_mismatches;          /**< Events whose computed values differ from the trace */
+  uint64_t first_mismatch_event;    /**< Index of the first mismatching event */
+  HalTraceTag_t first_mismatch_tag; /**< Tag of the first mismatching event */
+  bool is_diverged;                 /**< A call did not follow the trace */
+  uint64_t divergence_event;        /**< Index of the event the calls left the trace at */
+  HalTraceTag_t expected_tag;       /**< Event of the trace there, NUM_HAL_TRACE_TAGS past its end */
+  HalTraceTag_t actual_tag;         /**< Call made instead */
+  bool is_complete;                 /**< Every event of the trace was consumed */
+};
+
+/**
+ * @brief   Start replaying a trace
+ * @param   data Trace bytes, kept until hal_replay_finish()
+ * @param   size Number of bytes
+ * @param   sink Receiver of the trace the replay produces, with the computed values of this build, NULL for none
+ * @param   context Argument passed to the sink
+ * @return  TRUE if the trace header is supported
+ */
+bool hal_replay_start(const uint8_t *data, uint32_t size, HalTraceSink_t sink, void *context);
+
+/**
+ * @brief   Run the timer fires due, then take the next application event
+ * @param   kind Pointer to store the event kind
+ * @param   payload Pointer to store the event data, in the trace buffer
+ * @param   size Pointer to store the bytes of event data
+ * @return  TRUE if an application event was taken
+ *          FALSE at the end of the trace or once the replay diverged
+ */
+bool hal_replay_next_mark(uint8_t *kind, const uint8_t **payload, uint32_t *size);
+
+/**
+ * @brief   Compare an application event the code produced, such as a returned error, with the next event of the trace
+ * @param   kind Event kind
+ * @param   payload Event data
+ * @param   size Bytes of event data
+ * @return  TRUE if the trace holds the same event
+ */
+bool hal_replay_expect_mark(uint8_t kind, const void *payload, uint32_t size);
+
+/**
+ * @brief   Flush the produced trace and report the outcome
+ * @param   stats Pointer to store the outcome
+ */
+void hal_replay_finish(struct HalReplayStats_t *stats);
+
+/** @} */
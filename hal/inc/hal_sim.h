@@ -0,0 +1,168 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   hal_sim.h
+ *
+ * @brief  Header file for the simulation HAL controls
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "hal.h"
+
+/**
+ * @defgroup HALSim Simulation HAL
+ * @brief    Controls and measurements of the simulated motor behind the HAL
+ * @{
+ */
+
+/**
+ * @brief   Torque, energy and bridge writes accumulated by the simulator since the last hal_sim_reset_stats()
+ */
+struct HalSimStats_t {
+  float duration_s;                                /**< Integrated time (s) */
+  float torque_integral;                           /**< Integral of the electrical torque (Nm*s) */
+  float torque_squared_integral;                   /**< Integral of the squared electrical torque (Nm^2*s) */
+  float torque_min;                                /**< Minimum electrical torque (Nm) */
+  float torque_max;                                /**< Maximum electrical torque (Nm) */
+  float velocity_integral;                         /**< Integral of the mechanical rotor velocity (rad) */
+  float electrical_energy;                         /**< Energy drawn from the DC bus (J) */
+  float mechanical_energy;                         /**< Energy converted to rotor power by the electrical torque (J) */
+  float copper_loss_energy;                        /**< Energy dissipated in the winding resistance (J) */
+  float switch_loss_energy;                        /**< Conduction energy dissipated in the bridge switch channels (J) */
+  float diode_loss_energy;                         /**< Conduction energy dissipated in the bridge body diodes (J) */
+  float device_loss_energy[2U * NUM_MOTOR_PHASES]; /**< Conduction energy per bridge device, high side of phase p at 2p, low side at 2p + 1 (J) */
+  uint32_t gate_writes;                            /**< HAL calls that changed the gate states or duty cycles */
+};
+
+/**
+ * @brief   Instantaneous state of the simulated motor, free of the ADC noise and quantization
+ */
+struct HalSimMotorState_t {
+  float rotor_position;                   /**< Mechanical rotor angle, 0 to 2pi (rad) */
+  float rotor_velocity;                   /**< Mechanical rotor velocity (rad/s) */
+  float phase_currents[NUM_MOTOR_PHASES]; /**< Winding currents (A) */
+  float phase_voltages[NUM_MOTOR_PHASES]; /**< Terminal voltages referenced to the negative DC rail (V) */
+  float torque_electrical;                /**< Electrical torque (Nm) */
+  float dc_current;                       /**< Averaged DC link current (A) */
+  float temperature;                      /**< Winding temperature (°C) */
+};
+
+/**
+ * @brief   Callback run with each sample of the motor model
+ * @param   state Model state at the sample
+ * @param   time_us Simulation time of the sample (microseconds)
+ * @param   context Context given to hal_sim_set_sample_callback()
+ */
+typedef void (*HalSimSampleCallback_t)(const struct HalSimMotorState_t *state, uint32_t time_us, void *context);
+
+/**
+ * @brief   Advance the simulated clock, integrating the motor model and firing due timers
+ * @details The simulator runs in lockstep. Simulated time only moves through this call and the blocking HAL delays
+ * @param   duration_us Time to advance (microseconds)
+ */
+void hal_sim_advance_us(uint32_t duration_us);
+
+/**
+ * @brief   Enable or disable the per-call HAL trace on stdout
+ * @param   verbose TRUE to print every HAL call
+ */
+void hal_sim_set_verbose(bool verbose);
+
+/**
+ * @brief   Seed the ADC noise generator for repeatable runs
+ * @param   seed Random seed
+ */
+void hal_sim_set_noise_seed(uint32_t seed);
+
+/**
+ * @brief   Clear the torque and energy accumulators
+ */
+void hal_sim_reset_stats(void);
+
+/**
+ * @brief   Read the torque and energy accumulators
+ * @param   stats Pointer to store the accumulated statistics
+ */
+void hal_sim_get_stats(struct HalSimStats_t *stats);
+
+/**
+ * @brief   Read the motor model at the current simulation time
+ * @param   state Pointer to store the model state
+ */
+void hal_sim_get_motor_state(struct HalSimMotorState_t *state);
+
+/**
+ * @brief   Sample the motor model at a fixed rate of simulated time, independent of the control loop
+ * @details Samples fall on the model steps. Kept across hal_sim_restart(), so one sampler sees every scenario of a run
+ * @param   callback Callback run with each sample, NULL to stop sampling
+ * @param   period_us Simulated time between samples (microseconds)
+ * @param   context Context passed to the callback
+ */
+void hal_sim_set_sample_callback(HalSimSampleCallback_t callback, uint32_t period_us, void *context);
+
+/**
+ * @brief   Set load torque for testing
+ * @param   torque_nm Load torque opposing rotation (Nm)
+ */
+void hal_sim_set_load_torque(float torque_nm);
+
+/**
+ * @brief   Set the DC bus voltage
+ * @details Kept across driver re-initialization, hal_sim_restart() restores the default
+ * @param   voltage DC bus voltage (V)
+ */
+void hal_sim_set_dc_voltage(float voltage);
+
+/**
+ * @brief   Make the winding inductance follow the rotor
+ * @details The d-axis lies along the magnet flux. Its incremental inductance drops by up to the saturation fraction as
+ *          d-axis current adds to the magnet flux and rises as current opposes it, the knee is SIM_MOTOR_SATURATION_CURRENT.
+ *          Ld != Lq adds reluctance torque. Kept across driver re-initialization, hal_sim_restart() restores the round
+ *          rotor. Mutual inductance is folded into the d and q inductances
+ * @param   inductance_d Unsaturated d-axis inductance (H)
+ * @param   inductance_q q-axis inductance (H)
+ * @param   saturation Fraction of the d-axis inductance lost at large current along the magnet flux (0.0 to 1.0)
+ */
+void hal_sim_set_saliency(float inductance_d, float inductance_q, float saturation);
+
+/**
+ * @brief   Place the rotor at rest
+ * @param   position Mechanical angle (rad)
+ */
+void hal_sim_set_rotor_position(float position);
+
+/**
+ * @brief   Read the time the back-EMF of a phase last crossed zero
+ * @details Interpolated between model steps, this is the reference for measuring zero-crossing detection accuracy
+ * @param   phase Motor phase
+ * @return  Simulation time of the last back-EMF zero-crossing (microseconds)
+ */
+uint32_t hal_sim_get_bemf_zero_crossing_time(MotorPhase_t phase);
+
+/**
+ * @brief   Inject faults for testing
+ * @param   fault_type One of "overcurrent", "overvoltage" or "overtemp"
+ * @param   enable TRUE to enable the fault
+ */
+void hal_sim_inject_fault(const char *fault_type, bool enable);
+
+/**
+ * @brief   Stop the simulation cleanly
+ */
+void hal_sim_stop(void);
+
+/**
+ * @brief   Restart the simulation from initial state
+ */
+void hal_sim_restart(void);
+
+/** @} */
@@ -0,0 +1,190 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   hal_trace.h
+ *
+ * @brief  Header file for the binary trace of HAL calls
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "hal.h"
+
+/**
+ * @defgroup HALTrace HAL trace
+ * @brief    Compact binary log of the HAL calls made by the drivers, written by the recording HAL and read by the replay HAL
+ * @details  A trace starts with HAL_TRACE_MAGIC and HAL_TRACE_VERSION, then holds one event per HAL call in call order: a tag
+ *           byte and the fields of its layout. Floats are stored as their 4 raw bytes so a replay is bit-exact. Times are
+ *           zigzag varints of the difference from the previous time in the trace, counts and gate masks are varints, so a
+ *           timestamp read costs 2 to 3 bytes. Application events (marks) carry a kind byte and an opaque payload
+ * @{
+ */
+
+#define HAL_TRACE_MAGIC 0x4352544AUL  /**< "JTRC", little-endian */
+#define HAL_TRACE_VERSION 1U          /**< Format version, a reader rejects any other */
+#define HAL_TRACE_HEADER_SIZE 8U      /**< Magic, version and 3 reserved bytes */
+#define HAL_TRACE_MAX_EVENT_SIZE 32U  /**< Largest encoded event without a mark payload */
+#define HAL_TRACE_WRITER_BUFFER 4096U /**< Bytes buffered by a writer before it calls its sink */
+
+/**
+ * @brief   HAL call, or other event, of a trace entry
+ */
+typedef enum {
+  HAL_TRACE_PWM_INIT,             /**< hal_pwm_init() */
+  HAL_TRACE_ADC_INIT,             /**< hal_adc_init() */
+  HAL_TRACE_GPIO_INIT,            /**< hal_gpio_init() */
+  HAL_TRACE_GPIO_SET_PHASE_HIGH,  /**< hal_gpio_set_phase_high() */
+  HAL_TRACE_GPIO_SET_PHASE_LOW,   /**< hal_gpio_set_phase_low() */
+  HAL_TRACE_GPIO_SET_PHASE_FLOAT, /**< hal_gpio_set_phase_float() */
+  HAL_TRACE_PWM_SET_DUTY,         /**< hal_pwm_set_duty() */
+  HAL_TRACE_PWM_SET_GATES,        /**< hal_pwm_set_gates() */
+  HAL_TRACE_GET_MICROS,           /**< hal_get_micros() */
+  HAL_TRACE_TIMER_SCHEDULE,       /**< hal_timer_schedule() */
+  HAL_TRACE_TIMER_CANCEL,         /**< hal_timer_cancel() */
+  HAL_TRACE_DELAY_US,             /**< hal_delay_us() */
+  HAL_TRACE_DELAY_MS,             /**< hal_delay_ms() */
+  HAL_TRACE_ADC_START_CONVERSION, /**< hal_adc_start_conversion() */
+  HAL_TRACE_ADC_SET_PWM_TRIGGER,  /**< hal_adc_set_pwm_trigger() */
+  HAL_TRACE_ADC_PHASE_VOLTAGES,   /**< hal_adc_get_phase_voltages() */
+  HAL_TRACE_ADC_PHASE_CURRENTS,   /**< hal_adc_get_phase_currents() */
+  HAL_TRACE_ADC_DC_VOLTAGE,       /**< hal_adc_get_dc_voltage() */
+  HAL_TRACE_ADC_TEMPERATURE,      /**< hal_adc_get_temperature() */
+  HAL_TRACE_GPIO_INIT_HALL,       /**< hal_gpio_init_hall_sensors() */
+  HAL_TRACE_GPIO_HALL_STATE,      /**< hal_gpio_get_hall_state() */
+  HAL_TRACE_HALL_CAPTURE_INIT,    /**< hal_hall_capture_init() */
+  HAL_TRACE_HALL_CAPTURE_POP,     /**< hal_hall_capture_pop() */
+  HAL_TRACE_ENCODER_INIT,         /**< hal_encoder_init() */
+  HAL_TRACE_ENCODER_POSITION,     /**< hal_encoder_get_position() */
+  HAL_TRACE_ENCODER_VELOCITY,     /**< hal_encoder_get_velocity() */
+  HAL_TRACE_SET_PWM,              /**< hal_set_pwm() */
+  HAL_TRACE_TIMER_FIRE,           /**< The one-shot timer ran its callback */
+  HAL_TRACE_MARK,                 /**< Application event, see hal_record_mark() */
+  NUM_HAL_TRACE_TAGS
+} HalTraceTag_t;
+
+/**
+ * @brief   Decoded trace entry, a tag uses the fields of its layout and leaves the others at 0
+ */
+struct HalTraceEvent_t {
+  HalTraceTag_t tag;              /**< Call or event */
+  bool result;                    /**< Returned success flag */
+  uint8_t byte;                   /**< Phase, Hall state or mark kind */
+  uint32_t word;                  /**< Delay, gate mask or the returned time */
+  float values[NUM_MOTOR_PHASES]; /**< Float arguments or readings, as many as the layout has */
+  const uint8_t *payload;         /**< Mark payload, in the writer's caller or the reader's buffer */
+  uint32_t payload_size;          /**< Mark payload bytes */
+};
+
+/**
+ * @brief   Receives the bytes of a trace as a writer flushes them
+ * @param   data Encoded bytes
+ * @param   size Number of bytes
+ * @param   context Context given to hal_trace_writer_init()
+ */
+typedef void (*HalTraceSink_t)(const uint8_t *data, uint32_t size, void *context);
+
+/**
+ * @brief   Trace encoder
+ */
+struct HalTraceWriter_t {
+  HalTraceSink_t sink;                     /**< Receiver of the flushed bytes */
+  void *context;                           /**< Argument passed to the sink */
+  uint8_t buffer[HAL_TRACE_WRITER_BUFFER]; /**< Bytes not yet flushed */
+  uint32_t used;                           /**< Bytes held in buffer */
+  uint32_t last_time;                      /**< Previous time written, times are coded against it */
+  uint64_t num_bytes;                      /**< Bytes written, the header included */
+  uint64_t num_events;                     /**< Events written */
+};
+
+/**
+ * @brief   Trace decoder over a trace held in memory
+ */
+struct HalTraceReader_t {
+  const uint8_t *data; /**< Whole trace */
+  uint32_t size;       /**< Trace bytes */
+  uint32_t offset;     /**< Next byte to decode */
+  uint32_t last_time;  /**< Previous time read */
+  uint64_t num_events; /**< Events read */
+};
+
+/**
+ * @brief   Name of a tag, for reports
+ * @param   tag Tag to name
+ * @return  Name, "invalid" for an unknown tag
+ */
+const char *hal_trace_tag_name(HalTraceTag_t tag);
+
+/**
+ * @brief   Start a trace and write its header
+ * @param   writer Writer to set up
+ * @param   sink Receiver of the bytes
+ * @param   context Argument passed to the sink
+ */
+void hal_trace_writer_init(struct HalTraceWriter_t *writer, HalTraceSink_t sink, void *context);
+
+/**
+ * @brief   Append an event
+ * @param   writer Writer to append to
+ * @param   event Event to encode
+ */
+void hal_trace_write(struct HalTraceWriter_t *writer, const struct HalTraceEvent_t *event);
+
+/**
+ * @brief   Hand the buffered bytes to the sink
+ * @param   writer Writer to flush
+ */
+void hal_trace_writer_flush(struct HalTraceWriter_t *writer);
+
+/**
+ * @brief   Check the header of a trace and start decoding after it
+ * @param   reader Reader to set up
+ * @param   data Trace bytes, kept until decoding ends
+ * @param   size Number of bytes
+ * @return  TRUE if the header is a supported trace
+ *          FALSE if the magic or version is not
+ */
+bool hal_trace_reader_init(struct HalTraceReader_t *reader, const uint8_t *data, uint32_t size);
+
+/**
+ * @brief   Decode the next event without consuming it
+ * @param   reader Reader to decode from
+ * @param   event Pointer to store the event
+ * @return  TRUE if an event was decoded
+ *          FALSE at the end of the trace or on a truncated or unknown event
+ */
+bool hal_trace_peek(const struct HalTraceReader_t *reader, struct HalTraceEvent_t *event);
+
+/**
+ * @brief   Decode and consume the next event
+ * @param   reader Reader to decode from
+ * @param   event Pointer to store the event
+ * @return  TRUE if an event was decoded
+ *          FALSE at the end of the trace or on a truncated or unknown event
+ */
+bool hal_trace_read(struct HalTraceReader_t *reader, struct HalTraceEvent_t *event);
+
+/**
+ * @brief   Compare the fields of two events that the code under replay computes, as opposed to the HAL readings
+ * @details Floats are compared bit for bit. Events of different tags never match
+ * @param   expected Event from the trace
+ * @param   actual Event of the replayed call
+ * @return  TRUE if the computed fields are identical
+ */
+bool hal_trace_outputs_equal(const struct HalTraceEvent_t *expected, const struct HalTraceEvent_t *actual);
+
+/**
+ * @brief   Copy the computed fields of one event over another of the same tag
+ * @param   event Event to update, usually from the trace
+ * @param   outputs Event holding the computed fields
+ */
+void hal_trace_copy_outputs(struct HalTraceEvent_t *event, const struct HalTraceEvent_t *outputs);
+
+/** @} */
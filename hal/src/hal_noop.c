@@ -0,0 +1,227 @@
+/*******************************************************************************************************************************
+ * @file   hal_noop.c
+ *
+ * @brief  Source file for the no-op HAL
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "hal_noop.h"
+
+#define HAL_NOOP_DC_VOLTAGE 24.0f  /**< Bus voltage after a reset (V) */
+#define HAL_NOOP_TEMPERATURE 25.0f /**< Temperature reading (°C) */
+
+/**
+ * @brief   Inputs returned to the control code and the outputs it last wrote
+ */
+struct HalNoopState_t {
+  uint32_t micros;                        /**< Clock (us) */
+  float phase_currents[NUM_MOTOR_PHASES]; /**< Current readings (A) */
+  float phase_voltages[NUM_MOTOR_PHASES]; /**< Terminal voltage readings (V) */
+  float dc_voltage;                       /**< Bus voltage reading (V) */
+  uint8_t hall_state;                     /**< Hall inputs */
+  struct HallEdge_t hall_edge;            /**< Captured Hall edge */
+  bool has_hall_edge;                     /**< hall_edge is waiting to be popped */
+  float encoder_position;                 /**< Encoder angle reading (rad) */
+  float encoder_velocity;                 /**< Encoder velocity reading (rad/s) */
+  float pwm_duty[NUM_MOTOR_PHASES];       /**< Last duty cycle of each phase */
+  uint16_t gate_mask;                     /**< Last gate states */
+  bool timer_armed;                       /**< One-shot timer pending */
+  uint32_t timer_fire_time;               /**< Deadline of the one-shot timer (us) */
+  HalTimerCallback_t timer_callback;      /**< Callback of the one-shot timer */
+  void *timer_context;                    /**< Context of the one-shot timer */
+};
+
+static struct HalNoopState_t s_noop_state = { .dc_voltage = HAL_NOOP_DC_VOLTAGE };
+
+bool hal_pwm_init(struct PwmConfig_t *config) {
+  return config != NULL;
+}
+
+bool hal_adc_init(struct AdcConfig_t *config) {
+  return config != NULL;
+}
+
+bool hal_gpio_init() {
+  return true;
+}
+
+void hal_gpio_set_phase_high(MotorPhase_t phase) {
+  if (phase < NUM_MOTOR_PHASES) {
+    s_noop_state.gate_mask = (uint16_t)((s_noop_state.gate_mask & ~(HAL_GATE_LOW(phase) | HAL_GATE_PWM(phase))) | HAL_GATE_HIGH(phase));
+  }
+}
+
+void hal_gpio_set_phase_low(MotorPhase_t phase) {
+  if (phase < NUM_MOTOR_PHASES) {
+    s_noop_state.gate_mask = (uint16_t)((s_noop_state.gate_mask & ~(HAL_GATE_HIGH(phase) | HAL_GATE_PWM(phase))) | HAL_GATE_LOW(phase));
+  }
+}
+
+void hal_gpio_set_phase_float(MotorPhase_t phase) {
+  if (phase < NUM_MOTOR_PHASES) {
+    s_noop_state.gate_mask = (uint16_t)(s_noop_state.gate_mask & ~(HAL_GATE_HIGH(phase) | HAL_GATE_LOW(phase) | HAL_GATE_PWM(phase)));
+  }
+}
+
+void hal_pwm_set_duty(MotorPhase_t phase, float duty) {
+  if (phase < NUM_MOTOR_PHASES) {
+    s_noop_state.pwm_duty[phase] = duty;
+  }
+}
+
+void hal_pwm_set_gates(uint16_t gate_mask, float duty) {
+  s_noop_state.gate_mask = gate_mask;
+
+  for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+    s_noop_state.pwm_duty[phase] = duty;
+  }
+}
+
+uint32_t hal_get_micros() {
+  return s_noop_state.micros;
+}
+
+bool hal_timer_schedule(uint32_t fire_time_us, HalTimerCallback_t callback, void *context) {
+  if (callback == NULL) {
+    return false;
+  }
+
+  s_noop_state.timer_armed = true;
+  s_noop_state.timer_fire_time = fire_time_us;
+  s_noop_state.timer_callback = callback;
+  s_noop_state.timer_context = context;
+  return true;
+}
+
+void hal_timer_cancel() {
+  s_noop_state.timer_armed = false;
+}
+
+void hal_delay_us(uint32_t delay_us) {
+  hal_noop_advance_us(delay_us);
+}
+
+void hal_delay_ms(uint32_t delay_ms) {
+  hal_noop_advance_us(delay_ms * 1000U);
+}
+
+void hal_adc_start_conversion() {
+  /* Readings are always ready */
+}
+
+bool hal_adc_set_pwm_trigger(float on_time_fraction) {
+  return on_time_fraction >= 0.0f && on_time_fraction <= 1.0f;
+}
+
+void hal_adc_get_phase_voltages(float *voltages) {
+  memcpy(voltages, s_noop_state.phase_voltages, sizeof(s_noop_state.phase_voltages));
+}
+
+void hal_adc_get_phase_currents(float *currents) {
+  memcpy(currents, s_noop_state.phase_currents, sizeof(s_noop_state.phase_currents));
+}
+
+float hal_adc_get_dc_voltage() {
+  return s_noop_state.dc_voltage;
+}
+
+float hal_adc_get_temperature() {
+  return HAL_NOOP_TEMPERATURE;
+}
+
+bool hal_gpio_init_hall_sensors() {
+  return true;
+}
+
+uint8_t hal_gpio_get_hall_state() {
+  return s_noop_state.hall_state;
+}
+
+bool hal_hall_capture_init() {
+  s_noop_state.has_hall_edge = false;
+  return true;
+}
+
+bool hal_hall_capture_pop(struct HallEdge_t *edge) {
+  if (edge == NULL || !s_noop_state.has_hall_edge) {
+    return false;
+  }
+
+  *edge = s_noop_state.hall_edge;
+  s_noop_state.has_hall_edge = false;
+  return true;
+}
+
+bool hal_encoder_init() {
+  return true;
+}
+
+float hal_encoder_get_position() {
+  return s_noop_state.encoder_position;
+}
+
+float hal_encoder_get_velocity() {
+  return s_noop_state.encoder_velocity;
+}
+
+void hal_set_pwm(struct PwmConfig_t *config, float duty_a, float duty_b, float duty_c) {
+  (void)config;
+  s_noop_state.pwm_duty[MOTOR_PHASE_A] = duty_a;
+  s_noop_state.pwm_duty[MOTOR_PHASE_B] = duty_b;
+  s_noop_state.pwm_duty[MOTOR_PHASE_C] = duty_c;
+}
+
+/*******************************************************************************************************************************
+ * No-op HAL controls
+ *******************************************************************************************************************************/
+
+void hal_noop_reset(void) {
+  memset(&s_noop_state, 0, sizeof(s_noop_state));
+  s_noop_state.dc_voltage = HAL_NOOP_DC_VOLTAGE;
+}
+
+void hal_noop_advance_us(uint32_t duration_us) {
+  s_noop_state.micros += duration_us;
+
+  if (s_noop_state.timer_armed && (int32_t)(s_noop_state.micros - s_noop_state.timer_fire_time) >= 0) {
+    s_noop_state.timer_armed = false;
+    s_noop_state.timer_callback(s_noop_state.timer_context);
+  }
+}
+
+void hal_noop_set_phase_currents(const float currents[NUM_MOTOR_PHASES]) {
+  memcpy(s_noop_state.phase_currents, currents, sizeof(s_noop_state.phase_currents));
+}
+
+void hal_noop_set_phase_voltages(const float voltages[NUM_MOTOR_PHASES]) {
+  memcpy(s_noop_state.phase_voltages, voltages, sizeof(s_noop_state.phase_voltages));
+}
+
+void hal_noop_set_dc_voltage(float voltage) {
+  s_noop_state.dc_voltage = voltage;
+}
+
+void hal_noop_set_hall_state(uint8_t hall_state) {
+  if (hall_state != s_noop_state.hall_state) {
+    s_noop_state.hall_edge.timestamp_us = s_noop_state.micros;
+    s_noop_state.hall_edge.hall_state = hall_state;
+    s_noop_state.has_hall_edge = true;
+  }
+
+  s_noop_state.hall_state = hall_state;
+}
+
+void hal_noop_set_encoder(float position, float velocity) {
+  s_noop_state.encoder_position = position;
+  s_noop_state.encoder_velocity = velocity;
+}
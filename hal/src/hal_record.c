@@ -0,0 +1,337 @@
+/*******************************************************************************************************************************
+ * @file   hal_record.c
+ *
+ * @brief  Source file for the recording HAL shim
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stddef.h>
+#include <string.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "hal_record.h"
+
+/* HAL behind the shim, bound by the linker's --wrap */
+bool __real_hal_pwm_init(struct PwmConfig_t *config);
+bool __real_hal_adc_init(struct AdcConfig_t *config);
+bool __real_hal_gpio_init();
+void __real_hal_gpio_set_phase_high(MotorPhase_t phase);
+void __real_hal_gpio_set_phase_low(MotorPhase_t phase);
+void __real_hal_gpio_set_phase_float(MotorPhase_t phase);
+void __real_hal_pwm_set_duty(MotorPhase_t phase, float duty);
+void __real_hal_pwm_set_gates(uint16_t gate_mask, float duty);
+uint32_t __real_hal_get_micros();
+bool __real_hal_timer_schedule(uint32_t fire_time_us, HalTimerCallback_t callback, void *context);
+void __real_hal_timer_cancel();
+void __real_hal_delay_us(uint32_t delay_us);
+void __real_hal_delay_ms(uint32_t delay_ms);
+void __real_hal_adc_start_conversion();
+bool __real_hal_adc_set_pwm_trigger(float on_time_fraction);
+void __real_hal_adc_get_phase_voltages(float *voltages);
+void __real_hal_adc_get_phase_currents(float *currents);
+float __real_hal_adc_get_dc_voltage();
+float __real_hal_adc_get_temperature();
+bool __real_hal_gpio_init_hall_sensors();
+uint8_t __real_hal_gpio_get_hall_state();
+bool __real_hal_hall_capture_init();
+bool __real_hal_hall_capture_pop(struct HallEdge_t *edge);
+bool __real_hal_encoder_init();
+float __real_hal_encoder_get_position();
+float __real_hal_encoder_get_velocity();
+void __real_hal_set_pwm(struct PwmConfig_t *config, float duty_a, float duty_b, float duty_c);
+
+/**
+ * @brief   Recorder state
+ */
+struct HalRecordState_t {
+  struct HalTraceWriter_t writer;    /**< Trace being written */
+  bool is_active;                    /**< A trace is open */
+  bool is_capturing;                 /**< HAL calls are logged */
+  HalTimerCallback_t timer_callback; /**< Callback of the one-shot timer, run by timer_trampoline() */
+  void *timer_context;               /**< Context of the one-shot timer */
+};
+
+static struct HalRecordState_t s_record;
+
+static void log_event(const struct HalTraceEvent_t *event) {
+  if (s_record.is_active && s_record.is_capturing) {
+    hal_trace_write(&s_record.writer, event);
+  }
+}
+
+static void log_values(HalTraceTag_t tag, const float *values, uint32_t num_values) {
+  struct HalTraceEvent_t event = { .tag = tag };
+
+  memcpy(event.values, values, num_values * sizeof(float));
+  log_event(&event);
+}
+
+/* The fire is logged whatever the capture setting, it happens between control cycles as often as inside them */
+static void timer_trampoline(void *context) {
+  HalTimerCallback_t callback = s_record.timer_callback;
+  void *callback_context = s_record.timer_context;
+
+  (void)context;
+
+  if (!s_record.is_active) {
+    callback(callback_context);
+    return;
+  }
+
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_TIMER_FIRE };
+  hal_trace_write(&s_record.writer, &event);
+
+  bool was_capturing = hal_record_set_capture(true);
+  callback(callback_context);
+  hal_record_set_capture(was_capturing);
+}
+
+void hal_record_start(HalTraceSink_t sink, void *context) {
+  hal_trace_writer_init(&s_record.writer, sink, context);
+  s_record.is_active = true;
+  s_record.is_capturing = false;
+}
+
+void hal_record_stop(void) {
+  if (s_record.is_active) {
+    hal_trace_writer_flush(&s_record.writer);
+  }
+
+  s_record.is_active = false;
+  s_record.is_capturing = false;
+}
+
+bool hal_record_set_capture(bool is_enabled) {
+  bool was_capturing = s_record.is_capturing;
+
+  s_record.is_capturing = is_enabled;
+  return was_capturing;
+}
+
+void hal_record_mark(uint8_t kind, const void *payload, uint32_t size) {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_MARK, .byte = kind, .payload = (const uint8_t *)payload, .payload_size = size };
+
+  if (s_record.is_active) {
+    hal_trace_write(&s_record.writer, &event);
+  }
+}
+
+bool hal_record_is_active(void) {
+  return s_record.is_active;
+}
+
+bool __wrap_hal_pwm_init(struct PwmConfig_t *config) {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_PWM_INIT, .result = __real_hal_pwm_init(config) };
+
+  log_event(&event);
+  return event.result;
+}
+
+bool __wrap_hal_adc_init(struct AdcConfig_t *config) {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_ADC_INIT, .result = __real_hal_adc_init(config) };
+
+  log_event(&event);
+  return event.result;
+}
+
+bool __wrap_hal_gpio_init() {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_GPIO_INIT, .result = __real_hal_gpio_init() };
+
+  log_event(&event);
+  return event.result;
+}
+
+void __wrap_hal_gpio_set_phase_high(MotorPhase_t phase) {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_GPIO_SET_PHASE_HIGH, .byte = (uint8_t)phase };
+
+  log_event(&event);
+  __real_hal_gpio_set_phase_high(phase);
+}
+
+void __wrap_hal_gpio_set_phase_low(MotorPhase_t phase) {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_GPIO_SET_PHASE_LOW, .byte = (uint8_t)phase };
+
+  log_event(&event);
+  __real_hal_gpio_set_phase_low(phase);
+}
+
+void __wrap_hal_gpio_set_phase_float(MotorPhase_t phase) {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_GPIO_SET_PHASE_FLOAT, .byte = (uint8_t)phase };
+
+  log_event(&event);
+  __real_hal_gpio_set_phase_float(phase);
+}
+
+void __wrap_hal_pwm_set_duty(MotorPhase_t phase, float duty) {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_PWM_SET_DUTY, .byte = (uint8_t)phase, .values = { duty } };
+
+  log_event(&event);
+  __real_hal_pwm_set_duty(phase, duty);
+}
+
+void __wrap_hal_pwm_set_gates(uint16_t gate_mask, float duty) {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_PWM_SET_GATES, .word = gate_mask, .values = { duty } };
+
+  log_event(&event);
+  __real_hal_pwm_set_gates(gate_mask, duty);
+}
+
+uint32_t __wrap_hal_get_micros() {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_GET_MICROS, .word = __real_hal_get_micros() };
+
+  log_event(&event);
+  return event.word;
+}
+
+/* A failed schedule leaves the previous timer armed, so its callback is kept for the trampoline */
+bool __wrap_hal_timer_schedule(uint32_t fire_time_us, HalTimerCallback_t callback, void *context) {
+  HalTimerCallback_t previous_callback = s_record.timer_callback;
+  void *previous_context = s_record.timer_context;
+
+  s_record.timer_callback = callback;
+  s_record.timer_context = context;
+
+  struct HalTraceEvent_t event = {
+    .tag = HAL_TRACE_TIMER_SCHEDULE,
+    .result = (callback != NULL) && __real_hal_timer_schedule(fire_time_us, timer_trampoline, NULL),
+    .word = fire_time_us,
+  };
+
+  if (!event.result) {
+    s_record.timer_callback = previous_callback;
+    s_record.timer_context = previous_context;
+  }
+
+  log_event(&event);
+  return event.result;
+}
+
+void __wrap_hal_timer_cancel() {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_TIMER_CANCEL };
+
+  log_event(&event);
+  __real_hal_timer_cancel();
+}
+
+/* Logged before the wait, the timer can fire during it */
+void __wrap_hal_delay_us(uint32_t delay_us) {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_DELAY_US, .word = delay_us };
+
+  log_event(&event);
+  __real_hal_delay_us(delay_us);
+}
+
+void __wrap_hal_delay_ms(uint32_t delay_ms) {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_DELAY_MS, .word = delay_ms };
+
+  log_event(&event);
+  __real_hal_delay_ms(delay_ms);
+}
+
+void __wrap_hal_adc_start_conversion() {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_ADC_START_CONVERSION };
+
+  log_event(&event);
+  __real_hal_adc_start_conversion();
+}
+
+bool __wrap_hal_adc_set_pwm_trigger(float on_time_fraction) {
+  struct HalTraceEvent_t event = {
+    .tag = HAL_TRACE_ADC_SET_PWM_TRIGGER,
+    .result = __real_hal_adc_set_pwm_trigger(on_time_fraction),
+    .values = { on_time_fraction },
+  };
+
+  log_event(&event);
+  return event.result;
+}
+
+void __wrap_hal_adc_get_phase_voltages(float *voltages) {
+  __real_hal_adc_get_phase_voltages(voltages);
+  log_values(HAL_TRACE_ADC_PHASE_VOLTAGES, voltages, NUM_MOTOR_PHASES);
+}
+
+void __wrap_hal_adc_get_phase_currents(float *currents) {
+  __real_hal_adc_get_phase_currents(currents);
+  log_values(HAL_TRACE_ADC_PHASE_CURRENTS, currents, NUM_MOTOR_PHASES);
+}
+
+float __wrap_hal_adc_get_dc_voltage() {
+  float dc_voltage = __real_hal_adc_get_dc_voltage();
+
+  log_values(HAL_TRACE_ADC_DC_VOLTAGE, &dc_voltage, 1U);
+  return dc_voltage;
+}
+
+float __wrap_hal_adc_get_temperature() {
+  float temperature = __real_hal_adc_get_temperature();
+
+  log_values(HAL_TRACE_ADC_TEMPERATURE, &temperature, 1U);
+  return temperature;
+}
+
+bool __wrap_hal_gpio_init_hall_sensors() {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_GPIO_INIT_HALL, .result = __real_hal_gpio_init_hall_sensors() };
+
+  log_event(&event);
+  return event.result;
+}
+
+uint8_t __wrap_hal_gpio_get_hall_state() {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_GPIO_HALL_STATE, .byte = __real_hal_gpio_get_hall_state() };
+
+  log_event(&event);
+  return event.byte;
+}
+
+bool __wrap_hal_hall_capture_init() {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_HALL_CAPTURE_INIT, .result = __real_hal_hall_capture_init() };
+
+  log_event(&event);
+  return event.result;
+}
+
+bool __wrap_hal_hall_capture_pop(struct HallEdge_t *edge) {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_HALL_CAPTURE_POP, .result = __real_hal_hall_capture_pop(edge) };
+
+  if (event.result && edge != NULL) {
+    event.word = edge->timestamp_us;
+    event.byte = edge->hall_state;
+  }
+
+  log_event(&event);
+  return event.result;
+}
+
+bool __wrap_hal_encoder_init() {
+  struct HalTraceEvent_t event = { .tag = HAL_TRACE_ENCODER_INIT, .result = __real_hal_encoder_init() };
+
+  log_event(&event);
+  return event.result;
+}
+
+float __wrap_hal_encoder_get_position() {
+  float position = __real_hal_encoder_get_position();
+
+  log_values(HAL_TRACE_ENCODER_POSITION, &position, 1U);
+  return position;
+}
+
+float __wrap_hal_encoder_get_velocity() {
+  float velocity = __real_hal_encoder_get_velocity();
+
+  log_values(HAL_TRACE_ENCODER_VELOCITY, &velocity, 1U);
+  return velocity;
+}
+
+void __wrap_hal_set_pwm(struct PwmConfig_t *config, float duty_a, float duty_b, float duty_c) {
+  float duties[NUM_MOTOR_PHASES] = { duty_a, duty_b, duty_c };
+
+  log_values(HAL_TRACE_SET_PWM, duties, NUM_MOTOR_PHASES);
+  __real_hal_set_pwm(config, duty_a, duty_b, duty_c);
+}
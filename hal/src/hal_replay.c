@@ -0,0 +1,367 @@
+/*******************************************************************************************************************************
+ * @file   hal_replay.c
+ *
+ * @brief  Source file for the replay HAL
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stddef.h>
+#include <string.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "hal_replay.h"
+
+/**
+ * @brief   Replay state
+ */
+struct HalReplayState_t {
+  struct HalTraceReader_t reader;    /**< Trace being played */
+  struct HalTraceWriter_t writer;    /**< Trace being produced */
+  bool has_output;                   /**< The produced trace goes to a sink */
+  HalTimerCallback_t timer_callback; /**< Callback of the armed timer, NULL when none */
+  void *timer_context;               /**< Context of the armed timer */
+  struct HalReplayStats_t stats;     /**< Outcome so far */
+};
+
+static struct HalReplayState_t s_replay;
+
+static void emit(const struct HalTraceEvent_t *event) {
+  if (s_replay.has_output) {
+    hal_trace_write(&s_replay.writer, event);
+  }
+}
+
+static void diverge(HalTraceTag_t expected_tag, HalTraceTag_t actual_tag) {
+  s_replay.stats.is_diverged = true;
+  s_replay.stats.divergence_event = s_replay.reader.num_events;
+  s_replay.stats.expected_tag = expected_tag;
+  s_replay.stats.actual_tag = actual_tag;
+  s_replay.timer_callback = NULL;
+}
+
+/* Timer fires follow the call they happened in, a callback can make calls and fire again */
+static void run_timer_fires(void) {
+  struct HalTraceEvent_t event;
+
+  while (!s_replay.stats.is_diverged && hal_trace_peek(&s_replay.reader, &event) && event.tag == HAL_TRACE_TIMER_FIRE) {
+    HalTimerCallback_t callback = s_replay.timer_callback;
+
+    if (callback == NULL) {
+      diverge(HAL_TRACE_TIMER_FIRE, HAL_TRACE_TIMER_CANCEL);
+      return;
+    }
+
+    hal_trace_read(&s_replay.reader, &event);
+    s_replay.stats.num_events++;
+    s_replay.stats.num_timer_fires++;
+    s_replay.timer_callback = NULL;
+    emit(&event);
+
+    callback(s_replay.timer_context);
+  }
+}
+
+/**
+ * @brief   Match a call with the next event, leaving the recorded readings in recorded
+ * @return  TRUE if the call follows the trace
+ */
+static bool take_event(const struct HalTraceEvent_t *actual, struct HalTraceEvent_t *recorded) {
+  memset(recorded, 0, sizeof(*recorded));
+
+  if (s_replay.stats.is_diverged) {
+    return false;
+  }
+
+  bool has_event = hal_trace_peek(&s_replay.reader, recorded);
+
+  if (!has_event || recorded->tag != actual->tag) {
+    diverge(has_event ? recorded->tag : NUM_HAL_TRACE_TAGS, actual->tag);
+    memset(recorded, 0, sizeof(*recorded));
+    return false;
+  }
+
+  hal_trace_read(&s_replay.reader, recorded);
+  s_replay.stats.num_events++;
+
+  if (!hal_trace_outputs_equal(recorded, actual)) {
+    if (s_replay.stats.num_mismatches == 0U) {
+      s_replay.stats.first_mismatch_event = s_replay.reader.num_events - 1U;
+      s_replay.stats.first_mismatch_tag = recorded->tag;
+    }
+    s_replay.stats.num_mismatches++;
+  }
+
+  struct HalTraceEvent_t produced = *recorded;
+  hal_trace_copy_outputs(&produced, actual);
+  emit(&produced);
+
+  return true;
+}
+
+/* Calls returning no reading */
+static void replay_output(const struct HalTraceEvent_t *actual) {
+  struct HalTraceEvent_t recorded;
+
+  take_event(actual, &recorded);
+  run_timer_fires();
+}
+
+static bool replay_result(HalTraceTag_t tag) {
+  struct HalTraceEvent_t actual = { .tag = tag };
+  struct HalTraceEvent_t recorded;
+
+  take_event(&actual, &recorded);
+  run_timer_fires();
+  return recorded.result;
+}
+
+static void replay_values(HalTraceTag_t tag, float *values, uint32_t num_values) {
+  struct HalTraceEvent_t actual = { .tag = tag };
+  struct HalTraceEvent_t recorded;
+
+  take_event(&actual, &recorded);
+  memcpy(values, recorded.values, num_values * sizeof(float));
+  run_timer_fires();
+}
+
+bool hal_replay_start(const uint8_t *data, uint32_t size, HalTraceSink_t sink, void *context) {
+  memset(&s_replay, 0, sizeof(s_replay));
+  s_replay.stats.first_mismatch_tag = NUM_HAL_TRACE_TAGS;
+
+  if (!hal_trace_reader_init(&s_replay.reader, data, size)) {
+    return false;
+  }
+
+  if (sink != NULL) {
+    hal_trace_writer_init(&s_replay.writer, sink, context);
+    s_replay.has_output = true;
+  }
+
+  return true;
+}
+
+bool hal_replay_next_mark(uint8_t *kind, const uint8_t **payload, uint32_t *size) {
+  struct HalTraceEvent_t event;
+
+  run_timer_fires();
+
+  if (s_replay.stats.is_diverged || !hal_trace_peek(&s_replay.reader, &event)) {
+    return false;
+  }
+
+  if (event.tag != HAL_TRACE_MARK) {
+    diverge(event.tag, HAL_TRACE_MARK);
+    return false;
+  }
+
+  hal_trace_read(&s_replay.reader, &event);
+  s_replay.stats.num_events++;
+  emit(&event);
+
+  *kind = event.byte;
+  *payload = event.payload;
+  *size = event.payload_size;
+  return true;
+}
+
+bool hal_replay_expect_mark(uint8_t kind, const void *payload, uint32_t size) {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_MARK, .byte = kind, .payload = (const uint8_t *)payload, .payload_size = size };
+  struct HalTraceEvent_t recorded;
+  uint64_t num_mismatches = s_replay.stats.num_mismatches;
+
+  return take_event(&actual, &recorded) && (s_replay.stats.num_mismatches == num_mismatches);
+}
+
+void hal_replay_finish(struct HalReplayStats_t *stats) {
+  if (s_replay.has_output) {
+    hal_trace_writer_flush(&s_replay.writer);
+  }
+
+  s_replay.stats.is_complete = !s_replay.stats.is_diverged && (s_replay.reader.offset == s_replay.reader.size);
+  *stats = s_replay.stats;
+}
+
+bool hal_pwm_init(struct PwmConfig_t *config) {
+  (void)config;
+  return replay_result(HAL_TRACE_PWM_INIT);
+}
+
+bool hal_adc_init(struct AdcConfig_t *config) {
+  (void)config;
+  return replay_result(HAL_TRACE_ADC_INIT);
+}
+
+bool hal_gpio_init() {
+  return replay_result(HAL_TRACE_GPIO_INIT);
+}
+
+void hal_gpio_set_phase_high(MotorPhase_t phase) {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_GPIO_SET_PHASE_HIGH, .byte = (uint8_t)phase };
+
+  replay_output(&actual);
+}
+
+void hal_gpio_set_phase_low(MotorPhase_t phase) {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_GPIO_SET_PHASE_LOW, .byte = (uint8_t)phase };
+
+  replay_output(&actual);
+}
+
+void hal_gpio_set_phase_float(MotorPhase_t phase) {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_GPIO_SET_PHASE_FLOAT, .byte = (uint8_t)phase };
+
+  replay_output(&actual);
+}
+
+void hal_pwm_set_duty(MotorPhase_t phase, float duty) {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_PWM_SET_DUTY, .byte = (uint8_t)phase, .values = { duty } };
+
+  replay_output(&actual);
+}
+
+void hal_pwm_set_gates(uint16_t gate_mask, float duty) {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_PWM_SET_GATES, .word = gate_mask, .values = { duty } };
+
+  replay_output(&actual);
+}
+
+uint32_t hal_get_micros() {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_GET_MICROS };
+  struct HalTraceEvent_t recorded;
+
+  take_event(&actual, &recorded);
+  run_timer_fires();
+  return recorded.word;
+}
+
+/* The recorded result decides whether the timer is armed, its fires come from the trace */
+bool hal_timer_schedule(uint32_t fire_time_us, HalTimerCallback_t callback, void *context) {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_TIMER_SCHEDULE, .word = fire_time_us };
+  struct HalTraceEvent_t recorded;
+
+  if (take_event(&actual, &recorded) && recorded.result) {
+    s_replay.timer_callback = callback;
+    s_replay.timer_context = context;
+  }
+
+  run_timer_fires();
+  return recorded.result;
+}
+
+void hal_timer_cancel() {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_TIMER_CANCEL };
+
+  s_replay.timer_callback = NULL;
+  replay_output(&actual);
+}
+
+void hal_delay_us(uint32_t delay_us) {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_DELAY_US, .word = delay_us };
+
+  replay_output(&actual);
+}
+
+void hal_delay_ms(uint32_t delay_ms) {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_DELAY_MS, .word = delay_ms };
+
+  replay_output(&actual);
+}
+
+void hal_adc_start_conversion() {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_ADC_START_CONVERSION };
+
+  replay_output(&actual);
+}
+
+bool hal_adc_set_pwm_trigger(float on_time_fraction) {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_ADC_SET_PWM_TRIGGER, .values = { on_time_fraction } };
+  struct HalTraceEvent_t recorded;
+
+  take_event(&actual, &recorded);
+  run_timer_fires();
+  return recorded.result;
+}
+
+void hal_adc_get_phase_voltages(float *voltages) {
+  replay_values(HAL_TRACE_ADC_PHASE_VOLTAGES, voltages, NUM_MOTOR_PHASES);
+}
+
+void hal_adc_get_phase_currents(float *currents) {
+  replay_values(HAL_TRACE_ADC_PHASE_CURRENTS, currents, NUM_MOTOR_PHASES);
+}
+
+float hal_adc_get_dc_voltage() {
+  float dc_voltage;
+
+  replay_values(HAL_TRACE_ADC_DC_VOLTAGE, &dc_voltage, 1U);
+  return dc_voltage;
+}
+
+float hal_adc_get_temperature() {
+  float temperature;
+
+  replay_values(HAL_TRACE_ADC_TEMPERATURE, &temperature, 1U);
+  return temperature;
+}
+
+bool hal_gpio_init_hall_sensors() {
+  return replay_result(HAL_TRACE_GPIO_INIT_HALL);
+}
+
+uint8_t hal_gpio_get_hall_state() {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_GPIO_HALL_STATE };
+  struct HalTraceEvent_t recorded;
+
+  take_event(&actual, &recorded);
+  run_timer_fires();
+  return recorded.byte;
+}
+
+bool hal_hall_capture_init() {
+  return replay_result(HAL_TRACE_HALL_CAPTURE_INIT);
+}
+
+bool hal_hall_capture_pop(struct HallEdge_t *edge) {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_HALL_CAPTURE_POP };
+  struct HalTraceEvent_t recorded;
+
+  take_event(&actual, &recorded);
+
+  if (recorded.result && edge != NULL) {
+    edge->timestamp_us = recorded.word;
+    edge->hall_state = recorded.byte;
+  }
+
+  run_timer_fires();
+  return recorded.result;
+}
+
+bool hal_encoder_init() {
+  return replay_result(HAL_TRACE_ENCODER_INIT);
+}
+
+float hal_encoder_get_position() {
+  float position;
+
+  replay_values(HAL_TRACE_ENCODER_POSITION, &position, 1U);
+  return position;
+}
+
+float hal_encoder_get_velocity() {
+  float velocity;
+
+  replay_values(HAL_TRACE_ENCODER_VELOCITY, &velocity, 1U);
+  return velocity;
+}
+
+void hal_set_pwm(struct PwmConfig_t *config, float duty_a, float duty_b, float duty_c) {
+  struct HalTraceEvent_t actual = { .tag = HAL_TRACE_SET_PWM, .values = { duty_a, duty_b, duty_c } };
+
+  (void)config;
+  replay_output(&actual);
+}
@@ -18,6 +18,7 @@
 
 /* Intra-component Headers */
 #include "hal.h"
+#include "hal_sim.h"
 
 /*******************************************************************************************************************************
  * Simulation Parameters and Constants
@@ -31,16 +32,36 @@
 #define SIM_MOTOR_INERTIA 0.0001f         /**< Rotor inertia (kg⋅m²) */
 #define SIM_MOTOR_FRICTION 0.00001f       /**< Friction coefficient (Nm⋅s/rad) */
 #define SIM_MOTOR_COGGING_AMPLITUDE 0.05f /**< Cogging torque amplitude (Nm) */
+#define SIM_MOTOR_SATURATION_CURRENT 5.0f /**< d-axis current of the saturation knee of a salient rotor (A) */
 
-#define SIM_DC_VOLTAGE 24.0f           /**< Simulated DC bus voltage */
+#define SIM_DC_VOLTAGE 24.0f           /**< Default simulated DC bus voltage */
 #define SIM_AMBIENT_TEMPERATURE 25.0f  /**< Ambient temperature (°C) */
 #define SIM_THERMAL_RESISTANCE 10.0f   /**< Thermal resistance (°C/W) */
 #define SIM_ADC_NOISE_LEVEL 0.01f      /**< ADC noise level (% of full scale) */
 #define SIM_CURRENT_SENSOR_GAIN 0.1f   /**< Current sensor gain (V/A) */
 #define SIM_VOLTAGE_DIVIDER_RATIO 0.1f /**< Voltage divider ratio */
 
-#define SIM_CONTROL_FREQUENCY 10000.0f        /**< Control loop frequency (Hz) */
-#define SIM_DT (1.0f / SIM_CONTROL_FREQUENCY) /**< Time step (s) */
+#define SIM_HALL_ANGLE_OFFSET (PI / 6.0f) /**< Electrical angle of the 011 -> 001 Hall edge (rad), 6-step torque aligned */
+
+#define SIM_HALL_EDGE_QUEUE_SIZE 16U /**< Depth of the emulated Hall input capture queue */
+
+#define SIM_PHYSICS_STEP_US 2U          /**< Motor model integration step (us) */
+#define SIM_MAX_PHASE_CURRENT 50.0f     /**< Phase current limit of the model (A) */
+#define SIM_FLOAT_CURRENT_EPSILON 1e-3f /**< Below this a freewheeling diode stops conducting (A) */
+#define SIM_SWITCH_RDS_ON 0.01f         /**< On-resistance of a bridge switch (Ohm) */
+#define SIM_DIODE_FORWARD_VOLTAGE 0.7f  /**< Forward voltage of a bridge switch body diode (V) */
+
+#define SIM_DEFAULT_PWM_FREQUENCY 20000U  /**< PWM frequency assumed before hal_pwm_init() (Hz) */
+#define SIM_RINGING_AMPLITUDE 0.2f        /**< Floating phase ringing after a switching edge (fraction of the DC bus) */
+#define SIM_RINGING_TIME_CONSTANT_US 0.5f /**< Decay time constant of the switching ringing (us) */
+#define SIM_RINGING_FREQUENCY_MHZ 2.0f    /**< Frequency of the switching ringing (MHz) */
+
+#define SIM_LOG(...)       \
+  do {                     \
+    if (s_sim_verbose) {   \
+      printf(__VA_ARGS__); \
+    }                      \
+  } while (0)
 
 #define PI 3.14159265f
 
@@ -48,6 +69,15 @@
  * Simulation State Structure
  *******************************************************************************************************************************/
 
+/**
+ * @brief Bridge leg conduction state within one PWM interval
+ */
+typedef enum {
+  SIM_LEG_OPEN, /**< Both switches off, a body diode carries any winding current */
+  SIM_LEG_HIGH, /**< High side switch on */
+  SIM_LEG_LOW   /**< Low side switch on */
+} SimLegState_t;
+
 typedef struct {
   /* Motor electrical state */
   float rotor_angle;       /**< Rotor electrical angle (rad) */
@@ -56,15 +86,42 @@ typedef struct {
   float phase_voltages[3]; /**< Phase voltages (V) */
   float bemf_voltages[3];  /**< Back-EMF voltages (V) */
 
+  float neutral_voltage;    /**< Star point voltage referenced to the negative DC rail (V) */
+  bool phase_conducting[3]; /**< Phase carries current through a switch or a freewheeling diode */
+  float dc_voltage;         /**< DC bus voltage (V) */
+
+  /* Back-EMF zero-crossings */
+  uint32_t bemf_zc_time[3];  /**< Interpolated time of the last back-EMF zero-crossing of each phase (us) */
+  uint32_t bemf_sample_time; /**< Simulation time bemf_voltages were calculated at (us) */
+
+  /* Rotor saliency */
+  bool is_salient;    /**< Inductance follows the rotor, set by hal_sim_set_saliency() */
+  float inductance_d; /**< Unsaturated d-axis inductance (H) */
+  float inductance_q; /**< q-axis inductance (H) */
+  float saturation;   /**< Fraction of the d-axis inductance lost to saturation at large d-axis current */
+
   /* Motor mechanical state */
   float torque_electrical; /**< Electrical torque (Nm) */
   float torque_load;       /**< Load torque (Nm) */
   float torque_cogging;    /**< Cogging torque (Nm) */
 
   /* PWM state */
-  float pwm_duty[3];  /**< PWM duty cycles (0-1) */
-  bool phase_high[3]; /**< Phase high-side state */
-  bool phase_low[3];  /**< Phase low-side state */
+  float pwm_duty[3];       /**< PWM duty cycles (0-1) */
+  bool phase_high[3];      /**< Phase high-side state */
+  bool phase_low[3];       /**< Phase low-side state */
+  bool phase_modulated[3]; /**< Enabled switches follow the duty cycle, complementary when both are enabled */
+
+  /* Inverter conduction */
+  float dc_current;                               /**< Averaged DC link current (A) */
+  float device_loss_power[2U * NUM_MOTOR_PHASES]; /**< Conduction loss of each switch and its body diode (W) */
+  float switch_loss_power;                        /**< Conduction loss in the switch channels (W) */
+  float diode_loss_power;                         /**< Conduction loss in the body diodes (W) */
+
+  /* Hall input capture */
+  struct HallEdge_t hall_edges[SIM_HALL_EDGE_QUEUE_SIZE]; /**< Captured Hall edge queue */
+  uint8_t hall_edge_head;                                 /**< Index of the oldest captured edge */
+  uint8_t hall_edge_count;                                /**< Number of queued edges */
+  bool hall_capture_enabled;                              /**< Hall edge capture running */
 
   /* Thermal state */
   float temperature;       /**< Motor temperature (°C) */
@@ -75,6 +132,19 @@ typedef struct {
   uint32_t last_update_time; /**< Last update time (us) */
   bool simulation_running;   /**< Simulation running flag */
 
+  /* ADC trigger */
+  bool adc_synchronized;      /**< Phase voltage conversions are triggered from the PWM */
+  float adc_trigger_fraction; /**< Trigger position inside the on-time (0-1) */
+
+  /* One-shot timer */
+  bool timer_armed;                  /**< Timer waiting to fire */
+  uint32_t timer_fire_time;          /**< Simulation time the timer fires at (us) */
+  HalTimerCallback_t timer_callback; /**< Callback run when the timer fires */
+  void *timer_context;               /**< Context passed to the timer callback */
+
+  /* Measurement accumulators */
+  struct HalSimStats_t stats; /**< Integrated torque and energy since the last hal_sim_reset_stats() */
+
   /* Test/fault injection */
   bool inject_overcurrent;    /**< Inject overcurrent fault */
   bool inject_overvoltage;    /**< Inject overvoltage fault */
@@ -87,11 +157,23 @@ typedef struct {
  * Static Variables
  *******************************************************************************************************************************/
 
+/**
+ * Hall code for each 60 degree sector starting at SIM_HALL_ANGLE_OFFSET. Forward rotation walks the 6-step Hall sequence
+ */
+static const uint8_t s_hall_sequence[6U] = { 0b011U, 0b001U, 0b101U, 0b100U, 0b110U, 0b010U };
+
 static struct PwmConfig_t *s_pwm_config = NULL;
 static struct AdcConfig_t *s_adc_config = NULL;
 static SimulationState_t s_sim_state = { 0 };
-static struct timespec s_start_time = { 0 };
 static bool s_hal_initialized = false;
+static bool s_sim_verbose = true;
+static bool s_noise_seeded = false;
+
+/* Outside the simulation state, a restart keeps the sampler */
+static HalSimSampleCallback_t s_sample_callback = NULL;
+static void *s_sample_context = NULL;
+static uint32_t s_sample_period_us = 0U;
+static uint32_t s_next_sample_time = 0U;
 
 /*******************************************************************************************************************************
  * Private Helper Functions
@@ -133,6 +215,79 @@ static void calculate_bemf(void) {
   s_sim_state.bemf_voltages[2] = SIM_MOTOR_KE * s_sim_state.rotor_velocity * sinf(electrical_angle - 4.0f * PI / 3.0f);
 }
 
+/**
+ * @brief Record the back-EMF zero-crossings between the previous and the current back-EMF calculation
+ */
+static void track_bemf_zero_crossings(const float *previous_bemf, uint32_t previous_time) {
+  for (int phase = 0; phase < 3; phase++) {
+    float bemf = s_sim_state.bemf_voltages[phase];
+    bool has_crossed = (previous_bemf[phase] < 0.0f && bemf >= 0.0f) || (previous_bemf[phase] > 0.0f && bemf <= 0.0f);
+
+    if (has_crossed) {
+      float fraction = previous_bemf[phase] / (previous_bemf[phase] - bemf);
+      s_sim_state.bemf_zc_time[phase] = previous_time + (uint32_t)(fraction * (float)(s_sim_state.simulation_time - previous_time));
+    }
+  }
+}
+
+/**
+ * @brief Calculate the Hall sensor code from the rotor electrical angle
+ */
+static uint8_t calculate_hall_state(void) {
+  float electrical_angle = s_sim_state.rotor_angle * (SIM_MOTOR_POLES / 2.0f) - SIM_HALL_ANGLE_OFFSET;
+  float sector = floorf(electrical_angle / (PI / 3.0f));
+  int index = (int)(sector - 6.0f * floorf(sector / 6.0f));
+
+  return s_hall_sequence[index % 6];
+}
+
+/**
+ * @brief Queue a Hall edge, dropping the oldest one when the capture queue is full
+ */
+static void capture_hall_edge(uint32_t timestamp_us, uint8_t hall_state) {
+  if (s_sim_state.hall_edge_count == SIM_HALL_EDGE_QUEUE_SIZE) {
+    s_sim_state.hall_edge_head = (s_sim_state.hall_edge_head + 1U) % SIM_HALL_EDGE_QUEUE_SIZE;
+    s_sim_state.hall_edge_count--;
+  }
+
+  uint8_t tail = (s_sim_state.hall_edge_head + s_sim_state.hall_edge_count) % SIM_HALL_EDGE_QUEUE_SIZE;
+  s_sim_state.hall_edges[tail].timestamp_us = timestamp_us;
+  s_sim_state.hall_edges[tail].hall_state = hall_state;
+  s_sim_state.hall_edge_count++;
+}
+
+/**
+ * @brief Emulate input capture of every Hall edge crossed during one simulation step
+ * @details The rotor angle is linear within a step, so each crossing time is interpolated between the step end points
+ *          instead of being quantized to the control period
+ */
+static void capture_hall_edges(float start_angle, float end_angle, uint32_t start_time_us, float dt) {
+  if (!s_sim_state.hall_capture_enabled || end_angle == start_angle) {
+    return;
+  }
+
+  const float sector_angle = PI / 3.0f;
+  float start_electrical = start_angle * (SIM_MOTOR_POLES / 2.0f) - SIM_HALL_ANGLE_OFFSET;
+  float end_electrical = end_angle * (SIM_MOTOR_POLES / 2.0f) - SIM_HALL_ANGLE_OFFSET;
+  float start_sector = floorf(start_electrical / sector_angle);
+  float end_sector = floorf(end_electrical / sector_angle);
+  float step_us = dt * 1000000.0f;
+
+  if (end_sector > start_sector) {
+    for (float sector = start_sector + 1.0f; sector <= end_sector; sector += 1.0f) {
+      float fraction = (sector * sector_angle - start_electrical) / (end_electrical - start_electrical);
+      int index = (int)(sector - 6.0f * floorf(sector / 6.0f));
+      capture_hall_edge(start_time_us + (uint32_t)(fraction * step_us), s_hall_sequence[index % 6]);
+    }
+  } else {
+    for (float sector = start_sector; sector > end_sector; sector -= 1.0f) {
+      float fraction = (sector * sector_angle - start_electrical) / (end_electrical - start_electrical);
+      int index = (int)((sector - 1.0f) - 6.0f * floorf((sector - 1.0f) / 6.0f));
+      capture_hall_edge(start_time_us + (uint32_t)(fraction * step_us), s_hall_sequence[index % 6]);
+    }
+  }
+}
+
 /**
  * @brief Calculate cogging torque
  */
@@ -141,36 +296,306 @@ static float calculate_cogging_torque(void) {
   return SIM_MOTOR_COGGING_AMPLITUDE * sinf(electrical_angle * 6.0f);  // 6 cogging periods per electrical revolution
 }
 
+/**
+ * @brief Rotor flux direction and incremental d-axis inductance of a salient rotor
+ * @details The magnet flux lies 180 degrees from the electrical angle the back-EMF is referenced to. Current along the flux
+ *          adds to it and saturates the iron, current against it relieves it
+ */
+static float calculate_salient_inductance_d(float *cos_flux, float *sin_flux) {
+  float flux_angle = s_sim_state.rotor_angle * (SIM_MOTOR_POLES / 2.0f) + PI;
+  float current_alpha = (2.0f * s_sim_state.phase_currents[0] - s_sim_state.phase_currents[1] - s_sim_state.phase_currents[2]) / 3.0f;
+  float current_beta = (s_sim_state.phase_currents[1] - s_sim_state.phase_currents[2]) / sqrtf(3.0f);
+
+  *cos_flux = cosf(flux_angle);
+  *sin_flux = sinf(flux_angle);
+
+  float current_d = *cos_flux * current_alpha + *sin_flux * current_beta;
+  return s_sim_state.inductance_d * (1.0f - s_sim_state.saturation * tanhf(current_d / SIM_MOTOR_SATURATION_CURRENT));
+}
+
+/**
+ * @brief Coupling of the windings of a salient rotor when current flows in at phase p and out at phase q
+ * @details The rotor couples the windings, so the current sees the inductance of its direction and the voltage splits
+ *          unevenly. With u = v_leg - R * i - e, the star point sits at u_p - star_weight * (u_p - u_q) and the open winding
+ *          picks up open_weight * (u_p - u_q). A round rotor gives 1/2 and 0
+ * @return Inductance of the two windings in series (H)
+ */
+static float calculate_salient_coupling(int p, int q, float *star_weight, float *open_weight) {
+  const float phase_cos[3] = { 1.0f, -0.5f, -0.5f };
+  const float phase_sin[3] = { 0.0f, 0.8660254f, -0.8660254f };
+  float cos_flux, sin_flux;
+  float inductance_d = calculate_salient_inductance_d(&cos_flux, &sin_flux);
+  int r = 3 - p - q;
+
+  /* Current direction in the stationary frame, and the flux it links along d and q per amp */
+  float direction_alpha = (2.0f / 3.0f) * (phase_cos[p] - phase_cos[q]);
+  float direction_beta = (2.0f / 3.0f) * (phase_sin[p] - phase_sin[q]);
+  float flux_d = inductance_d * (cos_flux * direction_alpha + sin_flux * direction_beta);
+  float flux_q = s_sim_state.inductance_q * (-sin_flux * direction_alpha + cos_flux * direction_beta);
+  float flux_alpha = cos_flux * flux_d - sin_flux * flux_q;
+  float flux_beta = sin_flux * flux_d + cos_flux * flux_q;
+  float inductance = 1.5f * (direction_alpha * flux_alpha + direction_beta * flux_beta);
+
+  *star_weight = (phase_cos[p] * flux_alpha + phase_sin[p] * flux_beta) / inductance;
+  *open_weight = (phase_cos[r] * flux_alpha + phase_sin[r] * flux_beta) / inductance;
+  return inductance;
+}
+
+/**
+ * @brief Current slopes of the conducting windings of a salient rotor
+ * @details Two conducting windings carry one current through their series inductance. Three are solved along d and q,
+ *          where the star point is the average of the drive voltages as with a round rotor
+ * @param drive_voltages Leg voltage less the resistive drop and the back-EMF of each phase (V)
+ * @param current_rates Rate of change of each phase current (A/s)
+ * @param open_voltage Voltage the open winding picks up from the other two (V)
+ * @return Star point voltage (V)
+ */
+static float calculate_salient_current_rates(const float *drive_voltages, float *current_rates, float *open_voltage) {
+  int conducting[3];
+  int count = 0;
+
+  for (int phase = 0; phase < 3; phase++) {
+    current_rates[phase] = 0.0f;
+    if (s_sim_state.phase_conducting[phase]) {
+      conducting[count++] = phase;
+    }
+  }
+
+  *open_voltage = 0.0f;
+
+  if (count == 2) {
+    int p = conducting[0];
+    int q = conducting[1];
+    float star_weight, open_weight;
+    float inductance = calculate_salient_coupling(p, q, &star_weight, &open_weight);
+    float drive = drive_voltages[p] - drive_voltages[q];
+
+    current_rates[p] = drive / inductance;
+    current_rates[q] = -current_rates[p];
+    *open_voltage = open_weight * drive;
+    return drive_voltages[p] - star_weight * drive;
+  }
+
+  float neutral = (drive_voltages[0] + drive_voltages[1] + drive_voltages[2]) / 3.0f;
+  float cos_flux, sin_flux;
+  float inductance_d = calculate_salient_inductance_d(&cos_flux, &sin_flux);
+  float drive_alpha = (2.0f * drive_voltages[0] - drive_voltages[1] - drive_voltages[2]) / 3.0f;
+  float drive_beta = (drive_voltages[1] - drive_voltages[2]) / sqrtf(3.0f);
+  float rate_d = (cos_flux * drive_alpha + sin_flux * drive_beta) / inductance_d;
+  float rate_q = (-sin_flux * drive_alpha + cos_flux * drive_beta) / s_sim_state.inductance_q;
+  float rate_alpha = cos_flux * rate_d - sin_flux * rate_q;
+  float rate_beta = sin_flux * rate_d + cos_flux * rate_q;
+
+  current_rates[0] = rate_alpha;
+  current_rates[1] = -0.5f * rate_alpha + 0.8660254f * rate_beta;
+  current_rates[2] = -0.5f * rate_alpha - 0.8660254f * rate_beta;
+  return neutral;
+}
+
+/**
+ * @brief Switch state of a leg during the on-time or the off-time of the PWM period
+ */
+static SimLegState_t leg_state(int phase, bool is_on) {
+  bool is_high = s_sim_state.phase_high[phase];
+  bool is_low = s_sim_state.phase_low[phase];
+
+  if (!s_sim_state.phase_modulated[phase]) {
+    /* A leg held on does not switch. Both switches held on would short the bus, the HAL floats such a leg */
+    if (is_high != is_low) {
+      return is_high ? SIM_LEG_HIGH : SIM_LEG_LOW;
+    }
+    return SIM_LEG_OPEN;
+  }
+
+  if (is_high && is_low) {
+    /* Complementary: the low side synchronously rectifies during the off-time */
+    return is_on ? SIM_LEG_HIGH : SIM_LEG_LOW;
+  }
+
+  if (is_on && (is_high || is_low)) {
+    return is_high ? SIM_LEG_HIGH : SIM_LEG_LOW;
+  }
+
+  return SIM_LEG_OPEN;
+}
+
+/**
+ * @brief Voltage of an open leg, clamped by the body diode that carries the winding current
+ * @return TRUE if a diode conducts
+ */
+static bool open_leg_voltage(int phase, float *voltage) {
+  float current = s_sim_state.phase_currents[phase];
+
+  /* Zero current in a switching leg freewheels the way its switch drives it */
+  if (fabsf(current) <= SIM_FLOAT_CURRENT_EPSILON && s_sim_state.phase_modulated[phase]) {
+    current = s_sim_state.phase_high[phase] ? 1.0f : -1.0f;
+  }
+
+  if (current > SIM_FLOAT_CURRENT_EPSILON) {
+    /* Current flowing into the winding freewheels through the low side diode */
+    *voltage = -SIM_DIODE_FORWARD_VOLTAGE;
+    return true;
+  } else if (current < -SIM_FLOAT_CURRENT_EPSILON) {
+    /* Current flowing out of the winding freewheels through the high side diode */
+    *voltage = s_sim_state.dc_voltage + SIM_DIODE_FORWARD_VOLTAGE;
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief Average every leg over the PWM period and accumulate the bridge conduction losses
+ * @details Each leg spends duty * period in its on-time state and the rest in its off-time state. A switch dissipates
+ *          I^2 * Rds_on, a body diode Vf * |I|. A leg with no switch or diode conducting is marked as not conducting
+ */
+static void update_inverter_conduction(float *leg_voltages) {
+  s_sim_state.dc_current = 0.0f;
+  s_sim_state.switch_loss_power = 0.0f;
+  s_sim_state.diode_loss_power = 0.0f;
+
+  for (int phase = 0; phase < 3; phase++) {
+    float current = s_sim_state.phase_currents[phase];
+    float on_fraction = s_sim_state.phase_modulated[phase] ? s_sim_state.pwm_duty[phase] : 1.0f;
+    float *high_loss = &s_sim_state.device_loss_power[2 * phase];
+    float *low_loss = &s_sim_state.device_loss_power[2 * phase + 1];
+
+    *high_loss = 0.0f;
+    *low_loss = 0.0f;
+    leg_voltages[phase] = 0.0f;
+    s_sim_state.phase_conducting[phase] = true;
+
+    for (int interval = 0; interval < 2; interval++) {
+      float fraction = (interval == 0) ? on_fraction : (1.0f - on_fraction);
+      float voltage = 0.0f;
+
+      if (fraction <= 0.0f) {
+        continue;
+      }
+
+      switch (leg_state(phase, interval == 0)) {
+        case SIM_LEG_HIGH:
+          voltage = s_sim_state.dc_voltage - current * SIM_SWITCH_RDS_ON;
+          *high_loss += fraction * current * current * SIM_SWITCH_RDS_ON;
+          s_sim_state.switch_loss_power += fraction * current * current * SIM_SWITCH_RDS_ON;
+          s_sim_state.dc_current += fraction * current;
+          break;
+        case SIM_LEG_LOW:
+          voltage = -current * SIM_SWITCH_RDS_ON;
+          *low_loss += fraction * current * current * SIM_SWITCH_RDS_ON;
+          s_sim_state.switch_loss_power += fraction * current * current * SIM_SWITCH_RDS_ON;
+          break;
+        default:
+          if (!open_leg_voltage(phase, &voltage)) {
+            /* No switch and no diode conducts, the winding is disconnected */
+            s_sim_state.phase_conducting[phase] = false;
+            break;
+          }
+          *(current < 0.0f ? high_loss : low_loss) += fraction * SIM_DIODE_FORWARD_VOLTAGE * fabsf(current);
+          s_sim_state.diode_loss_power += fraction * SIM_DIODE_FORWARD_VOLTAGE * fabsf(current);
+          if (current < 0.0f) {
+            /* The high side diode returns the freewheel current to the bus */
+            s_sim_state.dc_current += fraction * current;
+          }
+          break;
+      }
+
+      leg_voltages[phase] += fraction * voltage;
+    }
+
+    if (!s_sim_state.phase_conducting[phase]) {
+      s_sim_state.phase_currents[phase] = 0.0f;
+      leg_voltages[phase] = 0.0f;
+    }
+  }
+}
+
 /**
  * @brief Update motor electrical dynamics
+ * @details Star connected windings with an averaged inverter model. Each leg is averaged over its on-time and off-time
+ *          states, a floating leg keeps conducting through its freewheeling diode until its current reaches zero. The star
+ *          point voltage follows from the conducting phase currents summing to zero. A salient rotor couples the windings,
+ *          its current slopes and star point come from calculate_salient_current_rates()
  */
-static void update_electrical_dynamics(void) {
-  float dt = SIM_DT;
+static void update_electrical_dynamics(float dt) {
+  float leg_voltages[3] = { 0.0f };
+  float current_rates[3] = { 0.0f };
+  float open_voltage = 0.0f;
+  float neutral_sum = 0.0f;
+  int conducting_count = 0;
+
+  update_inverter_conduction(leg_voltages);
 
-  /* Calculate phase voltages based on PWM and switching states */
   for (int phase = 0; phase < 3; phase++) {
-    if (s_sim_state.phase_high[phase]) {
-      s_sim_state.phase_voltages[phase] = s_sim_state.pwm_duty[phase] * SIM_DC_VOLTAGE;
-    } else if (s_sim_state.phase_low[phase]) {
-      s_sim_state.phase_voltages[phase] = 0.0f;
-    } else {
-      /* Floating phase - voltage determined by back-EMF and current flow */
-      s_sim_state.phase_voltages[phase] = s_sim_state.bemf_voltages[phase];
+    if (s_sim_state.phase_conducting[phase]) {
+      neutral_sum += leg_voltages[phase] - s_sim_state.bemf_voltages[phase];
+      conducting_count++;
+    }
+  }
+
+  /* Without a closed path through at least two windings no current can flow */
+  if (conducting_count < 2) {
+    for (int phase = 0; phase < 3; phase++) {
+      s_sim_state.phase_conducting[phase] = false;
+      s_sim_state.phase_currents[phase] = 0.0f;
+    }
+    s_sim_state.neutral_voltage = 0.0f;
+  } else if (s_sim_state.is_salient) {
+    float drive_voltages[3];
+    for (int phase = 0; phase < 3; phase++) {
+      drive_voltages[phase] =
+          leg_voltages[phase] - SIM_MOTOR_RESISTANCE * s_sim_state.phase_currents[phase] - s_sim_state.bemf_voltages[phase];
     }
+    s_sim_state.neutral_voltage = calculate_salient_current_rates(drive_voltages, current_rates, &open_voltage);
+  } else {
+    s_sim_state.neutral_voltage = neutral_sum / (float)conducting_count;
   }
 
-  /* Update phase currents using simplified electrical model */
   for (int phase = 0; phase < 3; phase++) {
-    float voltage_drop = s_sim_state.phase_voltages[phase] - s_sim_state.bemf_voltages[phase];
-    float target_current = voltage_drop / SIM_MOTOR_RESISTANCE;
+    if (!s_sim_state.phase_conducting[phase]) {
+      /* Open winding: the terminal follows the back-EMF on top of the star point */
+      s_sim_state.phase_voltages[phase] = s_sim_state.bemf_voltages[phase] + s_sim_state.neutral_voltage + open_voltage;
+      continue;
+    }
 
-    /* Simple first-order current dynamics */
-    float tau = SIM_MOTOR_INDUCTANCE / SIM_MOTOR_RESISTANCE;
-    s_sim_state.phase_currents[phase] += (target_current - s_sim_state.phase_currents[phase]) * dt / tau;
+    s_sim_state.phase_voltages[phase] = leg_voltages[phase];
+
+    /* L * di/dt = v_leg - v_neutral - R * i - e */
+    float previous_current = s_sim_state.phase_currents[phase];
+    float voltage_drop = leg_voltages[phase] - s_sim_state.neutral_voltage - SIM_MOTOR_RESISTANCE * previous_current -
+                         s_sim_state.bemf_voltages[phase];
+    if (s_sim_state.is_salient) {
+      s_sim_state.phase_currents[phase] += current_rates[phase] * dt;
+    } else {
+      s_sim_state.phase_currents[phase] += (voltage_drop / SIM_MOTOR_INDUCTANCE) * dt;
+    }
+
+    /* A freewheeling diode blocks once its current reverses */
+    bool is_driven = s_sim_state.phase_high[phase] || s_sim_state.phase_low[phase];
+    if (!is_driven && (previous_current * s_sim_state.phase_currents[phase]) <= 0.0f) {
+      s_sim_state.phase_currents[phase] = 0.0f;
+      s_sim_state.phase_conducting[phase] = false;
+    }
 
     /* Limit current to realistic values */
-    if (s_sim_state.phase_currents[phase] > 20.0f) s_sim_state.phase_currents[phase] = 20.0f;
-    if (s_sim_state.phase_currents[phase] < -20.0f) s_sim_state.phase_currents[phase] = -20.0f;
+    if (s_sim_state.phase_currents[phase] > SIM_MAX_PHASE_CURRENT) s_sim_state.phase_currents[phase] = SIM_MAX_PHASE_CURRENT;
+    if (s_sim_state.phase_currents[phase] < -SIM_MAX_PHASE_CURRENT) s_sim_state.phase_currents[phase] = -SIM_MAX_PHASE_CURRENT;
+  }
+
+  /* The star point carries no current. Remove the residual left by a blocking diode so the windings obey KCL */
+  float current_sum = 0.0f;
+  conducting_count = 0;
+  for (int phase = 0; phase < 3; phase++) {
+    if (s_sim_state.phase_conducting[phase]) {
+      current_sum += s_sim_state.phase_currents[phase];
+      conducting_count++;
+    }
+  }
+  for (int phase = 0; phase < 3; phase++) {
+    if (s_sim_state.phase_conducting[phase]) {
+      s_sim_state.phase_currents[phase] =
+          (conducting_count >= 2) ? (s_sim_state.phase_currents[phase] - current_sum / (float)conducting_count) : 0.0f;
+    }
   }
 
   /* Calculate electrical torque */
@@ -178,14 +603,23 @@ static void update_electrical_dynamics(void) {
   s_sim_state.torque_electrical = SIM_MOTOR_KT * (s_sim_state.phase_currents[0] * sinf(electrical_angle) +
                                                   s_sim_state.phase_currents[1] * sinf(electrical_angle - 2.0f * PI / 3.0f) +
                                                   s_sim_state.phase_currents[2] * sinf(electrical_angle - 4.0f * PI / 3.0f));
+
+  /* Reluctance torque 3/2 * p * (Ld - Lq) * id * iq, with d along the rotor flux */
+  if (s_sim_state.is_salient) {
+    float flux_angle = electrical_angle + PI;
+    float current_alpha = (2.0f * s_sim_state.phase_currents[0] - s_sim_state.phase_currents[1] - s_sim_state.phase_currents[2]) / 3.0f;
+    float current_beta = (s_sim_state.phase_currents[1] - s_sim_state.phase_currents[2]) / sqrtf(3.0f);
+    float current_d = cosf(flux_angle) * current_alpha + sinf(flux_angle) * current_beta;
+    float current_q = -sinf(flux_angle) * current_alpha + cosf(flux_angle) * current_beta;
+    s_sim_state.torque_electrical +=
+        1.5f * (SIM_MOTOR_POLES / 2.0f) * (s_sim_state.inductance_d - s_sim_state.inductance_q) * current_d * current_q;
+  }
 }
 
 /**
  * @brief Update motor mechanical dynamics
  */
-static void update_mechanical_dynamics(void) {
-  float dt = SIM_DT;
-
+static void update_mechanical_dynamics(float dt) {
   /* Calculate cogging torque */
   s_sim_state.torque_cogging = calculate_cogging_torque();
 
@@ -197,7 +631,9 @@ static void update_mechanical_dynamics(void) {
   s_sim_state.rotor_velocity += (total_torque / SIM_MOTOR_INERTIA) * dt;
 
   /* Update rotor angle */
+  float start_angle = s_sim_state.rotor_angle;
   s_sim_state.rotor_angle += s_sim_state.rotor_velocity * dt;
+  capture_hall_edges(start_angle, s_sim_state.rotor_angle, s_sim_state.simulation_time, dt);
 
   /* Wrap angle to [0, 2π] */
   while (s_sim_state.rotor_angle >= 2.0f * PI) {
@@ -211,9 +647,7 @@ static void update_mechanical_dynamics(void) {
 /**
  * @brief Update thermal dynamics
  */
-static void update_thermal_dynamics(void) {
-  float dt = SIM_DT;
-
+static void update_thermal_dynamics(float dt) {
   /* Calculate power dissipation */
   s_sim_state.power_dissipation = 0.0f;
   for (int phase = 0; phase < 3; phase++) {
@@ -232,25 +666,173 @@ static void update_thermal_dynamics(void) {
 }
 
 /**
- * @brief Update complete simulation state
+ * @brief Accumulate torque and energy for hal_sim_get_stats()
  */
-static void update_simulation_state(void) {
-  if (!s_sim_state.simulation_running) {
-    return;
+static void update_stats(float dt) {
+  struct HalSimStats_t *stats = &s_sim_state.stats;
+  float torque = s_sim_state.torque_electrical;
+
+  if (stats->duration_s == 0.0f || torque < stats->torque_min) stats->torque_min = torque;
+  if (stats->duration_s == 0.0f || torque > stats->torque_max) stats->torque_max = torque;
+
+  stats->duration_s += dt;
+  stats->torque_integral += torque * dt;
+  stats->torque_squared_integral += torque * torque * dt;
+  stats->velocity_integral += s_sim_state.rotor_velocity * dt;
+  stats->electrical_energy += s_sim_state.dc_voltage * s_sim_state.dc_current * dt;
+  stats->mechanical_energy += torque * s_sim_state.rotor_velocity * dt;
+  stats->copper_loss_energy += s_sim_state.power_dissipation * dt;
+  stats->switch_loss_energy += s_sim_state.switch_loss_power * dt;
+  stats->diode_loss_energy += s_sim_state.diode_loss_power * dt;
+
+  for (int device = 0; device < 2 * NUM_MOTOR_PHASES; device++) {
+    stats->device_loss_energy[device] += s_sim_state.device_loss_power[device] * dt;
   }
+}
+
+/**
+ * @brief Terminal voltages at the ADC sampling instant
+ * @details The dynamics use averaged leg voltages, but the ADC sees the instantaneous switch state. A PWM triggered
+ *          conversion samples the switching legs in their on-state at a fixed delay after the rising edge, a free-running
+ *          conversion lands anywhere in the PWM period. The floating phase rings after every switching edge
+ */
+static void sample_terminal_voltages(float *voltages) {
+  uint32_t pwm_frequency = (s_pwm_config != NULL && s_pwm_config->frequency > 0U) ? s_pwm_config->frequency : SIM_DEFAULT_PWM_FREQUENCY;
+  float pwm_period_us = 1000000.0f / (float)pwm_frequency;
+  float duty = 0.0f;
 
-  uint32_t current_time = hal_get_micros();
-  if ((current_time - s_sim_state.last_update_time) < (1000000 / SIM_CONTROL_FREQUENCY)) {
-    return;  // Not time for update yet
+  for (int phase = 0; phase < 3; phase++) {
+    if (s_sim_state.phase_modulated[phase] && s_sim_state.pwm_duty[phase] > duty) {
+      duty = s_sim_state.pwm_duty[phase];
+    }
+  }
+
+  float on_time_us = duty * pwm_period_us;
+  float edge_age_us = 0.0f;
+  bool is_on = false;
+
+  if (s_sim_state.adc_synchronized) {
+    is_on = duty > 0.0f;
+    edge_age_us = s_sim_state.adc_trigger_fraction * on_time_us;
+  } else {
+    float sample_instant_us = ((float)rand() / RAND_MAX) * pwm_period_us;
+    is_on = sample_instant_us < on_time_us;
+    edge_age_us = is_on ? sample_instant_us : (sample_instant_us - on_time_us);
   }
 
+  float leg_voltages[3] = { 0.0f };
+  float neutral_sum = 0.0f;
+  int conducting_count = 0;
+
+  for (int phase = 0; phase < 3; phase++) {
+    switch (leg_state(phase, is_on)) {
+      case SIM_LEG_HIGH:
+        leg_voltages[phase] = s_sim_state.dc_voltage;
+        break;
+      case SIM_LEG_LOW:
+        leg_voltages[phase] = 0.0f;
+        break;
+      default:
+        if (!open_leg_voltage(phase, &leg_voltages[phase])) {
+          leg_voltages[phase] = 0.0f;
+        }
+        break;
+    }
+
+    if (s_sim_state.phase_conducting[phase]) {
+      neutral_sum += leg_voltages[phase] - s_sim_state.bemf_voltages[phase];
+      conducting_count++;
+    }
+  }
+
+  float neutral_voltage = (conducting_count >= 2) ? (neutral_sum / (float)conducting_count) : 0.0f;
+  float open_voltage = 0.0f;
+  float ringing = 0.0f;
+
+  /* A salient rotor splits the voltage of two conducting windings unevenly and couples into the open one */
+  if (s_sim_state.is_salient && conducting_count == 2) {
+    int p = s_sim_state.phase_conducting[0] ? 0 : 1;
+    int q = s_sim_state.phase_conducting[2] ? 2 : 1;
+    float star_weight, open_weight;
+    float drive_p = leg_voltages[p] - SIM_MOTOR_RESISTANCE * s_sim_state.phase_currents[p] - s_sim_state.bemf_voltages[p];
+    float drive_q = leg_voltages[q] - SIM_MOTOR_RESISTANCE * s_sim_state.phase_currents[q] - s_sim_state.bemf_voltages[q];
+
+    calculate_salient_coupling(p, q, &star_weight, &open_weight);
+    neutral_voltage = drive_p - star_weight * (drive_p - drive_q);
+    open_voltage = open_weight * (drive_p - drive_q);
+  }
+
+  /* A leg held at 0% or 100% does not switch */
+  if (duty > 0.0f && duty < 1.0f) {
+    ringing = SIM_RINGING_AMPLITUDE * s_sim_state.dc_voltage * expf(-edge_age_us / SIM_RINGING_TIME_CONSTANT_US) *
+              cosf(2.0f * PI * SIM_RINGING_FREQUENCY_MHZ * edge_age_us);
+  }
+
+  for (int phase = 0; phase < 3; phase++) {
+    if (s_sim_state.phase_conducting[phase]) {
+      voltages[phase] = leg_voltages[phase];
+    } else {
+      voltages[phase] = s_sim_state.bemf_voltages[phase] + neutral_voltage + open_voltage + ringing;
+    }
+  }
+}
+
+/**
+ * @brief Integrate the motor model over one step
+ */
+static void simulate_step(uint32_t step_us) {
+  float dt = (float)step_us / 1000000.0f;
+  float previous_bemf[3] = { s_sim_state.bemf_voltages[0], s_sim_state.bemf_voltages[1], s_sim_state.bemf_voltages[2] };
+
   calculate_bemf();
-  update_electrical_dynamics();
-  update_mechanical_dynamics();
-  update_thermal_dynamics();
+  track_bemf_zero_crossings(previous_bemf, s_sim_state.bemf_sample_time);
+  s_sim_state.bemf_sample_time = s_sim_state.simulation_time;
+  update_electrical_dynamics(dt);
+  update_mechanical_dynamics(dt);
+  update_thermal_dynamics(dt);
+  update_stats(dt);
+
+  s_sim_state.simulation_time += step_us;
+}
+
+/**
+ * @brief Advance the simulation clock, firing the one-shot timer at its exact due time
+ */
+static void simulate_until(uint32_t target_time) {
+  while ((int32_t)(target_time - s_sim_state.simulation_time) > 0) {
+    uint32_t step_us = target_time - s_sim_state.simulation_time;
+
+    if (step_us > SIM_PHYSICS_STEP_US) {
+      step_us = SIM_PHYSICS_STEP_US;
+    }
+
+    /* Split the step so the timer callback sees the state at its due time */
+    if (s_sim_state.timer_armed && (int32_t)(s_sim_state.timer_fire_time - s_sim_state.simulation_time) >= 0 &&
+        (s_sim_state.timer_fire_time - s_sim_state.simulation_time) < step_us) {
+      step_us = s_sim_state.timer_fire_time - s_sim_state.simulation_time;
+    }
+
+    if (s_sim_state.simulation_running && step_us > 0U) {
+      simulate_step(step_us);
+    } else {
+      s_sim_state.simulation_time += step_us;
+    }
+
+    if (s_sim_state.timer_armed && (int32_t)(s_sim_state.simulation_time - s_sim_state.timer_fire_time) >= 0) {
+      s_sim_state.timer_armed = false;
+      s_sim_state.timer_callback(s_sim_state.timer_context);
+    }
+
+    if (s_sample_callback != NULL && (int32_t)(s_sim_state.simulation_time - s_next_sample_time) >= 0) {
+      struct HalSimMotorState_t state;
+
+      hal_sim_get_motor_state(&state);
+      s_next_sample_time = s_sim_state.simulation_time + s_sample_period_us;
+      s_sample_callback(&state, s_sim_state.simulation_time, s_sample_context);
+    }
+  }
 
-  s_sim_state.last_update_time = current_time;
-  s_sim_state.simulation_time += (uint32_t)(SIM_DT * 1000000);
+  s_sim_state.last_update_time = s_sim_state.simulation_time;
 }
 
 /*******************************************************************************************************************************
@@ -269,9 +851,10 @@ bool hal_pwm_init(struct PwmConfig_t *config) {
     s_sim_state.pwm_duty[i] = 0.0f;
     s_sim_state.phase_high[i] = false;
     s_sim_state.phase_low[i] = false;
+    s_sim_state.phase_modulated[i] = false;
   }
 
-  printf("[SIM] PWM initialized - Frequency: %d Hz\n", config->frequency);
+  SIM_LOG("[SIM] PWM initialized - Frequency: %d Hz\n", config->frequency);
   return true;
 }
 
@@ -281,106 +864,179 @@ bool hal_adc_init(struct AdcConfig_t *config) {
   }
 
   s_adc_config = config;
-  printf("[SIM] ADC initialized - Resolution: %d bits\n", config->resolution);
+  SIM_LOG("[SIM] ADC initialized - Resolution: %d bits\n", config->resolution);
   return true;
 }
 
 bool hal_gpio_init(void) {
-  /* Initialize simulation state */
-  memset(&s_sim_state, 0, sizeof(s_sim_state));
-  s_sim_state.temperature = SIM_AMBIENT_TEMPERATURE;
-  s_sim_state.simulation_running = true;
-
-  /* Initialize random seed for noise generation */
-  srand((unsigned int)time(NULL));
+  /* Initialize simulation state once. A driver re-init must not rewind the clock, drop the injected load or move the rotor */
+  if (!s_hal_initialized) {
+    uint32_t simulation_time = s_sim_state.simulation_time;
+    uint32_t last_update_time = s_sim_state.last_update_time;
+    float injected_load_torque = s_sim_state.injected_load_torque;
+
+    float dc_voltage = s_sim_state.dc_voltage;
+    bool is_salient = s_sim_state.is_salient;
+    float inductance_d = s_sim_state.inductance_d;
+    float inductance_q = s_sim_state.inductance_q;
+    float saturation = s_sim_state.saturation;
+    float rotor_angle = s_sim_state.rotor_angle;
+
+    memset(&s_sim_state, 0, sizeof(s_sim_state));
+    s_sim_state.temperature = SIM_AMBIENT_TEMPERATURE;
+    s_sim_state.simulation_running = true;
+    s_sim_state.simulation_time = simulation_time;
+    s_sim_state.last_update_time = last_update_time;
+    s_sim_state.injected_load_torque = injected_load_torque;
+    s_sim_state.dc_voltage = (dc_voltage > 0.0f) ? dc_voltage : SIM_DC_VOLTAGE;
+    s_sim_state.is_salient = is_salient;
+    s_sim_state.inductance_d = inductance_d;
+    s_sim_state.inductance_q = inductance_q;
+    s_sim_state.saturation = saturation;
+    s_sim_state.rotor_angle = rotor_angle;
+  }
 
-  /* Record start time */
-  clock_gettime(CLOCK_MONOTONIC, &s_start_time);
+  /* Initialize random seed for noise generation, unless a repeatable seed was requested */
+  if (!s_noise_seeded) {
+    srand((unsigned int)time(NULL));
+    s_noise_seeded = true;
+  }
 
   s_hal_initialized = true;
-  printf("[SIM] GPIO and simulation initialized\n");
+  SIM_LOG("[SIM] GPIO and simulation initialized\n");
   return true;
 }
 
 void hal_gpio_set_phase_high(MotorPhase_t phase) {
   if (phase < 3) {
+    s_sim_state.stats.gate_writes++;
     s_sim_state.phase_high[phase] = true;
     s_sim_state.phase_low[phase] = false;
-    printf("[SIM] Phase %d set HIGH\n", phase);
+    s_sim_state.phase_modulated[phase] = false;
+    SIM_LOG("[SIM] Phase %d set HIGH\n", phase);
   }
 }
 
 void hal_gpio_set_phase_low(MotorPhase_t phase) {
   if (phase < 3) {
+    s_sim_state.stats.gate_writes++;
     s_sim_state.phase_high[phase] = false;
     s_sim_state.phase_low[phase] = true;
-    printf("[SIM] Phase %d set LOW\n", phase);
+    s_sim_state.phase_modulated[phase] = false;
+    SIM_LOG("[SIM] Phase %d set LOW\n", phase);
   }
 }
 
 void hal_gpio_set_phase_float(MotorPhase_t phase) {
   if (phase < 3) {
+    s_sim_state.stats.gate_writes++;
     s_sim_state.phase_high[phase] = false;
     s_sim_state.phase_low[phase] = false;
-    printf("[SIM] Phase %d set FLOAT\n", phase);
+    s_sim_state.phase_modulated[phase] = false;
+    SIM_LOG("[SIM] Phase %d set FLOAT\n", phase);
   }
 }
 
-void hal_pwm_set_duty(MotorPhase_t phase, uint16_t duty) {
+void hal_pwm_set_duty(MotorPhase_t phase, float duty) {
   if (phase < 3) {
-    s_sim_state.pwm_duty[phase] = (float)duty / 100.0f;  // Assuming duty is in percent
+    s_sim_state.stats.gate_writes++;
+    s_sim_state.pwm_duty[phase] = duty;
 
     /* Automatically set phase high when PWM is applied */
-    if (duty > 0) {
+    if (duty > 0.0f) {
       s_sim_state.phase_high[phase] = true;
       s_sim_state.phase_low[phase] = false;
+      s_sim_state.phase_modulated[phase] = true;
     }
 
-    printf("[SIM] Phase %d PWM duty: %.1f%%\n", phase, s_sim_state.pwm_duty[phase] * 100.0f);
+    SIM_LOG("[SIM] Phase %d PWM duty: %.1f%%\n", phase, s_sim_state.pwm_duty[phase] * 100.0f);
   }
 }
 
-uint32_t hal_get_micros(void) {
-  if (!s_hal_initialized) {
-    return 0;
-  }
+void hal_pwm_set_gates(uint16_t gate_mask, float duty) {
+  for (int phase = 0; phase < 3; phase++) {
+    uint16_t leg = (uint16_t)((gate_mask >> (2U * phase)) & 0x3U);
+    bool is_modulated = ((gate_mask & HAL_GATE_PWM(phase)) != 0U) && (leg != 0U);
+
+    /* Both switches held on would short the bus, float the phase instead */
+    if (leg == 0x3U && !is_modulated) {
+      leg = 0U;
+    }
 
-  struct timespec ts;
-  clock_gettime(CLOCK_MONOTONIC, &ts);
+    s_sim_state.phase_high[phase] = (leg & 0x1U) != 0U;
+    s_sim_state.phase_low[phase] = (leg & 0x2U) != 0U;
+    s_sim_state.phase_modulated[phase] = is_modulated;
+    /* Only modulated legs read the duty cycle, storing it unconditionally keeps the decode branch free */
+    s_sim_state.pwm_duty[phase] = duty;
+  }
 
-  uint32_t elapsed_sec = ts.tv_sec - s_start_time.tv_sec;
-  uint32_t elapsed_nsec = ts.tv_nsec - s_start_time.tv_nsec;
+  s_sim_state.stats.gate_writes++;
+  SIM_LOG("[SIM] Gates 0x%03X PWM duty: %.1f%%\n", gate_mask, duty * 100.0f);
+}
 
-  if (elapsed_nsec < 0) {
-    elapsed_sec--;
-    elapsed_nsec += 1000000000;
+uint32_t hal_get_micros(void) {
+  if (!s_hal_initialized) {
+    return 0;
   }
 
-  return (elapsed_sec * 1000000) + (elapsed_nsec / 1000);
+  /* Simulated time only moves through hal_sim_advance_us() and the blocking delays */
+  return s_sim_state.simulation_time;
 }
 
 void hal_delay_us(uint32_t delay_us) {
-  struct timespec ts;
-  ts.tv_sec = delay_us / 1000000;
-  ts.tv_nsec = (delay_us % 1000000) * 1000;
-  nanosleep(&ts, NULL);
+  simulate_until(s_sim_state.simulation_time + delay_us);
 }
 
 void hal_delay_ms(uint32_t delay_ms) {
   hal_delay_us(delay_ms * 1000);
 }
 
+bool hal_timer_schedule(uint32_t fire_time_us, HalTimerCallback_t callback, void *context) {
+  if (callback == NULL) {
+    return false;
+  }
+
+  /* A deadline in the past fires on the next simulation step */
+  if ((int32_t)(fire_time_us - s_sim_state.simulation_time) < 0) {
+    fire_time_us = s_sim_state.simulation_time;
+  }
+
+  s_sim_state.timer_fire_time = fire_time_us;
+  s_sim_state.timer_callback = callback;
+  s_sim_state.timer_context = context;
+  s_sim_state.timer_armed = true;
+  return true;
+}
+
+void hal_timer_cancel(void) {
+  s_sim_state.timer_armed = false;
+}
+
 void hal_adc_start_conversion(void) {
-  /* Update simulation state before ADC conversion */
-  update_simulation_state();
-  printf("[SIM] ADC conversion started\n");
+  /* The ADC samples the model at the current simulation time */
+  SIM_LOG("[SIM] ADC conversion started\n");
+}
+
+bool hal_adc_set_pwm_trigger(float on_time_fraction) {
+  if (on_time_fraction < 0.0f || on_time_fraction > 1.0f) {
+    return false;
+  }
+
+  s_sim_state.adc_synchronized = true;
+  s_sim_state.adc_trigger_fraction = on_time_fraction;
+  SIM_LOG("[SIM] ADC triggered at %.0f%% of the PWM on-time\n", on_time_fraction * 100.0f);
+  return true;
 }
 
 void hal_adc_get_phase_voltages(float *voltages) {
   if (voltages == NULL) return;
 
+  /* The sense dividers are referenced to the negative DC rail */
+  sample_terminal_voltages(voltages);
+
   for (int phase = 0; phase < 3; phase++) {
-    voltages[phase] = add_noise(s_sim_state.phase_voltages[phase] * SIM_VOLTAGE_DIVIDER_RATIO, SIM_ADC_NOISE_LEVEL);
+    /* Noise enters at the ADC pin, behind the divider. The reading is scaled back to phase volts */
+    voltages[phase] = add_noise(voltages[phase] * SIM_VOLTAGE_DIVIDER_RATIO, SIM_ADC_NOISE_LEVEL) / SIM_VOLTAGE_DIVIDER_RATIO;
 
     /* Apply overvoltage fault injection */
     if (s_sim_state.inject_overvoltage) {
@@ -388,7 +1044,7 @@ void hal_adc_get_phase_voltages(float *voltages) {
     }
   }
 
-  printf("[SIM] Phase voltages: A=%.2fV, B=%.2fV, C=%.2fV\n", voltages[0], voltages[1], voltages[2]);
+  SIM_LOG("[SIM] Phase voltages: A=%.2fV, B=%.2fV, C=%.2fV\n", voltages[0], voltages[1], voltages[2]);
 }
 
 void hal_adc_get_phase_currents(float *currents) {
@@ -403,18 +1059,18 @@ void hal_adc_get_phase_currents(float *currents) {
     }
   }
 
-  printf("[SIM] Phase currents: A=%.2fA, B=%.2fA, C=%.2fA\n", currents[0], currents[1], currents[2]);
+  SIM_LOG("[SIM] Phase currents: A=%.2fA, B=%.2fA, C=%.2fA\n", currents[0], currents[1], currents[2]);
 }
 
 float hal_adc_get_dc_voltage(void) {
-  float voltage = add_noise(SIM_DC_VOLTAGE, SIM_ADC_NOISE_LEVEL);
+  float voltage = add_noise(s_sim_state.dc_voltage, SIM_ADC_NOISE_LEVEL);
 
   /* Apply overvoltage fault injection */
   if (s_sim_state.inject_overvoltage) {
     voltage *= 1.3f;  // 30% overvoltage
   }
 
-  printf("[SIM] DC voltage: %.2fV\n", voltage);
+  SIM_LOG("[SIM] DC voltage: %.2fV\n", voltage);
   return voltage;
 }
 
@@ -426,10 +1082,73 @@ float hal_adc_get_temperature(void) {
     temp += 50.0f;  // Add 50°C to trigger overtemperature
   }
 
-  printf("[SIM] Temperature: %.1f°C\n", temp);
+  SIM_LOG("[SIM] Temperature: %.1f°C\n", temp);
   return temp;
 }
 
+bool hal_gpio_init_hall_sensors(void) {
+  SIM_LOG("[SIM] Hall sensors initialized\n");
+  return true;
+}
+
+uint8_t hal_gpio_get_hall_state(void) {
+  uint8_t hall_state = calculate_hall_state();
+  SIM_LOG("[SIM] Hall state: %d%d%d\n", (hall_state >> 2) & 1U, (hall_state >> 1) & 1U, hall_state & 1U);
+  return hall_state;
+}
+
+bool hal_hall_capture_init(void) {
+  s_sim_state.hall_edge_head = 0U;
+  s_sim_state.hall_edge_count = 0U;
+  s_sim_state.hall_capture_enabled = true;
+  SIM_LOG("[SIM] Hall edge capture initialized\n");
+  return true;
+}
+
+bool hal_hall_capture_pop(struct HallEdge_t *edge) {
+  if (edge == NULL) {
+    return false;
+  }
+
+  if (s_sim_state.hall_edge_count == 0U) {
+    return false;
+  }
+
+  *edge = s_sim_state.hall_edges[s_sim_state.hall_edge_head];
+  s_sim_state.hall_edge_head = (s_sim_state.hall_edge_head + 1U) % SIM_HALL_EDGE_QUEUE_SIZE;
+  s_sim_state.hall_edge_count--;
+  return true;
+}
+
+bool hal_encoder_init(void) {
+  SIM_LOG("[SIM] Encoder initialized\n");
+  return true;
+}
+
+float hal_encoder_get_position(void) {
+  return s_sim_state.rotor_angle;
+}
+
+float hal_encoder_get_velocity(void) {
+  return s_sim_state.rotor_velocity;
+}
+
+void hal_set_pwm(struct PwmConfig_t *config, float duty_a, float duty_b, float duty_c) {
+  (void)config;
+  float duties[3] = { duty_a, duty_b, duty_c };
+
+  /* Complementary outputs keep every phase driven, the averaged leg voltage follows the duty cycle */
+  for (int phase = 0; phase < 3; phase++) {
+    s_sim_state.pwm_duty[phase] = duties[phase];
+    s_sim_state.phase_high[phase] = true;
+    s_sim_state.phase_low[phase] = true;
+    s_sim_state.phase_modulated[phase] = true;
+  }
+
+  s_sim_state.stats.gate_writes++;
+  SIM_LOG("[SIM] PWM duty: A=%.3f, B=%.3f, C=%.3f\n", duty_a, duty_b, duty_c);
+}
+
 /*******************************************************************************************************************************
  * Simulation Control Functions (for testing)
  *******************************************************************************************************************************/
@@ -439,7 +1158,7 @@ float hal_adc_get_temperature(void) {
  */
 void hal_sim_set_load_torque(float torque_nm) {
   s_sim_state.injected_load_torque = torque_nm;
-  printf("[SIM] Load torque set to %.3f Nm\n", torque_nm);
+  SIM_LOG("[SIM] Load torque set to %.3f Nm\n", torque_nm);
 }
 
 /**
@@ -448,18 +1167,18 @@ void hal_sim_set_load_torque(float torque_nm) {
 void hal_sim_inject_fault(const char *fault_type, bool enable) {
   if (strcmp(fault_type, "overcurrent") == 0) {
     s_sim_state.inject_overcurrent = enable;
-    printf("[SIM] Overcurrent fault injection %s\n", enable ? "ENABLED" : "DISABLED");
+    SIM_LOG("[SIM] Overcurrent fault injection %s\n", enable ? "ENABLED" : "DISABLED");
   } else if (strcmp(fault_type, "overvoltage") == 0) {
     s_sim_state.inject_overvoltage = enable;
-    printf("[SIM] Overvoltage fault injection %s\n", enable ? "ENABLED" : "DISABLED");
+    SIM_LOG("[SIM] Overvoltage fault injection %s\n", enable ? "ENABLED" : "DISABLED");
   } else if (strcmp(fault_type, "overtemp") == 0) {
     s_sim_state.inject_overtemp = enable;
-    printf("[SIM] Overtemperature fault injection %s\n", enable ? "ENABLED" : "DISABLED");
+    SIM_LOG("[SIM] Overtemperature fault injection %s\n", enable ? "ENABLED" : "DISABLED");
   } else if (strcmp(fault_type, "overtemp") == 0) {
     s_sim_state.inject_overtemp = enable;
-    printf("[SIM] Overtemperature fault injection %s\n", enable ? "ENABLED" : "DISABLED");
+    SIM_LOG("[SIM] Overtemperature fault injection %s\n", enable ? "ENABLED" : "DISABLED");
   } else {
-    printf("[SIM] Unknown fault type '%s'\n", fault_type);
+    SIM_LOG("[SIM] Unknown fault type '%s'\n", fault_type);
   }
 }
 
@@ -468,17 +1187,95 @@ void hal_sim_inject_fault(const char *fault_type, bool enable) {
  */
 void hal_sim_stop(void) {
   s_sim_state.simulation_running = false;
-  printf("[SIM] Simulation stopped\n");
+  SIM_LOG("[SIM] Simulation stopped\n");
 }
 
 /**
  * @brief Restart the simulation from initial state
  */
 void hal_sim_restart(void) {
+  bool hall_capture_enabled = s_sim_state.hall_capture_enabled;
+  uint32_t simulation_time = s_sim_state.simulation_time;
+
   memset(&s_sim_state, 0, sizeof(s_sim_state));
+  s_sim_state.hall_capture_enabled = hall_capture_enabled;
+  s_sim_state.dc_voltage = SIM_DC_VOLTAGE;
   s_sim_state.temperature = SIM_AMBIENT_TEMPERATURE;
   s_sim_state.simulation_running = true;
-  s_sim_state.last_update_time = hal_get_micros();
-  s_sim_state.simulation_time = 0;
-  printf("[SIM] Simulation restarted\n");
-}
\ No newline at end of file
+  /* The clock keeps running so timestamps held by the drivers stay monotonic */
+  s_sim_state.simulation_time = simulation_time;
+  s_sim_state.last_update_time = simulation_time;
+  SIM_LOG("[SIM] Simulation restarted\n");
+}
+
+void hal_sim_advance_us(uint32_t duration_us) {
+  simulate_until(s_sim_state.simulation_time + duration_us);
+}
+
+void hal_sim_set_verbose(bool verbose) {
+  s_sim_verbose = verbose;
+}
+
+void hal_sim_set_noise_seed(uint32_t seed) {
+  srand(seed);
+  s_noise_seeded = true;
+}
+
+void hal_sim_reset_stats(void) {
+  memset(&s_sim_state.stats, 0, sizeof(s_sim_state.stats));
+}
+
+void hal_sim_get_stats(struct HalSimStats_t *stats) {
+  if (stats != NULL) {
+    *stats = s_sim_state.stats;
+  }
+}
+
+void hal_sim_get_motor_state(struct HalSimMotorState_t *state) {
+  if (state == NULL) {
+    return;
+  }
+
+  state->rotor_position = s_sim_state.rotor_angle;
+  state->rotor_velocity = s_sim_state.rotor_velocity;
+  for (int phase = 0; phase < NUM_MOTOR_PHASES; phase++) {
+    state->phase_currents[phase] = s_sim_state.phase_currents[phase];
+    state->phase_voltages[phase] = s_sim_state.phase_voltages[phase];
+  }
+  state->torque_electrical = s_sim_state.torque_electrical;
+  state->dc_current = s_sim_state.dc_current;
+  state->temperature = s_sim_state.temperature;
+}
+
+void hal_sim_set_sample_callback(HalSimSampleCallback_t callback, uint32_t period_us, void *context) {
+  s_sample_callback = callback;
+  s_sample_context = context;
+  s_sample_period_us = period_us;
+  s_next_sample_time = s_sim_state.simulation_time;
+}
+
+void hal_sim_set_dc_voltage(float voltage) {
+  s_sim_state.dc_voltage = voltage;
+  SIM_LOG("[SIM] DC bus voltage set to %.1f V\n", voltage);
+}
+
+void hal_sim_set_saliency(float inductance_d, float inductance_q, float saturation) {
+  s_sim_state.is_salient = true;
+  s_sim_state.inductance_d = inductance_d;
+  s_sim_state.inductance_q = inductance_q;
+  s_sim_state.saturation = saturation;
+  SIM_LOG("[SIM] Saliency set to Ld=%.3f mH, Lq=%.3f mH, saturation %.2f\n", inductance_d * 1000.0f, inductance_q * 1000.0f, saturation);
+}
+
+void hal_sim_set_rotor_position(float position) {
+  s_sim_state.rotor_angle = fmodf(position, 2.0f * PI);
+  if (s_sim_state.rotor_angle < 0.0f) {
+    s_sim_state.rotor_angle += 2.0f * PI;
+  }
+  s_sim_state.rotor_velocity = 0.0f;
+  calculate_bemf();
+}
+
+uint32_t hal_sim_get_bemf_zero_crossing_time(MotorPhase_t phase) {
+  return (phase < NUM_MOTOR_PHASES) ? s_sim_state.bemf_zc_time[phase] : 0U;
+}
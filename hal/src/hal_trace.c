@@ -0,0 +1,351 @@
+/*******************************************************************************************************************************
+ * @file   hal_trace.c
+ *
+ * @brief  Source file for the binary trace of HAL calls
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stddef.h>
+#include <string.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "hal_trace.h"
+
+#define FIELD_RESULT 0x01U    /**< Success flag byte */
+#define FIELD_IF_RESULT 0x02U /**< The fields after the flag are only stored when it is set */
+#define FIELD_BYTE 0x04U      /**< One byte */
+#define FIELD_WORD 0x08U      /**< Varint */
+#define FIELD_TIME 0x10U      /**< Zigzag varint of the difference from the previous time */
+#define FIELD_VALUES 0x20U    /**< Raw floats */
+#define FIELD_PAYLOAD 0x40U   /**< Varint size and the bytes */
+
+/**
+ * @brief   Fields of a tag, in encoding order
+ */
+struct HalTraceLayout_t {
+  const char *name;   /**< Report name */
+  uint8_t fields;     /**< FIELD_ bits stored */
+  uint8_t outputs;    /**< FIELD_ bits the calling code computes, the rest are HAL readings */
+  uint8_t num_values; /**< Floats stored with FIELD_VALUES */
+};
+
+static const struct HalTraceLayout_t s_layouts[NUM_HAL_TRACE_TAGS] = {
+  [HAL_TRACE_PWM_INIT] = { "pwm_init", FIELD_RESULT, 0U, 0U },
+  [HAL_TRACE_ADC_INIT] = { "adc_init", FIELD_RESULT, 0U, 0U },
+  [HAL_TRACE_GPIO_INIT] = { "gpio_init", FIELD_RESULT, 0U, 0U },
+  [HAL_TRACE_GPIO_SET_PHASE_HIGH] = { "gpio_set_phase_high", FIELD_BYTE, FIELD_BYTE, 0U },
+  [HAL_TRACE_GPIO_SET_PHASE_LOW] = { "gpio_set_phase_low", FIELD_BYTE, FIELD_BYTE, 0U },
+  [HAL_TRACE_GPIO_SET_PHASE_FLOAT] = { "gpio_set_phase_float", FIELD_BYTE, FIELD_BYTE, 0U },
+  [HAL_TRACE_PWM_SET_DUTY] = { "pwm_set_duty", FIELD_BYTE | FIELD_VALUES, FIELD_BYTE | FIELD_VALUES, 1U },
+  [HAL_TRACE_PWM_SET_GATES] = { "pwm_set_gates", FIELD_WORD | FIELD_VALUES, FIELD_WORD | FIELD_VALUES, 1U },
+  [HAL_TRACE_GET_MICROS] = { "get_micros", FIELD_TIME, 0U, 0U },
+  [HAL_TRACE_TIMER_SCHEDULE] = { "timer_schedule", FIELD_RESULT | FIELD_TIME, FIELD_TIME, 0U },
+  [HAL_TRACE_TIMER_CANCEL] = { "timer_cancel", 0U, 0U, 0U },
+  [HAL_TRACE_DELAY_US] = { "delay_us", FIELD_WORD, FIELD_WORD, 0U },
+  [HAL_TRACE_DELAY_MS] = { "delay_ms", FIELD_WORD, FIELD_WORD, 0U },
+  [HAL_TRACE_ADC_START_CONVERSION] = { "adc_start_conversion", 0U, 0U, 0U },
+  [HAL_TRACE_ADC_SET_PWM_TRIGGER] = { "adc_set_pwm_trigger", FIELD_RESULT | FIELD_VALUES, FIELD_VALUES, 1U },
+  [HAL_TRACE_ADC_PHASE_VOLTAGES] = { "adc_phase_voltages", FIELD_VALUES, 0U, NUM_MOTOR_PHASES },
+  [HAL_TRACE_ADC_PHASE_CURRENTS] = { "adc_phase_currents", FIELD_VALUES, 0U, NUM_MOTOR_PHASES },
+  [HAL_TRACE_ADC_DC_VOLTAGE] = { "adc_dc_voltage", FIELD_VALUES, 0U, 1U },
+  [HAL_TRACE_ADC_TEMPERATURE] = { "adc_temperature", FIELD_VALUES, 0U, 1U },
+  [HAL_TRACE_GPIO_INIT_HALL] = { "gpio_init_hall_sensors", FIELD_RESULT, 0U, 0U },
+  [HAL_TRACE_GPIO_HALL_STATE] = { "gpio_hall_state", FIELD_BYTE, 0U, 0U },
+  [HAL_TRACE_HALL_CAPTURE_INIT] = { "hall_capture_init", FIELD_RESULT, 0U, 0U },
+  [HAL_TRACE_HALL_CAPTURE_POP] = { "hall_capture_pop", FIELD_RESULT | FIELD_IF_RESULT | FIELD_TIME | FIELD_BYTE, 0U, 0U },
+  [HAL_TRACE_ENCODER_INIT] = { "encoder_init", FIELD_RESULT, 0U, 0U },
+  [HAL_TRACE_ENCODER_POSITION] = { "encoder_position", FIELD_VALUES, 0U, 1U },
+  [HAL_TRACE_ENCODER_VELOCITY] = { "encoder_velocity", FIELD_VALUES, 0U, 1U },
+  [HAL_TRACE_SET_PWM] = { "set_pwm", FIELD_VALUES, FIELD_VALUES, NUM_MOTOR_PHASES },
+  [HAL_TRACE_TIMER_FIRE] = { "timer_fire", 0U, 0U, 0U },
+  [HAL_TRACE_MARK] = { "mark", FIELD_BYTE | FIELD_PAYLOAD, FIELD_BYTE | FIELD_PAYLOAD, 0U },
+};
+
+static uint32_t put_varint(uint8_t *out, uint32_t value) {
+  uint32_t size = 0U;
+
+  while (value >= 0x80U) {
+    out[size++] = (uint8_t)(value | 0x80U);
+    value >>= 7U;
+  }
+
+  out[size++] = (uint8_t)value;
+  return size;
+}
+
+static bool get_varint(const uint8_t *data, uint32_t size, uint32_t *offset, uint32_t *value) {
+  uint32_t result = 0U;
+
+  for (uint32_t shift = 0U; shift < 35U; shift += 7U) {
+    if (*offset >= size) {
+      return false;
+    }
+
+    uint8_t byte = data[(*offset)++];
+    result |= (uint32_t)(byte & 0x7FU) << shift;
+
+    if ((byte & 0x80U) == 0U) {
+      *value = result;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/* Zigzag keeps small negative differences, a deadline before the last time, to one or two bytes */
+static uint32_t zigzag(uint32_t delta) {
+  return (delta << 1U) ^ (uint32_t)((int32_t)delta >> 31);
+}
+
+static uint32_t unzigzag(uint32_t value) {
+  return (value >> 1U) ^ (uint32_t)(-(int32_t)(value & 1U));
+}
+
+static void put_bytes(struct HalTraceWriter_t *writer, const uint8_t *data, uint32_t size) {
+  while (size > 0U) {
+    uint32_t chunk = HAL_TRACE_WRITER_BUFFER - writer->used;
+    chunk = (chunk < size) ? chunk : size;
+
+    memcpy(&writer->buffer[writer->used], data, chunk);
+    writer->used += chunk;
+    writer->num_bytes += chunk;
+    data += chunk;
+    size -= chunk;
+
+    if (writer->used == HAL_TRACE_WRITER_BUFFER) {
+      hal_trace_writer_flush(writer);
+    }
+  }
+}
+
+/* Decode from a copy of the reader state, the caller decides whether to keep the position */
+static bool decode(struct HalTraceReader_t *reader, struct HalTraceEvent_t *event) {
+  const uint8_t *data = reader->data;
+  uint32_t size = reader->size;
+  uint32_t offset = reader->offset;
+
+  if (offset >= size || data[offset] >= NUM_HAL_TRACE_TAGS) {
+    return false;
+  }
+
+  memset(event, 0, sizeof(*event));
+  event->tag = (HalTraceTag_t)data[offset++];
+
+  const struct HalTraceLayout_t *layout = &s_layouts[event->tag];
+
+  if ((layout->fields & FIELD_RESULT) != 0U) {
+    if (offset >= size) {
+      return false;
+    }
+    event->result = (data[offset++] != 0U);
+  }
+
+  if ((layout->fields & FIELD_IF_RESULT) == 0U || event->result) {
+    if ((layout->fields & FIELD_BYTE) != 0U) {
+      if (offset >= size) {
+        return false;
+      }
+      event->byte = data[offset++];
+    }
+
+    if ((layout->fields & FIELD_WORD) != 0U && !get_varint(data, size, &offset, &event->word)) {
+      return false;
+    }
+
+    if ((layout->fields & FIELD_TIME) != 0U) {
+      uint32_t delta;
+
+      if (!get_varint(data, size, &offset, &delta)) {
+        return false;
+      }
+      event->word = reader->last_time + unzigzag(delta);
+      reader->last_time = event->word;
+    }
+
+    if ((layout->fields & FIELD_VALUES) != 0U) {
+      uint32_t values_size = layout->num_values * (uint32_t)sizeof(float);
+
+      if (size - offset < values_size) {
+        return false;
+      }
+      memcpy(event->values, &data[offset], values_size);
+      offset += values_size;
+    }
+
+    if ((layout->fields & FIELD_PAYLOAD) != 0U) {
+      if (!get_varint(data, size, &offset, &event->payload_size) || size - offset < event->payload_size) {
+        return false;
+      }
+      event->payload = &data[offset];
+      offset += event->payload_size;
+    }
+  }
+
+  reader->offset = offset;
+  reader->num_events++;
+  return true;
+}
+
+const char *hal_trace_tag_name(HalTraceTag_t tag) {
+  return ((uint32_t)tag < NUM_HAL_TRACE_TAGS) ? s_layouts[tag].name : "invalid";
+}
+
+void hal_trace_writer_init(struct HalTraceWriter_t *writer, HalTraceSink_t sink, void *context) {
+  uint8_t header[HAL_TRACE_HEADER_SIZE] = { 0U };
+  uint32_t magic = HAL_TRACE_MAGIC;
+
+  memset(writer, 0, sizeof(*writer));
+  writer->sink = sink;
+  writer->context = context;
+
+  for (uint32_t i = 0U; i < 4U; i++) {
+    header[i] = (uint8_t)(magic >> (8U * i));
+  }
+  header[4] = HAL_TRACE_VERSION;
+
+  put_bytes(writer, header, sizeof(header));
+}
+
+void hal_trace_write(struct HalTraceWriter_t *writer, const struct HalTraceEvent_t *event) {
+  uint8_t encoded[HAL_TRACE_MAX_EVENT_SIZE];
+  uint32_t size = 0U;
+
+  if ((uint32_t)event->tag >= NUM_HAL_TRACE_TAGS) {
+    return;
+  }
+
+  const struct HalTraceLayout_t *layout = &s_layouts[event->tag];
+  encoded[size++] = (uint8_t)event->tag;
+
+  if ((layout->fields & FIELD_RESULT) != 0U) {
+    encoded[size++] = event->result ? 1U : 0U;
+  }
+
+  if ((layout->fields & FIELD_IF_RESULT) == 0U || event->result) {
+    if ((layout->fields & FIELD_BYTE) != 0U) {
+      encoded[size++] = event->byte;
+    }
+
+    if ((layout->fields & FIELD_WORD) != 0U) {
+      size += put_varint(&encoded[size], event->word);
+    }
+
+    if ((layout->fields & FIELD_TIME) != 0U) {
+      size += put_varint(&encoded[size], zigzag(event->word - writer->last_time));
+      writer->last_time = event->word;
+    }
+
+    if ((layout->fields & FIELD_VALUES) != 0U) {
+      memcpy(&encoded[size], event->values, layout->num_values * sizeof(float));
+      size += layout->num_values * (uint32_t)sizeof(float);
+    }
+
+    if ((layout->fields & FIELD_PAYLOAD) != 0U) {
+      size += put_varint(&encoded[size], event->payload_size);
+    }
+  }
+
+  put_bytes(writer, encoded, size);
+
+  if ((layout->fields & FIELD_PAYLOAD) != 0U && event->payload_size > 0U) {
+    put_bytes(writer, event->payload, event->payload_size);
+  }
+
+  writer->num_events++;
+}
+
+void hal_trace_writer_flush(struct HalTraceWriter_t *writer) {
+  if (writer->used > 0U && writer->sink != NULL) {
+    writer->sink(writer->buffer, writer->used, writer->context);
+  }
+
+  writer->used = 0U;
+}
+
+bool hal_trace_reader_init(struct HalTraceReader_t *reader, const uint8_t *data, uint32_t size) {
+  uint32_t magic = 0U;
+
+  memset(reader, 0, sizeof(*reader));
+
+  if (data == NULL || size < HAL_TRACE_HEADER_SIZE) {
+    return false;
+  }
+
+  for (uint32_t i = 0U; i < 4U; i++) {
+    magic |= (uint32_t)data[i] << (8U * i);
+  }
+
+  if (magic != HAL_TRACE_MAGIC || data[4] != HAL_TRACE_VERSION) {
+    return false;
+  }
+
+  reader->data = data;
+  reader->size = size;
+  reader->offset = HAL_TRACE_HEADER_SIZE;
+  return true;
+}
+
+bool hal_trace_peek(const struct HalTraceReader_t *reader, struct HalTraceEvent_t *event) {
+  struct HalTraceReader_t copy = *reader;
+
+  return decode(&copy, event);
+}
+
+bool hal_trace_read(struct HalTraceReader_t *reader, struct HalTraceEvent_t *event) {
+  return decode(reader, event);
+}
+
+bool hal_trace_outputs_equal(const struct HalTraceEvent_t *expected, const struct HalTraceEvent_t *actual) {
+  if (expected->tag != actual->tag || (uint32_t)expected->tag >= NUM_HAL_TRACE_TAGS) {
+    return false;
+  }
+
+  const struct HalTraceLayout_t *layout = &s_layouts[expected->tag];
+  bool is_equal = true;
+
+  if ((layout->outputs & FIELD_BYTE) != 0U) {
+    is_equal = is_equal && (expected->byte == actual->byte);
+  }
+
+  if ((layout->outputs & (FIELD_WORD | FIELD_TIME)) != 0U) {
+    is_equal = is_equal && (expected->word == actual->word);
+  }
+
+  if ((layout->outputs & FIELD_VALUES) != 0U) {
+    is_equal = is_equal && (memcmp(expected->values, actual->values, layout->num_values * sizeof(float)) == 0);
+  }
+
+  if ((layout->outputs & FIELD_PAYLOAD) != 0U) {
+    is_equal = is_equal && (expected->payload_size == actual->payload_size) &&
+               (expected->payload_size == 0U || memcmp(expected->payload, actual->payload, expected->payload_size) == 0);
+  }
+
+  return is_equal;
+}
+
+void hal_trace_copy_outputs(struct HalTraceEvent_t *event, const struct HalTraceEvent_t *outputs) {
+  const struct HalTraceLayout_t *layout = &s_layouts[event->tag];
+
+  if ((layout->outputs & FIELD_BYTE) != 0U) {
+    event->byte = outputs->byte;
+  }
+
+  if ((layout->outputs & (FIELD_WORD | FIELD_TIME)) != 0U) {
+    event->word = outputs->word;
+  }
+
+  if ((layout->outputs & FIELD_VALUES) != 0U) {
+    memcpy(event->values, outputs->values, layout->num_values * sizeof(float));
+  }
+
+  if ((layout->outputs & FIELD_PAYLOAD) != 0U) {
+    event->payload = outputs->payload;
+    event->payload_size = outputs->payload_size;
+  }
+}
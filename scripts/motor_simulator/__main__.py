@@ -0,0 +1,83 @@
+import argparse
+import time
+import numpy as np
+import matplotlib.pyplot as plt
+
+from motor_sim_interface import (MotorSimInterface, allocate_history, MOTOR_SIM_DRIVER_FOC_SENSORLESS,
+                                 CONTROL_MODE_VELOCITY)
+
+RPM_TO_RAD_PER_S = 2.0 * np.pi / 60.0
+
+
+def run_speed_steps(sim, speeds_rpm, step_time, control_period_us, load_torque):
+    """
+    Sensorless FOC through a list of speed setpoints, the load applied from the second one.
+    Returns:
+        History of every cycle, see allocate_history().
+    """
+    cycles_per_step = int(round(step_time * 1e6 / control_period_us))
+    history = allocate_history(cycles_per_step * len(speeds_rpm))
+
+    sim.create(MOTOR_SIM_DRIVER_FOC_SENSORLESS, control_period_us=control_period_us)
+
+    for i, speed_rpm in enumerate(speeds_rpm):
+        if i == 1:
+            sim.set_load_torque(load_torque)
+        sim.set_setpoint(CONTROL_MODE_VELOCITY, speed_rpm * RPM_TO_RAD_PER_S)
+
+        # Views into the whole history, each step writes its own rows in place
+        rows = slice(i * cycles_per_step, (i + 1) * cycles_per_step)
+        sim.step(cycles_per_step, {field: array[rows] for field, array in history.items()})
+
+    sim.destroy()
+    return history
+
+
+def plot_history(history):
+    fig, (ax_speed, ax_current) = plt.subplots(2, 1, figsize=(10, 8), sharex=True)
+
+    ax_speed.plot(history["time"], history["rotor_velocity"] / RPM_TO_RAD_PER_S, label="Rotor")
+    ax_speed.plot(history["time"], history["measured_velocity"] / RPM_TO_RAD_PER_S, label="Estimated")
+    ax_speed.set_ylabel("Speed (RPM)")
+    ax_speed.grid()
+    ax_speed.legend()
+
+    for phase, name in enumerate("ABC"):
+        ax_current.plot(history["time"], history["phase_currents"][:, phase], label=f"Phase {name}")
+    ax_current.set_xlabel("Time (s)")
+    ax_current.set_ylabel("Current (A)")
+    ax_current.grid()
+    ax_current.legend()
+
+    fig.suptitle("Sensorless FOC speed steps")
+    fig.tight_layout()
+    plt.show()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Closed-loop motor simulation")
+    parser.add_argument("--speeds", type=float, nargs="+", default=[300.0, 600.0, 1200.0, 300.0],
+                        help="Speed setpoints (mechanical RPM)")
+    parser.add_argument("--step-time", type=float, default=1.0, help="Time at each setpoint (s)")
+    parser.add_argument("--period", type=int, default=50, help="Control period (us)")
+    parser.add_argument("--load", type=float, default=0.05, help="Load torque from the second setpoint (Nm)")
+    parser.add_argument("--no-plot", action="store_true")
+    parser.add_argument("--lib", type=str, default=None)
+    args = parser.parse_args()
+
+    sim = MotorSimInterface(lib_path=args.lib)
+
+    start = time.perf_counter()
+    history = run_speed_steps(sim, args.speeds, args.step_time, args.period, args.load)
+    elapsed = time.perf_counter() - start
+
+    num_cycles = history["time"].size
+    print(f"{num_cycles} control cycles in {elapsed:.2f} s: {num_cycles / elapsed:,.0f} cycles/s, "
+          f"{history['time'][-1] / elapsed:.2f}x real time")
+
+    if not args.no_plot:
+        plot_history(history)
+
+
+if __name__ == "__main__":
+    main()
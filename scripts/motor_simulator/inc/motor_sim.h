@@ -0,0 +1,104 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   motor_sim.h
+ *
+ * @brief  Header file for the host side closed-loop motor simulation binding
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdint.h>
+
+/* Inter-component Headers */
+#include "motor.h"
+#include "motor_error.h"
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup MotorSim Motor simulation binding
+ * @brief    Runs a motor_core driver against the simulation HAL for the Python scripts
+ * @details  The simulation HAL models one motor, so one simulated motor exists at a time. Its hal_sim_* controls, such as
+ *           the load torque and the DC bus voltage, are exported alongside and may be called between steps
+ * @{
+ */
+
+/**
+ * @brief   Drivers the simulated motor can run
+ */
+typedef enum {
+  MOTOR_SIM_DRIVER_FOC_SENSORED,     /**< Sensored FOC on the encoder */
+  MOTOR_SIM_DRIVER_FOC_SENSORLESS,   /**< Sensorless FOC with the back-EMF PLL observer */
+  MOTOR_SIM_DRIVER_6STEP_SENSORED,   /**< 6-step on the Hall sensors */
+  MOTOR_SIM_DRIVER_6STEP_SENSORLESS, /**< 6-step on the back-EMF zero-crossings */
+  NUM_MOTOR_SIM_DRIVERS
+} MotorSimDriver_t;
+
+/**
+ * @brief   Caller buffers one step writes its history into, one entry per control cycle
+ * @details A NULL buffer is not recorded. Each entry is sampled after the cycle's model time has elapsed
+ */
+struct MotorSimHistory_t {
+  float *time;              /**< Simulation time (s) */
+  float *rotor_position;    /**< Mechanical rotor angle of the model, 0 to 2pi (rad) */
+  float *rotor_velocity;    /**< Mechanical rotor velocity of the model (rad/s) */
+  float *measured_velocity; /**< Velocity the driver measured or estimated, in its own units */
+  float *phase_currents;    /**< Winding currents of the model, NUM_MOTOR_PHASES per cycle (A) */
+  float *phase_voltages;    /**< Terminal voltages of the model, NUM_MOTOR_PHASES per cycle (V) */
+  float *torque_electrical; /**< Electrical torque of the model (Nm) */
+  float *dc_current;        /**< Averaged DC link current of the model (A) */
+};
+
+/**
+ * @brief   Fill in a configuration the given driver runs the simulated motor with
+ * @param   driver Driver the configuration is for
+ * @param   config Pointer to the configuration to fill
+ */
+void motor_sim_default_config(MotorSimDriver_t driver, struct MotorConfig_t *config);
+
+/**
+ * @brief   Restart the simulation and initialize a driver on it
+ * @details Replaces the motor of an earlier call. The configuration is copied. Driver settings applied through their own
+ *          setters, such as foc_sensorless_set_backemf_pll_config(), must be made before this call. The restart clears
+ *          the hal_sim_* settings but the noise seed, apply them after it
+ * @param   driver Driver to run
+ * @param   config Motor configuration
+ * @param   control_period_us Time the model advances between control cycles (microseconds)
+ * @return  MOTOR_OK if successful, MOTOR_INVALID_ARGS on a bad argument, or the error of the driver initialization
+ */
+MotorError_t motor_sim_create(MotorSimDriver_t driver, const struct MotorConfig_t *config, uint32_t control_period_us);
+
+/**
+ * @brief   Deinitialize the simulated motor
+ * @return  MOTOR_OK if successful, MOTOR_UNINITIALIZED without a motor
+ */
+MotorError_t motor_sim_destroy(void);
+
+/**
+ * @brief   Command the simulated motor, selecting the control mode the driver runs
+ * @param   mode Control mode of the setpoint
+ * @param   setpoint Setpoint in the units of the driver
+ * @return  MOTOR_OK if successful, MOTOR_UNINITIALIZED without a motor, or the error of the driver
+ */
+MotorError_t motor_sim_set_setpoint(ControlMode_t mode, float setpoint);
+
+/**
+ * @brief   Run control cycles, each a motor_run() followed by one control period of the model
+ * @details Stops at the first cycle that fails, the history holds the cycles run before it
+ * @param   num_cycles Control cycles to run
+ * @param   history Buffers of at least num_cycles entries, NULL to record nothing
+ * @param   cycles_run Pointer to store the cycles completed, may be NULL
+ * @return  MOTOR_OK if every cycle ran, MOTOR_UNINITIALIZED without a motor, or the error of the failed cycle
+ */
+MotorError_t motor_sim_step(uint32_t num_cycles, const struct MotorSimHistory_t *history, uint32_t *cycles_run);
+
+/**
+ * @brief   Motor the steps run, for reading driver data between them
+ * @return  Pointer to the simulated motor, NULL without one
+ */
+struct Motor_t *motor_sim_get_motor(void);
+
+/** @} */
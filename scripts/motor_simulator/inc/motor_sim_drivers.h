@@ -0,0 +1,54 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   motor_sim_drivers.h
+ *
+ * @brief  Header file for the driver families of the motor simulation binding
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+#include "motor.h"
+
+/* Intra-component Headers */
+#include "motor_sim.h"
+
+/**
+ * @defgroup MotorSimDrivers Motor simulation driver families
+ * @brief    The 6-step and FOC headers each define the motor modes, so each family is set up from its own file
+ * @{
+ */
+
+/**
+ * @brief   Fill in the 6-step control settings of a configuration, on top of the shared motor parameters
+ * @param   driver MOTOR_SIM_DRIVER_6STEP_SENSORED or MOTOR_SIM_DRIVER_6STEP_SENSORLESS
+ * @param   config Pointer to the configuration to fill
+ */
+void motor_sim_6step_default_config(MotorSimDriver_t driver, struct MotorConfig_t *config);
+
+/**
+ * @brief   Register a 6-step driver into the motor
+ * @param   driver MOTOR_SIM_DRIVER_6STEP_SENSORED or MOTOR_SIM_DRIVER_6STEP_SENSORLESS
+ * @param   motor Pointer to the motor to populate
+ */
+void motor_sim_6step_create_driver(MotorSimDriver_t driver, struct Motor_t *motor);
+
+/**
+ * @brief   Fill in the FOC control settings of a configuration, on top of the shared motor parameters
+ * @param   driver MOTOR_SIM_DRIVER_FOC_SENSORED or MOTOR_SIM_DRIVER_FOC_SENSORLESS
+ * @param   config Pointer to the configuration to fill
+ */
+void motor_sim_foc_default_config(MotorSimDriver_t driver, struct MotorConfig_t *config);
+
+/**
+ * @brief   Register a FOC driver into the motor
+ * @param   driver MOTOR_SIM_DRIVER_FOC_SENSORED or MOTOR_SIM_DRIVER_FOC_SENSORLESS
+ * @param   motor Pointer to the motor to populate
+ */
+void motor_sim_foc_create_driver(MotorSimDriver_t driver, struct Motor_t *motor);
+
+/** @} */
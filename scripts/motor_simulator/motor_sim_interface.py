@@ -0,0 +1,198 @@
+import ctypes
+import numpy as np
+from pathlib import Path
+
+NUM_MOTOR_PHASES = 3
+
+# MotorSimDriver_t
+MOTOR_SIM_DRIVER_FOC_SENSORED = 0
+MOTOR_SIM_DRIVER_FOC_SENSORLESS = 1
+MOTOR_SIM_DRIVER_6STEP_SENSORED = 2
+MOTOR_SIM_DRIVER_6STEP_SENSORLESS = 3
+
+# ControlMode_t
+CONTROL_MODE_VOLTAGE = 0
+CONTROL_MODE_CURRENT = 1
+CONTROL_MODE_VELOCITY = 2
+CONTROL_MODE_POSITION = 3
+CONTROL_MODE_TORQUE = 4
+
+
+class PidConfig(ctypes.Structure):
+    _fields_ = [
+        ("kp", ctypes.c_float),
+        ("ki", ctypes.c_float),
+        ("kd", ctypes.c_float),
+        ("output_min", ctypes.c_float),
+        ("output_max", ctypes.c_float),
+        ("derivative_ema_alpha", ctypes.c_float),
+    ]
+
+
+class PwmConfig(ctypes.Structure):
+    _fields_ = [
+        ("frequency", ctypes.c_uint32),
+        ("dead_time_ns", ctypes.c_uint32),
+        ("resolution", ctypes.c_uint16),
+        ("complementary_output", ctypes.c_bool),
+    ]
+
+
+class AdcConfig(ctypes.Structure):
+    _fields_ = [
+        ("sampling_freq", ctypes.c_uint32),
+        ("resolution", ctypes.c_uint16),
+        ("v_ref", ctypes.c_float),
+        ("current_gain", ctypes.c_float),
+        ("voltage_gain", ctypes.c_float),
+    ]
+
+
+class MotorConfig(ctypes.Structure):
+    _fields_ = [
+        ("type", ctypes.c_int),
+        ("control_method", ctypes.c_int),
+        ("control_mode", ctypes.c_int),
+        ("pole_pairs", ctypes.c_uint8),
+        ("phase_resistance", ctypes.c_float),
+        ("phase_inductance", ctypes.c_float),
+        ("max_current", ctypes.c_float),
+        ("max_voltage", ctypes.c_float),
+        ("max_velocity", ctypes.c_float),
+        ("min_startup_speed", ctypes.c_float),
+        ("torque_constant", ctypes.c_float),
+        ("current_pid_config", PidConfig),
+        ("voltage_pid_config", PidConfig),
+        ("velocity_pid_config", PidConfig),
+        ("position_pid_config", PidConfig),
+        ("velocity_loop_per_commutation", ctypes.c_bool),
+        ("pwm_config", PwmConfig),
+        ("adc_config", AdcConfig),
+    ]
+
+
+class MotorSimHistory(ctypes.Structure):
+    _fields_ = [
+        ("time", ctypes.POINTER(ctypes.c_float)),
+        ("rotor_position", ctypes.POINTER(ctypes.c_float)),
+        ("rotor_velocity", ctypes.POINTER(ctypes.c_float)),
+        ("measured_velocity", ctypes.POINTER(ctypes.c_float)),
+        ("phase_currents", ctypes.POINTER(ctypes.c_float)),
+        ("phase_voltages", ctypes.POINTER(ctypes.c_float)),
+        ("torque_electrical", ctypes.POINTER(ctypes.c_float)),
+        ("dc_current", ctypes.POINTER(ctypes.c_float)),
+    ]
+
+
+# Entries of one cycle in each history buffer
+HISTORY_WIDTHS = {
+    "time": 1,
+    "rotor_position": 1,
+    "rotor_velocity": 1,
+    "measured_velocity": 1,
+    "phase_currents": NUM_MOTOR_PHASES,
+    "phase_voltages": NUM_MOTOR_PHASES,
+    "torque_electrical": 1,
+    "dc_current": 1,
+}
+
+
+def allocate_history(num_cycles, fields=None):
+    """
+    Buffers for num_cycles of history, (num_cycles,) or (num_cycles, NUM_MOTOR_PHASES) float32 each.
+    Returns:
+        {field: array} for the given fields, every field when None.
+    """
+    fields = HISTORY_WIDTHS.keys() if fields is None else fields
+    return {
+        field: np.empty((num_cycles,) if HISTORY_WIDTHS[field] == 1 else (num_cycles, HISTORY_WIDTHS[field]),
+                        dtype=np.float32)
+        for field in fields
+    }
+
+
+class MotorSimInterface:
+    MOTOR_OK = 0
+
+    def __init__(self, lib_path=None):
+        if lib_path is None:
+            lib_path = Path(__file__).parent.parent.parent / "build" / "libmotor_python_simulator.so"
+        lib_path = Path(lib_path).resolve()
+        print(f"Loading motor simulation shared library from: {lib_path}")
+
+        self.lib = ctypes.CDLL(str(lib_path))
+
+        self.lib.motor_sim_default_config.argtypes = [ctypes.c_int, ctypes.POINTER(MotorConfig)]
+        self.lib.motor_sim_default_config.restype = None
+
+        self.lib.motor_sim_create.argtypes = [ctypes.c_int, ctypes.POINTER(MotorConfig), ctypes.c_uint32]
+        self.lib.motor_sim_create.restype = ctypes.c_int
+
+        self.lib.motor_sim_destroy.argtypes = []
+        self.lib.motor_sim_destroy.restype = ctypes.c_int
+
+        self.lib.motor_sim_set_setpoint.argtypes = [ctypes.c_int, ctypes.c_float]
+        self.lib.motor_sim_set_setpoint.restype = ctypes.c_int
+
+        self.lib.motor_sim_step.argtypes = [
+            ctypes.c_uint32, ctypes.POINTER(MotorSimHistory), ctypes.POINTER(ctypes.c_uint32)
+        ]
+        self.lib.motor_sim_step.restype = ctypes.c_int
+
+        # Model controls of the simulation HAL
+        for name, argtypes in (("hal_sim_set_load_torque", [ctypes.c_float]),
+                               ("hal_sim_set_dc_voltage", [ctypes.c_float]),
+                               ("hal_sim_set_noise_seed", [ctypes.c_uint32]),
+                               ("hal_sim_set_rotor_position", [ctypes.c_float]),
+                               ("hal_sim_set_saliency", [ctypes.c_float, ctypes.c_float, ctypes.c_float])):
+            function = getattr(self.lib, name)
+            function.argtypes = argtypes
+            function.restype = None
+
+    def default_config(self, driver):
+        config = MotorConfig()
+        self.lib.motor_sim_default_config(driver, ctypes.byref(config))
+        return config
+
+    def create(self, driver, config=None, control_period_us=50, noise_seed=1):
+        """
+        Restart the simulation with a new motor. hal_sim settings such as the load torque apply after this.
+        """
+        if config is None:
+            config = self.default_config(driver)
+        self.lib.hal_sim_set_noise_seed(noise_seed)
+        result = self.lib.motor_sim_create(driver, ctypes.byref(config), control_period_us)
+        if result != self.MOTOR_OK:
+            raise RuntimeError(f"motor_sim_create failed with error code {result}")
+
+    def destroy(self):
+        self.lib.motor_sim_destroy()
+
+    def set_setpoint(self, mode, setpoint):
+        result = self.lib.motor_sim_set_setpoint(mode, setpoint)
+        if result != self.MOTOR_OK:
+            raise RuntimeError(f"motor_sim_set_setpoint failed with error code {result}")
+
+    def set_load_torque(self, torque_nm):
+        self.lib.hal_sim_set_load_torque(torque_nm)
+
+    def set_dc_voltage(self, voltage):
+        self.lib.hal_sim_set_dc_voltage(voltage)
+
+    def step(self, num_cycles, history=None):
+        """
+        Run num_cycles control cycles in C, writing each cycle into the history buffers in place.
+        history maps field names to C-contiguous float32 arrays of at least num_cycles rows, see allocate_history().
+        A failing cycle raises RuntimeError, the buffers hold the cycles before it.
+        """
+        history_struct = MotorSimHistory()
+        for field, array in (history or {}).items():
+            if (array.dtype != np.float32 or not array.flags.c_contiguous or
+                    array.size < num_cycles * HISTORY_WIDTHS[field]):
+                raise ValueError(f"{field} must be a C-contiguous float32 array of {num_cycles} cycles")
+            setattr(history_struct, field, array.ctypes.data_as(ctypes.POINTER(ctypes.c_float)))
+
+        cycles_run = ctypes.c_uint32()
+        result = self.lib.motor_sim_step(num_cycles, ctypes.byref(history_struct), ctypes.byref(cycles_run))
+        if result != self.MOTOR_OK:
+            raise RuntimeError(f"motor_sim_step failed with error code {result} after {cycles_run.value} cycles")
@@ -0,0 +1,192 @@
+/*******************************************************************************************************************************
+ * @file   motor_sim.c
+ *
+ * @brief  Source file for the host side closed-loop motor simulation binding
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "hal_sim.h"
+
+/* Intra-component Headers */
+#include "motor_sim.h"
+#include "motor_sim_drivers.h"
+
+#define MOTOR_SIM_US_TO_S 1e-6f /**< Microseconds to seconds */
+
+/**
+ * @brief   Simulated motor, the drivers keep a pointer to its configuration
+ */
+struct MotorSim_t {
+  struct Motor_t motor;        /**< Motor the steps run */
+  struct MotorConfig_t config; /**< Configuration of the motor */
+  uint32_t control_period_us;  /**< Model time between control cycles (us) */
+  bool is_created;             /**< The motor is initialized */
+};
+
+static struct MotorSim_t s_motor_sim = { 0 };
+
+static void record_cycle(const struct MotorSimHistory_t *history, uint32_t cycle) {
+  struct HalSimMotorState_t state;
+
+  hal_sim_get_motor_state(&state);
+
+  if (history->time != NULL) {
+    history->time[cycle] = (float)hal_get_micros() * MOTOR_SIM_US_TO_S;
+  }
+  if (history->rotor_position != NULL) {
+    history->rotor_position[cycle] = state.rotor_position;
+  }
+  if (history->rotor_velocity != NULL) {
+    history->rotor_velocity[cycle] = state.rotor_velocity;
+  }
+  if (history->measured_velocity != NULL) {
+    history->measured_velocity[cycle] = s_motor_sim.motor.state.velocity;
+  }
+  if (history->torque_electrical != NULL) {
+    history->torque_electrical[cycle] = state.torque_electrical;
+  }
+  if (history->dc_current != NULL) {
+    history->dc_current[cycle] = state.dc_current;
+  }
+
+  for (uint32_t phase = 0U; phase < NUM_MOTOR_PHASES; phase++) {
+    if (history->phase_currents != NULL) {
+      history->phase_currents[cycle * NUM_MOTOR_PHASES + phase] = state.phase_currents[phase];
+    }
+    if (history->phase_voltages != NULL) {
+      history->phase_voltages[cycle * NUM_MOTOR_PHASES + phase] = state.phase_voltages[phase];
+    }
+  }
+}
+
+void motor_sim_default_config(MotorSimDriver_t driver, struct MotorConfig_t *config) {
+  if (config == NULL) {
+    return;
+  }
+
+  memset(config, 0, sizeof(*config));
+  config->pole_pairs = 7U;
+  config->phase_resistance = 0.5f;
+  config->phase_inductance = 0.001f;
+  config->max_current = 40.0f;
+  config->max_voltage = 24.0f;
+
+  if (driver == MOTOR_SIM_DRIVER_6STEP_SENSORED || driver == MOTOR_SIM_DRIVER_6STEP_SENSORLESS) {
+    motor_sim_6step_default_config(driver, config);
+  } else {
+    motor_sim_foc_default_config(driver, config);
+  }
+
+  config->pwm_config.frequency = 20000U;
+  config->pwm_config.dead_time_ns = 500U;
+  config->pwm_config.resolution = 12U;
+  config->pwm_config.complementary_output = true;
+
+  config->adc_config.sampling_freq = 20000U;
+  config->adc_config.resolution = 12U;
+  config->adc_config.v_ref = 3.3f;
+  config->adc_config.current_gain = 0.1f;
+  config->adc_config.voltage_gain = 0.1f;
+}
+
+MotorError_t motor_sim_create(MotorSimDriver_t driver, const struct MotorConfig_t *config, uint32_t control_period_us) {
+  if (config == NULL || driver >= NUM_MOTOR_SIM_DRIVERS || control_period_us == 0U) {
+    return MOTOR_INVALID_ARGS;
+  }
+
+  motor_sim_destroy();
+
+  memset(&s_motor_sim.motor, 0, sizeof(s_motor_sim.motor));
+  s_motor_sim.config = *config;
+  s_motor_sim.control_period_us = control_period_us;
+
+  hal_sim_set_verbose(false);
+  hal_sim_restart();
+
+  if (driver == MOTOR_SIM_DRIVER_6STEP_SENSORED || driver == MOTOR_SIM_DRIVER_6STEP_SENSORLESS) {
+    motor_sim_6step_create_driver(driver, &s_motor_sim.motor);
+  } else {
+    motor_sim_foc_create_driver(driver, &s_motor_sim.motor);
+  }
+
+  MotorError_t err = s_motor_sim.motor.driver.init(&s_motor_sim.motor, &s_motor_sim.config);
+  if (err != MOTOR_OK) {
+    return err;
+  }
+
+  s_motor_sim.is_created = true;
+  return MOTOR_OK;
+}
+
+MotorError_t motor_sim_destroy(void) {
+  if (!s_motor_sim.is_created) {
+    return MOTOR_UNINITIALIZED;
+  }
+
+  s_motor_sim.is_created = false;
+  return s_motor_sim.motor.driver.deinit(&s_motor_sim.motor);
+}
+
+MotorError_t motor_sim_set_setpoint(ControlMode_t mode, float setpoint) {
+  if (!s_motor_sim.is_created) {
+    return MOTOR_UNINITIALIZED;
+  }
+
+  struct Motor_t *motor = &s_motor_sim.motor;
+
+  switch (mode) {
+    case CONTROL_MODE_VOLTAGE:
+      return motor->driver.set_voltage(motor, setpoint);
+    case CONTROL_MODE_CURRENT:
+      return motor->driver.set_current(motor, setpoint);
+    case CONTROL_MODE_VELOCITY:
+      return motor->driver.set_velocity(motor, setpoint);
+    case CONTROL_MODE_POSITION:
+      return motor->driver.set_position(motor, setpoint);
+    case CONTROL_MODE_TORQUE:
+      return motor->driver.set_torque(motor, setpoint);
+    default:
+      return MOTOR_INVALID_ARGS;
+  }
+}
+
+MotorError_t motor_sim_step(uint32_t num_cycles, const struct MotorSimHistory_t *history, uint32_t *cycles_run) {
+  MotorError_t err = MOTOR_OK;
+  uint32_t cycle = 0U;
+
+  if (!s_motor_sim.is_created) {
+    err = MOTOR_UNINITIALIZED;
+    num_cycles = 0U;
+  }
+
+  for (; cycle < num_cycles; cycle++) {
+    err = motor_run(&s_motor_sim.motor);
+    if (err != MOTOR_OK) {
+      break;
+    }
+
+    hal_sim_advance_us(s_motor_sim.control_period_us);
+
+    if (history != NULL) {
+      record_cycle(history, cycle);
+    }
+  }
+
+  if (cycles_run != NULL) {
+    *cycles_run = cycle;
+  }
+
+  return err;
+}
+
+struct Motor_t *motor_sim_get_motor(void) {
+  return s_motor_sim.is_created ? &s_motor_sim.motor : NULL;
+}
@@ -0,0 +1,45 @@
+/*******************************************************************************************************************************
+ * @file   motor_sim_6step.c
+ *
+ * @brief  Source file for the 6-step drivers of the motor simulation binding
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+#include "bldc_6step_sensored.h"
+#include "bldc_6step_sensorless.h"
+
+/* Intra-component Headers */
+#include "motor_sim_drivers.h"
+
+void motor_sim_6step_default_config(MotorSimDriver_t driver, struct MotorConfig_t *config) {
+  config->type = MOTOR_TYPE_BLDC;
+  config->control_mode = CONTROL_MODE_VOLTAGE;
+  config->max_velocity = 10000.0f;
+
+  if (driver == MOTOR_SIM_DRIVER_6STEP_SENSORED) {
+    config->control_method = CONTROL_METHOD_SIX_STEP;
+
+    /* Speed error (electrical RPM) to a signed duty, as in the position scenario */
+    config->velocity_pid_config.kp = 0.0001f;
+    config->velocity_pid_config.ki = 0.002f;
+    config->velocity_pid_config.output_min = -1.0f;
+    config->velocity_pid_config.output_max = 1.0f;
+  } else {
+    config->control_method = CONTROL_METHOD_SENSORLESS;
+    config->current_pid_config.output_min = 0.0f;
+    config->current_pid_config.output_max = 1.0f;
+  }
+}
+
+void motor_sim_6step_create_driver(MotorSimDriver_t driver, struct Motor_t *motor) {
+  if (driver == MOTOR_SIM_DRIVER_6STEP_SENSORED) {
+    bldc_6step_sensored_create_driver(motor);
+  } else {
+    bldc_6step_sensorless_create_driver(motor);
+  }
+}
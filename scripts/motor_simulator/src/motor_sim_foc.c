@@ -0,0 +1,41 @@
+/*******************************************************************************************************************************
+ * @file   motor_sim_foc.c
+ *
+ * @brief  Source file for the FOC drivers of the motor simulation binding
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+#include "foc_sensored.h"
+#include "foc_sensorless.h"
+
+/* Intra-component Headers */
+#include "motor_sim_drivers.h"
+
+void motor_sim_foc_default_config(MotorSimDriver_t driver, struct MotorConfig_t *config) {
+  (void)driver;
+
+  config->type = MOTOR_TYPE_PMSM;
+  config->control_method = CONTROL_METHOD_FOC;
+  config->control_mode = CONTROL_MODE_CURRENT;
+  config->max_velocity = 200.0f;
+  config->torque_constant = 0.15f;
+
+  /* Speed error (mechanical rad/s) to a q-axis current (A), as in the sensorless speed range scenario */
+  config->velocity_pid_config.kp = 0.1f;
+  config->velocity_pid_config.ki = 2.0f;
+  config->velocity_pid_config.output_min = -10.0f;
+  config->velocity_pid_config.output_max = 10.0f;
+}
+
+void motor_sim_foc_create_driver(MotorSimDriver_t driver, struct Motor_t *motor) {
+  if (driver == MOTOR_SIM_DRIVER_FOC_SENSORED) {
+    foc_sensored_create_driver(motor);
+  } else {
+    foc_sensorless_create_driver(motor, OBSERVER_TYPE_BACKEMF_PLL);
+  }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   gain_sweep.h
+ *
+ * @brief  Header file for the host side PLL and PID gain sweeps
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdint.h>
+
+/* Inter-component Headers */
+#include "pid.h"
+#include "pll.h"
+#include "utils_error.h"
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup GainSweep Gain sweep
+ * @brief    Runs a loop over every kp/ki pair of a grid against one test signal, for the Python visualizers
+ * @{
+ */
+
+/**
+ * @brief   Gains of a sweep, every kp is run with every ki
+ */
+struct GainSweepGrid_t {
+  const float *kp_values; /**< Proportional gains, the rows of the result */
+  uint32_t num_kp;        /**< Entries in kp_values */
+  const float *ki_values; /**< Integral gains, the columns of the result */
+  uint32_t num_ki;        /**< Entries in ki_values */
+};
+
+/**
+ * @brief   Test signal shared by every pair of a sweep
+ */
+struct GainSweepSignal_t {
+  const float *reference; /**< Reference at each sample, an angle for the PLL and a setpoint for the PID */
+  const float *noise;     /**< Noise added to the measurement at each sample, NULL for none */
+  uint32_t num_samples;   /**< Entries in reference, and in noise when given */
+  float dt;               /**< Time between samples (s) */
+};
+
+/**
+ * @brief   First order plant closed by the PID in a sweep, y' = (gain * u - y) / time_constant
+ */
+struct PidSweepPlant_t {
+  float gain;          /**< Steady-state output per unit of PID output */
+  float time_constant; /**< Time constant (s) */
+};
+
+/**
+ * @brief   Sweep the PLL gains against an angle reference
+ * @details Each sample feeds the PLL the wrapped angle error plus the noise, the same as PLLVisualizer.run_sweep(). The
+ *          result is the RMS of the unwrapped tracking error of the PLL output
+ * @param   base_config Configuration of every run, its kp and ki replaced by the grid
+ * @param   grid Gains to run
+ * @param   signal Angle reference (rad) and phase noise (rad)
+ * @param   num_threads Worker threads, 0 for one per online core
+ * @param   rms_errors num_kp * num_ki RMS errors, row-major in kp (rad)
+ * @return  UTILS_OK on success, UTILS_INVALID_ARGS on a NULL pointer, an empty grid or signal, or an invalid base_config
+ */
+UtilsError_t pll_sweep_gains(const struct PLLConfig_t *base_config, const struct GainSweepGrid_t *grid,
+                             const struct GainSweepSignal_t *signal, uint32_t num_threads, float *rms_errors);
+
+/**
+ * @brief   Sweep the PID gains on a first order plant against a setpoint
+ * @details The plant starts at rest and the noise is added to the output the PID measures. The result is the RMS of the
+ *          setpoint less the noise-free plant output
+ * @param   base_config Configuration of every run, its kp and ki replaced by the grid
+ * @param   plant Plant closed by the PID
+ * @param   grid Gains to run
+ * @param   signal Setpoint and measurement noise
+ * @param   num_threads Worker threads, 0 for one per online core
+ * @param   rms_errors num_kp * num_ki RMS errors, row-major in kp
+ * @return  UTILS_OK on success, UTILS_INVALID_ARGS on a NULL pointer, an empty grid or signal, or a zero time constant
+ */
+UtilsError_t pid_sweep_gains(const struct PidConfig_t *base_config, const struct PidSweepPlant_t *plant,
+                             const struct GainSweepGrid_t *grid, const struct GainSweepSignal_t *signal, uint32_t num_threads,
+                             float *rms_errors);
+
+/** @} */
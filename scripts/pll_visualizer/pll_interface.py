@@ -1,28 +1,87 @@
 import ctypes
+import numpy as np
 from pathlib import Path
 
+class PLLGainPoint(ctypes.Structure):
+    _fields_ = [
+        ("omega", ctypes.c_float),
+        ("bandwidth", ctypes.c_float),
+    ]
+
+
 class PLLConfig(ctypes.Structure):
     _fields_ = [
         ("kp", ctypes.c_float),
         ("ki", ctypes.c_float),
         ("max_omega", ctypes.c_float),
-        ("enable_filtering", ctypes.c_bool),
         ("filter_alpha", ctypes.c_float),
+        ("enable_filtering", ctypes.c_bool),
+        ("gain_schedule", ctypes.POINTER(PLLGainPoint)),
+        ("num_gain_points", ctypes.c_uint8),
+        ("track_acceleration", ctypes.c_bool),
+        ("ka", ctypes.c_float),
     ]
 
 
 class PLLState(ctypes.Structure):
     _fields_ = [
+        ("integrator", ctypes.c_float),
+        ("prev_error", ctypes.c_float),
         ("theta", ctypes.c_float),
         ("omega", ctypes.c_float),
-        ("integrator", ctypes.c_float),
         ("max_error", ctypes.c_float),
+        ("filtered_error", ctypes.c_float),
+        ("acceleration", ctypes.c_float),
         ("is_converged", ctypes.c_bool),
-        ("prev_error", ctypes.c_float),
         ("cfg", ctypes.POINTER(PLLConfig))
     ]
 
 
+class PidConfig(ctypes.Structure):
+    _fields_ = [
+        ("kp", ctypes.c_float),
+        ("ki", ctypes.c_float),
+        ("kd", ctypes.c_float),
+        ("output_min", ctypes.c_float),
+        ("output_max", ctypes.c_float),
+        ("derivative_ema_alpha", ctypes.c_float),
+    ]
+
+
+class PidSweepPlant(ctypes.Structure):
+    _fields_ = [
+        ("gain", ctypes.c_float),
+        ("time_constant", ctypes.c_float),
+    ]
+
+
+class GainSweepGrid(ctypes.Structure):
+    _fields_ = [
+        ("kp_values", ctypes.POINTER(ctypes.c_float)),
+        ("num_kp", ctypes.c_uint32),
+        ("ki_values", ctypes.POINTER(ctypes.c_float)),
+        ("num_ki", ctypes.c_uint32),
+    ]
+
+
+class GainSweepSignal(ctypes.Structure):
+    _fields_ = [
+        ("reference", ctypes.POINTER(ctypes.c_float)),
+        ("noise", ctypes.POINTER(ctypes.c_float)),
+        ("num_samples", ctypes.c_uint32),
+        ("dt", ctypes.c_float),
+    ]
+
+
+def _float_array(values):
+    """Contiguous float32 copy of values, kept alive by the caller while C reads it."""
+    return np.ascontiguousarray(values, dtype=np.float32)
+
+
+def _float_pointer(array):
+    return array.ctypes.data_as(ctypes.POINTER(ctypes.c_float))
+
+
 class PLLInterface:
     def __init__(self, lib_path=None):
         if lib_path is None:
@@ -43,6 +102,25 @@ class PLLInterface:
         ]
         self.lib.pll_update.restype = ctypes.c_int
 
+        self.lib.pll_sweep_gains.argtypes = [
+            ctypes.POINTER(PLLConfig),
+            ctypes.POINTER(GainSweepGrid),
+            ctypes.POINTER(GainSweepSignal),
+            ctypes.c_uint32,
+            ctypes.POINTER(ctypes.c_float)
+        ]
+        self.lib.pll_sweep_gains.restype = ctypes.c_int
+
+        self.lib.pid_sweep_gains.argtypes = [
+            ctypes.POINTER(PidConfig),
+            ctypes.POINTER(PidSweepPlant),
+            ctypes.POINTER(GainSweepGrid),
+            ctypes.POINTER(GainSweepSignal),
+            ctypes.c_uint32,
+            ctypes.POINTER(ctypes.c_float)
+        ]
+        self.lib.pid_sweep_gains.restype = ctypes.c_int
+
         self.UTILS_OK = 0
         self.UTILS_INVALID_ARGS = 1
 
@@ -65,6 +143,47 @@ class PLLInterface:
             raise RuntimeError(f"pll_update failed with error code {result}")
         return theta_out.value, omega_out.value
 
+    def _run_sweep(self, sweep, configs, kp_vals, ki_vals, reference, noise, dt, num_threads):
+        kp_array = _float_array(kp_vals)
+        ki_array = _float_array(ki_vals)
+        reference_array = _float_array(reference)
+        noise_array = None if noise is None else _float_array(noise)
+        if noise_array is not None and noise_array.size != reference_array.size:
+            raise ValueError("noise must have one entry per reference sample")
+
+        grid = GainSweepGrid(_float_pointer(kp_array), kp_array.size, _float_pointer(ki_array), ki_array.size)
+        signal = GainSweepSignal(
+            _float_pointer(reference_array),
+            None if noise_array is None else _float_pointer(noise_array),
+            reference_array.size,
+            dt
+        )
+        rms_errors = np.zeros((kp_array.size, ki_array.size), dtype=np.float32)
+
+        result = sweep(*[ctypes.byref(config) for config in configs], ctypes.byref(grid), ctypes.byref(signal),
+                       num_threads, _float_pointer(rms_errors))
+        if result != self.UTILS_OK:
+            raise RuntimeError(f"{sweep.__name__} failed with error code {result}")
+        return rms_errors
+
+    def sweep_pll_gains(self, pll_config: PLLConfig, kp_vals, ki_vals, theta_ref, noise, dt: float, num_threads=0):
+        """
+        Run the PLL over every kp/ki pair natively, in parallel across cores.
+        Returns:
+            (len(kp_vals), len(ki_vals)) matrix of RMS unwrapped tracking errors in rad.
+        """
+        return self._run_sweep(self.lib.pll_sweep_gains, [pll_config], kp_vals, ki_vals, theta_ref, noise, dt, num_threads)
+
+    def sweep_pid_gains(self, pid_config: PidConfig, plant: PidSweepPlant, kp_vals, ki_vals, setpoint, noise, dt: float,
+                        num_threads=0):
+        """
+        Close the PID around a first order plant for every kp/ki pair natively, in parallel across cores.
+        Returns:
+            (len(kp_vals), len(ki_vals)) matrix of RMS setpoint errors.
+        """
+        return self._run_sweep(self.lib.pid_sweep_gains, [pid_config, plant], kp_vals, ki_vals, setpoint, noise, dt,
+                               num_threads)
+
 class DefaultPLL:
     def __init__(self, lib_path=None):
         self.interface = PLLInterface(lib_path)
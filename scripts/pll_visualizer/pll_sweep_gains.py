@@ -1,51 +1,61 @@
 import argparse
+import time
 import numpy as np
 import matplotlib.pyplot as plt
 
-from pll_interface              import PLLInterface, DefaultPLL
-from pll_visualizer             import PLLVisualizer
+from pll_interface              import PLLInterface, PLLConfig, PidConfig, PidSweepPlant
 
-def sweep_pll_gains_c_wrapper(kp_vals, ki_vals, dt=0.01, total_time=5.0, freq=0.5, noise=0.05, lib_path=None):
-    rms_errors = np.zeros((len(kp_vals), len(ki_vals)))
+def make_test_signal(dt, total_time, freq, noise):
+    """Angle of a shaft turning at freq, sampled like PLLVisualizer.run_sweep(), and the phase noise of each sample."""
+    num_steps = int(total_time / dt)
+    t = np.linspace(0, total_time, num_steps)
+    theta_ref = 2 * np.pi * freq * t
+    return theta_ref, np.random.normal(0, noise, num_steps)
 
-    for i, kp in enumerate(kp_vals):
-        for j, ki in enumerate(ki_vals):
-            pll = DefaultPLL(lib_path=lib_path)
-            pll.config.kp = kp
-            pll.config.ki = ki
-            pll.config.max_omega = 100.0
-            pll.config.enable_filtering = True
-            pll.config.filter_alpha = 0.5
-            pll.interface.init_pll(pll.state, pll.config)
+def sweep_pll_gains_c_wrapper(kp_vals, ki_vals, dt=0.01, total_time=5.0, freq=0.5, noise=0.05, lib_path=None, num_threads=0):
+    """RMS phase error of every kp/ki pair, one native call running all of them across the cores."""
+    interface = PLLInterface(lib_path)
+    config = PLLConfig(kp=1.0, ki=0.8, max_omega=100.0, enable_filtering=True, filter_alpha=0.5)
+    theta_ref, phase_noise = make_test_signal(dt, total_time, freq, noise)
 
-            vis = PLLVisualizer(pll)
-            t, omega, theta, phase_err, theta_ref = vis.run_sweep(dt, total_time, freq, noise)
+    return interface.sweep_pll_gains(config, kp_vals, ki_vals, theta_ref, phase_noise, dt, num_threads)
 
-            unwrapped_error = np.unwrap(phase_err)
-            rms_error = np.sqrt(np.mean(unwrapped_error**2))
-            rms_errors[i, j] = rms_error
+def sweep_pid_gains_c_wrapper(kp_vals, ki_vals, dt=0.001, total_time=2.0, step_time=0.1, noise=0.01, plant_gain=1.0,
+                              plant_time_constant=0.05, lib_path=None, num_threads=0):
+    """RMS setpoint error of the PID closed around a first order plant for every kp/ki pair, on a unit step."""
+    interface = PLLInterface(lib_path)
+    config = PidConfig(kp=1.0, ki=0.0, kd=0.0, output_min=-10.0, output_max=10.0, derivative_ema_alpha=0.1)
+    plant = PidSweepPlant(gain=plant_gain, time_constant=plant_time_constant)
 
-    return rms_errors
+    num_steps = int(total_time / dt)
+    t = np.arange(num_steps) * dt
+    setpoint = np.where(t >= step_time, 1.0, 0.0)
+    measurement_noise = np.random.normal(0, noise, num_steps)
 
-def calculate_optimal_pll_gains():
+    return interface.sweep_pid_gains(config, plant, kp_vals, ki_vals, setpoint, measurement_noise, dt, num_threads)
+
+def calculate_optimal_pll_gains(num_points=100, show_plot=True):
     # Define ranges
-    kp_range = np.linspace(0.5, 5.0, 10)
-    ki_range = np.linspace(0.2, 3.0, 10)
+    kp_range = np.linspace(0.5, 5.0, num_points)
+    ki_range = np.linspace(0.2, 3.0, num_points)
 
     # Run sweep
+    start = time.perf_counter()
     rms_matrix = sweep_pll_gains_c_wrapper(kp_range, ki_range)
+    print(f"Swept {rms_matrix.size} gain pairs in {time.perf_counter() - start:.2f} s")
 
     # Plot heatmap
-    plt.figure(figsize=(8, 6))
-    plt.imshow(rms_matrix, origin='lower', aspect='auto',
-            extent=[ki_range[0], ki_range[-1], kp_range[0], kp_range[-1]],
-            cmap='viridis')
-    plt.colorbar(label="RMS Phase Error (rad)")
-    plt.xlabel("ki")
-    plt.ylabel("kp")
-    plt.title("PLL Gain Sweep - RMS Phase Error")
-    plt.tight_layout()
-    plt.show()
+    if show_plot:
+        plt.figure(figsize=(8, 6))
+        plt.imshow(rms_matrix, origin='lower', aspect='auto',
+                extent=[ki_range[0], ki_range[-1], kp_range[0], kp_range[-1]],
+                cmap='viridis')
+        plt.colorbar(label="RMS Phase Error (rad)")
+        plt.xlabel("ki")
+        plt.ylabel("kp")
+        plt.title("PLL Gain Sweep - RMS Phase Error")
+        plt.tight_layout()
+        plt.show()
 
     # Report best result
     min_idx = np.unravel_index(np.argmin(rms_matrix), rms_matrix.shape)
@@ -55,4 +65,5 @@ def calculate_optimal_pll_gains():
 
     print(f"\nBest Gains: kp = {best_kp:.3f}, ki = {best_ki:.3f} → RMS Error = {best_rms:.4f} rad")
 
-    return {best_kp, best_ki}
+    # In the order __main__ unpacks them
+    return best_ki, best_kp
@@ -0,0 +1,212 @@
+/*******************************************************************************************************************************
+ * @file   gain_sweep.c
+ *
+ * @brief  Source file for the host side PLL and PID gain sweeps
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <pthread.h>
+#include <stddef.h>
+#include <unistd.h>
+
+/* Inter-component Headers */
+#include "math_utils.h"
+#include "pid.h"
+#include "pll.h"
+
+/* Intra-component Headers */
+#include "gain_sweep.h"
+
+#define GAIN_SWEEP_MAX_THREADS 64U /**< Most worker threads of one sweep */
+
+/**
+ * @brief   One sweep shared by its workers, each run writes only its own result
+ */
+struct GainSweepJob_t {
+  const struct GainSweepGrid_t *grid;     /**< Gains to run */
+  const struct GainSweepSignal_t *signal; /**< Test signal */
+  const void *base_config;                /**< PLLConfig_t or PidConfig_t the gains are written into */
+  const struct PidSweepPlant_t *plant;    /**< Plant of a PID sweep, NULL for the PLL */
+  float (*run)(const struct GainSweepJob_t *job, float kp, float ki); /**< One run, returns its RMS error */
+  float *rms_errors;                      /**< Results, row-major in kp */
+};
+
+/**
+ * @brief   Share of one worker, every num_workers-th run from first_index
+ */
+struct GainSweepWorker_t {
+  const struct GainSweepJob_t *job; /**< Sweep being run */
+  uint32_t first_index;             /**< First run of this worker */
+  uint32_t num_workers;             /**< Stride between its runs */
+  pthread_t thread;                 /**< Thread running it */
+};
+
+/* Angle wrapped to [-pi, pi) */
+static float wrap_angle(float angle) {
+  return normalize_angle(angle + MATH_PI) - MATH_PI;
+}
+
+static float sample_noise(const struct GainSweepSignal_t *signal, uint32_t sample) {
+  return (signal->noise != NULL) ? signal->noise[sample] : 0.0f;
+}
+
+static float run_pll_case(const struct GainSweepJob_t *job, float kp, float ki) {
+  const struct GainSweepSignal_t *signal = job->signal;
+  struct PLLConfig_t config = *(const struct PLLConfig_t *)job->base_config;
+  struct PLLState_t state;
+  float theta = 0.0f;
+  float omega = 0.0f;
+  float prev_error = 0.0f;
+  float unwrapped_error = 0.0f;
+  float sum_squared = 0.0f;
+
+  config.kp = kp;
+  config.ki = ki;
+  pll_init(&state, &config);
+
+  for (uint32_t i = 0U; i < signal->num_samples; i++) {
+    float phase_error = wrap_angle(wrap_angle(signal->reference[i] - state.theta) + sample_noise(signal, i));
+    pll_update(&state, phase_error, signal->dt, &theta, &omega);
+
+    /* Unwrapped the way numpy.unwrap() does, a lost cycle counts in full */
+    float tracking_error = wrap_angle(signal->reference[i] - theta);
+    unwrapped_error = (i == 0U) ? tracking_error : (unwrapped_error + wrap_angle(tracking_error - prev_error));
+    prev_error = tracking_error;
+    sum_squared += unwrapped_error * unwrapped_error;
+  }
+
+  return sqrtf(sum_squared / (float)signal->num_samples);
+}
+
+static float run_pid_case(const struct GainSweepJob_t *job, float kp, float ki) {
+  const struct GainSweepSignal_t *signal = job->signal;
+  struct PidConfig_t config = *(const struct PidConfig_t *)job->base_config;
+  struct PidController_t pid;
+  float output = 0.0f;
+  float sum_squared = 0.0f;
+  float step = signal->dt / job->plant->time_constant;
+
+  config.kp = kp;
+  config.ki = ki;
+  pid_init(&pid, &config);
+
+  for (uint32_t i = 0U; i < signal->num_samples; i++) {
+    float control = pid_update(&pid, signal->reference[i], output + sample_noise(signal, i), signal->dt);
+    output += step * (job->plant->gain * control - output);
+
+    float error = signal->reference[i] - output;
+    sum_squared += error * error;
+  }
+
+  return sqrtf(sum_squared / (float)signal->num_samples);
+}
+
+static void *run_worker(void *arg) {
+  const struct GainSweepWorker_t *worker = (const struct GainSweepWorker_t *)arg;
+  const struct GainSweepJob_t *job = worker->job;
+  uint32_t num_runs = job->grid->num_kp * job->grid->num_ki;
+
+  for (uint32_t index = worker->first_index; index < num_runs; index += worker->num_workers) {
+    float kp = job->grid->kp_values[index / job->grid->num_ki];
+    float ki = job->grid->ki_values[index % job->grid->num_ki];
+    job->rms_errors[index] = job->run(job, kp, ki);
+  }
+
+  return NULL;
+}
+
+static uint32_t count_workers(uint32_t num_threads, uint32_t num_runs) {
+  if (num_threads == 0U) {
+    long num_cores = sysconf(_SC_NPROCESSORS_ONLN);
+    num_threads = (num_cores > 0L) ? (uint32_t)num_cores : 1U;
+  }
+
+  if (num_threads > GAIN_SWEEP_MAX_THREADS) {
+    num_threads = GAIN_SWEEP_MAX_THREADS;
+  }
+
+  return (num_threads < num_runs) ? num_threads : num_runs;
+}
+
+static void run_sweep(const struct GainSweepJob_t *job, uint32_t num_threads) {
+  struct GainSweepWorker_t workers[GAIN_SWEEP_MAX_THREADS];
+  bool is_started[GAIN_SWEEP_MAX_THREADS];
+  uint32_t num_workers = count_workers(num_threads, job->grid->num_kp * job->grid->num_ki);
+
+  /* Worker 0 runs on the calling thread */
+  for (uint32_t i = 0U; i < num_workers; i++) {
+    workers[i].job = job;
+    workers[i].first_index = i;
+    workers[i].num_workers = num_workers;
+    is_started[i] = (i > 0U) && (pthread_create(&workers[i].thread, NULL, run_worker, &workers[i]) == 0);
+  }
+
+  /* A share whose thread could not be created is run here instead */
+  for (uint32_t i = 0U; i < num_workers; i++) {
+    if (!is_started[i]) {
+      run_worker(&workers[i]);
+    }
+  }
+
+  for (uint32_t i = 1U; i < num_workers; i++) {
+    if (is_started[i]) {
+      pthread_join(workers[i].thread, NULL);
+    }
+  }
+}
+
+static bool is_valid_sweep(const struct GainSweepGrid_t *grid, const struct GainSweepSignal_t *signal, const float *rms_errors) {
+  if (grid == NULL || signal == NULL || rms_errors == NULL) {
+    return false;
+  }
+
+  return grid->kp_values != NULL && grid->ki_values != NULL && grid->num_kp > 0U && grid->num_ki > 0U &&
+         signal->reference != NULL && signal->num_samples > 0U;
+}
+
+UtilsError_t pll_sweep_gains(const struct PLLConfig_t *base_config, const struct GainSweepGrid_t *grid,
+                             const struct GainSweepSignal_t *signal, uint32_t num_threads, float *rms_errors) {
+  struct PLLState_t state;
+
+  /* Checked once here, the runs cannot report a failure */
+  if (base_config == NULL || !is_valid_sweep(grid, signal, rms_errors) || pll_init(&state, base_config) != UTILS_OK) {
+    return UTILS_INVALID_ARGS;
+  }
+
+  struct GainSweepJob_t job = {
+    .grid = grid,
+    .signal = signal,
+    .base_config = base_config,
+    .plant = NULL,
+    .run = run_pll_case,
+    .rms_errors = rms_errors,
+  };
+
+  run_sweep(&job, num_threads);
+
+  return UTILS_OK;
+}
+
+UtilsError_t pid_sweep_gains(const struct PidConfig_t *base_config, const struct PidSweepPlant_t *plant,
+                             const struct GainSweepGrid_t *grid, const struct GainSweepSignal_t *signal, uint32_t num_threads,
+                             float *rms_errors) {
+  if (base_config == NULL || plant == NULL || plant->time_constant <= 0.0f || !is_valid_sweep(grid, signal, rms_errors)) {
+    return UTILS_INVALID_ARGS;
+  }
+
+  struct GainSweepJob_t job = {
+    .grid = grid,
+    .signal = signal,
+    .base_config = base_config,
+    .plant = plant,
+    .run = run_pid_case,
+    .rms_errors = rms_errors,
+  };
+
+  run_sweep(&job, num_threads);
+
+  return UTILS_OK;
+}
@@ -7,6 +7,7 @@ from clarke_phase_visualizer    import ClarkeVisualizer
 from park_visualizer            import ParkVisualizer
 from inverse_park_visualizer    import InverseParkVisualizer
 from noise_generator            import generate_noisy_phases
+from transform_benchmark        import run_benchmark, print_benchmark
 
 def main():
     parser = argparse.ArgumentParser(description="SVPWM and Parke/Clarke Transform Visualization Framework")
@@ -14,10 +15,16 @@ def main():
     parser.add_argument("--resolution", type=int, default=360)
     parser.add_argument("--noise", type=float, default=0.05)
     parser.add_argument("--lib", type=str, default=None)
+    parser.add_argument("--benchmark", type=int, default=0, metavar="SAMPLES",
+                        help="Print scalar and array samples/s over this many samples instead of plotting")
     args = parser.parse_args()
 
     svpwm_transform_interface = SvpwmTransformInterface(lib_path=args.lib)
 
+    if args.benchmark > 0:
+        print_benchmark(run_benchmark(svpwm_transform_interface, args.benchmark))
+        return
+
     # SVPWM
     svpwm_viz = SVPWMVisualizer(svpwm_transform_interface)
     thetas, dA, dB, dC = svpwm_viz.run_sweep(args.vref, args.resolution)
@@ -9,23 +9,13 @@ class ClarkeVisualizer:
         """
         Compute Clarke transform for 3-phase inputs
         """
-        alphas, betas = [], []
-        for ia_val, ib_val, ic_val in zip(ia, ib, ic):
-            alpha, beta = self.foc_common.clarke_3phase(ia_val, ib_val, ic_val)
-            alphas.append(alpha)
-            betas.append(beta)
-        return np.array(alphas), np.array(betas)
+        return self.foc_common.clarke_batch(ia, ib, ic)
 
     def run_2phase_sweep(self, thetas, ia, ib):
         """
         Compute Clarke transform for 2-phase inputs
         """
-        alphas, betas = [], []
-        for ia_val, ib_val in zip(ia, ib):
-            alpha, beta = self.foc_common.clarke_2phase(ia_val, ib_val)
-            alphas.append(alpha)
-            betas.append(beta)
-        return np.array(alphas), np.array(betas)
+        return self.foc_common.clarke_batch(ia, ib)
 
     def plot_alpha_beta(self, alphas, betas, title="Clarke α-β Plane"):
         plt.figure(figsize=(6,6))
@@ -0,0 +1,80 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   transform_batch.h
+ *
+ * @brief  Header file for the host side array Clarke/Park transforms and SVPWM
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdint.h>
+
+/* Inter-component Headers */
+#include "utils_error.h"
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup TransformBatch Array transforms
+ * @brief    Clarke/Park transforms and SVPWM over structure-of-arrays buffers, for the Python visualizers
+ * @details  Every output array is written in full and may not alias an input. The loops are branch-free and use a
+ *           polynomial sin/cos, within 2e-7 of sinf/cosf for angles under 1000 rad, so the compiler vectorizes them
+ * @{
+ */
+
+/**
+ * @brief   Clarke transform of count samples
+ * @param   ia Phase A currents
+ * @param   ib Phase B currents
+ * @param   ic Phase C currents, NULL to infer them as -ia - ib like clarke_transform_2phase()
+ * @param   alpha α-axis results
+ * @param   beta β-axis results
+ * @param   count Samples in every array
+ * @return  UTILS_OK if successful, UTILS_INVALID_ARGS if a required pointer is null
+ */
+UtilsError_t clarke_transform_batch(const float *ia, const float *ib, const float *ic, float *alpha, float *beta, uint32_t count);
+
+/**
+ * @brief   Park transform of count samples, see park_transform()
+ * @param   alpha α-axis inputs
+ * @param   beta β-axis inputs
+ * @param   theta Rotor electrical angles (radians)
+ * @param   d Direct-axis results
+ * @param   q Quadrature-axis results
+ * @param   count Samples in every array
+ * @return  UTILS_OK if successful, UTILS_INVALID_ARGS if a pointer is null
+ */
+UtilsError_t park_transform_batch(const float *alpha, const float *beta, const float *theta, float *d, float *q, uint32_t count);
+
+/**
+ * @brief   Inverse Park transform of count samples, see inverse_park_transform()
+ * @param   d Direct-axis inputs
+ * @param   q Quadrature-axis inputs
+ * @param   theta Rotor electrical angles (radians)
+ * @param   alpha α-axis results
+ * @param   beta β-axis results
+ * @param   count Samples in every array
+ * @return  UTILS_OK if successful, UTILS_INVALID_ARGS if a pointer is null
+ */
+UtilsError_t inverse_park_transform_batch(const float *d, const float *q, const float *theta, float *alpha, float *beta,
+                                          uint32_t count);
+
+/**
+ * @brief   SVPWM duty cycles of count samples, the same as svpwm_generate()
+ * @details Computed as the sine references with the min-max zero sequence added, which equals the sector timings without
+ *          a branch on the sector
+ * @param   theta_e Electrical angles (radians)
+ * @param   vref_mag Normalized voltage magnitudes, clamped to 0.0 to 1.0
+ * @param   duty_a Phase A duty cycles
+ * @param   duty_b Phase B duty cycles
+ * @param   duty_c Phase C duty cycles
+ * @param   count Samples in every array
+ * @return  UTILS_OK if successful, UTILS_INVALID_ARGS if a pointer is null
+ */
+UtilsError_t svpwm_generate_batch(const float *theta_e, const float *vref_mag, float *duty_a, float *duty_b, float *duty_c,
+                                  uint32_t count);
+
+/** @} */
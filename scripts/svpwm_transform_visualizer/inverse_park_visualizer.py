@@ -15,13 +15,9 @@ class InverseParkVisualizer:
             d_array += np.random.normal(0, noise_sigma, size=resolution)
             q_array += np.random.normal(0, noise_sigma, size=resolution)
 
-        alphas, betas = [], []
-        for theta, d_val, q_val in zip(thetas, d_array, q_array):
-            alpha, beta = self.foc_common.inverse_park(d_val, q_val, theta)
-            alphas.append(alpha)
-            betas.append(beta)
+        alphas, betas = self.foc_common.inverse_park_batch(d_array, q_array, thetas)
 
-        return thetas, np.array(alphas), np.array(betas)
+        return thetas, alphas, betas
 
     def plot_alpha_beta(self, alphas, betas):
         plt.figure(figsize=(6,6))
@@ -15,13 +15,9 @@ class ParkVisualizer:
             alpha_array += np.random.normal(0, noise_sigma, size=resolution)
             beta_array += np.random.normal(0, noise_sigma, size=resolution)
 
-        d_vals, q_vals = [], []
-        for theta, a, b in zip(thetas, alpha_array, beta_array):
-            d, q = self.foc_common.park(a, b, theta)
-            d_vals.append(d)
-            q_vals.append(q)
+        d_vals, q_vals = self.foc_common.park_batch(alpha_array, beta_array, thetas)
 
-        return thetas, np.array(d_vals), np.array(q_vals)
+        return thetas, d_vals, q_vals
 
     def plot_d_q(self, d_vals, q_vals):
         plt.figure(figsize=(6,6))
@@ -0,0 +1,133 @@
+/*******************************************************************************************************************************
+ * @file   transform_batch.c
+ *
+ * @brief  Source file for the host side array Clarke/Park transforms and SVPWM
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stddef.h>
+
+/* Inter-component Headers */
+#include "math_utils.h"
+
+/* Intra-component Headers */
+#include "transform_batch.h"
+
+#define BATCH_TWO_OVER_PI 0.636619772f         /**< 2 / pi */
+#define BATCH_PI_OVER_2_HI 1.5703125f          /**< pi / 2 to 8 bits, its product with a quadrant count stays exact */
+#define BATCH_PI_OVER_2_LO 4.838267949e-4f     /**< Remainder of pi / 2 */
+#define BATCH_ROUND_MAGIC 12582912.0f          /**< 1.5 * 2^23, adding and removing it rounds to the nearest integer */
+#define BATCH_TWO_OVER_THREE (2.0f / 3.0f)     /**< Phase amplitude per unit of modulation index */
+
+/*
+ * sin and cos of x without a branch or a libm call, so loops around it vectorize. x is reduced to a quadrant and
+ * r within +-pi/4, where Taylor series to r^9 and r^10 are within a float rounding
+ */
+static inline void batch_sin_cos(float x, float *sin_x, float *cos_x) {
+  float quadrant = (x * BATCH_TWO_OVER_PI + BATCH_ROUND_MAGIC) - BATCH_ROUND_MAGIC;
+  int32_t q = (int32_t)quadrant;
+  float r = (x - quadrant * BATCH_PI_OVER_2_HI) - quadrant * BATCH_PI_OVER_2_LO;
+  float r2 = r * r;
+
+  float sin_r = r + r * r2 * (-1.0f / 6.0f + r2 * (1.0f / 120.0f + r2 * (-1.0f / 5040.0f + r2 * (1.0f / 362880.0f))));
+  float cos_r = 1.0f + r2 * (-0.5f + r2 * (1.0f / 24.0f + r2 * (-1.0f / 720.0f + r2 * (1.0f / 40320.0f))));
+
+  /* Odd quadrants swap sin and cos, the upper two negate sin, the middle two negate cos */
+  float sin_base = (q & 1) ? cos_r : sin_r;
+  float cos_base = (q & 1) ? sin_r : cos_r;
+
+  *sin_x = (q & 2) ? -sin_base : sin_base;
+  *cos_x = ((q + 1) & 2) ? -cos_base : cos_base;
+}
+
+UtilsError_t clarke_transform_batch(const float *ia, const float *ib, const float *ic, float *alpha, float *beta, uint32_t count) {
+  if (ia == NULL || ib == NULL || alpha == NULL || beta == NULL) {
+    return UTILS_INVALID_ARGS;
+  }
+
+  /* Separate loops keep the branch on ic out of the vectorized ones */
+  if (ic == NULL) {
+    for (uint32_t i = 0U; i < count; i++) {
+      alpha[i] = ia[i];
+      beta[i] = (ia[i] + (2.0f * ib[i])) * INV_SQRT3;
+    }
+  } else {
+    for (uint32_t i = 0U; i < count; i++) {
+      alpha[i] = ia[i];
+      beta[i] = INV_SQRT3 * (ib[i] - ic[i]);
+    }
+  }
+
+  return UTILS_OK;
+}
+
+UtilsError_t park_transform_batch(const float *alpha, const float *beta, const float *theta, float *d, float *q, uint32_t count) {
+  if (alpha == NULL || beta == NULL || theta == NULL || d == NULL || q == NULL) {
+    return UTILS_INVALID_ARGS;
+  }
+
+  for (uint32_t i = 0U; i < count; i++) {
+    float sin_theta, cos_theta;
+    batch_sin_cos(theta[i], &sin_theta, &cos_theta);
+
+    d[i] = alpha[i] * cos_theta + beta[i] * sin_theta;
+    q[i] = -alpha[i] * sin_theta + beta[i] * cos_theta;
+  }
+
+  return UTILS_OK;
+}
+
+UtilsError_t inverse_park_transform_batch(const float *d, const float *q, const float *theta, float *alpha, float *beta,
+                                          uint32_t count) {
+  if (d == NULL || q == NULL || theta == NULL || alpha == NULL || beta == NULL) {
+    return UTILS_INVALID_ARGS;
+  }
+
+  for (uint32_t i = 0U; i < count; i++) {
+    float sin_theta, cos_theta;
+    batch_sin_cos(theta[i], &sin_theta, &cos_theta);
+
+    alpha[i] = d[i] * cos_theta - q[i] * sin_theta;
+    beta[i] = d[i] * sin_theta + q[i] * cos_theta;
+  }
+
+  return UTILS_OK;
+}
+
+UtilsError_t svpwm_generate_batch(const float *theta_e, const float *vref_mag, float *duty_a, float *duty_b, float *duty_c,
+                                  uint32_t count) {
+  if (theta_e == NULL || vref_mag == NULL || duty_a == NULL || duty_b == NULL || duty_c == NULL) {
+    return UTILS_INVALID_ARGS;
+  }
+
+  for (uint32_t i = 0U; i < count; i++) {
+    float sin_theta, cos_theta;
+    batch_sin_cos(theta_e[i], &sin_theta, &cos_theta);
+
+    /* Clamped after the scaling, a multiply left inside the clamp would keep the loop from vectorizing */
+    float amplitude = BATCH_TWO_OVER_THREE * vref_mag[i];
+    amplitude = (amplitude > BATCH_TWO_OVER_THREE) ? BATCH_TWO_OVER_THREE : amplitude;
+    amplitude = (amplitude < 0.0f) ? 0.0f : amplitude;
+
+    /* Phase references 120 degrees apart */
+    float va = amplitude * cos_theta;
+    float vb = amplitude * (-0.5f * cos_theta + SQRT3_OVER_2 * sin_theta);
+    float vc = -va - vb;
+
+    /* Centring the outer two on 0.5 splits the zero vector time evenly, as the sector timings do */
+    float v_max = (va > vb) ? va : vb;
+    float v_min = (va < vb) ? va : vb;
+    v_max = (vc > v_max) ? vc : v_max;
+    v_min = (vc < v_min) ? vc : v_min;
+    float offset = 0.5f - 0.5f * (v_max + v_min);
+
+    duty_a[i] = va + offset;
+    duty_b[i] = vb + offset;
+    duty_c[i] = vc + offset;
+  }
+
+  return UTILS_OK;
+}
@@ -1,11 +1,21 @@
 import ctypes
+import numpy as np
 from pathlib import Path
 
+
+def _float_array(values):
+    """values as contiguous float32, only copied when they are not already, kept alive by the caller while C reads it."""
+    return np.ascontiguousarray(values, dtype=np.float32)
+
+
+def _float_pointer(array):
+    return array.ctypes.data_as(ctypes.POINTER(ctypes.c_float))
+
 class SvpwmTransformInterface:
     def __init__(self, lib_path=None):
         if lib_path is None:
             lib_path = Path(__file__).parent.parent.parent / "build" / "libsvpwm_transform_python_visualizer.so"
-        lib_path = lib_path.resolve()
+        lib_path = Path(lib_path).resolve()
         print(f"Loading SVPWM and Parke/Clarke shared library from: {lib_path}")
 
         self.lib = ctypes.CDLL(str(lib_path))
@@ -47,6 +57,14 @@ class SvpwmTransformInterface:
         ]
         self.lib.inverse_park_transform.restype = ctypes.c_int
 
+        # Array entry points, pointers to count floats each
+        float_p = ctypes.POINTER(ctypes.c_float)
+        for name in ("svpwm_generate_batch", "clarke_transform_batch", "park_transform_batch",
+                     "inverse_park_transform_batch"):
+            function = getattr(self.lib, name)
+            function.argtypes = [float_p] * 5 + [ctypes.c_uint32]
+            function.restype = ctypes.c_int
+
     # SVPWM generation
     def svpwm_generate(self, theta_e, vref_mag):
         dA = ctypes.c_float()
@@ -107,3 +125,30 @@ class SvpwmTransformInterface:
         if err != 0:
             raise RuntimeError(f"Inverse Park transform error code: {err}")
         return alpha.value, beta.value
+
+    def _run_batch(self, function, inputs, num_outputs):
+        # Inputs broadcast against each other, a None input is passed as NULL, one float32 array per result
+        shape = np.broadcast(*[values for values in inputs if values is not None]).shape
+        arrays = [None if values is None else _float_array(np.broadcast_to(values, shape)) for values in inputs]
+        outputs = [np.empty(shape, dtype=np.float32) for _ in range(num_outputs)]
+        pointers = [None if array is None else _float_pointer(array) for array in arrays + outputs]
+        err = function(*pointers, int(np.prod(shape)))
+        if err != 0:
+            raise RuntimeError(f"{function.__name__} error code: {err}")
+        return tuple(outputs)
+
+    # SVPWM generation over arrays of angles and magnitudes
+    def svpwm_generate_batch(self, theta_e, vref_mag):
+        return self._run_batch(self.lib.svpwm_generate_batch, [theta_e, vref_mag], 3)
+
+    # Clarke transform over arrays, 2-phase when ic is None
+    def clarke_batch(self, ia, ib, ic=None):
+        return self._run_batch(self.lib.clarke_transform_batch, [ia, ib, ic], 2)
+
+    # Park transform over arrays
+    def park_batch(self, alpha, beta, theta):
+        return self._run_batch(self.lib.park_transform_batch, [alpha, beta, theta], 2)
+
+    # Inverse Park transform over arrays
+    def inverse_park_batch(self, d, q, theta):
+        return self._run_batch(self.lib.inverse_park_transform_batch, [d, q, theta], 2)
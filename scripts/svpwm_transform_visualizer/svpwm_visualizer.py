@@ -7,15 +7,9 @@ class SVPWMVisualizer:
 
     def run_sweep(self, vref, resolution=360):
         thetas = np.linspace(0, 2*np.pi, resolution)
-        duties_A, duties_B, duties_C = [], [], []
+        duties_A, duties_B, duties_C = self.foc_common.svpwm_generate_batch(thetas, vref)
 
-        for theta in thetas:
-            a, b, c = self.foc_common.svpwm_generate(theta, vref)
-            duties_A.append(a)
-            duties_B.append(b)
-            duties_C.append(c)
-
-        return thetas, np.array(duties_A), np.array(duties_B), np.array(duties_C)
+        return thetas, duties_A, duties_B, duties_C
 
     def plot_phases(self, thetas, duties_A, duties_B, duties_C):
         vbus = 1.0
@@ -0,0 +1,52 @@
+import time
+import numpy as np
+
+
+def _samples_per_second(function, num_samples, repeats):
+    # Best of the repeats, the first run also pays for page faults on the outputs
+    best = float("inf")
+    for _ in range(repeats):
+        start = time.perf_counter()
+        function()
+        best = min(best, time.perf_counter() - start)
+    return num_samples / best
+
+
+def run_benchmark(interface, num_samples=1_000_000, scalar_samples=20_000, repeats=5):
+    """
+    Time each transform through the array entry points against one ctypes call per sample.
+    Returns:
+        {name: (scalar samples/s, batch samples/s)}
+    """
+    rng = np.random.default_rng(0)
+    theta = rng.uniform(0.0, 2.0 * np.pi, num_samples).astype(np.float32)
+    x = rng.normal(0.0, 1.0, num_samples).astype(np.float32)
+    y = rng.normal(0.0, 1.0, num_samples).astype(np.float32)
+    z = -x - y
+    vref = rng.uniform(0.0, 1.0, num_samples).astype(np.float32)
+
+    # The scalar path is slow enough that a slice of the samples gives a stable rate
+    n = min(scalar_samples, num_samples)
+    cases = {
+        "svpwm": (lambda: [interface.svpwm_generate(t, v) for t, v in zip(theta[:n], vref[:n])],
+                  lambda: interface.svpwm_generate_batch(theta, vref)),
+        "clarke 3-phase": (lambda: [interface.clarke_3phase(a, b, c) for a, b, c in zip(x[:n], y[:n], z[:n])],
+                           lambda: interface.clarke_batch(x, y, z)),
+        "clarke 2-phase": (lambda: [interface.clarke_2phase(a, b) for a, b in zip(x[:n], y[:n])],
+                           lambda: interface.clarke_batch(x, y)),
+        "park": (lambda: [interface.park(a, b, t) for a, b, t in zip(x[:n], y[:n], theta[:n])],
+                 lambda: interface.park_batch(x, y, theta)),
+        "inverse park": (lambda: [interface.inverse_park(a, b, t) for a, b, t in zip(x[:n], y[:n], theta[:n])],
+                         lambda: interface.inverse_park_batch(x, y, theta)),
+    }
+
+    results = {}
+    for name, (scalar, batch) in cases.items():
+        results[name] = (_samples_per_second(scalar, n, 1), _samples_per_second(batch, num_samples, repeats))
+    return results
+
+
+def print_benchmark(results):
+    print(f"{'transform':<16}{'scalar (samples/s)':>20}{'batch (samples/s)':>20}{'speedup':>10}")
+    for name, (scalar, batch) in results.items():
+        print(f"{name:<16}{scalar:>20,.0f}{batch:>20,.0f}{batch / scalar:>9.0f}x")
@@ -0,0 +1,138 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   sim_scenarios.h
+ *
+ * @brief  Header file for the closed-loop simulation scenarios
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup SimScenarios Simulation scenarios
+ * @brief    Drivers run against the simulated motor, reporting torque and energy figures
+ * @{
+ */
+
+/**
+ * @brief   Compare immediate and delayed sensorless 6-step commutation
+ * @details Runs the sensorless driver at a fixed voltage and load with commutation on the zero-crossing, 30 degrees
+ *          after it, and 30 degrees after it with speed dependent advance. Prints speed, torque ripple and efficiency
+ * @return  0 if every case reached closed-loop operation
+ */
+int sim_scenario_commutation_timing(void);
+
+/**
+ * @brief   Measure sensorless 6-step zero-crossing detection accuracy across bus voltages
+ * @details Runs the sensorless driver from a 12 V to a 48 V bus with the virtual neutral and the half bus reference.
+ *          Prints the error of every detected zero-crossing against the simulated back-EMF crossing
+ * @return  0 if every case reached closed-loop operation
+ */
+int sim_scenario_zero_crossing_accuracy(void);
+
+/**
+ * @brief   Benchmark the output cost of a 6-step commutation event
+ * @details Times the per-phase commutation table walk the drivers used before against the packed gate states applied
+ *          with hal_pwm_set_gates(). Prints the host time and the number of HAL output writes per commutation
+ * @return  0 once the benchmark has run
+ */
+int sim_scenario_gate_write_cost(void);
+
+/**
+ * @brief   Compare the bridge conduction losses of the 6-step PWM schemes
+ * @details Runs the sensorless driver at a fixed voltage and load with each modulation scheme. Prints the speed, the
+ *          efficiency, the switch and body diode losses and how evenly they spread over the six bridge devices
+ * @return  0 if every scheme reached closed-loop operation, 1 otherwise
+ */
+int sim_scenario_pwm_scheme_losses(void);
+
+/**
+ * @brief   Restart the sensorless 6-step driver on a spinning rotor after a brownout
+ * @details Runs the driver to steady state, floats the bridge for a coast time and re-initializes it, once with the
+ *          startup from standstill and once with the flying start. Prints the time to closed-loop operation, the time
+ *          until the speed is back within 5%, the peak phase current and the lowest speed of the restart
+ * @return  0 if every flying start recovered the speed, 1 otherwise
+ */
+int sim_scenario_flying_start(void);
+
+/**
+ * @brief   Start the sensorless 6-step driver with and without the initial position detection
+ * @details Places a surface and an interior magnet rotor at rest on every cogging detent, shifted by two holding loads,
+ *          and starts it once with the alignment and once with the detection. Prints the detection error, the
+ *          time to closed-loop operation and how far the rotor was pulled backwards
+ * @return  0 if every start reached closed-loop operation and every detection was within 30 electrical degrees without
+ *          turning the rotor backwards, 1 otherwise
+ */
+int sim_scenario_initial_position(void);
+
+/**
+ * @brief   Run point-to-point moves with the sensored and sensorless 6-step position modes
+ * @details Commands a sequence of sensored forward and reverse moves against a constant load, then forward sensorless
+ *          moves from the closed-loop handover. Prints the overshoot and the final error of each move against the
+ *          simulated rotor angle, with the settling time of sensored moves and the arrival speed of sensorless ones
+ * @return  0 if every move ended within one commutation step of its target, 1 otherwise
+ */
+int sim_scenario_position_moves(void);
+
+/**
+ * @brief   Run the sensorless FOC driver across its speed range
+ * @details Starts the motor with the I/f startup, then the speed loop steps through the setpoints against two
+ *          loads. Prints the speed error, the back-EMF PLL angle error against the simulated rotor
+ *          and the d/q currents at each setpoint
+ * @return  0 if every setpoint held its speed within 2% and its angle error within 20 electrical degrees, 1 otherwise
+ */
+int sim_scenario_foc_sensorless_speed_range(void);
+
+/**
+ * @brief   Run the sensored FOC driver on the Hall position source across its speed range
+ * @details Steps the speed loop from standstill through the setpoints against two loads, with the rotor angle
+ *          interpolated between Hall edges. Prints the speed error, the Hall estimator angle error against the
+ *          simulated rotor and the d/q currents at each setpoint
+ * @return  0 if every setpoint held its speed within 2% and its angle error within 20 electrical degrees, 1 otherwise
+ */
+int sim_scenario_foc_sensored_speed_range(void);
+
+/**
+ * @brief   Start the sensorless FOC driver from standstill with the I/f ramp
+ * @details Runs the alignment, the I/f ramp and the handover to the back-EMF PLL observer in both directions against
+ *          several loads, then the speed loop. Prints the time to closed-loop operation, the rotor lag behind the forced
+ *          angle at the lock and the current vector peaks during the ramp and the handover
+ * @return  0 if every case reached its speed within 2% with a handover peak under 1.5 times the ramp current, 1 otherwise
+ */
+int sim_scenario_foc_sensorless_startup(void);
+
+/**
+ * @brief   Restart the sensorless FOC driver on a spinning rotor after a brownout
+ * @details Same brownout as the 6-step flying start scenario, with the speed loop holding 600 RPM. Compares the I/f
+ *          startup with the flying start
+ * @return  0 if every flying start recovered the speed, 1 otherwise
+ */
+int sim_scenario_foc_flying_start(void);
+
+/**
+ * @brief   Run the sensorless FOC driver from standstill on the high-frequency injection observer
+ * @details Aligns an interior magnet rotor and steps the speed loop from standstill through the crossover band to the
+ *          back-EMF observer and back, without load and under load. Prints the speed error, the angle error against the
+ *          simulated rotor and the back-EMF observer weight at each setpoint, then the time per update of both observers
+ * @return  0 if every setpoint held its speed within 2% (5 RPM near standstill) and its angle error within 20 electrical
+ *          degrees, 1 otherwise
+ */
+int sim_scenario_foc_hfi(void);
+
+/**
+ * @brief   Ramp the speed of the sensorless FOC driver with fixed and speed-scheduled PLL gains
+ * @details Ramps the speed loop setpoint between 150 and 1200 RPM at two rates under a light load, with the driver
+ *          default PLL, a bandwidth scheduled on speed and the scheduled type-3 loop. Prints the spread of the back-EMF
+ *          PLL angle error at both held speeds and its mean, largest value and spread over each ramp
+ * @return  0 if every case kept its angle error within 20 electrical degrees, 1 otherwise
+ */
+int sim_scenario_foc_speed_ramp(void);
+
+/** @} */
@@ -0,0 +1,60 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   sim_telemetry.h
+ *
+ * @brief  Header file for streaming simulation telemetry through shared memory
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdint.h>
+
+/* Inter-component Headers */
+#include "hal_sim.h"
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup SimTelemetry Simulation telemetry
+ * @brief    Samples of the motor model published into a telemetry ring in a memory mapped file
+ * @details  The simulation never waits on a reader. Readers map the same file and follow the ring on their own, see
+ *           simulation/scripts/sim_telemetry.py
+ * @{
+ */
+
+#define SIM_TELEMETRY_DEFAULT_CAPACITY 65536U /**< Slots in the ring, 1.3 s of samples at the default period */
+#define SIM_TELEMETRY_DEFAULT_PERIOD_US 20U   /**< Simulated time between samples (us), 50 kHz */
+
+/**
+ * @brief   Frame published for every sample, 52 bytes
+ */
+struct SimTelemetryFrame_t {
+  uint32_t time_us;                /**< Simulation time of the sample (us) */
+  uint32_t scenario;               /**< Index of the running scenario */
+  struct HalSimMotorState_t state; /**< Model state at the sample */
+};
+
+/**
+ * @brief   Create the telemetry file and start publishing samples of the motor model into it
+ * @param   path File to create or truncate, a file in /dev/shm keeps the ring in memory
+ * @param   capacity Number of frames the ring holds
+ * @param   period_us Simulated time between samples (us)
+ * @return  0 if successful, -1 if the file could not be created or mapped
+ */
+int sim_telemetry_open(const char *path, uint32_t capacity, uint32_t period_us);
+
+/**
+ * @brief   Tag the following frames with a scenario
+ * @param   scenario Index of the scenario about to run
+ */
+void sim_telemetry_set_scenario(uint32_t scenario);
+
+/**
+ * @brief   Stop publishing and unmap the file, which stays for readers to finish with
+ */
+void sim_telemetry_close(void);
+
+/** @} */
@@ -0,0 +1,121 @@
+import argparse
+import os
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+import numpy as np
+
+from sim_telemetry import TelemetryReader, DEFAULT_TELEMETRY_PATH, SCENARIO_NAMES
+
+REPO_ROOT = Path(__file__).resolve().parents[2]
+SIM_CANDIDATES = [REPO_ROOT / "build" / "sim_bldc", REPO_ROOT / "_gate_build" / "sim_bldc"]
+
+
+def find_simulator(sim_path):
+    if sim_path is not None:
+        return Path(sim_path).resolve()
+    for candidate in SIM_CANDIDATES:
+        if candidate.exists():
+            return candidate
+    raise FileNotFoundError("sim_bldc not found, build it or pass --sim")
+
+
+def launch_simulator(sim_path, telemetry_path, scenarios, capacity, period_us, quiet=False):
+    """
+    Start sim_bldc streaming into telemetry_path, the old ring is removed so no reader attaches to it.
+    """
+    if os.path.exists(telemetry_path):
+        os.remove(telemetry_path)
+
+    command = [str(sim_path), "--telemetry", telemetry_path, "--telemetry-capacity", str(capacity),
+               "--telemetry-period", str(period_us)] + list(scenarios)
+    return subprocess.Popen(command, stdout=subprocess.DEVNULL if quiet else None)
+
+
+class StreamStats:
+    """
+    Checks on the consumed stream: rate, losses and that simulation time only moves forward.
+    """
+
+    def __init__(self):
+        self.frames = 0
+        self.non_monotonic = 0
+        self.last_time_us = None
+        self.scenario = None
+
+    def update(self, frames):
+        if len(frames) == 0:
+            return
+        times = frames["time_us"].astype(np.int64)
+        self.non_monotonic += int(np.count_nonzero(np.diff(times) <= 0))
+        if self.last_time_us is not None and times[0] <= self.last_time_us:
+            self.non_monotonic += 1
+        self.last_time_us = int(times[-1])
+        self.scenario = int(frames["scenario"][-1])
+        self.frames += len(frames)
+
+
+def run_bridge(args):
+    sim_path = find_simulator(args.sim)
+    process = launch_simulator(sim_path, args.telemetry, args.scenarios, args.capacity, args.period, args.quiet)
+    reader = TelemetryReader(args.telemetry, from_start=True)
+    stats = StreamStats()
+
+    start = time.monotonic()
+    last_report = start
+    last_frames = 0
+
+    try:
+        while True:
+            running = process.poll() is None
+            frames, _ = reader.read_new()
+            stats.update(frames)
+
+            now = time.monotonic()
+            if now - last_report >= args.report_interval:
+                scenario = SCENARIO_NAMES[stats.scenario] if stats.scenario is not None else "-"
+                print(f"[bridge] {scenario:>16}  t={stats.last_time_us or 0:>10} us  "
+                      f"{(stats.frames - last_frames) / (now - last_report) / 1e3:8.1f} kframes/s  "
+                      f"dropped {reader.frames_dropped}  torn {reader.frames_torn}", file=sys.stderr)
+                last_report = now
+                last_frames = stats.frames
+
+            if not running:
+                break
+            time.sleep(args.read_interval)
+    finally:
+        if process.poll() is None:
+            process.terminate()
+        process.wait()
+
+    elapsed = time.monotonic() - start
+    published = reader.write_count()
+    print(f"[bridge] {published} frames published in {elapsed:.2f} s ({published / elapsed / 1e3:.1f} kframes/s)\n"
+          f"[bridge] read {reader.frames_read}, dropped {reader.frames_dropped} (torn {reader.frames_torn}), "
+          f"time steps out of order {stats.non_monotonic}", file=sys.stderr)
+    reader.close()
+
+    consistent = (reader.frames_read + reader.frames_dropped == published) and stats.non_monotonic == 0
+    if not consistent:
+        print("[bridge] stream check failed", file=sys.stderr)
+    return process.returncode or (0 if consistent else 1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run sim_bldc and follow its telemetry through shared memory")
+    parser.add_argument("scenarios", nargs="*", help="Scenarios to run, all of them when none are given")
+    parser.add_argument("--sim", default=None, help="Path of sim_bldc")
+    parser.add_argument("--telemetry", default=DEFAULT_TELEMETRY_PATH, help="Telemetry file")
+    parser.add_argument("--capacity", type=int, default=65536, help="Frames held by the ring")
+    parser.add_argument("--period", type=int, default=20, help="Simulated time between frames (us)")
+    parser.add_argument("--read-interval", type=float, default=0.01,
+                        help="Time between reads (s), raise it to watch a slow reader drop frames without slowing the simulation")
+    parser.add_argument("--report-interval", type=float, default=1.0, help="Time between progress lines (s)")
+    parser.add_argument("--quiet", action="store_true", help="Hide the simulator's own output")
+    sys.exit(run_bridge(parser.parse_args()))
+
+
+if __name__ == "__main__":
+    main()
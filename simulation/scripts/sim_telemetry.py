@@ -0,0 +1,191 @@
+import mmap
+import os
+import time
+import numpy as np
+
+NUM_MOTOR_PHASES = 3
+
+# telemetry_ring.h
+TELEMETRY_RING_MAGIC = 0x5254454A
+TELEMETRY_RING_VERSION = 1
+TELEMETRY_RING_FRAME_OFFSET = 8
+
+# Frame numbers count from 1 and wrap back to 1, 0 marks a slot being written
+FRAME_NUMBER_PERIOD = (1 << 32) - 1
+
+# TelemetryRingHeader_t
+HEADER_DTYPE = np.dtype([
+    ("magic", "<u4"),
+    ("version", "<u4"),
+    ("header_size", "<u4"),
+    ("slot_size", "<u4"),
+    ("frame_size", "<u4"),
+    ("capacity", "<u4"),
+    ("write_count", "<u4"),
+    ("reserved", "<u4"),
+])
+
+# SimTelemetryFrame_t, with HalSimMotorState_t flattened into it
+FRAME_DTYPE = np.dtype([
+    ("time_us", "<u4"),
+    ("scenario", "<u4"),
+    ("rotor_position", "<f4"),
+    ("rotor_velocity", "<f4"),
+    ("phase_currents", "<f4", (NUM_MOTOR_PHASES,)),
+    ("phase_voltages", "<f4", (NUM_MOTOR_PHASES,)),
+    ("torque_electrical", "<f4"),
+    ("dc_current", "<f4"),
+    ("temperature", "<f4"),
+])
+
+DEFAULT_TELEMETRY_PATH = "/dev/shm/jupiter_sim_telemetry"
+
+# sim_bldc scenarios in main.c order, indexed by the frame's scenario field
+SCENARIO_NAMES = ["commutation", "zero-crossing", "gate-write", "pwm-scheme", "flying-start", "initial-position", "position",
+                  "foc-sensorless", "foc-startup", "foc-flying-start", "foc-hfi", "foc-speed-ramp",
+                  "foc-sensored"]
+
+
+def wrap_frame_number(count):
+    """
+    Frame number the producer gives its count-th frame, count from 1.
+    """
+    return (np.asarray(count, dtype=np.int64) - 1) % FRAME_NUMBER_PERIOD + 1
+
+
+class TelemetryReader:
+    """
+    Follows a telemetry ring written by sim_bldc --telemetry, without ever holding up the simulation.
+
+    The ring is viewed in place through the mapping. Each read copies the new slots out with one vectorized gather,
+    between two gathers of their frame numbers, and keeps the slots whose number matched before and after the copy.
+    Frames overwritten before the reader got to them are counted as dropped, those overwritten during the copy as torn too.
+    """
+
+    def __init__(self, path=DEFAULT_TELEMETRY_PATH, timeout=5.0, from_start=False):
+        """
+        Args:
+            path: Telemetry file given to sim_bldc --telemetry
+            timeout: Time to wait for the simulator to create the ring (s)
+            from_start: Read the frames already in the ring rather than only the ones published from now on
+        """
+        self.path = path
+        self._map = self._open(path, timeout)
+        self.header = np.ndarray((), dtype=HEADER_DTYPE, buffer=self._map)
+
+        if int(self.header["frame_size"]) != FRAME_DTYPE.itemsize:
+            raise ValueError(f"{path}: frames of {int(self.header['frame_size'])} bytes, expected {FRAME_DTYPE.itemsize}")
+
+        self.capacity = int(self.header["capacity"])
+        slot_dtype = np.dtype({
+            "names": ["number", "frame"],
+            "formats": ["<u4", FRAME_DTYPE],
+            "offsets": [0, TELEMETRY_RING_FRAME_OFFSET],
+            "itemsize": int(self.header["slot_size"]),
+        })
+        slots = np.ndarray((self.capacity,), dtype=slot_dtype, buffer=self._map, offset=int(self.header["header_size"]))
+        self._numbers = slots["number"]
+        self._frames = slots["frame"]
+
+        # Counts are kept unwrapped, the ring only sees them modulo FRAME_NUMBER_PERIOD
+        self._write_count = int(self.header["write_count"])
+        self._next = 1 if from_start else self._write_count + 1
+        self.frames_read = 0
+        self.frames_dropped = 0
+        self.frames_torn = 0
+
+    @staticmethod
+    def _open(path, timeout):
+        deadline = time.monotonic() + timeout
+        header_size = HEADER_DTYPE.itemsize
+
+        # The simulator creates the file, sizes it and writes the magic last
+        while True:
+            try:
+                with open(path, "rb") as f:
+                    size = os.fstat(f.fileno()).st_size
+                    if size >= header_size:
+                        memory = mmap.mmap(f.fileno(), size, access=mmap.ACCESS_READ)
+                        header = np.frombuffer(memory, dtype=HEADER_DTYPE, count=1)[0]
+                        if header["magic"] == TELEMETRY_RING_MAGIC:
+                            if header["version"] != TELEMETRY_RING_VERSION:
+                                raise ValueError(f"{path}: ring version {int(header['version'])}, expected {TELEMETRY_RING_VERSION}")
+                            if size < int(header["header_size"]) + int(header["capacity"]) * int(header["slot_size"]):
+                                raise ValueError(f"{path}: file shorter than its ring")
+                            return memory
+                        del header
+                        memory.close()
+            except FileNotFoundError:
+                pass
+
+            if time.monotonic() > deadline:
+                raise TimeoutError(f"{path}: no telemetry ring after {timeout} s")
+            time.sleep(0.01)
+
+    def write_count(self):
+        """
+        Unwrapped number of frames published so far.
+        """
+        wrapped = int(self.header["write_count"])
+        if wrapped != 0:
+            self._write_count += (wrapped - 1 - (self._write_count - 1)) % FRAME_NUMBER_PERIOD
+        return self._write_count
+
+    def _gather(self, first, last):
+        """
+        Copy the frames numbered first to last (unwrapped, inclusive) out of the ring.
+        Returns:
+            The frames copied whole, and whether each frame of the range was.
+        """
+        numbers = wrap_frame_number(np.arange(first, last + 1, dtype=np.int64))
+        index = (numbers - 1) % self.capacity
+
+        before = self._numbers[index]
+        frames = self._frames[index]
+        after = self._numbers[index]
+
+        # The producer zeroes a slot's number before writing it, a number unchanged across the copy means a whole frame
+        valid = (before == numbers) & (after == numbers)
+        return frames[valid], valid
+
+    def read_new(self, max_frames=None):
+        """
+        Frames published since the last call, oldest first.
+        Args:
+            max_frames: Most frames to return, the newest ones are kept when more are waiting
+        Returns:
+            Array of FRAME_DTYPE, and the number of frames lost since the last call.
+        """
+        last = self.write_count()
+        first = max(self._next, last - self.capacity + 1)
+        if max_frames is not None:
+            first = max(first, last - max_frames + 1)
+
+        if last < first:
+            return np.empty(0, dtype=FRAME_DTYPE), 0
+
+        frames, valid = self._gather(first, last)
+        torn = int(np.count_nonzero(~valid))
+        dropped = (first - self._next) + torn
+
+        self._next = last + 1
+        self.frames_read += len(frames)
+        self.frames_dropped += dropped
+        self.frames_torn += torn
+        return frames, dropped
+
+    def latest(self, num_frames):
+        """
+        Up to num_frames of the newest frames, oldest first, without moving read_new() along.
+        """
+        last = self.write_count()
+        first = max(1, last - min(num_frames, self.capacity) + 1)
+        if last < first:
+            return np.empty(0, dtype=FRAME_DTYPE)
+        return self._gather(first, last)[0]
+
+    def close(self):
+        self._numbers = None
+        self._frames = None
+        self.header = None
+        self._map.close()
@@ -0,0 +1,81 @@
+import argparse
+import numpy as np
+import matplotlib.pyplot as plt
+from matplotlib.animation import FuncAnimation
+
+from sim_telemetry import TelemetryReader, DEFAULT_TELEMETRY_PATH, SCENARIO_NAMES
+from sim_bridge import find_simulator, launch_simulator
+
+RAD_PER_S_TO_RPM = 60.0 / (2.0 * np.pi)
+MAX_PLOT_POINTS = 2000
+
+
+def run_visualization(args):
+    process = None
+    if args.launch:
+        process = launch_simulator(find_simulator(args.sim), args.telemetry, args.scenarios, args.capacity, args.period,
+                                   quiet=True)
+
+    reader = TelemetryReader(args.telemetry, timeout=args.timeout)
+    window_frames = min(reader.capacity, int(args.window * 1e6 / args.period))
+
+    fig, (ax_speed, ax_current) = plt.subplots(2, 1, figsize=(10, 8), sharex=True)
+    (speed_line,) = ax_speed.plot([], [])
+    current_lines = [ax_current.plot([], [], label=f"Phase {name}")[0] for name in "ABC"]
+
+    ax_speed.set_ylabel("Speed (RPM)")
+    ax_speed.grid()
+    ax_current.set_xlabel("Simulation time (s)")
+    ax_current.set_ylabel("Current (A)")
+    ax_current.grid()
+    ax_current.legend(loc="upper right")
+
+    def update(_):
+        # Only the newest window is drawn, the ring is viewed in place so a slow redraw never holds up the simulation
+        frames = reader.latest(window_frames)
+        if len(frames) == 0:
+            return [speed_line] + current_lines
+
+        frames = frames[::max(1, len(frames) // MAX_PLOT_POINTS)]
+        time_s = frames["time_us"] * 1e-6
+
+        speed_line.set_data(time_s, frames["rotor_velocity"] * RAD_PER_S_TO_RPM)
+        for phase, line in enumerate(current_lines):
+            line.set_data(time_s, frames["phase_currents"][:, phase])
+
+        for axis in (ax_speed, ax_current):
+            axis.relim()
+            axis.autoscale_view()
+        ax_current.set_xlim(time_s[0], max(time_s[-1], time_s[0] + 1e-3))
+
+        scenario = int(frames["scenario"][-1])
+        fig.suptitle(f"{SCENARIO_NAMES[scenario] if scenario < len(SCENARIO_NAMES) else scenario}  "
+                     f"t = {time_s[-1]:.3f} s  ({reader.write_count()} frames)")
+        return [speed_line] + current_lines
+
+    animation = FuncAnimation(fig, update, interval=args.interval, cache_frame_data=False)
+    plt.show()
+
+    del animation
+    reader.close()
+    if process is not None:
+        process.terminate()
+        process.wait()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Live plots of the simulator telemetry")
+    parser.add_argument("scenarios", nargs="*", help="Scenarios to run with --launch, all of them when none are given")
+    parser.add_argument("--launch", action="store_true", help="Start sim_bldc rather than attach to a running one")
+    parser.add_argument("--sim", default=None, help="Path of sim_bldc")
+    parser.add_argument("--telemetry", default=DEFAULT_TELEMETRY_PATH, help="Telemetry file")
+    parser.add_argument("--capacity", type=int, default=65536, help="Frames held by the ring, with --launch")
+    parser.add_argument("--period", type=int, default=20, help="Simulated time between frames (us)")
+    parser.add_argument("--window", type=float, default=0.5, help="Simulated time shown (s)")
+    parser.add_argument("--interval", type=int, default=50, help="Time between redraws (ms)")
+    parser.add_argument("--timeout", type=float, default=30.0, help="Time to wait for the simulator (s)")
+    run_visualization(parser.parse_args())
+
+
+if __name__ == "__main__":
+    main()
@@ -8,12 +8,113 @@
  *******************************************************************************************************************************/
 
 /* Standard library Headers */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 /* Inter-component Headers */
 
 /* Intra-component Headers */
+#include "sim_scenarios.h"
+#include "sim_telemetry.h"
 
-int main(void) {
-  return 0;
-}
\ No newline at end of file
+/**
+ * @brief   Named simulation scenario
+ */
+struct SimScenario_t {
+  const char *name; /**< Command line name */
+  int (*run)(void); /**< Scenario entry point */
+};
+
+static const struct SimScenario_t s_scenarios[] = {
+  { "commutation", sim_scenario_commutation_timing },
+  { "zero-crossing", sim_scenario_zero_crossing_accuracy },
+  { "gate-write", sim_scenario_gate_write_cost },
+  { "pwm-scheme", sim_scenario_pwm_scheme_losses },
+  { "flying-start", sim_scenario_flying_start },
+  { "initial-position", sim_scenario_initial_position },
+  { "position", sim_scenario_position_moves },
+  { "foc-sensorless", sim_scenario_foc_sensorless_speed_range },
+  { "foc-startup", sim_scenario_foc_sensorless_startup },
+  { "foc-flying-start", sim_scenario_foc_flying_start },
+  { "foc-hfi", sim_scenario_foc_hfi },
+  { "foc-speed-ramp", sim_scenario_foc_speed_ramp },
+  { "foc-sensored", sim_scenario_foc_sensored_speed_range },
+};
+
+#define NUM_SIM_SCENARIOS (sizeof(s_scenarios) / sizeof(s_scenarios[0]))
+
+/**
+ * @brief   Command line options
+ */
+struct SimOptions_t {
+  const char *telemetry_path;   /**< File to stream telemetry into, NULL for none */
+  uint32_t telemetry_capacity;  /**< Frames held by the telemetry ring */
+  uint32_t telemetry_period_us; /**< Simulated time between telemetry samples (us) */
+};
+
+/**
+ * @brief   Read the options, given before or between the scenario names
+ * @return  Number of scenario names, moved to the front of argv, or -1 on an unknown option
+ */
+static int parse_options(int argc, char **argv, struct SimOptions_t *options) {
+  int num_scenarios = 0;
+
+  for (int arg = 1; arg < argc; arg++) {
+    const char *value = (arg + 1 < argc) ? argv[arg + 1] : NULL;
+
+    if (strcmp(argv[arg], "--telemetry") == 0 && value != NULL) {
+      options->telemetry_path = value;
+      arg++;
+    } else if (strcmp(argv[arg], "--telemetry-capacity") == 0 && value != NULL) {
+      options->telemetry_capacity = (uint32_t)strtoul(value, NULL, 10);
+      arg++;
+    } else if (strcmp(argv[arg], "--telemetry-period") == 0 && value != NULL) {
+      options->telemetry_period_us = (uint32_t)strtoul(value, NULL, 10);
+      arg++;
+    } else if (strncmp(argv[arg], "--", 2) == 0) {
+      fprintf(stderr, "usage: %s [--telemetry PATH] [--telemetry-capacity FRAMES] [--telemetry-period US] [SCENARIO...]\n", argv[0]);
+      return -1;
+    } else {
+      argv[1 + num_scenarios++] = argv[arg];
+    }
+  }
+
+  return num_scenarios;
+}
+
+int main(int argc, char **argv) {
+  struct SimOptions_t options = { .telemetry_capacity = SIM_TELEMETRY_DEFAULT_CAPACITY, .telemetry_period_us = SIM_TELEMETRY_DEFAULT_PERIOD_US };
+  int num_scenarios = parse_options(argc, argv, &options);
+  int result = 0;
+
+  if (num_scenarios < 0) {
+    return 2;
+  }
+
+  if (options.telemetry_path != NULL &&
+      sim_telemetry_open(options.telemetry_path, options.telemetry_capacity, options.telemetry_period_us) != 0) {
+    return 1;
+  }
+
+  /* Without scenario names every scenario runs */
+  for (size_t i = 0U; i < NUM_SIM_SCENARIOS; i++) {
+    bool is_selected = (num_scenarios == 0);
+
+    for (int arg = 1; arg <= num_scenarios; arg++) {
+      is_selected = is_selected || (strcmp(argv[arg], s_scenarios[i].name) == 0);
+    }
+
+    if (is_selected) {
+      sim_telemetry_set_scenario((uint32_t)i);
+      result |= s_scenarios[i].run();
+    }
+  }
+
+  sim_telemetry_close();
+
+  return result;
+}
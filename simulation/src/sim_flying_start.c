@@ -0,0 +1,253 @@
+/*******************************************************************************************************************************
+ * @file   sim_flying_start.c
+ *
+ * @brief  Source file for the sensorless 6-step flying start scenario
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "bldc_6step_sensorless.h"
+#include "hal.h"
+#include "hal_sim.h"
+#include "math_utils.h"
+#include "motor.h"
+
+/* Intra-component Headers */
+#include "sim_scenarios.h"
+
+#define SIM_CONTROL_PERIOD_US 50U                  /**< Control loop period (us), 20 kHz */
+#define SIM_SPIN_UP_TIMEOUT_US 3000000U            /**< Longest time the first start may take to reach closed-loop (us) */
+#define SIM_SETTLE_TIME_US 2500000U                /**< Closed-loop time before the brownout (us) */
+#define SIM_MEASURE_TIME_US 100000U                /**< Speed measurement window before the brownout (us) */
+#define SIM_RECOVER_TIMEOUT_US 3000000U            /**< Longest restart before the case is failed (us) */
+#define SIM_RECOVER_TOLERANCE 0.05f                /**< Speed error that counts as recovered (fraction of the speed before the brownout) */
+#define SIM_SUPPLY_VOLTAGE 16.0f                   /**< Voltage setpoint (V), as in the commutation scenario */
+#define SIM_VOLTAGE_RAMP_V_PER_TICK 0.001f         /**< Closed-loop voltage ramp (V per control period), 20 V/s */
+#define SIM_CATCH_TIME_US 20000U                   /**< Flying start window (us) */
+#define SIM_LOAD_TORQUE 0.05f                      /**< Load torque of every case (Nm) */
+#define SIM_NOISE_SEED 1U                          /**< Noise seed shared by every case */
+#define SIM_RAD_PER_S_TO_RPM (60.0f / MATH_TWO_PI) /**< Mechanical rad/s to RPM */
+
+/**
+ * @brief   Times the bridge is off before the restart (us)
+ */
+static const uint32_t s_coast_times_us[] = { 10000U, 50000U };
+
+/**
+ * @brief   Restart figures of one case
+ */
+struct SimFlyingStartResult_t {
+  bool is_running;   /**< Closed-loop operation was reached */
+  bool is_recovered; /**< The speed came back within tolerance */
+  float catch_rpm;   /**< Rotor speed when the driver was re-initialized (mechanical RPM) */
+  float restart_ms;  /**< Time from init to closed-loop operation (ms) */
+  float recover_ms;  /**< Time from init until the speed is back within tolerance (ms) */
+  float peak_a;      /**< Largest phase current from init to recovery (A) */
+  float min_rpm;     /**< Lowest rotor speed from init to recovery (mechanical RPM) */
+};
+
+static void prepare_motor_config(struct MotorConfig_t *config) {
+  memset(config, 0, sizeof(*config));
+  config->type = MOTOR_TYPE_BLDC;
+  config->control_method = CONTROL_METHOD_SENSORLESS;
+  config->control_mode = CONTROL_MODE_VOLTAGE;
+  config->pole_pairs = 7U;
+  config->phase_resistance = 0.5f;
+  config->phase_inductance = 0.001f;
+  config->max_current = 40.0f;
+  config->max_voltage = 24.0f;
+  config->max_velocity = 10000.0f;
+  config->current_pid_config.output_min = 0.0f;
+  config->current_pid_config.output_max = 1.0f;
+
+  config->pwm_config.frequency = 20000U;
+  config->pwm_config.dead_time_ns = 500U;
+  config->pwm_config.resolution = 12U;
+  config->pwm_config.complementary_output = true;
+
+  config->adc_config.sampling_freq = 20000U;
+  config->adc_config.resolution = 12U;
+  config->adc_config.v_ref = 3.3f;
+  config->adc_config.current_gain = 0.1f;
+  config->adc_config.voltage_gain = 0.1f;
+}
+
+static void prepare_startup_config(struct BLDC6StepStartupConfig_t *startup_config) {
+  startup_config->align_duty = 0.1f;
+  startup_config->align_time_us = 100000U;
+  startup_config->initial_period_us = 20000U;
+  startup_config->final_period_us = 4000U;
+  startup_config->acceleration_factor = 0.98f;
+  startup_config->initial_duty = 0.1f;
+  startup_config->duty_increment = 0.0012f;
+  startup_config->num_steps = 150U;
+  startup_config->transition_timeout_us = 200000U;
+}
+
+static bool init_motor(struct Motor_t *motor, struct MotorConfig_t *config, bool is_flying_start) {
+  struct BLDC6StepStartupConfig_t startup_config;
+  struct BLDC6StepFlyingStartConfig_t flying_start_config = { .enabled = is_flying_start, .catch_time_us = SIM_CATCH_TIME_US };
+
+  prepare_startup_config(&startup_config);
+  bldc_6step_sensorless_set_startup_config(&startup_config);
+  bldc_6step_sensorless_set_flying_start_config(&flying_start_config);
+  bldc_6step_sensorless_create_driver(motor);
+
+  return motor->driver.init(motor, config) == MOTOR_OK;
+}
+
+/* The voltage setpoint takes over from the startup duty once closed-loop and ramps to the target */
+static bool run_period(struct Motor_t *motor, float *voltage) {
+  const struct BLDC6StepSensorlessData_t *bldc_data = (const struct BLDC6StepSensorlessData_t *)motor->private_data;
+
+  if (bldc_data->mode == MOTOR_MODE_RUNNING) {
+    if (*voltage < 0.0f) {
+      *voltage = bldc_data->pwm_duty * motor->config->max_voltage;
+    }
+    *voltage = fminf(*voltage + SIM_VOLTAGE_RAMP_V_PER_TICK, SIM_SUPPLY_VOLTAGE);
+    motor->driver.set_voltage(motor, *voltage);
+  }
+
+  if (motor_run(motor) != MOTOR_OK) {
+    return false;
+  }
+
+  hal_sim_advance_us(SIM_CONTROL_PERIOD_US);
+  return true;
+}
+
+/* Starts from standstill, settles and returns the mean speed before the brownout (mechanical rad/s) */
+static bool spin_up(struct Motor_t *motor, struct MotorConfig_t *config, float *speed) {
+  struct HalSimStats_t stats;
+  float voltage = -1.0f;
+
+  if (!init_motor(motor, config, false)) {
+    return false;
+  }
+
+  const struct BLDC6StepSensorlessData_t *bldc_data = (const struct BLDC6StepSensorlessData_t *)motor->private_data;
+
+  for (uint32_t elapsed = 0U; bldc_data->mode != MOTOR_MODE_RUNNING; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (elapsed >= SIM_SPIN_UP_TIMEOUT_US || !run_period(motor, &voltage)) {
+      return false;
+    }
+  }
+
+  for (uint32_t elapsed = 0U; elapsed < SIM_SETTLE_TIME_US + SIM_MEASURE_TIME_US; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (elapsed == SIM_SETTLE_TIME_US) {
+      hal_sim_reset_stats();
+    }
+
+    if (!run_period(motor, &voltage)) {
+      return false;
+    }
+  }
+
+  hal_sim_get_stats(&stats);
+  *speed = (stats.duration_s > 0.0f) ? (stats.velocity_integral / stats.duration_s) : 0.0f;
+
+  return bldc_data->mode == MOTOR_MODE_RUNNING;
+}
+
+/* Drops the bridge for the coast time, restarts the driver and times the recovery of the speed */
+static void restart(struct Motor_t *motor, struct MotorConfig_t *config, uint32_t coast_us, bool is_flying_start, float speed,
+                    struct SimFlyingStartResult_t *result) {
+  float voltage = -1.0f;
+
+  motor->driver.deinit(motor);
+  hal_sim_advance_us(coast_us);
+
+  result->catch_rpm = hal_encoder_get_velocity() * SIM_RAD_PER_S_TO_RPM;
+  result->min_rpm = result->catch_rpm;
+
+  if (!init_motor(motor, config, is_flying_start)) {
+    return;
+  }
+
+  const struct BLDC6StepSensorlessData_t *bldc_data = (const struct BLDC6StepSensorlessData_t *)motor->private_data;
+
+  for (uint32_t elapsed = SIM_CONTROL_PERIOD_US; elapsed <= SIM_RECOVER_TIMEOUT_US; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (!run_period(motor, &voltage)) {
+      return;
+    }
+
+    for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+      result->peak_a = fmaxf(result->peak_a, fabsf(motor->state.phase_currents[phase]));
+    }
+
+    float velocity = hal_encoder_get_velocity();
+    result->min_rpm = fminf(result->min_rpm, velocity * SIM_RAD_PER_S_TO_RPM);
+
+    if (!result->is_running && bldc_data->mode == MOTOR_MODE_RUNNING) {
+      result->is_running = true;
+      result->restart_ms = (float)elapsed / 1000.0f;
+    }
+
+    if (result->is_running && fabsf(velocity - speed) <= SIM_RECOVER_TOLERANCE * speed) {
+      result->is_recovered = true;
+      result->recover_ms = (float)elapsed / 1000.0f;
+      return;
+    }
+  }
+}
+
+static int run_restart_case(uint32_t coast_us, bool is_flying_start) {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct SimFlyingStartResult_t result;
+  const char *start_name = is_flying_start ? "flying" : "standstill";
+  float speed = 0.0f;
+
+  memset(&motor, 0, sizeof(motor));
+  memset(&result, 0, sizeof(result));
+  prepare_motor_config(&config);
+
+  hal_sim_restart();
+  hal_sim_set_noise_seed(SIM_NOISE_SEED);
+  hal_sim_set_load_torque(SIM_LOAD_TORQUE);
+
+  if (!spin_up(&motor, &config, &speed)) {
+    printf("%-8.0f %-11s did not reach closed-loop operation before the brownout FAIL\n", (float)coast_us / 1000.0f, start_name);
+    motor.driver.deinit(&motor);
+    return 1;
+  }
+
+  restart(&motor, &config, coast_us, is_flying_start, speed, &result);
+  motor.driver.deinit(&motor);
+
+  /* The startup from standstill is the baseline, only the flying start has to recover */
+  bool is_passing = result.is_recovered || !is_flying_start;
+
+  if (result.is_recovered) {
+    printf("%-8.0f %-11s %9.1f %10.1f %10.1f %8.2f %9.1f\n", (float)coast_us / 1000.0f, start_name, result.catch_rpm, result.restart_ms,
+           result.recover_ms, result.peak_a, result.min_rpm);
+  } else {
+    printf("%-8.0f %-11s %9.1f %10s %10s %8.2f %9.1f %s\n", (float)coast_us / 1000.0f, start_name, result.catch_rpm,
+           result.is_running ? "running" : "stalled", "-", result.peak_a, result.min_rpm, is_passing ? "" : "FAIL");
+  }
+
+  return is_passing ? 0 : 1;
+}
+
+int sim_scenario_flying_start(void) {
+  int result = 0;
+
+  hal_sim_set_verbose(false);
+
+  printf("Sensorless 6-step restart after a brownout: %.1f V, %.3f Nm load\n", SIM_SUPPLY_VOLTAGE, SIM_LOAD_TORQUE);
+  printf("%-8s %-11s %9s %10s %10s %8s %9s\n", "coast_ms", "start", "catch_rpm", "restart_ms", "recover_ms", "peak_a", "min_rpm");
+
+  for (size_t i = 0U; i < sizeof(s_coast_times_us) / sizeof(s_coast_times_us[0]); i++) {
+    result |= run_restart_case(s_coast_times_us[i], false);
+    result |= run_restart_case(s_coast_times_us[i], true);
+  }
+
+  return result;
+}
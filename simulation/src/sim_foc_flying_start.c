@@ -0,0 +1,236 @@
+/*******************************************************************************************************************************
+ * @file   sim_foc_flying_start.c
+ *
+ * @brief  Source file for the sensorless FOC flying start scenario
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "foc_sensorless.h"
+#include "hal.h"
+#include "hal_sim.h"
+#include "math_utils.h"
+#include "motor.h"
+
+/* Intra-component Headers */
+#include "sim_scenarios.h"
+
+#define SIM_CONTROL_PERIOD_US 50U                  /**< Control loop period (us), 20 kHz */
+#define SIM_SPIN_UP_TIMEOUT_US 3000000U            /**< Longest time the first start may take to reach closed-loop (us) */
+#define SIM_SETTLE_TIME_US 500000U                 /**< Closed-loop time before the brownout (us) */
+#define SIM_MEASURE_TIME_US 100000U                /**< Speed measurement window before the brownout (us) */
+#define SIM_RECOVER_TIMEOUT_US 3000000U            /**< Longest restart before the case is failed (us) */
+#define SIM_RECOVER_TOLERANCE 0.05f                /**< Speed error that counts as recovered (fraction of the speed before the brownout) */
+#define SIM_TARGET_RPM 600.0f                      /**< Speed setpoint (mechanical RPM), as in the startup scenario */
+#define SIM_POLE_PAIRS 7U                          /**< Pole pairs of the simulated motor */
+#define SIM_LOAD_TORQUE 0.05f                      /**< Load torque of every case (Nm) */
+#define SIM_NOISE_SEED 1U                          /**< Noise seed shared by every case */
+#define SIM_RAD_PER_S_TO_RPM (60.0f / MATH_TWO_PI) /**< Mechanical rad/s to RPM */
+
+/**
+ * @brief   Times the bridge is off before the restart (us)
+ */
+static const uint32_t s_coast_times_us[] = { 10000U, 50000U };
+
+/**
+ * @brief   Restart figures of one case
+ */
+struct SimFlyingStartResult_t {
+  bool is_running;   /**< Closed-loop operation was reached */
+  bool is_recovered; /**< The speed came back within tolerance */
+  float catch_rpm;   /**< Rotor speed when the driver was re-initialized (mechanical RPM) */
+  float restart_ms;  /**< Time from init to closed-loop operation (ms) */
+  float recover_ms;  /**< Time from init until the speed is back within tolerance (ms) */
+  float peak_a;      /**< Largest phase current from init to recovery (A) */
+  float min_rpm;     /**< Lowest rotor speed from init to recovery (mechanical RPM) */
+};
+
+static void prepare_motor_config(struct MotorConfig_t *config) {
+  memset(config, 0, sizeof(*config));
+  config->type = MOTOR_TYPE_PMSM;
+  config->control_method = CONTROL_METHOD_FOC;
+  config->control_mode = CONTROL_MODE_VELOCITY;
+  config->pole_pairs = SIM_POLE_PAIRS;
+  config->phase_resistance = 0.5f;
+  config->phase_inductance = 0.001f;
+  config->max_current = 40.0f;
+  config->max_voltage = 24.0f;
+  config->max_velocity = 200.0f;
+  config->torque_constant = 0.15f;
+
+  /* Speed error (mechanical rad/s) to a q-axis current (A), about 150 rad/s of bandwidth on the rotor inertia */
+  config->velocity_pid_config.kp = 0.1f;
+  config->velocity_pid_config.ki = 2.0f;
+  config->velocity_pid_config.output_min = -10.0f;
+  config->velocity_pid_config.output_max = 10.0f;
+
+  config->pwm_config.frequency = 20000U;
+  config->pwm_config.dead_time_ns = 500U;
+  config->pwm_config.resolution = 12U;
+  config->pwm_config.complementary_output = true;
+
+  config->adc_config.sampling_freq = 20000U;
+  config->adc_config.resolution = 12U;
+  config->adc_config.v_ref = 3.3f;
+  config->adc_config.current_gain = 0.1f;
+  config->adc_config.voltage_gain = 0.1f;
+}
+
+static bool init_motor(struct Motor_t *motor, struct MotorConfig_t *config, bool is_flying_start) {
+  struct FOCSensorlessFlyingStartConfig_t flying_start_config = {
+    .enabled = is_flying_start,
+    .catch_time_us = FOC_SENSORLESS_DEFAULT_CATCH_TIME_US,
+    .min_bemf = FOC_SENSORLESS_DEFAULT_CATCH_MIN_BEMF,
+  };
+
+  foc_sensorless_set_flying_start_config(&flying_start_config);
+  foc_sensorless_create_driver(motor, OBSERVER_TYPE_BACKEMF_PLL);
+
+  if (motor->driver.init(motor, config) != MOTOR_OK) {
+    return false;
+  }
+
+  return motor->driver.set_velocity(motor, SIM_TARGET_RPM / SIM_RAD_PER_S_TO_RPM) == MOTOR_OK;
+}
+
+static bool run_period(struct Motor_t *motor) {
+  if (motor_run(motor) != MOTOR_OK) {
+    return false;
+  }
+
+  hal_sim_advance_us(SIM_CONTROL_PERIOD_US);
+  return true;
+}
+
+/* Starts from standstill, settles and returns the mean speed before the brownout (mechanical rad/s) */
+static bool spin_up(struct Motor_t *motor, struct MotorConfig_t *config, float *speed) {
+  struct HalSimStats_t stats;
+
+  if (!init_motor(motor, config, false)) {
+    return false;
+  }
+
+  const struct FOCSensorlessData_t *foc_data = (const struct FOCSensorlessData_t *)motor->private_data;
+
+  for (uint32_t elapsed = 0U; foc_data->mode != MOTOR_MODE_RUNNING; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (elapsed >= SIM_SPIN_UP_TIMEOUT_US || !run_period(motor)) {
+      return false;
+    }
+  }
+
+  for (uint32_t elapsed = 0U; elapsed < SIM_SETTLE_TIME_US + SIM_MEASURE_TIME_US; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (elapsed == SIM_SETTLE_TIME_US) {
+      hal_sim_reset_stats();
+    }
+
+    if (!run_period(motor)) {
+      return false;
+    }
+  }
+
+  hal_sim_get_stats(&stats);
+  *speed = (stats.duration_s > 0.0f) ? (stats.velocity_integral / stats.duration_s) : 0.0f;
+
+  return foc_data->mode == MOTOR_MODE_RUNNING;
+}
+
+/* Drops the bridge for the coast time, restarts the driver and times the recovery of the speed */
+static void restart(struct Motor_t *motor, struct MotorConfig_t *config, uint32_t coast_us, bool is_flying_start, float speed,
+                    struct SimFlyingStartResult_t *result) {
+  motor->driver.deinit(motor);
+  hal_sim_advance_us(coast_us);
+
+  result->catch_rpm = hal_encoder_get_velocity() * SIM_RAD_PER_S_TO_RPM;
+  result->min_rpm = result->catch_rpm;
+
+  if (!init_motor(motor, config, is_flying_start)) {
+    return;
+  }
+
+  const struct FOCSensorlessData_t *foc_data = (const struct FOCSensorlessData_t *)motor->private_data;
+
+  for (uint32_t elapsed = SIM_CONTROL_PERIOD_US; elapsed <= SIM_RECOVER_TIMEOUT_US; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (!run_period(motor)) {
+      return;
+    }
+
+    for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+      result->peak_a = fmaxf(result->peak_a, fabsf(motor->state.phase_currents[phase]));
+    }
+
+    float velocity = hal_encoder_get_velocity();
+    result->min_rpm = fminf(result->min_rpm, velocity * SIM_RAD_PER_S_TO_RPM);
+
+    if (!result->is_running && foc_data->mode == MOTOR_MODE_RUNNING) {
+      result->is_running = true;
+      result->restart_ms = (float)elapsed / 1000.0f;
+    }
+
+    if (result->is_running && fabsf(velocity - speed) <= SIM_RECOVER_TOLERANCE * speed) {
+      result->is_recovered = true;
+      result->recover_ms = (float)elapsed / 1000.0f;
+      return;
+    }
+  }
+}
+
+static int run_restart_case(uint32_t coast_us, bool is_flying_start) {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct SimFlyingStartResult_t result;
+  const char *start_name = is_flying_start ? "flying" : "standstill";
+  float speed = 0.0f;
+
+  memset(&motor, 0, sizeof(motor));
+  memset(&result, 0, sizeof(result));
+  prepare_motor_config(&config);
+
+  hal_sim_restart();
+  hal_sim_set_noise_seed(SIM_NOISE_SEED);
+  hal_sim_set_load_torque(SIM_LOAD_TORQUE);
+
+  if (!spin_up(&motor, &config, &speed)) {
+    printf("%-8.0f %-11s did not reach closed-loop operation before the brownout FAIL\n", (float)coast_us / 1000.0f, start_name);
+    motor.driver.deinit(&motor);
+    return 1;
+  }
+
+  restart(&motor, &config, coast_us, is_flying_start, speed, &result);
+  motor.driver.deinit(&motor);
+
+  /* The startup from standstill is the baseline, only the flying start has to recover */
+  bool is_passing = result.is_recovered || !is_flying_start;
+
+  if (result.is_recovered) {
+    printf("%-8.0f %-11s %9.1f %10.1f %10.1f %8.2f %9.1f\n", (float)coast_us / 1000.0f, start_name, result.catch_rpm, result.restart_ms,
+           result.recover_ms, result.peak_a, result.min_rpm);
+  } else {
+    printf("%-8.0f %-11s %9.1f %10s %10s %8.2f %9.1f %s\n", (float)coast_us / 1000.0f, start_name, result.catch_rpm,
+           result.is_running ? "running" : "stalled", "-", result.peak_a, result.min_rpm, is_passing ? "" : "FAIL");
+  }
+
+  return is_passing ? 0 : 1;
+}
+
+int sim_scenario_foc_flying_start(void) {
+  int result = 0;
+
+  hal_sim_set_verbose(false);
+
+  printf("Sensorless FOC restart after a brownout: %.0f RPM, %.3f Nm load\n", SIM_TARGET_RPM, SIM_LOAD_TORQUE);
+  printf("%-8s %-11s %9s %10s %10s %8s %9s\n", "coast_ms", "start", "catch_rpm", "restart_ms", "recover_ms", "peak_a", "min_rpm");
+
+  for (size_t i = 0U; i < sizeof(s_coast_times_us) / sizeof(s_coast_times_us[0]); i++) {
+    result |= run_restart_case(s_coast_times_us[i], false);
+    result |= run_restart_case(s_coast_times_us[i], true);
+  }
+
+  return result;
+}
@@ -0,0 +1,339 @@
+/*******************************************************************************************************************************
+ * @file   sim_foc_hfi.c
+ *
+ * @brief  Source file for the sensorless FOC high-frequency injection scenario
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* Inter-component Headers */
+#include "backemf_pll_observer.h"
+#include "foc_sensorless.h"
+#include "hal.h"
+#include "hal_sim.h"
+#include "hfi_observer.h"
+#include "math_utils.h"
+#include "motor.h"
+
+/* Intra-component Headers */
+#include "sim_scenarios.h"
+
+#define SIM_CONTROL_PERIOD_US 50U                  /**< Control loop period (us), 20 kHz */
+#define SIM_STEP_TIME_US 600000U                   /**< Time spent at each speed setpoint (us) */
+#define SIM_MEASURE_TIME_US 300000U                /**< Measurement window at the end of each setpoint (us) */
+#define SIM_POLE_PAIRS 7U                          /**< Pole pairs of the simulated motor */
+#define SIM_INDUCTANCE_D 0.0008f                   /**< d-axis inductance of the interior magnet rotor (H) */
+#define SIM_INDUCTANCE_Q 0.0012f                   /**< q-axis inductance of the interior magnet rotor (H) */
+#define SIM_SATURATION 0.3f                        /**< d-axis inductance lost to saturation */
+#define SIM_START_POSITION 0.3f                    /**< Mechanical rest angle of the rotor before the alignment (rad) */
+#define SIM_NOISE_SEED 1U                          /**< Noise seed shared by every case */
+#define SIM_SPEED_TOLERANCE 0.02f                  /**< Largest accepted mean speed error (fraction of the setpoint) */
+#define SIM_SPEED_TOLERANCE_RPM 5.0f               /**< Largest accepted mean speed error at and near standstill (RPM) */
+#define SIM_ANGLE_TOLERANCE_DEG 20.0f              /**< Largest accepted observer angle error (electrical degrees) */
+#define SIM_BENCHMARK_UPDATES 1000000U             /**< Observer updates timed per observer */
+#define SIM_BENCHMARK_SPEED 150.0f                 /**< Electrical speed of the synthetic benchmark input, inside the crossover band (rad/s) */
+#define SIM_RAD_PER_S_TO_RPM (60.0f / MATH_TWO_PI) /**< Mechanical rad/s to RPM */
+#define SIM_RAD_TO_DEG (180.0f / MATH_PI)          /**< Radians to degrees */
+
+/**
+ * @brief   Speed setpoints of each case (mechanical RPM), from standstill through the crossover band and back
+ */
+static const float s_speed_setpoints_rpm[] = { 0.0f, 20.0f, 60.0f, 180.0f, 400.0f, 180.0f, 20.0f, 0.0f };
+
+/**
+ * @brief   Load torques of each case (Nm), applied once the speed loop has taken over from the alignment
+ */
+static const float s_load_torques[] = { 0.0f, 0.1f };
+
+/**
+ * @brief   Observer and speed loop figures of one setpoint
+ */
+struct SimFocHfiStep_t {
+  float speed_rpm;        /**< Mean rotor speed over the measurement window (mechanical RPM) */
+  float angle_error_mean; /**< Mean observer angle error (electrical degrees) */
+  float angle_error_max;  /**< Largest absolute observer angle error (electrical degrees) */
+  float blend;            /**< Mean weight of the back-EMF observer */
+  float iq_mean;          /**< Mean q-axis current (A) */
+};
+
+static void prepare_motor_config(struct MotorConfig_t *config) {
+  memset(config, 0, sizeof(*config));
+  config->type = MOTOR_TYPE_PMSM;
+  config->control_method = CONTROL_METHOD_FOC;
+  config->control_mode = CONTROL_MODE_CURRENT;
+  config->pole_pairs = SIM_POLE_PAIRS;
+  config->phase_resistance = 0.5f;
+  config->phase_inductance = 0.5f * (SIM_INDUCTANCE_D + SIM_INDUCTANCE_Q);
+  config->max_current = 40.0f;
+  config->max_voltage = 24.0f;
+  config->max_velocity = 200.0f;
+  config->torque_constant = 0.15f;
+
+  /* Speed error (mechanical rad/s) to a q-axis current (A), as in the back-EMF speed range scenario */
+  config->velocity_pid_config.kp = 0.1f;
+  config->velocity_pid_config.ki = 2.0f;
+  config->velocity_pid_config.output_min = -10.0f;
+  config->velocity_pid_config.output_max = 10.0f;
+
+  config->pwm_config.frequency = 20000U;
+  config->pwm_config.dead_time_ns = 500U;
+  config->pwm_config.resolution = 12U;
+  config->pwm_config.complementary_output = true;
+
+  config->adc_config.sampling_freq = 20000U;
+  config->adc_config.resolution = 12U;
+  config->adc_config.v_ref = 3.3f;
+  config->adc_config.current_gain = 0.1f;
+  config->adc_config.voltage_gain = 0.1f;
+}
+
+static void prepare_hfi_config(struct HFIObserverConfig_t *hfi_config) {
+  memset(hfi_config, 0, sizeof(*hfi_config));
+  hfi_config->pll_cfg.kp = FOC_SENSORLESS_DEFAULT_HFI_PLL_KP;
+  hfi_config->pll_cfg.ki = FOC_SENSORLESS_DEFAULT_HFI_PLL_KI;
+  hfi_config->pll_cfg.max_omega = FOC_SENSORLESS_DEFAULT_PLL_MAX_OMEGA;
+  hfi_config->injection_voltage = FOC_SENSORLESS_DEFAULT_HFI_INJECTION_VOLTAGE;
+  hfi_config->Ld = SIM_INDUCTANCE_D;
+  hfi_config->Lq = SIM_INDUCTANCE_Q;
+  hfi_config->crossover_low = FOC_SENSORLESS_DEFAULT_HFI_CROSSOVER_LOW;
+  hfi_config->crossover_high = FOC_SENSORLESS_DEFAULT_HFI_CROSSOVER_HIGH;
+}
+
+static void prepare_backemf_config(struct BackEMFPLLConfig_t *backemf_config) {
+  memset(backemf_config, 0, sizeof(*backemf_config));
+  backemf_config->pll_cfg.kp = FOC_SENSORLESS_DEFAULT_PLL_KP;
+  backemf_config->pll_cfg.ki = FOC_SENSORLESS_DEFAULT_PLL_KI;
+  backemf_config->pll_cfg.max_omega = FOC_SENSORLESS_DEFAULT_PLL_MAX_OMEGA;
+  backemf_config->Rs = 0.5f;
+  backemf_config->Ls = 0.5f * (SIM_INDUCTANCE_D + SIM_INDUCTANCE_Q);
+  backemf_config->min_speed = FOC_SENSORLESS_DEFAULT_OBSERVER_MIN_SPEED;
+  backemf_config->max_speed = FOC_SENSORLESS_DEFAULT_PLL_MAX_OMEGA;
+}
+
+/* The simulated phase A back-EMF is Ke * w * sin(theta_e), which puts the rotor flux (d-axis) at theta_e + pi */
+static float observer_angle_error_deg(const struct FOCSensorlessData_t *foc_data) {
+  float true_angle = normalize_angle(hal_encoder_get_position() * (float)SIM_POLE_PAIRS + MATH_PI);
+  float error = normalize_angle(foc_data->electrical_angle - true_angle + MATH_PI) - MATH_PI;
+
+  return error * SIM_RAD_TO_DEG;
+}
+
+static bool run_motor(struct Motor_t *motor, uint32_t duration_us) {
+  for (uint32_t elapsed = 0U; elapsed < duration_us; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (motor_run(motor) != MOTOR_OK) {
+      return false;
+    }
+    hal_sim_advance_us(SIM_CONTROL_PERIOD_US);
+  }
+
+  return true;
+}
+
+static bool run_speed_step(struct Motor_t *motor, float setpoint_rpm, struct SimFocHfiStep_t *step) {
+  const struct FOCSensorlessData_t *foc_data = (const struct FOCSensorlessData_t *)motor->private_data;
+  struct HalSimStats_t stats;
+  uint32_t samples = 0U;
+  float angle_error_sum = 0.0f;
+
+  memset(step, 0, sizeof(*step));
+  motor->driver.set_velocity(motor, setpoint_rpm / SIM_RAD_PER_S_TO_RPM);
+
+  if (!run_motor(motor, SIM_STEP_TIME_US - SIM_MEASURE_TIME_US)) {
+    return false;
+  }
+
+  hal_sim_reset_stats();
+
+  for (uint32_t elapsed = 0U; elapsed < SIM_MEASURE_TIME_US; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (motor_run(motor) != MOTOR_OK) {
+      return false;
+    }
+
+    float angle_error = observer_angle_error_deg(foc_data);
+    float blend = 0.0f;
+
+    foc_observer_hfi_get_blend(&foc_data->observer, &blend);
+
+    angle_error_sum += angle_error;
+    step->angle_error_max = fmaxf(step->angle_error_max, fabsf(angle_error));
+    step->blend += blend;
+    step->iq_mean += foc_data->iq;
+    samples++;
+
+    hal_sim_advance_us(SIM_CONTROL_PERIOD_US);
+  }
+
+  hal_sim_get_stats(&stats);
+
+  step->speed_rpm = (stats.duration_s > 0.0f) ? (stats.velocity_integral / stats.duration_s) * SIM_RAD_PER_S_TO_RPM : 0.0f;
+  step->angle_error_mean = angle_error_sum / (float)samples;
+  step->blend /= (float)samples;
+  step->iq_mean /= (float)samples;
+
+  return true;
+}
+
+static int run_load_case(float load_torque) {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct HFIObserverConfig_t hfi_config;
+  int result = 0;
+
+  memset(&motor, 0, sizeof(motor));
+  prepare_motor_config(&config);
+  prepare_hfi_config(&hfi_config);
+
+  hal_sim_restart();
+  hal_sim_set_noise_seed(SIM_NOISE_SEED);
+  hal_sim_set_saliency(SIM_INDUCTANCE_D, SIM_INDUCTANCE_Q, SIM_SATURATION);
+  hal_sim_set_rotor_position(SIM_START_POSITION);
+
+  foc_sensorless_set_hfi_config(&hfi_config);
+  foc_sensorless_create_driver(&motor, OBSERVER_TYPE_HFI);
+
+  if (motor.driver.init(&motor, &config) != MOTOR_OK) {
+    printf("%-8.3f sensorless FOC driver failed to start\n", load_torque);
+    return 1;
+  }
+
+  /* The alignment hands over to the speed loop at standstill */
+  const struct FOCSensorlessData_t *foc_data = (const struct FOCSensorlessData_t *)motor.private_data;
+  bool is_started = motor.driver.set_velocity(&motor, 0.0f) == MOTOR_OK;
+
+  while (is_started && foc_data->mode != MOTOR_MODE_RUNNING) {
+    is_started = run_motor(&motor, SIM_CONTROL_PERIOD_US);
+  }
+
+  if (!is_started) {
+    printf("%-8.3f sensorless FOC alignment failed\n", load_torque);
+    motor.driver.deinit(&motor);
+    return 1;
+  }
+
+  /* An alignment current ramping up from zero cannot hold a rotor the load is already turning */
+  hal_sim_set_load_torque(load_torque);
+
+  for (size_t i = 0U; i < sizeof(s_speed_setpoints_rpm) / sizeof(s_speed_setpoints_rpm[0]); i++) {
+    struct SimFocHfiStep_t step;
+
+    if (!run_speed_step(&motor, s_speed_setpoints_rpm[i], &step)) {
+      printf("%-8.3f %10.0f fault\n", load_torque, s_speed_setpoints_rpm[i]);
+      result = 1;
+      break;
+    }
+
+    float speed_error = step.speed_rpm - s_speed_setpoints_rpm[i];
+    float speed_tolerance = fmaxf(SIM_SPEED_TOLERANCE * s_speed_setpoints_rpm[i], SIM_SPEED_TOLERANCE_RPM);
+    bool is_passing = (fabsf(speed_error) <= speed_tolerance) && (step.angle_error_max <= SIM_ANGLE_TOLERANCE_DEG);
+
+    if (!is_passing) {
+      result = 1;
+    }
+
+    printf("%-8.3f %10.0f %10.1f %10.2f %10.2f %10.2f %8.2f %8.3f %s\n", load_torque, s_speed_setpoints_rpm[i], step.speed_rpm,
+           speed_error, step.angle_error_mean, step.angle_error_max, step.blend, step.iq_mean, is_passing ? "" : "FAIL");
+  }
+
+  motor.driver.deinit(&motor);
+
+  return result;
+}
+
+/* Feeds an observer the voltage of an unloaded rotor at the benchmark speed and times its updates */
+static double time_observer_updates(struct FOCObserver_t *observer) {
+  const float dt = (float)SIM_CONTROL_PERIOD_US / 1000000.0f;
+  const float flux_linkage = 0.1f / (float)SIM_POLE_PAIRS;
+  float theta = 0.0f;
+  float theta_out, omega_out;
+
+  observer->driver.init(observer);
+
+  clock_t start = clock();
+
+  for (uint32_t i = 0U; i < SIM_BENCHMARK_UPDATES; i++) {
+    theta = normalize_angle(theta + SIM_BENCHMARK_SPEED * dt);
+
+    /* The small current ripple keeps the carrier path exercised */
+    float ripple = (i & 1U) ? 0.05f : -0.05f;
+    observer->driver.update(observer, -flux_linkage * SIM_BENCHMARK_SPEED * sinf(theta), flux_linkage * SIM_BENCHMARK_SPEED * cosf(theta),
+                            ripple, 0.0f, dt, &theta_out, &omega_out);
+  }
+
+  clock_t end = clock();
+
+  return 1.0e9 * (double)(end - start) / (double)CLOCKS_PER_SEC / (double)SIM_BENCHMARK_UPDATES;
+}
+
+/* The synthetic input costs the same for both observers, it is timed alone and taken off */
+static double time_input_generation(void) {
+  const float dt = (float)SIM_CONTROL_PERIOD_US / 1000000.0f;
+  volatile float sink = 0.0f;
+  float theta = 0.0f;
+
+  clock_t start = clock();
+
+  for (uint32_t i = 0U; i < SIM_BENCHMARK_UPDATES; i++) {
+    theta = normalize_angle(theta + SIM_BENCHMARK_SPEED * dt);
+    sink = sinf(theta) + cosf(theta);
+  }
+
+  clock_t end = clock();
+  (void)sink;
+
+  return 1.0e9 * (double)(end - start) / (double)CLOCKS_PER_SEC / (double)SIM_BENCHMARK_UPDATES;
+}
+
+static void report_update_cost(void) {
+  struct FOCObserver_t observer;
+  struct BackEMFPLLConfig_t backemf_config;
+  struct HFIObserverConfig_t hfi_config;
+
+  prepare_backemf_config(&backemf_config);
+  prepare_hfi_config(&hfi_config);
+
+  /* Both crossovers are moved above the benchmark speed, so the injection path runs next to the back-EMF observer */
+  hfi_config.crossover_low = 2.0f * SIM_BENCHMARK_SPEED;
+  hfi_config.crossover_high = 4.0f * SIM_BENCHMARK_SPEED;
+
+  double input_ns = time_input_generation();
+
+  memset(&observer, 0, sizeof(observer));
+  foc_observer_backemf_pll_create_driver(&observer, &backemf_config);
+  double backemf_ns = time_observer_updates(&observer) - input_ns;
+
+  memset(&observer, 0, sizeof(observer));
+  foc_observer_hfi_create_driver(&observer, &hfi_config, &backemf_config);
+  double hfi_ns = time_observer_updates(&observer) - input_ns;
+
+  printf("\nObserver update cost on this host, %u updates\n", (unsigned)SIM_BENCHMARK_UPDATES);
+  printf("%-18s %14s\n", "observer", "ns_per_update");
+  printf("%-18s %14.2f\n", "backemf-pll", backemf_ns);
+  printf("%-18s %14.2f\n", "hfi+backemf-pll", hfi_ns);
+}
+
+int sim_scenario_foc_hfi(void) {
+  int result = 0;
+
+  hal_sim_set_verbose(false);
+
+  printf("Sensorless FOC (high-frequency injection observer) from standstill on an interior magnet rotor, Ld %.1f mH, Lq %.1f mH\n",
+         SIM_INDUCTANCE_D * 1000.0f, SIM_INDUCTANCE_Q * 1000.0f);
+  printf("Angle errors in electrical degrees, blend is the back-EMF observer weight\n");
+  printf("%-8s %10s %10s %10s %10s %10s %8s %8s\n", "load_nm", "set_rpm", "speed_rpm", "speed_err", "angle_err", "angle_max", "blend",
+         "iq_a");
+
+  for (size_t i = 0U; i < sizeof(s_load_torques) / sizeof(s_load_torques[0]); i++) {
+    result |= run_load_case(s_load_torques[i]);
+  }
+
+  report_update_cost();
+
+  return result;
+}
@@ -0,0 +1,221 @@
+/*******************************************************************************************************************************
+ * @file   sim_foc_sensorless.c
+ *
+ * @brief  Source file for the sensorless FOC speed range scenario
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "foc_sensorless.h"
+#include "hal.h"
+#include "hal_sim.h"
+#include "math_utils.h"
+#include "motor.h"
+
+/* Intra-component Headers */
+#include "sim_scenarios.h"
+
+#define SIM_CONTROL_PERIOD_US 50U                  /**< Control loop period (us), 20 kHz */
+#define SIM_STARTUP_TIMEOUT_US 2000000U            /**< Longest I/f startup before the case is failed (us) */
+#define SIM_STEP_TIME_US 600000U                   /**< Time spent at each speed setpoint (us) */
+#define SIM_MEASURE_TIME_US 300000U                /**< Measurement window at the end of each setpoint (us) */
+#define SIM_POLE_PAIRS 7U                          /**< Pole pairs of the simulated motor */
+#define SIM_NOISE_SEED 1U                          /**< Noise seed shared by every case */
+#define SIM_SPEED_TOLERANCE 0.02f                  /**< Largest accepted mean speed error (fraction of the setpoint) */
+#define SIM_ANGLE_TOLERANCE_DEG 20.0f              /**< Largest accepted observer angle error (electrical degrees) */
+#define SIM_RAD_PER_S_TO_RPM (60.0f / MATH_TWO_PI) /**< Mechanical rad/s to RPM */
+#define SIM_RAD_TO_DEG (180.0f / MATH_PI)          /**< Radians to degrees */
+
+/**
+ * @brief   Speed setpoints of each case (mechanical RPM), from a 1 V back-EMF up to the bus limit of the 24 V supply
+ */
+static const float s_speed_setpoints_rpm[] = { 150.0f, 300.0f, 600.0f, 900.0f, 1200.0f };
+
+/**
+ * @brief   Load torques of each case (Nm), applied once the observer has locked
+ */
+static const float s_load_torques[] = { 0.02f, 0.1f };
+
+/**
+ * @brief   Observer and speed loop figures of one setpoint
+ */
+struct SimFocSensorlessStep_t {
+  float speed_rpm;         /**< Mean rotor speed over the measurement window (mechanical RPM) */
+  float angle_error_mean;  /**< Mean observer angle error (electrical degrees) */
+  float angle_error_max;   /**< Largest absolute observer angle error (electrical degrees) */
+  float id_mean;           /**< Mean d-axis current, negative once field weakening acts (A) */
+  float iq_mean;           /**< Mean q-axis current (A) */
+};
+
+static void prepare_motor_config(struct MotorConfig_t *config) {
+  memset(config, 0, sizeof(*config));
+  config->type = MOTOR_TYPE_PMSM;
+  config->control_method = CONTROL_METHOD_FOC;
+  config->control_mode = CONTROL_MODE_CURRENT;
+  config->pole_pairs = SIM_POLE_PAIRS;
+  config->phase_resistance = 0.5f;
+  config->phase_inductance = 0.001f;
+  config->max_current = 40.0f;
+  config->max_voltage = 24.0f;
+  config->max_velocity = 200.0f;
+  config->torque_constant = 0.15f;
+
+  /* Speed error (mechanical rad/s) to a q-axis current (A), about 150 rad/s of bandwidth on the rotor inertia */
+  config->velocity_pid_config.kp = 0.1f;
+  config->velocity_pid_config.ki = 2.0f;
+  config->velocity_pid_config.output_min = -10.0f;
+  config->velocity_pid_config.output_max = 10.0f;
+
+  config->pwm_config.frequency = 20000U;
+  config->pwm_config.dead_time_ns = 500U;
+  config->pwm_config.resolution = 12U;
+  config->pwm_config.complementary_output = true;
+
+  config->adc_config.sampling_freq = 20000U;
+  config->adc_config.resolution = 12U;
+  config->adc_config.v_ref = 3.3f;
+  config->adc_config.current_gain = 0.1f;
+  config->adc_config.voltage_gain = 0.1f;
+}
+
+/* The simulated phase A back-EMF is Ke * w * sin(theta_e), which puts the rotor flux (d-axis) at theta_e + pi */
+static float observer_angle_error_deg(const struct FOCSensorlessData_t *foc_data) {
+  float true_angle = normalize_angle(hal_encoder_get_position() * (float)SIM_POLE_PAIRS + MATH_PI);
+  float error = normalize_angle(foc_data->electrical_angle - true_angle + MATH_PI) - MATH_PI;
+
+  return error * SIM_RAD_TO_DEG;
+}
+
+static bool run_motor(struct Motor_t *motor, uint32_t duration_us) {
+  for (uint32_t elapsed = 0U; elapsed < duration_us; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (motor_run(motor) != MOTOR_OK) {
+      return false;
+    }
+    hal_sim_advance_us(SIM_CONTROL_PERIOD_US);
+  }
+
+  return true;
+}
+
+static bool run_speed_step(struct Motor_t *motor, float setpoint_rpm, struct SimFocSensorlessStep_t *step) {
+  const struct FOCSensorlessData_t *foc_data = (const struct FOCSensorlessData_t *)motor->private_data;
+  struct HalSimStats_t stats;
+  uint32_t samples = 0U;
+  float angle_error_sum = 0.0f;
+
+  memset(step, 0, sizeof(*step));
+  motor->driver.set_velocity(motor, setpoint_rpm / SIM_RAD_PER_S_TO_RPM);
+
+  if (!run_motor(motor, SIM_STEP_TIME_US - SIM_MEASURE_TIME_US)) {
+    return false;
+  }
+
+  hal_sim_reset_stats();
+
+  for (uint32_t elapsed = 0U; elapsed < SIM_MEASURE_TIME_US; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (motor_run(motor) != MOTOR_OK) {
+      return false;
+    }
+
+    float angle_error = observer_angle_error_deg(foc_data);
+
+    angle_error_sum += angle_error;
+    step->angle_error_max = fmaxf(step->angle_error_max, fabsf(angle_error));
+    step->id_mean += foc_data->id;
+    step->iq_mean += foc_data->iq;
+    samples++;
+
+    hal_sim_advance_us(SIM_CONTROL_PERIOD_US);
+  }
+
+  hal_sim_get_stats(&stats);
+
+  step->speed_rpm = (stats.duration_s > 0.0f) ? (stats.velocity_integral / stats.duration_s) * SIM_RAD_PER_S_TO_RPM : 0.0f;
+  step->angle_error_mean = angle_error_sum / (float)samples;
+  step->id_mean /= (float)samples;
+  step->iq_mean /= (float)samples;
+
+  return true;
+}
+
+static int run_load_case(float load_torque) {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  int result = 0;
+
+  memset(&motor, 0, sizeof(motor));
+  prepare_motor_config(&config);
+
+  hal_sim_restart();
+  hal_sim_set_noise_seed(SIM_NOISE_SEED);
+
+  foc_sensorless_create_driver(&motor, OBSERVER_TYPE_BACKEMF_PLL);
+
+  if (motor.driver.init(&motor, &config) != MOTOR_OK) {
+    printf("%-8.3f sensorless FOC driver failed to start\n", load_torque);
+    return 1;
+  }
+
+  /* Unloaded I/f startup, the speed loop takes over at the first setpoint */
+  const struct FOCSensorlessData_t *foc_data = (const struct FOCSensorlessData_t *)motor.private_data;
+  bool is_started = motor.driver.set_velocity(&motor, s_speed_setpoints_rpm[0] / SIM_RAD_PER_S_TO_RPM) == MOTOR_OK;
+
+  for (uint32_t elapsed = 0U; is_started && foc_data->mode != MOTOR_MODE_RUNNING; elapsed += SIM_CONTROL_PERIOD_US) {
+    is_started = (elapsed < SIM_STARTUP_TIMEOUT_US) && run_motor(&motor, SIM_CONTROL_PERIOD_US);
+  }
+
+  if (!is_started) {
+    printf("%-8.3f sensorless FOC startup failed\n", load_torque);
+    motor.driver.deinit(&motor);
+    return 1;
+  }
+
+  hal_sim_set_load_torque(load_torque);
+
+  for (size_t i = 0U; i < sizeof(s_speed_setpoints_rpm) / sizeof(s_speed_setpoints_rpm[0]); i++) {
+    struct SimFocSensorlessStep_t step;
+
+    if (!run_speed_step(&motor, s_speed_setpoints_rpm[i], &step)) {
+      printf("%-8.3f %10.0f fault\n", load_torque, s_speed_setpoints_rpm[i]);
+      result = 1;
+      break;
+    }
+
+    float speed_error = (step.speed_rpm - s_speed_setpoints_rpm[i]) / s_speed_setpoints_rpm[i];
+    bool is_passing = (fabsf(speed_error) <= SIM_SPEED_TOLERANCE) && (step.angle_error_max <= SIM_ANGLE_TOLERANCE_DEG);
+
+    if (!is_passing) {
+      result = 1;
+    }
+
+    printf("%-8.3f %10.0f %10.1f %9.2f%% %10.2f %10.2f %8.3f %8.3f %s\n", load_torque, s_speed_setpoints_rpm[i], step.speed_rpm,
+           speed_error * 100.0f, step.angle_error_mean, step.angle_error_max, step.id_mean, step.iq_mean, is_passing ? "" : "FAIL");
+  }
+
+  motor.driver.deinit(&motor);
+
+  return result;
+}
+
+int sim_scenario_foc_sensorless_speed_range(void) {
+  int result = 0;
+
+  hal_sim_set_verbose(false);
+
+  printf("Sensorless FOC (back-EMF PLL observer) speed range, angle errors in electrical degrees\n");
+  printf("%-8s %10s %10s %10s %10s %10s %8s %8s\n", "load_nm", "set_rpm", "speed_rpm", "speed_err", "angle_err", "angle_max", "id_a",
+         "iq_a");
+
+  for (size_t i = 0U; i < sizeof(s_load_torques) / sizeof(s_load_torques[0]); i++) {
+    result |= run_load_case(s_load_torques[i]);
+  }
+
+  return result;
+}
@@ -0,0 +1,269 @@
+/*******************************************************************************************************************************
+ * @file   sim_foc_speed_ramp.c
+ *
+ * @brief  Source file for the sensorless FOC speed ramp tracking scenario
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "foc_sensorless.h"
+#include "hal.h"
+#include "hal_sim.h"
+#include "math_utils.h"
+#include "motor.h"
+#include "pll.h"
+
+/* Intra-component Headers */
+#include "sim_scenarios.h"
+
+#define SIM_CONTROL_PERIOD_US 50U                  /**< Control loop period (us), 20 kHz */
+#define SIM_STARTUP_TIMEOUT_US 2000000U            /**< Longest I/f startup before the case is failed (us) */
+#define SIM_SETTLE_TIME_US 500000U                 /**< Time at a setpoint before it is measured or left (us) */
+#define SIM_HOLD_TIME_US 300000U                   /**< Measurement window at a held setpoint (us) */
+#define SIM_LOW_SPEED_RPM 150.0f                   /**< Setpoint the ramps start and end at (mechanical RPM) */
+#define SIM_HIGH_SPEED_RPM 1200.0f                 /**< Setpoint the ramps reach (mechanical RPM) */
+#define SIM_LOAD_TORQUE 0.02f                      /**< Load torque, applied once the observer has locked (Nm) */
+#define SIM_POLE_PAIRS 7U                          /**< Pole pairs of the simulated motor */
+#define SIM_NOISE_SEED 1U                          /**< Noise seed shared by every case */
+#define SIM_ANGLE_TOLERANCE_DEG 20.0f              /**< Largest accepted observer angle error (electrical degrees) */
+#define SIM_RAD_PER_S_TO_RPM (60.0f / MATH_TWO_PI) /**< Mechanical rad/s to RPM */
+#define SIM_RAD_TO_DEG (180.0f / MATH_PI)          /**< Radians to degrees */
+
+/**
+ * @brief   Setpoint ramp rates of each case (mechanical RPM/s)
+ */
+static const float s_ramp_rates_rpm_per_s[] = { 5000.0f, 20000.0f };
+
+/**
+ * @brief   Bandwidth against electrical speed
+ * @details The driver default where the back-EMF is small against the current noise, twice it at the top of the range
+ */
+static const struct PLLGainPoint_t s_gain_schedule[] = {
+  { 100.0f, 300.0f },
+  { 900.0f, 600.0f },
+};
+
+/**
+ * @brief   PLL of a case
+ */
+struct SimPLLCase_t {
+  const char *name;        /**< Printed name */
+  bool is_scheduled;       /**< Gains follow s_gain_schedule, the driver defaults otherwise */
+  bool track_acceleration; /**< Type-3 loop */
+};
+
+static const struct SimPLLCase_t s_pll_cases[] = {
+  { "fixed", false, false },
+  { "scheduled", true, false },
+  { "scheduled-t3", true, true },
+};
+
+/**
+ * @brief   Observer angle error over a stretch of the run
+ */
+struct SimAngleError_t {
+  float sum;       /**< Sum of the errors (electrical degrees) */
+  float sum_sq;    /**< Sum of the squared errors (electrical degrees^2) */
+  float max;       /**< Largest absolute error (electrical degrees) */
+  uint32_t count;  /**< Samples */
+};
+
+static void prepare_motor_config(struct MotorConfig_t *config) {
+  memset(config, 0, sizeof(*config));
+  config->type = MOTOR_TYPE_PMSM;
+  config->control_method = CONTROL_METHOD_FOC;
+  config->control_mode = CONTROL_MODE_CURRENT;
+  config->pole_pairs = SIM_POLE_PAIRS;
+  config->phase_resistance = 0.5f;
+  config->phase_inductance = 0.001f;
+  config->max_current = 40.0f;
+  config->max_voltage = 24.0f;
+  config->max_velocity = 200.0f;
+  config->torque_constant = 0.15f;
+
+  /* Speed error (mechanical rad/s) to a q-axis current (A), about 150 rad/s of bandwidth on the rotor inertia */
+  config->velocity_pid_config.kp = 0.1f;
+  config->velocity_pid_config.ki = 2.0f;
+  config->velocity_pid_config.output_min = -10.0f;
+  config->velocity_pid_config.output_max = 10.0f;
+
+  config->pwm_config.frequency = 20000U;
+  config->pwm_config.dead_time_ns = 500U;
+  config->pwm_config.resolution = 12U;
+  config->pwm_config.complementary_output = true;
+
+  config->adc_config.sampling_freq = 20000U;
+  config->adc_config.resolution = 12U;
+  config->adc_config.v_ref = 3.3f;
+  config->adc_config.current_gain = 0.1f;
+  config->adc_config.voltage_gain = 0.1f;
+}
+
+/* The sensorless driver defaults, with the gain schedule of the case. Rs and Ls are filled in at init */
+static void prepare_backemf_config(struct BackEMFPLLConfig_t *backemf_config, const struct SimPLLCase_t *pll_case) {
+  memset(backemf_config, 0, sizeof(*backemf_config));
+  backemf_config->pll_cfg.kp = FOC_SENSORLESS_DEFAULT_PLL_KP;
+  backemf_config->pll_cfg.ki = FOC_SENSORLESS_DEFAULT_PLL_KI;
+  backemf_config->pll_cfg.max_omega = FOC_SENSORLESS_DEFAULT_PLL_MAX_OMEGA;
+  backemf_config->min_speed = FOC_SENSORLESS_DEFAULT_OBSERVER_MIN_SPEED;
+  backemf_config->max_speed = FOC_SENSORLESS_DEFAULT_PLL_MAX_OMEGA;
+
+  if (pll_case->is_scheduled) {
+    backemf_config->pll_cfg.gain_schedule = s_gain_schedule;
+    backemf_config->pll_cfg.num_gain_points = (uint8_t)(sizeof(s_gain_schedule) / sizeof(s_gain_schedule[0]));
+  }
+  backemf_config->pll_cfg.track_acceleration = pll_case->track_acceleration;
+}
+
+/* The simulated phase A back-EMF is Ke * w * sin(theta_e), which puts the rotor flux (d-axis) at theta_e + pi */
+static float observer_angle_error_deg(const struct FOCSensorlessData_t *foc_data) {
+  float true_angle = normalize_angle(hal_encoder_get_position() * (float)SIM_POLE_PAIRS + MATH_PI);
+  float error = normalize_angle(foc_data->electrical_angle - true_angle + MATH_PI) - MATH_PI;
+
+  return error * SIM_RAD_TO_DEG;
+}
+
+/* Runs for the duration, moving the setpoint towards target_rpm at rate_rpm_per_s. A NULL error skips the measurement */
+static bool run_motor(struct Motor_t *motor, float *setpoint_rpm, float target_rpm, float rate_rpm_per_s, uint32_t duration_us,
+                      struct SimAngleError_t *error) {
+  const struct FOCSensorlessData_t *foc_data = (const struct FOCSensorlessData_t *)motor->private_data;
+  float step_rpm = rate_rpm_per_s * ((float)SIM_CONTROL_PERIOD_US / 1000000.0f);
+
+  for (uint32_t elapsed = 0U; elapsed < duration_us; elapsed += SIM_CONTROL_PERIOD_US) {
+    *setpoint_rpm = (target_rpm > *setpoint_rpm) ? fminf(*setpoint_rpm + step_rpm, target_rpm)
+                                                 : fmaxf(*setpoint_rpm - step_rpm, target_rpm);
+    motor->driver.set_velocity(motor, *setpoint_rpm / SIM_RAD_PER_S_TO_RPM);
+
+    if (motor_run(motor) != MOTOR_OK) {
+      return false;
+    }
+
+    if (error != NULL) {
+      float angle_error = observer_angle_error_deg(foc_data);
+
+      error->sum += angle_error;
+      error->sum_sq += angle_error * angle_error;
+      error->max = fmaxf(error->max, fabsf(angle_error));
+      error->count++;
+    }
+
+    hal_sim_advance_us(SIM_CONTROL_PERIOD_US);
+  }
+
+  return true;
+}
+
+/* Ramp to the target, measured from the start of the ramp until the setpoint has been reached */
+static bool run_ramp(struct Motor_t *motor, float *setpoint_rpm, float target_rpm, float rate_rpm_per_s,
+                     struct SimAngleError_t *error) {
+  uint32_t ramp_us = (uint32_t)(fabsf(target_rpm - *setpoint_rpm) / rate_rpm_per_s * 1000000.0f);
+
+  memset(error, 0, sizeof(*error));
+
+  return run_motor(motor, setpoint_rpm, target_rpm, rate_rpm_per_s, ramp_us, error) &&
+         run_motor(motor, setpoint_rpm, target_rpm, rate_rpm_per_s, SIM_SETTLE_TIME_US, NULL);
+}
+
+static bool run_hold(struct Motor_t *motor, float *setpoint_rpm, struct SimAngleError_t *error) {
+  memset(error, 0, sizeof(*error));
+
+  return run_motor(motor, setpoint_rpm, *setpoint_rpm, 0.0f, SIM_HOLD_TIME_US, error);
+}
+
+static float angle_error_mean(const struct SimAngleError_t *error) {
+  return (error->count > 0U) ? (error->sum / (float)error->count) : 0.0f;
+}
+
+/* Spread about the mean, the noise the PLL lets through */
+static float angle_error_deviation(const struct SimAngleError_t *error) {
+  float mean = angle_error_mean(error);
+  float variance = (error->count > 0U) ? (error->sum_sq / (float)error->count - mean * mean) : 0.0f;
+
+  return (variance > 0.0f) ? sqrtf(variance) : 0.0f;
+}
+
+static int run_ramp_case(const struct SimPLLCase_t *pll_case, float rate_rpm_per_s) {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BackEMFPLLConfig_t backemf_config;
+  struct SimAngleError_t hold_low, ramp_up, hold_high, ramp_down;
+  float setpoint_rpm = SIM_LOW_SPEED_RPM;
+
+  memset(&motor, 0, sizeof(motor));
+  prepare_motor_config(&config);
+  prepare_backemf_config(&backemf_config, pll_case);
+
+  hal_sim_restart();
+  hal_sim_set_noise_seed(SIM_NOISE_SEED);
+
+  foc_sensorless_set_backemf_pll_config(&backemf_config);
+  foc_sensorless_create_driver(&motor, OBSERVER_TYPE_BACKEMF_PLL);
+
+  if (motor.driver.init(&motor, &config) != MOTOR_OK) {
+    printf("%-13s %8.0f sensorless FOC driver failed to start\n", pll_case->name, rate_rpm_per_s);
+    return 1;
+  }
+
+  /* Unloaded I/f startup, the speed loop takes over at the low setpoint */
+  const struct FOCSensorlessData_t *foc_data = (const struct FOCSensorlessData_t *)motor.private_data;
+  bool is_running = motor.driver.set_velocity(&motor, setpoint_rpm / SIM_RAD_PER_S_TO_RPM) == MOTOR_OK;
+
+  for (uint32_t elapsed = 0U; is_running && foc_data->mode != MOTOR_MODE_RUNNING; elapsed += SIM_CONTROL_PERIOD_US) {
+    is_running = (elapsed < SIM_STARTUP_TIMEOUT_US) && run_motor(&motor, &setpoint_rpm, setpoint_rpm, 0.0f, SIM_CONTROL_PERIOD_US, NULL);
+  }
+
+  hal_sim_set_load_torque(SIM_LOAD_TORQUE);
+
+  is_running = is_running && run_motor(&motor, &setpoint_rpm, setpoint_rpm, 0.0f, SIM_SETTLE_TIME_US, NULL) &&
+               run_hold(&motor, &setpoint_rpm, &hold_low) &&
+               run_ramp(&motor, &setpoint_rpm, SIM_HIGH_SPEED_RPM, rate_rpm_per_s, &ramp_up) &&
+               run_hold(&motor, &setpoint_rpm, &hold_high) &&
+               run_ramp(&motor, &setpoint_rpm, SIM_LOW_SPEED_RPM, rate_rpm_per_s, &ramp_down);
+
+  motor.driver.deinit(&motor);
+
+  if (!is_running) {
+    printf("%-13s %8.0f fault\n", pll_case->name, rate_rpm_per_s);
+    return 1;
+  }
+
+  bool is_passing = fmaxf(fmaxf(hold_low.max, ramp_up.max), fmaxf(hold_high.max, ramp_down.max)) <= SIM_ANGLE_TOLERANCE_DEG;
+
+  printf("%-13s %8.0f %9.2f %8.2f %8.2f %8.2f %9.2f %8.2f %8.2f %8.2f %s\n", pll_case->name, rate_rpm_per_s,
+         angle_error_deviation(&hold_low), angle_error_deviation(&hold_high), angle_error_mean(&ramp_up), ramp_up.max,
+         angle_error_mean(&ramp_down), ramp_down.max, angle_error_deviation(&ramp_up), angle_error_deviation(&ramp_down),
+         is_passing ? "" : "FAIL");
+
+  return is_passing ? 0 : 1;
+}
+
+int sim_scenario_foc_speed_ramp(void) {
+  int result = 0;
+  struct BackEMFPLLConfig_t backemf_config;
+
+  hal_sim_set_verbose(false);
+
+  printf("Sensorless FOC (back-EMF PLL observer) speed ramps %.0f <-> %.0f RPM under %.2f Nm, angle errors in electrical degrees\n",
+         SIM_LOW_SPEED_RPM, SIM_HIGH_SPEED_RPM, SIM_LOAD_TORQUE);
+  printf("%-13s %8s %9s %8s %8s %8s %9s %8s %8s %8s\n", "pll", "rpm_s", "low_dev", "high_dev", "up_mean", "up_max", "down_mean",
+         "down_max", "up_dev", "down_dev");
+
+  for (size_t i = 0U; i < sizeof(s_pll_cases) / sizeof(s_pll_cases[0]); i++) {
+    for (size_t j = 0U; j < sizeof(s_ramp_rates_rpm_per_s) / sizeof(s_ramp_rates_rpm_per_s[0]); j++) {
+      result |= run_ramp_case(&s_pll_cases[i], s_ramp_rates_rpm_per_s[j]);
+    }
+  }
+
+  /* The driver keeps the configuration, the scenarios after this one expect its defaults */
+  prepare_backemf_config(&backemf_config, &s_pll_cases[0]);
+  foc_sensorless_set_backemf_pll_config(&backemf_config);
+
+  return result;
+}
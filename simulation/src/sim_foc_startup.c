@@ -0,0 +1,236 @@
+/*******************************************************************************************************************************
+ * @file   sim_foc_startup.c
+ *
+ * @brief  Source file for the sensorless FOC I/f startup scenario
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "foc_sensorless.h"
+#include "hal.h"
+#include "hal_sim.h"
+#include "math_utils.h"
+#include "motor.h"
+
+/* Intra-component Headers */
+#include "sim_scenarios.h"
+
+#define SIM_CONTROL_PERIOD_US 50U                  /**< Control loop period (us), 20 kHz */
+#define SIM_STARTUP_TIMEOUT_US 2000000U            /**< Longest startup before the case is failed (us) */
+#define SIM_HANDOVER_WINDOW_US 50000U              /**< Closed-loop time after the handover still counted for the peak current (us) */
+#define SIM_SETTLE_TIME_US 500000U                 /**< Closed-loop time before the speed is measured (us) */
+#define SIM_MEASURE_TIME_US 200000U                /**< Speed measurement window (us) */
+#define SIM_TARGET_RPM 600.0f                      /**< Closed-loop speed setpoint magnitude (mechanical RPM) */
+#define SIM_POLE_PAIRS 7U                          /**< Pole pairs of the simulated motor */
+#define SIM_NOISE_SEED 1U                          /**< Noise seed shared by every case */
+#define SIM_SPEED_TOLERANCE 0.02f                  /**< Largest accepted mean speed error (fraction of the setpoint) */
+#define SIM_HANDOVER_PEAK_RATIO 1.5f               /**< Largest accepted handover current peak (multiple of the ramp current) */
+#define SIM_RAD_PER_S_TO_RPM (60.0f / MATH_TWO_PI) /**< Mechanical rad/s to RPM */
+#define SIM_RAD_TO_DEG (180.0f / MATH_PI)          /**< Radians to degrees */
+
+/**
+ * @brief   Load torques of each case (Nm), applied from the start of the I/f ramp
+ */
+static const float s_load_torques[] = { 0.0f, 0.05f, 0.1f, 0.2f };
+
+/**
+ * @brief   Directions each load case is started in, the load always opposes the rotation
+ */
+static const float s_directions[] = { 1.0f, -1.0f };
+
+/**
+ * @brief   Startup figures of one load case
+ */
+struct SimFocStartupCase_t {
+  bool is_running;      /**< Closed-loop operation was reached */
+  float closed_loop_ms; /**< Time from init to closed-loop operation (ms) */
+  float lock_ms;        /**< Time from the start of the I/f ramp to the observer lock (ms) */
+  float load_angle_deg; /**< Lag of the rotor behind the forced angle when the observer locked (electrical degrees) */
+  float ramp_peak_a;    /**< Largest current vector amplitude during the I/f ramp (A) */
+  float handover_peak_a;/**< Largest current vector amplitude from the lock to the end of the handover window (A) */
+  float speed_rpm;      /**< Mean closed-loop speed once settled (mechanical RPM) */
+};
+
+static void prepare_motor_config(struct MotorConfig_t *config) {
+  memset(config, 0, sizeof(*config));
+  config->type = MOTOR_TYPE_PMSM;
+  config->control_method = CONTROL_METHOD_FOC;
+  config->control_mode = CONTROL_MODE_VELOCITY;
+  config->pole_pairs = SIM_POLE_PAIRS;
+  config->phase_resistance = 0.5f;
+  config->phase_inductance = 0.001f;
+  config->max_current = 40.0f;
+  config->max_voltage = 24.0f;
+  config->max_velocity = 200.0f;
+  config->torque_constant = 0.15f;
+
+  /* Speed error (mechanical rad/s) to a q-axis current (A), about 150 rad/s of bandwidth on the rotor inertia */
+  config->velocity_pid_config.kp = 0.1f;
+  config->velocity_pid_config.ki = 2.0f;
+  config->velocity_pid_config.output_min = -10.0f;
+  config->velocity_pid_config.output_max = 10.0f;
+
+  config->pwm_config.frequency = 20000U;
+  config->pwm_config.dead_time_ns = 500U;
+  config->pwm_config.resolution = 12U;
+  config->pwm_config.complementary_output = true;
+
+  config->adc_config.sampling_freq = 20000U;
+  config->adc_config.resolution = 12U;
+  config->adc_config.v_ref = 3.3f;
+  config->adc_config.current_gain = 0.1f;
+  config->adc_config.voltage_gain = 0.1f;
+}
+
+/* The simulated phase A back-EMF is Ke * w * sin(theta_e), which puts the rotor flux (d-axis) at theta_e + pi */
+static float rotor_flux_angle(void) {
+  return normalize_angle(hal_encoder_get_position() * (float)SIM_POLE_PAIRS + MATH_PI);
+}
+
+static float current_amplitude(const struct FOCSensorlessData_t *foc_data) {
+  return sqrtf(foc_data->i_alpha * foc_data->i_alpha + foc_data->i_beta * foc_data->i_beta);
+}
+
+static bool run_startup(struct Motor_t *motor, float load_torque, struct SimFocStartupCase_t *result) {
+  const struct FOCSensorlessData_t *foc_data = (const struct FOCSensorlessData_t *)motor->private_data;
+  uint32_t ramp_start = 0U;
+  uint32_t running_start = 0U;
+  FOCMotorMode_t last_mode = foc_data->mode;
+
+  for (uint32_t elapsed = 0U; elapsed < SIM_STARTUP_TIMEOUT_US; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (motor_run(motor) != MOTOR_OK) {
+      return false;
+    }
+
+    if (foc_data->mode != last_mode) {
+      if (foc_data->mode == MOTOR_MODE_OPEN_LOOP) {
+        /* The simulated load is an active torque that would back-drive the rotor while the alignment current builds */
+        hal_sim_set_load_torque(load_torque);
+        ramp_start = elapsed;
+      } else if (foc_data->mode == MOTOR_MODE_TRANSITION) {
+        result->lock_ms = (float)(elapsed - ramp_start) / 1000.0f;
+        result->load_angle_deg = (normalize_angle(foc_data->forced_angle - rotor_flux_angle() + MATH_PI) - MATH_PI) * SIM_RAD_TO_DEG;
+      } else if (foc_data->mode == MOTOR_MODE_RUNNING) {
+        result->closed_loop_ms = (float)elapsed / 1000.0f;
+        result->is_running = true;
+        running_start = elapsed;
+      }
+
+      last_mode = foc_data->mode;
+    }
+
+    float amplitude = current_amplitude(foc_data);
+
+    if (foc_data->mode == MOTOR_MODE_OPEN_LOOP) {
+      result->ramp_peak_a = fmaxf(result->ramp_peak_a, amplitude);
+    } else if (foc_data->mode == MOTOR_MODE_TRANSITION || foc_data->mode == MOTOR_MODE_RUNNING) {
+      result->handover_peak_a = fmaxf(result->handover_peak_a, amplitude);
+    }
+
+    hal_sim_advance_us(SIM_CONTROL_PERIOD_US);
+
+    if (result->is_running && (elapsed - running_start) >= SIM_HANDOVER_WINDOW_US) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static bool run_closed_loop(struct Motor_t *motor, struct SimFocStartupCase_t *result) {
+  struct HalSimStats_t stats;
+
+  for (uint32_t elapsed = 0U; elapsed < SIM_SETTLE_TIME_US + SIM_MEASURE_TIME_US; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (elapsed == SIM_SETTLE_TIME_US) {
+      hal_sim_reset_stats();
+    }
+
+    if (motor_run(motor) != MOTOR_OK) {
+      return false;
+    }
+
+    hal_sim_advance_us(SIM_CONTROL_PERIOD_US);
+  }
+
+  hal_sim_get_stats(&stats);
+  result->speed_rpm = (stats.duration_s > 0.0f) ? (stats.velocity_integral / stats.duration_s) * SIM_RAD_PER_S_TO_RPM : 0.0f;
+
+  return true;
+}
+
+static int run_load_case(float load_torque, float direction) {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct FOCSensorlessStartupConfig_t startup_config;
+  struct SimFocStartupCase_t result;
+
+  memset(&motor, 0, sizeof(motor));
+  memset(&result, 0, sizeof(result));
+  prepare_motor_config(&config);
+
+  hal_sim_restart();
+  hal_sim_set_noise_seed(SIM_NOISE_SEED);
+  hal_sim_set_load_torque(0.0f);
+
+  startup_config.align_current = FOC_SENSORLESS_DEFAULT_ALIGN_CURRENT;
+  startup_config.align_time_us = FOC_SENSORLESS_DEFAULT_ALIGN_TIME_US;
+  startup_config.ramp_current = FOC_SENSORLESS_DEFAULT_RAMP_CURRENT;
+  startup_config.ramp_acceleration = FOC_SENSORLESS_DEFAULT_RAMP_ACCELERATION;
+  startup_config.ramp_final_speed = direction * FOC_SENSORLESS_DEFAULT_RAMP_FINAL_SPEED;
+  startup_config.lock_window_us = FOC_SENSORLESS_DEFAULT_LOCK_WINDOW_US;
+  startup_config.blend_time_us = FOC_SENSORLESS_DEFAULT_BLEND_TIME_US;
+  startup_config.transition_timeout_us = FOC_SENSORLESS_DEFAULT_TRANSITION_TIMEOUT_US;
+
+  foc_sensorless_create_driver(&motor, OBSERVER_TYPE_BACKEMF_PLL);
+  foc_sensorless_set_startup_config(&startup_config);
+
+  if (motor.driver.init(&motor, &config) != MOTOR_OK) {
+    printf("%-8.3f %4.0f sensorless FOC driver failed to start\n", load_torque, direction);
+    return 1;
+  }
+
+  motor.driver.set_velocity(&motor, direction * SIM_TARGET_RPM / SIM_RAD_PER_S_TO_RPM);
+
+  if (!run_startup(&motor, direction * load_torque, &result) || !run_closed_loop(&motor, &result)) {
+    printf("%-8.3f %4.0f %10s stalled or faulted before closed-loop operation FAIL\n", load_torque, direction,
+           result.is_running ? "running" : "starting");
+    motor.driver.deinit(&motor);
+    return 1;
+  }
+
+  motor.driver.deinit(&motor);
+
+  float speed_error = (result.speed_rpm - direction * SIM_TARGET_RPM) / SIM_TARGET_RPM;
+  bool is_passing = (fabsf(speed_error) <= SIM_SPEED_TOLERANCE) &&
+                    (result.handover_peak_a <= SIM_HANDOVER_PEAK_RATIO * FOC_SENSORLESS_DEFAULT_RAMP_CURRENT);
+
+  printf("%-8.3f %4.0f %10.1f %10.1f %10.1f %10.2f %10.2f %10.1f %s\n", load_torque, direction, result.closed_loop_ms, result.lock_ms,
+         result.load_angle_deg, result.ramp_peak_a, result.handover_peak_a, result.speed_rpm, is_passing ? "" : "FAIL");
+
+  return is_passing ? 0 : 1;
+}
+
+int sim_scenario_foc_sensorless_startup(void) {
+  int result = 0;
+
+  hal_sim_set_verbose(false);
+
+  printf("Sensorless FOC I/f startup: %.1f A ramp to %.0f rad/s electrical, then closed-loop at %.0f RPM\n",
+         FOC_SENSORLESS_DEFAULT_RAMP_CURRENT, FOC_SENSORLESS_DEFAULT_RAMP_FINAL_SPEED, SIM_TARGET_RPM);
+  printf("%-8s %4s %10s %10s %10s %10s %10s %10s\n", "load_nm", "dir", "closed_ms", "lock_ms", "lag_deg", "ramp_pk_a", "handovr_pk", "speed_rpm");
+
+  for (size_t i = 0U; i < sizeof(s_directions) / sizeof(s_directions[0]); i++) {
+    for (size_t j = 0U; j < sizeof(s_load_torques) / sizeof(s_load_torques[0]); j++) {
+      result |= run_load_case(s_load_torques[j], s_directions[i]);
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,98 @@
+/*******************************************************************************************************************************
+ * @file   sim_gate_write.c
+ *
+ * @brief  Source file for the 6-step commutation gate write benchmark
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdio.h>
+#include <time.h>
+
+/* Inter-component Headers */
+#include "bldc_6step_common.h"
+#include "hal.h"
+#include "hal_sim.h"
+
+/* Intra-component Headers */
+#include "sim_scenarios.h"
+
+#define SIM_BENCHMARK_COMMUTATIONS 6000000U /**< Commutation events timed per case */
+#define SIM_BENCHMARK_DUTY 0.5f             /**< Duty cycle applied on every commutation */
+
+/**
+ * Per-switch commutation table the drivers used before the packed gate states, kept as the benchmark baseline
+ */
+static const uint8_t s_legacy_commutation_table[NUM_COMMUTATION_STEPS][NUM_COMMUTATION_STEPS] = {
+  /* High_A, Low_A, High_B, Low_B, High_C, Low_C */
+  { 1U, 0U, 0U, 1U, 0U, 0U }, /* Step 1: A-High, B-Low */
+  { 1U, 0U, 0U, 0U, 0U, 1U }, /* Step 2: A-High, C-Low */
+  { 0U, 0U, 1U, 0U, 0U, 1U }, /* Step 3: B-High, C-Low */
+  { 0U, 1U, 1U, 0U, 0U, 0U }, /* Step 4: B-High, A-Low */
+  { 0U, 1U, 0U, 0U, 1U, 0U }, /* Step 5: C-High, A-Low */
+  { 0U, 0U, 0U, 1U, 1U, 0U }, /* Step 6: C-High, B-Low */
+};
+
+/**
+ * @brief   Commutation output path timed by the benchmark
+ */
+struct SimGateWriteCase_t {
+  const char *name;                            /**< Printed case name */
+  void (*commutate)(uint8_t step, float duty); /**< Applies the outputs of one commutation step */
+};
+
+static void legacy_commutate(uint8_t step, float duty) {
+  const uint8_t *commutation = s_legacy_commutation_table[step];
+
+  /* One branch chain and one HAL call per phase */
+  for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+    if (commutation[2U * phase] == 1U) {
+      hal_pwm_set_duty(phase, duty);
+    } else if (commutation[2U * phase + 1U] == 1U) {
+      hal_gpio_set_phase_low(phase);
+    } else {
+      hal_gpio_set_phase_float(phase);
+    }
+  }
+}
+
+static void packed_commutate(uint8_t step, float duty) {
+  _6step_bldc_set_phase_outputs(BLDC6STEP_PWM_H_PWM_L_ON, step, duty);
+}
+
+static const struct SimGateWriteCase_t s_gate_write_cases[] = {
+  { "per-phase table", legacy_commutate },
+  { "packed gates", packed_commutate },
+};
+
+int sim_scenario_gate_write_cost(void) {
+  hal_sim_set_verbose(false);
+  hal_sim_restart();
+
+  printf("6-step commutation output cost: %u commutations per case\n", (unsigned int)SIM_BENCHMARK_COMMUTATIONS);
+  printf("%-18s %14s %20s\n", "case", "ns_per_event", "hal_writes_per_event");
+
+  for (size_t i = 0U; i < sizeof(s_gate_write_cases) / sizeof(s_gate_write_cases[0]); i++) {
+    struct HalSimStats_t stats;
+    uint8_t step = 0U;
+
+    hal_sim_reset_stats();
+    clock_t start = clock();
+
+    for (uint32_t event = 0U; event < SIM_BENCHMARK_COMMUTATIONS; event++) {
+      s_gate_write_cases[i].commutate(step, SIM_BENCHMARK_DUTY);
+      step = (step + 1U == NUM_COMMUTATION_STEPS) ? 0U : (uint8_t)(step + 1U);
+    }
+
+    clock_t end = clock();
+    hal_sim_get_stats(&stats);
+
+    double elapsed_ns = 1.0e9 * (double)(end - start) / (double)CLOCKS_PER_SEC;
+    printf("%-18s %14.2f %20.2f\n", s_gate_write_cases[i].name, elapsed_ns / (double)SIM_BENCHMARK_COMMUTATIONS,
+           (double)stats.gate_writes / (double)SIM_BENCHMARK_COMMUTATIONS);
+  }
+
+  return 0;
+}
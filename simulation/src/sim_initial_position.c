@@ -0,0 +1,234 @@
+/*******************************************************************************************************************************
+ * @file   sim_initial_position.c
+ *
+ * @brief  Source file for the sensorless 6-step initial position detection scenario
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "bldc_6step_sensorless.h"
+#include "hal.h"
+#include "hal_sim.h"
+#include "math_utils.h"
+#include "motor.h"
+
+/* Intra-component Headers */
+#include "sim_scenarios.h"
+
+#define SIM_CONTROL_PERIOD_US 50U          /**< Control loop period (us), 20 kHz */
+#define SIM_START_TIMEOUT_US 3000000U      /**< Longest time the startup may take to reach closed-loop (us) */
+#define SIM_POLE_PAIRS 7U                  /**< Pole pairs of the simulated motor */
+#define SIM_COGGING_AMPLITUDE 0.05f        /**< Cogging torque amplitude of the simulated motor (Nm) */
+#define SIM_COGGING_PERIODS 6.0f           /**< Cogging periods per electrical revolution of the simulated motor */
+#define SIM_SATURATION 0.3f                /**< d-axis inductance lost to saturation */
+#define SIM_MAX_DETECTION_ERROR_DEG 30.0f  /**< Largest detection error that still leads the rotor by 60 to 120 degrees */
+#define SIM_MAX_REVERSE_DEG 15.0f          /**< Largest backwards travel allowed of a start with detection (electrical deg) */
+#define SIM_NUM_REST_POSITIONS 6U          /**< Cogging detents per electrical revolution, each one a case */
+#define SIM_NOISE_SEED 1U                  /**< Noise seed shared by every case */
+#define SIM_RAD_TO_DEG (180.0f / MATH_PI)  /**< Radians to degrees */
+
+/**
+ * @brief   Rotor of a case
+ */
+struct SimRotor_t {
+  const char *name;   /**< Printed name */
+  float inductance_d; /**< Unsaturated d-axis inductance (H) */
+  float inductance_q; /**< q-axis inductance (H) */
+};
+
+static const struct SimRotor_t s_rotors[] = {
+  { "surface", 0.001f, 0.001f },
+  { "interior", 0.0008f, 0.0012f },
+};
+
+/**
+ * @brief   Torques holding the rotor at rest, they shift it off the cogging detents (Nm)
+ * @details The open-loop ramp of this scenario needs some load to hand over to closed-loop operation
+ */
+static const float s_holding_loads[] = { 0.02f, 0.04f };
+
+/**
+ * @brief   Startup figures of one rotor, load and startup over every rest position
+ */
+struct SimInitialPositionResult_t {
+  uint32_t num_running;  /**< Cases that reached closed-loop operation */
+  float max_error_deg;   /**< Largest detection error (electrical degrees) */
+  float detect_ms;       /**< Longest time spent detecting (ms) */
+  float total_start_ms;  /**< Sum of the times from init to closed-loop operation (ms) */
+  float max_start_ms;    /**< Longest time from init to closed-loop operation (ms) */
+  float max_reverse_deg; /**< Largest backwards travel of the rotor before closed-loop operation (electrical degrees) */
+};
+
+static void prepare_motor_config(struct MotorConfig_t *config) {
+  memset(config, 0, sizeof(*config));
+  config->type = MOTOR_TYPE_BLDC;
+  config->control_method = CONTROL_METHOD_SENSORLESS;
+  config->control_mode = CONTROL_MODE_VOLTAGE;
+  config->pole_pairs = SIM_POLE_PAIRS;
+  config->phase_resistance = 0.5f;
+  config->phase_inductance = 0.001f;
+  config->max_current = 40.0f;
+  config->max_voltage = 24.0f;
+  config->max_velocity = 10000.0f;
+  config->current_pid_config.output_min = 0.0f;
+  config->current_pid_config.output_max = 1.0f;
+
+  config->pwm_config.frequency = 20000U;
+  config->pwm_config.dead_time_ns = 500U;
+  config->pwm_config.resolution = 12U;
+  config->pwm_config.complementary_output = true;
+
+  config->adc_config.sampling_freq = 20000U;
+  config->adc_config.resolution = 12U;
+  config->adc_config.v_ref = 3.3f;
+  config->adc_config.current_gain = 0.1f;
+  config->adc_config.voltage_gain = 0.1f;
+}
+
+/* The flying start scenario ramp, with the default alignment time */
+static void prepare_startup_config(struct BLDC6StepStartupConfig_t *startup_config) {
+  startup_config->align_duty = 0.1f;
+  startup_config->align_time_us = DEFAULT_ALIGNMENT_TIME_MS * 1000U;
+  startup_config->initial_period_us = 20000U;
+  startup_config->final_period_us = 4000U;
+  startup_config->acceleration_factor = 0.98f;
+  startup_config->initial_duty = 0.1f;
+  startup_config->duty_increment = 0.0012f;
+  startup_config->num_steps = 150U;
+  startup_config->transition_timeout_us = 200000U;
+}
+
+/* Mechanical angle at which the cogging torque balances the holding load, on detent k */
+static float calculate_rest_position(uint32_t detent, float load) {
+  float electrical_angle = (asinf(-load / SIM_COGGING_AMPLITUDE) + MATH_TWO_PI * (float)detent) / SIM_COGGING_PERIODS;
+  return electrical_angle / (float)SIM_POLE_PAIRS;
+}
+
+/* Difference of two angles wrapped to +-pi */
+static float wrap_angle(float angle) {
+  return atan2f(sinf(angle), cosf(angle));
+}
+
+static void run_start_case(const struct SimRotor_t *rotor, float load, uint32_t detent, bool is_detecting,
+                           struct SimInitialPositionResult_t *result) {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepStartupConfig_t startup_config;
+  struct BLDC6StepFlyingStartConfig_t flying_start_config = { .enabled = false, .catch_time_us = 0U };
+  struct BLDC6StepInitialPositionConfig_t detect_config = {
+    .enabled = is_detecting,
+    .num_pulses = BLDC6STEP_MAX_DETECTION_PULSES,
+    .pulse_time_us = 200U,
+    .settle_time_us = 300U,
+  };
+
+  memset(&motor, 0, sizeof(motor));
+  prepare_motor_config(&config);
+  prepare_startup_config(&startup_config);
+
+  hal_sim_restart();
+  hal_sim_set_noise_seed(SIM_NOISE_SEED);
+  hal_sim_set_saliency(rotor->inductance_d, rotor->inductance_q, SIM_SATURATION);
+  hal_sim_set_load_torque(load);
+  hal_sim_set_rotor_position(calculate_rest_position(detent, load));
+
+  bldc_6step_sensorless_set_startup_config(&startup_config);
+  bldc_6step_sensorless_set_flying_start_config(&flying_start_config);
+  bldc_6step_sensorless_set_initial_position_config(&detect_config);
+  bldc_6step_sensorless_create_driver(&motor);
+
+  float north = hal_encoder_get_position() * (float)SIM_POLE_PAIRS + MATH_PI;
+  float last_position = hal_encoder_get_position();
+  float travel = 0.0f;
+
+  if (motor.driver.init(&motor, &config) != MOTOR_OK) {
+    return;
+  }
+
+  const struct BLDC6StepSensorlessData_t *bldc_data = (const struct BLDC6StepSensorlessData_t *)motor.private_data;
+
+  for (uint32_t elapsed = SIM_CONTROL_PERIOD_US; elapsed <= SIM_START_TIMEOUT_US; elapsed += SIM_CONTROL_PERIOD_US) {
+    bool was_detecting = bldc_data->mode == MOTOR_MODE_DETECTING;
+
+    if (motor_run(&motor) != MOTOR_OK) {
+      break;
+    }
+    hal_sim_advance_us(SIM_CONTROL_PERIOD_US);
+
+    float position = hal_encoder_get_position();
+    travel += wrap_angle(position - last_position);
+    last_position = position;
+    result->max_reverse_deg = fmaxf(result->max_reverse_deg, -travel * (float)SIM_POLE_PAIRS * SIM_RAD_TO_DEG);
+
+    if (was_detecting && bldc_data->mode != MOTOR_MODE_DETECTING) {
+      float error = fabsf(wrap_angle(bldc_data->detected_angle - north)) * SIM_RAD_TO_DEG;
+      result->max_error_deg = fmaxf(result->max_error_deg, error);
+      result->detect_ms = fmaxf(result->detect_ms, (float)elapsed / 1000.0f);
+    }
+
+    if (bldc_data->mode == MOTOR_MODE_RUNNING) {
+      float start_ms = (float)elapsed / 1000.0f;
+      result->num_running++;
+      result->total_start_ms += start_ms;
+      result->max_start_ms = fmaxf(result->max_start_ms, start_ms);
+      break;
+    }
+  }
+
+  motor.driver.deinit(&motor);
+}
+
+static int run_rotor_case(const struct SimRotor_t *rotor, float load, bool is_detecting) {
+  struct SimInitialPositionResult_t result;
+  const char *start_name = is_detecting ? "detect" : "align";
+
+  memset(&result, 0, sizeof(result));
+
+  for (uint32_t detent = 0U; detent < SIM_NUM_REST_POSITIONS; detent++) {
+    run_start_case(rotor, load, detent, is_detecting, &result);
+  }
+
+  /* The alignment is the baseline, only the detection is held to the error and the reverse travel */
+  bool is_passing = result.num_running == SIM_NUM_REST_POSITIONS;
+  if (is_detecting) {
+    is_passing = is_passing && result.max_error_deg <= SIM_MAX_DETECTION_ERROR_DEG && result.max_reverse_deg <= SIM_MAX_REVERSE_DEG;
+  }
+
+  if (is_detecting) {
+    printf("%-9s %-6.2f %-7s %9.1f %9.1f", rotor->name, load, start_name, result.max_error_deg, result.detect_ms);
+  } else {
+    printf("%-9s %-6.2f %-7s %9s %9s", rotor->name, load, start_name, "-", "-");
+  }
+  float mean_start_ms = (result.num_running > 0U) ? (result.total_start_ms / (float)result.num_running) : 0.0f;
+  printf(" %7u/%u %8.0f %8.0f %11.1f %s\n", (unsigned)result.num_running, (unsigned)SIM_NUM_REST_POSITIONS, mean_start_ms,
+         result.max_start_ms, result.max_reverse_deg, is_passing ? "" : "FAIL");
+
+  return is_passing ? 0 : 1;
+}
+
+int sim_scenario_initial_position(void) {
+  int result = 0;
+
+  hal_sim_set_verbose(false);
+
+  printf("Sensorless 6-step startup from the %u cogging detents: alignment against initial position detection\n",
+         (unsigned)SIM_NUM_REST_POSITIONS);
+  printf("%-9s %-6s %-7s %9s %9s %9s %8s %8s %11s\n", "rotor", "load", "start", "error_deg", "detect_ms", "running", "mean_ms",
+         "max_ms", "reverse_deg");
+
+  for (size_t i = 0U; i < sizeof(s_rotors) / sizeof(s_rotors[0]); i++) {
+    for (size_t j = 0U; j < sizeof(s_holding_loads) / sizeof(s_holding_loads[0]); j++) {
+      result |= run_rotor_case(&s_rotors[i], s_holding_loads[j], false);
+      result |= run_rotor_case(&s_rotors[i], s_holding_loads[j], true);
+    }
+  }
+
+  return result;
+}
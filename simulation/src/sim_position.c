@@ -0,0 +1,340 @@
+/*******************************************************************************************************************************
+ * @file   sim_position.c
+ *
+ * @brief  Source file for the sensored and sensorless 6-step point-to-point position scenario
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "bldc_6step_sensored.h"
+#include "bldc_6step_sensorless.h"
+#include "hal.h"
+#include "hal_sim.h"
+#include "math_utils.h"
+#include "motor.h"
+
+/* Intra-component Headers */
+#include "sim_scenarios.h"
+
+#define SIM_CONTROL_PERIOD_US 50U                                   /**< Control loop period (us), 20 kHz */
+#define SIM_MOVE_WINDOW_US 1500000U                                 /**< Time given to each move before the next one is commanded (us) */
+#define SIM_POLE_PAIRS 7U                                           /**< Pole pairs of the simulated motor */
+#define SIM_LOAD_TORQUE 0.02f                                       /**< Constant load torque the position is held against (Nm) */
+#define SIM_NOISE_SEED 1U                                           /**< Noise seed of the run */
+#define SIM_SETTLE_BAND_STEPS 1.0f                                  /**< A move is settled once it stays within this many steps of the target */
+#define SIM_RAD_TO_DEG (180.0f / MATH_PI)                           /**< Radians to degrees */
+#define SIM_STEP_ANGLE_RAD (MATH_PI_OVER_3 / (float)SIM_POLE_PAIRS) /**< Mechanical angle of one commutation step (rad) */
+#define SIM_SPIN_UP_TIMEOUT_US 3000000U                             /**< Longest sensorless startup before the move is failed (us) */
+#define SIM_HOLD_TIME_US 500000U                                    /**< Time the reached sensorless target is held before measuring (us) */
+#define SIM_RAD_PER_S_TO_RPM (60.0f / MATH_TWO_PI)                  /**< Mechanical rad/s to RPM */
+
+/**
+ * @brief   Point-to-point move of the scenario, in commutation steps from the startup position
+ */
+static const int32_t s_move_targets[] = { 42, 21, 22, 168, 0 };
+
+/**
+ * @brief   Forward travel of each sensorless move, in commutation steps from the count at closed-loop handover
+ */
+static const int32_t s_sensorless_distances[] = { 6, 21, 42, 84 };
+
+/**
+ * @brief   Result of one move
+ */
+struct SimPositionMove_t {
+  float settle_time_s;   /**< Time from the command until the rotor stays within the settle band (s) */
+  float overshoot_deg;   /**< Largest travel past the target (mechanical degrees) */
+  float final_error_deg; /**< Rotor position relative to the target at the end of the window (mechanical degrees) */
+  int32_t final_steps;   /**< Step count reported by the driver at the end of the window */
+};
+
+/**
+ * @brief   Result of one sensorless move
+ */
+struct SimSensorlessMove_t {
+  bool is_held;          /**< The driver reached the target and holds it */
+  int32_t target;        /**< Target step count, the count at handover plus the travel */
+  float arrival_time_s;  /**< Time from the command until the target step is reached (s) */
+  float arrival_rpm;     /**< Rotor speed when the target step is reached (mechanical RPM) */
+  float overshoot_deg;   /**< Largest travel past the target (mechanical degrees) */
+  float final_error_deg; /**< Rotor position relative to the target at the end of the hold (mechanical degrees) */
+};
+
+static const struct BLDC6StepPositionConfig_t s_position_config = {
+  .cruise_velocity = 3000.0f,
+  .acceleration = 20000.0f,
+};
+
+static void prepare_startup_config(struct BLDC6StepStartupConfig_t *startup_config) {
+  startup_config->align_duty = 0.1f;
+  startup_config->align_time_us = 100000U;
+  startup_config->initial_period_us = 20000U;
+  startup_config->final_period_us = 4000U;
+  startup_config->acceleration_factor = 0.98f;
+  startup_config->initial_duty = 0.1f;
+  startup_config->duty_increment = 0.0012f;
+  startup_config->num_steps = 150U;
+  startup_config->transition_timeout_us = 200000U;
+}
+
+static void prepare_motor_config(struct MotorConfig_t *config) {
+  memset(config, 0, sizeof(*config));
+  config->type = MOTOR_TYPE_BLDC;
+  config->control_method = CONTROL_METHOD_SIX_STEP;
+  config->control_mode = CONTROL_MODE_VOLTAGE;
+  config->pole_pairs = SIM_POLE_PAIRS;
+  config->phase_resistance = 0.5f;
+  config->phase_inductance = 0.001f;
+  config->max_current = 40.0f;
+  config->max_voltage = 24.0f;
+  config->max_velocity = 10000.0f;
+
+  /* Position error (steps) to a speed correction (electrical RPM) */
+  config->position_pid_config.kp = 200.0f;
+  config->position_pid_config.ki = 5.0f;
+  config->position_pid_config.output_min = -1000.0f;
+  config->position_pid_config.output_max = 1000.0f;
+
+  /* Speed error (electrical RPM) to a signed duty, negative drives in reverse */
+  config->velocity_pid_config.kp = 0.0001f;
+  config->velocity_pid_config.ki = 0.002f;
+  config->velocity_pid_config.output_min = -1.0f;
+  config->velocity_pid_config.output_max = 1.0f;
+
+  config->pwm_config.frequency = 20000U;
+  config->pwm_config.dead_time_ns = 500U;
+  config->pwm_config.resolution = 12U;
+  config->pwm_config.complementary_output = true;
+
+  config->adc_config.sampling_freq = 20000U;
+  config->adc_config.resolution = 12U;
+  config->adc_config.v_ref = 3.3f;
+  config->adc_config.current_gain = 0.1f;
+  config->adc_config.voltage_gain = 0.1f;
+}
+
+/* Unwraps the [0, 2π) encoder angle into a continuous mechanical position */
+static float track_rotor_position(float *last_angle, float position) {
+  float angle = hal_encoder_get_position();
+  float delta = angle - *last_angle;
+
+  if (delta > MATH_PI) {
+    delta -= MATH_TWO_PI;
+  } else if (delta < -MATH_PI) {
+    delta += MATH_TWO_PI;
+  }
+
+  *last_angle = angle;
+  return position + delta;
+}
+
+static bool run_move(struct Motor_t *motor, int32_t target, float *last_angle, float *rotor_position, struct SimPositionMove_t *move) {
+  float target_offset = (float)target * SIM_STEP_ANGLE_RAD;
+  float direction = (target_offset >= *rotor_position) ? 1.0f : -1.0f;
+  uint32_t last_outside_us = 0U;
+
+  memset(move, 0, sizeof(*move));
+  motor->driver.set_position(motor, target_offset);
+
+  for (uint32_t elapsed = 0U; elapsed < SIM_MOVE_WINDOW_US; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (motor_run(motor) != MOTOR_OK) {
+      return false;
+    }
+    hal_sim_advance_us(SIM_CONTROL_PERIOD_US);
+
+    *rotor_position = track_rotor_position(last_angle, *rotor_position);
+    float error = *rotor_position - target_offset;
+
+    move->overshoot_deg = fmaxf(move->overshoot_deg, direction * error * SIM_RAD_TO_DEG);
+
+    if (fabsf(error) > SIM_SETTLE_BAND_STEPS * SIM_STEP_ANGLE_RAD) {
+      last_outside_us = elapsed + SIM_CONTROL_PERIOD_US;
+    }
+  }
+
+  struct BLDC6StepSensoredData_t *bldc_data = (struct BLDC6StepSensoredData_t *)motor->private_data;
+
+  move->settle_time_s = (float)last_outside_us / 1000000.0f;
+  move->final_error_deg = (*rotor_position - target_offset) * SIM_RAD_TO_DEG;
+  move->final_steps = bldc_data->position_steps;
+
+  return last_outside_us < SIM_MOVE_WINDOW_US;
+}
+
+/* Steps the loop and follows the rotor, the sensorless count starts at the rotor angle the alignment leaves behind */
+static bool run_sensorless_period(struct Motor_t *motor, float *last_angle, float *rotor_position, float *origin) {
+  const struct BLDC6StepSensorlessData_t *bldc_data = (const struct BLDC6StepSensorlessData_t *)motor->private_data;
+
+  if (motor_run(motor) != MOTOR_OK) {
+    return false;
+  }
+  hal_sim_advance_us(SIM_CONTROL_PERIOD_US);
+
+  *rotor_position = track_rotor_position(last_angle, *rotor_position);
+
+  if (bldc_data->mode == MOTOR_MODE_ALIGNING) {
+    *origin = *rotor_position;
+  }
+
+  return true;
+}
+
+static void run_sensorless_move(int32_t distance, struct SimSensorlessMove_t *move) {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepStartupConfig_t startup_config;
+
+  memset(&motor, 0, sizeof(motor));
+  memset(move, 0, sizeof(*move));
+  prepare_motor_config(&config);
+  config.control_method = CONTROL_METHOD_SENSORLESS;
+  /* The open-loop startup duty is capped by the current loop limits */
+  config.current_pid_config.output_min = 0.0f;
+  config.current_pid_config.output_max = 1.0f;
+  prepare_startup_config(&startup_config);
+
+  hal_sim_restart();
+  hal_sim_set_noise_seed(SIM_NOISE_SEED);
+  hal_sim_set_load_torque(SIM_LOAD_TORQUE);
+
+  bldc_6step_sensorless_set_startup_config(&startup_config);
+  bldc_6step_sensorless_set_position_config(&s_position_config);
+  bldc_6step_sensorless_create_driver(&motor);
+
+  if (motor.driver.init(&motor, &config) != MOTOR_OK) {
+    return;
+  }
+
+  const struct BLDC6StepSensorlessData_t *bldc_data = (const struct BLDC6StepSensorlessData_t *)motor.private_data;
+  float last_angle = hal_encoder_get_position();
+  float rotor_position = 0.0f;
+  float origin = 0.0f;
+  uint32_t elapsed = 0U;
+
+  for (; bldc_data->mode != MOTOR_MODE_RUNNING; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (elapsed >= SIM_SPIN_UP_TIMEOUT_US || !run_sensorless_period(&motor, &last_angle, &rotor_position, &origin)) {
+      motor.driver.deinit(&motor);
+      return;
+    }
+  }
+
+  move->target = bldc_data->position_steps + distance;
+  float target_offset = (float)move->target * SIM_STEP_ANGLE_RAD;
+
+  if (motor.driver.set_position(&motor, target_offset) != MOTOR_OK) {
+    motor.driver.deinit(&motor);
+    return;
+  }
+
+  for (elapsed = 0U; bldc_data->mode == MOTOR_MODE_RUNNING && elapsed < SIM_MOVE_WINDOW_US; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (!run_sensorless_period(&motor, &last_angle, &rotor_position, &origin)) {
+      motor.driver.deinit(&motor);
+      return;
+    }
+    move->overshoot_deg = fmaxf(move->overshoot_deg, (rotor_position - origin - target_offset) * SIM_RAD_TO_DEG);
+  }
+
+  move->arrival_time_s = (float)elapsed / 1000000.0f;
+  move->arrival_rpm = hal_encoder_get_velocity() * SIM_RAD_PER_S_TO_RPM;
+
+  for (elapsed = 0U; bldc_data->mode == MOTOR_MODE_BRAKING && elapsed < SIM_HOLD_TIME_US; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (!run_sensorless_period(&motor, &last_angle, &rotor_position, &origin)) {
+      motor.driver.deinit(&motor);
+      return;
+    }
+    move->overshoot_deg = fmaxf(move->overshoot_deg, (rotor_position - origin - target_offset) * SIM_RAD_TO_DEG);
+  }
+
+  move->is_held = (bldc_data->mode == MOTOR_MODE_BRAKING) && (bldc_data->position_steps == move->target);
+  move->final_error_deg = (rotor_position - origin - target_offset) * SIM_RAD_TO_DEG;
+
+  motor.driver.deinit(&motor);
+}
+
+static int run_sensorless_moves(void) {
+  int result = 0;
+
+  printf("\nSensorless 6-step position moves: forward from the closed-loop handover, target held at the align duty\n");
+  printf("%8s %8s %10s %12s %12s %12s\n", "travel", "target", "arrive_s", "arrive_rpm", "overshoot", "final_err");
+
+  for (size_t i = 0U; i < sizeof(s_sensorless_distances) / sizeof(s_sensorless_distances[0]); i++) {
+    struct SimSensorlessMove_t move;
+
+    run_sensorless_move(s_sensorless_distances[i], &move);
+
+    /* Holding the target step leaves the rotor within one step of it */
+    bool is_passing = move.is_held && (fabsf(move.final_error_deg) <= SIM_SETTLE_BAND_STEPS * SIM_STEP_ANGLE_RAD * SIM_RAD_TO_DEG);
+
+    if (!is_passing) {
+      result = 1;
+    }
+
+    printf("%8d %8d %10.3f %12.1f %12.2f %12.2f%s\n", (int)s_sensorless_distances[i], (int)move.target, move.arrival_time_s, move.arrival_rpm,
+           move.overshoot_deg, move.final_error_deg, is_passing ? "" : " FAIL");
+  }
+
+  return result;
+}
+
+int sim_scenario_position_moves(void) {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  int result = 0;
+
+  hal_sim_set_verbose(false);
+  memset(&motor, 0, sizeof(motor));
+  prepare_motor_config(&config);
+
+  hal_sim_restart();
+  hal_sim_set_noise_seed(SIM_NOISE_SEED);
+  hal_sim_set_load_torque(SIM_LOAD_TORQUE);
+
+  bldc_6step_sensored_set_position_config(&s_position_config);
+  bldc_6step_sensored_create_driver(&motor);
+
+  printf("Sensored 6-step position moves: %.0f erpm cruise, %.0f erpm/s, %.3f Nm load, one step = %.2f mechanical degrees\n",
+         s_position_config.cruise_velocity, s_position_config.acceleration, SIM_LOAD_TORQUE, SIM_STEP_ANGLE_RAD * SIM_RAD_TO_DEG);
+
+  if (motor.driver.init(&motor, &config) != MOTOR_OK) {
+    printf("sensored driver failed to start\n");
+    return 1;
+  }
+
+  float last_angle = hal_encoder_get_position();
+  float rotor_position = 0.0f;
+
+  printf("%8s %10s %10s %12s %12s %12s\n", "target", "target_deg", "settle_s", "overshoot", "final_err", "driver_steps");
+
+  for (size_t i = 0U; i < sizeof(s_move_targets) / sizeof(s_move_targets[0]); i++) {
+    struct SimPositionMove_t move;
+
+    bool is_settled = run_move(&motor, s_move_targets[i], &last_angle, &rotor_position, &move);
+
+    if (!is_settled) {
+      result = 1;
+    }
+
+    char settle_time[16];
+    if (is_settled) {
+      snprintf(settle_time, sizeof(settle_time), "%.3f", move.settle_time_s);
+    } else {
+      snprintf(settle_time, sizeof(settle_time), "unsettled");
+    }
+
+    printf("%8d %10.1f %10s %12.2f %12.2f %12d\n", (int)s_move_targets[i], (float)s_move_targets[i] * SIM_STEP_ANGLE_RAD * SIM_RAD_TO_DEG,
+           settle_time, move.overshoot_deg, move.final_error_deg, (int)move.final_steps);
+  }
+
+  motor.driver.deinit(&motor);
+
+  result |= run_sensorless_moves();
+
+  return result;
+}
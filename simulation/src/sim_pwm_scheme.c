@@ -0,0 +1,190 @@
+/*******************************************************************************************************************************
+ * @file   sim_pwm_scheme.c
+ *
+ * @brief  Source file for the sensorless 6-step PWM scheme conduction loss scenario
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "bldc_6step_sensorless.h"
+#include "hal_sim.h"
+#include "math_utils.h"
+#include "motor.h"
+
+/* Intra-component Headers */
+#include "sim_scenarios.h"
+
+#define SIM_CONTROL_PERIOD_US 50U                  /**< Control loop period (us), 20 kHz */
+#define SIM_SETTLE_TIME_US 2500000U                /**< Time from start before measuring (us) */
+#define SIM_MEASURE_TIME_US 500000U                /**< Measurement window (us) */
+#define SIM_SUPPLY_VOLTAGE 16.0f                   /**< Voltage setpoint of the run (V), 2/3 of the bus */
+#define SIM_VOLTAGE_RAMP_V_PER_TICK 0.001f         /**< Closed-loop voltage ramp (V per control period), 20 V/s */
+#define SIM_LOAD_TORQUE 0.05f                      /**< Load torque of the run (Nm) */
+#define SIM_NOISE_SEED 1U                          /**< Noise seed shared by every case */
+#define SIM_RAD_PER_S_TO_RPM (60.0f / MATH_TWO_PI) /**< Mechanical rad/s to RPM */
+
+/**
+ * @brief   Modulation scheme compared by the scenario
+ */
+struct SimPwmSchemeCase_t {
+  const char *name;            /**< Printed case name */
+  BLDC6StepPwmScheme_t scheme; /**< Driver modulation scheme */
+};
+
+static const struct SimPwmSchemeCase_t s_pwm_scheme_cases[] = {
+  { "H_PWM-L_ON", BLDC6STEP_PWM_H_PWM_L_ON },
+  { "H_ON-L_PWM", BLDC6STEP_PWM_H_ON_L_PWM },
+  { "complementary", BLDC6STEP_PWM_COMPLEMENTARY },
+  { "alternating", BLDC6STEP_PWM_ALTERNATING },
+};
+
+static const struct BLDC6StepCommutationConfig_t s_commutation_config = {
+  .delayed_commutation = true,
+  .advance_deg_per_krpm = 0.0f,
+  .max_advance_deg = 0.0f,
+  .blanking_fraction = 0.25f,
+};
+
+static void prepare_motor_config(struct MotorConfig_t *config) {
+  memset(config, 0, sizeof(*config));
+  config->type = MOTOR_TYPE_BLDC;
+  config->control_method = CONTROL_METHOD_SENSORLESS;
+  config->control_mode = CONTROL_MODE_VOLTAGE;
+  config->pole_pairs = 7U;
+  config->phase_resistance = 0.5f;
+  config->phase_inductance = 0.001f;
+  config->max_current = 40.0f;
+  config->max_voltage = 24.0f;
+  config->max_velocity = 10000.0f;
+  config->current_pid_config.output_min = 0.0f;
+  config->current_pid_config.output_max = 1.0f;
+
+  config->pwm_config.frequency = 20000U;
+  config->pwm_config.dead_time_ns = 500U;
+  config->pwm_config.resolution = 12U;
+  config->pwm_config.complementary_output = true;
+
+  config->adc_config.sampling_freq = 20000U;
+  config->adc_config.resolution = 12U;
+  config->adc_config.v_ref = 3.3f;
+  config->adc_config.current_gain = 0.1f;
+  config->adc_config.voltage_gain = 0.1f;
+}
+
+static void prepare_startup_config(struct BLDC6StepStartupConfig_t *startup_config) {
+  startup_config->align_duty = 0.1f;
+  startup_config->align_time_us = 100000U;
+  startup_config->initial_period_us = 20000U;
+  startup_config->final_period_us = 4000U;
+  startup_config->acceleration_factor = 0.98f;
+  startup_config->initial_duty = 0.1f;
+  startup_config->duty_increment = 0.0012f;
+  startup_config->num_steps = 150U;
+  startup_config->transition_timeout_us = 200000U;
+}
+
+static bool run_pwm_scheme_case(BLDC6StepPwmScheme_t scheme, struct HalSimStats_t *stats) {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepStartupConfig_t startup_config;
+
+  memset(&motor, 0, sizeof(motor));
+  prepare_motor_config(&config);
+  prepare_startup_config(&startup_config);
+
+  hal_sim_restart();
+  hal_sim_set_noise_seed(SIM_NOISE_SEED);
+  hal_sim_set_load_torque(SIM_LOAD_TORQUE);
+
+  bldc_6step_sensorless_set_startup_config(&startup_config);
+  bldc_6step_sensorless_set_commutation_config(&s_commutation_config);
+  bldc_6step_sensorless_set_pwm_scheme(BLDC6STEP_PWM_H_PWM_L_ON);
+  bldc_6step_sensorless_create_driver(&motor);
+
+  if (motor.driver.init(&motor, &config) != MOTOR_OK) {
+    return false;
+  }
+
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor.private_data;
+  bool is_running = true;
+  float voltage = -1.0f;
+
+  for (uint32_t elapsed = 0U; elapsed < SIM_SETTLE_TIME_US + SIM_MEASURE_TIME_US; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (elapsed == SIM_SETTLE_TIME_US) {
+      hal_sim_reset_stats();
+    }
+
+    /* Every case starts up the same way. The scheme under test and the voltage setpoint take over once closed-loop */
+    if (bldc_data->mode == MOTOR_MODE_RUNNING) {
+      if (voltage < 0.0f) {
+        voltage = bldc_data->pwm_duty * config.max_voltage;
+        bldc_6step_sensorless_set_pwm_scheme(scheme);
+      }
+      voltage = fminf(voltage + SIM_VOLTAGE_RAMP_V_PER_TICK, SIM_SUPPLY_VOLTAGE);
+      motor.driver.set_voltage(&motor, voltage);
+    }
+
+    if (motor_run(&motor) != MOTOR_OK) {
+      is_running = false;
+      break;
+    }
+    hal_sim_advance_us(SIM_CONTROL_PERIOD_US);
+  }
+
+  is_running = is_running && (bldc_data->mode == MOTOR_MODE_RUNNING);
+  hal_sim_get_stats(stats);
+  motor.driver.deinit(&motor);
+
+  return is_running;
+}
+
+int sim_scenario_pwm_scheme_losses(void) {
+  int result = 0;
+
+  hal_sim_set_verbose(false);
+
+  printf("Sensorless 6-step PWM schemes: %.1f V, %.3f Nm load, bridge conduction losses\n", SIM_SUPPLY_VOLTAGE, SIM_LOAD_TORQUE);
+  printf("%-14s %10s %12s %12s %12s %12s %12s\n", "scheme", "speed_rpm", "efficiency", "bridge_w", "diode_share", "max_device",
+         "min_device");
+
+  for (size_t i = 0U; i < sizeof(s_pwm_scheme_cases) / sizeof(s_pwm_scheme_cases[0]); i++) {
+    struct HalSimStats_t stats;
+
+    if (!run_pwm_scheme_case(s_pwm_scheme_cases[i].scheme, &stats) || stats.duration_s <= 0.0f) {
+      printf("%-14s did not reach closed-loop operation\n", s_pwm_scheme_cases[i].name);
+      result = 1;
+      continue;
+    }
+
+    float bridge_energy = stats.switch_loss_energy + stats.diode_loss_energy;
+    float device_max = 0.0f;
+    float device_min = bridge_energy;
+
+    for (int device = 0; device < 2 * NUM_MOTOR_PHASES; device++) {
+      device_max = fmaxf(device_max, stats.device_loss_energy[device]);
+      device_min = fminf(device_min, stats.device_loss_energy[device]);
+    }
+
+    float speed_rpm = (stats.velocity_integral / stats.duration_s) * SIM_RAD_PER_S_TO_RPM;
+    float efficiency = (stats.electrical_energy > 0.0f) ? (stats.mechanical_energy / stats.electrical_energy) : 0.0f;
+    float diode_share = (bridge_energy > 0.0f) ? (stats.diode_loss_energy / bridge_energy) : 0.0f;
+
+    /* Device shares are relative to an even split of the bridge losses over the six devices */
+    float even_share = bridge_energy / (2.0f * (float)NUM_MOTOR_PHASES);
+    printf("%-14s %10.1f %11.1f%% %12.3f %11.1f%% %11.2fx %11.2fx\n", s_pwm_scheme_cases[i].name, speed_rpm, 100.0f * efficiency,
+           bridge_energy / stats.duration_s, 100.0f * diode_share, (even_share > 0.0f) ? device_max / even_share : 0.0f,
+           (even_share > 0.0f) ? device_min / even_share : 0.0f);
+  }
+
+  /* Later scenarios run the default scheme */
+  bldc_6step_sensorless_set_pwm_scheme(BLDC6STEP_PWM_H_PWM_L_ON);
+
+  return result;
+}
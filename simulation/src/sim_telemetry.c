@@ -0,0 +1,89 @@
+/*******************************************************************************************************************************
+ * @file   sim_telemetry.c
+ *
+ * @brief  Source file for streaming simulation telemetry through shared memory
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* Inter-component Headers */
+#include "telemetry_ring.h"
+
+/* Intra-component Headers */
+#include "sim_telemetry.h"
+
+static struct TelemetryRing_t s_ring;
+static void *s_memory = NULL;
+static size_t s_memory_size = 0U;
+static uint32_t s_scenario = 0U;
+
+static void publish_sample(const struct HalSimMotorState_t *state, uint32_t time_us, void *context) {
+  (void)context;
+
+  struct SimTelemetryFrame_t frame = { .time_us = time_us, .scenario = s_scenario, .state = *state };
+
+  telemetry_ring_publish(&s_ring, &frame);
+}
+
+int sim_telemetry_open(const char *path, uint32_t capacity, uint32_t period_us) {
+  if (path == NULL || s_memory != NULL) {
+    return -1;
+  }
+
+  size_t memory_size = telemetry_ring_memory_size((uint32_t)sizeof(struct SimTelemetryFrame_t), capacity);
+  int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+  if (fd < 0) {
+    perror(path);
+    return -1;
+  }
+
+  if (ftruncate(fd, (off_t)memory_size) != 0) {
+    perror(path);
+    close(fd);
+    return -1;
+  }
+
+  void *memory = mmap(NULL, memory_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+  /* The mapping holds its own reference to the file */
+  close(fd);
+
+  if (memory == MAP_FAILED) {
+    perror(path);
+    return -1;
+  }
+
+  if (telemetry_ring_init(&s_ring, memory, memory_size, (uint32_t)sizeof(struct SimTelemetryFrame_t), capacity) != UTILS_OK) {
+    munmap(memory, memory_size);
+    return -1;
+  }
+
+  s_memory = memory;
+  s_memory_size = memory_size;
+  hal_sim_set_sample_callback(publish_sample, period_us, NULL);
+
+  return 0;
+}
+
+void sim_telemetry_set_scenario(uint32_t scenario) {
+  s_scenario = scenario;
+}
+
+void sim_telemetry_close(void) {
+  if (s_memory == NULL) {
+    return;
+  }
+
+  hal_sim_set_sample_callback(NULL, 0U, NULL);
+  munmap(s_memory, s_memory_size);
+  s_memory = NULL;
+  s_memory_size = 0U;
+}
@@ -0,0 +1,228 @@
+/*******************************************************************************************************************************
+ * @file   sim_zero_crossing.c
+ *
+ * @brief  Source file for the sensorless 6-step zero-crossing accuracy scenario
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "bldc_6step_sensorless.h"
+#include "hal_sim.h"
+#include "math_utils.h"
+#include "motor.h"
+
+/* Intra-component Headers */
+#include "sim_scenarios.h"
+
+#define SIM_CONTROL_PERIOD_US 50U                  /**< Control loop period (us), 20 kHz */
+#define SIM_SETTLE_TIME_US 2500000U                /**< Time from start before measuring (us) */
+#define SIM_MEASURE_TIME_US 500000U                /**< Measurement window (us) */
+#define SIM_STARTUP_BUS_VOLTAGE 24.0f              /**< Bus voltage the startup duty cycles are tuned for (V) */
+#define SIM_TARGET_DUTY 0.5f                       /**< Closed-loop duty cycle of the run */
+#define SIM_DUTY_RAMP_PER_TICK 0.00005f            /**< Closed-loop duty ramp (per control period), 1 per second */
+#define SIM_LOAD_TORQUE 0.05f                      /**< Load torque of the run (Nm) */
+#define SIM_NOISE_SEED 1U                          /**< Noise seed shared by every case */
+#define SIM_FALSE_DETECTION_DEG 30.0f              /**< Errors beyond this are counted as false detections (electrical degrees) */
+#define SIM_RAD_PER_S_TO_RPM (60.0f / MATH_TWO_PI) /**< Mechanical rad/s to RPM */
+
+/**
+ * @brief   Zero-crossing reference compared by the scenario
+ */
+struct SimZeroCrossingReference_t {
+  const char *name;                  /**< Printed reference name */
+  ZeroCrossingReference_t reference; /**< Driver zero-crossing reference */
+};
+
+/**
+ * @brief   Detection error statistics of one run
+ */
+struct SimZeroCrossingAccuracy_t {
+  uint32_t detections;       /**< Zero-crossings detected in the measurement window */
+  uint32_t false_detections; /**< Detections further than SIM_FALSE_DETECTION_DEG from the back-EMF crossing */
+  float error_sum;           /**< Sum of the detection errors (electrical degrees) */
+  float error_squared_sum;   /**< Sum of the squared detection errors (electrical degrees^2) */
+  float error_max;           /**< Largest absolute detection error (electrical degrees) */
+  float hysteresis_sum;      /**< Sum of the hysteresis in use at each detection (V) */
+};
+
+static const float s_bus_voltages[] = { 12.0f, 24.0f, 36.0f, 48.0f };
+
+static const struct SimZeroCrossingReference_t s_references[] = {
+  { "virtual neutral", ZC_REFERENCE_VIRTUAL_NEUTRAL },
+  { "half bus", ZC_REFERENCE_HALF_BUS },
+};
+
+static void prepare_motor_config(struct MotorConfig_t *config, float bus_voltage) {
+  memset(config, 0, sizeof(*config));
+  config->type = MOTOR_TYPE_BLDC;
+  config->control_method = CONTROL_METHOD_SENSORLESS;
+  config->control_mode = CONTROL_MODE_VOLTAGE;
+  config->pole_pairs = 7U;
+  config->phase_resistance = 0.5f;
+  config->phase_inductance = 0.001f;
+  config->max_current = 40.0f;
+  config->max_voltage = bus_voltage;
+  config->max_velocity = 10000.0f;
+  config->current_pid_config.output_min = 0.0f;
+  config->current_pid_config.output_max = 1.0f;
+
+  config->pwm_config.frequency = 20000U;
+  config->pwm_config.dead_time_ns = 500U;
+  config->pwm_config.resolution = 12U;
+  config->pwm_config.complementary_output = true;
+
+  config->adc_config.sampling_freq = 20000U;
+  config->adc_config.resolution = 12U;
+  config->adc_config.v_ref = 3.3f;
+  config->adc_config.current_gain = 0.1f;
+  config->adc_config.voltage_gain = 0.1f;
+}
+
+static void prepare_startup_config(struct BLDC6StepStartupConfig_t *startup_config, float bus_voltage) {
+  /* Same startup voltages on every bus */
+  float duty_scale = SIM_STARTUP_BUS_VOLTAGE / bus_voltage;
+
+  startup_config->align_duty = 0.1f * duty_scale;
+  startup_config->align_time_us = 100000U;
+  startup_config->initial_period_us = 20000U;
+  startup_config->final_period_us = 4000U;
+  startup_config->acceleration_factor = 0.98f;
+  startup_config->initial_duty = 0.1f * duty_scale;
+  startup_config->duty_increment = 0.0012f * duty_scale;
+  startup_config->num_steps = 150U;
+  startup_config->transition_timeout_us = 200000U;
+}
+
+static void prepare_zero_crossing_config(struct BLDC6StepZeroCrossingConfig_t *zc_config, ZeroCrossingReference_t reference) {
+  zc_config->reference = reference;
+  zc_config->sample_point = 0.5f;
+  zc_config->min_hysteresis = 0.1f;
+  zc_config->noise_gain = 2.0f;
+  zc_config->bemf_fraction = 0.5f;
+}
+
+static void record_detection(struct SimZeroCrossingAccuracy_t *accuracy, struct BLDC6StepSensorlessData_t *bldc_data, MotorPhase_t phase) {
+  int32_t error_us = (int32_t)(bldc_data->last_zc_time - hal_sim_get_bemf_zero_crossing_time(phase));
+  float error_deg = 60.0f * (float)error_us / (float)bldc_data->commutation_period;
+
+  accuracy->detections++;
+  accuracy->hysteresis_sum += bldc_data->zc_hysteresis;
+
+  if (fabsf(error_deg) > SIM_FALSE_DETECTION_DEG) {
+    accuracy->false_detections++;
+    return;
+  }
+
+  accuracy->error_sum += error_deg;
+  accuracy->error_squared_sum += error_deg * error_deg;
+  accuracy->error_max = fmaxf(accuracy->error_max, fabsf(error_deg));
+}
+
+static bool run_zero_crossing_case(float bus_voltage, ZeroCrossingReference_t reference, struct SimZeroCrossingAccuracy_t *accuracy,
+                                   struct HalSimStats_t *stats) {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepStartupConfig_t startup_config;
+  struct BLDC6StepZeroCrossingConfig_t zc_config;
+
+  memset(&motor, 0, sizeof(motor));
+  memset(accuracy, 0, sizeof(*accuracy));
+  prepare_motor_config(&config, bus_voltage);
+  prepare_startup_config(&startup_config, bus_voltage);
+  prepare_zero_crossing_config(&zc_config, reference);
+
+  hal_sim_restart();
+  hal_sim_set_noise_seed(SIM_NOISE_SEED);
+  hal_sim_set_load_torque(SIM_LOAD_TORQUE);
+  hal_sim_set_dc_voltage(bus_voltage);
+
+  bldc_6step_sensorless_set_startup_config(&startup_config);
+  bldc_6step_sensorless_set_zero_crossing_config(&zc_config);
+  bldc_6step_sensorless_create_driver(&motor);
+
+  if (motor.driver.init(&motor, &config) != MOTOR_OK) {
+    return false;
+  }
+
+  struct BLDC6StepSensorlessData_t *bldc_data = (struct BLDC6StepSensorlessData_t *)motor.private_data;
+  bool is_running = true;
+  float duty = -1.0f;
+
+  for (uint32_t elapsed = 0U; elapsed < SIM_SETTLE_TIME_US + SIM_MEASURE_TIME_US; elapsed += SIM_CONTROL_PERIOD_US) {
+    if (elapsed == SIM_SETTLE_TIME_US) {
+      hal_sim_reset_stats();
+    }
+
+    /* The duty setpoint takes over from the startup duty once closed-loop and ramps to the target */
+    if (bldc_data->mode == MOTOR_MODE_RUNNING) {
+      if (duty < 0.0f) {
+        duty = bldc_data->pwm_duty;
+      }
+      duty = fminf(duty + SIM_DUTY_RAMP_PER_TICK, SIM_TARGET_DUTY);
+      motor.driver.set_voltage(&motor, duty * config.max_voltage);
+    }
+
+    uint32_t last_zc_time = bldc_data->last_zc_time;
+    MotorPhase_t floating_phase = _6step_bldc_determine_floating_phase(bldc_data->step);
+
+    if (motor_run(&motor) != MOTOR_OK) {
+      is_running = false;
+      break;
+    }
+
+    if (elapsed >= SIM_SETTLE_TIME_US && bldc_data->last_zc_time != last_zc_time) {
+      record_detection(accuracy, bldc_data, floating_phase);
+    }
+
+    hal_sim_advance_us(SIM_CONTROL_PERIOD_US);
+  }
+
+  is_running = is_running && (bldc_data->mode == MOTOR_MODE_RUNNING);
+  hal_sim_get_stats(stats);
+  motor.driver.deinit(&motor);
+
+  return is_running;
+}
+
+int sim_scenario_zero_crossing_accuracy(void) {
+  int result = 0;
+
+  hal_sim_set_verbose(false);
+
+  printf("Sensorless 6-step zero-crossing accuracy: %.0f%% duty, %.3f Nm load, errors in electrical degrees\n", SIM_TARGET_DUTY * 100.0f,
+         SIM_LOAD_TORQUE);
+  printf("%-6s %-16s %10s %6s %6s %10s %10s %10s %10s\n", "vbus", "reference", "speed_rpm", "zcs", "false", "mean_err", "jitter",
+         "max_err", "hyst_v");
+
+  for (size_t i = 0U; i < sizeof(s_bus_voltages) / sizeof(s_bus_voltages[0]); i++) {
+    for (size_t j = 0U; j < sizeof(s_references) / sizeof(s_references[0]); j++) {
+      struct SimZeroCrossingAccuracy_t accuracy;
+      struct HalSimStats_t stats;
+
+      if (!run_zero_crossing_case(s_bus_voltages[i], s_references[j].reference, &accuracy, &stats) || stats.duration_s <= 0.0f) {
+        printf("%-6.0f %-16s did not reach closed-loop operation\n", s_bus_voltages[i], s_references[j].name);
+        result = 1;
+        continue;
+      }
+
+      uint32_t valid_detections = accuracy.detections - accuracy.false_detections;
+      float error_mean = (valid_detections > 0U) ? (accuracy.error_sum / (float)valid_detections) : 0.0f;
+      float error_variance = (valid_detections > 0U) ? (accuracy.error_squared_sum / (float)valid_detections - error_mean * error_mean) : 0.0f;
+      float hysteresis_mean = (accuracy.detections > 0U) ? (accuracy.hysteresis_sum / (float)accuracy.detections) : 0.0f;
+      float speed_rpm = (stats.velocity_integral / stats.duration_s) * SIM_RAD_PER_S_TO_RPM;
+
+      printf("%-6.0f %-16s %10.1f %6u %6u %10.2f %10.2f %10.2f %10.3f\n", s_bus_voltages[i], s_references[j].name, speed_rpm,
+             (unsigned int)accuracy.detections, (unsigned int)accuracy.false_detections, error_mean, sqrtf(fmaxf(error_variance, 0.0f)),
+             accuracy.error_max, hysteresis_mean);
+    }
+  }
+
+  return result;
+}
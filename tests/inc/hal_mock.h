@@ -27,10 +27,18 @@ void hal_mock_reset();
 
 void hal_mock_set_test_micros(uint32_t micros);
 
-uint16_t *hal_mock_get_test_pwm_duty_cycles();
+void hal_mock_set_test_hall_state(uint8_t hall_state);
+
+void hal_mock_push_test_hall_edge(uint32_t timestamp_us, uint8_t hall_state);
+
+float *hal_mock_get_test_pwm_duty_cycles();
 
 uint8_t *hal_mock_get_test_gpio_states();
 
+uint16_t hal_mock_get_test_gate_mask();
+
+uint32_t hal_mock_get_test_gate_write_count();
+
 float *hal_mock_get_test_phase_voltages();
 
 float *hal_mock_get_test_phase_currents();
@@ -39,4 +47,14 @@ void hal_mock_set_test_phase_voltage(MotorPhase_t phase, float voltage);
 
 void hal_mock_set_test_phase_current(MotorPhase_t phase, float current);
 
+void hal_mock_set_test_dc_voltage(float voltage);
+
+float hal_mock_get_test_adc_pwm_trigger();
+
+bool hal_mock_is_test_timer_armed();
+
+uint32_t hal_mock_get_test_timer_fire_time();
+
+void hal_mock_fire_test_timer();
+
 /** @} */
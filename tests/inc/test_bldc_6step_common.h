@@ -0,0 +1,29 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   test_bldc_6step_common.h
+ *
+ * @brief  Header file for the common 6-step BLDC function tests
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup TestHeaders Test files
+ * @brief    Test headers for 3-phase inverters
+ * @{
+ */
+
+/**
+ * @brief   Run common 6-step BLDC function tests
+ */
+void run_bldc_6step_common_tests();
+
+/** @} */
@@ -0,0 +1,29 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   test_bldc_sensored_driver.h
+ *
+ * @brief  Header file for BLDC sensored driver tests
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup TestHeaders Test files
+ * @brief    Test headers for 3-phase inverters
+ * @{
+ */
+
+/**
+ * @brief   Run BLDC sensored driver tests
+ */
+void run_bldc_sensored_driver_tests();
+
+/** @} */
@@ -0,0 +1,29 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   test_foc_sensorless_driver.h
+ *
+ * @brief  Header file for sensorless FOC driver tests
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup TestHeaders Test files
+ * @brief    Test headers for 3-phase inverters
+ * @{
+ */
+
+/**
+ * @brief   Run sensorless FOC driver, back-EMF PLL and high-frequency injection observer tests
+ */
+void run_foc_sensorless_driver_tests();
+
+/** @} */
@@ -0,0 +1,29 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   test_hall_estimator.h
+ *
+ * @brief  Header file for Hall estimator tests
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup TestHeaders Test files
+ * @brief    Test headers for 3-phase inverters
+ * @{
+ */
+
+/**
+ * @brief   Run Hall estimator tests
+ */
+void run_hall_estimator_tests();
+
+/** @} */
@@ -0,0 +1,29 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   test_pll.h
+ *
+ * @brief  Header file for PLL tests
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup TestHeaders Test files
+ * @brief    Test headers for 3-phase inverters
+ * @{
+ */
+
+/**
+ * @brief   Run PLL tests
+ */
+void run_pll_tests();
+
+/** @} */
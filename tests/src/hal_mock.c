@@ -9,6 +9,7 @@
 
 /* Standard library Headers */
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -18,13 +19,28 @@
 /* Intra-component Headers */
 
 /* Global variables used by our HAL stubs */
-static uint16_t test_pwm_duty[NUM_MOTOR_PHASES] = { 0 };
+static float test_pwm_duty[NUM_MOTOR_PHASES] = { 0 };
 static uint8_t test_gpio_state[NUM_MOTOR_PHASES] = { 0 };
+static uint16_t test_gate_mask = 0;
+static uint32_t test_gate_write_count = 0;
 
 /* For our test: 0 = float, 1 = low, 2 = PWM (set via hal_pwm_set_duty) */
 static float test_phase_voltages[NUM_MOTOR_PHASES] = { 0 };
 static float test_phase_currents[NUM_MOTOR_PHASES] = { 0 };
+static float test_dc_voltage = 24.0f;
+static float test_adc_pwm_trigger = -1.0f;
 static uint32_t test_micros = 0;
+static uint8_t test_hall_state = 0;
+
+static bool test_timer_armed = false;
+static uint32_t test_timer_fire_time = 0;
+static HalTimerCallback_t test_timer_callback = NULL;
+static void *test_timer_context = NULL;
+
+#define TEST_HALL_EDGE_QUEUE_SIZE 16U
+static struct HallEdge_t test_hall_edges[TEST_HALL_EDGE_QUEUE_SIZE] = { 0 };
+static uint8_t test_hall_edge_head = 0;
+static uint8_t test_hall_edge_count = 0;
 
 bool hal_pwm_init(struct PwmConfig_t *config) {
   (void)config;
@@ -40,8 +56,9 @@ bool hal_gpio_init() {
   return true;
 }
 
-void hal_pwm_set_duty(MotorPhase_t phase, uint16_t duty) {
+void hal_pwm_set_duty(MotorPhase_t phase, float duty) {
   if (phase < NUM_MOTOR_PHASES) {
+    test_gate_write_count++;
     test_pwm_duty[phase] = duty;
     test_gpio_state[phase] = 2U; /* 2 = PWM */
   }
@@ -49,20 +66,54 @@ void hal_pwm_set_duty(MotorPhase_t phase, uint16_t duty) {
 
 void hal_gpio_set_phase_low(MotorPhase_t phase) {
   if (phase < NUM_MOTOR_PHASES) {
+    test_gate_write_count++;
     test_gpio_state[phase] = 1U; /* 1 = LOW */
   }
 }
 
 void hal_gpio_set_phase_float(MotorPhase_t phase) {
   if (phase < NUM_MOTOR_PHASES) {
+    test_gate_write_count++;
     test_gpio_state[phase] = 0U; /* 0 = float */
   }
 }
 
+void hal_pwm_set_gates(uint16_t gate_mask, float duty) {
+  test_gate_mask = gate_mask;
+  test_gate_write_count++;
+
+  for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+    bool is_high = (gate_mask & HAL_GATE_HIGH(phase)) != 0U;
+    bool is_low = (gate_mask & HAL_GATE_LOW(phase)) != 0U;
+    bool is_pwm = (gate_mask & HAL_GATE_PWM(phase)) != 0U;
+
+    test_pwm_duty[phase] = is_pwm ? duty : 0.0f;
+
+    if (is_high && is_low) {
+      test_gpio_state[phase] = is_pwm ? 5U : 0U; /* 5 = complementary PWM, shoot-through floats */
+    } else if (is_high) {
+      test_gpio_state[phase] = is_pwm ? 2U : 3U; /* 2 = PWM, 3 = HIGH */
+    } else if (is_low) {
+      test_gpio_state[phase] = is_pwm ? 4U : 1U; /* 4 = low side PWM, 1 = LOW */
+    } else {
+      test_gpio_state[phase] = 0U; /* 0 = float */
+    }
+  }
+}
+
 void hal_adc_start_conversion() {
   /* In tests conversion is immediate */
 }
 
+bool hal_adc_set_pwm_trigger(float on_time_fraction) {
+  if (on_time_fraction < 0.0f || on_time_fraction > 1.0f) {
+    return false;
+  }
+
+  test_adc_pwm_trigger = on_time_fraction;
+  return true;
+}
+
 void hal_adc_get_phase_voltages(float *voltages) {
   for (int i = 0; i < NUM_MOTOR_PHASES; i++) {
     voltages[i] = test_phase_voltages[i];
@@ -80,9 +131,9 @@ float hal_adc_get_temperature() {
   return 25.0f;
 }
 
-/* Return a fixed DC voltage */
+/* Return the test DC voltage */
 float hal_adc_get_dc_voltage() {
-  return 24.0f;
+  return test_dc_voltage;
 }
 
 /* Return a simulated microsecond timestamp */
@@ -92,6 +143,22 @@ uint32_t hal_get_micros() {
 
 void hal_delay_us(uint32_t delay_us) {}
 
+bool hal_timer_schedule(uint32_t fire_time_us, HalTimerCallback_t callback, void *context) {
+  if (callback == NULL) {
+    return false;
+  }
+
+  test_timer_armed = true;
+  test_timer_fire_time = fire_time_us;
+  test_timer_callback = callback;
+  test_timer_context = context;
+  return true;
+}
+
+void hal_timer_cancel() {
+  test_timer_armed = false;
+}
+
 void hal_delay_ms(uint32_t delay_ms) {}
 
 bool hal_gpio_init_hall_sensors() {
@@ -99,7 +166,48 @@ bool hal_gpio_init_hall_sensors() {
 }
 
 uint8_t hal_gpio_get_hall_state() {
-  return 0;
+  return test_hall_state;
+}
+
+bool hal_hall_capture_init() {
+  test_hall_edge_head = 0U;
+  test_hall_edge_count = 0U;
+  return true;
+}
+
+bool hal_hall_capture_pop(struct HallEdge_t *edge) {
+  if (edge == NULL || test_hall_edge_count == 0U) {
+    return false;
+  }
+
+  *edge = test_hall_edges[test_hall_edge_head];
+  test_hall_edge_head = (test_hall_edge_head + 1U) % TEST_HALL_EDGE_QUEUE_SIZE;
+  test_hall_edge_count--;
+  return true;
+}
+
+bool hal_encoder_init() {
+  return true;
+}
+
+float hal_encoder_get_position() {
+  return 0.0f;
+}
+
+float hal_encoder_get_velocity() {
+  return 0.0f;
+}
+
+void hal_set_pwm(struct PwmConfig_t *config, float duty_a, float duty_b, float duty_c) {
+  (void)config;
+  test_gate_write_count++;
+  test_pwm_duty[MOTOR_PHASE_A] = duty_a;
+  test_pwm_duty[MOTOR_PHASE_B] = duty_b;
+  test_pwm_duty[MOTOR_PHASE_C] = duty_c;
+
+  for (uint8_t phase = 0U; phase < NUM_MOTOR_PHASES; phase++) {
+    test_gpio_state[phase] = 5U; /* 5 = complementary PWM */
+  }
 }
 
 /*******************************************************************************************************************************
@@ -109,19 +217,54 @@ uint8_t hal_gpio_get_hall_state() {
 void hal_mock_reset() {
   memset(test_pwm_duty, 0, sizeof(test_pwm_duty));
   memset(test_gpio_state, 0, sizeof(test_gpio_state));
+  test_gate_mask = 0;
+  test_gate_write_count = 0;
   memset(test_phase_voltages, 0, sizeof(test_phase_voltages));
   memset(test_phase_currents, 0, sizeof(test_phase_currents));
+  test_dc_voltage = 24.0f;
+  test_adc_pwm_trigger = -1.0f;
   test_micros = 1000; /* start time in microseconds */
+  test_hall_state = 0;
+  memset(test_hall_edges, 0, sizeof(test_hall_edges));
+  test_hall_edge_head = 0;
+  test_hall_edge_count = 0;
+  test_timer_armed = false;
+  test_timer_fire_time = 0;
+  test_timer_callback = NULL;
+  test_timer_context = NULL;
 }
 
 void hal_mock_set_test_micros(uint32_t micros) {
   test_micros = micros;
 }
 
-uint16_t *hal_mock_get_test_pwm_duty_cycles() {
+void hal_mock_set_test_hall_state(uint8_t hall_state) {
+  test_hall_state = hall_state;
+}
+
+void hal_mock_push_test_hall_edge(uint32_t timestamp_us, uint8_t hall_state) {
+  if (test_hall_edge_count < TEST_HALL_EDGE_QUEUE_SIZE) {
+    uint8_t tail = (test_hall_edge_head + test_hall_edge_count) % TEST_HALL_EDGE_QUEUE_SIZE;
+    test_hall_edges[tail].timestamp_us = timestamp_us;
+    test_hall_edges[tail].hall_state = hall_state;
+    test_hall_edge_count++;
+  }
+
+  test_hall_state = hall_state;
+}
+
+float *hal_mock_get_test_pwm_duty_cycles() {
   return test_pwm_duty;
 }
 
+uint16_t hal_mock_get_test_gate_mask() {
+  return test_gate_mask;
+}
+
+uint32_t hal_mock_get_test_gate_write_count() {
+  return test_gate_write_count;
+}
+
 uint8_t *hal_mock_get_test_gpio_states() {
   return test_gpio_state;
 }
@@ -141,3 +284,28 @@ void hal_mock_set_test_phase_voltage(MotorPhase_t phase, float voltage) {
 void hal_mock_set_test_phase_current(MotorPhase_t phase, float current) {
   test_phase_currents[phase] = current;
 }
+
+void hal_mock_set_test_dc_voltage(float voltage) {
+  test_dc_voltage = voltage;
+}
+
+float hal_mock_get_test_adc_pwm_trigger() {
+  return test_adc_pwm_trigger;
+}
+
+bool hal_mock_is_test_timer_armed() {
+  return test_timer_armed;
+}
+
+uint32_t hal_mock_get_test_timer_fire_time() {
+  return test_timer_fire_time;
+}
+
+void hal_mock_fire_test_timer() {
+  if (test_timer_armed) {
+    /* Fire at the scheduled time, like the hardware timer would */
+    test_timer_armed = false;
+    test_micros = test_timer_fire_time;
+    test_timer_callback(test_timer_context);
+  }
+}
@@ -0,0 +1,224 @@
+/*******************************************************************************************************************************
+ * @file   test_bldc_6step_common.c
+ *
+ * @brief  Source file for the common 6-step BLDC function tests
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stdint.h>
+
+/* Inter-component Headers */
+#include "bldc_6step_common.h"
+#include "hal.h"
+#include "math_utils.h"
+#include "unity.h"
+
+/* Intra-component Headers */
+#include "hal_mock.h"
+#include "test_bldc_6step_common.h"
+
+#define TEST_PWM_DUTY 0.4f
+
+#define TEST_PROFILE_DT 0.001f /**< Position profile update period (s) */
+
+#define TEST_GPIO_LOW 1U           /**< hal_mock state of a low side held on */
+#define TEST_GPIO_HIGH_PWM 2U      /**< hal_mock state of a modulated high side */
+#define TEST_GPIO_HIGH 3U          /**< hal_mock state of a high side held on */
+#define TEST_GPIO_LOW_PWM 4U       /**< hal_mock state of a modulated low side */
+#define TEST_GPIO_COMPLEMENTARY 5U /**< hal_mock state of a complementary leg */
+
+/* Helper: Apply a commutation step and check it took one HAL write with the given leg states */
+static void assert_scheme_outputs(BLDC6StepPwmScheme_t scheme, uint8_t step, MotorPhase_t high_phase, MotorPhase_t low_phase,
+                                  uint8_t high_state, uint8_t low_state) {
+  MotorPhase_t floating_phase = (MotorPhase_t)(NUM_MOTOR_PHASES - high_phase - low_phase);
+  uint16_t high_mask = HAL_GATE_HIGH(high_phase) | ((high_state == TEST_GPIO_HIGH) ? 0U : HAL_GATE_PWM(high_phase));
+  uint16_t low_mask = HAL_GATE_LOW(low_phase) | ((low_state == TEST_GPIO_LOW) ? 0U : HAL_GATE_PWM(low_phase));
+
+  if (high_state == TEST_GPIO_COMPLEMENTARY) {
+    high_mask |= HAL_GATE_LOW(high_phase);
+  }
+  if (low_state == TEST_GPIO_COMPLEMENTARY) {
+    low_mask |= HAL_GATE_HIGH(low_phase);
+  }
+
+  hal_mock_reset();
+
+  _6step_bldc_set_phase_outputs(scheme, step, TEST_PWM_DUTY);
+
+  uint8_t *gpio_states = hal_mock_get_test_gpio_states();
+  float *pwm_duty = hal_mock_get_test_pwm_duty_cycles();
+
+  TEST_ASSERT_EQUAL_UINT32(1U, hal_mock_get_test_gate_write_count());
+  TEST_ASSERT_EQUAL_HEX16(high_mask | low_mask, hal_mock_get_test_gate_mask());
+  TEST_ASSERT_EQUAL_UINT8(high_state, gpio_states[high_phase]);
+  TEST_ASSERT_EQUAL_UINT8(low_state, gpio_states[low_phase]);
+  TEST_ASSERT_EQUAL_UINT8(0U, gpio_states[floating_phase]);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, (high_state == TEST_GPIO_HIGH) ? 0.0f : TEST_PWM_DUTY, pwm_duty[high_phase]);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, (low_state == TEST_GPIO_LOW) ? 0.0f : TEST_PWM_DUTY, pwm_duty[low_phase]);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, pwm_duty[floating_phase]);
+  TEST_ASSERT_EQUAL(floating_phase, _6step_bldc_determine_floating_phase(step));
+}
+
+/* Helper: Default H_PWM-L_ON step, the high side modulates and the low side is held on */
+static void assert_step_outputs(uint8_t step, MotorPhase_t high_phase, MotorPhase_t low_phase) {
+  assert_scheme_outputs(BLDC6STEP_PWM_H_PWM_L_ON, step, high_phase, low_phase, TEST_GPIO_HIGH_PWM, TEST_GPIO_LOW);
+}
+
+void test_bldc_6step_common_step_0() {
+  assert_step_outputs(0U, MOTOR_PHASE_A, MOTOR_PHASE_B);
+}
+
+void test_bldc_6step_common_step_1() {
+  assert_step_outputs(1U, MOTOR_PHASE_A, MOTOR_PHASE_C);
+}
+
+void test_bldc_6step_common_step_2() {
+  assert_step_outputs(2U, MOTOR_PHASE_B, MOTOR_PHASE_C);
+}
+
+void test_bldc_6step_common_step_3() {
+  assert_step_outputs(3U, MOTOR_PHASE_B, MOTOR_PHASE_A);
+}
+
+void test_bldc_6step_common_step_4() {
+  assert_step_outputs(4U, MOTOR_PHASE_C, MOTOR_PHASE_A);
+}
+
+void test_bldc_6step_common_step_5() {
+  assert_step_outputs(5U, MOTOR_PHASE_C, MOTOR_PHASE_B);
+}
+
+void test_bldc_6step_common_h_on_l_pwm() {
+  assert_scheme_outputs(BLDC6STEP_PWM_H_ON_L_PWM, 0U, MOTOR_PHASE_A, MOTOR_PHASE_B, TEST_GPIO_HIGH, TEST_GPIO_LOW_PWM);
+  assert_scheme_outputs(BLDC6STEP_PWM_H_ON_L_PWM, 3U, MOTOR_PHASE_B, MOTOR_PHASE_A, TEST_GPIO_HIGH, TEST_GPIO_LOW_PWM);
+}
+
+void test_bldc_6step_common_complementary() {
+  assert_scheme_outputs(BLDC6STEP_PWM_COMPLEMENTARY, 1U, MOTOR_PHASE_A, MOTOR_PHASE_C, TEST_GPIO_COMPLEMENTARY, TEST_GPIO_LOW);
+  assert_scheme_outputs(BLDC6STEP_PWM_COMPLEMENTARY, 4U, MOTOR_PHASE_C, MOTOR_PHASE_A, TEST_GPIO_COMPLEMENTARY, TEST_GPIO_LOW);
+}
+
+void test_bldc_6step_common_alternating() {
+  /* Each switch is held on in the first of its two conducting steps and modulates in the second */
+  assert_scheme_outputs(BLDC6STEP_PWM_ALTERNATING, 0U, MOTOR_PHASE_A, MOTOR_PHASE_B, TEST_GPIO_HIGH, TEST_GPIO_LOW_PWM);
+  assert_scheme_outputs(BLDC6STEP_PWM_ALTERNATING, 1U, MOTOR_PHASE_A, MOTOR_PHASE_C, TEST_GPIO_HIGH_PWM, TEST_GPIO_LOW);
+  assert_scheme_outputs(BLDC6STEP_PWM_ALTERNATING, 2U, MOTOR_PHASE_B, MOTOR_PHASE_C, TEST_GPIO_HIGH, TEST_GPIO_LOW_PWM);
+  assert_scheme_outputs(BLDC6STEP_PWM_ALTERNATING, 5U, MOTOR_PHASE_C, MOTOR_PHASE_B, TEST_GPIO_HIGH_PWM, TEST_GPIO_LOW);
+}
+
+void test_bldc_6step_common_invalid_scheme_floats() {
+  hal_mock_reset();
+
+  _6step_bldc_set_phase_outputs(NUM_BLDC6STEP_PWM_SCHEMES, 0U, TEST_PWM_DUTY);
+
+  TEST_ASSERT_EQUAL_UINT32(1U, hal_mock_get_test_gate_write_count());
+  TEST_ASSERT_EQUAL_HEX16(HAL_GATES_FLOAT, hal_mock_get_test_gate_mask());
+}
+
+void test_bldc_6step_common_stop_pwm_output() {
+  hal_mock_reset();
+  _6step_bldc_set_phase_outputs(BLDC6STEP_PWM_H_PWM_L_ON, 0U, TEST_PWM_DUTY);
+
+  _6step_bldc_stop_pwm_output();
+
+  uint8_t *gpio_states = hal_mock_get_test_gpio_states();
+  TEST_ASSERT_EQUAL_UINT32(2U, hal_mock_get_test_gate_write_count());
+  TEST_ASSERT_EQUAL_HEX16(HAL_GATES_FLOAT, hal_mock_get_test_gate_mask());
+
+  for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+    TEST_ASSERT_EQUAL_UINT8(0U, gpio_states[phase]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, hal_mock_get_test_pwm_duty_cycles()[phase]);
+  }
+}
+
+/* Helper: Run the profile to rest and return the move time, storing the largest reference speed (steps/s) */
+static float run_position_profile(struct BLDC6StepPositionProfile_t *profile, const struct BLDC6StepPositionConfig_t *config,
+                                  float *peak_velocity) {
+  float time = 0.0f;
+  *peak_velocity = 0.0f;
+
+  do {
+    _6step_bldc_position_profile_update(profile, config, TEST_PROFILE_DT);
+    *peak_velocity = fmaxf(*peak_velocity, fabsf(profile->velocity));
+    time += TEST_PROFILE_DT;
+  } while (profile->velocity != 0.0f && time < 10.0f);
+
+  return time;
+}
+
+void test_bldc_6step_common_position_steps() {
+  TEST_ASSERT_EQUAL_INT32(42, _6step_bldc_position_to_steps(MATH_TWO_PI, 7U));
+  TEST_ASSERT_EQUAL_INT32(-3, _6step_bldc_position_to_steps(-MATH_PI, 1U));
+  TEST_ASSERT_EQUAL_INT32(1, _6step_bldc_position_to_steps(1.2f, 0U));
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, MATH_TWO_PI, _6step_bldc_steps_to_position(42, 7U));
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, -MATH_PI_OVER_3, _6step_bldc_steps_to_position(-1, 0U));
+}
+
+void test_bldc_6step_common_position_profile_trapezoid() {
+  /* 300 steps/s cruise and 2000 steps/s^2, so 100 steps take 100 / 300 + 300 / 2000 seconds */
+  struct BLDC6StepPositionConfig_t config = { .cruise_velocity = 3000.0f, .acceleration = 20000.0f };
+  struct BLDC6StepPositionProfile_t profile;
+  float peak_velocity;
+
+  _6step_bldc_position_profile_reset(&profile, 0);
+  profile.target = 100;
+
+  float move_time = run_position_profile(&profile, &config, &peak_velocity);
+
+  TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.4833f, move_time);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 300.0f, peak_velocity);
+  TEST_ASSERT_EQUAL_FLOAT(100.0f, profile.position);
+}
+
+void test_bldc_6step_common_position_profile_triangle() {
+  /* Too short to reach cruise. Peaks at sqrt(a * d) and stops on the target in reverse */
+  struct BLDC6StepPositionConfig_t config = { .cruise_velocity = 3000.0f, .acceleration = 20000.0f };
+  struct BLDC6StepPositionProfile_t profile;
+  float peak_velocity;
+
+  _6step_bldc_position_profile_reset(&profile, 5);
+  profile.target = -5;
+
+  float velocity_feedforward = _6step_bldc_position_profile_update(&profile, &config, TEST_PROFILE_DT);
+  TEST_ASSERT_TRUE(velocity_feedforward < 0.0f);
+
+  float move_time = run_position_profile(&profile, &config, &peak_velocity);
+
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 2.0f * sqrtf(10.0f / 2000.0f), move_time);
+  TEST_ASSERT_FLOAT_WITHIN(3.0f, sqrtf(2000.0f * 10.0f), peak_velocity);
+  TEST_ASSERT_EQUAL_FLOAT(-5.0f, profile.position);
+}
+
+void test_bldc_6step_common_position_profile_no_limits() {
+  struct BLDC6StepPositionConfig_t config = { .cruise_velocity = 0.0f, .acceleration = 20000.0f };
+  struct BLDC6StepPositionProfile_t profile;
+
+  _6step_bldc_position_profile_reset(&profile, 0);
+  profile.target = 12;
+
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, _6step_bldc_position_profile_update(&profile, &config, TEST_PROFILE_DT));
+  TEST_ASSERT_EQUAL_FLOAT(12.0f, profile.position);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, profile.velocity);
+}
+
+void run_bldc_6step_common_tests() {
+  RUN_TEST(test_bldc_6step_common_step_0);
+  RUN_TEST(test_bldc_6step_common_step_1);
+  RUN_TEST(test_bldc_6step_common_step_2);
+  RUN_TEST(test_bldc_6step_common_step_3);
+  RUN_TEST(test_bldc_6step_common_step_4);
+  RUN_TEST(test_bldc_6step_common_step_5);
+  RUN_TEST(test_bldc_6step_common_h_on_l_pwm);
+  RUN_TEST(test_bldc_6step_common_complementary);
+  RUN_TEST(test_bldc_6step_common_alternating);
+  RUN_TEST(test_bldc_6step_common_invalid_scheme_floats);
+  RUN_TEST(test_bldc_6step_common_stop_pwm_output);
+  RUN_TEST(test_bldc_6step_common_position_steps);
+  RUN_TEST(test_bldc_6step_common_position_profile_trapezoid);
+  RUN_TEST(test_bldc_6step_common_position_profile_triangle);
+  RUN_TEST(test_bldc_6step_common_position_profile_no_limits);
+}
@@ -0,0 +1,308 @@
+/*******************************************************************************************************************************
+ * @file   test_bldc_sensored_driver.c
+ *
+ * @brief  Source file for the BLDC sensored driver tests
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "bldc_6step_sensored.h"
+#include "hal.h"
+#include "math_utils.h"
+#include "motor.h"
+#include "unity.h"
+
+/* Intra-component Headers */
+#include "hal_mock.h"
+#include "test_bldc_sensored_driver.h"
+
+/* Forward Hall sequence, index matches the commutation step it selects */
+static const uint8_t test_hall_sequence[NUM_COMMUTATION_STEPS] = { 0b011, 0b001, 0b101, 0b100, 0b110, 0b010 };
+
+static struct Motor_t test_motor;
+static struct MotorConfig_t test_config;
+
+/* Helper: Prepare a valid motor configuration */
+static void prepare_valid_config(struct MotorConfig_t *config) {
+  memset(config, 0, sizeof(*config));
+  config->type = MOTOR_TYPE_BLDC;
+  config->control_method = CONTROL_METHOD_SIX_STEP;
+  config->control_mode = CONTROL_MODE_VOLTAGE;
+  config->pole_pairs = 1;
+  config->max_current = 20.0f;
+  config->max_voltage = 24.0f;
+  config->max_velocity = 1000.0f;
+
+  config->pwm_config.frequency = 20000;
+  config->pwm_config.resolution = 12;
+  config->adc_config.sampling_freq = 20000;
+  config->adc_config.resolution = 12;
+}
+
+/* Helper: Reset the mock and initialize the driver with the rotor in Hall sector 0 */
+static void init_sensored_motor() {
+  hal_mock_reset();
+  hal_mock_set_test_hall_state(test_hall_sequence[0]);
+  bldc_6step_sensored_set_pwm_scheme(BLDC6STEP_PWM_H_PWM_L_ON);
+
+  bldc_6step_sensored_create_driver(&test_motor);
+  prepare_valid_config(&test_config);
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.init(&test_motor, &test_config));
+  test_motor.state.last_update_time = 1000;
+}
+
+/* Helper: Push forward Hall edges for sectors [first, first + count) spaced by period_us, starting at start_us */
+static void push_forward_edges(uint8_t first, uint8_t count, uint32_t start_us, uint32_t period_us) {
+  for (uint8_t i = 0U; i < count; i++) {
+    hal_mock_push_test_hall_edge(start_us + i * period_us, test_hall_sequence[(first + i) % NUM_COMMUTATION_STEPS]);
+  }
+}
+
+static struct BLDC6StepSensoredData_t *get_sensored_data() {
+  return (struct BLDC6StepSensoredData_t *)test_motor.private_data;
+}
+
+void test_bldc_sensored_driver_init_success() {
+  init_sensored_motor();
+
+  TEST_ASSERT_TRUE(test_motor.state.is_initialized);
+  TEST_ASSERT_EQUAL(MOTOR_MODE_RUNNING, get_sensored_data()->mode);
+  TEST_ASSERT_EQUAL_UINT8(0U, get_sensored_data()->step);
+}
+
+void test_bldc_sensored_driver_init_invalid_hall() {
+  hal_mock_reset();
+  hal_mock_set_test_hall_state(0b111);
+
+  bldc_6step_sensored_create_driver(&test_motor);
+  prepare_valid_config(&test_config);
+  TEST_ASSERT_EQUAL(MOTOR_INIT_ERROR, test_motor.driver.init(&test_motor, &test_config));
+}
+
+void test_bldc_sensored_driver_commutates_on_captured_edge() {
+  init_sensored_motor();
+
+  hal_mock_push_test_hall_edge(1500, test_hall_sequence[1]);
+  hal_mock_set_test_micros(2000);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.update_state(&test_motor));
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.commutate(&test_motor));
+
+  /* Step 2: A-High, C-Low, B floating */
+  uint8_t *gpio_states = hal_mock_get_test_gpio_states();
+  TEST_ASSERT_EQUAL_UINT8(1U, get_sensored_data()->step);
+  TEST_ASSERT_EQUAL_UINT8(2U, gpio_states[MOTOR_PHASE_A]);
+  TEST_ASSERT_EQUAL_UINT8(0U, gpio_states[MOTOR_PHASE_B]);
+  TEST_ASSERT_EQUAL_UINT8(1U, gpio_states[MOTOR_PHASE_C]);
+  TEST_ASSERT_EQUAL_UINT32(1500U, get_sensored_data()->last_commutation_time);
+}
+
+void test_bldc_sensored_driver_complementary_scheme() {
+  init_sensored_motor();
+  bldc_6step_sensored_set_pwm_scheme(BLDC6STEP_PWM_COMPLEMENTARY);
+
+  hal_mock_push_test_hall_edge(1500, test_hall_sequence[1]);
+  hal_mock_set_test_micros(2000);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.update_state(&test_motor));
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.commutate(&test_motor));
+
+  /* Step 2 with synchronous rectification: A complementary, C held low, B floating */
+  uint8_t *gpio_states = hal_mock_get_test_gpio_states();
+  TEST_ASSERT_EQUAL_UINT8(5U, gpio_states[MOTOR_PHASE_A]);
+  TEST_ASSERT_EQUAL_UINT8(0U, gpio_states[MOTOR_PHASE_B]);
+  TEST_ASSERT_EQUAL_UINT8(1U, gpio_states[MOTOR_PHASE_C]);
+}
+
+void test_bldc_sensored_driver_ignores_polled_state_without_edge() {
+  init_sensored_motor();
+
+  hal_mock_set_test_hall_state(test_hall_sequence[1]);
+  hal_mock_set_test_micros(2000);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.update_state(&test_motor));
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.commutate(&test_motor));
+  TEST_ASSERT_EQUAL_UINT8(0U, get_sensored_data()->step);
+}
+
+void test_bldc_sensored_driver_skips_illegal_edge() {
+  init_sensored_motor();
+
+  /* A glitch between two legal edges is dropped, the next legal edge still commutates */
+  hal_mock_push_test_hall_edge(1500, 0b111);
+  hal_mock_set_test_micros(1800);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.update_state(&test_motor));
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.commutate(&test_motor));
+  TEST_ASSERT_EQUAL_UINT8(test_hall_sequence[0], get_sensored_data()->last_hall_state);
+  TEST_ASSERT_EQUAL_UINT8(0U, get_sensored_data()->step);
+
+  hal_mock_push_test_hall_edge(2000, 0b000);
+  hal_mock_push_test_hall_edge(2100, test_hall_sequence[1]);
+  hal_mock_set_test_micros(2500);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.update_state(&test_motor));
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.commutate(&test_motor));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_RUNNING, get_sensored_data()->mode);
+  TEST_ASSERT_EQUAL_UINT8(1U, get_sensored_data()->step);
+  TEST_ASSERT_EQUAL_UINT8(0U, get_sensored_data()->invalid_edges);
+}
+
+void test_bldc_sensored_driver_consecutive_illegal_edges_fault() {
+  init_sensored_motor();
+
+  for (uint8_t i = 0U; i < BLDC6STEP_SENSORED_MAX_INVALID_EDGES; i++) {
+    hal_mock_push_test_hall_edge(1500U + i * 100U, 0b111);
+  }
+  hal_mock_set_test_micros(2000);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.update_state(&test_motor));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_RUNNING, get_sensored_data()->mode);
+
+  hal_mock_push_test_hall_edge(2100, 0b000);
+  hal_mock_set_test_micros(2500);
+
+  TEST_ASSERT_EQUAL(MOTOR_HAL_ERROR, test_motor.driver.update_state(&test_motor));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_ERROR, get_sensored_data()->mode);
+}
+
+void test_bldc_sensored_driver_speed_from_capture_timestamps() {
+  init_sensored_motor();
+
+  /* All edges land between two control cycles, only the capture timestamps carry the timing */
+  push_forward_edges(1U, 4U, 2000U, 1000U);
+  hal_mock_set_test_micros(5500);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.update_state(&test_motor));
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.commutate(&test_motor));
+
+  /* 1000 us per 60 degree sector -> 10000 RPM */
+  TEST_ASSERT_EQUAL_UINT32(3000U, get_sensored_data()->speed_estimator.period_sum);
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 10000.0f, test_motor.state.velocity);
+  TEST_ASSERT_EQUAL_UINT8(4U, get_sensored_data()->step);
+}
+
+void test_bldc_sensored_driver_speed_moving_window() {
+  init_sensored_motor();
+
+  /* Fill the window with 2000 us periods, then replace it entirely with 1000 us periods */
+  push_forward_edges(1U, BLDC6STEP_SPEED_WINDOW + 1U, 2000U, 2000U);
+  hal_mock_set_test_micros(2000U + BLDC6STEP_SPEED_WINDOW * 2000U);
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.update_state(&test_motor));
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 5000.0f, test_motor.state.velocity);
+
+  uint32_t start_us = 2000U + BLDC6STEP_SPEED_WINDOW * 2000U + 1000U;
+  push_forward_edges(2U, 3U, start_us, 1000U);
+  hal_mock_set_test_micros(start_us + 2000U);
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.update_state(&test_motor));
+
+  /* Window holds three 2000 us periods and three 1000 us periods, a 1500 us average */
+  TEST_ASSERT_EQUAL_UINT8(BLDC6STEP_SPEED_WINDOW, get_sensored_data()->speed_estimator.count);
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 6666.7f, test_motor.state.velocity);
+}
+
+void test_bldc_sensored_driver_reversal_resets_speed() {
+  init_sensored_motor();
+
+  push_forward_edges(1U, 3U, 2000U, 1000U);
+  hal_mock_push_test_hall_edge(5000U, test_hall_sequence[2]);
+  hal_mock_set_test_micros(5100);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.update_state(&test_motor));
+  TEST_ASSERT_EQUAL_UINT8(0U, get_sensored_data()->speed_estimator.count);
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, test_motor.state.velocity);
+}
+
+void test_bldc_sensored_driver_stall_timeout() {
+  init_sensored_motor();
+
+  push_forward_edges(1U, 3U, 2000U, 1000U);
+  hal_mock_set_test_micros(4000U + BLDC6STEP_SENSORED_SPEED_TIMEOUT_US + 1U);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.update_state(&test_motor));
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, test_motor.state.velocity);
+}
+
+void test_bldc_sensored_driver_counts_position_steps() {
+  init_sensored_motor();
+
+  /* Three sectors forward, then one back */
+  push_forward_edges(1U, 3U, 2000U, 1000U);
+  hal_mock_push_test_hall_edge(5000U, test_hall_sequence[2]);
+  hal_mock_set_test_micros(5100);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.update_state(&test_motor));
+  TEST_ASSERT_EQUAL_INT32(2, get_sensored_data()->position_steps);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 2.0f * MATH_PI_OVER_3, test_motor.state.position);
+}
+
+void test_bldc_sensored_driver_position_reverses_drive() {
+  init_sensored_motor();
+
+  test_config.position_pid_config.kp = 100.0f;
+  test_config.position_pid_config.ki = 1.0f;
+  test_config.position_pid_config.output_min = -1000.0f;
+  test_config.position_pid_config.output_max = 1000.0f;
+  test_config.velocity_pid_config.kp = 0.001f;
+  test_config.velocity_pid_config.ki = 0.01f;
+  test_config.velocity_pid_config.output_min = -1.0f;
+  test_config.velocity_pid_config.output_max = 1.0f;
+  TEST_ASSERT_EQUAL(MOTOR_OK, motor_reload_config(&test_motor));
+
+  /* Two sectors behind the startup position */
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.set_position(&test_motor, -2.0f * MATH_PI_OVER_3));
+  TEST_ASSERT_EQUAL_INT32(-2, get_sensored_data()->position_profile.target);
+
+  hal_mock_set_test_micros(2000);
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.update_state(&test_motor));
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.commutate(&test_motor));
+
+  /* Reverse torque in Hall sector 0 is step 3 (0-based): B-High, A-Low, C floating */
+  uint8_t *gpio_states = hal_mock_get_test_gpio_states();
+  TEST_ASSERT_FALSE(get_sensored_data()->direction);
+  TEST_ASSERT_TRUE(get_sensored_data()->pwm_duty > 0.0f);
+  TEST_ASSERT_EQUAL_UINT8(3U, get_sensored_data()->step);
+  TEST_ASSERT_EQUAL_UINT8(1U, gpio_states[MOTOR_PHASE_A]);
+  TEST_ASSERT_EQUAL_UINT8(2U, gpio_states[MOTOR_PHASE_B]);
+  TEST_ASSERT_EQUAL_UINT8(0U, gpio_states[MOTOR_PHASE_C]);
+}
+
+void test_bldc_sensored_driver_config_applies_on_reload() {
+  init_sensored_motor();
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 24.0f, test_motor.params.max_voltage);
+
+  /* The control cycle keeps using the copy until the configuration is reloaded */
+  test_config.max_voltage = 12.0f;
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 24.0f, test_motor.params.max_voltage);
+  TEST_ASSERT_EQUAL(MOTOR_OK, motor_reload_config(&test_motor));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 12.0f, test_motor.params.max_voltage);
+
+  /* The setpoint setters change the mode in both */
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.set_velocity(&test_motor, 100.0f));
+  TEST_ASSERT_EQUAL(CONTROL_MODE_VELOCITY, test_motor.params.control_mode);
+  TEST_ASSERT_EQUAL(CONTROL_MODE_VELOCITY, test_config.control_mode);
+}
+
+void run_bldc_sensored_driver_tests() {
+  RUN_TEST(test_bldc_sensored_driver_init_success);
+  RUN_TEST(test_bldc_sensored_driver_init_invalid_hall);
+  RUN_TEST(test_bldc_sensored_driver_commutates_on_captured_edge);
+  RUN_TEST(test_bldc_sensored_driver_complementary_scheme);
+  RUN_TEST(test_bldc_sensored_driver_ignores_polled_state_without_edge);
+  RUN_TEST(test_bldc_sensored_driver_skips_illegal_edge);
+  RUN_TEST(test_bldc_sensored_driver_consecutive_illegal_edges_fault);
+  RUN_TEST(test_bldc_sensored_driver_speed_from_capture_timestamps);
+  RUN_TEST(test_bldc_sensored_driver_speed_moving_window);
+  RUN_TEST(test_bldc_sensored_driver_reversal_resets_speed);
+  RUN_TEST(test_bldc_sensored_driver_stall_timeout);
+  RUN_TEST(test_bldc_sensored_driver_counts_position_steps);
+  RUN_TEST(test_bldc_sensored_driver_position_reverses_drive);
+  RUN_TEST(test_bldc_sensored_driver_config_applies_on_reload);
+}
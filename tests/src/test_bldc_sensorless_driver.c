@@ -8,6 +8,7 @@
  *******************************************************************************************************************************/
 
 /* Standard library Headers */
+#include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
@@ -15,6 +16,7 @@
 /* Inter-component Headers */
 #include "bldc_6step_sensorless.h"
 #include "hal.h"
+#include "math_utils.h"
 #include "motor.h"
 #include "pid.h"
 #include "unity.h"
@@ -30,11 +32,11 @@ static uint8_t determine_floating_phase(uint8_t step) {
     case 0U:
       return MOTOR_PHASE_C;
     case 1U:
-      return MOTOR_PHASE_C;
-    case 2U:
       return MOTOR_PHASE_B;
-    case 3U:
+    case 2U:
       return MOTOR_PHASE_A;
+    case 3U:
+      return MOTOR_PHASE_C;
     case 4U:
       return MOTOR_PHASE_B;
     case 5U:
@@ -44,7 +46,52 @@ static uint8_t determine_floating_phase(uint8_t step) {
   }
 }
 
-void bldc_sensorless_driver_test_set_up() {}
+/* Helper: Commutation settings the timing tests are written against */
+static void prepare_commutation_config(struct BLDC6StepCommutationConfig_t *commutation_config, bool delayed_commutation) {
+  commutation_config->delayed_commutation = delayed_commutation;
+  commutation_config->advance_deg_per_krpm = 0.5f;
+  commutation_config->max_advance_deg = 10.0f;
+  commutation_config->blanking_fraction = 0.25f;
+}
+
+/* Helper: Zero-crossing settings the detection tests are written against */
+static void prepare_zero_crossing_config(struct BLDC6StepZeroCrossingConfig_t *zc_config, ZeroCrossingReference_t reference) {
+  zc_config->reference = reference;
+  zc_config->sample_point = 0.5f;
+  zc_config->min_hysteresis = 0.1f;
+  zc_config->noise_gain = 2.0f;
+  zc_config->bemf_fraction = 0.5f;
+}
+
+/* Helper: Drive the terminals of a 24 V bridge with the floating phase at a given Back-EMF */
+static void set_floating_phase_bemf(uint8_t step, float bemf) {
+  MotorPhase_t floating_phase = determine_floating_phase(step);
+
+  /* The conducting phases sit at the rails, which puts the star point at 12 V + bemf / 2 */
+  for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+    if (phase == floating_phase) {
+      hal_mock_set_test_phase_voltage(phase, 12.0f + 1.5f * bemf);
+    } else {
+      hal_mock_set_test_phase_voltage(phase, (phase == (floating_phase + 1U) % NUM_MOTOR_PHASES) ? 24.0f : 0.0f);
+    }
+  }
+}
+
+void bldc_sensorless_driver_test_set_up() {
+  struct BLDC6StepCommutationConfig_t commutation_config;
+  prepare_commutation_config(&commutation_config, true);
+  bldc_6step_sensorless_set_commutation_config(&commutation_config);
+
+  struct BLDC6StepZeroCrossingConfig_t zc_config;
+  prepare_zero_crossing_config(&zc_config, ZC_REFERENCE_VIRTUAL_NEUTRAL);
+  bldc_6step_sensorless_set_zero_crossing_config(&zc_config);
+
+  struct BLDC6StepFlyingStartConfig_t flying_start_config = { .enabled = false, .catch_time_us = 20000U };
+  bldc_6step_sensorless_set_flying_start_config(&flying_start_config);
+
+  struct BLDC6StepInitialPositionConfig_t detect_config = { .enabled = false, .num_pulses = 12U, .pulse_time_us = 100U, .settle_time_us = 200U };
+  bldc_6step_sensorless_set_initial_position_config(&detect_config);
+}
 
 void bldc_sensorless_driver_test_tear_down() {}
 
@@ -84,6 +131,7 @@ void test_bldc_sensorless_driver_init_success() {
   TEST_ASSERT_EQUAL(MOTOR_OK, err);
   TEST_ASSERT_TRUE(motor.state.is_initialized);
   TEST_ASSERT_NOT_NULL(motor.private_data);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f, hal_mock_get_test_adc_pwm_trigger());
 }
 
 void test_bldc_sensorless_driver_init_null_config() {
@@ -152,8 +200,38 @@ void test_bldc_sensorless_driver_update_state_overvoltage() {
   struct BLDC6StepSensorlessData_t *bldc = (struct BLDC6StepSensorlessData_t *)motor.private_data;
   bldc->mode = MOTOR_MODE_RUNNING;
 
-  /* Set one phase voltage above max */
-  hal_mock_set_test_phase_voltage(MOTOR_PHASE_A, 30.0f);
+  /* Set the bus above max */
+  hal_mock_set_test_dc_voltage(30.0f);
+
+  for (int i = 0; i < NUM_MOTOR_PHASES; i++) {
+    hal_mock_set_test_phase_voltage(i, 12.0f);
+    hal_mock_set_test_phase_current(i, 5.0f);
+  }
+
+  hal_mock_set_test_micros(2000);
+
+  err = motor.driver.update_state(&motor);
+  hal_mock_set_test_dc_voltage(24.0f);
+  TEST_ASSERT_EQUAL(MOTOR_OVERVOLTAGE_ERROR, err);
+}
+
+void test_bldc_sensorless_driver_update_state_terminal_at_bus() {
+  struct Motor_t motor;
+  bldc_6step_sensorless_create_driver(&motor);
+
+  struct MotorConfig_t config;
+  prepare_valid_config(&config);
+  config.control_method = CONTROL_MODE_CURRENT;
+
+  hal_mock_set_test_micros(1000);
+  MotorError_t err = motor.driver.init(&motor, &config);
+  TEST_ASSERT_EQUAL(MOTOR_OK, err);
+
+  struct BLDC6StepSensorlessData_t *bldc = (struct BLDC6StepSensorlessData_t *)motor.private_data;
+  bldc->mode = MOTOR_MODE_RUNNING;
+
+  /* A conducting high side with ringing reads above max_voltage, the bus is still at max */
+  hal_mock_set_test_phase_voltage(MOTOR_PHASE_A, 28.0f);
 
   for (int i = 1; i < NUM_MOTOR_PHASES; i++) {
     hal_mock_set_test_phase_voltage(i, 12.0f);
@@ -166,7 +244,7 @@ void test_bldc_sensorless_driver_update_state_overvoltage() {
   hal_mock_set_test_micros(2000);
 
   err = motor.driver.update_state(&motor);
-  TEST_ASSERT_EQUAL(MOTOR_OVERVOLTAGE_ERROR, err);
+  TEST_ASSERT_EQUAL(MOTOR_OK, err);
 }
 
 void test_bldc_sensorless_driver_update_state_overcurrent() {
@@ -203,6 +281,38 @@ void test_bldc_sensorless_driver_update_state_overcurrent() {
   TEST_ASSERT_EQUAL(MOTOR_OVERCURRENT_ERROR, err);
 }
 
+/* Helper: Run the sampling and commutation of one control tick with the floating phase at a given Back-EMF */
+static MotorError_t sample_floating_phase(struct Motor_t *motor, uint32_t micros, float bemf) {
+  struct BLDC6StepSensorlessData_t *bldc = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+
+  hal_mock_set_test_micros(micros);
+  set_floating_phase_bemf(bldc->step, bemf);
+
+  MotorError_t err = motor->driver.update_state(motor);
+  if (err != MOTOR_OK) {
+    return err;
+  }
+  return motor->driver.commutate(motor);
+}
+
+/* Helper: Closed-loop motor on step 0 with the last commutation and zero-crossing at t = 0 and a 1000 us period */
+static struct BLDC6StepSensorlessData_t *init_running_motor(struct Motor_t *motor) {
+  static struct MotorConfig_t config;
+
+  hal_mock_reset();
+  bldc_6step_sensorless_create_driver(motor);
+  prepare_valid_config(&config);
+  config.control_mode = CONTROL_MODE_VOLTAGE;
+
+  hal_mock_set_test_micros(0);
+  TEST_ASSERT_EQUAL(MOTOR_OK, motor->driver.init(motor, &config));
+
+  struct BLDC6StepSensorlessData_t *bldc = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+  bldc->mode = MOTOR_MODE_RUNNING;
+  bldc->commutation_period = 1000U;
+  return bldc;
+}
+
 void test_bldc_sensorless_driver_commutate_sensorless() {
   struct Motor_t motor;
   bldc_6step_sensorless_create_driver(&motor);
@@ -211,29 +321,211 @@ void test_bldc_sensorless_driver_commutate_sensorless() {
   prepare_valid_config(&config);
   config.control_method = CONTROL_METHOD_SENSORLESS;
 
+  hal_mock_reset();
   hal_mock_set_test_micros(0);
 
   MotorError_t err = motor.driver.init(&motor, &config);
   TEST_ASSERT_EQUAL(MOTOR_OK, err);
 
-  hal_mock_set_test_micros(100);
-  /* For sensorless commutation, the driver checks the filtered back-EMF in the floating phase.
-     Set that value to be above the threshold so that a commutation occurs.
+  /* For sensorless commutation, the driver checks the back-EMF in the floating phase.
+     Step 0 expects a falling zero-crossing, so drive the sample from above to below the threshold.
      (determine_floating_phase() is used internally to pick the phase.) */
   struct BLDC6StepSensorlessData_t *bldc = (struct BLDC6StepSensorlessData_t *)motor.private_data;
 
   bldc->mode = MOTOR_MODE_RUNNING;
-
-  uint8_t floating_phase = determine_floating_phase(bldc->step);
-  bldc->bemf_filtered[floating_phase] = bldc->zc_threshold + 0.51f; /* Hystersis = 0.5 */
   bldc->direction = true;
+  bldc->commutation_period = 1000U;
   uint8_t old_step = bldc->step;
-  err = motor.driver.commutate(&motor);
 
+  sample_floating_phase(&motor, 400, bldc->zc_hysteresis + 0.01f);
+  err = sample_floating_phase(&motor, 600, -(bldc->zc_hysteresis + 0.01f));
+
+  /* Commutation waits for the timer 30 degrees after the zero-crossing */
   TEST_ASSERT_EQUAL(MOTOR_OK, err);
+  TEST_ASSERT_EQUAL(old_step, bldc->step);
+  TEST_ASSERT_TRUE(hal_mock_is_test_timer_armed());
+
+  hal_mock_fire_test_timer();
   TEST_ASSERT_EQUAL((old_step + 1U) % NUM_COMMUTATION_STEPS, bldc->step);
 }
 
+void test_bldc_sensorless_driver_zero_crossing_interpolation() {
+  struct Motor_t motor;
+  struct BLDC6StepSensorlessData_t *bldc = init_running_motor(&motor);
+
+  /* 1.0 V -> -3.0 V crosses zero a quarter of the way between the samples */
+  sample_floating_phase(&motor, 900, 1.0f);
+  sample_floating_phase(&motor, 1100, -3.0f);
+
+  TEST_ASSERT_TRUE(bldc->commutation_scheduled);
+  TEST_ASSERT_EQUAL(950U, bldc->last_zc_time);
+  TEST_ASSERT_EQUAL(950U, bldc->commutation_period);
+}
+
+void test_bldc_sensorless_driver_delayed_commutation_advance() {
+  struct Motor_t motor;
+  struct BLDC6StepSensorlessData_t *bldc = init_running_motor(&motor);
+
+  /* Zero-crossing at 1000 us, 1000 us after the previous one: 10000 RPM, 5 degrees of advance */
+  sample_floating_phase(&motor, 900, 1.0f);
+  sample_floating_phase(&motor, 1100, -1.0f);
+
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 10000.0f, bldc->estimated_speed);
+  TEST_ASSERT_TRUE(hal_mock_is_test_timer_armed());
+  TEST_ASSERT_UINT32_WITHIN(1U, 1000U + 416U, hal_mock_get_test_timer_fire_time());
+
+  /* No second detection while the commutation is pending */
+  sample_floating_phase(&motor, 1200, -1.0f);
+  TEST_ASSERT_EQUAL(0U, bldc->step);
+
+  hal_mock_fire_test_timer();
+  TEST_ASSERT_EQUAL(1U, bldc->step);
+  TEST_ASSERT_FALSE(bldc->commutation_scheduled);
+  TEST_ASSERT_EQUAL(ZC_STATE_RISING, bldc->zc_state);
+}
+
+void test_bldc_sensorless_driver_immediate_commutation() {
+  struct BLDC6StepCommutationConfig_t commutation_config;
+  prepare_commutation_config(&commutation_config, false);
+  bldc_6step_sensorless_set_commutation_config(&commutation_config);
+
+  struct Motor_t motor;
+  struct BLDC6StepSensorlessData_t *bldc = init_running_motor(&motor);
+
+  sample_floating_phase(&motor, 900, 1.0f);
+  sample_floating_phase(&motor, 1100, -1.0f);
+
+  TEST_ASSERT_FALSE(hal_mock_is_test_timer_armed());
+  TEST_ASSERT_EQUAL(1U, bldc->step);
+  TEST_ASSERT_EQUAL(1000U, bldc->last_zc_time);
+}
+
+void test_bldc_sensorless_driver_zero_crossing_blanking() {
+  struct Motor_t motor;
+  struct BLDC6StepSensorlessData_t *bldc = init_running_motor(&motor);
+
+  /* Commutation ringing inside the first 250 us of the 1000 us period is ignored */
+  sample_floating_phase(&motor, 100, 1.0f);
+  sample_floating_phase(&motor, 200, -1.0f);
+  TEST_ASSERT_FALSE(bldc->zc_candidate_valid);
+  TEST_ASSERT_FALSE(hal_mock_is_test_timer_armed());
+
+  /* The first sample after blanking only arms the search, it cannot complete a crossing */
+  sample_floating_phase(&motor, 300, -1.0f);
+  TEST_ASSERT_FALSE(bldc->zc_candidate_valid);
+  TEST_ASSERT_EQUAL(0U, bldc->step);
+}
+
+void test_bldc_sensorless_driver_speed_moving_window() {
+  struct Motor_t motor;
+  struct BLDC6StepSensorlessData_t *bldc = init_running_motor(&motor);
+
+  /* Asymmetric falling and rising detections: 900 us then 1100 us between zero-crossings */
+  sample_floating_phase(&motor, 800, 1.0f);
+  sample_floating_phase(&motor, 1000, -1.0f);
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 11111.1f, bldc->estimated_speed);
+  hal_mock_fire_test_timer();
+
+  sample_floating_phase(&motor, 1900, -1.0f);
+  sample_floating_phase(&motor, 2100, 1.0f);
+
+  /* The latest period still times the commutation, the speed averages both */
+  TEST_ASSERT_EQUAL(1100U, bldc->commutation_period);
+  TEST_ASSERT_EQUAL_UINT8(2U, bldc->speed_estimator.count);
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 10000.0f, bldc->estimated_speed);
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 10000.0f, motor.state.velocity);
+}
+
+void test_bldc_sensorless_driver_velocity_loop_per_commutation() {
+  struct Motor_t motor;
+  struct BLDC6StepSensorlessData_t *bldc = init_running_motor(&motor);
+
+  motor.config->control_mode = CONTROL_MODE_VELOCITY;
+  motor.config->velocity_loop_per_commutation = true;
+  motor.config->velocity_pid_config.kp = 0.0001f;
+  motor.config->velocity_pid_config.output_max = 1.0f;
+  TEST_ASSERT_EQUAL(MOTOR_OK, motor_reload_config(&motor));
+  motor.setpoint.velocity = 20000.0f;
+  bldc->pwm_duty = 0.25f;
+
+  /* No new commutation period, the duty cycle holds */
+  sample_floating_phase(&motor, 800, 1.0f);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.25f, bldc->pwm_duty);
+
+  /* The zero-crossing is confirmed after this tick's state update, the loop runs on the next one */
+  sample_floating_phase(&motor, 1000, -1.0f);
+  TEST_ASSERT_TRUE(bldc->speed_estimator.is_updated);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.25f, bldc->pwm_duty);
+
+  sample_floating_phase(&motor, 1050, -1.0f);
+  TEST_ASSERT_FALSE(bldc->speed_estimator.is_updated);
+  TEST_ASSERT_EQUAL(1050U, bldc->last_velocity_update_time);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0001f * (20000.0f - 11111.1f), bldc->pwm_duty);
+
+  sample_floating_phase(&motor, 1100, -1.0f);
+  TEST_ASSERT_EQUAL(1050U, bldc->last_velocity_update_time);
+}
+
+/* Helper: Terminals of a sagged 20 V bus with the star point at 9.5 V and the floating phase at 8.5 V */
+static void set_sagged_bus_terminals(MotorPhase_t floating_phase) {
+  hal_mock_set_test_dc_voltage(20.0f);
+  hal_mock_set_test_phase_voltage((MotorPhase_t)((floating_phase + 1U) % NUM_MOTOR_PHASES), 20.0f);
+  hal_mock_set_test_phase_voltage((MotorPhase_t)((floating_phase + 2U) % NUM_MOTOR_PHASES), 0.0f);
+  hal_mock_set_test_phase_voltage(floating_phase, 8.5f);
+  hal_mock_set_test_micros(500);
+}
+
+void test_bldc_sensorless_driver_zero_crossing_reference() {
+  struct Motor_t motor;
+  struct BLDC6StepSensorlessData_t *bldc = init_running_motor(&motor);
+  MotorPhase_t floating_phase = determine_floating_phase(bldc->step);
+
+  /* The virtual neutral follows the sagged rails instead of the nominal bus */
+  set_sagged_bus_terminals(floating_phase);
+  TEST_ASSERT_EQUAL(MOTOR_OK, motor.driver.update_state(&motor));
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, -1.0f, bldc->bemf[floating_phase]);
+
+  /* Half of the measured bus sees the same crossing, scaled by 1.5 as the star point moves with the floating phase */
+  struct BLDC6StepZeroCrossingConfig_t zc_config;
+  prepare_zero_crossing_config(&zc_config, ZC_REFERENCE_HALF_BUS);
+  bldc_6step_sensorless_set_zero_crossing_config(&zc_config);
+  init_running_motor(&motor);
+
+  set_sagged_bus_terminals(floating_phase);
+  TEST_ASSERT_EQUAL(MOTOR_OK, motor.driver.update_state(&motor));
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, -1.5f, bldc->bemf[floating_phase]);
+}
+
+void test_bldc_sensorless_driver_adaptive_hysteresis() {
+  struct Motor_t motor;
+  struct BLDC6StepSensorlessData_t *bldc = init_running_motor(&motor);
+
+  /* Falling Back-EMF with +-0.5 V of alternating noise, then a crossing and the scheduled commutation */
+  for (uint32_t micros = 300U; micros <= 800U; micros += 50U) {
+    float noise = ((micros / 50U) % 2U == 0U) ? 0.5f : -0.5f;
+    sample_floating_phase(&motor, micros, 4.0f - ((float)micros / 250.0f) + noise);
+  }
+  sample_floating_phase(&motor, 1000, -2.0f);
+  TEST_ASSERT_TRUE(hal_mock_is_test_timer_armed());
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.1f, bldc->zc_hysteresis);
+
+  float bemf_peak = bldc->bemf_peak;
+  hal_mock_fire_test_timer();
+
+  /* The noise widens the band of the next step, within half of the Back-EMF peak */
+  TEST_ASSERT_TRUE(bldc->bemf_noise > 0.5f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, fminf(2.0f * bldc->bemf_noise, 0.5f * bemf_peak), bldc->zc_hysteresis);
+  TEST_ASSERT_TRUE(bldc->zc_hysteresis > 0.1f);
+
+  /* A slow rotor with a small Back-EMF peak caps the band so the next crossing can still be confirmed */
+  sample_floating_phase(&motor, 1500, -0.2f);
+  sample_floating_phase(&motor, 1600, 2.5f);
+  TEST_ASSERT_TRUE(hal_mock_is_test_timer_armed());
+  bldc->bemf_peak = 0.4f;
+  hal_mock_fire_test_timer();
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.2f, bldc->zc_hysteresis);
+}
+
 void test_bldc_sensorless_driver_update_pwm() {
   hal_mock_reset();
 
@@ -250,7 +542,7 @@ void test_bldc_sensorless_driver_update_pwm() {
 
   /* Set a known commutation step and PWM duty */
   struct BLDC6StepSensorlessData_t *bldc = (struct BLDC6StepSensorlessData_t *)motor.private_data;
-  bldc->step = 0; /* using commutation table row 0: {1,0,0,1,0,0} */
+  bldc->step = 0; /* using commutation table row 0: A-High, B-Low */
   bldc->pwm_duty = 1000;
 
   err = motor.driver.update_pwm(&motor);
@@ -265,6 +557,329 @@ void test_bldc_sensorless_driver_update_pwm() {
   TEST_ASSERT_EQUAL(0U, hal_mock_get_test_gpio_states()[MOTOR_PHASE_C]);
 }
 
+/* Helper: Short startup ramp so every startup phase can be stepped through with the mock clock */
+static void prepare_startup_config(struct BLDC6StepStartupConfig_t *startup_config) {
+  startup_config->align_duty = 0.2f;
+  startup_config->align_time_us = 1000U;
+  startup_config->initial_period_us = 8000U;
+  startup_config->final_period_us = 2000U;
+  startup_config->acceleration_factor = 0.5f;
+  startup_config->initial_duty = 0.2f;
+  startup_config->duty_increment = 0.1f;
+  startup_config->num_steps = 4U;
+  startup_config->transition_timeout_us = 10000U;
+}
+
+/* Helper: Initialize the driver at t = 1000 us with the short startup ramp */
+static struct BLDC6StepSensorlessData_t *init_startup_motor(struct Motor_t *motor, struct MotorConfig_t *config) {
+  struct BLDC6StepStartupConfig_t startup_config;
+  prepare_startup_config(&startup_config);
+  bldc_6step_sensorless_set_startup_config(&startup_config);
+
+  hal_mock_reset();
+  bldc_6step_sensorless_create_driver(motor);
+  prepare_valid_config(config);
+  config->current_pid_config.output_max = 1.0f;
+
+  hal_mock_set_test_micros(1000);
+  TEST_ASSERT_EQUAL(MOTOR_OK, motor->driver.init(motor, config));
+  return (struct BLDC6StepSensorlessData_t *)motor->private_data;
+}
+
+/* Helper: Advance the mock clock and run one control tick */
+static MotorError_t run_tick_at(struct Motor_t *motor, uint32_t micros) {
+  hal_mock_set_test_micros(micros);
+  return motor_run(motor);
+}
+
+void test_bldc_sensorless_driver_init_does_not_block() {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepSensorlessData_t *bldc = init_startup_motor(&motor, &config);
+
+  TEST_ASSERT_TRUE(motor.state.is_initialized);
+  TEST_ASSERT_EQUAL(MOTOR_MODE_ALIGNING, bldc->mode);
+  TEST_ASSERT_EQUAL(0U, bldc->step);
+  TEST_ASSERT_EQUAL(2U, hal_mock_get_test_gpio_states()[MOTOR_PHASE_A]);
+  TEST_ASSERT_EQUAL(1U, hal_mock_get_test_gpio_states()[MOTOR_PHASE_B]);
+}
+
+void test_bldc_sensorless_driver_startup_alignment() {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepSensorlessData_t *bldc = init_startup_motor(&motor, &config);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(&motor, 1500));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_ALIGNING, bldc->mode);
+  TEST_ASSERT_EQUAL(0U, bldc->step);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(&motor, 2000));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_OPEN_LOOP, bldc->mode);
+  TEST_ASSERT_EQUAL(1U, bldc->step);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.2f, bldc->pwm_duty);
+}
+
+void test_bldc_sensorless_driver_startup_open_loop_ramp() {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepSensorlessData_t *bldc = init_startup_motor(&motor, &config);
+
+  run_tick_at(&motor, 2000);
+  TEST_ASSERT_EQUAL(8000U, bldc->startup_period);
+
+  /* Not due yet */
+  run_tick_at(&motor, 9999);
+  TEST_ASSERT_EQUAL(1U, bldc->step);
+
+  /* Period halves on every forced step until it reaches the final period */
+  run_tick_at(&motor, 10000);
+  TEST_ASSERT_EQUAL(2U, bldc->step);
+  TEST_ASSERT_EQUAL(4000U, bldc->startup_period);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.3f, bldc->pwm_duty);
+
+  run_tick_at(&motor, 14000);
+  TEST_ASSERT_EQUAL(3U, bldc->step);
+  TEST_ASSERT_EQUAL(2000U, bldc->startup_period);
+
+  run_tick_at(&motor, 16000);
+  TEST_ASSERT_EQUAL(4U, bldc->step);
+  TEST_ASSERT_EQUAL(2000U, bldc->startup_period);
+
+  run_tick_at(&motor, 18000);
+  TEST_ASSERT_EQUAL(MOTOR_MODE_TRANSITION, bldc->mode);
+}
+
+void test_bldc_sensorless_driver_startup_transition_to_running() {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepSensorlessData_t *bldc = init_startup_motor(&motor, &config);
+
+  uint32_t micros[] = { 2000, 10000, 14000, 16000 };
+  for (uint8_t i = 0U; i < sizeof(micros) / sizeof(micros[0]); i++) {
+    run_tick_at(&motor, micros[i]);
+  }
+
+  /* The floating phase is above zero when the ramp hands over */
+  uint8_t old_step = bldc->step;
+  TEST_ASSERT_EQUAL(ZC_STATE_FALLING, bldc->zc_state);
+  set_floating_phase_bemf(old_step, bldc->zc_hysteresis + 0.1f);
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(&motor, 18000));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_TRANSITION, bldc->mode);
+
+  /* First Back-EMF zero-crossing on the floating phase hands over to closed-loop */
+  set_floating_phase_bemf(old_step, -(bldc->zc_hysteresis + 0.1f));
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(&motor, 18200));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_RUNNING, bldc->mode);
+  TEST_ASSERT_EQUAL(old_step, bldc->step);
+
+  /* The forced period is kept as the first estimate, so the commutation lands 27.5 degrees after the crossing */
+  TEST_ASSERT_EQUAL(2000U, bldc->commutation_period);
+  TEST_ASSERT_UINT32_WITHIN(1U, 18100U + 916U, hal_mock_get_test_timer_fire_time());
+  hal_mock_fire_test_timer();
+  TEST_ASSERT_EQUAL((old_step + 1U) % NUM_COMMUTATION_STEPS, bldc->step);
+}
+
+void test_bldc_sensorless_driver_startup_stall() {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepSensorlessData_t *bldc = init_startup_motor(&motor, &config);
+
+  uint32_t micros[] = { 2000, 10000, 14000, 16000, 18000 };
+  for (uint8_t i = 0U; i < sizeof(micros) / sizeof(micros[0]); i++) {
+    run_tick_at(&motor, micros[i]);
+  }
+
+  /* No Back-EMF before the transition timeout */
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(&motor, 20000));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_TRANSITION, bldc->mode);
+  TEST_ASSERT_EQUAL(MOTOR_INIT_ERROR, run_tick_at(&motor, 28001));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_ERROR, bldc->mode);
+}
+
+/* Helper: Initialize the driver at t = 1000 us with a 10 ms flying start ahead of the short startup ramp */
+static struct BLDC6StepSensorlessData_t *init_flying_start_motor(struct Motor_t *motor, struct MotorConfig_t *config) {
+  struct BLDC6StepFlyingStartConfig_t flying_start_config = { .enabled = true, .catch_time_us = 10000U };
+  bldc_6step_sensorless_set_flying_start_config(&flying_start_config);
+
+  return init_startup_motor(motor, config);
+}
+
+/* Helper: Tick every 50 us with the bridge off and the terminals at the sinusoidal Back-EMF of a coasting rotor, one step per
+ * step_period_us, around a 12 V star point. Stops early once the driver leaves the flying start */
+static void coast_floating_phases(struct Motor_t *motor, uint32_t start_us, uint32_t end_us, float step_period_us, bool is_forward) {
+  struct BLDC6StepSensorlessData_t *bldc = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+  float direction = is_forward ? 1.0f : -1.0f;
+
+  for (uint32_t micros = start_us; micros <= end_us && bldc->mode == MOTOR_MODE_CATCHING; micros += 50U) {
+    float theta = direction * MATH_PI * (float)micros / (3.0f * step_period_us);
+
+    for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+      hal_mock_set_test_phase_voltage(phase, 12.0f + 4.0f * sinf(theta - (float)phase * MATH_TWO_PI / 3.0f));
+    }
+
+    TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(motor, micros));
+  }
+}
+
+void test_bldc_sensorless_driver_flying_start_standstill_aligns() {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepSensorlessData_t *bldc = init_flying_start_motor(&motor, &config);
+
+  TEST_ASSERT_EQUAL(MOTOR_MODE_CATCHING, bldc->mode);
+
+  for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+    TEST_ASSERT_EQUAL_UINT8(0U, hal_mock_get_test_gpio_states()[phase]);
+  }
+
+  /* No zero-crossing inside the window, the rotor stands and is aligned */
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(&motor, 11000));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_CATCHING, bldc->mode);
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(&motor, 11001));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_ALIGNING, bldc->mode);
+}
+
+void test_bldc_sensorless_driver_flying_start_catches_rotor() {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepSensorlessData_t *bldc = init_flying_start_motor(&motor, &config);
+
+  /* 1000 us per step, faster than the 2000 us final open-loop period */
+  coast_floating_phases(&motor, 1050U, 11000U, 1000.0f, true);
+
+  TEST_ASSERT_EQUAL(MOTOR_MODE_RUNNING, bldc->mode);
+  TEST_ASSERT_UINT32_WITHIN(50U, 1000U, bldc->commutation_period);
+  TEST_ASSERT_TRUE(bldc->pwm_duty > 0.0f);
+  TEST_ASSERT_TRUE(hal_mock_is_test_timer_armed());
+}
+
+void test_bldc_sensorless_driver_flying_start_reverse_aligns() {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepSensorlessData_t *bldc = init_flying_start_motor(&motor, &config);
+
+  /* Crossings against the driver direction never chain up, the rotor goes through the startup */
+  coast_floating_phases(&motor, 1050U, 12000U, 1000.0f, false);
+
+  TEST_ASSERT_EQUAL(MOTOR_MODE_ALIGNING, bldc->mode);
+}
+
+/* Helper: Initialize the driver at t = 1000 us with a 12 pulse position detection ahead of the short startup ramp */
+static struct BLDC6StepSensorlessData_t *init_detecting_motor(struct Motor_t *motor, struct MotorConfig_t *config) {
+  struct BLDC6StepInitialPositionConfig_t detect_config = { .enabled = true, .num_pulses = 12U, .pulse_time_us = 100U, .settle_time_us = 200U };
+  bldc_6step_sensorless_set_initial_position_config(&detect_config);
+
+  return init_startup_motor(motor, config);
+}
+
+/* Helper: Phase currents of the applied pulse, with a magnitude peaking at 1 + first + second along the north pole and at
+ * 1 - first + second against it. Zero while the bridge floats */
+static void set_pulse_currents(float north, float first, float second) {
+  uint16_t gate_mask = hal_mock_get_test_gate_mask();
+  float drive[NUM_MOTOR_PHASES];
+  float drive_sum = 0.0f;
+  uint8_t num_driven = 0U;
+
+  for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+    bool is_driven = (gate_mask & (HAL_GATE_HIGH(phase) | HAL_GATE_LOW(phase))) != 0U;
+    drive[phase] = ((gate_mask & HAL_GATE_HIGH(phase)) != 0U) ? 1.0f : 0.0f;
+    if (is_driven) {
+      drive_sum += drive[phase];
+      num_driven++;
+    }
+  }
+
+  float alpha = 0.0f;
+  float beta = 0.0f;
+  for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+    bool is_driven = (gate_mask & (HAL_GATE_HIGH(phase) | HAL_GATE_LOW(phase))) != 0U;
+    float current = is_driven ? (drive[phase] - drive_sum / (float)num_driven) : 0.0f;
+    alpha += current * cosf((float)phase * MATH_TWO_PI / 3.0f);
+    beta += current * sinf((float)phase * MATH_TWO_PI / 3.0f);
+  }
+
+  float angle = atan2f(beta, alpha);
+  float magnitude = (num_driven < 2U) ? 0.0f : (1.0f + first * cosf(angle - north) + second * cosf(2.0f * (angle - north)));
+
+  for (MotorPhase_t phase = MOTOR_PHASE_A; phase < NUM_MOTOR_PHASES; phase++) {
+    hal_mock_set_test_phase_current(phase, magnitude * cosf(angle - (float)phase * MATH_TWO_PI / 3.0f));
+  }
+}
+
+/* Helper: Tick every 50 us with the currents of the applied pulse until the detection is over */
+static void run_detection(struct Motor_t *motor, float north, float first, float second) {
+  struct BLDC6StepSensorlessData_t *bldc = (struct BLDC6StepSensorlessData_t *)motor->private_data;
+
+  for (uint32_t micros = 1050U; micros <= 10000U && bldc->mode == MOTOR_MODE_DETECTING; micros += 50U) {
+    set_pulse_currents(north, first, second);
+    TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(motor, micros));
+  }
+}
+
+void test_bldc_sensorless_driver_initial_position_pulses() {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepSensorlessData_t *bldc = init_detecting_motor(&motor, &config);
+
+  /* The first pulse drives A against B and C, held on for the whole pulse */
+  TEST_ASSERT_EQUAL(MOTOR_MODE_DETECTING, bldc->mode);
+  TEST_ASSERT_EQUAL_HEX16(HAL_GATE_HIGH(MOTOR_PHASE_A) | HAL_GATE_LOW(MOTOR_PHASE_B) | HAL_GATE_LOW(MOTOR_PHASE_C), hal_mock_get_test_gate_mask());
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(&motor, 1050));
+  TEST_ASSERT_NOT_EQUAL(HAL_GATES_FLOAT, hal_mock_get_test_gate_mask());
+
+  /* The bridge floats while the current decays */
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(&motor, 1100));
+  TEST_ASSERT_EQUAL_HEX16(HAL_GATES_FLOAT, hal_mock_get_test_gate_mask());
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(&motor, 1250));
+  TEST_ASSERT_EQUAL_HEX16(HAL_GATES_FLOAT, hal_mock_get_test_gate_mask());
+
+  /* The second pulse is the opposite one */
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(&motor, 1300));
+  TEST_ASSERT_EQUAL_HEX16(HAL_GATE_HIGH(MOTOR_PHASE_B) | HAL_GATE_HIGH(MOTOR_PHASE_C) | HAL_GATE_LOW(MOTOR_PHASE_A), hal_mock_get_test_gate_mask());
+  TEST_ASSERT_EQUAL(MOTOR_MODE_DETECTING, bldc->mode);
+}
+
+void test_bldc_sensorless_driver_initial_position_saturation() {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepSensorlessData_t *bldc = init_detecting_motor(&motor, &config);
+  float north = 100.0f * MATH_PI / 180.0f;
+
+  run_detection(&motor, north, 0.1f, 0.0f);
+
+  /* Step 3 drives the current at 150 degrees, the first forced step 4 leads the north pole by 110 degrees */
+  TEST_ASSERT_FLOAT_WITHIN(0.02f, north, bldc->detected_angle);
+  TEST_ASSERT_EQUAL(MOTOR_MODE_OPEN_LOOP, bldc->mode);
+  TEST_ASSERT_EQUAL(4U, bldc->step);
+  TEST_ASSERT_EQUAL(1, bldc->position_steps);
+}
+
+void test_bldc_sensorless_driver_initial_position_saliency() {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepSensorlessData_t *bldc = init_detecting_motor(&motor, &config);
+  float north = 260.0f * MATH_PI / 180.0f;
+
+  /* The d-axis harmonic dominates, the weak saturation harmonic only picks its north end */
+  run_detection(&motor, north, 0.02f, 0.3f);
+
+  TEST_ASSERT_FLOAT_WITHIN(0.02f, north, bldc->detected_angle);
+  TEST_ASSERT_EQUAL(MOTOR_MODE_OPEN_LOOP, bldc->mode);
+  TEST_ASSERT_EQUAL(0U, bldc->step);
+}
+
+void test_bldc_sensorless_driver_initial_position_invalid_pulses() {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepInitialPositionConfig_t detect_config = { .enabled = true, .num_pulses = 8U, .pulse_time_us = 100U, .settle_time_us = 200U };
+  bldc_6step_sensorless_set_initial_position_config(&detect_config);
+
+  bldc_6step_sensorless_create_driver(&motor);
+  prepare_valid_config(&config);
+  TEST_ASSERT_EQUAL(MOTOR_INVALID_ARGS, motor.driver.init(&motor, &config));
+}
+
 /* Test: bldc_set_voltage clamps the setpoint appropriately */
 void test_bldc_sensorless_driver_set_voltage() {
   struct Motor_t motor;
@@ -344,6 +959,58 @@ void test_bldc_sensorless_driver_set_position() {
   TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.57f, motor.setpoint.position);
 }
 
+void test_bldc_sensorless_driver_set_position_behind_count() {
+  struct Motor_t motor;
+  memset(&motor, 0, sizeof(motor));
+
+  bldc_6step_sensorless_create_driver(&motor);
+
+  struct MotorConfig_t config;
+  prepare_valid_config(&config);
+  config.control_mode = CONTROL_MODE_VOLTAGE;
+
+  MotorError_t err = motor.driver.init(&motor, &config);
+  TEST_ASSERT_EQUAL(MOTOR_OK, err);
+
+  struct BLDC6StepSensorlessData_t *bldc = (struct BLDC6StepSensorlessData_t *)motor.private_data;
+  bldc->position_steps = 5;
+
+  /* One pole pair, each step is 60 degrees. Moves only go forward from the counted position */
+  TEST_ASSERT_EQUAL(MOTOR_INVALID_ARGS, motor.driver.set_position(&motor, 5.0f * MATH_PI_OVER_3));
+  TEST_ASSERT_EQUAL(MOTOR_INVALID_ARGS, motor.driver.set_position(&motor, 3.0f * MATH_PI_OVER_3));
+  TEST_ASSERT_EQUAL(CONTROL_MODE_VOLTAGE, config.control_mode);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, motor.driver.set_position(&motor, 6.0f * MATH_PI_OVER_3));
+  TEST_ASSERT_EQUAL(6, bldc->position_profile.target);
+  TEST_ASSERT_EQUAL(CONTROL_MODE_POSITION, config.control_mode);
+}
+
+void test_bldc_sensorless_driver_position_holds_target() {
+  struct Motor_t motor;
+  struct MotorConfig_t config;
+  struct BLDC6StepSensorlessData_t *bldc = init_startup_motor(&motor, &config);
+
+  /* Closed-loop one step short of the target */
+  bldc->mode = MOTOR_MODE_RUNNING;
+  bldc->step = 2U;
+  bldc->position_steps = 4;
+  TEST_ASSERT_EQUAL(MOTOR_OK, motor.driver.set_position(&motor, 5.0f * MATH_PI_OVER_3));
+
+  /* Reaching the target holds its step at the alignment duty instead of releasing the bridge */
+  bldc->position_steps = 5;
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(&motor, 2000U));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_BRAKING, bldc->mode);
+  TEST_ASSERT_EQUAL_UINT8(2U, bldc->step);
+  TEST_ASSERT_FALSE(bldc->is_reverse_torque);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.2f, bldc->pwm_duty);
+  TEST_ASSERT_EQUAL(0U, hal_mock_get_test_gpio_states()[determine_floating_phase(2U)]);
+
+  /* The held motor does not commutate, a further move needs a new init */
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_tick_at(&motor, 3000U));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_BRAKING, bldc->mode);
+  TEST_ASSERT_EQUAL(MOTOR_INVALID_ARGS, motor.driver.set_position(&motor, 6.0f * MATH_PI_OVER_3));
+}
+
 void test_bldc_sensorless_driver_set_torque() {
   struct Motor_t motor;
   memset(&motor, 0, sizeof(motor));
@@ -366,12 +1033,35 @@ void run_bldc_sensorless_driver_tests() {
   RUN_TEST(test_bldc_sensorless_driver_deinit);
   RUN_TEST(test_bldc_sensorless_driver_update_state_normal);
   RUN_TEST(test_bldc_sensorless_driver_update_state_overvoltage);
+  RUN_TEST(test_bldc_sensorless_driver_update_state_terminal_at_bus);
   RUN_TEST(test_bldc_sensorless_driver_update_state_overcurrent);
   RUN_TEST(test_bldc_sensorless_driver_commutate_sensorless);
+  RUN_TEST(test_bldc_sensorless_driver_zero_crossing_interpolation);
+  RUN_TEST(test_bldc_sensorless_driver_delayed_commutation_advance);
+  RUN_TEST(test_bldc_sensorless_driver_immediate_commutation);
+  RUN_TEST(test_bldc_sensorless_driver_zero_crossing_blanking);
+  RUN_TEST(test_bldc_sensorless_driver_speed_moving_window);
+  RUN_TEST(test_bldc_sensorless_driver_velocity_loop_per_commutation);
+  RUN_TEST(test_bldc_sensorless_driver_zero_crossing_reference);
+  RUN_TEST(test_bldc_sensorless_driver_adaptive_hysteresis);
   RUN_TEST(test_bldc_sensorless_driver_update_pwm);
+  RUN_TEST(test_bldc_sensorless_driver_init_does_not_block);
+  RUN_TEST(test_bldc_sensorless_driver_startup_alignment);
+  RUN_TEST(test_bldc_sensorless_driver_startup_open_loop_ramp);
+  RUN_TEST(test_bldc_sensorless_driver_startup_transition_to_running);
+  RUN_TEST(test_bldc_sensorless_driver_startup_stall);
+  RUN_TEST(test_bldc_sensorless_driver_flying_start_standstill_aligns);
+  RUN_TEST(test_bldc_sensorless_driver_flying_start_catches_rotor);
+  RUN_TEST(test_bldc_sensorless_driver_flying_start_reverse_aligns);
+  RUN_TEST(test_bldc_sensorless_driver_initial_position_pulses);
+  RUN_TEST(test_bldc_sensorless_driver_initial_position_saturation);
+  RUN_TEST(test_bldc_sensorless_driver_initial_position_saliency);
+  RUN_TEST(test_bldc_sensorless_driver_initial_position_invalid_pulses);
   RUN_TEST(test_bldc_sensorless_driver_set_voltage);
   RUN_TEST(test_bldc_sensorless_driver_set_current);
   RUN_TEST(test_bldc_sensorless_driver_set_velocity);
   RUN_TEST(test_bldc_sensorless_driver_set_position);
+  RUN_TEST(test_bldc_sensorless_driver_set_position_behind_count);
+  RUN_TEST(test_bldc_sensorless_driver_position_holds_target);
   RUN_TEST(test_bldc_sensorless_driver_set_torque);
 }
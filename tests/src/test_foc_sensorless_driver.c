@@ -0,0 +1,555 @@
+/*******************************************************************************************************************************
+ * @file   test_foc_sensorless_driver.c
+ *
+ * @brief  Source file for the sensorless FOC driver, back-EMF PLL and high-frequency injection observer tests
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Inter-component Headers */
+#include "backemf_pll_observer.h"
+#include "foc_sensorless.h"
+#include "hal.h"
+#include "hfi_observer.h"
+#include "math_utils.h"
+#include "motor.h"
+#include "transform_utils.h"
+#include "unity.h"
+
+/* Intra-component Headers */
+#include "hal_mock.h"
+#include "test_foc_sensorless_driver.h"
+
+#define TEST_OBSERVER_DT 0.00005f     /**< Observer update period, 20 kHz [s] */
+#define TEST_OBSERVER_STEPS 4000U     /**< 200 ms of updates, many PLL time constants */
+#define TEST_FLUX_LINKAGE 0.01f       /**< Rotor flux linkage of the synthetic back-EMF [Wb] */
+#define TEST_ELECTRICAL_SPEED 300.0f  /**< Electrical speed of the synthetic back-EMF [rad/s] */
+#define TEST_INDUCTANCE_D 0.0008f     /**< D-axis inductance of the synthetic salient rotor [H] */
+#define TEST_INDUCTANCE_Q 0.0012f     /**< Q-axis inductance of the synthetic salient rotor [H] */
+
+static struct Motor_t test_motor;
+static struct MotorConfig_t test_config;
+static uint32_t test_elapsed_us;
+static float test_rotor_angle;
+static struct FOCObserver_t test_observer;
+static struct BackEMFPLLConfig_t test_observer_config;
+static struct HFIObserverConfig_t test_hfi_config;
+
+/* Helper: Prepare a valid motor configuration */
+static void prepare_valid_config(struct MotorConfig_t *config) {
+  memset(config, 0, sizeof(*config));
+  config->type = MOTOR_TYPE_PMSM;
+  config->control_method = CONTROL_METHOD_FOC;
+  config->control_mode = CONTROL_MODE_CURRENT;
+  config->pole_pairs = 7;
+  config->phase_resistance = 0.5f;
+  config->phase_inductance = 0.001f;
+  config->max_current = 20.0f;
+  config->max_voltage = 24.0f;
+  config->max_velocity = 200.0f;
+
+  config->pwm_config.frequency = 20000;
+  config->pwm_config.resolution = 12;
+  config->adc_config.sampling_freq = 20000;
+  config->adc_config.resolution = 12;
+}
+
+/* Helper: Fill a startup configuration with the driver defaults */
+static void prepare_startup_config(struct FOCSensorlessStartupConfig_t *startup_config) {
+  startup_config->align_current = FOC_SENSORLESS_DEFAULT_ALIGN_CURRENT;
+  startup_config->align_time_us = FOC_SENSORLESS_DEFAULT_ALIGN_TIME_US;
+  startup_config->ramp_current = FOC_SENSORLESS_DEFAULT_RAMP_CURRENT;
+  startup_config->ramp_acceleration = FOC_SENSORLESS_DEFAULT_RAMP_ACCELERATION;
+  startup_config->ramp_final_speed = FOC_SENSORLESS_DEFAULT_RAMP_FINAL_SPEED;
+  startup_config->lock_window_us = FOC_SENSORLESS_DEFAULT_LOCK_WINDOW_US;
+  startup_config->blend_time_us = FOC_SENSORLESS_DEFAULT_BLEND_TIME_US;
+  startup_config->transition_timeout_us = FOC_SENSORLESS_DEFAULT_TRANSITION_TIMEOUT_US;
+}
+
+/* Helper: Reset the mock and initialize the driver with a flying start, with the default startup when startup_config is NULL */
+static void init_flying_start_motor(const struct FOCSensorlessStartupConfig_t *startup_config, bool is_flying_start) {
+  struct FOCSensorlessStartupConfig_t default_startup_config;
+  struct FOCSensorlessFlyingStartConfig_t flying_start_config = {
+    .enabled = is_flying_start,
+    .catch_time_us = FOC_SENSORLESS_DEFAULT_CATCH_TIME_US,
+    .min_bemf = FOC_SENSORLESS_DEFAULT_CATCH_MIN_BEMF,
+  };
+
+  if (startup_config == NULL) {
+    prepare_startup_config(&default_startup_config);
+    startup_config = &default_startup_config;
+  }
+
+  hal_mock_reset();
+  foc_sensorless_set_startup_config(startup_config);
+  foc_sensorless_set_flying_start_config(&flying_start_config);
+  foc_sensorless_create_driver(&test_motor, OBSERVER_TYPE_BACKEMF_PLL);
+  prepare_valid_config(&test_config);
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_motor.driver.init(&test_motor, &test_config));
+  test_motor.state.last_update_time = 1000;
+  test_elapsed_us = 0U;
+  test_rotor_angle = 1.0f;
+}
+
+/* Helper: Reset the mock and initialize the driver, with the default startup when startup_config is NULL */
+static void init_sensorless_motor(const struct FOCSensorlessStartupConfig_t *startup_config) {
+  init_flying_start_motor(startup_config, false);
+}
+
+/* Helper: Run the control loop at 20 kHz for a further duration_us, stopping at the first error */
+static MotorError_t run_sensorless_motor(uint32_t duration_us) {
+  for (uint32_t end = test_elapsed_us + duration_us; test_elapsed_us < end;) {
+    test_elapsed_us += 50U;
+    hal_mock_set_test_micros(1000U + test_elapsed_us);
+
+    MotorError_t status = motor_run(&test_motor);
+
+    if (status != MOTOR_OK) {
+      return status;
+    }
+  }
+
+  return MOTOR_OK;
+}
+
+static struct FOCSensorlessData_t *get_sensorless_data() {
+  return (struct FOCSensorlessData_t *)test_motor.private_data;
+}
+
+/* Helper: Create and initialize a back-EMF PLL observer with the sensorless driver default gains */
+static void init_observer() {
+  memset(&test_observer, 0, sizeof(test_observer));
+  memset(&test_observer_config, 0, sizeof(test_observer_config));
+  test_observer_config.pll_cfg.kp = FOC_SENSORLESS_DEFAULT_PLL_KP;
+  test_observer_config.pll_cfg.ki = FOC_SENSORLESS_DEFAULT_PLL_KI;
+  test_observer_config.pll_cfg.max_omega = FOC_SENSORLESS_DEFAULT_PLL_MAX_OMEGA;
+  test_observer_config.Rs = 0.5f;
+  test_observer_config.Ls = 0.001f;
+  test_observer_config.min_speed = FOC_SENSORLESS_DEFAULT_OBSERVER_MIN_SPEED;
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_backemf_pll_create_driver(&test_observer, &test_observer_config));
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_observer.driver.init(&test_observer));
+}
+
+/* Helper: Feed the observer an unloaded rotor spinning at omega. Returns the final rotor flux angle */
+static float spin_observer(float omega) {
+  float theta = 1.0f;
+  float theta_out = 0.0f;
+  float omega_out = 0.0f;
+
+  for (uint32_t i = 0U; i < TEST_OBSERVER_STEPS; i++) {
+    theta = normalize_angle(theta + omega * TEST_OBSERVER_DT);
+
+    /* With no current, the terminal voltage is the back-EMF, leading the rotor flux by 90 degrees */
+    float v_alpha = -TEST_FLUX_LINKAGE * omega * sinf(theta);
+    float v_beta = TEST_FLUX_LINKAGE * omega * cosf(theta);
+
+    TEST_ASSERT_EQUAL(MOTOR_OK, test_observer.driver.update(&test_observer, v_alpha, v_beta, 0.0f, 0.0f, TEST_OBSERVER_DT, &theta_out,
+                                                            &omega_out));
+  }
+
+  return theta;
+}
+
+static float angle_difference(float a, float b) {
+  return normalize_angle(a - b + MATH_PI) - MATH_PI;
+}
+
+/* Helper: Run the control loop at 20 kHz with the bridge off and the terminals at the back-EMF of a rotor spinning at omega.
+ * Returns the final rotor flux angle */
+static float coast_sensorless_motor(float omega, uint32_t duration_us) {
+  for (uint32_t end = test_elapsed_us + duration_us; test_elapsed_us < end;) {
+    test_elapsed_us += 50U;
+    test_rotor_angle = normalize_angle(test_rotor_angle + omega * 50e-6f);
+
+    /* Phase A back-EMF leads the rotor flux by 90 degrees, B and C follow 120 degrees apart, around a 12 V star point */
+    for (uint8_t phase = 0U; phase < NUM_MOTOR_PHASES; phase++) {
+      float phase_angle = test_rotor_angle - (float)phase * MATH_TWO_PI / 3.0f;
+      hal_mock_set_test_phase_voltage((MotorPhase_t)phase, 12.0f - TEST_FLUX_LINKAGE * omega * sinf(phase_angle));
+    }
+
+    hal_mock_set_test_micros(1000U + test_elapsed_us);
+    TEST_ASSERT_EQUAL(MOTOR_OK, motor_run(&test_motor));
+  }
+
+  return test_rotor_angle;
+}
+
+/* Helper: Fill an injection observer configuration with the sensorless driver defaults and the given inductances */
+static void prepare_hfi_config(struct HFIObserverConfig_t *hfi_config, float inductance_d, float inductance_q) {
+  memset(hfi_config, 0, sizeof(*hfi_config));
+  hfi_config->pll_cfg.kp = FOC_SENSORLESS_DEFAULT_HFI_PLL_KP;
+  hfi_config->pll_cfg.ki = FOC_SENSORLESS_DEFAULT_HFI_PLL_KI;
+  hfi_config->pll_cfg.max_omega = FOC_SENSORLESS_DEFAULT_PLL_MAX_OMEGA;
+  hfi_config->injection_voltage = FOC_SENSORLESS_DEFAULT_HFI_INJECTION_VOLTAGE;
+  hfi_config->Ld = inductance_d;
+  hfi_config->Lq = inductance_q;
+  hfi_config->crossover_low = FOC_SENSORLESS_DEFAULT_HFI_CROSSOVER_LOW;
+  hfi_config->crossover_high = FOC_SENSORLESS_DEFAULT_HFI_CROSSOVER_HIGH;
+}
+
+/* Helper: Create an injection observer on a salient rotor, blending into a back-EMF PLL observer with the driver defaults */
+static MotorError_t init_hfi_observer(float inductance_d, float inductance_q) {
+  init_observer();
+  prepare_hfi_config(&test_hfi_config, inductance_d, inductance_q);
+  memset(&test_observer, 0, sizeof(test_observer));
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_hfi_create_driver(&test_observer, &test_hfi_config, &test_observer_config));
+  return test_observer.driver.init(&test_observer);
+}
+
+/* Helper: Apply the injection to a salient rotor held at rotor_angle, with no fundamental voltage or current */
+static void inject_standstill_rotor(float rotor_angle, uint32_t steps) {
+  float i_alpha = 0.0f;
+  float i_beta = 0.0f;
+  float theta_out = 0.0f;
+  float omega_out = 0.0f;
+
+  for (uint32_t i = 0U; i < steps; i++) {
+    float v_alpha, v_beta, v_d, v_q, di_alpha, di_beta;
+
+    TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_hfi_get_injection(&test_observer, &v_alpha, &v_beta));
+
+    /* Each axis of the rotor integrates its share of the pulse through its own inductance */
+    park_transform(v_alpha, v_beta, rotor_angle, &v_d, &v_q);
+    inverse_park_transform(v_d * TEST_OBSERVER_DT / TEST_INDUCTANCE_D, v_q * TEST_OBSERVER_DT / TEST_INDUCTANCE_Q, rotor_angle, &di_alpha,
+                           &di_beta);
+    i_alpha += di_alpha;
+    i_beta += di_beta;
+
+    TEST_ASSERT_EQUAL(MOTOR_OK, test_observer.driver.update(&test_observer, v_alpha, v_beta, i_alpha, i_beta, TEST_OBSERVER_DT,
+                                                            &theta_out, &omega_out));
+  }
+}
+
+/* Helper: Reset the mock and initialize the driver with the injection observer */
+static MotorError_t init_hfi_motor(float inductance_d, float inductance_q) {
+  struct FOCSensorlessStartupConfig_t startup_config;
+  struct FOCSensorlessFlyingStartConfig_t flying_start_config = {
+    .enabled = false,
+    .catch_time_us = FOC_SENSORLESS_DEFAULT_CATCH_TIME_US,
+    .min_bemf = FOC_SENSORLESS_DEFAULT_CATCH_MIN_BEMF,
+  };
+
+  prepare_startup_config(&startup_config);
+  prepare_hfi_config(&test_hfi_config, inductance_d, inductance_q);
+
+  hal_mock_reset();
+  foc_sensorless_set_startup_config(&startup_config);
+  foc_sensorless_set_flying_start_config(&flying_start_config);
+  foc_sensorless_set_hfi_config(&test_hfi_config);
+  foc_sensorless_create_driver(&test_motor, OBSERVER_TYPE_HFI);
+  prepare_valid_config(&test_config);
+  test_motor.state.last_update_time = 1000;
+  test_elapsed_us = 0U;
+
+  return test_motor.driver.init(&test_motor, &test_config);
+}
+
+void test_backemf_pll_observer_locks_forward() {
+  init_observer();
+
+  float theta = spin_observer(TEST_ELECTRICAL_SPEED);
+
+  bool is_converged = false;
+  uint32_t update_count = 0U;
+  float max_error = 0.0f;
+
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, 0.0f, angle_difference(test_observer.estimated_theta, theta));
+  TEST_ASSERT_FLOAT_WITHIN(5.0f, TEST_ELECTRICAL_SPEED, test_observer.estimated_omega);
+  TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_backemf_pll_get_status(&test_observer, &is_converged, &update_count, &max_error));
+  TEST_ASSERT_TRUE(is_converged);
+  TEST_ASSERT_EQUAL_UINT32(TEST_OBSERVER_STEPS, update_count);
+}
+
+void test_backemf_pll_observer_locks_reverse() {
+  init_observer();
+
+  /* Reverse rotation points the back-EMF along the negative q-axis, the lock must not settle 180 degrees off */
+  float theta = spin_observer(-TEST_ELECTRICAL_SPEED);
+
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, 0.0f, angle_difference(test_observer.estimated_theta, theta));
+  TEST_ASSERT_FLOAT_WITHIN(5.0f, -TEST_ELECTRICAL_SPEED, test_observer.estimated_omega);
+}
+
+void test_backemf_pll_observer_not_converged_at_standstill() {
+  init_observer();
+  spin_observer(0.0f);
+
+  bool is_converged = true;
+  uint32_t update_count = 0U;
+  float max_error = 0.0f;
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_backemf_pll_get_status(&test_observer, &is_converged, &update_count, &max_error));
+  TEST_ASSERT_FALSE(is_converged);
+}
+
+void test_backemf_pll_observer_update_invalid_dt() {
+  init_observer();
+
+  float theta_out = 0.0f;
+  float omega_out = 0.0f;
+
+  TEST_ASSERT_EQUAL(MOTOR_INVALID_ARGS, test_observer.driver.update(&test_observer, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, &theta_out, &omega_out));
+}
+
+void test_backemf_pll_observer_seed_sets_estimate() {
+  init_observer();
+  spin_observer(TEST_ELECTRICAL_SPEED);
+
+  bool is_converged = true;
+  uint32_t update_count = 0U;
+  float max_error = 0.0f;
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_backemf_pll_seed(&test_observer, 1.0f, -TEST_ELECTRICAL_SPEED));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, test_observer.estimated_theta);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, -TEST_ELECTRICAL_SPEED, test_observer.estimated_omega);
+  TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_backemf_pll_get_status(&test_observer, &is_converged, &update_count, &max_error));
+  TEST_ASSERT_FALSE(is_converged);
+
+  /* Seeded with the right direction, a reverse rotor is tracked from the first sample */
+  float theta = spin_observer(-TEST_ELECTRICAL_SPEED);
+
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, 0.0f, angle_difference(test_observer.estimated_theta, theta));
+  TEST_ASSERT_FLOAT_WITHIN(5.0f, -TEST_ELECTRICAL_SPEED, test_observer.estimated_omega);
+}
+
+void test_backemf_pll_observer_seed_uninitialized() {
+  memset(&test_observer, 0, sizeof(test_observer));
+  TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_backemf_pll_create_driver(&test_observer, &test_observer_config));
+
+  TEST_ASSERT_EQUAL(MOTOR_UNINITIALIZED, foc_observer_backemf_pll_seed(&test_observer, 0.0f, 0.0f));
+  TEST_ASSERT_EQUAL(MOTOR_INVALID_ARGS, foc_observer_backemf_pll_seed(NULL, 0.0f, 0.0f));
+}
+
+void test_hfi_observer_init_round_rotor_rejected() {
+  TEST_ASSERT_EQUAL(MOTOR_INVALID_ARGS, init_hfi_observer(TEST_INDUCTANCE_D, TEST_INDUCTANCE_D));
+  TEST_ASSERT_EQUAL(MOTOR_INVALID_ARGS, init_hfi_observer(0.0f, TEST_INDUCTANCE_Q));
+}
+
+void test_hfi_observer_injection_alternates() {
+  TEST_ASSERT_EQUAL(MOTOR_OK, init_hfi_observer(TEST_INDUCTANCE_D, TEST_INDUCTANCE_Q));
+
+  float v_alpha = 0.0f;
+  float v_beta = 0.0f;
+  float theta_out = 0.0f;
+  float omega_out = 0.0f;
+
+  /* A half pulse along the estimated d-axis starts the carrier, then full pulses alternate */
+  TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_hfi_get_injection(&test_observer, &v_alpha, &v_beta));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f * FOC_SENSORLESS_DEFAULT_HFI_INJECTION_VOLTAGE, v_alpha);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, v_beta);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_observer.driver.update(&test_observer, v_alpha, v_beta, 0.0f, 0.0f, TEST_OBSERVER_DT, &theta_out,
+                                                          &omega_out));
+  TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_hfi_get_injection(&test_observer, &v_alpha, &v_beta));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, -FOC_SENSORLESS_DEFAULT_HFI_INJECTION_VOLTAGE, v_alpha);
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, test_observer.driver.update(&test_observer, v_alpha, v_beta, 0.0f, 0.0f, TEST_OBSERVER_DT, &theta_out,
+                                                          &omega_out));
+  TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_hfi_get_injection(&test_observer, &v_alpha, &v_beta));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, FOC_SENSORLESS_DEFAULT_HFI_INJECTION_VOLTAGE, v_alpha);
+}
+
+void test_hfi_observer_tracks_standstill_rotor() {
+  TEST_ASSERT_EQUAL(MOTOR_OK, init_hfi_observer(TEST_INDUCTANCE_D, TEST_INDUCTANCE_Q));
+
+  /* Started 0.6 rad off, well inside the 90 degrees the injection resolves the d-axis over */
+  inject_standstill_rotor(0.6f, TEST_OBSERVER_STEPS);
+
+  float blend = 1.0f;
+  float i_alpha = 1.0f;
+  float i_beta = 1.0f;
+
+  TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.0f, angle_difference(test_observer.estimated_theta, 0.6f));
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 0.0f, test_observer.estimated_omega);
+  TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_hfi_get_blend(&test_observer, &blend));
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, blend);
+
+  /* The carrier ripple is taken off the current, the rotor carries none of its own */
+  TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_hfi_get_fundamental_current(&test_observer, &i_alpha, &i_beta));
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, i_alpha);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, i_beta);
+}
+
+void test_hfi_observer_seed_sets_estimate() {
+  TEST_ASSERT_EQUAL(MOTOR_OK, init_hfi_observer(TEST_INDUCTANCE_D, TEST_INDUCTANCE_Q));
+
+  /* The injection only resolves the axis, a seed on the opposite polarity is held there */
+  TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_hfi_seed(&test_observer, -2.0f, 0.0f));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, normalize_angle(-2.0f), test_observer.estimated_theta);
+
+  inject_standstill_rotor(1.0f, TEST_OBSERVER_STEPS);
+  TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.0f, angle_difference(test_observer.estimated_theta, 1.0f + MATH_PI));
+
+  memset(&test_observer, 0, sizeof(test_observer));
+  TEST_ASSERT_EQUAL(MOTOR_OK, foc_observer_hfi_create_driver(&test_observer, &test_hfi_config, &test_observer_config));
+  TEST_ASSERT_EQUAL(MOTOR_UNINITIALIZED, foc_observer_hfi_seed(&test_observer, 0.0f, 0.0f));
+}
+
+void test_foc_sensorless_driver_init_starts_aligning() {
+  init_sensorless_motor(NULL);
+
+  struct FOCSensorlessData_t *foc_data = get_sensorless_data();
+  TEST_ASSERT_EQUAL(MOTOR_MODE_ALIGNING, foc_data->mode);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, foc_data->forced_angle);
+  TEST_ASSERT_EQUAL_FLOAT(test_config.phase_resistance, foc_data->backemf_pll_config.Rs);
+  TEST_ASSERT_EQUAL_FLOAT(test_config.phase_inductance, foc_data->backemf_pll_config.Ls);
+}
+
+void test_foc_sensorless_driver_init_unsupported_observer() {
+  hal_mock_reset();
+  foc_sensorless_create_driver(&test_motor, OBSERVER_TYPE_SMO);
+  prepare_valid_config(&test_config);
+
+  TEST_ASSERT_EQUAL(MOTOR_INIT_ERROR, test_motor.driver.init(&test_motor, &test_config));
+}
+
+void test_foc_sensorless_driver_aligning_drives_d_axis() {
+  init_sensorless_motor(NULL);
+
+  /* Past the alignment current ramp. No current flows in the mock, so the d-axis voltage saturates */
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_sensorless_motor(FOC_SENSORLESS_DEFAULT_ALIGN_TIME_US / 2U));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_ALIGNING, get_sensorless_data()->mode);
+
+  /* Halfway through, the vector is 90 degrees ahead of the start angle, on the beta axis */
+  float *duties = hal_mock_get_test_pwm_duty_cycles();
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, MATH_PI_OVER_2, get_sensorless_data()->forced_angle);
+  TEST_ASSERT_TRUE(duties[MOTOR_PHASE_B] > 0.5f);
+  TEST_ASSERT_TRUE(duties[MOTOR_PHASE_C] < 0.5f);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, duties[MOTOR_PHASE_A]);
+
+  /* Then turned back onto the start angle, the vector lies on phase A */
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_sensorless_motor(FOC_SENSORLESS_DEFAULT_ALIGN_TIME_US / 2U - 50U));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_ALIGNING, get_sensorless_data()->mode);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, get_sensorless_data()->forced_angle);
+  TEST_ASSERT_TRUE(duties[MOTOR_PHASE_A] > 0.5f);
+  TEST_ASSERT_TRUE(duties[MOTOR_PHASE_B] < 0.5f);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, duties[MOTOR_PHASE_B], duties[MOTOR_PHASE_C]);
+  TEST_ASSERT_EQUAL_UINT8(5U, hal_mock_get_test_gpio_states()[MOTOR_PHASE_A]);
+}
+
+void test_foc_sensorless_driver_open_loop_ramps_forced_angle() {
+  struct FOCSensorlessStartupConfig_t startup_config;
+  prepare_startup_config(&startup_config);
+  startup_config.align_time_us = 1000U;
+
+  init_sensorless_motor(&startup_config);
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_sensorless_motor(1000U + 10000U));
+
+  /* 10 ms of I/f ramp */
+  struct FOCSensorlessData_t *foc_data = get_sensorless_data();
+  TEST_ASSERT_EQUAL(MOTOR_MODE_OPEN_LOOP, foc_data->mode);
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, FOC_SENSORLESS_DEFAULT_RAMP_ACCELERATION * 0.01f, foc_data->forced_velocity);
+  TEST_ASSERT_TRUE(foc_data->forced_angle > 0.0f);
+}
+
+void test_foc_sensorless_driver_startup_stall_times_out() {
+  struct FOCSensorlessStartupConfig_t startup_config;
+  prepare_startup_config(&startup_config);
+  startup_config.align_time_us = 1000U;
+  startup_config.transition_timeout_us = 5000U;
+
+  init_sensorless_motor(&startup_config);
+
+  /* Without a bus voltage nothing is applied, there is no back-EMF for the observer to lock onto */
+  hal_mock_set_test_dc_voltage(0.0f);
+
+  TEST_ASSERT_EQUAL(MOTOR_INIT_ERROR, run_sensorless_motor(1000U + 10000U));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_ERROR, get_sensorless_data()->mode);
+
+  uint8_t *gpio_states = hal_mock_get_test_gpio_states();
+
+  for (uint8_t phase = 0U; phase < NUM_MOTOR_PHASES; phase++) {
+    TEST_ASSERT_EQUAL_UINT8(0U, gpio_states[phase]);
+  }
+}
+
+void test_foc_sensorless_driver_flying_start_standstill_aligns() {
+  init_flying_start_motor(NULL, true);
+
+  struct FOCSensorlessData_t *foc_data = get_sensorless_data();
+  TEST_ASSERT_EQUAL(MOTOR_MODE_CATCHING, foc_data->mode);
+
+  /* No back-EMF on the terminals, the rotor stands and goes through the I/f startup */
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_sensorless_motor(50U));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_ALIGNING, foc_data->mode);
+}
+
+void test_foc_sensorless_driver_flying_start_catches_rotor() {
+  init_flying_start_motor(NULL, true);
+
+  struct FOCSensorlessData_t *foc_data = get_sensorless_data();
+
+  /* Still measuring halfway through the window, with the bridge off */
+  coast_sensorless_motor(-TEST_ELECTRICAL_SPEED, FOC_SENSORLESS_DEFAULT_CATCH_TIME_US / 2U);
+  TEST_ASSERT_EQUAL(MOTOR_MODE_CATCHING, foc_data->mode);
+
+  for (uint8_t phase = 0U; phase < NUM_MOTOR_PHASES; phase++) {
+    TEST_ASSERT_EQUAL_UINT8(0U, hal_mock_get_test_gpio_states()[phase]);
+  }
+
+  /* A reverse rotor is picked up at its speed and flux angle, skipping the startup */
+  float theta = coast_sensorless_motor(-TEST_ELECTRICAL_SPEED, FOC_SENSORLESS_DEFAULT_CATCH_TIME_US / 2U + 50U);
+  TEST_ASSERT_EQUAL(MOTOR_MODE_RUNNING, foc_data->mode);
+  TEST_ASSERT_FLOAT_WITHIN(5.0f, -TEST_ELECTRICAL_SPEED, foc_data->observer.estimated_omega);
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, 0.0f, angle_difference(foc_data->observer.estimated_theta, theta));
+
+  /* The q-axis loop starts out producing the back-EMF */
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, -TEST_FLUX_LINKAGE * TEST_ELECTRICAL_SPEED, foc_data->vq);
+}
+
+void test_foc_sensorless_driver_hfi_requires_saliency() {
+  TEST_ASSERT_EQUAL(MOTOR_INIT_ERROR, init_hfi_motor(0.0f, 0.0f));
+}
+
+void test_foc_sensorless_driver_hfi_aligns_then_runs() {
+  TEST_ASSERT_EQUAL(MOTOR_OK, init_hfi_motor(TEST_INDUCTANCE_D, TEST_INDUCTANCE_Q));
+
+  struct FOCSensorlessData_t *foc_data = get_sensorless_data();
+  TEST_ASSERT_EQUAL(MOTOR_MODE_ALIGNING, foc_data->mode);
+
+  /* The alignment gives the injection its polarity, closed-loop starts from standstill without the I/f ramp */
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_sensorless_motor(FOC_SENSORLESS_DEFAULT_ALIGN_TIME_US + 50U));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_RUNNING, foc_data->mode);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, angle_difference(foc_data->observer.estimated_theta, 0.0f));
+
+  TEST_ASSERT_EQUAL(MOTOR_OK, run_sensorless_motor(10000U));
+  TEST_ASSERT_EQUAL(MOTOR_MODE_RUNNING, foc_data->mode);
+}
+
+void test_foc_sensorless_driver_set_position_rejected() {
+  init_sensorless_motor(NULL);
+
+  TEST_ASSERT_EQUAL(MOTOR_INVALID_ARGS, test_motor.driver.set_position(&test_motor, 1.0f));
+}
+
+void run_foc_sensorless_driver_tests() {
+  RUN_TEST(test_backemf_pll_observer_locks_forward);
+  RUN_TEST(test_backemf_pll_observer_locks_reverse);
+  RUN_TEST(test_backemf_pll_observer_not_converged_at_standstill);
+  RUN_TEST(test_backemf_pll_observer_update_invalid_dt);
+  RUN_TEST(test_backemf_pll_observer_seed_sets_estimate);
+  RUN_TEST(test_backemf_pll_observer_seed_uninitialized);
+  RUN_TEST(test_hfi_observer_init_round_rotor_rejected);
+  RUN_TEST(test_hfi_observer_injection_alternates);
+  RUN_TEST(test_hfi_observer_tracks_standstill_rotor);
+  RUN_TEST(test_hfi_observer_seed_sets_estimate);
+  RUN_TEST(test_foc_sensorless_driver_init_starts_aligning);
+  RUN_TEST(test_foc_sensorless_driver_init_unsupported_observer);
+  RUN_TEST(test_foc_sensorless_driver_aligning_drives_d_axis);
+  RUN_TEST(test_foc_sensorless_driver_open_loop_ramps_forced_angle);
+  RUN_TEST(test_foc_sensorless_driver_startup_stall_times_out);
+  RUN_TEST(test_foc_sensorless_driver_flying_start_standstill_aligns);
+  RUN_TEST(test_foc_sensorless_driver_flying_start_catches_rotor);
+  RUN_TEST(test_foc_sensorless_driver_hfi_requires_saliency);
+  RUN_TEST(test_foc_sensorless_driver_hfi_aligns_then_runs);
+  RUN_TEST(test_foc_sensorless_driver_set_position_rejected);
+}
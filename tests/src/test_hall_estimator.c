@@ -0,0 +1,191 @@
+/*******************************************************************************************************************************
+ * @file   test_hall_estimator.c
+ *
+ * @brief  Source file for Hall estimator unit tests
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+#include "hall_estimator.h"
+#include "math_utils.h"
+#include "unity.h"
+
+/* Intra-component Headers */
+
+#define TEST_SECTOR_PERIOD_US 1000U
+
+static const uint8_t test_forward_sequence[HALL_NUM_SECTORS] = { 0b011, 0b001, 0b101, 0b100, 0b110, 0b010 };
+
+static struct HallEstimatorConfig_t test_config = {
+  .angle_offset = 0.0f,
+  .stale_timeout_us = 10000U,
+};
+
+static struct HallEstimatorState_t test_state;
+static float test_theta;
+static float test_omega;
+
+static void test_hall_estimator_feed(uint8_t sector, uint32_t now_us) {
+  TEST_ASSERT_EQUAL(UTILS_OK, hall_estimator_update(&test_state, test_forward_sequence[sector], now_us, &test_theta, &test_omega));
+}
+
+void test_hall_estimator_sector_decode() {
+  for (uint8_t sector = 0U; sector < HALL_NUM_SECTORS; sector++) {
+    TEST_ASSERT_EQUAL_UINT8(sector, hall_state_to_sector(test_forward_sequence[sector]));
+  }
+
+  TEST_ASSERT_EQUAL_UINT8(HALL_INVALID_SECTOR, hall_state_to_sector(0b000));
+  TEST_ASSERT_EQUAL_UINT8(HALL_INVALID_SECTOR, hall_state_to_sector(0b111));
+}
+
+void test_hall_estimator_invalid_state() {
+  hall_estimator_init(&test_state, &test_config);
+
+  TEST_ASSERT_EQUAL(UTILS_INVALID_ARGS, hall_estimator_update(&test_state, 0b111, 0U, &test_theta, &test_omega));
+  TEST_ASSERT_EQUAL(UTILS_INVALID_ARGS, hall_estimator_init(NULL, &test_config));
+}
+
+void test_hall_estimator_first_state_sector_center() {
+  hall_estimator_init(&test_state, &test_config);
+  test_hall_estimator_feed(2U, 1000U);
+
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 2.5f * MATH_PI_OVER_3, test_theta);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, test_omega);
+}
+
+void test_hall_estimator_forward_interpolation() {
+  hall_estimator_init(&test_state, &test_config);
+  test_hall_estimator_feed(0U, 1000U);
+  test_hall_estimator_feed(1U, 2000U);
+  test_hall_estimator_feed(2U, 2000U + TEST_SECTOR_PERIOD_US);
+
+  float expected_omega = MATH_PI_OVER_3 / (TEST_SECTOR_PERIOD_US * 1e-6f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 2.0f * MATH_PI_OVER_3, test_theta);
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, expected_omega, test_omega);
+
+  /* Halfway through the sector the angle is interpolated halfway between the boundaries */
+  test_hall_estimator_feed(2U, 2000U + TEST_SECTOR_PERIOD_US + TEST_SECTOR_PERIOD_US / 2U);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 2.5f * MATH_PI_OVER_3, test_theta);
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, expected_omega, test_omega);
+}
+
+void test_hall_estimator_reverse_interpolation() {
+  hall_estimator_init(&test_state, &test_config);
+  test_hall_estimator_feed(3U, 1000U);
+  test_hall_estimator_feed(2U, 2000U);
+  test_hall_estimator_feed(1U, 2000U + TEST_SECTOR_PERIOD_US);
+
+  /* Reverse rotation enters sector 1 at its upper boundary */
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 2.0f * MATH_PI_OVER_3, test_theta);
+  TEST_ASSERT_TRUE(test_omega < 0.0f);
+
+  test_hall_estimator_feed(1U, 2000U + TEST_SECTOR_PERIOD_US + TEST_SECTOR_PERIOD_US / 2U);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 1.5f * MATH_PI_OVER_3, test_theta);
+}
+
+void test_hall_estimator_reversal_resets_speed() {
+  hall_estimator_init(&test_state, &test_config);
+  test_hall_estimator_feed(0U, 1000U);
+  test_hall_estimator_feed(1U, 2000U);
+  test_hall_estimator_feed(2U, 3000U);
+  test_hall_estimator_feed(1U, 4000U);
+
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, test_omega);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 2.0f * MATH_PI_OVER_3, test_theta);
+}
+
+void test_hall_estimator_overdue_edge_clamps_to_boundary() {
+  hall_estimator_init(&test_state, &test_config);
+  test_hall_estimator_feed(0U, 1000U);
+  test_hall_estimator_feed(1U, 2000U);
+  test_hall_estimator_feed(2U, 3000U);
+
+  /* Rotor slowed down. The estimate must not run past the next boundary */
+  test_hall_estimator_feed(2U, 3000U + 2U * TEST_SECTOR_PERIOD_US);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 3.0f * MATH_PI_OVER_3, test_theta);
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, MATH_PI_OVER_3 / (2.0f * TEST_SECTOR_PERIOD_US * 1e-6f), test_omega);
+}
+
+void test_hall_estimator_stale_timeout() {
+  hall_estimator_init(&test_state, &test_config);
+  test_hall_estimator_feed(0U, 1000U);
+  test_hall_estimator_feed(1U, 2000U);
+  test_hall_estimator_feed(2U, 3000U);
+  test_hall_estimator_feed(2U, 3000U + test_config.stale_timeout_us + 1U);
+
+  TEST_ASSERT_FALSE(test_state.is_tracking);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, test_omega);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 2.0f * MATH_PI_OVER_3, test_theta);
+}
+
+void test_hall_estimator_angle_offset_wraps() {
+  struct HallEstimatorConfig_t offset_config = {
+    .angle_offset = MATH_PI_OVER_3,
+    .stale_timeout_us = 10000U,
+  };
+
+  hall_estimator_init(&test_state, &offset_config);
+  test_hall_estimator_feed(5U, 1000U);
+
+  /* Sector 5 center plus one sector of offset wraps past 2π */
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.5f * MATH_PI_OVER_3, test_theta);
+}
+
+void test_hall_estimator_glitch_holds_estimate() {
+  struct HallEstimatorConfig_t glitch_config = {
+    .angle_offset = 0.0f,
+    .stale_timeout_us = 10000U,
+    .max_invalid_reads = 2U,
+  };
+
+  hall_estimator_init(&test_state, &glitch_config);
+  test_hall_estimator_feed(0U, 1000U);
+  test_hall_estimator_feed(1U, 2000U);
+  test_hall_estimator_feed(2U, 2000U + TEST_SECTOR_PERIOD_US);
+
+  /* One illegal sample halfway through the sector keeps the extrapolation going */
+  TEST_ASSERT_EQUAL(UTILS_OK, hall_estimator_update(&test_state, 0b000, 2000U + TEST_SECTOR_PERIOD_US + TEST_SECTOR_PERIOD_US / 2U,
+                                                    &test_theta, &test_omega));
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 2.5f * MATH_PI_OVER_3, test_theta);
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, MATH_PI_OVER_3 / (TEST_SECTOR_PERIOD_US * 1e-6f), test_omega);
+  TEST_ASSERT_TRUE(test_state.is_tracking);
+
+  /* The next valid sample continues from the same sector and clears the count */
+  test_hall_estimator_feed(3U, 2000U + 2U * TEST_SECTOR_PERIOD_US);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 3.0f * MATH_PI_OVER_3, test_theta);
+  TEST_ASSERT_TRUE(test_state.is_tracking);
+  TEST_ASSERT_EQUAL_UINT8(0U, test_state.invalid_reads);
+}
+
+void test_hall_estimator_consecutive_invalid_reads_fail() {
+  struct HallEstimatorConfig_t glitch_config = {
+    .angle_offset = 0.0f,
+    .stale_timeout_us = 10000U,
+    .max_invalid_reads = 2U,
+  };
+
+  hall_estimator_init(&test_state, &glitch_config);
+  test_hall_estimator_feed(0U, 1000U);
+
+  TEST_ASSERT_EQUAL(UTILS_OK, hall_estimator_update(&test_state, 0b111, 1100U, &test_theta, &test_omega));
+  TEST_ASSERT_EQUAL(UTILS_OK, hall_estimator_update(&test_state, 0b111, 1200U, &test_theta, &test_omega));
+  TEST_ASSERT_EQUAL(UTILS_INVALID_ARGS, hall_estimator_update(&test_state, 0b111, 1300U, &test_theta, &test_omega));
+}
+
+void run_hall_estimator_tests() {
+  RUN_TEST(test_hall_estimator_sector_decode);
+  RUN_TEST(test_hall_estimator_invalid_state);
+  RUN_TEST(test_hall_estimator_first_state_sector_center);
+  RUN_TEST(test_hall_estimator_forward_interpolation);
+  RUN_TEST(test_hall_estimator_reverse_interpolation);
+  RUN_TEST(test_hall_estimator_reversal_resets_speed);
+  RUN_TEST(test_hall_estimator_overdue_edge_clamps_to_boundary);
+  RUN_TEST(test_hall_estimator_stale_timeout);
+  RUN_TEST(test_hall_estimator_angle_offset_wraps);
+  RUN_TEST(test_hall_estimator_glitch_holds_estimate);
+  RUN_TEST(test_hall_estimator_consecutive_invalid_reads_fail);
+}
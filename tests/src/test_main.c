@@ -10,9 +10,15 @@
 /* Standard library Headers */
 
 /* Inter-component Headers */
+#include "test_bldc_6step_common.h"
+#include "test_bldc_sensored_driver.h"
 #include "test_bldc_sensorless_driver.h"
+#include "test_foc_sensorless_driver.h"
+#include "test_hall_estimator.h"
 #include "test_math_utils.h"
 #include "test_pid.h"
+#include "test_pll.h"
+#include "test_telemetry_ring.h"
 #include "unity.h"
 
 /* Intra-component Headers */
@@ -31,6 +37,12 @@ int main() {
   UNITY_BEGIN();
   run_pid_tests();
   run_math_utils_tests();
+  run_pll_tests();
+  run_bldc_6step_common_tests();
   run_bldc_sensorless_driver_tests();
+  run_bldc_sensored_driver_tests();
+  run_hall_estimator_tests();
+  run_foc_sensorless_driver_tests();
+  run_telemetry_ring_tests();
   return UNITY_END();
 }
@@ -39,8 +39,25 @@ void test_clamp_lsmin() {
   TEST_ASSERT_FLOAT_WITHIN(0.1f, test_min_output, clamp(test_input, test_min_output, test_max_output));
 }
 
+void test_fast_inv_sqrt() {
+  float test_inputs[] = { 1e-4f, 0.25f, 1.0f, 2.0f, 1e4f };
+
+  for (unsigned int i = 0; i < sizeof(test_inputs) / sizeof(test_inputs[0]); i++) {
+    float expected = 1.0f / sqrtf(test_inputs[i]);
+    TEST_ASSERT_FLOAT_WITHIN(5e-6f * expected, expected, fast_inv_sqrt(test_inputs[i]));
+  }
+
+  /* The error repeats every factor of 4, sweep one such span for the worst case */
+  for (unsigned int i = 0; i < 3000; i++) {
+    float x = 1.0f + (float)i * 1e-3f;
+    float expected = 1.0f / sqrtf(x);
+    TEST_ASSERT_FLOAT_WITHIN(5e-6f * expected, expected, fast_inv_sqrt(x));
+  }
+}
+
 void run_math_utils_tests() {
   RUN_TEST(test_clamp_btwn);
   RUN_TEST(test_clamp_gtmax);
   RUN_TEST(test_clamp_lsmin);
+  RUN_TEST(test_fast_inv_sqrt);
 }
@@ -233,6 +233,39 @@ void test_pid_integral_windup_negative() {
   }
 }
 
+void test_pid_integral_windup_negative_recovers() {
+  struct PidConfig_t config = { .kp = 0.0f, .ki = 1.0f, .kd = 0.0f, .output_max = 10.0f, .output_min = -10.0f, .derivative_ema_alpha = 1.0f };
+
+  struct PidController_t pid;
+  pid_init(&pid, &config);
+
+  for (int i = 0; i < 5; i++) {
+    pid_update(&pid, -20.0f, 0.0f, 1.0f);
+  }
+
+  /* The integral is held at the lower limit, so a reversed error leaves saturation right away */
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, -10.0f, pid.integral);
+  float output = pid_update(&pid, 20.0f, 0.0f, 1.0f);
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, -10.0f, output);
+  output = pid_update(&pid, 20.0f, 0.0f, 1.0f);
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, 10.0f, output);
+}
+
+void test_pid_proportional_saturation_holds_integral() {
+  struct PidConfig_t config = { .kp = 10.0f, .ki = 1.0f, .kd = 0.0f, .output_max = 10.0f, .output_min = -10.0f, .derivative_ema_alpha = 1.0f };
+
+  struct PidController_t pid;
+  pid_init(&pid, &config);
+
+  /* The proportional term alone saturates, the integral must not be pushed to the opposite sign */
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, -10.0f, pid_update(&pid, -20.0f, 0.0f, 1.0f));
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, -10.0f, pid_update(&pid, -20.0f, 0.0f, 1.0f));
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, pid.integral);
+
+  /* Small opposite error right after saturation is answered in its own sign */
+  TEST_ASSERT_TRUE(pid_update(&pid, 0.5f, 0.0f, 0.01f) > 0.0f);
+}
+
 void test_pid_zero_delta_time() {
   struct PidConfig_t config = { .kp = 1.0f, .ki = 1.0f, .kd = 1.0f, .output_max = 100.0f, .output_min = -100.0f, .derivative_ema_alpha = 1.0f };
 
@@ -286,6 +319,39 @@ void test_pid_changing_setpoint() {
   TEST_ASSERT_TRUE(output > first_output);
 }
 
+void test_pid_reload_config() {
+  struct PidConfig_t config = { .kp = 1.0f, .ki = 1.0f, .kd = 0.0f, .output_max = 100.0f, .output_min = -100.0f, .derivative_ema_alpha = 1.0f };
+
+  struct PidController_t pid;
+  pid_init(&pid, &config);
+
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 7.5f, pid_update(&pid, 5.0f, 0.0f, 1.0f));
+
+  /* The controller runs on its copy of the gains until the configuration is reloaded */
+  config.kp = 2.0f;
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 12.5f, pid_update(&pid, 5.0f, 0.0f, 1.0f));
+
+  pid_reload_config(&pid);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 2.0f, pid.gains.kp);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 7.5f, pid.integral);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 22.5f, pid_update(&pid, 5.0f, 0.0f, 1.0f));
+}
+
+void test_pid_set_output_limits() {
+  struct PidConfig_t config = { .kp = 1.0f, .ki = 0.0f, .kd = 0.0f, .output_max = 100.0f, .output_min = -100.0f, .derivative_ema_alpha = 1.0f };
+
+  struct PidController_t pid;
+  pid_init(&pid, &config);
+  pid_set_output_limits(&pid, -2.0f, 3.0f);
+
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 3.0f, pid_update(&pid, 10.0f, 0.0f, 1.0f));
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, -2.0f, pid_update(&pid, -10.0f, 0.0f, 1.0f));
+
+  /* The configuration keeps its own limits */
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 100.0f, config.output_max);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, -100.0f, config.output_min);
+}
+
 void run_pid_tests() {
   RUN_TEST(test_pid_init);
   RUN_TEST(test_pid_invalid_config);
@@ -299,7 +365,11 @@ void run_pid_tests() {
   RUN_TEST(test_pid_kd_with_ema_filter);
   RUN_TEST(test_pid_integral_windup_positive);
   RUN_TEST(test_pid_integral_windup_negative);
+  RUN_TEST(test_pid_integral_windup_negative_recovers);
+  RUN_TEST(test_pid_proportional_saturation_holds_integral);
   RUN_TEST(test_pid_zero_delta_time);
   RUN_TEST(test_pid_large_delta_time);
   RUN_TEST(test_pid_changing_setpoint);
+  RUN_TEST(test_pid_reload_config);
+  RUN_TEST(test_pid_set_output_limits);
 }
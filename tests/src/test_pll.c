@@ -0,0 +1,163 @@
+/*******************************************************************************************************************************
+ * @file   test_pll.c
+ *
+ * @brief  Source file for PLL tests
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <math.h>
+#include <stddef.h>
+
+/* Inter-component Headers */
+#include "math_utils.h"
+#include "pll.h"
+#include "unity.h"
+
+/* Intra-component Headers */
+
+#define TEST_PLL_DT 0.00005f            /**< Update period, 20 kHz [s] */
+#define TEST_PLL_BANDWIDTH 300.0f       /**< Bandwidth of the fixed gain loops [rad/s] */
+#define TEST_PLL_MAX_OMEGA 10000.0f     /**< Speed limit [rad/s] */
+#define TEST_PLL_ACCELERATION 5000.0f   /**< Acceleration of the tracked ramps [rad/s^2] */
+
+static const struct PLLGainPoint_t test_gain_schedule[] = {
+  { 100.0f, 300.0f },
+  { 900.0f, 600.0f },
+};
+
+/* Helper: Track an angle accelerating from standstill for the given time, returns the final angle error */
+static float track_speed_ramp(const struct PLLConfig_t *config, float duration) {
+  struct PLLState_t state;
+  float theta = 0.0f;
+  float omega = 0.0f;
+  float time = 0.0f;
+  float phase_error = 0.0f;
+
+  TEST_ASSERT_EQUAL(UTILS_OK, pll_init(&state, config));
+
+  for (uint32_t i = 0U; (float)i * TEST_PLL_DT < duration; i++) {
+    time = (float)(i + 1U) * TEST_PLL_DT;
+    phase_error = normalize_angle(0.5f * TEST_PLL_ACCELERATION * time * time - state.theta + MATH_PI) - MATH_PI;
+    TEST_ASSERT_EQUAL(UTILS_OK, pll_update(&state, sinf(phase_error), TEST_PLL_DT, &theta, &omega));
+  }
+
+  return phase_error;
+}
+
+/* Helper: Speed out of one update from the given integrator speed, with the acceleration integrator at rest */
+static float update_from_speed(const struct PLLConfig_t *config, float integrator, float phase_error) {
+  struct PLLState_t state;
+  float theta = 0.0f;
+  float omega = 0.0f;
+
+  TEST_ASSERT_EQUAL(UTILS_OK, pll_init(&state, config));
+  state.integrator = integrator;
+  TEST_ASSERT_EQUAL(UTILS_OK, pll_update(&state, phase_error, TEST_PLL_DT, &theta, &omega));
+
+  return omega;
+}
+
+void test_pll_init_rejects_empty_schedule() {
+  struct PLLState_t state;
+  struct PLLConfig_t config = { .kp = 600.0f, .ki = 90000.0f, .max_omega = TEST_PLL_MAX_OMEGA };
+
+  config.gain_schedule = test_gain_schedule;
+  config.num_gain_points = 0U;
+
+  TEST_ASSERT_EQUAL(UTILS_INVALID_ARGS, pll_init(&state, &config));
+}
+
+void test_pll_type2_lags_speed_ramp() {
+  struct PLLConfig_t config = {
+    .kp = 2.0f * TEST_PLL_BANDWIDTH,
+    .ki = TEST_PLL_BANDWIDTH * TEST_PLL_BANDWIDTH,
+    .max_omega = TEST_PLL_MAX_OMEGA,
+  };
+
+  /* The integrator only moves with an error, a constant acceleration leaves acceleration / ki behind */
+  float expected_error = TEST_PLL_ACCELERATION / config.ki;
+
+  TEST_ASSERT_FLOAT_WITHIN(0.05f * expected_error, expected_error, track_speed_ramp(&config, 0.1f));
+}
+
+void test_pll_type3_tracks_speed_ramp() {
+  struct PLLConfig_t config = {
+    .kp = 3.0f * TEST_PLL_BANDWIDTH,
+    .ki = 3.0f * TEST_PLL_BANDWIDTH * TEST_PLL_BANDWIDTH,
+    .max_omega = TEST_PLL_MAX_OMEGA,
+    .track_acceleration = true,
+    .ka = TEST_PLL_BANDWIDTH * TEST_PLL_BANDWIDTH * TEST_PLL_BANDWIDTH,
+  };
+
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, track_speed_ramp(&config, 0.1f));
+}
+
+void test_pll_schedule_interpolates_bandwidth() {
+  struct PLLConfig_t config = { .kp = 1.0f, .ki = 1.0f, .max_omega = TEST_PLL_MAX_OMEGA };
+  float phase_error = 0.01f;
+
+  config.gain_schedule = test_gain_schedule;
+  config.num_gain_points = (uint8_t)(sizeof(test_gain_schedule) / sizeof(test_gain_schedule[0]));
+
+  /* Halfway between the entries, 450 rad/s. kp = 2 * bw, ki = bw^2 */
+  float expected = 500.0f + 2.0f * 450.0f * phase_error + 450.0f * 450.0f * phase_error * TEST_PLL_DT;
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, expected, update_from_speed(&config, 500.0f, phase_error));
+
+  /* Scheduled on the absolute speed */
+  expected = -500.0f + 2.0f * 450.0f * phase_error + 450.0f * 450.0f * phase_error * TEST_PLL_DT;
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, expected, update_from_speed(&config, -500.0f, phase_error));
+
+  /* Held at the end entries */
+  expected = 50.0f + 2.0f * 300.0f * phase_error + 300.0f * 300.0f * phase_error * TEST_PLL_DT;
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, expected, update_from_speed(&config, 50.0f, phase_error));
+  expected = 2000.0f + 2.0f * 600.0f * phase_error + 600.0f * 600.0f * phase_error * TEST_PLL_DT;
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, expected, update_from_speed(&config, 2000.0f, phase_error));
+
+  /* Type 3 places all three poles at the bandwidth, ka = bw^3 enters the speed integrator in the same update */
+  config.track_acceleration = true;
+  float acceleration = 450.0f * 450.0f * 450.0f * phase_error * TEST_PLL_DT;
+  expected = 500.0f + 3.0f * 450.0f * phase_error + (3.0f * 450.0f * 450.0f * phase_error + acceleration) * TEST_PLL_DT;
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, expected, update_from_speed(&config, 500.0f, phase_error));
+}
+
+void test_pll_integrators_held_at_max_omega() {
+  struct PLLConfig_t config = {
+    .kp = 3.0f * TEST_PLL_BANDWIDTH,
+    .ki = 3.0f * TEST_PLL_BANDWIDTH * TEST_PLL_BANDWIDTH,
+    .max_omega = 1000.0f,
+    .track_acceleration = true,
+    .ka = TEST_PLL_BANDWIDTH * TEST_PLL_BANDWIDTH * TEST_PLL_BANDWIDTH,
+  };
+  struct PLLState_t state;
+  float theta = 0.0f;
+  float omega = 0.0f;
+
+  TEST_ASSERT_EQUAL(UTILS_OK, pll_init(&state, &config));
+
+  /* A radian of error held long enough to drive the speed integrator to the limit */
+  for (uint32_t i = 0U; i < 4000U; i++) {
+    TEST_ASSERT_EQUAL(UTILS_OK, pll_update(&state, 1.0f, TEST_PLL_DT, &theta, &omega));
+  }
+
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, config.max_omega, state.integrator);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, config.max_omega, omega);
+  float acceleration = state.acceleration;
+
+  TEST_ASSERT_EQUAL(UTILS_OK, pll_update(&state, 1.0f, TEST_PLL_DT, &theta, &omega));
+  TEST_ASSERT_EQUAL_FLOAT(acceleration, state.acceleration);
+
+  /* The error reversing unwinds it straight away */
+  TEST_ASSERT_EQUAL(UTILS_OK, pll_update(&state, -1.0f, TEST_PLL_DT, &theta, &omega));
+  TEST_ASSERT_TRUE(state.acceleration < acceleration);
+}
+
+void run_pll_tests() {
+  RUN_TEST(test_pll_init_rejects_empty_schedule);
+  RUN_TEST(test_pll_type2_lags_speed_ramp);
+  RUN_TEST(test_pll_type3_tracks_speed_ramp);
+  RUN_TEST(test_pll_schedule_interpolates_bandwidth);
+  RUN_TEST(test_pll_integrators_held_at_max_omega);
+}
@@ -0,0 +1,179 @@
+/*******************************************************************************************************************************
+ * @file   test_telemetry_ring.c
+ *
+ * @brief  Source file for telemetry ring buffer unit tests
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <string.h>
+
+/* Inter-component Headers */
+#include "telemetry_ring.h"
+#include "unity.h"
+
+/* Intra-component Headers */
+
+#define TEST_RING_CAPACITY 64U
+#define TEST_RING_MEMORY_WORDS 1024U
+
+/**
+ * @brief   Test frame, 12 bytes so the slots carry padding
+ */
+struct TestFrame_t {
+  uint32_t number;   /**< Frame number the producer gave it */
+  uint32_t square;   /**< number * number, wrapping */
+  uint32_t checksum; /**< Complement of the other fields */
+};
+
+static uint64_t s_memory[TEST_RING_MEMORY_WORDS];
+
+static struct TestFrame_t make_frame(uint32_t number) {
+  struct TestFrame_t frame = { .number = number, .square = number * number };
+
+  frame.checksum = ~(frame.number ^ frame.square);
+  return frame;
+}
+
+static bool frame_is_whole(const struct TestFrame_t *frame, uint32_t number) {
+  return frame->number == number && frame->square == number * number && frame->checksum == ~(frame->number ^ frame->square);
+}
+
+static void init_test_ring(struct TelemetryRing_t *ring) {
+  TEST_ASSERT_EQUAL(UTILS_OK, telemetry_ring_init(ring, s_memory, sizeof(s_memory), sizeof(struct TestFrame_t), TEST_RING_CAPACITY));
+}
+
+void test_telemetry_ring_init_rejects_bad_args() {
+  struct TelemetryRing_t ring;
+  size_t memory_size = telemetry_ring_memory_size(sizeof(struct TestFrame_t), TEST_RING_CAPACITY);
+
+  TEST_ASSERT_EQUAL(32U + TEST_RING_CAPACITY * 24U, memory_size);
+  TEST_ASSERT_EQUAL(UTILS_INVALID_ARGS, telemetry_ring_init(NULL, s_memory, sizeof(s_memory), sizeof(struct TestFrame_t), 4U));
+  TEST_ASSERT_EQUAL(UTILS_INVALID_ARGS, telemetry_ring_init(&ring, NULL, sizeof(s_memory), sizeof(struct TestFrame_t), 4U));
+  TEST_ASSERT_EQUAL(UTILS_INVALID_ARGS, telemetry_ring_init(&ring, s_memory, sizeof(s_memory), 0U, 4U));
+  TEST_ASSERT_EQUAL(UTILS_INVALID_ARGS, telemetry_ring_init(&ring, s_memory, sizeof(s_memory), sizeof(struct TestFrame_t), 0U));
+  TEST_ASSERT_EQUAL(UTILS_INVALID_ARGS,
+                    telemetry_ring_init(&ring, s_memory, memory_size - 1U, sizeof(struct TestFrame_t), TEST_RING_CAPACITY));
+}
+
+void test_telemetry_ring_round_trip() {
+  struct TelemetryRing_t ring;
+  struct TestFrame_t frame;
+
+  init_test_ring(&ring);
+  TEST_ASSERT_EQUAL_UINT32(0U, telemetry_ring_get_write_count(&ring));
+  TEST_ASSERT_FALSE(telemetry_ring_read(&ring, 1U, &frame));
+
+  for (uint32_t number = 1U; number <= TEST_RING_CAPACITY; number++) {
+    struct TestFrame_t published = make_frame(number);
+    telemetry_ring_publish(&ring, &published);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(TEST_RING_CAPACITY, telemetry_ring_get_write_count(&ring));
+
+  for (uint32_t number = 1U; number <= TEST_RING_CAPACITY; number++) {
+    TEST_ASSERT_TRUE(telemetry_ring_read(&ring, number, &frame));
+    TEST_ASSERT_TRUE(frame_is_whole(&frame, number));
+  }
+
+  /* Not published yet, and frame 0 never is */
+  TEST_ASSERT_FALSE(telemetry_ring_read(&ring, TEST_RING_CAPACITY + 1U, &frame));
+  TEST_ASSERT_FALSE(telemetry_ring_read(&ring, 0U, &frame));
+}
+
+void test_telemetry_ring_overwritten_frame_fails() {
+  struct TelemetryRing_t ring;
+  struct TestFrame_t frame;
+
+  init_test_ring(&ring);
+
+  for (uint32_t number = 1U; number <= TEST_RING_CAPACITY + 1U; number++) {
+    struct TestFrame_t published = make_frame(number);
+    telemetry_ring_publish(&ring, &published);
+  }
+
+  /* Frame 1 shared its slot with the newest frame */
+  TEST_ASSERT_FALSE(telemetry_ring_read(&ring, 1U, &frame));
+  TEST_ASSERT_TRUE(telemetry_ring_read(&ring, 2U, &frame));
+  TEST_ASSERT_TRUE(telemetry_ring_read(&ring, TEST_RING_CAPACITY + 1U, &frame));
+  TEST_ASSERT_TRUE(frame_is_whole(&frame, TEST_RING_CAPACITY + 1U));
+
+  /* A slot caught mid-write, its number cleared by the producer, reads as lost */
+  atomic_store((_Atomic uint32_t *)(void *)ring.slots, 0U);
+  TEST_ASSERT_FALSE(telemetry_ring_read(&ring, TEST_RING_CAPACITY + 1U, &frame));
+}
+
+void test_telemetry_ring_attach_validates_header() {
+  struct TelemetryRing_t producer;
+  struct TelemetryRing_t reader;
+  struct TestFrame_t frame;
+  size_t memory_size = telemetry_ring_memory_size(sizeof(struct TestFrame_t), TEST_RING_CAPACITY);
+
+  memset(s_memory, 0, sizeof(s_memory));
+  TEST_ASSERT_EQUAL(UTILS_UNINITIALIZED, telemetry_ring_attach(&reader, s_memory, sizeof(s_memory)));
+  TEST_ASSERT_EQUAL(UTILS_INVALID_ARGS, telemetry_ring_attach(&reader, NULL, sizeof(s_memory)));
+
+  init_test_ring(&producer);
+  TEST_ASSERT_EQUAL(UTILS_UNINITIALIZED, telemetry_ring_attach(&reader, s_memory, memory_size - 1U));
+  TEST_ASSERT_EQUAL(UTILS_OK, telemetry_ring_attach(&reader, s_memory, memory_size));
+
+  struct TestFrame_t published = make_frame(1U);
+  telemetry_ring_publish(&producer, &published);
+  TEST_ASSERT_EQUAL_UINT32(1U, telemetry_ring_get_write_count(&reader));
+  TEST_ASSERT_TRUE(telemetry_ring_read(&reader, 1U, &frame));
+  TEST_ASSERT_TRUE(frame_is_whole(&frame, 1U));
+
+  producer.header->version = TELEMETRY_RING_VERSION + 1U;
+  TEST_ASSERT_EQUAL(UTILS_UNINITIALIZED, telemetry_ring_attach(&reader, s_memory, memory_size));
+}
+
+void test_telemetry_ring_sustained_streaming() {
+  struct TelemetryRing_t ring;
+  struct TestFrame_t frame;
+  const uint32_t num_frames = 1000000U;
+  uint32_t next = 1U;
+  uint32_t frames_read = 0U;
+  uint32_t frames_dropped = 0U;
+
+  init_test_ring(&ring);
+
+  /* A reader that wakes at irregular times and takes at most half a ring, so it both keeps up and falls behind */
+  for (uint32_t number = 1U; number <= num_frames; number++) {
+    struct TestFrame_t published = make_frame(number);
+    telemetry_ring_publish(&ring, &published);
+
+    if (((number * 2654435761U) >> 26) != 0U && number != num_frames) {
+      continue;
+    }
+
+    uint32_t write_count = telemetry_ring_get_write_count(&ring);
+    uint32_t oldest = (write_count >= TEST_RING_CAPACITY) ? write_count - TEST_RING_CAPACITY + 1U : 1U;
+    uint32_t last = (number == num_frames) ? write_count : write_count - (write_count - oldest) / 2U;
+
+    if (next < oldest) {
+      frames_dropped += oldest - next;
+      next = oldest;
+    }
+
+    for (; next <= last; next++) {
+      TEST_ASSERT_TRUE(telemetry_ring_read(&ring, next, &frame));
+      TEST_ASSERT_TRUE(frame_is_whole(&frame, next));
+      frames_read++;
+    }
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(num_frames, telemetry_ring_get_write_count(&ring));
+  TEST_ASSERT_EQUAL_UINT32(num_frames, frames_read + frames_dropped);
+  TEST_ASSERT_TRUE(frames_dropped > 0U);
+  TEST_ASSERT_TRUE(frames_read > num_frames / 100U);
+}
+
+void run_telemetry_ring_tests() {
+  RUN_TEST(test_telemetry_ring_init_rejects_bad_args);
+  RUN_TEST(test_telemetry_ring_round_trip);
+  RUN_TEST(test_telemetry_ring_overwritten_frame_fails);
+  RUN_TEST(test_telemetry_ring_attach_validates_header);
+  RUN_TEST(test_telemetry_ring_sustained_streaming);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   hall_estimator.h
+ *
+ * @brief  Header file for the Hall sensor angle estimator
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "utils_error.h"
+
+/**
+ * @defgroup HallEstimator_Utils Hall sensor angle estimator
+ * @brief    Electrical angle and speed estimation from 3 digital Hall sensors
+ * @{
+ */
+
+/** @brief  Returned by hall_state_to_sector() for the illegal 0b000 and 0b111 Hall states */
+#define HALL_INVALID_SECTOR 0xFFU
+
+/** @brief  Number of Hall sectors in one electrical revolution */
+#define HALL_NUM_SECTORS 6U
+
+/**
+ * @brief   Hall estimator configuration
+ */
+struct HallEstimatorConfig_t {
+  float angle_offset;        /**< Electrical angle at the start of sector 0 [rad] (Hall mounting calibration) */
+  uint32_t stale_timeout_us; /**< Time without a Hall transition before the rotor is considered stopped [us] */
+  uint8_t max_invalid_reads; /**< Consecutive illegal Hall states tolerated before an update fails */
+};
+
+/**
+ * @brief   Hall estimator state
+ */
+struct HallEstimatorState_t {
+  const struct HallEstimatorConfig_t *config; /**< Pointer to the estimator configuration */
+  uint8_t sector;                             /**< Current Hall sector (0-5) */
+  int8_t direction;                           /**< Direction of the last transition (+1 forward, -1 reverse, 0 unknown) */
+  bool is_tracking;                           /**< True once two consecutive transitions in the same direction were seen */
+  bool is_valid;                              /**< True once a valid Hall state has been decoded */
+  uint8_t invalid_reads;                      /**< Consecutive illegal Hall states read */
+  uint32_t last_edge_time;                    /**< Timestamp of the last valid Hall transition [us] */
+  uint32_t sector_period;                     /**< Duration of the last complete sector [us] */
+  float boundary_angle;                       /**< Electrical angle of the last crossed sector boundary, excluding offset [rad] */
+  float sector_omega;                         /**< Electrical speed measured over the last sector [rad/s] */
+  float theta;                                /**< Estimated electrical angle [rad] */
+  float omega;                                /**< Estimated electrical speed [rad/s] */
+};
+
+/**
+ * @brief   Decode a Hall state into a forward-ordered sector index
+ * @details Hall state is read as 0bHallA_MSB HallB_MID HallC_LSB. The forward sequence is
+ *          011 -> 001 -> 101 -> 100 -> 110 -> 010, which maps to sectors 0 -> 5
+ * @param   hall_state Raw 3-bit Hall state
+ * @return  Sector index (0-5), or HALL_INVALID_SECTOR for 0b000 and 0b111
+ */
+uint8_t hall_state_to_sector(uint8_t hall_state);
+
+/**
+ * @brief   Initialize the Hall estimator
+ * @param   state Pointer to the estimator state
+ * @param   config Pointer to the estimator configuration
+ * @return  UTILS_OK if successful
+ *          UTILS_INVALID_ARGS if a pointer is null
+ */
+UtilsError_t hall_estimator_init(struct HallEstimatorState_t *state, const struct HallEstimatorConfig_t *config);
+
+/**
+ * @brief   Sample the Hall sensors and update the angle estimate
+ * @details A change of Hall state is treated as a transition at now_us. The angle snaps to the crossed
+ *          sector boundary on every transition and is extrapolated with the last sector speed in between,
+ *          never leaving the current sector. A reversal or an out-of-sequence state restarts speed tracking. An illegal
+ *          state is read as no transition, so the estimate keeps extrapolating, until more than max_invalid_reads follow
+ *          each other
+ * @param   state Pointer to the estimator state
+ * @param   hall_state Raw 3-bit Hall state
+ * @param   now_us Current timestamp [us]
+ * @param   theta_out Pointer to store the electrical angle [rad], normalized to [0, 2π)
+ * @param   omega_out Pointer to store the electrical speed [rad/s]
+ * @return  UTILS_OK if successful
+ *          UTILS_INVALID_ARGS if a pointer is null or more than max_invalid_reads consecutive Hall states were illegal
+ *          UTILS_UNINITIALIZED if the estimator has not been initialized
+ */
+UtilsError_t hall_estimator_update(struct HallEstimatorState_t *state, uint8_t hall_state, uint32_t now_us, float *theta_out, float *omega_out);
+
+/** @} */
@@ -28,6 +28,9 @@
 /** @brief  2 Pi */
 #define MATH_TWO_PI 6.283185307f
 
+/** @brief  Pi / 2 */
+#define MATH_PI_OVER_2 1.570796327f
+
 /** @brief  Pi / 3 */
 #define MATH_PI_OVER_3 1.047197551f
 
@@ -68,6 +71,14 @@ float fabsf(float x);
  */
 float sqrtf(float x);
 
+/**
+ * @brief   Returns the reciprocal square root of a float without a division or an iteration loop
+ * @details An exponent bit estimate refined by two Newton-Raphson steps, relative error below 5e-6 of 1 / sqrt(x)
+ * @param   x Value subject to a reciprocal square root operation, must be positive and normal
+ * @return  Reciprocal square root of x
+ */
+float fast_inv_sqrt(float x);
+
 /**
  * @brief   Normalize angle into [0, 2π)
  * @param   angle Input angle (radians)
@@ -36,17 +36,21 @@ struct PidConfig_t {
 
 /**
  * @brief   PID Controller storage class
+ * @details The gains are copied out of the configuration so an update reads one contiguous block, changes to the
+ *          configuration take effect on pid_reload_config()
  */
 struct PidController_t {
-  struct PidConfig_t *config; /**< Pointer to the PID config class */
+  struct PidConfig_t gains;   /**< Copy of the configuration used by pid_update() */
   float integral;             /**< Error integral */
   float prev_error;           /**< Previous error for derivative calculation */
   float prev_derivative;      /**< Previous derivative calculation for low-pass filter */
   bool is_initialized;        /**< Initialized flag */
+  struct PidConfig_t *config; /**< Pointer to the PID config class */
 };
 
 /**
  * @brief   Initialize the PID Controller class
+ * @details The gains are copied out of the config class, later writes to it take effect on pid_reload_config()
  * @param   pid Pointer to the PID Controller class
  * @param   config Pointer to the PID config class
  */
@@ -61,4 +65,18 @@ void pid_init(struct PidController_t *pid, struct PidConfig_t *config);
  */
 float pid_update(struct PidController_t *pid, float set_point, float measurement, float delta_time);
 
+/**
+ * @brief   Copy the PID config class into the controller again, keeping the integrator state
+ * @param   pid Pointer to the PID Controller class
+ */
+void pid_reload_config(struct PidController_t *pid);
+
+/**
+ * @brief   Change the output limits of the controller without touching its PID config class
+ * @param   pid Pointer to the PID Controller class
+ * @param   output_min Minimum output
+ * @param   output_max Maximum output
+ */
+void pid_set_output_limits(struct PidController_t *pid, float output_min, float output_max);
+
 /** @} */
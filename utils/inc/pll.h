@@ -11,6 +11,7 @@
 
 /* Standard library Headers */
 #include <stdbool.h>
+#include <stdint.h>
 
 /* Inter-component Headers */
 
@@ -23,12 +24,28 @@
  * @{
  */
 
+/**
+ * @brief Bandwidth of a scheduled PLL at one speed
+ */
+struct PLLGainPoint_t {
+    float omega;        /**< Absolute speed the bandwidth applies at [rad/s] */
+    float bandwidth;    /**< Closed-loop bandwidth, every pole of the loop sits at -bandwidth [rad/s] */
+};
+
 struct PLLConfig_t {
     float kp;
     float ki;
-    float max_omega;
+    float max_omega;    /**< Speed limit of the output, and of the integrator behind it [rad/s] */
     float filter_alpha;
     bool enable_filtering;
+
+    /* Gain scheduling, unused while gain_schedule is NULL */
+    const struct PLLGainPoint_t *gain_schedule; /**< Bandwidths in ascending omega, interpolated at the integrator speed, replace kp/ki/ka */
+    uint8_t num_gain_points;                    /**< Entries in gain_schedule */
+
+    /* Type-3 loop */
+    bool track_acceleration;  /**< Integrate the speed integrator input as well, tracking a constant acceleration without lag */
+    float ka;                 /**< Acceleration gain with fixed gains [rad/s^3] */
 };
 
 struct PLLState_t {
@@ -37,11 +54,29 @@ struct PLLState_t {
     float theta;
     float omega;
     float max_error;
+    float filtered_error;   /**< Low-passed absolute phase error behind is_converged */
+    float acceleration;     /**< Acceleration integrator of the type-3 loop [rad/s^2] */
     bool is_converged;
-    struct PLLConfig_t *cfg;
+    const struct PLLConfig_t *cfg;
 };
 
+/**
+ * @brief Initialize a PLL
+ *
+ * @return UTILS_INVALID_ARGS on a NULL pointer, or a gain_schedule without entries
+ */
 UtilsError_t pll_init(struct PLLState_t *state, const struct PLLConfig_t *cfg);
+
+/**
+ * @brief Advance the PLL by one update
+ *
+ * A PI loop (type 2) drives the phase error to zero at a constant speed and
+ * lags a speed ramp by acceleration / ki. With track_acceleration a second
+ * integrator removes that lag as well (type 3). With a gain_schedule the gains
+ * follow the bandwidth at the integrator speed, clamped to the end entries:
+ * kp = 2 * bw, ki = bw^2 for type 2 and kp = 3 * bw, ki = 3 * bw^2, ka = bw^3
+ * for type 3, a critically damped loop either way.
+ */
 UtilsError_t pll_update(struct PLLState_t *state,
                         float phase_error, float dt,
                         float *theta_out, float *omega_out);
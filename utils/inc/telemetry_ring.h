@@ -0,0 +1,116 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   telemetry_ring.h
+ *
+ * @brief  Header file for the lock-free telemetry ring buffer
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "utils_error.h"
+
+/**
+ * @defgroup TelemetryRing Telemetry ring buffer
+ * @brief    Fixed size frames streamed from one producer to any number of readers through a shared block of memory
+ * @details  The producer never waits. It overwrites the oldest slot, and a reader that falls a full ring behind loses
+ *           the frames in between. Every slot carries the number of the frame in it, set to 0 while the frame is
+ *           written, so a reader copies a slot and keeps it only if the number was the one it wanted before and after
+ *           the copy. Frames are numbered from 1, wrapping back to 1 after 2^32 - 1.
+ *
+ *           The memory holds a TelemetryRingHeader_t followed by capacity slots of slot_size bytes, each a 32-bit frame
+ *           number at offset 0 and the frame at TELEMETRY_RING_FRAME_OFFSET. The layout is the same for every process
+ *           mapping it, so readers in other languages can view it directly
+ * @{
+ */
+
+#define TELEMETRY_RING_MAGIC 0x5254454AU /**< "JETR" in little-endian memory */
+#define TELEMETRY_RING_VERSION 1U        /**< Layout version */
+#define TELEMETRY_RING_FRAME_OFFSET 8U   /**< Offset of the frame in a slot, 8-byte aligned after the frame number */
+
+/**
+ * @brief   Start of the ring memory, 32 bytes
+ */
+struct TelemetryRingHeader_t {
+  uint32_t magic;               /**< TELEMETRY_RING_MAGIC once initialized */
+  uint32_t version;             /**< TELEMETRY_RING_VERSION */
+  uint32_t header_size;         /**< Offset of the first slot (bytes) */
+  uint32_t slot_size;           /**< Bytes per slot, the frame number, padding and the frame rounded up to 8 bytes */
+  uint32_t frame_size;          /**< Bytes per frame */
+  uint32_t capacity;            /**< Number of slots */
+  _Atomic uint32_t write_count; /**< Number of the last complete frame, 0 before the first */
+  uint32_t reserved;            /**< Pads the header to 32 bytes */
+};
+
+/**
+ * @brief   View of a ring in memory, one per producer or reader
+ */
+struct TelemetryRing_t {
+  struct TelemetryRingHeader_t *header; /**< Header at the start of the memory */
+  uint8_t *slots;                       /**< First slot */
+};
+
+/**
+ * @brief   Bytes of memory a ring needs
+ * @param   frame_size Bytes per frame
+ * @param   capacity Number of slots
+ * @return  Size of the header and the slots (bytes)
+ */
+size_t telemetry_ring_memory_size(uint32_t frame_size, uint32_t capacity);
+
+/**
+ * @brief   Lay out an empty ring in memory, for the producer
+ * @param   ring Pointer to the ring view to set up
+ * @param   memory Memory of the ring, 8-byte aligned
+ * @param   memory_size Bytes available, at least telemetry_ring_memory_size()
+ * @param   frame_size Bytes per frame
+ * @param   capacity Number of slots
+ * @return  UTILS_OK if successful, UTILS_INVALID_ARGS on a NULL pointer, a zero size or too little memory
+ */
+UtilsError_t telemetry_ring_init(struct TelemetryRing_t *ring, void *memory, size_t memory_size, uint32_t frame_size,
+                                 uint32_t capacity);
+
+/**
+ * @brief   View a ring another producer laid out, for a reader
+ * @param   ring Pointer to the ring view to set up
+ * @param   memory Memory of the ring
+ * @param   memory_size Bytes available
+ * @return  UTILS_OK if successful, UTILS_INVALID_ARGS on a NULL pointer, UTILS_UNINITIALIZED if the memory does not hold
+ *          a ring of this version or holds more than memory_size bytes
+ */
+UtilsError_t telemetry_ring_attach(struct TelemetryRing_t *ring, void *memory, size_t memory_size);
+
+/**
+ * @brief   Publish a frame, overwriting the oldest one once the ring is full
+ * @param   ring Pointer to the producer's ring view
+ * @param   frame frame_size bytes to copy in
+ */
+void telemetry_ring_publish(struct TelemetryRing_t *ring, const void *frame);
+
+/**
+ * @brief   Number of the last published frame
+ * @param   ring Pointer to the ring view
+ * @return  Frames published, 0 before the first
+ */
+uint32_t telemetry_ring_get_write_count(const struct TelemetryRing_t *ring);
+
+/**
+ * @brief   Copy out one frame
+ * @param   ring Pointer to the reader's ring view
+ * @param   frame_number Number of the frame to read, from 1
+ * @param   frame frame_size bytes to copy the frame into, undefined on a failed read
+ * @return  TRUE if the frame was copied whole, FALSE if it is not yet published or was overwritten
+ */
+bool telemetry_ring_read(const struct TelemetryRing_t *ring, uint32_t frame_number, void *frame);
+
+/** @} */
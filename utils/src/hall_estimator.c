@@ -0,0 +1,166 @@
+/*******************************************************************************************************************************
+ * @file   hall_estimator.c
+ *
+ * @brief  Source file for the Hall sensor angle estimator
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <stddef.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "hall_estimator.h"
+#include "math_utils.h"
+
+#define HALL_SECTOR_ANGLE MATH_PI_OVER_3                   /**< Electrical angle spanned by one sector [rad] */
+#define HALL_SECTOR_ANGLE_US (MATH_PI_OVER_3 * 1000000.0f) /**< Sector angle scaled for microsecond periods */
+
+/**
+ * Sector lookup indexed by the raw Hall state. 0b000 and 0b111 cannot occur with 120° spaced sensors
+ */
+static const uint8_t s_hall_sector_lookup[8U] = {
+  HALL_INVALID_SECTOR, /**< 0b000 */
+  1U,                  /**< 0b001 */
+  5U,                  /**< 0b010 */
+  0U,                  /**< 0b011 */
+  3U,                  /**< 0b100 */
+  2U,                  /**< 0b101 */
+  4U,                  /**< 0b110 */
+  HALL_INVALID_SECTOR, /**< 0b111 */
+};
+
+static void hall_estimator_process_edge(struct HallEstimatorState_t *state, uint8_t sector, uint32_t edge_time) {
+  uint8_t delta = (uint8_t)((sector + HALL_NUM_SECTORS - state->sector) % HALL_NUM_SECTORS);
+  int8_t direction = 0;
+
+  if (delta == 1U) {
+    direction = 1;
+  } else if (delta == HALL_NUM_SECTORS - 1U) {
+    direction = -1;
+  }
+
+  if (direction == 0) {
+    /* Skipped a sector (glitch or missed edge). Snap to the middle of the new sector and restart tracking */
+    state->boundary_angle = ((float)sector + 0.5f) * HALL_SECTOR_ANGLE;
+    state->is_tracking = false;
+    state->sector_period = 0U;
+    state->sector_omega = 0.0f;
+  } else {
+    /* Forward rotation enters a sector at its start, reverse rotation enters at its end */
+    state->boundary_angle = (float)(direction > 0 ? sector : state->sector) * HALL_SECTOR_ANGLE;
+
+    if (direction == state->direction && state->last_edge_time != 0U) {
+      /* Same direction as the previous transition, so the last sector was fully traversed */
+      state->sector_period = edge_time - state->last_edge_time;
+      state->is_tracking = state->sector_period > 0U;
+      state->sector_omega = state->is_tracking ? (float)direction * (HALL_SECTOR_ANGLE_US / (float)state->sector_period) : 0.0f;
+    } else {
+      /* First transition, or direction reversal. The previous sector time is meaningless */
+      state->is_tracking = false;
+      state->sector_period = 0U;
+      state->sector_omega = 0.0f;
+    }
+  }
+
+  state->direction = direction;
+  state->sector = sector;
+  state->last_edge_time = edge_time;
+}
+
+uint8_t hall_state_to_sector(uint8_t hall_state) {
+  return s_hall_sector_lookup[hall_state & 0x07U];
+}
+
+UtilsError_t hall_estimator_init(struct HallEstimatorState_t *state, const struct HallEstimatorConfig_t *config) {
+  if (state == NULL || config == NULL) {
+    return UTILS_INVALID_ARGS;
+  }
+
+  state->config = config;
+  state->sector = 0U;
+  state->direction = 0;
+  state->is_tracking = false;
+  state->is_valid = false;
+  state->invalid_reads = 0U;
+  state->last_edge_time = 0U;
+  state->sector_period = 0U;
+  state->boundary_angle = 0.0f;
+  state->sector_omega = 0.0f;
+  state->theta = 0.0f;
+  state->omega = 0.0f;
+
+  return UTILS_OK;
+}
+
+UtilsError_t hall_estimator_update(struct HallEstimatorState_t *state, uint8_t hall_state, uint32_t now_us, float *theta_out, float *omega_out) {
+  if (state == NULL || theta_out == NULL || omega_out == NULL) {
+    return UTILS_INVALID_ARGS;
+  }
+
+  if (state->config == NULL) {
+    return UTILS_UNINITIALIZED;
+  }
+
+  uint8_t sector = hall_state_to_sector(hall_state);
+
+  if (sector == HALL_INVALID_SECTOR) {
+    if (state->invalid_reads >= state->config->max_invalid_reads) {
+      return UTILS_INVALID_ARGS;
+    }
+
+    /* A single noisy sample is common. Hold the sector so the estimate keeps extrapolating from the last edge */
+    state->invalid_reads++;
+
+    if (!state->is_valid) {
+      *theta_out = state->theta;
+      *omega_out = state->omega;
+      return UTILS_OK;
+    }
+
+    sector = state->sector;
+  } else {
+    state->invalid_reads = 0U;
+  }
+
+  if (!state->is_valid) {
+    /* No transition seen yet, the best guess is the middle of the sector */
+    state->sector = sector;
+    state->boundary_angle = ((float)sector + 0.5f) * HALL_SECTOR_ANGLE;
+    state->is_valid = true;
+  } else if (sector != state->sector) {
+    hall_estimator_process_edge(state, sector, now_us);
+  }
+
+  uint32_t elapsed = now_us - state->last_edge_time;
+  float theta = state->boundary_angle;
+  float omega = 0.0f;
+
+  if (state->is_tracking && elapsed > state->config->stale_timeout_us) {
+    /* No transition for too long. Treat the rotor as stopped and hold the last boundary */
+    state->is_tracking = false;
+    state->sector_omega = 0.0f;
+  }
+
+  if (state->is_tracking) {
+    if (elapsed <= state->sector_period) {
+      omega = state->sector_omega;
+      theta += omega * ((float)elapsed * 1.0e-6f);
+    } else {
+      /* Overdue edge means the rotor is slower than the last sector. Bound the speed and stop at the next boundary */
+      omega = (float)state->direction * (HALL_SECTOR_ANGLE_US / (float)elapsed);
+      theta += (float)state->direction * HALL_SECTOR_ANGLE;
+    }
+  }
+
+  state->theta = normalize_angle(theta + state->config->angle_offset);
+  state->omega = omega;
+
+  *theta_out = state->theta;
+  *omega_out = state->omega;
+
+  return UTILS_OK;
+}
@@ -15,6 +15,8 @@
 /* Intra-component Headers */
 #include "math_utils.h"
 
+#define SQRTF_MAX_ITERATIONS 64 /**< Newton-Raphson iterations before the estimate is returned as is */
+
 float clamp(float value, float min, float max) {
   if (value >= max) {
     return max;
@@ -52,16 +54,35 @@ float sqrtf(float x) {
     if (x == 0.0f) return 0.0f;
 
     float guess = x / 2.0f;
-    float epsilon = 0.00001f;
+    float epsilon = 0.00001f * x;
 
-    // Newton-Raphson iteration
-    while ((guess * guess - x) > epsilon || (guess * guess - x) < -epsilon) {
+    // Newton-Raphson iteration. The tolerance is relative, an absolute one is finer than a float resolves for large x
+    for (int i = 0; i < SQRTF_MAX_ITERATIONS; i++) {
+        if ((guess * guess - x) <= epsilon && (guess * guess - x) >= -epsilon) {
+            break;
+        }
         guess = (guess + x / guess) * 0.5f;
     }
 
     return guess;
 }
 
+float fast_inv_sqrt(float x) {
+  union {
+    float f;
+    uint32_t i;
+  } u;
+
+  /* Halving the exponent bits gives a first guess within 4% */
+  u.f = x;
+  u.i = 0x5F3759DFU - (u.i >> 1U);
+
+  u.f *= 1.5f - 0.5f * x * u.f * u.f;
+  u.f *= 1.5f - 0.5f * x * u.f * u.f;
+
+  return u.f;
+}
+
 float mech_to_elec_angle(float mechanical_angle, uint8_t pole_pairs) {
   float electrical_angle = mechanical_angle * (float)pole_pairs;
   return normalize_angle(electrical_angle);
@@ -17,11 +17,17 @@
 #include "pid.h"
 
 void pid_init(struct PidController_t *pid, struct PidConfig_t *config) {
-  if (pid == NULL || config == NULL) {
+  if (pid == NULL) {
+    return;
+  }
+
+  if (config == NULL) {
+    pid->is_initialized = false;
     return;
   }
 
   pid->config = config;
+  pid->gains = *config;
 
   pid->integral = 0.0f;
   pid->prev_error = 0.0f;
@@ -37,7 +43,8 @@ float pid_update(struct PidController_t *pid, float set_point, float measurement
   float error = set_point - measurement;
 
   /* Trapezoidal rule integral */
-  pid->integral = pid->integral + (0.5f * delta_time) * (error + pid->prev_error);
+  float integral_step = (0.5f * delta_time) * (error + pid->prev_error);
+  pid->integral = pid->integral + integral_step;
 
   /* IIR Low pass filter */
   float derivative = 0.0f;
@@ -45,24 +52,43 @@ float pid_update(struct PidController_t *pid, float set_point, float measurement
   /* Only calculate if time is not 0 and previous error is a valid value */
   if (delta_time > 0.0f && pid->prev_error != 0.0f) {
     derivative = (error - pid->prev_error) / delta_time;
-    derivative = (pid->config->derivative_ema_alpha * derivative) + ((1.0f - pid->config->derivative_ema_alpha) * pid->prev_derivative);
+    derivative = (pid->gains.derivative_ema_alpha * derivative) + ((1.0f - pid->gains.derivative_ema_alpha) * pid->prev_derivative);
     pid->prev_derivative = derivative;
   }
 
   pid->prev_error = error;
 
-  float output = (pid->config->kp * error) + (pid->config->ki * pid->integral) + (pid->config->kd * derivative);
-
-  /* Integral windup */
-  if (output > pid->config->output_max) {
-    /* Saturation has occurred, prevent further integration */
-    pid->integral -= (output - pid->config->output_max) / pid->config->ki;
-    output = pid->config->output_max;
-  } else if (output < pid->config->output_min) {
-    /* Saturation has occurred, prevent further integration */
-    pid->integral -= (pid->config->output_min - output) / pid->config->ki;
-    output = pid->config->output_min;
+  float output = (pid->gains.kp * error) + (pid->gains.ki * pid->integral) + (pid->gains.kd * derivative);
+
+  /* Integral windup. A step that drives further into saturation is not integrated */
+  if (output > pid->gains.output_max) {
+    if (integral_step > 0.0f) {
+      pid->integral -= integral_step;
+    }
+    output = pid->gains.output_max;
+  } else if (output < pid->gains.output_min) {
+    if (integral_step < 0.0f) {
+      pid->integral -= integral_step;
+    }
+    output = pid->gains.output_min;
   }
 
   return output;
 }
+
+void pid_reload_config(struct PidController_t *pid) {
+  if (pid == NULL || pid->is_initialized == false) {
+    return;
+  }
+
+  pid->gains = *pid->config;
+}
+
+void pid_set_output_limits(struct PidController_t *pid, float output_min, float output_max) {
+  if (pid == NULL) {
+    return;
+  }
+
+  pid->gains.output_min = output_min;
+  pid->gains.output_max = output_max;
+}
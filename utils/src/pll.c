@@ -10,6 +10,7 @@
 /* Standard library Headers */
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /* Inter-component Headers */
 
@@ -17,19 +18,43 @@
 #include "pll.h"
 #include "math_utils.h"
 
-#define CONVERGENCE_THRESHOLD   0.05f
+#define CONVERGENCE_THRESHOLD   0.15f   /**< Averaged phase error of a lock, above the current sampling noise [rad] */
+#define CONVERGENCE_TIME_CONST  0.005f  /**< Averaging of the phase error noise before the threshold [s] */
 #define MAX_PHASE_ERROR         MATH_TWO_PI
-#define MAX_INTEGRATOR          50.0f
+
+/* Bandwidth at the given absolute speed, linear between the schedule entries and held beyond them */
+static float schedule_bandwidth(const struct PLLConfig_t *cfg, float abs_omega) {
+    const struct PLLGainPoint_t *points = cfg->gain_schedule;
+
+    if (abs_omega <= points[0].omega) {
+        return points[0].bandwidth;
+    }
+
+    for (uint8_t i = 1U; i < cfg->num_gain_points; i++) {
+        if (abs_omega < points[i].omega) {
+            float fraction = (abs_omega - points[i - 1U].omega) / (points[i].omega - points[i - 1U].omega);
+            return points[i - 1U].bandwidth + fraction * (points[i].bandwidth - points[i - 1U].bandwidth);
+        }
+    }
+
+    return points[cfg->num_gain_points - 1U].bandwidth;
+}
 
 UtilsError_t pll_init(struct PLLState_t *state, const struct PLLConfig_t *cfg) {
     if (state == NULL || cfg == NULL) {
         return UTILS_INVALID_ARGS;
     }
 
+    if (cfg->gain_schedule != NULL && cfg->num_gain_points == 0U) {
+        return UTILS_INVALID_ARGS;
+    }
+
     state->theta = 0.0f;
     state->omega = 0.0f;
     state->integrator = 0.0f;
+    state->acceleration = 0.0f;
     state->max_error = 0.0f;
+    state->filtered_error = MAX_PHASE_ERROR;
     state->is_converged = false;
     state->prev_error = 0.0f;
     state->cfg = cfg;
@@ -53,14 +78,44 @@ UtilsError_t pll_update(struct PLLState_t *state,
         state->max_error = abs_error;
     }
 
-    /* Check if phase is converged/aligned */
-    state->is_converged = abs_error < CONVERGENCE_THRESHOLD;
+    /* Check if phase is converged/aligned. Single samples carry the measurement noise, so the error is averaged first */
+    state->filtered_error += (dt / (CONVERGENCE_TIME_CONST + dt)) * (abs_error - state->filtered_error);
+    state->is_converged = state->filtered_error < CONVERGENCE_THRESHOLD;
+
+    float kp = state->cfg->kp;
+    float ki = state->cfg->ki;
+    float ka = state->cfg->ka;
+
+    /* Scheduled on the integrator, the proportional term carries the phase noise into omega */
+    if (state->cfg->gain_schedule != NULL) {
+        float bandwidth = schedule_bandwidth(state->cfg, fabsf(state->integrator));
+
+        if (state->cfg->track_acceleration) {
+            kp = 3.0f * bandwidth;
+            ki = 3.0f * bandwidth * bandwidth;
+            ka = bandwidth * bandwidth * bandwidth;
+        } else {
+            kp = 2.0f * bandwidth;
+            ki = bandwidth * bandwidth;
+        }
+    }
+
+    /* The acceleration integrator only winds towards the limit the speed integrator is pinned at */
+    if (state->cfg->track_acceleration) {
+        float acceleration_step = ka * phase_error * dt;
+        bool is_winding_up = (state->integrator >= state->cfg->max_omega && acceleration_step > 0.0f) ||
+                             (state->integrator <= -state->cfg->max_omega && acceleration_step < 0.0f);
+
+        if (!is_winding_up) {
+            state->acceleration += acceleration_step;
+        }
+    }
 
     /* PI controller (Output is angular velocity) */
-    state->integrator += state->cfg->ki * phase_error * dt;
-    state->integrator = clamp(state->integrator, -MAX_INTEGRATOR, MAX_INTEGRATOR);
+    state->integrator += (ki * phase_error + state->acceleration) * dt;
+    state->integrator = clamp(state->integrator, -state->cfg->max_omega, state->cfg->max_omega);
 
-    float omega = state->cfg->kp * phase_error + state->integrator;
+    float omega = kp * phase_error + state->integrator;
 
     if (omega > state->cfg->max_omega) omega = state->cfg->max_omega;
     if (omega < -state->cfg->max_omega) omega = -state->cfg->max_omega;
@@ -77,6 +132,9 @@ UtilsError_t pll_update(struct PLLState_t *state,
         state->omega = omega;
     }
 
+    /* Wrapped after filtering, the filter blends angles that are still continuous */
+    state->theta = normalize_angle(state->theta);
+
     if (theta_out) *theta_out = state->theta;
     if (omega_out) *omega_out = state->omega;
 
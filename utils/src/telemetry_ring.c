@@ -0,0 +1,127 @@
+/*******************************************************************************************************************************
+ * @file   telemetry_ring.c
+ *
+ * @brief  Source file for the lock-free telemetry ring buffer
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <string.h>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "telemetry_ring.h"
+
+static uint32_t slot_size(uint32_t frame_size) {
+  return TELEMETRY_RING_FRAME_OFFSET + ((frame_size + 7U) & ~7U);
+}
+
+static _Atomic uint32_t *slot_number(const struct TelemetryRing_t *ring, uint32_t frame_number) {
+  uint32_t index = (frame_number - 1U) % ring->header->capacity;
+
+  return (_Atomic uint32_t *)(void *)(ring->slots + (size_t)index * ring->header->slot_size);
+}
+
+size_t telemetry_ring_memory_size(uint32_t frame_size, uint32_t capacity) {
+  return sizeof(struct TelemetryRingHeader_t) + (size_t)capacity * slot_size(frame_size);
+}
+
+UtilsError_t telemetry_ring_init(struct TelemetryRing_t *ring, void *memory, size_t memory_size, uint32_t frame_size,
+                                 uint32_t capacity) {
+  if (ring == NULL || memory == NULL || frame_size == 0U || capacity == 0U ||
+      memory_size < telemetry_ring_memory_size(frame_size, capacity)) {
+    return UTILS_INVALID_ARGS;
+  }
+
+  memset(memory, 0, telemetry_ring_memory_size(frame_size, capacity));
+
+  ring->header = (struct TelemetryRingHeader_t *)memory;
+  ring->slots = (uint8_t *)memory + sizeof(struct TelemetryRingHeader_t);
+
+  ring->header->version = TELEMETRY_RING_VERSION;
+  ring->header->header_size = (uint32_t)sizeof(struct TelemetryRingHeader_t);
+  ring->header->slot_size = slot_size(frame_size);
+  ring->header->frame_size = frame_size;
+  ring->header->capacity = capacity;
+  atomic_store_explicit(&ring->header->write_count, 0U, memory_order_relaxed);
+
+  /* Written last, a reader attaching early sees an unusable ring rather than a partial one */
+  atomic_thread_fence(memory_order_release);
+  ring->header->magic = TELEMETRY_RING_MAGIC;
+
+  return UTILS_OK;
+}
+
+UtilsError_t telemetry_ring_attach(struct TelemetryRing_t *ring, void *memory, size_t memory_size) {
+  if (ring == NULL || memory == NULL) {
+    return UTILS_INVALID_ARGS;
+  }
+
+  struct TelemetryRingHeader_t *header = (struct TelemetryRingHeader_t *)memory;
+
+  if (memory_size < sizeof(*header) || header->magic != TELEMETRY_RING_MAGIC || header->version != TELEMETRY_RING_VERSION) {
+    return UTILS_UNINITIALIZED;
+  }
+
+  atomic_thread_fence(memory_order_acquire);
+
+  if (header->capacity == 0U || header->slot_size != slot_size(header->frame_size) ||
+      memory_size < telemetry_ring_memory_size(header->frame_size, header->capacity)) {
+    return UTILS_UNINITIALIZED;
+  }
+
+  ring->header = header;
+  ring->slots = (uint8_t *)memory + header->header_size;
+
+  return UTILS_OK;
+}
+
+void telemetry_ring_publish(struct TelemetryRing_t *ring, const void *frame) {
+  if (ring == NULL || ring->header == NULL || frame == NULL) {
+    return;
+  }
+
+  uint32_t frame_number = atomic_load_explicit(&ring->header->write_count, memory_order_relaxed) + 1U;
+
+  /* Number 0 is never a frame, it marks the slot as being written */
+  if (frame_number == 0U) {
+    frame_number = 1U;
+  }
+
+  _Atomic uint32_t *number = slot_number(ring, frame_number);
+
+  atomic_store_explicit(number, 0U, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  memcpy((uint8_t *)number + TELEMETRY_RING_FRAME_OFFSET, frame, ring->header->frame_size);
+  atomic_store_explicit(number, frame_number, memory_order_release);
+  atomic_store_explicit(&ring->header->write_count, frame_number, memory_order_release);
+}
+
+uint32_t telemetry_ring_get_write_count(const struct TelemetryRing_t *ring) {
+  if (ring == NULL || ring->header == NULL) {
+    return 0U;
+  }
+
+  return atomic_load_explicit(&ring->header->write_count, memory_order_acquire);
+}
+
+bool telemetry_ring_read(const struct TelemetryRing_t *ring, uint32_t frame_number, void *frame) {
+  if (ring == NULL || ring->header == NULL || frame == NULL || frame_number == 0U) {
+    return false;
+  }
+
+  _Atomic uint32_t *number = slot_number(ring, frame_number);
+
+  if (atomic_load_explicit(number, memory_order_acquire) != frame_number) {
+    return false;
+  }
+
+  memcpy(frame, (const uint8_t *)number + TELEMETRY_RING_FRAME_OFFSET, ring->header->frame_size);
+
+  /* The producer clears the number before touching the frame, an unchanged number means the copy is whole */
+  atomic_thread_fence(memory_order_acquire);
+  return atomic_load_explicit(number, memory_order_relaxed) == frame_number;
+}